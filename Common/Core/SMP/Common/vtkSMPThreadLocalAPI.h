@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadLocalAPI.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// vtkSMPThreadLocalAPI creates the thread local storage of every enabled
+// back-end and forwards to the storage of the back-end in use. Objects
+// created through Local() belong to the storage of the back-end that was in
+// use at the time: changing the back-end while a vtkSMPThreadLocal is
+// populated hides the existing objects from iteration.
+
+#ifndef vtkSMPThreadLocalAPI_h
+#define vtkSMPThreadLocalAPI_h
+
+#include "vtkSMP.h" // For VTK_SMP_ENABLE_*
+
+#include "SMP/Common/vtkSMPThreadLocalImplAbstract.h"
+#include "SMP/Common/vtkSMPToolsAPI.h" // For GetBackendType(), DefaultBackend
+#if VTK_SMP_ENABLE_SEQUENTIAL
+#include "SMP/Sequential/vtkSMPThreadLocalImpl.h"
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+#include "SMP/STDThread/vtkSMPThreadLocalImpl.h"
+#endif
+#if VTK_SMP_ENABLE_TBB
+#include "SMP/TBB/vtkSMPThreadLocalImpl.h"
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+#include "SMP/OpenMP/vtkSMPThreadLocalImpl.h"
+#endif
+
+#include <array>
+#include <iterator> // For std::forward_iterator_tag
+#include <memory>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+template <typename T>
+class vtkSMPThreadLocalAPI
+{
+  typedef std::unique_ptr<vtkSMPThreadLocalImplAbstract<T> > ImplPointer;
+  typedef typename vtkSMPThreadLocalImplAbstract<T>::ItImpl ItImplAbstract;
+
+public:
+  //--------------------------------------------------------------------------------
+  vtkSMPThreadLocalAPI()
+  {
+#if VTK_SMP_ENABLE_SEQUENTIAL
+    this->BackendsImpl[static_cast<int>(BackendType::Sequential)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::Sequential, T>());
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+    this->BackendsImpl[static_cast<int>(BackendType::STDThread)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::STDThread, T>());
+#endif
+#if VTK_SMP_ENABLE_TBB
+    this->BackendsImpl[static_cast<int>(BackendType::TBB)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::TBB, T>());
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+    this->BackendsImpl[static_cast<int>(BackendType::OpenMP)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::OpenMP, T>());
+#endif
+  }
+
+  //--------------------------------------------------------------------------------
+  explicit vtkSMPThreadLocalAPI(const T& exemplar)
+  {
+#if VTK_SMP_ENABLE_SEQUENTIAL
+    this->BackendsImpl[static_cast<int>(BackendType::Sequential)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::Sequential, T>(exemplar));
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+    this->BackendsImpl[static_cast<int>(BackendType::STDThread)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::STDThread, T>(exemplar));
+#endif
+#if VTK_SMP_ENABLE_TBB
+    this->BackendsImpl[static_cast<int>(BackendType::TBB)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::TBB, T>(exemplar));
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+    this->BackendsImpl[static_cast<int>(BackendType::OpenMP)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::OpenMP, T>(exemplar));
+#endif
+  }
+
+  //--------------------------------------------------------------------------------
+  T& Local() { return this->GetActiveImpl().Local(); }
+
+  //--------------------------------------------------------------------------------
+  size_t size() const { return this->GetActiveImpl().size(); }
+
+  //--------------------------------------------------------------------------------
+  class iterator : public std::iterator<std::forward_iterator_tag, T> // for iterator_traits
+  {
+  public:
+    iterator() = default;
+
+    iterator(const iterator& other)
+      : ImplAbstract(other.ImplAbstract ? other.ImplAbstract->Clone() : nullptr)
+    {
+    }
+
+    iterator& operator=(const iterator& other)
+    {
+      if (this != &other)
+      {
+        this->ImplAbstract = other.ImplAbstract ? other.ImplAbstract->Clone() : nullptr;
+      }
+      return *this;
+    }
+
+    iterator& operator++()
+    {
+      this->ImplAbstract->Increment();
+      return *this;
+    }
+
+    iterator operator++(int)
+    {
+      iterator copy = *this;
+      this->ImplAbstract->Increment();
+      return copy;
+    }
+
+    bool operator==(const iterator& other)
+    {
+      return this->ImplAbstract->Compare(other.ImplAbstract.get());
+    }
+
+    bool operator!=(const iterator& other)
+    {
+      return !this->ImplAbstract->Compare(other.ImplAbstract.get());
+    }
+
+    T& operator*() { return this->ImplAbstract->GetContent(); }
+
+    T* operator->() { return this->ImplAbstract->GetContentPtr(); }
+
+  private:
+    std::unique_ptr<ItImplAbstract> ImplAbstract;
+
+    friend class vtkSMPThreadLocalAPI<T>;
+  };
+
+  //--------------------------------------------------------------------------------
+  iterator begin()
+  {
+    iterator iter;
+    iter.ImplAbstract = this->GetActiveImpl().begin();
+    return iter;
+  }
+
+  //--------------------------------------------------------------------------------
+  iterator end()
+  {
+    iterator iter;
+    iter.ImplAbstract = this->GetActiveImpl().end();
+    return iter;
+  }
+
+  // disable copying
+  vtkSMPThreadLocalAPI(const vtkSMPThreadLocalAPI&) = delete;
+  vtkSMPThreadLocalAPI& operator=(const vtkSMPThreadLocalAPI&) = delete;
+
+private:
+  vtkSMPThreadLocalImplAbstract<T>& GetActiveImpl() const
+  {
+    const BackendType backendType = vtkSMPToolsAPI::GetInstance().GetBackendType();
+    return *this->BackendsImpl[static_cast<int>(backendType)];
+  }
+
+  std::array<ImplPointer, NumberOfBackends> BackendsImpl;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif // __VTK_WRAP__
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadLocalAPI.h
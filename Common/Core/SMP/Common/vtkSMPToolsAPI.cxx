@@ -0,0 +1,272 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/Common/vtkSMPToolsAPI.h"
+
+#include "vtkObject.h" // For vtkGenericWarningMacro
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+//------------------------------------------------------------------------------
+vtkSMPToolsAPI::vtkSMPToolsAPI()
+{
+#if VTK_SMP_ENABLE_SEQUENTIAL
+  this->SequentialBackend.reset(new vtkSMPToolsImpl<BackendType::Sequential>);
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+  this->STDThreadBackend.reset(new vtkSMPToolsImpl<BackendType::STDThread>);
+#endif
+#if VTK_SMP_ENABLE_TBB
+  this->TBBBackend.reset(new vtkSMPToolsImpl<BackendType::TBB>);
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+  this->OpenMPBackend.reset(new vtkSMPToolsImpl<BackendType::OpenMP>);
+#endif
+
+  std::string backend;
+  if (vtksys::SystemTools::GetEnv("VTK_SMP_BACKEND_IN_USE", backend))
+  {
+    this->SetBackend(backend.c_str());
+  }
+
+  std::string maxThreads;
+  if (vtksys::SystemTools::GetEnv("VTK_SMP_MAX_THREADS", maxThreads))
+  {
+    int numThreads = std::atoi(maxThreads.c_str());
+    if (numThreads > 0)
+    {
+      this->Initialize(numThreads);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSMPToolsAPI& vtkSMPToolsAPI::GetInstance()
+{
+  static vtkSMPToolsAPI instance;
+  return instance;
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPToolsAPI::GetBackend() const
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      return "Sequential";
+    case BackendType::STDThread:
+      return "STDThread";
+    case BackendType::TBB:
+      return "TBB";
+    case BackendType::OpenMP:
+      return "OpenMP";
+  }
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::SetBackend(const char* type)
+{
+  if (!type)
+  {
+    return false;
+  }
+  std::string backend(type);
+  std::transform(backend.cbegin(), backend.cend(), backend.begin(), ::toupper);
+
+  if (backend == "SEQUENTIAL" && VTK_SMP_ENABLE_SEQUENTIAL)
+  {
+    this->ActivatedBackend = BackendType::Sequential;
+  }
+  else if (backend == "STDTHREAD" && VTK_SMP_ENABLE_STDTHREAD)
+  {
+    this->ActivatedBackend = BackendType::STDThread;
+  }
+  else if (backend == "TBB" && VTK_SMP_ENABLE_TBB)
+  {
+    this->ActivatedBackend = BackendType::TBB;
+  }
+  else if (backend == "OPENMP" && VTK_SMP_ENABLE_OPENMP)
+  {
+    this->ActivatedBackend = BackendType::OpenMP;
+  }
+  else
+  {
+    vtkGenericWarningMacro("SMP backend " << type << " is not available, "
+                                          << this->GetBackend() << " is still in use.");
+    return false;
+  }
+
+  this->RefreshNumberOfThread();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::Initialize(int numThreads)
+{
+  this->DesiredNumberOfThread = numThreads;
+  this->RefreshNumberOfThread();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::RefreshNumberOfThread()
+{
+  const int numThreads = this->DesiredNumberOfThread;
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+      this->SequentialBackend->Initialize(numThreads);
+#endif
+      break;
+    case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+      this->STDThreadBackend->Initialize(numThreads);
+#endif
+      break;
+    case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+      this->TBBBackend->Initialize(numThreads);
+#endif
+      break;
+    case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+      this->OpenMPBackend->Initialize(numThreads);
+#endif
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPToolsAPI::GetEstimatedNumberOfThreads()
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+      return this->SequentialBackend->GetEstimatedNumberOfThreads();
+#endif
+      break;
+    case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+      return this->STDThreadBackend->GetEstimatedNumberOfThreads();
+#endif
+      break;
+    case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+      return this->TBBBackend->GetEstimatedNumberOfThreads();
+#endif
+      break;
+    case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+      return this->OpenMPBackend->GetEstimatedNumberOfThreads();
+#endif
+      break;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetNestedParallelism(bool isNested)
+{
+  // The setting is kept by every back-end so that it applies to whichever
+  // one is activated later on.
+#if VTK_SMP_ENABLE_SEQUENTIAL
+  this->SequentialBackend->SetNestedParallelism(isNested);
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+  this->STDThreadBackend->SetNestedParallelism(isNested);
+#endif
+#if VTK_SMP_ENABLE_TBB
+  this->TBBBackend->SetNestedParallelism(isNested);
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+  this->OpenMPBackend->SetNestedParallelism(isNested);
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::GetNestedParallelism()
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+      return this->SequentialBackend->GetNestedParallelism();
+#endif
+      break;
+    case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+      return this->STDThreadBackend->GetNestedParallelism();
+#endif
+      break;
+    case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+      return this->TBBBackend->GetNestedParallelism();
+#endif
+      break;
+    case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+      return this->OpenMPBackend->GetNestedParallelism();
+#endif
+      break;
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::IsParallelScope()
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+      return this->SequentialBackend->IsParallelScope();
+#endif
+      break;
+    case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+      return this->STDThreadBackend->IsParallelScope();
+#endif
+      break;
+    case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+      return this->TBBBackend->IsParallelScope();
+#endif
+      break;
+    case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+      return this->OpenMPBackend->IsParallelScope();
+#endif
+      break;
+  }
+  return false;
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
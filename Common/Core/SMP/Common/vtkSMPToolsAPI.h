@@ -0,0 +1,246 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// vtkSMPToolsAPI owns one vtkSMPToolsImpl per back-end enabled at build time
+// and forwards vtkSMPTools calls to the one in use. The back-end in use is
+// the VTK_SMP_IMPLEMENTATION_TYPE chosen at configure time unless the
+// VTK_SMP_BACKEND_IN_USE environment variable or SetBackend() selects another
+// one. The VTK_SMP_MAX_THREADS environment variable sets the default number
+// of threads, like a call to Initialize() would.
+
+#ifndef vtkSMPToolsAPI_h
+#define vtkSMPToolsAPI_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSMP.h"              // For VTK_SMP_ENABLE_*
+#include "vtkSystemIncludes.h"
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#if VTK_SMP_ENABLE_SEQUENTIAL
+#include "SMP/Sequential/vtkSMPToolsImpl.txx"
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+#include "SMP/STDThread/vtkSMPToolsImpl.txx"
+#endif
+#if VTK_SMP_ENABLE_TBB
+#include "SMP/TBB/vtkSMPToolsImpl.txx"
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+#include "SMP/OpenMP/vtkSMPToolsImpl.txx"
+#endif
+
+#include <atomic>
+#include <memory>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+class VTKCOMMONCORE_EXPORT vtkSMPToolsAPI
+{
+public:
+  //--------------------------------------------------------------------------------
+  static vtkSMPToolsAPI& GetInstance();
+
+  //--------------------------------------------------------------------------------
+  BackendType GetBackendType() const { return this->ActivatedBackend; }
+
+  //--------------------------------------------------------------------------------
+  const char* GetBackend() const;
+
+  //--------------------------------------------------------------------------------
+  bool SetBackend(const char* type);
+
+  //--------------------------------------------------------------------------------
+  void Initialize(int numThreads = 0);
+
+  //--------------------------------------------------------------------------------
+  int GetEstimatedNumberOfThreads();
+
+  //--------------------------------------------------------------------------------
+  void SetNestedParallelism(bool isNested);
+
+  //--------------------------------------------------------------------------------
+  bool GetNestedParallelism();
+
+  //--------------------------------------------------------------------------------
+  bool IsParallelScope();
+
+  //--------------------------------------------------------------------------------
+  int GetInternalDesiredNumberOfThread() const { return this->DesiredNumberOfThread; }
+
+  //--------------------------------------------------------------------------------
+  template <typename FunctorInternal>
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+        this->SequentialBackend->For(first, last, grain, fi);
+#endif
+        break;
+      case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+        this->STDThreadBackend->For(first, last, grain, fi);
+#endif
+        break;
+      case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+        this->TBBBackend->For(first, last, grain, fi);
+#endif
+        break;
+      case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+        this->OpenMPBackend->For(first, last, grain, fi);
+#endif
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+        this->SequentialBackend->Sort(begin, end);
+#endif
+        break;
+      case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+        this->STDThreadBackend->Sort(begin, end);
+#endif
+        break;
+      case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+        this->TBBBackend->Sort(begin, end);
+#endif
+        break;
+      case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+        this->OpenMPBackend->Sort(begin, end);
+#endif
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Compare>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+        this->SequentialBackend->Sort(begin, end, comp);
+#endif
+        break;
+      case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+        this->STDThreadBackend->Sort(begin, end, comp);
+#endif
+        break;
+      case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+        this->TBBBackend->Sort(begin, end, comp);
+#endif
+        break;
+      case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+        this->OpenMPBackend->Sort(begin, end, comp);
+#endif
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Compare>
+  void StableSort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+#if VTK_SMP_ENABLE_SEQUENTIAL
+        this->SequentialBackend->StableSort(begin, end, comp);
+#endif
+        break;
+      case BackendType::STDThread:
+#if VTK_SMP_ENABLE_STDTHREAD
+        this->STDThreadBackend->StableSort(begin, end, comp);
+#endif
+        break;
+      case BackendType::TBB:
+#if VTK_SMP_ENABLE_TBB
+        this->TBBBackend->StableSort(begin, end, comp);
+#endif
+        break;
+      case BackendType::OpenMP:
+#if VTK_SMP_ENABLE_OPENMP
+        this->OpenMPBackend->StableSort(begin, end, comp);
+#endif
+        break;
+    }
+  }
+
+  // disable copying
+  vtkSMPToolsAPI(vtkSMPToolsAPI const&) = delete;
+  void operator=(vtkSMPToolsAPI const&) = delete;
+
+private:
+  //--------------------------------------------------------------------------------
+  vtkSMPToolsAPI();
+
+  //--------------------------------------------------------------------------------
+  void RefreshNumberOfThread();
+
+  // Back-end vtkSMPTools calls are forwarded to.
+  BackendType ActivatedBackend = DefaultBackend;
+
+  // Number of threads asked through Initialize() or VTK_SMP_MAX_THREADS, 0 to
+  // let the back-end decide. Kept to configure a newly activated back-end.
+  // Initialize() may be called from several threads.
+  std::atomic<int> DesiredNumberOfThread{ 0 };
+
+#if VTK_SMP_ENABLE_SEQUENTIAL
+  std::unique_ptr<vtkSMPToolsImpl<BackendType::Sequential> > SequentialBackend;
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+  std::unique_ptr<vtkSMPToolsImpl<BackendType::STDThread> > STDThreadBackend;
+#endif
+#if VTK_SMP_ENABLE_TBB
+  std::unique_ptr<vtkSMPToolsImpl<BackendType::TBB> > TBBBackend;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+  std::unique_ptr<vtkSMPToolsImpl<BackendType::OpenMP> > OpenMPBackend;
+#endif
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif // __VTK_WRAP__
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsAPI.h
@@ -0,0 +1,249 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// vtkSMPToolsImpl is the interface every vtkSMPTools back-end implements.
+// It is specialized for each enabled BackendType in SMP/<Backend>/
+// vtkSMPToolsImpl.txx; all enabled back-ends are compiled into the same
+// library and vtkSMPToolsAPI dispatches to the one selected at run time.
+//
+// Nested parallelism policy: when For() is called from a thread that is
+// already executing a For() (see IsParallelScope()), it is executed serially
+// by the calling thread unless nested parallelism is activated. Back-ends that
+// run nested loops on the same thread pool (STDThread, TBB) activate it by
+// default since that cannot oversubscribe the machine; OpenMP does not,
+// because every nested parallel region would start a new team of threads.
+
+#ifndef vtkSMPToolsImpl_h
+#define vtkSMPToolsImpl_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSMP.h"              // For VTK_SMP_ENABLE_*
+#include "vtkSystemIncludes.h"
+
+#include <algorithm> // For std::sort, std::stable_sort, std::inplace_merge
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+enum class BackendType
+{
+  Sequential = 0,
+  STDThread = 1,
+  TBB = 2,
+  OpenMP = 3
+};
+
+const int NumberOfBackends = 4;
+
+#if VTK_SMP_DEFAULT_IMPLEMENTATION_SEQUENTIAL
+const BackendType DefaultBackend = BackendType::Sequential;
+#elif VTK_SMP_DEFAULT_IMPLEMENTATION_STDTHREAD
+const BackendType DefaultBackend = BackendType::STDThread;
+#elif VTK_SMP_DEFAULT_IMPLEMENTATION_TBB
+const BackendType DefaultBackend = BackendType::TBB;
+#elif VTK_SMP_DEFAULT_IMPLEMENTATION_OPENMP
+const BackendType DefaultBackend = BackendType::OpenMP;
+#endif
+
+template <BackendType Backend>
+class VTKCOMMONCORE_EXPORT vtkSMPToolsImpl
+{
+public:
+  vtkSMPToolsImpl()
+    : NestedActivated(Backend == BackendType::STDThread || Backend == BackendType::TBB)
+  {
+  }
+
+  //--------------------------------------------------------------------------------
+  void Initialize(int numThreads = 0);
+
+  //--------------------------------------------------------------------------------
+  int GetEstimatedNumberOfThreads();
+
+  //--------------------------------------------------------------------------------
+  void SetNestedParallelism(bool isNested) { this->NestedActivated = isNested; }
+
+  //--------------------------------------------------------------------------------
+  bool GetNestedParallelism() { return this->NestedActivated; }
+
+  //--------------------------------------------------------------------------------
+  bool IsParallelScope();
+
+  //--------------------------------------------------------------------------------
+  template <typename FunctorInternal>
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi);
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end);
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Compare>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Compare>
+  void StableSort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
+
+private:
+  bool NestedActivated;
+};
+
+//--------------------------------------------------------------------------------
+// Execute [first, last) serially on the calling thread, cut into grain sized
+// pieces. This is the whole Sequential back-end and what the other back-ends
+// fall back to for nested loops when nested parallelism is not activated.
+template <typename FunctorInternal>
+void vtkSMPToolsImpl_SerialFor(
+  vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  vtkIdType n = last - first;
+  if (n <= 0)
+  {
+    return;
+  }
+
+  if (grain <= 0 || grain >= n)
+  {
+    fi.Execute(first, last);
+  }
+  else
+  {
+    vtkIdType b = first;
+    while (b < last)
+    {
+      vtkIdType e = b + grain;
+      if (e > last)
+      {
+        e = last;
+      }
+      fi.Execute(b, e);
+      b = e;
+    }
+  }
+}
+
+//--------------------------------------------------------------------------------
+// Parallel block sort: the sequence is cut into one block per thread, the
+// blocks are sorted concurrently and then merged pairwise in log2(blocks)
+// parallel rounds. std::inplace_merge is stable, so the result is stable when
+// the blocks are sorted with std::stable_sort.
+template <typename RandomAccessIterator, typename Compare>
+class vtkSMPToolsImpl_SortBlocks
+{
+public:
+  RandomAccessIterator Begin;
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  vtkIdType Width; // number of sorted blocks merged per task, 1 == sort
+  Compare Comp;
+  bool Stable;
+
+  vtkSMPToolsImpl_SortBlocks(RandomAccessIterator begin, vtkIdType size, vtkIdType blockSize,
+    Compare comp, bool stable)
+    : Begin(begin)
+    , Size(size)
+    , BlockSize(blockSize)
+    , Width(1)
+    , Comp(comp)
+    , Stable(stable)
+  {
+  }
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType task = first; task < last; ++task)
+    {
+      vtkIdType b = task * this->Width * this->BlockSize;
+      vtkIdType e = std::min(b + this->Width * this->BlockSize, this->Size);
+      if (this->Width == 1)
+      {
+        if (this->Stable)
+        {
+          std::stable_sort(this->Begin + b, this->Begin + e, this->Comp);
+        }
+        else
+        {
+          std::sort(this->Begin + b, this->Begin + e, this->Comp);
+        }
+      }
+      else
+      {
+        vtkIdType m = std::min(b + (this->Width / 2) * this->BlockSize, this->Size);
+        if (m < e)
+        {
+          std::inplace_merge(this->Begin + b, this->Begin + m, this->Begin + e, this->Comp);
+        }
+      }
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Sort [begin, end) with the For() of the given back-end, see
+// vtkSMPToolsImpl_SortBlocks. Small sequences and nested calls that may not
+// run in parallel are sorted serially.
+template <BackendType Backend, typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl_BlockSort(vtkSMPToolsImpl<Backend>& impl, RandomAccessIterator begin,
+  RandomAccessIterator end, Compare comp, bool stable)
+{
+  const vtkIdType size = static_cast<vtkIdType>(end - begin);
+  const vtkIdType minimumBlockSize = 8192; // below this, the serial sort wins
+  vtkIdType numThreads = 1;
+  if (size >= 2 * minimumBlockSize && (impl.GetNestedParallelism() || !impl.IsParallelScope()))
+  {
+    numThreads = impl.GetEstimatedNumberOfThreads();
+  }
+  if (numThreads <= 1)
+  {
+    if (stable)
+    {
+      std::stable_sort(begin, end, comp);
+    }
+    else
+    {
+      std::sort(begin, end, comp);
+    }
+    return;
+  }
+
+  vtkIdType numBlocks = std::min(numThreads, size / minimumBlockSize);
+  vtkIdType blockSize = (size + numBlocks - 1) / numBlocks;
+
+  vtkSMPToolsImpl_SortBlocks<RandomAccessIterator, Compare> sorter(
+    begin, size, blockSize, comp, stable);
+  impl.For(0, numBlocks, 1, sorter);
+  for (sorter.Width = 2; sorter.Width / 2 < numBlocks; sorter.Width *= 2)
+  {
+    vtkIdType numMerges = (numBlocks + sorter.Width - 1) / sorter.Width;
+    impl.For(0, numMerges, 1, sorter);
+  }
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif // __VTK_WRAP__
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsImpl.h
@@ -1,7 +1,7 @@
 /*=========================================================================
 
   Program:   Visualization Toolkit
-  Module:    vtkSMPThreadLocalImpl.h
+  Module:    vtkSMPThreadLocalBackend.h
 
   Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
   All rights reserved.
@@ -29,8 +29,8 @@
 // safe and only blocks when a new array needs to be allocated, which should be
 // rare.
 
-#ifndef vtkSMPThreadLocalImpl_h
-#define vtkSMPThreadLocalImpl_h
+#ifndef OpenMPvtkSMPThreadLocalBackend_h
+#define OpenMPvtkSMPThreadLocalBackend_h
 
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkConfigure.h"
@@ -40,8 +40,14 @@
 #include <omp.h>
 
 
+namespace vtk
+{
 namespace detail
 {
+namespace smp
+{
+namespace OpenMP
+{
 
 typedef void* ThreadIdType;
 typedef vtkTypeUInt32 HashType;
@@ -182,7 +188,10 @@ private:
   size_t CurrentSlot;
 };
 
-} // detail;
+} // namespace OpenMP
+} // namespace smp
+} // namespace detail
+} // namespace vtk
 
 #endif
-// VTK-HeaderTest-Exclude: vtkSMPThreadLocalImpl.h
+// VTK-HeaderTest-Exclude: vtkSMPThreadLocalBackend.h
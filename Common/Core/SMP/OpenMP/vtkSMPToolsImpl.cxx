@@ -0,0 +1,93 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "SMP/OpenMP/vtkSMPToolsImpl.txx"
+
+#include <omp.h>
+
+#include <algorithm>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+namespace
+{
+int vtkSMPNumberOfSpecifiedThreads = 0;
+}
+
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int numThreads)
+{
+#pragma omp single
+  if (numThreads)
+  {
+    vtkSMPNumberOfSpecifiedThreads = numThreads;
+    omp_set_num_threads(numThreads);
+  }
+}
+
+//------------------------------------------------------------------------------
+template <>
+int vtkSMPToolsImpl<BackendType::OpenMP>::GetEstimatedNumberOfThreads()
+{
+  return GetNumberOfThreadsOpenMP();
+}
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::OpenMP>::IsParallelScope()
+{
+  return omp_in_parallel() != 0;
+}
+
+//------------------------------------------------------------------------------
+int GetNumberOfThreadsOpenMP()
+{
+  return vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads : omp_get_max_threads();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated)
+{
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = (last - first) / (omp_get_max_threads() * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  // Nested regions only get their own team of threads when more than one
+  // level of parallelism is active. This can only be changed from the
+  // outermost level.
+  if (!omp_in_parallel())
+  {
+    omp_set_max_active_levels(nestedActivated ? 2 : 1);
+  }
+
+#pragma omp parallel for schedule(runtime)
+  for (vtkIdType from = first; from < last; from += grain)
+  {
+    functorExecuter(functor, from, grain, last);
+  }
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
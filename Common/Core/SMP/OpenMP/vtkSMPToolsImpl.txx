@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef OpenMPvtkSMPToolsImpl_txx
+#define OpenMPvtkSMPToolsImpl_txx
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "vtkCommonCoreModule.h" // For export macro
+
+#include <functional> //for std::less
+#include <iterator>   //for std::iterator_traits
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+typedef void (*ExecuteFunctorPtrType)(void*, vtkIdType, vtkIdType, vtkIdType);
+
+int VTKCOMMONCORE_EXPORT GetNumberOfThreadsOpenMP();
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated);
+
+//--------------------------------------------------------------------------------
+template <>
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int);
+
+//--------------------------------------------------------------------------------
+template <>
+int VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::OpenMP>::GetEstimatedNumberOfThreads();
+
+//--------------------------------------------------------------------------------
+template <>
+bool VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::OpenMP>::IsParallelScope();
+
+//--------------------------------------------------------------------------------
+template <typename FunctorInternal>
+void ExecuteFunctorOpenMP(void* functor, vtkIdType from, vtkIdType grain, vtkIdType last)
+{
+  vtkIdType to = from + grain;
+  if (to > last)
+  {
+    to = last;
+  }
+
+  FunctorInternal& fi = *reinterpret_cast<FunctorInternal*>(functor);
+  fi.Execute(from, to);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename FunctorInternal>
+void vtkSMPToolsImpl<BackendType::OpenMP>::For(
+  vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  vtkIdType n = last - first;
+  if (n <= 0)
+  {
+    return;
+  }
+
+  if (grain >= n || (!this->NestedActivated && this->IsParallelScope()))
+  {
+    fi.Execute(first, last);
+  }
+  else
+  {
+    vtkSMPToolsImplForOpenMP(
+      first, last, grain, ExecuteFunctorOpenMP<FunctorInternal>, &fi, this->NestedActivated);
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator>
+void vtkSMPToolsImpl<BackendType::OpenMP>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end)
+{
+  typedef typename std::iterator_traits<RandomAccessIterator>::value_type ValueType;
+  this->Sort(begin, end, std::less<ValueType>());
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::OpenMP>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  vtkSMPToolsImpl_BlockSort(*this, begin, end, comp, false);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::OpenMP>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  vtkSMPToolsImpl_BlockSort(*this, begin, end, comp, true);
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadLocalImpl.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// A thread local storage implementation using the lock-free hash table of
+// vtkSMPThreadLocalBackend.h, keyed by std::thread.
+
+#ifndef STDThreadvtkSMPThreadLocalImpl_h
+#define STDThreadvtkSMPThreadLocalImpl_h
+
+#include "SMP/Common/vtkSMPThreadLocalImplAbstract.h"
+#include "SMP/STDThread/vtkSMPThreadLocalBackend.h"
+#include "SMP/STDThread/vtkSMPToolsImpl.txx" // For GetNumberOfThreadsSTDThread()
+
+#include <memory>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+template <typename T>
+class vtkSMPThreadLocalImpl<BackendType::STDThread, T> : public vtkSMPThreadLocalImplAbstract<T>
+{
+  typedef typename vtkSMPThreadLocalImplAbstract<T>::ItImpl ItImplAbstract;
+
+public:
+  vtkSMPThreadLocalImpl()
+    : Backend(GetNumberOfThreadsSTDThread())
+  {
+  }
+
+  explicit vtkSMPThreadLocalImpl(const T& exemplar)
+    : Backend(GetNumberOfThreadsSTDThread())
+    , Exemplar(exemplar)
+  {
+  }
+
+  ~vtkSMPThreadLocalImpl() override
+  {
+    STDThread::ThreadSpecificStorageIterator it;
+    it.SetThreadSpecificStorage(this->Backend);
+    for (it.SetToBegin(); !it.GetAtEnd(); it.Forward())
+    {
+      delete reinterpret_cast<T*>(it.GetStorage());
+    }
+  }
+
+  T& Local() override
+  {
+    STDThread::StoragePointerType& ptr = this->Backend.GetStorage();
+    T* local = reinterpret_cast<T*>(ptr);
+    if (!ptr)
+    {
+      ptr = local = new T(this->Exemplar);
+    }
+    return *local;
+  }
+
+  size_t size() const override { return this->Backend.Size(); }
+
+  class ItImpl : public vtkSMPThreadLocalImplAbstract<T>::ItImpl
+  {
+  public:
+    void Increment() override { this->Impl.Forward(); }
+
+    bool Compare(ItImplAbstract* other) override
+    {
+      return this->Impl == static_cast<ItImpl*>(other)->Impl;
+    }
+
+    T& GetContent() override { return *reinterpret_cast<T*>(this->Impl.GetStorage()); }
+
+    T* GetContentPtr() override { return reinterpret_cast<T*>(this->Impl.GetStorage()); }
+
+  protected:
+    ItImpl* CloneImpl() const override { return new ItImpl(*this); }
+
+  private:
+    STDThread::ThreadSpecificStorageIterator Impl;
+
+    friend class vtkSMPThreadLocalImpl<BackendType::STDThread, T>;
+  };
+
+  std::unique_ptr<ItImplAbstract> begin() override
+  {
+    std::unique_ptr<ItImpl> it(new ItImpl());
+    it->Impl.SetThreadSpecificStorage(this->Backend);
+    it->Impl.SetToBegin();
+    // XXX(c++14): remove std::move and cast variable
+    std::unique_ptr<ItImplAbstract> abstractIt(std::move(it));
+    return abstractIt;
+  }
+
+  std::unique_ptr<ItImplAbstract> end() override
+  {
+    std::unique_ptr<ItImpl> it(new ItImpl());
+    it->Impl.SetThreadSpecificStorage(this->Backend);
+    it->Impl.SetToEnd();
+    // XXX(c++14): remove std::move and cast variable
+    std::unique_ptr<ItImplAbstract> abstractIt(std::move(it));
+    return abstractIt;
+  }
+
+private:
+  STDThread::ThreadSpecific Backend;
+  T Exemplar;
+
+  // disable copying
+  vtkSMPThreadLocalImpl(const vtkSMPThreadLocalImpl&) = delete;
+  void operator=(const vtkSMPThreadLocalImpl&) = delete;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadLocalImpl.h
@@ -0,0 +1,380 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "SMP/STDThread/vtkSMPToolsImpl.txx"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+namespace
+{
+std::atomic<int> vtkSMPNumberOfSpecifiedThreads(0);
+
+//------------------------------------------------------------------------------
+// One vtkSMPTools::For() invocation. Pending counts the indices that have not
+// been processed yet; the For() returns once it reaches zero.
+struct vtkSMPJob
+{
+  ExecuteFunctorPtrType Executer;
+  void* Functor;
+  vtkIdType Grain;
+  std::atomic<vtkIdType> Pending;
+};
+
+// A contiguous range [Begin, End) of a job that has not been executed yet.
+struct vtkSMPTask
+{
+  vtkSMPJob* Job;
+  vtkIdType Begin;
+  vtkIdType End;
+};
+
+// Task queue owned by one worker. The owner works at the back, thieves take
+// from the front.
+struct vtkSMPTaskQueue
+{
+  std::mutex Lock;
+  std::deque<vtkSMPTask> Tasks;
+};
+
+//------------------------------------------------------------------------------
+class vtkSMPThreadPool
+{
+public:
+  explicit vtkSMPThreadPool(int numThreads);
+  ~vtkSMPThreadPool();
+
+  int GetNumberOfThreads() const { return this->NumberOfWorkers + 1; }
+
+  // Execute the job on the pool. The calling thread participates and does
+  // not return before all the indices in [first, last) have been processed.
+  void Run(vtkSMPJob& job, vtkIdType first, vtkIdType last);
+
+private:
+  void WorkerLoop(int index);
+  void Push(const vtkSMPTask& task);
+  void Execute(vtkSMPTask task);
+  bool PopLocal(vtkSMPTask& task, const vtkSMPJob* job);
+  bool Steal(vtkSMPTask& task, const vtkSMPJob* job);
+
+  int NumberOfWorkers;
+  std::vector<std::unique_ptr<vtkSMPTaskQueue> > Queues;
+  std::vector<std::thread> Threads;
+
+  std::atomic<vtkIdType> QueuedTasks;
+  std::atomic<int> IdleWorkers;
+  std::atomic<unsigned int> NextQueue;
+  std::mutex WakeLock;
+  std::condition_variable WakeCondition;
+  bool Stop;
+
+  vtkSMPThreadPool(const vtkSMPThreadPool&) = delete;
+  void operator=(const vtkSMPThreadPool&) = delete;
+};
+
+// Identify the worker (and the pool it belongs to) executing on this thread.
+// Threads that do not belong to a pool have a null LocalPool.
+thread_local vtkSMPThreadPool* LocalPool = nullptr;
+thread_local int LocalWorkerIndex = -1;
+
+// Number of tasks being executed by this thread, nested For() included.
+thread_local int LocalParallelScopeDepth = 0;
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::vtkSMPThreadPool(int numThreads)
+  : NumberOfWorkers(std::max(numThreads - 1, 1))
+  , QueuedTasks(0)
+  , IdleWorkers(0)
+  , NextQueue(0)
+  , Stop(false)
+{
+  for (int i = 0; i < this->NumberOfWorkers; ++i)
+  {
+    this->Queues.emplace_back(new vtkSMPTaskQueue);
+  }
+  for (int i = 0; i < this->NumberOfWorkers; ++i)
+  {
+    this->Threads.emplace_back(&vtkSMPThreadPool::WorkerLoop, this, i);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::~vtkSMPThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->WakeLock);
+    this->Stop = true;
+  }
+  this->WakeCondition.notify_all();
+  for (auto& thread : this->Threads)
+  {
+    thread.join();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Push(const vtkSMPTask& task)
+{
+  int index = (LocalPool == this)
+    ? LocalWorkerIndex
+    : static_cast<int>(this->NextQueue++ % static_cast<unsigned int>(this->NumberOfWorkers));
+  vtkSMPTaskQueue& queue = *this->Queues[index];
+  {
+    std::lock_guard<std::mutex> lock(queue.Lock);
+    queue.Tasks.push_back(task);
+  }
+  ++this->QueuedTasks;
+
+  // Only pay for the wake-up when somebody is actually sleeping.
+  if (this->IdleWorkers.load() > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->WakeLock);
+    }
+    this->WakeCondition.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Split the task in halves, keeping the lower half and pushing the upper one
+// for other threads to steal, until it is no larger than the grain. Then run
+// it.
+void vtkSMPThreadPool::Execute(vtkSMPTask task)
+{
+  vtkSMPJob* job = task.Job;
+  const vtkIdType grain = job->Grain;
+  while (task.End - task.Begin > grain)
+  {
+    vtkIdType numberOfChunks = (task.End - task.Begin + grain - 1) / grain;
+    vtkIdType middle = task.Begin + (numberOfChunks / 2) * grain;
+    this->Push(vtkSMPTask{ job, middle, task.End });
+    task.End = middle;
+  }
+
+  const vtkIdType size = task.End - task.Begin;
+  ++LocalParallelScopeDepth;
+  job->Executer(job->Functor, task.Begin, size, task.End);
+  --LocalParallelScopeDepth;
+  job->Pending -= size;
+}
+
+//------------------------------------------------------------------------------
+// Pop from the back of the queue of the calling worker. When job is not null,
+// only a task of that job is accepted.
+bool vtkSMPThreadPool::PopLocal(vtkSMPTask& task, const vtkSMPJob* job)
+{
+  if (LocalPool != this)
+  {
+    return false;
+  }
+  vtkSMPTaskQueue& queue = *this->Queues[LocalWorkerIndex];
+  std::lock_guard<std::mutex> lock(queue.Lock);
+  if (queue.Tasks.empty() || (job && queue.Tasks.back().Job != job))
+  {
+    return false;
+  }
+  task = queue.Tasks.back();
+  queue.Tasks.pop_back();
+  --this->QueuedTasks;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Take the oldest (and therefore largest) task from another queue. When job
+// is not null, only a task of that job is accepted.
+bool vtkSMPThreadPool::Steal(vtkSMPTask& task, const vtkSMPJob* job)
+{
+  const int start = (LocalPool == this) ? LocalWorkerIndex + 1 : 0;
+  for (int i = 0; i < this->NumberOfWorkers; ++i)
+  {
+    vtkSMPTaskQueue& queue = *this->Queues[(start + i) % this->NumberOfWorkers];
+    std::lock_guard<std::mutex> lock(queue.Lock);
+    auto it = queue.Tasks.begin();
+    if (job)
+    {
+      it = std::find_if(queue.Tasks.begin(), queue.Tasks.end(),
+        [job](const vtkSMPTask& t) { return t.Job == job; });
+    }
+    if (it != queue.Tasks.end())
+    {
+      task = *it;
+      queue.Tasks.erase(it);
+      --this->QueuedTasks;
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::WorkerLoop(int index)
+{
+  LocalPool = this;
+  LocalWorkerIndex = index;
+
+  for (;;)
+  {
+    vtkSMPTask task;
+    if (this->PopLocal(task, nullptr) || this->Steal(task, nullptr))
+    {
+      this->Execute(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->WakeLock);
+    ++this->IdleWorkers;
+    this->WakeCondition.wait(
+      lock, [this]() { return this->Stop || this->QueuedTasks.load() > 0; });
+    --this->IdleWorkers;
+    if (this->Stop)
+    {
+      break;
+    }
+  }
+
+  LocalPool = nullptr;
+  LocalWorkerIndex = -1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Run(vtkSMPJob& job, vtkIdType first, vtkIdType last)
+{
+  job.Pending = last - first;
+  this->Execute(vtkSMPTask{ &job, first, last });
+
+  // Help with the remaining tasks of this job only: picking up unrelated work
+  // here could re-enter a functor that is waiting on us (nested For()).
+  while (job.Pending.load() > 0)
+  {
+    vtkSMPTask task;
+    if (this->PopLocal(task, &job) || this->Steal(task, &job))
+    {
+      this->Execute(task);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// The pool is created on first use and replaced when Initialize() asks for a
+// different number of threads. Each outermost For() holds a reference to the
+// pool it runs on, so a pool that is replaced during a For() is only
+// destroyed, and its workers joined, by the thread that started that For()
+// once it returns. Nested For() calls from workers run on the pool of the
+// worker, which the outermost For() keeps alive.
+std::mutex vtkSMPThreadPoolLock;
+std::shared_ptr<vtkSMPThreadPool> vtkSMPThreadPoolInstance;
+
+std::shared_ptr<vtkSMPThreadPool> GetThreadPool()
+{
+  std::lock_guard<std::mutex> lock(vtkSMPThreadPoolLock);
+  if (!vtkSMPThreadPoolInstance)
+  {
+    vtkSMPThreadPoolInstance =
+      std::make_shared<vtkSMPThreadPool>(GetNumberOfThreadsSTDThread());
+  }
+  return vtkSMPThreadPoolInstance;
+}
+} // namespace
+
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::STDThread>::Initialize(int numThreads)
+{
+  // The previous pool is released outside of the lock: when no For() uses it
+  // anymore, its destruction joins its workers.
+  std::shared_ptr<vtkSMPThreadPool> previousPool;
+  std::lock_guard<std::mutex> lock(vtkSMPThreadPoolLock);
+  if (numThreads != vtkSMPNumberOfSpecifiedThreads.load())
+  {
+    vtkSMPNumberOfSpecifiedThreads = std::max(numThreads, 0);
+    if (vtkSMPThreadPoolInstance &&
+      vtkSMPThreadPoolInstance->GetNumberOfThreads() != GetNumberOfThreadsSTDThread())
+    {
+      previousPool.swap(vtkSMPThreadPoolInstance);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+template <>
+int vtkSMPToolsImpl<BackendType::STDThread>::GetEstimatedNumberOfThreads()
+{
+  return GetNumberOfThreadsSTDThread();
+}
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::STDThread>::IsParallelScope()
+{
+  return LocalParallelScopeDepth > 0;
+}
+
+//------------------------------------------------------------------------------
+int GetNumberOfThreadsSTDThread()
+{
+  const int numThreads = vtkSMPNumberOfSpecifiedThreads.load();
+  if (numThreads)
+  {
+    return numThreads;
+  }
+  unsigned int hardwareThreads = std::thread::hardware_concurrency();
+  return hardwareThreads ? static_cast<int>(hardwareThreads) : 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsImplForSTDThread(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  // Keep the pool alive for the duration of an outermost For().
+  std::shared_ptr<vtkSMPThreadPool> sharedPool;
+  if (!LocalPool)
+  {
+    sharedPool = GetThreadPool();
+  }
+  vtkSMPThreadPool& pool = LocalPool ? *LocalPool : *sharedPool;
+  if (grain <= 0)
+  {
+    // Several chunks per thread so that stealing can balance uneven work.
+    vtkIdType estimateGrain = (last - first) / (pool.GetNumberOfThreads() * 8);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  vtkSMPJob job;
+  job.Executer = functorExecuter;
+  job.Functor = functor;
+  job.Grain = grain;
+  pool.Run(job, first, last);
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// The STDThread backend executes vtkSMPTools::For() on a persistent pool of
+// std::thread workers. Each worker owns a double-ended task queue: the owner
+// pushes and pops range tasks at the back (depth first, cache friendly)
+// while idle workers steal from the front, where the largest ranges are.
+// Ranges are split lazily in halves down to the grain size, so the number of
+// queued tasks stays logarithmic in the number of chunks. A thread waiting
+// for a For() to complete (including a nested For() issued from inside a
+// task) keeps executing tasks of that same For(), which makes nested calls
+// safe without oversubscribing the machine.
+
+#ifndef STDThreadvtkSMPToolsImpl_txx
+#define STDThreadvtkSMPToolsImpl_txx
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "vtkCommonCoreModule.h" // For export macro
+
+#include <functional> //for std::less
+#include <iterator>   //for std::iterator_traits
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+typedef void (*ExecuteFunctorPtrType)(void*, vtkIdType, vtkIdType, vtkIdType);
+
+int VTKCOMMONCORE_EXPORT GetNumberOfThreadsSTDThread();
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForSTDThread(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void* functor);
+
+//--------------------------------------------------------------------------------
+template <>
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::STDThread>::Initialize(int);
+
+//--------------------------------------------------------------------------------
+template <>
+int VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::STDThread>::GetEstimatedNumberOfThreads();
+
+//--------------------------------------------------------------------------------
+template <>
+bool VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::STDThread>::IsParallelScope();
+
+//--------------------------------------------------------------------------------
+template <typename FunctorInternal>
+void ExecuteFunctorSTDThread(void* functor, vtkIdType from, vtkIdType grain, vtkIdType last)
+{
+  vtkIdType to = from + grain;
+  if (to > last)
+  {
+    to = last;
+  }
+
+  FunctorInternal& fi = *reinterpret_cast<FunctorInternal*>(functor);
+  fi.Execute(from, to);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename FunctorInternal>
+void vtkSMPToolsImpl<BackendType::STDThread>::For(
+  vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  vtkIdType n = last - first;
+  if (n <= 0)
+  {
+    return;
+  }
+
+  if (grain >= n || GetNumberOfThreadsSTDThread() == 1 ||
+    (!this->NestedActivated && this->IsParallelScope()))
+  {
+    fi.Execute(first, last);
+  }
+  else
+  {
+    vtkSMPToolsImplForSTDThread(
+      first, last, grain, ExecuteFunctorSTDThread<FunctorInternal>, &fi);
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  vtkSMPToolsImpl_BlockSort(*this, begin, end, comp, false);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator>
+void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end)
+{
+  typedef typename std::iterator_traits<RandomAccessIterator>::value_type ValueType;
+  this->Sort(begin, end, std::less<ValueType>());
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::STDThread>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  vtkSMPToolsImpl_BlockSort(*this, begin, end, comp, true);
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
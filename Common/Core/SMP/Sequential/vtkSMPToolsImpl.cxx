@@ -1,7 +1,7 @@
 /*=========================================================================
 
   Program:   Visualization Toolkit
-  Module:    vtkSMPTools.cxx
+  Module:    vtkSMPToolsImpl.cxx
 
   Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
   All rights reserved.
@@ -13,21 +13,38 @@
 
 =========================================================================*/
 
-#include "vtkSMPTools.h"
-
-#include "vtkSMP.h"
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "SMP/Sequential/vtkSMPToolsImpl.txx"
 
 // Simple implementation that runs everything sequentially.
 
-const char* vtkSMPTools::GetBackend()
+namespace vtk
+{
+namespace detail
+{
+namespace smp
 {
-  return VTK_SMP_BACKEND;
-}
 
 //------------------------------------------------------------------------------
-void vtkSMPTools::Initialize(int) {}
+template <>
+void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int)
+{
+}
 
-int vtkSMPTools::GetEstimatedNumberOfThreads()
+//------------------------------------------------------------------------------
+template <>
+int vtkSMPToolsImpl<BackendType::Sequential>::GetEstimatedNumberOfThreads()
 {
   return 1;
 }
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::Sequential>::IsParallelScope()
+{
+  return false;
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
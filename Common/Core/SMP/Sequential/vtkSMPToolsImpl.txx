@@ -0,0 +1,82 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef SequentialvtkSMPToolsImpl_txx
+#define SequentialvtkSMPToolsImpl_txx
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+
+#include <algorithm> //for std::sort(), std::stable_sort()
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+//--------------------------------------------------------------------------------
+template <>
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
+
+//--------------------------------------------------------------------------------
+template <>
+int VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::Sequential>::GetEstimatedNumberOfThreads();
+
+//--------------------------------------------------------------------------------
+template <>
+bool VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::Sequential>::IsParallelScope();
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename FunctorInternal>
+void vtkSMPToolsImpl<BackendType::Sequential>::For(
+  vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  vtkSMPToolsImpl_SerialFor(first, last, grain, fi);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator>
+void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end)
+{
+  std::sort(begin, end);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  std::sort(begin, end, comp);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::Sequential>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  std::stable_sort(begin, end, comp);
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
@@ -1,7 +1,7 @@
 /*=========================================================================
 
   Program:   Visualization Toolkit
-  Module:    vtkSMPTools.cxx
+  Module:    vtkSMPToolsImpl.cxx
 
   Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
   All rights reserved.
@@ -13,10 +13,10 @@
 
 =========================================================================*/
 
-#include "vtkSMPTools.h"
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "SMP/TBB/vtkSMPToolsImpl.txx"
 
 #include "vtkCriticalSection.h"
-#include "vtkSMP.h"
 
 #ifdef _MSC_VER
 #pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
@@ -29,6 +29,13 @@
 #pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
 #endif
 
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
 struct vtkSMPToolsInit
 {
   tbb::task_scheduler_init Init;
@@ -44,13 +51,8 @@ static int vtkTBBNumSpecifiedThreads = 0;
 static vtkSimpleCriticalSection vtkSMPToolsCS;
 
 //------------------------------------------------------------------------------
-const char* vtkSMPTools::GetBackend()
-{
-  return VTK_SMP_BACKEND;
-}
-
-//------------------------------------------------------------------------------
-void vtkSMPTools::Initialize(int numThreads)
+template <>
+void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int numThreads)
 {
   vtkSMPToolsCS.Lock();
   if (!vtkSMPToolsInitialized)
@@ -68,8 +70,27 @@ void vtkSMPTools::Initialize(int numThreads)
 }
 
 //------------------------------------------------------------------------------
-int vtkSMPTools::GetEstimatedNumberOfThreads()
+template <>
+int vtkSMPToolsImpl<BackendType::TBB>::GetEstimatedNumberOfThreads()
 {
   return vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
                                    : tbb::task_scheduler_init::default_num_threads();
 }
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::TBB>::IsParallelScope()
+{
+  return GetParallelScopeDepthTBB() > 0;
+}
+
+//------------------------------------------------------------------------------
+int& GetParallelScopeDepthTBB()
+{
+  static thread_local int depth = 0;
+  return depth;
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -1,7 +1,7 @@
 /*=========================================================================
 
   Program:   Visualization Toolkit
-  Module:    vtkSMPToolsInternal.h.in
+  Module:    vtkSMPToolsImpl.txx
 
   Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
   All rights reserved.
@@ -12,11 +12,16 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
-#include "vtkNew.h"
+
+#ifndef TBBvtkSMPToolsImpl_txx
+#define TBBvtkSMPToolsImpl_txx
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "vtkCommonCoreModule.h" // For export macro
 
 #ifdef _MSC_VER
-#  pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
-#  define __TBB_NO_IMPLICIT_LINKAGE 1
+#pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#define __TBB_NO_IMPLICIT_LINKAGE 1
 #endif
 
 #include <tbb/blocked_range.h>
@@ -24,7 +29,7 @@
 #include <tbb/parallel_sort.h>
 
 #ifdef _MSC_VER
-#  pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
 #endif
 
 namespace vtk
@@ -34,6 +39,21 @@ namespace detail
 namespace smp
 {
 
+// Number of FuncCall being executed by the calling thread.
+VTKCOMMONCORE_EXPORT int& GetParallelScopeDepthTBB();
+
+//--------------------------------------------------------------------------------
+template <>
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::TBB>::Initialize(int);
+
+//--------------------------------------------------------------------------------
+template <>
+int VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::TBB>::GetEstimatedNumberOfThreads();
+
+//--------------------------------------------------------------------------------
+template <>
+bool VTKCOMMONCORE_EXPORT vtkSMPToolsImpl<BackendType::TBB>::IsParallelScope();
+
 //--------------------------------------------------------------------------------
 template <typename T>
 class FuncCall
@@ -43,30 +63,40 @@ class FuncCall
   void operator=(const FuncCall&) = delete;
 
 public:
-  void operator() (const tbb::blocked_range<vtkIdType>& r) const
+  void operator()(const tbb::blocked_range<vtkIdType>& r) const
   {
-      o.Execute(r.begin(), r.end());
+    int& depth = GetParallelScopeDepthTBB();
+    ++depth;
+    o.Execute(r.begin(), r.end());
+    --depth;
   }
 
-  FuncCall (T& _o) : o(_o)
+  FuncCall(T& _o)
+    : o(_o)
   {
   }
 };
 
 //--------------------------------------------------------------------------------
+template <>
 template <typename FunctorInternal>
-void vtkSMPTools_Impl_For(
-  vtkIdType first, vtkIdType last, vtkIdType grain,
-  FunctorInternal& fi)
+void vtkSMPToolsImpl<BackendType::TBB>::For(
+  vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
 {
   vtkIdType range = last - first;
   if (range <= 0)
   {
     return;
   }
+  if (!this->NestedActivated && this->IsParallelScope())
+  {
+    fi.Execute(first, last);
+    return;
+  }
   if (grain > 0)
   {
-    tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, grain), FuncCall<FunctorInternal>(fi));
+    tbb::parallel_for(
+      tbb::blocked_range<vtkIdType>(first, last, grain), FuncCall<FunctorInternal>(fi));
   }
   else
   {
@@ -79,7 +109,8 @@ void vtkSMPTools_Impl_For(
     if (range >= batches)
     {
       vtkIdType calculatedGrain = ((range - 1) / batches) + 1; // std::ceil round up for systems without cmath
-      tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, calculatedGrain), FuncCall<FunctorInternal>(fi));
+      tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, calculatedGrain),
+        FuncCall<FunctorInternal>(fi));
     }
     else
     {
@@ -91,23 +122,34 @@ void vtkSMPTools_Impl_For(
 }
 
 //--------------------------------------------------------------------------------
-template<typename RandomAccessIterator>
-void vtkSMPTools_Impl_Sort(RandomAccessIterator begin,
-                                  RandomAccessIterator end)
+template <>
+template <typename RandomAccessIterator>
+void vtkSMPToolsImpl<BackendType::TBB>::Sort(RandomAccessIterator begin, RandomAccessIterator end)
 {
   tbb::parallel_sort(begin, end);
 }
 
 //--------------------------------------------------------------------------------
-template<typename RandomAccessIterator, typename Compare>
-void vtkSMPTools_Impl_Sort(RandomAccessIterator begin,
-                                  RandomAccessIterator end,
-                                  Compare comp)
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::TBB>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
 {
   tbb::parallel_sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+// tbb::parallel_sort is not stable.
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::TBB>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  vtkSMPToolsImpl_BlockSort(*this, begin, end, comp, true);
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
 
-}//namespace smp
-}//namespace detail
-}//namespace vtk
+#endif
@@ -1,6 +1,9 @@
 #include "vtkDoubleArray.h"
 #include "vtkIntArray.h"
 #include "vtkMathUtilities.h"
+#include "vtkPoints.h"
+
+#include <cmath>
 
 // Define this to run benchmarking tests on some vtkDataArray methods:
 #undef BENCHMARK
@@ -207,7 +210,53 @@ int TestDataArray(int, char*[])
     cout << " " << fa[0] << "," << fa[1] << "," << fa[2];
   }
   cout << endl;
+
+  // The max norm comes from the cached magnitude range.
+  double maxNorm = std::sqrt(8.125 * 8.125 + 8.25 * 8.25 + 8.375 * 8.375);
+  if (!vtkMathUtilities::FuzzyCompare(farray->GetMaxNorm(), maxNorm))
+  {
+    cerr << "Max norm " << farray->GetMaxNorm() << " <> " << maxNorm << endl;
+    farray->Delete();
+    return 1;
+  }
+  farray->SetTuple3(0, 20.0, 0.0, 0.0);
+  farray->Modified();
+  if (farray->GetMaxNorm() != 20.0)
+  {
+    cerr << "Max norm of modified array " << farray->GetMaxNorm() << " <> 20" << endl;
+    farray->Delete();
+    return 1;
+  }
+
+  // The bounds of points are the ranges of their components.
+  vtkPoints* points = vtkPoints::New(VTK_DOUBLE);
+  points->SetData(farray);
+  double bounds[6];
+  points->GetBounds(bounds);
+  for (int i = 0; i < 3; ++i)
+  {
+    farray->GetRange(range, i);
+    if (bounds[2 * i] != range[0] || bounds[2 * i + 1] != range[1])
+    {
+      cerr << "Bounds of points do not match the ranges of their components" << endl;
+      points->Delete();
+      farray->Delete();
+      return 1;
+    }
+  }
+  points->Delete();
   farray->Delete();
+
+  vtkIntArray* negatives = vtkIntArray::New();
+  negatives->InsertNextValue(-7);
+  negatives->InsertNextValue(3);
+  if (negatives->GetMaxNorm() != 7.0)
+  {
+    cerr << "Max norm of {-7, 3} " << negatives->GetMaxNorm() << " <> 7" << endl;
+    negatives->Delete();
+    return 1;
+  }
+  negatives->Delete();
   return 0;
 }
 
@@ -0,0 +1,214 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the values, copies and dispatch of implicit arrays, and the point
+// coordinates of structured grids.
+
+#include "vtkAffineArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCommand.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkImplicitArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredPointArray.h"
+#include "vtkTestErrorObserver.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+struct Squares
+{
+  double operator()(vtkIdType idx) const { return static_cast<double>(idx * idx); }
+};
+
+struct SumWorker
+{
+  double Sum = 0.0;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    for (const auto value : vtk::DataArrayValueRange(array))
+    {
+      this->Sum += value;
+    }
+  }
+};
+
+#define CHECK(cond, msg)                                                                           \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    std::cerr << "Failed: " << msg << std::endl;                                                   \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestConstant()
+{
+  vtkNew<vtkConstantArray<int>> constant;
+  constant->ConstructBackend(42);
+  constant->SetNumberOfComponents(2);
+  constant->SetNumberOfTuples(1000000);
+  CHECK(constant->GetNumberOfValues() == 2000000, "number of values");
+  CHECK(constant->GetActualMemorySize() <= 1, "memory size");
+  CHECK(constant->GetValue(1999999) == 42 && constant->GetComponent(17, 1) == 42.0, "values");
+
+  // Writes report an error and leave the values unchanged.
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  constant->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  constant->SetValue(3, 7);
+  CHECK(errorObserver->GetError() && constant->GetValue(3) == 42, "read-only values");
+  errorObserver->Clear();
+  const double tuple[2] = { 1.0, 2.0 };
+  constant->SetTuple(5, tuple);
+  CHECK(errorObserver->GetError() && constant->GetComponent(5, 1) == 42.0, "read-only tuples");
+  constant->RemoveObserver(errorObserver);
+
+  double range[2];
+  constant->GetRange(range, 0);
+  CHECK(range[0] == 42.0 && range[1] == 42.0, "range");
+
+  // Copies of the array share its backend, new instances are regular arrays.
+  vtkNew<vtkConstantArray<int>> copy;
+  copy->ShallowCopy(constant);
+  CHECK(copy->GetBackend() == constant->GetBackend() &&
+      copy->GetNumberOfTuples() == constant->GetNumberOfTuples() &&
+      copy->GetNumberOfComponents() == 2,
+    "shallow copy");
+  vtkSmartPointer<vtkDataArray> instance = vtkSmartPointer<vtkDataArray>::Take(
+    constant->vtkDataArray::NewInstance());
+  CHECK(vtkIntArray::SafeDownCast(instance) != nullptr, "new instance");
+  instance->DeepCopy(constant);
+  CHECK(instance->GetNumberOfValues() == 2000000 &&
+      vtkIntArray::SafeDownCast(instance)->GetValue(12345) == 42,
+    "deep copy to a regular array");
+  return EXIT_SUCCESS;
+}
+
+int TestAffine()
+{
+  vtkNew<vtkAffineArray<double>> affine;
+  affine->ConstructBackend(0.5, -1.0);
+  affine->SetNumberOfComponents(3);
+  affine->SetNumberOfTuples(10);
+  double tuple[3];
+  affine->GetTuple(2, tuple);
+  CHECK(tuple[0] == 2.0 && tuple[1] == 2.5 && tuple[2] == 3.0, "tuple");
+
+  std::vector<double> values(30);
+  affine->ExportToVoidPointer(values.data());
+  for (vtkIdType i = 0; i < 30; ++i)
+  {
+    CHECK(values[i] == 0.5 * i - 1.0, "exported values");
+  }
+
+  CHECK(vtkArrayDownCast<vtkAffineArray<double>>(affine.GetPointer()) == affine.GetPointer(),
+    "downcast");
+  CHECK(vtkArrayDownCast<vtkAffineArray<float>>(affine.GetPointer()) == nullptr,
+    "downcast to another value type");
+  CHECK(vtkArrayDownCast<vtkConstantArray<double>>(affine.GetPointer()) == nullptr,
+    "downcast to another backend");
+  return EXIT_SUCCESS;
+}
+
+int TestStructuredPoints()
+{
+  const int extent[6] = { -1, 1, 0, 2, 3, 4 };
+  vtkNew<vtkDoubleArray> axes[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (int i = extent[2 * axis]; i <= extent[2 * axis + 1]; ++i)
+    {
+      axes[axis]->InsertNextValue(0.1 * i * i + axis);
+    }
+  }
+  vtkNew<vtkStructuredPointArray<double>> rectilinear;
+  rectilinear->ConstructBackend(extent, axes[0], axes[1], axes[2]);
+  rectilinear->SetNumberOfComponents(3);
+  rectilinear->SetNumberOfTuples(18);
+
+  // A rotated, translated and scaled image.
+  const double matrix[16] = { 0.0, -2.0, 0.0, 1.0, 0.5, 0.0, 0.0, -3.0, 0.0, 0.0, 0.25, 7.0, 0.0,
+    0.0, 0.0, 1.0 };
+  vtkNew<vtkStructuredPointArray<float>> image;
+  image->ConstructBackend(extent, matrix);
+  image->SetNumberOfComponents(3);
+  image->SetNumberOfTuples(18);
+
+  vtkIdType ptId = 0;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i, ++ptId)
+      {
+        double point[3];
+        rectilinear->GetTuple(ptId, point);
+        CHECK(point[0] == axes[0]->GetValue(i - extent[0]) &&
+            point[1] == axes[1]->GetValue(j - extent[2]) &&
+            point[2] == axes[2]->GetValue(k - extent[4]),
+          "rectilinear point " << ptId);
+
+        float imagePoint[3];
+        image->GetTypedTuple(ptId, imagePoint);
+        for (int comp = 0; comp < 3; ++comp)
+        {
+          const double* m = matrix + 4 * comp;
+          const float expected = static_cast<float>(m[0] * i + m[1] * j + m[2] * k + m[3]);
+          CHECK(imagePoint[comp] == expected && image->GetTypedComponent(ptId, comp) == expected &&
+              image->GetValue(3 * ptId + comp) == expected,
+            "image point " << ptId);
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestDispatch()
+{
+  vtkNew<vtkImplicitArray<Squares>> squares;
+  squares->SetNumberOfTuples(10);
+  vtkNew<vtkConstantArray<int>> constant;
+  constant->ConstructBackend(3);
+  constant->SetNumberOfTuples(10);
+
+  using Arrays = vtkTypeList::Create<vtkImplicitArray<Squares>, vtkConstantArray<int>>;
+  using Dispatcher = vtkArrayDispatch::DispatchByArray<Arrays>;
+  SumWorker squaresSum;
+  SumWorker constantSum;
+  CHECK(Dispatcher::Execute(squares, squaresSum) && squaresSum.Sum == 285.0, "dispatch");
+  CHECK(Dispatcher::Execute(constant, constantSum) && constantSum.Sum == 30.0, "dispatch");
+
+  vtkNew<vtkDoubleArray> regular;
+  regular->SetNumberOfTuples(10);
+  CHECK(!Dispatcher::Execute(regular, squaresSum), "dispatch of an unlisted array");
+  return EXIT_SUCCESS;
+}
+}
+
+int TestImplicitArray(int, char*[])
+{
+  if (TestConstant() != EXIT_SUCCESS || TestAffine() != EXIT_SUCCESS ||
+    TestStructuredPoints() != EXIT_SUCCESS || TestDispatch() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -12,13 +12,22 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
 #include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMP.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <numeric>
+#include <thread>
+#include <utility>
 #include <vector>
 
 static const int Target = 10000;
@@ -78,16 +87,38 @@ public:
   void Reduce() {}
 };
 
+class NestedFunctor
+{
+public:
+  vtkSMPThreadLocal<int> Counter;
+
+  NestedFunctor()
+    : Counter(0)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      vtkSMPTools::For(0, 100, [this](vtkIdType b, vtkIdType e) {
+        for (vtkIdType j = b; j < e; j++)
+        {
+          this->Counter.Local()++;
+        }
+      });
+    }
+  }
+};
+
 // For sorting comparison
 bool myComp(double a, double b)
 {
   return (a < b);
 }
 
-int TestSMP(int, char*[])
+int DoTestSMP()
 {
-  // vtkSMPTools::Initialize(8);
-
   ARangeFunctor functor1;
 
   vtkSMPTools::For(0, Target, functor1);
@@ -130,6 +161,40 @@ int TestSMP(int, char*[])
     return 1;
   }
 
+  // Test nested parallel for, with and without nested parallelism
+  if (vtkSMPTools::IsParallelScope())
+  {
+    cerr << "Error: IsParallelScope() is true outside of a parallel section" << endl;
+    return 1;
+  }
+  const bool nestedDefault = vtkSMPTools::GetNestedParallelism();
+  for (bool nested : { true, false })
+  {
+    vtkSMPTools::SetNestedParallelism(nested);
+    if (vtkSMPTools::GetNestedParallelism() != nested)
+    {
+      cerr << "Error: SetNestedParallelism(" << nested << ") was ignored" << endl;
+      return 1;
+    }
+
+    NestedFunctor functor3;
+
+    vtkSMPTools::For(0, 100, 1, functor3);
+
+    total = 0;
+    for (int count : functor3.Counter)
+    {
+      total += count;
+    }
+
+    if (total != 100 * 100)
+    {
+      cerr << "Error: NestedFunctor did not generate " << 100 * 100 << endl;
+      return 1;
+    }
+  }
+  vtkSMPTools::SetNestedParallelism(nestedDefault);
+
   // Test sorting
   double data0[] = { 2, 1, 0, 3, 9, 6, 7, 3, 8, 4, 5 };
   std::vector<double> myvector(data0, data0 + 11);
@@ -157,5 +222,225 @@ int TestSMP(int, char*[])
     }
   }
 
+  // Large enough to go through the parallel path of the backends
+  std::vector<int> large(100000);
+  for (size_t i = 0; i < large.size(); ++i)
+  {
+    large[i] = static_cast<int>((i * 7919) % large.size());
+  }
+  vtkSMPTools::Sort(large.begin(), large.end(), std::greater<int>());
+  if (!std::is_sorted(large.begin(), large.end(), std::greater<int>()) ||
+    large.front() != static_cast<int>(large.size()) - 1 || large.back() != 0)
+  {
+    cerr << "Error: Bad large sort!" << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+// Parallel algorithms, on std::vector and on data array ranges
+int DoTestSMPAlgorithms()
+{
+  const vtkIdType size = 100003; // not a multiple of any chunk size
+
+  // Fill
+  vtkNew<vtkIntArray> counts;
+  counts->SetNumberOfTuples(size);
+  auto countRange = vtk::DataArrayValueRange<1>(counts);
+  vtkSMPTools::Fill(countRange.begin(), countRange.end(), 3);
+  if (std::count(countRange.cbegin(), countRange.cend(), 3) != size)
+  {
+    cerr << "Error: Bad fill!" << endl;
+    return 1;
+  }
+
+  // Unary and in place transform
+  std::vector<int> values(size);
+  std::iota(values.begin(), values.end(), 0);
+  vtkSMPTools::Transform(countRange.cbegin(), countRange.cend(), values.cbegin(),
+    countRange.begin(), [](int count, int i) { return count * (i % 7); });
+  vtkSMPTools::Transform(
+    values.cbegin(), values.cend(), values.begin(), [](int i) { return i % 7; });
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (countRange[i] != 3 * (i % 7) || values[i] != i % 7)
+    {
+      cerr << "Error: Bad transform at " << i << endl;
+      return 1;
+    }
+  }
+
+  // Reduce / TransformReduce
+  long long expected = std::accumulate(values.cbegin(), values.cend(), 0LL);
+  if (vtkSMPTools::Reduce(values.cbegin(), values.cend(), 0LL) != expected)
+  {
+    cerr << "Error: Bad reduce!" << endl;
+    return 1;
+  }
+  int maxCount = vtkSMPTools::Reduce(countRange.cbegin(), countRange.cend(), -1,
+    [](int a, int b) { return std::max(a, b); });
+  if (maxCount != 18)
+  {
+    cerr << "Error: Bad max reduce: " << maxCount << endl;
+    return 1;
+  }
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetNumberOfTuples(size);
+  auto doubleRange = vtk::DataArrayValueRange<1>(doubles);
+  std::copy(values.cbegin(), values.cend(), doubleRange.begin());
+  double sumOfSquares = vtkSMPTools::TransformReduce(doubleRange.cbegin(), doubleRange.cend(), 0.,
+    std::plus<double>(), [](double x) { return x * x; });
+  double expectedSumOfSquares = 0.;
+  for (int v : values)
+  {
+    expectedSumOfSquares += v * v;
+  }
+  if (sumOfSquares != expectedSumOfSquares) // exact, these are small integers
+  {
+    cerr << "Error: Bad transform reduce!" << endl;
+    return 1;
+  }
+
+  // Scans, including in place, against the serial result
+  std::vector<long long> serial(size);
+  std::vector<long long> scanned(size);
+  std::partial_sum(values.cbegin(), values.cend(), serial.begin());
+  vtkSMPTools::InclusiveScan(values.cbegin(), values.cend(), scanned.begin());
+  if (scanned != serial)
+  {
+    cerr << "Error: Bad inclusive scan!" << endl;
+    return 1;
+  }
+  vtkSMPTools::ExclusiveScan(countRange.cbegin(), countRange.cend(), countRange.begin(), 5);
+  int acc = 5;
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (countRange[i] != acc)
+    {
+      cerr << "Error: Bad exclusive scan at " << i << endl;
+      return 1;
+    }
+    acc += 3 * (i % 7);
+  }
+
+  // Stable sort: equal keys must keep their order
+  std::vector<std::pair<int, vtkIdType> > pairs(size);
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    pairs[i] = std::make_pair(static_cast<int>((i * 7919) % 13), i);
+  }
+  vtkSMPTools::StableSort(pairs.begin(), pairs.end(),
+    [](const std::pair<int, vtkIdType>& a, const std::pair<int, vtkIdType>& b) {
+      return a.first < b.first;
+    });
+  for (vtkIdType i = 1; i < size; ++i)
+  {
+    if (pairs[i - 1].first > pairs[i].first ||
+      (pairs[i - 1].first == pairs[i].first && pairs[i - 1].second > pairs[i].second))
+    {
+      cerr << "Error: Bad stable sort!" << endl;
+      return 1;
+    }
+  }
+  vtkSMPTools::StableSort(doubleRange.begin(), doubleRange.end(), std::greater<double>());
+  if (!std::is_sorted(doubleRange.cbegin(), doubleRange.cend(), std::greater<double>()))
+  {
+    cerr << "Error: Bad stable sort of a data array range!" << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+// Changing the number of threads while other threads, or the functor itself,
+// are executing a For()
+int DoTestSMPReinitialize()
+{
+  const vtkIdType size = 100000;
+  std::atomic<bool> failed(false);
+  std::atomic<bool> done(false);
+  auto sum = [size]() {
+    std::atomic<vtkIdType> total(0);
+    vtkSMPTools::For(0, size, 100, [&total](vtkIdType begin, vtkIdType end) {
+      vtkIdType local = 0;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        local += i % 3;
+      }
+      total += local;
+    });
+    return total.load();
+  };
+  const vtkIdType expected = sum();
+
+  std::thread other([&]() {
+    for (int i = 0; i < 200; ++i)
+    {
+      if (sum() != expected)
+      {
+        failed = true;
+      }
+    }
+    done = true;
+  });
+  for (int n = 1; !done; n = n % 4 + 1)
+  {
+    vtkSMPTools::Initialize(n);
+  }
+  other.join();
+
+  // From a worker, inside a For().
+  vtkSMPTools::For(0, 8, 1, [&](vtkIdType begin, vtkIdType) {
+    vtkSMPTools::Initialize(static_cast<int>(begin % 3) + 1);
+    if (sum() != expected)
+    {
+      failed = true;
+    }
+  });
+  vtkSMPTools::Initialize(0);
+
+  if (failed || sum() != expected)
+  {
+    cerr << "Error: Bad result while changing the number of threads!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int TestSMP(int, char*[])
+{
+  // vtkSMPTools::Initialize(8);
+
+  std::vector<const char*> backends;
+#if VTK_SMP_ENABLE_SEQUENTIAL
+  backends.push_back("Sequential");
+#endif
+#if VTK_SMP_ENABLE_STDTHREAD
+  backends.push_back("STDThread");
+#endif
+#if VTK_SMP_ENABLE_TBB
+  backends.push_back("TBB");
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+  backends.push_back("OpenMP");
+#endif
+
+  const char* defaultBackend = vtkSMPTools::GetBackend();
+  for (const char* backend : backends)
+  {
+    if (!vtkSMPTools::SetBackend(backend))
+    {
+      cerr << "Error: SMP backend " << backend << " could not be activated" << endl;
+      return 1;
+    }
+    cout << "Testing SMP backend " << vtkSMPTools::GetBackend() << endl;
+    if (DoTestSMP() || DoTestSMPAlgorithms() || DoTestSMPReinitialize())
+    {
+      return 1;
+    }
+  }
+  vtkSMPTools::SetBackend(defaultBackend);
+
   return 0;
 }
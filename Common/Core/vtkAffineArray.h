@@ -0,0 +1,68 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineArray
+ * @brief   An implicit array whose values are an affine function of their
+ * index.
+ *
+ * vtkAffineArray is a vtkImplicitArray backed by vtkAffineImplicitBackend. The
+ * value at index i, in array-of-structs order, is Slope * i + Intercept. It
+ * represents sequences such as point ids or uniform coordinates in constant
+ * memory:
+ *
+ * @code{cpp}
+ * vtkNew<vtkAffineArray<vtkIdType>> ids;
+ * ids->ConstructBackend(1, 0);
+ * ids->SetNumberOfTuples(numPoints);
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkConstantArray
+ */
+
+#ifndef vtkAffineArray_h
+#define vtkAffineArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueT>
+struct vtkAffineImplicitBackend
+{
+  vtkAffineImplicitBackend()
+    : Slope(1)
+    , Intercept(0)
+  {
+  }
+  vtkAffineImplicitBackend(ValueT slope, ValueT intercept)
+    : Slope(slope)
+    , Intercept(intercept)
+  {
+  }
+
+  ValueT operator()(vtkIdType idx) const
+  {
+    return static_cast<ValueT>(this->Slope * idx + this->Intercept);
+  }
+
+  ValueT Slope;
+  ValueT Intercept;
+};
+
+template <typename ValueT>
+using vtkAffineArray = vtkImplicitArray<vtkAffineImplicitBackend<ValueT>>;
+
+#endif // vtkAffineArray_h
+
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
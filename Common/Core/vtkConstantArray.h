@@ -0,0 +1,60 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantArray
+ * @brief   An implicit array whose values are all equal.
+ *
+ * vtkConstantArray is a vtkImplicitArray backed by vtkConstantImplicitBackend.
+ * It represents constant fields, such as the ghost array of a dataset without
+ * ghost cells, in constant memory:
+ *
+ * @code{cpp}
+ * vtkNew<vtkConstantArray<unsigned char>> ghosts;
+ * ghosts->ConstructBackend(0);
+ * ghosts->SetNumberOfTuples(numCells);
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkAffineArray
+ */
+
+#ifndef vtkConstantArray_h
+#define vtkConstantArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueT>
+struct vtkConstantImplicitBackend
+{
+  vtkConstantImplicitBackend()
+    : Value(0)
+  {
+  }
+  vtkConstantImplicitBackend(ValueT value)
+    : Value(value)
+  {
+  }
+
+  ValueT operator()(vtkIdType) const { return this->Value; }
+
+  ValueT Value;
+};
+
+template <typename ValueT>
+using vtkConstantArray = vtkImplicitArray<vtkConstantImplicitBackend<ValueT>>;
+
+#endif // vtkConstantArray_h
+
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
@@ -15,6 +15,16 @@
 #   Include vtkTypedDataArray<ValueType> for the basic types supported
 #   by VTK. This enables the old-style in-situ vtkMappedDataArray subclasses
 #   to be used.
+# - VTK_DISPATCH_AFFINE_ARRAYS (default: OFF)
+#   Include vtkAffineArray<ValueType> implicit arrays for the basic types
+#   supported by VTK.
+# - VTK_DISPATCH_CONSTANT_ARRAYS (default: OFF)
+#   Include vtkConstantArray<ValueType> implicit arrays for the basic types
+#   supported by VTK.
+# - VTK_DISPATCH_STRUCTURED_POINT_ARRAYS (default: OFF)
+#   Include vtkStructuredPointArray<ValueType> implicit arrays for float and
+#   double. These hold the point coordinates of images and rectilinear grids
+#   converted to point sets.
 #
 # At a lower level, specific arrays can be added to the list individually in
 # two ways:
@@ -146,6 +156,31 @@ if (VTK_DISPATCH_TYPED_ARRAYS)
   )
 endif()
 
+if (VTK_DISPATCH_AFFINE_ARRAYS)
+  list(APPEND vtkArrayDispatch_containers vtkAffineArray)
+  set(vtkArrayDispatch_vtkAffineArray_header vtkAffineArray.h)
+  set(vtkArrayDispatch_vtkAffineArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+endif()
+
+if (VTK_DISPATCH_CONSTANT_ARRAYS)
+  list(APPEND vtkArrayDispatch_containers vtkConstantArray)
+  set(vtkArrayDispatch_vtkConstantArray_header vtkConstantArray.h)
+  set(vtkArrayDispatch_vtkConstantArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+endif()
+
+if (VTK_DISPATCH_STRUCTURED_POINT_ARRAYS)
+  list(APPEND vtkArrayDispatch_containers vtkStructuredPointArray)
+  set(vtkArrayDispatch_vtkStructuredPointArray_header vtkStructuredPointArray.h)
+  set(vtkArrayDispatch_vtkStructuredPointArray_types
+    "float"
+    "double"
+  )
+endif()
+
 endmacro()
 
 # Concatenates a list of strings into a single string, since string(CONCAT ...)
@@ -47,6 +47,7 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <algorithm> // for min(), max()
+#include <cmath>     // for abs()
 
 namespace
 {
@@ -1465,21 +1466,20 @@ void vtkDataArray::CopyComponent(int dstComponent, vtkDataArray* src, int srcCom
 //------------------------------------------------------------------------------
 double vtkDataArray::GetMaxNorm()
 {
-  vtkIdType i;
-  double norm, maxNorm;
-  int nComponents = this->GetNumberOfComponents();
-
-  maxNorm = 0.0;
-  for (i = 0; i < this->GetNumberOfTuples(); i++)
+  if (this->GetNumberOfTuples() < 1 || this->NumberOfComponents < 1)
   {
-    norm = vtkMath::Norm(this->GetTuple(i), nComponents);
-    if (norm > maxNorm)
-    {
-      maxNorm = norm;
-    }
+    return 0.0;
   }
 
-  return maxNorm;
+  // The magnitude range is computed in parallel and cached until the array
+  // is modified. The magnitude of a single component array is its range.
+  double range[2];
+  this->GetRange(range, -1);
+  if (this->NumberOfComponents == 1)
+  {
+    return std::max(std::abs(range[0]), std::abs(range[1]));
+  }
+  return range[1];
 }
 
 //------------------------------------------------------------------------------
@@ -1496,6 +1496,10 @@ int vtkDataArray::CopyInformation(vtkInformation* infoFrom, int deep)
   {
     myInfo->Remove(L2_NORM_RANGE());
   }
+  if (myInfo->Has(L2_NORM_FINITE_RANGE()))
+  {
+    myInfo->Remove(L2_NORM_FINITE_RANGE());
+  }
 
   return 1;
 }
@@ -442,7 +442,8 @@ public:
 
   /**
    * Return the maximum norm for the tuples.
-   * Note that the max. is computed every time GetMaxNorm is called.
+   * Note that the max. is taken from the magnitude range, which is cached
+   * until the array is modified.
    */
   virtual double GetMaxNorm();
 
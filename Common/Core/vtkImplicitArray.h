@@ -0,0 +1,304 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitArray
+ * @brief   A read-only vtkGenericDataArray whose values are computed by a
+ * functor.
+ *
+ * vtkImplicitArray stores no values. Its backend is a functor called with
+ * the index of a value, in array-of-structs order, that returns this value:
+ *
+ * @code{cpp}
+ * struct Squares
+ * {
+ *   double operator()(vtkIdType idx) const { return idx * idx; }
+ * };
+ * vtkNew<vtkImplicitArray<Squares>> squares;
+ * squares->SetNumberOfTuples(100);
+ * @endcode
+ *
+ * The value type of the array is the return type of the backend, which must
+ * be default constructible. The backend is held by a shared pointer, so that
+ * shallow and deep copies of the array share it: it must not be modified once
+ * it is set. Constant arrays and affine sequences are provided by
+ * vtkConstantArray and vtkAffineArray.
+ *
+ * A backend may also provide `void MapTuple(vtkIdType tupleIdx, ValueType*
+ * tuple) const` and `ValueType MapComponent(vtkIdType tupleIdx, int comp)
+ * const`, which are then used to read tuples and components instead of
+ * computing each value from its flat index.
+ *
+ * The number of components and tuples are set as for any other array, but
+ * cost no memory. Writing values reports an error, and NewInstance()
+ * returns a vtkAOSDataArrayTemplate of the same value type, so that filters
+ * copying the array into a new one write into a regular array.
+ *
+ * Implicit arrays can be dispatched with vtkArrayDispatch by listing them in
+ * the array list, see the VTK_DISPATCH_AFFINE_ARRAYS,
+ * VTK_DISPATCH_CONSTANT_ARRAYS and VTK_DISPATCH_STRUCTURED_POINT_ARRAYS
+ * options, which are off by default. Otherwise the dispatchers fall back to
+ * the vtkDataArray API. GetVoidPointer() generates the values in a temporary
+ * buffer, and should be avoided.
+ *
+ * @sa
+ * vtkGenericDataArray vtkConstantArray vtkAffineArray vtkStructuredPointArray
+ */
+
+#ifndef vtkImplicitArray_h
+#define vtkImplicitArray_h
+
+#include "vtkBuffer.h"
+#include "vtkGenericDataArray.h"
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+
+#include <memory>      // For shared_ptr
+#include <type_traits> // For decay, true_type
+
+namespace vtk
+{
+namespace detail
+{
+// Detect the optional tuple and component accessors of a backend.
+template <typename BackendT, typename ValueT, typename = void>
+struct ImplicitBackendHasMapTuple : std::false_type
+{
+};
+template <typename BackendT, typename ValueT>
+struct ImplicitBackendHasMapTuple<BackendT, ValueT,
+  decltype(std::declval<const BackendT&>().MapTuple(vtkIdType(), std::declval<ValueT*>()))>
+  : std::true_type
+{
+};
+
+template <typename BackendT, typename = void>
+struct ImplicitBackendHasMapComponent : std::false_type
+{
+};
+template <typename BackendT>
+struct ImplicitBackendHasMapComponent<BackendT,
+  decltype(void(std::declval<const BackendT&>().MapComponent(vtkIdType(), int())))>
+  : std::true_type
+{
+};
+} // end namespace detail
+} // end namespace vtk
+
+template <class BackendT>
+class vtkImplicitArray
+  : public vtkGenericDataArray<vtkImplicitArray<BackendT>,
+      typename std::decay<decltype(std::declval<const BackendT&>()(vtkIdType()))>::type>
+{
+public:
+  typedef BackendT BackendType;
+  typedef typename std::decay<decltype(std::declval<const BackendT&>()(vtkIdType()))>::type
+    ValueType;
+  typedef vtkImplicitArray<BackendT> SelfType;
+  typedef vtkGenericDataArray<SelfType, ValueType> GenericDataArrayType;
+  friend class vtkGenericDataArray<SelfType, ValueType>;
+
+  vtkAbstractTypeMacroWithNewInstanceType(
+    SelfType, GenericDataArrayType, vtkDataArray, typeid(SelfType).name());
+  vtkAOSArrayNewInstanceMacro(SelfType);
+
+  static vtkImplicitArray* New();
+
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the functor computing the values. SetBackend() does not change
+   * the number of tuples of the array.
+   */
+  void SetBackend(std::shared_ptr<BackendT> backend);
+  std::shared_ptr<BackendT> GetBackend() const { return this->Backend; }
+  //@}
+
+  /**
+   * Construct a new backend from the given arguments.
+   */
+  template <typename... Args>
+  void ConstructBackend(Args&&... args)
+  {
+    this->SetBackend(std::make_shared<BackendT>(std::forward<Args>(args)...));
+  }
+
+  /**
+   * Get the value at @a valueIdx, in array-of-structs order.
+   */
+  inline ValueType GetValue(vtkIdType valueIdx) const { return (*this->Backend)(valueIdx); }
+
+  /**
+   * Implicit arrays are read-only: this reports an error.
+   */
+  void SetValue(vtkIdType valueIdx, ValueType value);
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  inline void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    this->GetTypedTupleImpl(tupleIdx, tuple,
+      typename vtk::detail::ImplicitBackendHasMapTuple<BackendT, ValueType>::type());
+  }
+
+  /**
+   * Implicit arrays are read-only: this reports an error.
+   */
+  void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple);
+
+  //@{
+  /**
+   * Reimplemented to read the tuple at once when the backend provides
+   * MapTuple() and the values are doubles.
+   */
+  using Superclass::GetTuple;
+  void GetTuple(vtkIdType tupleIdx, double* tuple) override
+  {
+    this->GetTupleImpl(tupleIdx, tuple, static_cast<ValueType*>(nullptr),
+      typename vtk::detail::ImplicitBackendHasMapTuple<BackendT, ValueType>::type());
+  }
+  //@}
+
+  /**
+   * Get component @a comp of the tuple at @a tupleIdx.
+   */
+  inline ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return this->GetTypedComponentImpl(
+      tupleIdx, comp, typename vtk::detail::ImplicitBackendHasMapComponent<BackendT>::type());
+  }
+
+  /**
+   * Implicit arrays are read-only: this reports an error.
+   */
+  void SetTypedComponent(vtkIdType tupleIdx, int comp, ValueType value);
+
+  /**
+   * Use of this method is discouraged, it generates the values into a
+   * temporary array-of-structs buffer and prints a warning.
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Generate the values into the preallocated memory buffer.
+   */
+  void ExportToVoidPointer(void* ptr) override;
+
+  /**
+   * Only an implicit array of the same type can be copied into an implicit
+   * array. The copy shares the backend of @a other.
+   */
+  void DeepCopy(vtkDataArray* other) override;
+  void DeepCopy(vtkAbstractArray* other) override { this->Superclass::DeepCopy(other); }
+
+  /**
+   * Share the backend of @a other if it is an implicit array of the same
+   * type, otherwise report an error.
+   */
+  void ShallowCopy(vtkDataArray* other) override;
+
+  /**
+   * The values are not stored: return the size of the backend, in kibibytes.
+   */
+  unsigned long GetActualMemorySize() const override;
+
+  VTK_NEWINSTANCE vtkArrayIterator* NewIterator() override;
+
+#ifndef __VTK_WRAP__
+  /**
+   * Perform a fast, safe cast from a vtkAbstractArray to a vtkImplicitArray.
+   * This method checks if source->GetArrayType() returns ImplicitArray and
+   * that the value types match before checking the backend type. Otherwise,
+   * nullptr is returned.
+   */
+  static vtkImplicitArray<BackendT>* FastDownCast(vtkAbstractArray* source)
+  {
+    if (source && source->GetArrayType() == vtkAbstractArray::ImplicitArray &&
+      vtkDataTypesCompare(source->GetDataType(), vtkTypeTraits<ValueType>::VTK_TYPE_ID))
+    {
+      return SelfType::SafeDownCast(source);
+    }
+    return nullptr;
+  }
+#endif
+
+  int GetArrayType() const override { return vtkAbstractArray::ImplicitArray; }
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray() override;
+
+  /**
+   * No memory is needed to hold the values. This releases the temporary
+   * buffer of GetVoidPointer().
+   */
+  bool AllocateTuples(vtkIdType numTuples);
+  bool ReallocateTuples(vtkIdType numTuples);
+
+  std::shared_ptr<BackendT> Backend;
+  vtkBuffer<ValueType>* AoSCopy;
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&) = delete;
+  void operator=(const vtkImplicitArray&) = delete;
+
+  inline void GetTypedTupleImpl(vtkIdType tupleIdx, ValueType* tuple, std::true_type) const
+  {
+    this->Backend->MapTuple(tupleIdx, tuple);
+  }
+  inline void GetTypedTupleImpl(vtkIdType tupleIdx, ValueType* tuple, std::false_type) const
+  {
+    const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+      tuple[comp] = (*this->Backend)(valueIdx + comp);
+    }
+  }
+
+  inline void GetTupleImpl(vtkIdType tupleIdx, double* tuple, double*, std::true_type)
+  {
+    this->Backend->MapTuple(tupleIdx, tuple);
+  }
+  template <typename OtherValueT, typename HasMapTuple>
+  inline void GetTupleImpl(vtkIdType tupleIdx, double* tuple, OtherValueT*, HasMapTuple)
+  {
+    this->Superclass::GetTuple(tupleIdx, tuple);
+  }
+
+  inline ValueType GetTypedComponentImpl(vtkIdType tupleIdx, int comp, std::true_type) const
+  {
+    return this->Backend->MapComponent(tupleIdx, comp);
+  }
+  inline ValueType GetTypedComponentImpl(vtkIdType tupleIdx, int comp, std::false_type) const
+  {
+    return (*this->Backend)(tupleIdx * this->NumberOfComponents + comp);
+  }
+};
+
+// Declare vtkArrayDownCast implementations for implicit containers:
+template <typename BackendT>
+struct vtkArrayDownCast_impl<vtkImplicitArray<BackendT>>
+{
+  inline vtkImplicitArray<BackendT>* operator()(vtkAbstractArray* array)
+  {
+    return vtkImplicitArray<BackendT>::FastDownCast(array);
+  }
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif // vtkImplicitArray_h
+
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitArray_txx
+#define vtkImplicitArray_txx
+
+#include "vtkImplicitArray.h"
+
+#include "vtkArrayIteratorTemplate.h"
+
+#include <cstdlib>
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>* vtkImplicitArray<BackendT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkImplicitArray<BackendT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::vtkImplicitArray()
+  : Backend(std::make_shared<BackendT>())
+  , AoSCopy(nullptr)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::~vtkImplicitArray()
+{
+  if (this->AoSCopy)
+  {
+    this->AoSCopy->Delete();
+    this->AoSCopy = nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Backend: " << this->Backend.get() << "\n";
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetBackend(std::shared_ptr<BackendT> backend)
+{
+  if (this->Backend != backend)
+  {
+    this->Backend = backend;
+    this->DataChanged();
+    this->Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetValue(vtkIdType valueIdx, ValueType)
+{
+  vtkErrorMacro(<< "Cannot set value " << valueIdx << ": implicit arrays are read-only.");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetTypedTuple(vtkIdType tupleIdx, const ValueType*)
+{
+  vtkErrorMacro(<< "Cannot set tuple " << tupleIdx << ": implicit arrays are read-only.");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetTypedComponent(vtkIdType tupleIdx, int comp, ValueType)
+{
+  vtkErrorMacro(<< "Cannot set component " << comp << " of tuple " << tupleIdx
+                << ": implicit arrays are read-only.");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void* vtkImplicitArray<BackendT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  // Allow warnings to be silenced:
+  const char* silence = getenv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS");
+  if (!silence)
+  {
+    vtkWarningMacro(<< "GetVoidPointer called. This is very expensive for "
+                       "implicit arrays, as the values must be generated for "
+                       "each call. Using the vtkGenericDataArray API with "
+                       "vtkArrayDispatch are preferred. Define the environment "
+                       "variable VTK_SILENCE_GET_VOID_POINTER_WARNINGS to "
+                       "silence this warning.");
+  }
+
+  const vtkIdType numValues = this->GetNumberOfValues();
+
+  if (!this->AoSCopy)
+  {
+    this->AoSCopy = vtkBuffer<ValueType>::New();
+  }
+
+  if (!this->AoSCopy->Allocate(numValues))
+  {
+    vtkErrorMacro(<< "Error allocating a buffer of " << numValues << " '"
+                  << this->GetDataTypeAsString() << "' elements.");
+    return nullptr;
+  }
+
+  this->ExportToVoidPointer(static_cast<void*>(this->AoSCopy->GetBuffer()));
+
+  return static_cast<void*>(this->AoSCopy->GetBuffer() + valueIdx);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ExportToVoidPointer(void* voidPtr)
+{
+  const vtkIdType numValues = this->GetNumberOfValues();
+  if (numValues == 0)
+  {
+    // Nothing to do.
+    return;
+  }
+
+  if (!voidPtr)
+  {
+    vtkErrorMacro(<< "Buffer is nullptr.");
+    return;
+  }
+
+  // Generate whole tuples, with MapTuple() when the backend provides it.
+  ValueType* ptr = static_cast<ValueType*>(voidPtr);
+  const int numComps = this->NumberOfComponents;
+  const vtkIdType numTuples = numValues / numComps;
+  for (vtkIdType tupleIdx = 0; tupleIdx < numTuples; ++tupleIdx, ptr += numComps)
+  {
+    this->GetTypedTuple(tupleIdx, ptr);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::DeepCopy(vtkDataArray* other)
+{
+  if (other == nullptr || other == this)
+  {
+    return;
+  }
+
+  SelfType* o = SelfType::FastDownCast(other);
+  if (!o)
+  {
+    vtkErrorMacro(<< "Cannot copy a " << other->GetClassName() << " into an implicit array.");
+    return;
+  }
+
+  this->vtkAbstractArray::DeepCopy(other); // copy Information object
+  this->SetNumberOfComponents(o->GetNumberOfComponents());
+  this->SetNumberOfTuples(o->GetNumberOfTuples());
+  this->SetBackend(o->Backend);
+  this->SetLookupTable(nullptr);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ShallowCopy(vtkDataArray* other)
+{
+  this->DeepCopy(other);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+unsigned long vtkImplicitArray<BackendT>::GetActualMemorySize() const
+{
+  return static_cast<unsigned long>((sizeof(BackendT) + 1023) / 1024);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkArrayIterator* vtkImplicitArray<BackendT>::NewIterator()
+{
+  vtkArrayIterator* iter = vtkArrayIteratorTemplate<ValueType>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+bool vtkImplicitArray<BackendT>::AllocateTuples(vtkIdType)
+{
+  if (this->AoSCopy)
+  {
+    this->AoSCopy->Delete();
+    this->AoSCopy = nullptr;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+bool vtkImplicitArray<BackendT>::ReallocateTuples(vtkIdType numTuples)
+{
+  return this->AllocateTuples(numTuples);
+}
+
+#endif
@@ -85,7 +85,12 @@ void vtkPoints::ComputeBounds()
 {
   if (this->GetMTime() > this->ComputeTime)
   {
-    this->Data->ComputeScalarRange(this->Bounds);
+    // Go through the cached component ranges of the data array, so that the
+    // bounds and the coordinate ranges share one parallel scan.
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Data->GetRange(this->Bounds + 2 * i, i);
+    }
     this->ComputeTime.Modified();
   }
 }
@@ -1,21 +1,55 @@
+# Every enabled back-end is compiled in; VTK_SMP_IMPLEMENTATION_TYPE only
+# selects the one used by default. The VTK_SMP_BACKEND_IN_USE environment
+# variable or vtkSMPTools::SetBackend() switch between them at runtime.
+option(VTK_SMP_ENABLE_SEQUENTIAL "Enable Sequential backend for vtkSMPTools" ON)
+option(VTK_SMP_ENABLE_STDTHREAD "Enable STDThread backend for vtkSMPTools" ON)
+option(VTK_SMP_ENABLE_OPENMP "Enable OpenMP backend for vtkSMPTools" OFF)
+option(VTK_SMP_ENABLE_TBB "Enable TBB backend for vtkSMPTools" OFF)
+mark_as_advanced(
+  VTK_SMP_ENABLE_SEQUENTIAL
+  VTK_SMP_ENABLE_STDTHREAD
+  VTK_SMP_ENABLE_OPENMP
+  VTK_SMP_ENABLE_TBB)
+
 set(VTK_SMP_IMPLEMENTATION_TYPE "Sequential"
-  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, OpenMP or TBB")
+  CACHE STRING "Which multi-threaded parallelism implementation to use by default. Options are Sequential, STDThread, OpenMP or TBB")
 set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
   PROPERTY
-    STRINGS Sequential OpenMP TBB)
+    STRINGS Sequential STDThread OpenMP TBB)
 
 if (NOT (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP" OR
-         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB"))
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB" OR
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread"))
   set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
     PROPERTY
       VALUE "Sequential")
 endif ()
 
-set(vtk_smp_headers_to_configure)
+# The default back-end is always built.
+string(TOUPPER "${VTK_SMP_IMPLEMENTATION_TYPE}" vtk_smp_default_implementation)
+set("VTK_SMP_ENABLE_${vtk_smp_default_implementation}" ON)
+foreach (vtk_smp_implementation IN ITEMS SEQUENTIAL STDTHREAD OPENMP TBB)
+  if (vtk_smp_implementation STREQUAL vtk_smp_default_implementation)
+    set("VTK_SMP_DEFAULT_IMPLEMENTATION_${vtk_smp_implementation}" 1)
+  else ()
+    set("VTK_SMP_DEFAULT_IMPLEMENTATION_${vtk_smp_implementation}" 0)
+  endif ()
+endforeach ()
+
 set(vtk_smp_defines)
 set(vtk_smp_use_default_atomics ON)
 
-if (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB")
+list(APPEND vtk_smp_sources
+  "${CMAKE_CURRENT_SOURCE_DIR}/vtkSMPTools.cxx"
+  "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Common/vtkSMPToolsAPI.cxx")
+vtk_module_install_headers(
+  FILES   "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Common/vtkSMPThreadLocalAPI.h"
+          "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Common/vtkSMPThreadLocalImplAbstract.h"
+          "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Common/vtkSMPToolsAPI.h"
+          "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Common/vtkSMPToolsImpl.h"
+  SUBDIR  "SMP/Common")
+
+if (VTK_SMP_ENABLE_TBB)
   vtk_module_find_package(PACKAGE TBB)
   list(APPEND vtk_smp_libraries
     TBB::tbb)
@@ -23,12 +57,14 @@ if (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB")
   set(vtk_smp_use_default_atomics OFF)
   set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/TBB")
   list(APPEND vtk_smp_sources
-    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx")
-  list(APPEND vtk_smp_headers_to_configure
-    vtkSMPToolsInternal.h
-    vtkSMPThreadLocal.h)
+    "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.cxx")
+  vtk_module_install_headers(
+    FILES   "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.h"
+            "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.txx"
+    SUBDIR  "SMP/TBB")
+endif ()
 
-elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
+if (VTK_SMP_ENABLE_OPENMP)
   vtk_module_find_package(PACKAGE OpenMP)
 
   list(APPEND vtk_smp_libraries
@@ -36,12 +72,13 @@ elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
 
   set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/OpenMP")
   list(APPEND vtk_smp_sources
-    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx"
-    "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.cxx")
-  list(APPEND vtk_smp_headers_to_configure
-    vtkSMPThreadLocal.h
-    vtkSMPThreadLocalImpl.h
-    vtkSMPToolsInternal.h)
+    "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPThreadLocalBackend.cxx")
+  vtk_module_install_headers(
+    FILES   "${vtk_smp_implementation_dir}/vtkSMPThreadLocalBackend.h"
+            "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.h"
+            "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.txx"
+    SUBDIR  "SMP/OpenMP")
 
   if (OpenMP_CXX_SPEC_DATE AND NOT "${OpenMP_CXX_SPEC_DATE}" LESS "201107")
     set(vtk_smp_use_default_atomics OFF)
@@ -50,15 +87,30 @@ elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
       "Required OpenMP version (3.1) for atomics not detected. Using default "
       "atomics implementation.")
   endif()
+endif ()
 
-elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "Sequential")
+if (VTK_SMP_ENABLE_STDTHREAD)
+  # Threads::Threads is always linked by VTK::CommonCore.
+  set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/STDThread")
+  list(APPEND vtk_smp_sources
+    "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPThreadLocalBackend.cxx")
+  vtk_module_install_headers(
+    FILES   "${vtk_smp_implementation_dir}/vtkSMPThreadLocalBackend.h"
+            "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.h"
+            "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.txx"
+    SUBDIR  "SMP/STDThread")
+endif ()
+
+if (VTK_SMP_ENABLE_SEQUENTIAL)
   set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Sequential")
   list(APPEND vtk_smp_sources
-    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx")
-  list(APPEND vtk_smp_headers_to_configure
-    vtkSMPThreadLocal.h
-    vtkSMPToolsInternal.h)
-endif()
+    "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.cxx")
+  vtk_module_install_headers(
+    FILES   "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.h"
+            "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.txx"
+    SUBDIR  "SMP/Sequential")
+endif ()
 
 if (vtk_smp_use_default_atomics)
   include(CheckSymbolExists)
@@ -68,15 +120,7 @@ if (vtk_smp_use_default_atomics)
   set(vtk_atomics_default_impl_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Sequential")
 endif()
 
-foreach (vtk_smp_header IN LISTS vtk_smp_headers_to_configure)
-  configure_file(
-    "${vtk_smp_implementation_dir}/${vtk_smp_header}.in"
-    "${CMAKE_CURRENT_BINARY_DIR}/${vtk_smp_header}"
-    COPYONLY)
-  list(APPEND vtk_smp_headers
-    "${CMAKE_CURRENT_BINARY_DIR}/${vtk_smp_header}")
-endforeach()
-
 list(APPEND vtk_smp_headers
   vtkSMPTools.h
+  vtkSMPThreadLocal.h
   vtkSMPThreadLocalObject.h)
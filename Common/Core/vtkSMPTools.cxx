@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "SMP/Common/vtkSMPToolsAPI.h"
+
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+const char* vtkSMPTools::GetBackend()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetBackend();
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.SetBackend(backend);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.Initialize(numThreads);
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetEstimatedNumberOfThreads();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetNestedParallelism(bool isNested)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetNestedParallelism(isNested);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetNestedParallelism();
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::IsParallelScope()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.IsParallelScope();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtk::detail::smp::vtkSMPTools_GetNumberOfChunks(vtkIdType size)
+{
+  const vtkIdType minimumChunkSize = 1024; // below this, the overhead dominates
+  if (size < 2 * minimumChunkSize)
+  {
+    return 1;
+  }
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  if (!SMPToolsAPI.GetNestedParallelism() && SMPToolsAPI.IsParallelScope())
+  {
+    return 1;
+  }
+  // A few chunks per thread to balance the load
+  const vtkIdType numChunks = 4 * SMPToolsAPI.GetEstimatedNumberOfThreads();
+  return numChunks > 1 ? std::min(numChunks, size / minimumChunkSize) : 1;
+}
@@ -19,8 +19,20 @@
  * vtkSMPTools provides a set of utility functions that can
  * be used to parallelize parts of VTK code using multiple threads.
  * There are several back-end implementations of parallel functionality
- * (currently Sequential, TBB and X-Kaapi) that actual execution is
- * delegated to.
+ * (currently Sequential, STDThread, OpenMP and TBB) that actual execution is
+ * delegated to. The STDThread back-end has no external dependency: it runs
+ * on a persistent pool of std::thread workers that balance the load by work
+ * stealing.
+ *
+ * Every back-end enabled at build time (VTK_SMP_ENABLE_*) is available at
+ * runtime. VTK_SMP_IMPLEMENTATION_TYPE selects the default one; the
+ * VTK_SMP_BACKEND_IN_USE environment variable or SetBackend() select another
+ * one, and the VTK_SMP_MAX_THREADS environment variable limits the number of
+ * threads like Initialize() does.
+ *
+ * A For() called from within a parallel section is run serially by the
+ * calling thread unless nested parallelism is enabled (see
+ * SetNestedParallelism()).
  */
 
 #ifndef vtkSMPTools_h
@@ -29,8 +41,13 @@
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkObject.h"
 
-#include "vtkSMPThreadLocal.h" // For Initialized
-#include "vtkSMPToolsInternal.h"
+#include "SMP/Common/vtkSMPToolsAPI.h" // For the back-end dispatch
+#include "vtkSMPThreadLocal.h"           // For Initialized
+
+#include <algorithm>  // For std::min
+#include <functional> // For std::plus, std::less
+#include <iterator>   // For std::iterator_traits
+#include <vector>     // For partial results
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __VTK_WRAP__
@@ -90,7 +107,8 @@ struct vtkSMPTools_FunctorInternal<Functor, false>
   void Execute(vtkIdType first, vtkIdType last) { this->F(first, last); }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.For(first, last, grain, *this);
   }
   vtkSMPTools_FunctorInternal<Functor, false>& operator=(
     const vtkSMPTools_FunctorInternal<Functor, false>&);
@@ -119,7 +137,8 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
   }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.For(first, last, grain, *this);
     this->F.Reduce();
   }
   vtkSMPTools_FunctorInternal<Functor, true>& operator=(
@@ -144,6 +163,210 @@ class vtkSMPTools_Lookup_For<Functor const>
 public:
   typedef vtkSMPTools_FunctorInternal<Functor const, init> type;
 };
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename OutputIt, typename Functor>
+class vtkSMPTools_UnaryTransformCall
+{
+  InputIt In;
+  OutputIt Out;
+  Functor& Transform;
+
+public:
+  vtkSMPTools_UnaryTransformCall(InputIt in, OutputIt out, Functor& transform)
+    : In(in)
+    , Out(out)
+    , Transform(transform)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    InputIt it = this->In + begin;
+    OutputIt outIt = this->Out + begin;
+    for (vtkIdType i = begin; i < end; ++i, ++it, ++outIt)
+    {
+      *outIt = this->Transform(*it);
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+class vtkSMPTools_BinaryTransformCall
+{
+  InputIt1 In1;
+  InputIt2 In2;
+  OutputIt Out;
+  Functor& Transform;
+
+public:
+  vtkSMPTools_BinaryTransformCall(InputIt1 in1, InputIt2 in2, OutputIt out, Functor& transform)
+    : In1(in1)
+    , In2(in2)
+    , Out(out)
+    , Transform(transform)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    InputIt1 it1 = this->In1 + begin;
+    InputIt2 it2 = this->In2 + begin;
+    OutputIt outIt = this->Out + begin;
+    for (vtkIdType i = begin; i < end; ++i, ++it1, ++it2, ++outIt)
+    {
+      *outIt = this->Transform(*it1, *it2);
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename Iterator, typename T>
+class vtkSMPTools_FillCall
+{
+  Iterator Begin;
+  const T& Value;
+
+public:
+  vtkSMPTools_FillCall(Iterator begin, const T& value)
+    : Begin(begin)
+    , Value(value)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    Iterator it = this->Begin + begin;
+    for (vtkIdType i = begin; i < end; ++i, ++it)
+    {
+      *it = this->Value;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Reductions and scans cut the sequence into a fixed number of contiguous
+// chunks that only depends on the size of the sequence and the number of
+// threads, so that partial results are always combined in the same order
+// (only the associativity of the operation is required, not commutativity).
+// Returns 1 when the sequence is not worth processing in parallel.
+VTKCOMMONCORE_EXPORT vtkIdType vtkSMPTools_GetNumberOfChunks(vtkIdType size);
+
+//--------------------------------------------------------------------------------
+// Reduce every chunk of [Begin, Begin + Size) into Partials[chunk]. Chunks are
+// never empty, so a chunk is seeded with its first transformed element.
+template <typename Iterator, typename T, typename ReduceOp, typename TransformOp>
+class vtkSMPTools_TransformReduceCall
+{
+  Iterator Begin;
+  vtkIdType Size;
+  vtkIdType ChunkSize;
+  std::vector<T>& Partials;
+  ReduceOp& Reduce;
+  TransformOp& Transform;
+
+public:
+  vtkSMPTools_TransformReduceCall(Iterator begin, vtkIdType size, vtkIdType chunkSize,
+    std::vector<T>& partials, ReduceOp& reduce, TransformOp& transform)
+    : Begin(begin)
+    , Size(size)
+    , ChunkSize(chunkSize)
+    , Partials(partials)
+    , Reduce(reduce)
+    , Transform(transform)
+  {
+  }
+
+  void operator()(vtkIdType beginChunk, vtkIdType endChunk)
+  {
+    for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+    {
+      vtkIdType begin = chunk * this->ChunkSize;
+      vtkIdType end = std::min(begin + this->ChunkSize, this->Size);
+      Iterator it = this->Begin + begin;
+      T acc = this->Transform(*it);
+      for (++it, ++begin; begin < end; ++begin, ++it)
+      {
+        acc = this->Reduce(acc, this->Transform(*it));
+      }
+      this->Partials[chunk] = acc;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Second pass of a scan: every chunk is scanned starting from Carry[chunk],
+// the reduction of everything that precedes the chunk. The first chunk of an
+// inclusive scan has nothing to carry and starts from its first element.
+// Each element is read before being written, so the scan can be done in
+// place.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class vtkSMPTools_ScanCall
+{
+  InputIt In;
+  OutputIt Out;
+  vtkIdType Size;
+  vtkIdType ChunkSize;
+  const std::vector<T>& Carry;
+  bool Inclusive;
+  BinaryOp& Op;
+
+public:
+  vtkSMPTools_ScanCall(InputIt in, OutputIt out, vtkIdType size, vtkIdType chunkSize,
+    const std::vector<T>& carry, bool inclusive, BinaryOp& op)
+    : In(in)
+    , Out(out)
+    , Size(size)
+    , ChunkSize(chunkSize)
+    , Carry(carry)
+    , Inclusive(inclusive)
+    , Op(op)
+  {
+  }
+
+  void operator()(vtkIdType beginChunk, vtkIdType endChunk)
+  {
+    for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+    {
+      vtkIdType begin = chunk * this->ChunkSize;
+      vtkIdType end = std::min(begin + this->ChunkSize, this->Size);
+      InputIt it = this->In + begin;
+      OutputIt outIt = this->Out + begin;
+      if (this->Inclusive)
+      {
+        T acc = chunk == 0 ? T(*it) : this->Op(this->Carry[chunk], *it);
+        *outIt = acc;
+        for (++begin, ++it, ++outIt; begin < end; ++begin, ++it, ++outIt)
+        {
+          acc = this->Op(acc, *it);
+          *outIt = acc;
+        }
+      }
+      else
+      {
+        T acc = this->Carry[chunk];
+        for (; begin < end; ++begin, ++it, ++outIt)
+        {
+          T value = *it;
+          *outIt = acc;
+          acc = this->Op(acc, value);
+        }
+      }
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename T>
+struct vtkSMPTools_Identity
+{
+  template <typename U>
+  T operator()(const U& value) const
+  {
+    return value;
+  }
+};
 } // namespace smp
 } // namespace detail
 } // namespace vtk
@@ -224,15 +447,26 @@ public:
    */
   static const char* GetBackend();
 
+  /**
+   * Change the backend in use.
+   * The options are "Sequential", "STDThread", "TBB" and "OpenMP" (case
+   * insensitive); only the back-ends enabled at build time are available.
+   * Returns false and keeps the current backend when the requested one is
+   * not available.
+   * The VTK_SMP_BACKEND_IN_USE environment variable selects the backend used
+   * at startup the same way.
+   */
+  static bool SetBackend(const char* backend);
+
   /**
    * Initialize the underlying libraries for execution. This is
    * not required as it is automatically called before the first
    * execution of any parallel code. However, it can be used to
    * control the maximum number of threads used when the back-end
-   * supports it (currently Simple and TBB only). Make sure to call
+   * supports it (currently STDThread, OpenMP and TBB). Make sure to call
    * it before any other parallel operation.
-   * When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
-   * the number of threads used in the thread pool.
+   * The VTK_SMP_MAX_THREADS environment variable provides the default value.
+   * The number of threads is kept when the backend is changed.
    */
   static void Initialize(int numThreads = 0);
 
@@ -244,6 +478,28 @@ public:
    */
   static int GetEstimatedNumberOfThreads();
 
+  /**
+   * Enable or disable nested parallelism.
+   * When disabled, a For() called from within a parallel section is executed
+   * serially by the thread calling it. When enabled, it is split again and its
+   * tasks are shared with the other threads. The default depends on the
+   * backend: it is enabled for STDThread and TBB, whose schedulers compose
+   * nested loops without oversubscribing, and disabled for OpenMP and
+   * Sequential. The setting applies to all backends.
+   */
+  static void SetNestedParallelism(bool isNested);
+
+  /**
+   * Return true if nested parallelism is enabled for the backend in use.
+   */
+  static bool GetNestedParallelism();
+
+  /**
+   * Return true if it is called from within a parallel section of the
+   * backend in use.
+   */
+  static bool IsParallelScope();
+
   /**
    * A convenience method for sorting data. It is a drop in replacement for
    * std::sort(). Under the hood different methods are used. For example,
@@ -252,7 +508,8 @@ public:
   template <typename RandomAccessIterator>
   static void Sort(RandomAccessIterator begin, RandomAccessIterator end)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end);
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.Sort(begin, end);
   }
 
   /**
@@ -264,7 +521,250 @@ public:
   template <typename RandomAccessIterator, typename Compare>
   static void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end, comp);
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.Sort(begin, end, comp);
+  }
+
+  /**
+   * A convenience method for sorting data while preserving the relative
+   * order of equivalent elements. It is a drop in replacement for
+   * std::stable_sort(). Blocks are sorted in parallel with std::stable_sort()
+   * and merged in parallel with std::inplace_merge().
+   */
+  template <typename RandomAccessIterator>
+  static void StableSort(RandomAccessIterator begin, RandomAccessIterator end)
+  {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type ValueType;
+    vtkSMPTools::StableSort(begin, end, std::less<ValueType>());
+  }
+
+  /**
+   * A convenience method for sorting data while preserving the relative
+   * order of equivalent elements. This version of StableSort() takes a
+   * comparison class.
+   */
+  template <typename RandomAccessIterator, typename Compare>
+  static void StableSort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.StableSort(begin, end, comp);
+  }
+
+  /**
+   * A parallel drop in replacement for std::transform(): assign
+   * transform(*it) to the output for every it in [inBegin, inEnd).
+   * The iterators must be random access iterators, such as the ones of
+   * vtk::DataArrayValueRange(). The output may be the input.
+   *
+   * \code
+   * auto range = vtk::DataArrayValueRange<1>(array);
+   * vtkSMPTools::Transform(range.cbegin(), range.cend(), range.begin(),
+   *   [](double x) { return x * x; });
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename Functor>
+  static void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor transform)
+  {
+    vtk::detail::smp::vtkSMPTools_UnaryTransformCall<InputIt, OutputIt, Functor> worker(
+      inBegin, outBegin, transform);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(inEnd - inBegin), worker);
+  }
+
+  /**
+   * A parallel drop in replacement for the binary std::transform(): assign
+   * transform(*it1, *it2) to the output for every it1 in [inBegin1, inEnd)
+   * and the matching it2 starting from inBegin2.
+   */
+  template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+  static void Transform(
+    InputIt1 inBegin1, InputIt1 inEnd, InputIt2 inBegin2, OutputIt outBegin, Functor transform)
+  {
+    vtk::detail::smp::vtkSMPTools_BinaryTransformCall<InputIt1, InputIt2, OutputIt, Functor>
+      worker(inBegin1, inBegin2, outBegin, transform);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(inEnd - inBegin1), worker);
+  }
+
+  /**
+   * A parallel drop in replacement for std::fill(): assign value to every
+   * element of [begin, end).
+   */
+  template <typename Iterator, typename T>
+  static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtk::detail::smp::vtkSMPTools_FillCall<Iterator, T> worker(begin, value);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(end - begin), worker);
+  }
+
+  /**
+   * Reduce [begin, end) with reduce(transform(*it), ...), starting from init.
+   * It is the parallel equivalent of std::transform_reduce(). reduce must be
+   * associative. Partial results are computed over contiguous chunks and
+   * combined in order, so the result does not depend on the scheduling;
+   * with floating point values it may however differ from a serial
+   * accumulation, and depend on the number of threads.
+   */
+  template <typename Iterator, typename T, typename ReduceOp, typename TransformOp>
+  static T TransformReduce(
+    Iterator begin, Iterator end, T init, ReduceOp reduce, TransformOp transform)
+  {
+    const vtkIdType size = static_cast<vtkIdType>(end - begin);
+    const vtkIdType numChunks = vtk::detail::smp::vtkSMPTools_GetNumberOfChunks(size);
+    if (numChunks <= 1)
+    {
+      for (; begin != end; ++begin)
+      {
+        init = reduce(init, transform(*begin));
+      }
+      return init;
+    }
+
+    const vtkIdType chunkSize = (size + numChunks - 1) / numChunks;
+    std::vector<T> partials(static_cast<size_t>(numChunks), init);
+    vtk::detail::smp::vtkSMPTools_TransformReduceCall<Iterator, T, ReduceOp, TransformOp> worker(
+      begin, size, chunkSize, partials, reduce, transform);
+    vtkSMPTools::For(0, (size + chunkSize - 1) / chunkSize, 1, worker);
+
+    for (vtkIdType chunk = 0; chunk * chunkSize < size; ++chunk)
+    {
+      init = reduce(init, partials[chunk]);
+    }
+    return init;
+  }
+
+  /**
+   * Reduce [begin, end) with op, starting from init. It is the parallel
+   * equivalent of std::reduce(), see TransformReduce().
+   */
+  template <typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+  {
+    return vtkSMPTools::TransformReduce(
+      begin, end, init, op, vtk::detail::smp::vtkSMPTools_Identity<T>());
+  }
+
+  /**
+   * Sum [begin, end), starting from init.
+   */
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+
+  /**
+   * Inclusive prefix scan: the i-th output is the reduction with op of the
+   * first i+1 inputs. It is the parallel equivalent of
+   * std::inclusive_scan(). op must be associative. The output may be the
+   * input. Returns the end of the output.
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt out, BinaryOp op)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type T;
+    const vtkIdType size = static_cast<vtkIdType>(end - begin);
+    if (size <= 0)
+    {
+      return out;
+    }
+    const vtkIdType numChunks = vtk::detail::smp::vtkSMPTools_GetNumberOfChunks(size);
+    const vtkIdType chunkSize = (size + numChunks - 1) / numChunks;
+    const vtkIdType usedChunks = (size + chunkSize - 1) / chunkSize;
+
+    std::vector<T> carry(static_cast<size_t>(usedChunks), T(*begin));
+    if (usedChunks > 1)
+    {
+      // carry[c] = reduction of all the chunks before c
+      vtk::detail::smp::vtkSMPTools_Identity<T> identity;
+      vtk::detail::smp::vtkSMPTools_TransformReduceCall<InputIt, T, BinaryOp,
+        vtk::detail::smp::vtkSMPTools_Identity<T> >
+        reducer(begin, size, chunkSize, carry, op, identity);
+      vtkSMPTools::For(0, usedChunks - 1, 1, reducer);
+      for (vtkIdType chunk = usedChunks - 1; chunk > 0; --chunk)
+      {
+        carry[chunk] = carry[chunk - 1];
+      }
+      for (vtkIdType chunk = 2; chunk < usedChunks; ++chunk)
+      {
+        carry[chunk] = op(carry[chunk - 1], carry[chunk]);
+      }
+    }
+
+    vtk::detail::smp::vtkSMPTools_ScanCall<InputIt, OutputIt, T, BinaryOp> scanner(
+      begin, out, size, chunkSize, carry, true, op);
+    vtkSMPTools::For(0, usedChunks, 1, scanner);
+    return out + size;
+  }
+
+  /**
+   * Inclusive prefix sum, see InclusiveScan().
+   */
+  template <typename InputIt, typename OutputIt>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt out)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type T;
+    return vtkSMPTools::InclusiveScan(begin, end, out, std::plus<T>());
+  }
+
+  /**
+   * Exclusive prefix scan: the i-th output is the reduction with op of init
+   * and the first i inputs. It is the parallel equivalent of
+   * std::exclusive_scan(), typically used to turn counts into offsets:
+   *
+   * \code
+   * // offsets has one more entry than counts
+   * vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets.begin(), 0);
+   * offsets.back() = offsets[counts.size() - 1] + counts.back();
+   * \endcode
+   *
+   * op must be associative. The output may be the input. Returns the end of
+   * the output.
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static OutputIt ExclusiveScan(InputIt begin, InputIt end, OutputIt out, T init, BinaryOp op)
+  {
+    const vtkIdType size = static_cast<vtkIdType>(end - begin);
+    if (size <= 0)
+    {
+      return out;
+    }
+    const vtkIdType numChunks = vtk::detail::smp::vtkSMPTools_GetNumberOfChunks(size);
+    const vtkIdType chunkSize = (size + numChunks - 1) / numChunks;
+    const vtkIdType usedChunks = (size + chunkSize - 1) / chunkSize;
+
+    std::vector<T> carry(static_cast<size_t>(usedChunks), init);
+    if (usedChunks > 1)
+    {
+      // carry[c] = init reduced with all the chunks before c
+      vtk::detail::smp::vtkSMPTools_Identity<T> identity;
+      vtk::detail::smp::vtkSMPTools_TransformReduceCall<InputIt, T, BinaryOp,
+        vtk::detail::smp::vtkSMPTools_Identity<T> >
+        reducer(begin, size, chunkSize, carry, op, identity);
+      vtkSMPTools::For(0, usedChunks - 1, 1, reducer);
+      T acc = init;
+      for (vtkIdType chunk = 0; chunk < usedChunks; ++chunk)
+      {
+        T partial = carry[chunk];
+        carry[chunk] = acc;
+        if (chunk + 1 < usedChunks)
+        {
+          acc = op(acc, partial);
+        }
+      }
+    }
+
+    vtk::detail::smp::vtkSMPTools_ScanCall<InputIt, OutputIt, T, BinaryOp> scanner(
+      begin, out, size, chunkSize, carry, false, op);
+    vtkSMPTools::For(0, usedChunks, 1, scanner);
+    return out + size;
+  }
+
+  /**
+   * Exclusive prefix sum starting from init, see ExclusiveScan().
+   */
+  template <typename InputIt, typename OutputIt, typename T>
+  static OutputIt ExclusiveScan(InputIt begin, InputIt end, OutputIt out, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, out, init, std::plus<T>());
   }
 };
 
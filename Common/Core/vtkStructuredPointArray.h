@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStructuredPointArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkStructuredPointArray
+ * @brief   An implicit array of the point coordinates of a structured grid.
+ *
+ * vtkStructuredPointArray is a 3-component vtkImplicitArray backed by
+ * vtkStructuredPointBackend. It computes the coordinates of the points of an
+ * image or a rectilinear grid from their index, in the same order as
+ * vtkImageData::GetPoint() and vtkRectilinearGrid::GetPoint(), and only
+ * stores the coordinates along each axis:
+ *
+ * @code{cpp}
+ * vtkNew<vtkStructuredPointArray<double>> coordinates;
+ * coordinates->ConstructBackend(
+ *   image->GetExtent(), image->GetIndexToPhysicalMatrix()->GetData());
+ * coordinates->SetNumberOfComponents(3);
+ * coordinates->SetNumberOfTuples(image->GetNumberOfPoints());
+ * @endcode
+ *
+ * The coordinates are exactly the ones returned by GetPoint() on the grid.
+ * When the grid axes are aligned with the coordinate axes, each component is
+ * a lookup in the coordinates of its axis.
+ *
+ * @sa
+ * vtkImplicitArray vtkImageDataToPointSet vtkRectilinearGridToPointSet
+ */
+
+#ifndef vtkStructuredPointArray_h
+#define vtkStructuredPointArray_h
+
+#include "vtkDataArray.h"
+#include "vtkImplicitArray.h"
+
+#include <algorithm> // For copy, fill
+#include <vector>    // For vector
+
+template <typename ValueT>
+class vtkStructuredPointBackend
+{
+public:
+  vtkStructuredPointBackend()
+    : AxisAligned(true)
+  {
+    std::fill(this->Matrix, this->Matrix + 12, 0.0);
+    this->Dimensions[0] = this->Dimensions[1] = 0;
+  }
+
+  /**
+   * Points of a rectilinear grid of the given extent, with the coordinates
+   * along each axis.
+   */
+  vtkStructuredPointBackend(
+    const int extent[6], vtkDataArray* xCoords, vtkDataArray* yCoords, vtkDataArray* zCoords)
+    : AxisAligned(true)
+  {
+    std::fill(this->Matrix, this->Matrix + 12, 0.0);
+    vtkDataArray* coords[3] = { xCoords, yCoords, zCoords };
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const vtkIdType size = extent[2 * axis + 1] - extent[2 * axis] + 1;
+      this->Axes[axis].resize(size > 0 ? size : 0);
+      for (vtkIdType i = 0; i < size; ++i)
+      {
+        this->Axes[axis][i] = coords[axis]->GetComponent(i, 0);
+      }
+    }
+    this->Dimensions[0] = static_cast<vtkIdType>(this->Axes[0].size());
+    this->Dimensions[1] = static_cast<vtkIdType>(this->Axes[1].size());
+  }
+
+  /**
+   * Points of an image of the given extent, with the elements of its index
+   * to physical matrix (see vtkImageData::GetIndexToPhysicalMatrix()).
+   */
+  vtkStructuredPointBackend(const int extent[6], const double indexToPhysical[16])
+  {
+    const double* m = indexToPhysical;
+    this->AxisAligned = m[1] == 0.0 && m[2] == 0.0 && m[4] == 0.0 && m[6] == 0.0 &&
+      m[8] == 0.0 && m[9] == 0.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const int size = extent[2 * axis + 1] - extent[2 * axis] + 1;
+      this->Axes[axis].resize(size > 0 ? size : 0);
+      for (int i = 0; i < size; ++i)
+      {
+        // Adding the zero terms of the matrix product does not change the
+        // result, so the coordinates of aligned images are precomputed.
+        const int index = extent[2 * axis] + i;
+        this->Axes[axis][i] =
+          this->AxisAligned ? m[5 * axis] * index + m[4 * axis + 3] : static_cast<double>(index);
+      }
+    }
+    std::copy(m, m + 12, this->Matrix);
+    this->Dimensions[0] = static_cast<vtkIdType>(this->Axes[0].size());
+    this->Dimensions[1] = static_cast<vtkIdType>(this->Axes[1].size());
+  }
+
+  ValueT operator()(vtkIdType valueIdx) const
+  {
+    const vtkIdType ptId = valueIdx / 3;
+    return this->MapComponent(ptId, static_cast<int>(valueIdx - 3 * ptId));
+  }
+
+  void MapTuple(vtkIdType ptId, ValueT* tuple) const
+  {
+    const double x = this->Axes[0][ptId % this->Dimensions[0]];
+    const double y = this->Axes[1][(ptId / this->Dimensions[0]) % this->Dimensions[1]];
+    const double z = this->Axes[2][ptId / (this->Dimensions[0] * this->Dimensions[1])];
+    if (this->AxisAligned)
+    {
+      tuple[0] = static_cast<ValueT>(x);
+      tuple[1] = static_cast<ValueT>(y);
+      tuple[2] = static_cast<ValueT>(z);
+    }
+    else
+    {
+      const double* m = this->Matrix;
+      tuple[0] = static_cast<ValueT>(m[0] * x + m[1] * y + m[2] * z + m[3]);
+      tuple[1] = static_cast<ValueT>(m[4] * x + m[5] * y + m[6] * z + m[7]);
+      tuple[2] = static_cast<ValueT>(m[8] * x + m[9] * y + m[10] * z + m[11]);
+    }
+  }
+
+  ValueT MapComponent(vtkIdType ptId, int comp) const
+  {
+    if (this->AxisAligned)
+    {
+      switch (comp)
+      {
+        case 0:
+          return static_cast<ValueT>(this->Axes[0][ptId % this->Dimensions[0]]);
+        case 1:
+          return static_cast<ValueT>(
+            this->Axes[1][(ptId / this->Dimensions[0]) % this->Dimensions[1]]);
+        default:
+          return static_cast<ValueT>(
+            this->Axes[2][ptId / (this->Dimensions[0] * this->Dimensions[1])]);
+      }
+    }
+    ValueT tuple[3];
+    this->MapTuple(ptId, tuple);
+    return tuple[comp];
+  }
+
+protected:
+  // The coordinates along each axis, or the indices along each axis when the
+  // image is not aligned with the coordinate axes.
+  std::vector<double> Axes[3];
+  double Matrix[12];
+  vtkIdType Dimensions[2];
+  bool AxisAligned;
+};
+
+template <typename ValueT>
+using vtkStructuredPointArray = vtkImplicitArray<vtkStructuredPointBackend<ValueT>>;
+
+#endif // vtkStructuredPointArray_h
+
+// VTK-HeaderTest-Exclude: vtkStructuredPointArray.h
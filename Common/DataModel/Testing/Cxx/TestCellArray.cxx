@@ -945,6 +945,35 @@ void TestShallowCopy(vtkSmartPointer<vtkCellArray> cellArray)
   TEST_ASSERT(cellArray->GetConnectivityArray() == other->GetConnectivityArray());
 }
 
+void TestCompactStorage(vtkSmartPointer<vtkCellArray> cellArray)
+{
+  vtkLogScopeFunction(INFO);
+
+  FillCellArray(cellArray);
+
+  vtkNew<vtkCellArray> other;
+  other->ShallowCopy(cellArray);
+
+  vtkCellArray::SetGlobalCompactStorage(true);
+  other->Squeeze();
+  vtkCellArray::SetGlobalCompactStorage(false);
+
+  // The shallow copy is converted without altering the shared arrays.
+  TEST_ASSERT(!other->IsStorage64Bit());
+  ValidateCellArray(other);
+  ValidateCellArray(cellArray);
+
+  // Ids beyond 32 bits prevent the conversion.
+  if (cellArray->IsStorage64Bit())
+  {
+    cellArray->InsertNextCell({ 0, static_cast<vtkIdType>(VTK_INT_MAX) + 1 });
+    vtkCellArray::SetGlobalCompactStorage(true);
+    cellArray->Squeeze();
+    vtkCellArray::SetGlobalCompactStorage(false);
+    TEST_ASSERT(cellArray->IsStorage64Bit());
+  }
+}
+
 void TestAppendImpl(vtkSmartPointer<vtkCellArray> first, vtkSmartPointer<vtkCellArray> second)
 {
   first->InsertNextCell({ 0, 1, 2 });
@@ -1377,6 +1406,7 @@ void RunTests(bool use64BitStorage)
   TestGetMaxCellSize(NewCellArray(use64BitStorage));
   TestDeepCopy(NewCellArray(use64BitStorage));
   TestShallowCopy(NewCellArray(use64BitStorage));
+  TestCompactStorage(NewCellArray(use64BitStorage));
   TestAppend32(NewCellArray(use64BitStorage));
   TestAppend64(NewCellArray(use64BitStorage));
   TestLegacyFormatImportExportAppend(NewCellArray(use64BitStorage));
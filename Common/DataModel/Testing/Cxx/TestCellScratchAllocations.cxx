@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellScratchAllocations.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that a generic cell reused in a loop over cells stops allocating
+// once it has seen each cell, counting every call to operator new.
+
+#include "vtkCell.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolygon.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+std::atomic<long long> NumberOfAllocations(0);
+}
+
+// Count the allocations of the whole test executable. The other tests only
+// see the default behavior.
+void* operator new(std::size_t size)
+{
+  NumberOfAllocations++;
+  if (void* ptr = std::malloc(size ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+// A grid with a tetrahedron, a hexahedron, a polyhedron and a concave polygon.
+void BuildGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  const double cube[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+    { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+  for (int i = 0; i < 8; ++i)
+  {
+    points->InsertNextPoint(cube[i]);
+  }
+  const double star[6][3] = { { 2, 0, 0 }, { 4, 0, 0 }, { 3.2, 1, 0 }, { 4, 2, 0 }, { 2, 2, 0 },
+    { 2.8, 1, 0 } };
+  for (int i = 0; i < 6; ++i)
+  {
+    points->InsertNextPoint(star[i]);
+  }
+  grid->SetPoints(points);
+  grid->Allocate(4);
+
+  const vtkIdType tetra[4] = { 0, 1, 3, 4 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+  const vtkIdType hexahedron[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  grid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedron);
+  const vtkIdType faces[] = { 4, 0, 3, 2, 1, 4, 4, 5, 6, 7, 4, 0, 1, 5, 4, 4, 1, 2, 6, 5, 4, 2, 3,
+    7, 6, 4, 3, 0, 4, 7 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 8, hexahedron, 6, faces);
+  const vtkIdType polygon[6] = { 8, 9, 10, 11, 12, 13 };
+  grid->InsertNextCell(VTK_POLYGON, 6, polygon);
+}
+
+// Exercise the helpers of each cell of the grid.
+void VisitCells(vtkUnstructuredGrid* grid, vtkGenericCell* cell, vtkIdList* ptIds, vtkPoints* pts)
+{
+  double weights[VTK_CELL_SIZE];
+  double values[VTK_CELL_SIZE];
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCell(cellId, cell);
+    double x[3], closest[3], pcoords[3], dist2, derivs[3];
+    int subId;
+    cell->GetParametricCenter(pcoords);
+    cell->EvaluateLocation(subId, pcoords, x, weights);
+    cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights);
+    cell->InterpolateFunctions(x, weights);
+    for (vtkIdType i = 0; i < cell->GetNumberOfPoints(); ++i)
+    {
+      values[i] = static_cast<double>(i);
+    }
+    cell->Derivatives(subId, pcoords, values, 1, derivs);
+    cell->Triangulate(0, ptIds, pts);
+    cell->CellBoundary(subId, pcoords, ptIds);
+  }
+}
+}
+
+int TestCellScratchAllocations(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(grid);
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkPoints> pts;
+
+  const vtkIdType start = vtkCell::GetNumberOfScratchAllocations();
+  VisitCells(grid, cell, ptIds, pts);
+  if (vtkCell::GetNumberOfScratchAllocations() <= start)
+  {
+    std::cerr << "The first loop over the cells should grow the scratch storage" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const long long warm = NumberOfAllocations;
+  for (int i = 0; i < 3; ++i)
+  {
+    VisitCells(grid, cell, ptIds, pts);
+  }
+  if (NumberOfAllocations != warm)
+  {
+    std::cerr << "Warm loops over the cells allocated " << NumberOfAllocations - warm << " times"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Mean value coordinates of polygons use scratch storage too.
+  vtkNew<vtkPolygon> polygon;
+  polygon->DeepCopy(cell->GetRepresentativeCell());
+  polygon->SetUseMVCInterpolation(true);
+  double x[3] = { 3.0, 0.5, 0.0 }, weights[6];
+  polygon->InterpolateFunctions(x, weights);
+  const long long mvc = NumberOfAllocations;
+  for (int i = 0; i < 10; ++i)
+  {
+    x[0] = 2.1 + 0.1 * i;
+    polygon->InterpolateFunctions(x, weights);
+  }
+  if (NumberOfAllocations != mvc)
+  {
+    std::cerr << "Mean value coordinates allocated " << NumberOfAllocations - mvc
+              << " times when warm" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyhedronReuse.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the compressed sparse row form of the polyhedron faces of
+// vtkUnstructuredGrid, the polyhedra that GetCell() loads from it, and the
+// reuse of the structures of vtkPolyhedron when the same cell is loaded again.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Compare the faces of each cell in both representations, and with the faces
+// of the polyhedra loaded by GetCell().
+int CheckFaces(vtkUnstructuredGrid* grid)
+{
+  vtkCellArray* faces = grid->GetPolyhedronFaces();
+  vtkCellArray* faceLocations = grid->GetPolyhedronFaceLocations();
+  if (!faces || !faceLocations || faceLocations->GetNumberOfCells() != grid->GetNumberOfCells())
+  {
+    std::cerr << "Missing polyhedron faces" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (faces->IsStorage64Bit() || faceLocations->IsStorage64Bit())
+  {
+    std::cerr << "Polyhedron faces should use 32-bit storage" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkIdList> stream;
+  vtkNew<vtkIdList> faceIds;
+  vtkNew<vtkIdList> facePts;
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    faceLocations->GetCellAtId(cellId, faceIds);
+    if (grid->GetCellType(cellId) != VTK_POLYHEDRON)
+    {
+      if (faceIds->GetNumberOfIds() != 0)
+      {
+        std::cerr << "Cell " << cellId << " should have no faces" << std::endl;
+        return EXIT_FAILURE;
+      }
+      continue;
+    }
+
+    grid->GetFaceStream(cellId, stream);
+    grid->GetCell(cellId, cell);
+    if (faceIds->GetNumberOfIds() != stream->GetId(0) ||
+      cell->GetNumberOfFaces() != stream->GetId(0))
+    {
+      std::cerr << "Wrong number of faces for cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+    const vtkIdType* cellFaces = cell->GetFaces();
+    vtkIdType loc = 1;
+    for (vtkIdType i = 0; i < faceIds->GetNumberOfIds(); ++i)
+    {
+      faces->GetCellAtId(faceIds->GetId(i), facePts);
+      vtkIdList* cellFacePts = cell->GetFace(i)->GetPointIds();
+      const vtkIdType npts = stream->GetId(loc);
+      if (facePts->GetNumberOfIds() != npts || cellFacePts->GetNumberOfIds() != npts ||
+        cellFaces[loc] != npts)
+      {
+        std::cerr << "Wrong size of face " << i << " of cell " << cellId << std::endl;
+        return EXIT_FAILURE;
+      }
+      ++loc;
+      for (vtkIdType j = 0; j < npts; ++j, ++loc)
+      {
+        const vtkIdType ptId = stream->GetId(loc);
+        if (facePts->GetId(j) != ptId || cellFacePts->GetId(j) != ptId || cellFaces[loc] != ptId)
+        {
+          std::cerr << "Wrong point of face " << i << " of cell " << cellId << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Evaluate a position in a cell and check the squared distance to it.
+int CheckPosition(
+  vtkUnstructuredGrid* grid, vtkGenericCell* cell, vtkIdType cellId, double x[3], double dist2)
+{
+  grid->GetCell(cellId, cell);
+  double closest[3], pcoords[3], minDist2, weights[8];
+  int subId;
+  int inside = cell->EvaluatePosition(x, closest, subId, pcoords, minDist2, weights);
+  if (inside != (dist2 == 0.0) || std::abs(minDist2 - dist2) > 1e-9)
+  {
+    std::cerr << "Wrong position in cell " << cellId << ": " << inside << " " << minDist2
+              << " instead of " << dist2 << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (dist2 > 0.0 && std::abs(vtkMath::Distance2BetweenPoints(x, closest) - dist2) > 1e-9)
+  {
+    std::cerr << "Wrong closest point in cell " << cellId << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestPolyhedronReuse(int, char*[])
+{
+  // Two unit cubes side by side.
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->Allocate(4);
+  const vtkIdType tetra[4] = { 0, 1, 3, 6 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+  if (grid->GetPolyhedronFaces() || grid->GetPolyhedronFaceLocations())
+  {
+    std::cerr << "A grid without polyhedra has no faces" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (vtkIdType i = 0; i < 2; ++i)
+  {
+    const vtkIdType pts[8] = { i, i + 1, i + 4, i + 3, i + 6, i + 7, i + 10, i + 9 };
+    const vtkIdType faces[30] = { 4, pts[0], pts[3], pts[2], pts[1], 4, pts[4], pts[5], pts[6],
+      pts[7], 4, pts[0], pts[1], pts[5], pts[4], 4, pts[2], pts[3], pts[7], pts[6], 4, pts[0],
+      pts[4], pts[7], pts[3], 4, pts[1], pts[2], pts[6], pts[5] };
+    grid->InsertNextCell(VTK_POLYHEDRON, 8, pts, 6, faces);
+  }
+  if (CheckFaces(grid) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The faces are rebuilt when polyhedra are added.
+
+  const vtkIdType pyramid[5] = { 0, 1, 4, 3, 7 };
+  const vtkIdType pyramidFaces[21] = { 4, 0, 3, 4, 1, 3, 0, 1, 7, 3, 1, 4, 7, 3, 4, 3, 7, 3, 3, 0,
+    7 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 5, pyramid, 5, pyramidFaces);
+  if (CheckFaces(grid) != EXIT_SUCCESS || grid->GetPolyhedronFaces()->GetNumberOfCells() != 17)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Loading the same polyhedron again reuses its structures, but they are
+  // rebuilt when its points are modified.
+  vtkNew<vtkGenericCell> cell;
+  double inside[3] = { 0.5, 0.5, 0.5 };
+  double outside[3] = { 3.0, 0.5, 0.5 };
+  if (CheckPosition(grid, cell, 1, inside, 0.0) != EXIT_SUCCESS ||
+    CheckPosition(grid, cell, 1, outside, 4.0) != EXIT_SUCCESS ||
+    CheckPosition(grid, cell, 2, outside, 1.0) != EXIT_SUCCESS ||
+    CheckPosition(grid, cell, 1, outside, 4.0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  points->SetPoint(1, 2.0, 0.0, 0.0);
+  points->SetPoint(4, 2.0, 1.0, 0.0);
+  points->SetPoint(7, 2.0, 0.0, 1.0);
+  points->SetPoint(10, 2.0, 1.0, 1.0);
+  points->Modified();
+  if (CheckPosition(grid, cell, 1, outside, 1.0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
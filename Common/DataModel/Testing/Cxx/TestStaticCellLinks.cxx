@@ -12,7 +12,10 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
 #include "vtkExtractGeometry.h"
+#include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
@@ -23,6 +26,37 @@
 #include "vtkTimerLog.h"
 #include "vtkUnstructuredGrid.h"
 
+namespace
+{
+// Compare the links of a polydata with those of vtkCellLinks, cell by cell
+// and in the same order.
+int CompareWithCellLinks(vtkPolyData* pdata, vtkStaticCellLinksTemplate<int>& slinks)
+{
+  vtkSmartPointer<vtkCellLinks> links = vtkSmartPointer<vtkCellLinks>::New();
+  links->Allocate(pdata->GetNumberOfPoints());
+  links->BuildLinks(pdata);
+  for (vtkIdType ptId = 0; ptId < pdata->GetNumberOfPoints(); ++ptId)
+  {
+    const int numCells = slinks.GetNumberOfCells(ptId);
+    const int* cells = slinks.GetCells(ptId);
+    if (numCells != links->GetNcells(ptId))
+    {
+      cout << "Wrong number of cells for point " << ptId << "\n";
+      return EXIT_FAILURE;
+    }
+    for (int i = 0; i < numCells; ++i)
+    {
+      if (cells[i] != links->GetCells(ptId)[i])
+      {
+        cout << "Wrong cells for point " << ptId << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
 // Test the building of static cell links in both unstructured and structured
 // grids.
 int TestStaticCellLinks(int, char*[])
@@ -194,5 +228,85 @@ int TestStaticCellLinks(int, char*[])
     return EXIT_FAILURE;
   }
 
+  //----------------------------------------------------------------------------
+  // Polydata mixing vertices, lines and polygons. The threaded and serial
+  // builds list the cells of each point in the order of vtkCellLinks.
+  vtkSmartPointer<vtkPolyData> mixed = vtkSmartPointer<vtkPolyData>::New();
+  mixed->DeepCopy(pdata);
+  vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+  for (vtkIdType ptId = 0; ptId < mixed->GetNumberOfPoints(); ++ptId)
+  {
+    verts->InsertNextCell(1, &ptId);
+    const vtkIdType line[2] = { ptId, (ptId + 1) % mixed->GetNumberOfPoints() };
+    lines->InsertNextCell(2, line);
+  }
+  mixed->SetVerts(verts);
+  mixed->SetLines(lines);
+
+  for (int sequential = 0; sequential < 2; ++sequential)
+  {
+    vtkStaticCellLinksTemplate<int> mlinks;
+    mlinks.SetSequentialProcessing(sequential);
+    mlinks.BuildLinks(mixed);
+    if (CompareWithCellLinks(mixed, mlinks) != EXIT_SUCCESS)
+    {
+      cout << "Mixed polydata links differ (sequential " << sequential << ")\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // vtkPolyData builds static links unless it is editable, and answers the
+  // topological queries the same way with both.
+  vtkSmartPointer<vtkPolyData> editable = vtkSmartPointer<vtkPolyData>::New();
+  editable->DeepCopy(mixed);
+  editable->EditableOn();
+  mixed->BuildLinks();
+  editable->BuildLinks();
+  if (!vtkStaticCellLinks::SafeDownCast(mixed->GetCellLinks()) ||
+    !vtkCellLinks::SafeDownCast(editable->GetCellLinks()))
+  {
+    cout << "Wrong type of polydata links\n";
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> neighbors = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> editableNeighbors = vtkSmartPointer<vtkIdList>::New();
+  for (vtkIdType cellId = 0; cellId < mixed->GetNumberOfCells(); ++cellId)
+  {
+    mixed->GetCellPoints(cellId, ptIds);
+    mixed->GetCellNeighbors(cellId, ptIds, neighbors);
+    editable->GetCellNeighbors(cellId, ptIds, editableNeighbors);
+    if (neighbors->GetNumberOfIds() != editableNeighbors->GetNumberOfIds())
+    {
+      cout << "Wrong neighbors of cell " << cellId << "\n";
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+    {
+      if (neighbors->GetId(i) != editableNeighbors->GetId(i))
+      {
+        cout << "Wrong neighbors of cell " << cellId << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Editing the links of a non editable polydata rebuilds them as
+  // vtkCellLinks first.
+  vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
+  mixed->GetPointCells(0, cellIds);
+  const vtkIdType numPointCells = cellIds->GetNumberOfIds();
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  const vtkIdType triangleId = mixed->InsertNextLinkedCell(VTK_TRIANGLE, 3, triangle);
+  mixed->GetPointCells(0, cellIds);
+  if (!vtkCellLinks::SafeDownCast(mixed->GetCellLinks()) || !mixed->GetEditable() ||
+    cellIds->GetNumberOfIds() != numPointCells + 1 ||
+    cellIds->GetId(numPointCells) != triangleId)
+  {
+    cout << "Wrong links after editing a non editable polydata\n";
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -17,11 +17,193 @@
 
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+namespace
+{
+// Per-thread scratch space of the batched queries.
+struct BatchedQueryScratch
+{
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+  int MaxCellSize;
+
+  BatchedQueryScratch(vtkDataSet* ds)
+    : MaxCellSize(ds ? ds->GetMaxCellSize() : 0)
+  {
+  }
+
+  double* LocalWeights()
+  {
+    std::vector<double>& weights = this->Weights.Local();
+    if (weights.empty())
+    {
+      weights.resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1);
+    }
+    return weights.data();
+  }
+};
+
+struct FindCellsWorker : public BatchedQueryScratch
+{
+  vtkAbstractCellLocator* Locator;
+  vtkPoints* Points;
+  double Tol2;
+  vtkIdType* CellIds;
+  double* PCoords;
+
+  FindCellsWorker(vtkAbstractCellLocator* locator, vtkPoints* points, double tol2,
+    vtkIdType* cellIds, double* pcoords)
+    : BatchedQueryScratch(locator->GetDataSet())
+    , Locator(locator)
+    , Points(points)
+    , Tol2(tol2)
+    , CellIds(cellIds)
+    , PCoords(pcoords)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double* weights = this->LocalWeights();
+    double x[3], pcoords[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      this->CellIds[ptId] = this->Locator->FindCell(x, this->Tol2, cell, pcoords, weights);
+      if (this->PCoords)
+      {
+        double* p = this->PCoords + 3 * ptId;
+        p[0] = pcoords[0];
+        p[1] = pcoords[1];
+        p[2] = pcoords[2];
+      }
+    }
+  }
+};
+
+struct FindClosestPointsWorker : public BatchedQueryScratch
+{
+  vtkAbstractCellLocator* Locator;
+  vtkPoints* Points;
+  vtkIdType* CellIds;
+  vtkPoints* ClosestPoints;
+  double* Dist2;
+
+  FindClosestPointsWorker(vtkAbstractCellLocator* locator, vtkPoints* points, vtkIdType* cellIds,
+    vtkPoints* closestPoints, double* dist2)
+    : BatchedQueryScratch(locator->GetDataSet())
+    , Locator(locator)
+    , Points(points)
+    , CellIds(cellIds)
+    , ClosestPoints(closestPoints)
+    , Dist2(dist2)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double x[3], closest[3], dist2;
+    int subId;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      vtkIdType cellId = -1;
+      dist2 = vtkMath::Inf();
+      closest[0] = closest[1] = closest[2] = 0.0;
+      this->Locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+      this->CellIds[ptId] = cellId;
+      if (this->ClosestPoints)
+      {
+        this->ClosestPoints->SetPoint(ptId, closest);
+      }
+      if (this->Dist2)
+      {
+        this->Dist2[ptId] = dist2;
+      }
+    }
+  }
+};
+
+struct IntersectWithLinesWorker : public BatchedQueryScratch
+{
+  vtkAbstractCellLocator* Locator;
+  vtkPoints* P1s;
+  vtkPoints* P2s;
+  double Tol;
+  vtkIdType* CellIds;
+  double* Ts;
+  vtkPoints* Xs;
+
+  IntersectWithLinesWorker(vtkAbstractCellLocator* locator, vtkPoints* p1s, vtkPoints* p2s,
+    double tol, vtkIdType* cellIds, double* ts, vtkPoints* xs)
+    : BatchedQueryScratch(locator->GetDataSet())
+    , Locator(locator)
+    , P1s(p1s)
+    , P2s(p2s)
+    , Tol(tol)
+    , CellIds(cellIds)
+    , Ts(ts)
+    , Xs(xs)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double p1[3], p2[3], x[3], pcoords[3], t;
+    int subId;
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      this->P1s->GetPoint(lineId, p1);
+      this->P2s->GetPoint(lineId, p2);
+      vtkIdType cellId = -1;
+      t = 0.0;
+      x[0] = x[1] = x[2] = 0.0;
+      if (!this->Locator->IntersectWithLine(p1, p2, this->Tol, t, x, pcoords, subId, cellId, cell))
+      {
+        cellId = -1;
+      }
+      this->CellIds[lineId] = cellId;
+      if (this->Ts)
+      {
+        this->Ts[lineId] = t;
+      }
+      if (this->Xs)
+      {
+        this->Xs->SetPoint(lineId, x);
+      }
+    }
+  }
+};
+
+// Run a batched query, in parallel if the locator supports it.
+template <typename TWorker>
+void RunBatchedQuery(vtkAbstractCellLocator* locator, vtkIdType num, TWorker& worker)
+{
+  if (locator->SupportsConcurrentQueries())
+  {
+    vtkSMPTools::For(0, num, worker);
+  }
+  else
+  {
+    worker(0, num);
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -51,10 +233,21 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return true;
   }
+
+  // Trigger the non thread safe initialization of the data set, if any
+  vtkDataSet* ds = this->DataSet;
+  double(*cellBounds)[6] = this->CellBounds;
+  ds->GetCellBounds(0, cellBounds[0]);
+  vtkSMPTools::For(1, numCells, [ds, cellBounds](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType j = begin; j < end; j++)
+    {
+      ds->GetCellBounds(j, cellBounds[j]);
+    }
+  });
   return true;
 }
 //------------------------------------------------------------------------------
@@ -189,6 +382,98 @@ bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
   }
   return false;
 }
+//------------------------------------------------------------------------------
+// Build the locator, and the cells of the dataset, so that the queries
+// do not modify either of them when run concurrently.
+void vtkAbstractCellLocator::PrepareBatchedQueries()
+{
+  this->BuildLocator();
+  if (this->DataSet && this->DataSet->GetNumberOfCells() > 0)
+  {
+    this->DataSet->GetCell(0, this->GenericCell);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints* points, double tol2, vtkIdList* cellIds, vtkDoubleArray* pcoords)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numPts);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numPts);
+  }
+  if (numPts < 1)
+  {
+    return;
+  }
+
+  this->PrepareBatchedQueries();
+  FindCellsWorker worker(
+    this, points, tol2, cellIds->GetPointer(0), pcoords ? pcoords->GetPointer(0) : nullptr);
+  RunBatchedQuery(this, numPts, worker);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoints(
+  vtkPoints* points, vtkIdList* cellIds, vtkPoints* closestPoints, vtkDoubleArray* dist2)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numPts);
+  if (closestPoints)
+  {
+    closestPoints->SetNumberOfPoints(numPts);
+  }
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfTuples(numPts);
+  }
+  if (numPts < 1)
+  {
+    return;
+  }
+
+  this->PrepareBatchedQueries();
+  FindClosestPointsWorker worker(
+    this, points, cellIds->GetPointer(0), closestPoints, dist2 ? dist2->GetPointer(0) : nullptr);
+  RunBatchedQuery(this, numPts, worker);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* ts, vtkPoints* xs)
+{
+  if (p1s->GetNumberOfPoints() != p2s->GetNumberOfPoints())
+  {
+    vtkErrorMacro(<< "The start and end points of the lines do not match");
+    cellIds->Reset();
+    return;
+  }
+  const vtkIdType numLines = p1s->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numLines);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+  }
+  if (xs)
+  {
+    xs->SetNumberOfPoints(numLines);
+  }
+  if (numLines < 1)
+  {
+    return;
+  }
+
+  this->PrepareBatchedQueries();
+  IntersectWithLinesWorker worker(
+    this, p1s, p2s, tol, cellIds->GetPointer(0), ts ? ts->GetPointer(0) : nullptr, xs);
+  RunBatchedQuery(this, numLines, worker);
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -41,6 +41,7 @@
 #include "vtkLocator.h"
 
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPoints;
@@ -255,6 +256,51 @@ public:
    */
   virtual bool InsideCellBounds(double x[3], vtkIdType cell_ID);
 
+  /**
+   * Return true if the queries taking a vtkGenericCell (FindCell(),
+   * FindClosestPoint(), FindClosestPointWithinRadius() and
+   * IntersectWithLine()) can be called concurrently from several threads,
+   * each one with its own vtkGenericCell, once BuildLocator() has been
+   * called. The batched queries below are only run in parallel in that
+   * case. The default implementation returns false.
+   */
+  virtual bool SupportsConcurrentQueries() { return false; }
+
+  /**
+   * Find the cells containing a set of points, as FindCell() does for one
+   * point. cellIds is resized to the number of points and receives the id of
+   * the cell containing each point, or -1. If pcoords is not nullptr, it
+   * receives the parametric coordinates of each point in its cell. The
+   * points are processed in parallel with vtkSMPTools when
+   * SupportsConcurrentQueries() is true.
+   */
+  virtual void FindCells(
+    vtkPoints* points, double tol2, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr);
+
+  /**
+   * Find the closest point on the cells to each point of a set, as
+   * FindClosestPoint() does for one point. cellIds is resized to the number
+   * of points and receives the id of the cell holding each closest point, or
+   * -1. If not nullptr, closestPoints and dist2 receive the closest points
+   * and their squared distances to the query points. The points are
+   * processed in parallel with vtkSMPTools when SupportsConcurrentQueries()
+   * is true.
+   */
+  virtual void FindClosestPoints(vtkPoints* points, vtkIdList* cellIds,
+    vtkPoints* closestPoints = nullptr, vtkDoubleArray* dist2 = nullptr);
+
+  /**
+   * Intersect a set of finite lines, going from the points of p1s to the
+   * points of p2s with the same ids, with the cells, as IntersectWithLine()
+   * does for one line. cellIds is resized to the number of lines and
+   * receives the id of the intersected cell, or -1. If not nullptr, ts and xs
+   * receive the parametric coordinates of the intersections along the lines
+   * and the intersection points. The lines are processed in parallel with
+   * vtkSMPTools when SupportsConcurrentQueries() is true.
+   */
+  virtual void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds,
+    vtkDoubleArray* ts = nullptr, vtkPoints* xs = nullptr);
+
 protected:
   vtkAbstractCellLocator();
   ~vtkAbstractCellLocator() override;
@@ -271,6 +317,12 @@ protected:
   virtual void FreeCellBounds();
   //@}
 
+  /**
+   * Build the locator and the cells of the dataset before the batched
+   * queries are run.
+   */
+  void PrepareBatchedQueries();
+
   int NumberOfCellsPerNode;
   vtkTypeBool RetainCellLists;
   vtkTypeBool CacheCellBounds;
@@ -16,6 +16,8 @@
 
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
 
 //------------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
@@ -64,6 +66,37 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPoints(vtkPoints* points, vtkIdList* ptIds)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  ptIds->SetNumberOfIds(numPts);
+  if (numPts < 1)
+  {
+    return;
+  }
+
+  vtkIdType* ids = ptIds->GetPointer(0);
+  auto findClosest = [this, points, ids](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      ids[ptId] = this->FindClosestPoint(x);
+    }
+  };
+
+  this->BuildLocator();
+  if (this->SupportsConcurrentQueries())
+  {
+    vtkSMPTools::For(0, numPts, findClosest);
+  }
+  else
+  {
+    findClosest(0, numPts);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
@@ -34,6 +34,7 @@
 #include "vtkLocator.h"
 
 class vtkIdList;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -89,6 +90,23 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   //@}
 
+  /**
+   * Return true if FindClosestPoint(), FindClosestPointWithinRadius(),
+   * FindClosestNPoints() and FindPointsWithinRadius() can be called
+   * concurrently from several threads once BuildLocator() has been called.
+   * FindClosestPoints() is only run in parallel in that case. The default
+   * implementation returns false.
+   */
+  virtual bool SupportsConcurrentQueries() { return false; }
+
+  /**
+   * Find the id of the point closest to each point of a set, as
+   * FindClosestPoint() does for one point. ptIds is resized to the number
+   * of points. The points are processed in parallel with vtkSMPTools when
+   * SupportsConcurrentQueries() is true.
+   */
+  virtual void FindClosestPoints(vtkPoints* points, vtkIdList* ptIds);
+
   //@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
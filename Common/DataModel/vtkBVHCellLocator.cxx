@@ -0,0 +1,1477 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+namespace
+{
+// Number of rays traced together by IntersectWithLines().
+constexpr int PacketSize = 8;
+
+// Relative cost of visiting a node with respect to testing a cell, used by
+// the surface area heuristic.
+constexpr double TraversalCost = 0.125;
+
+// Smallest number of cells below which a subtree is built by a single thread.
+constexpr vtkIdType MinimumSubtreeSize = 4096;
+
+//------------------------------------------------------------------------------
+// An axis-aligned box in single precision.
+struct Box
+{
+  float Min[3];
+  float Max[3];
+
+  void Reset()
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Min[i] = std::numeric_limits<float>::max();
+      this->Max[i] = -std::numeric_limits<float>::max();
+    }
+  }
+
+  void Grow(const Box& box)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Min[i] = std::min(this->Min[i], box.Min[i]);
+      this->Max[i] = std::max(this->Max[i], box.Max[i]);
+    }
+  }
+
+  void Grow(const float p[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Min[i] = std::min(this->Min[i], p[i]);
+      this->Max[i] = std::max(this->Max[i], p[i]);
+    }
+  }
+
+  // Half the surface area of the box, or half the sum of its edges when it
+  // is flat along two axes.
+  double Measure(bool useLength) const
+  {
+    if (this->Min[0] > this->Max[0])
+    {
+      return 0.0;
+    }
+    const double dx = static_cast<double>(this->Max[0]) - this->Min[0];
+    const double dy = static_cast<double>(this->Max[1]) - this->Min[1];
+    const double dz = static_cast<double>(this->Max[2]) - this->Min[2];
+    return useLength ? dx + dy + dz : dx * dy + dy * dz + dz * dx;
+  }
+
+  bool ContainsPoint(const double x[3]) const
+  {
+    return x[0] >= this->Min[0] && x[0] <= this->Max[0] && x[1] >= this->Min[1] &&
+      x[1] <= this->Max[1] && x[2] >= this->Min[2] && x[2] <= this->Max[2];
+  }
+
+  bool Intersects(const double bounds[6]) const
+  {
+    return bounds[0] <= this->Max[0] && bounds[1] >= this->Min[0] && bounds[2] <= this->Max[1] &&
+      bounds[3] >= this->Min[1] && bounds[4] <= this->Max[2] && bounds[5] >= this->Min[2];
+  }
+
+  double Distance2(const double x[3]) const
+  {
+    double dist2 = 0.0;
+    for (int i = 0; i < 3; ++i)
+    {
+      double d = 0.0;
+      if (x[i] < this->Min[i])
+      {
+        d = this->Min[i] - x[i];
+      }
+      else if (x[i] > this->Max[i])
+      {
+        d = x[i] - this->Max[i];
+      }
+      dist2 += d * d;
+    }
+    return dist2;
+  }
+};
+
+// Round a double precision bound to single precision, outwards.
+float RoundDown(double value)
+{
+  float f = static_cast<float>(value);
+  return static_cast<double>(f) > value ? std::nextafter(f, -std::numeric_limits<float>::max())
+                                        : f;
+}
+
+float RoundUp(double value)
+{
+  float f = static_cast<float>(value);
+  return static_cast<double>(f) < value ? std::nextafter(f, std::numeric_limits<float>::max())
+                                        : f;
+}
+
+//------------------------------------------------------------------------------
+// A node of the tree, 32 bytes.
+struct Node
+{
+  Box Bounds;
+  // For leaves, the position of the first cell of the leaf in the cell ids.
+  // For interior nodes, the index of the second child, the first child being
+  // the next node.
+  vtkTypeInt32 Offset;
+  // For leaves, the number of cells. For interior nodes, -1 - split axis.
+  vtkTypeInt32 Count;
+
+  bool IsLeaf() const { return this->Count > 0; }
+  int Axis() const { return -1 - this->Count; }
+};
+
+//------------------------------------------------------------------------------
+// A ray along a line segment, with the reciprocal of its direction. Null
+// components of the direction get a huge finite reciprocal so that the slab
+// tests never produce NaNs.
+struct Ray
+{
+  double Origin[3];
+  double InvDir[3];
+
+  Ray(const double p1[3], const double p2[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Origin[i] = p1[i];
+      const double d = p2[i] - p1[i];
+      this->InvDir[i] =
+        std::abs(d) >= std::numeric_limits<double>::min() ? 1.0 / d : VTK_DOUBLE_MAX;
+    }
+  }
+
+  // Return whether the ray enters the padded box before tMax, and where.
+  bool Hit(const Box& box, double pad, double tMax, double& tEnter) const
+  {
+    double t0 = 0.0, t1 = tMax;
+    for (int i = 0; i < 3; ++i)
+    {
+      const double lo = (box.Min[i] - pad - this->Origin[i]) * this->InvDir[i];
+      const double hi = (box.Max[i] + pad - this->Origin[i]) * this->InvDir[i];
+      const double tNear = lo < hi ? lo : hi;
+      const double tFar = lo < hi ? hi : lo;
+      t0 = tNear > t0 ? tNear : t0;
+      t1 = tFar < t1 ? tFar : t1;
+    }
+    tEnter = t0;
+    return t0 <= t1;
+  }
+};
+
+//------------------------------------------------------------------------------
+// The rays of a packet, in structure of arrays layout, with the closest hit
+// of each ray.
+struct RayPacket
+{
+  int Size;
+  vtkIdType RayIds[PacketSize];
+  double P1[PacketSize][3];
+  double P2[PacketSize][3];
+  double Origin[3][PacketSize];
+  double InvDir[3][PacketSize];
+  double TMax[PacketSize];
+  vtkIdType CellIds[PacketSize];
+  double X[PacketSize][3];
+
+  // The ray-box tests of all the rays, written so that the compiler can
+  // vectorize them. Inactive rays have a negative TMax and never hit.
+  bool Hit(const Box& box, double pad, unsigned char hits[PacketSize]) const
+  {
+    unsigned char any = 0;
+    for (int l = 0; l < PacketSize; ++l)
+    {
+      double t0 = 0.0, t1 = this->TMax[l];
+      for (int i = 0; i < 3; ++i)
+      {
+        const double lo = (box.Min[i] - pad - this->Origin[i][l]) * this->InvDir[i][l];
+        const double hi = (box.Max[i] + pad - this->Origin[i][l]) * this->InvDir[i][l];
+        const double tNear = lo < hi ? lo : hi;
+        const double tFar = lo < hi ? hi : lo;
+        t0 = tNear > t0 ? tNear : t0;
+        t1 = tFar < t1 ? tFar : t1;
+      }
+      hits[l] = t0 <= t1 ? 1 : 0;
+      any |= hits[l];
+    }
+    return any != 0;
+  }
+};
+
+// Interleave the lowest 10 bits of v with zeros, for Morton codes.
+vtkTypeUInt64 SpreadBits(vtkTypeUInt64 v)
+{
+  v &= 0x3ff;
+  v = (v | (v << 16)) & 0x30000ff;
+  v = (v | (v << 8)) & 0x300f00f;
+  v = (v | (v << 4)) & 0x30c30c3;
+  v = (v | (v << 2)) & 0x9249249;
+  return v;
+}
+
+// Whether the intersection (t, cellId) is closer than (tBest, bestId). Ties
+// are broken by cell id, so that the result does not depend on the order in
+// which the cells are visited.
+bool IsCloser(double t, vtkIdType cellId, double tBest, vtkIdType bestId)
+{
+  return bestId < 0 || t < tBest || (t == tBest && cellId < bestId);
+}
+}
+
+//------------------------------------------------------------------------------
+// The tree itself, and the queries.
+struct vtkBVHCellTree
+{
+  std::vector<Node> Nodes;
+  // The ids of the cells, in the order of the leaves.
+  std::vector<vtkTypeInt32> CellIds;
+  // The bounds of the cells, in the order of the leaves.
+  std::vector<Box> CellBounds;
+  // Padding of the boxes absorbing the rounding errors of the ray-box tests.
+  double Epsilon;
+  int MaxCellSize;
+
+  // Call f(cellId, position) for the cells whose padded bounds intersect
+  // the segment (p1,p2).
+  template <typename TFunctor>
+  void ForEachCellAlongLine(const double p1[3], const double p2[3], double pad, TFunctor& f) const
+  {
+    const Ray ray(p1, p2);
+    std::vector<vtkTypeInt32> stack(1, 0);
+    double tEnter;
+    while (!stack.empty())
+    {
+      const vtkTypeInt32 nodeId = stack.back();
+      const Node& node = this->Nodes[nodeId];
+      stack.pop_back();
+      if (!ray.Hit(node.Bounds, pad, 1.0, tEnter))
+      {
+        continue;
+      }
+      if (node.IsLeaf())
+      {
+        for (vtkTypeInt32 k = node.Offset; k < node.Offset + node.Count; ++k)
+        {
+          if (ray.Hit(this->CellBounds[k], pad, 1.0, tEnter))
+          {
+            f(this->CellIds[k]);
+          }
+        }
+      }
+      else
+      {
+        stack.push_back(node.Offset);
+        stack.push_back(nodeId + 1);
+      }
+    }
+  }
+
+  vtkIdType FindCell(vtkDataSet* ds, const double x[3], vtkGenericCell* cell, double pcoords[3],
+    double* weights) const
+  {
+    std::vector<vtkTypeInt32> stack(1, 0);
+    double dist2;
+    int subId;
+    while (!stack.empty())
+    {
+      const vtkTypeInt32 nodeId = stack.back();
+      const Node& node = this->Nodes[nodeId];
+      stack.pop_back();
+      if (!node.Bounds.ContainsPoint(x))
+      {
+        continue;
+      }
+      if (node.IsLeaf())
+      {
+        for (vtkTypeInt32 k = node.Offset; k < node.Offset + node.Count; ++k)
+        {
+          if (this->CellBounds[k].ContainsPoint(x))
+          {
+            ds->GetCell(this->CellIds[k], cell);
+            if (cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights) == 1)
+            {
+              return this->CellIds[k];
+            }
+          }
+        }
+      }
+      else
+      {
+        stack.push_back(node.Offset);
+        stack.push_back(nodeId + 1);
+      }
+    }
+    return -1;
+  }
+
+  vtkIdType FindClosestPointWithinRadius(vtkDataSet* ds, const double x[3], double radius,
+    double closestPoint[3], vtkGenericCell* cell, vtkIdType& closestCellId, int& closestSubId,
+    double& minDist2, int& inside) const
+  {
+    std::vector<double> weights(std::max(this->MaxCellSize, 1));
+    std::vector<std::pair<vtkTypeInt32, double>> stack;
+    double point[3], pcoords[3], dist2;
+    int subId;
+    vtkIdType retVal = 0;
+
+    minDist2 = radius * radius;
+    closestCellId = -1;
+    stack.emplace_back(0, this->Nodes[0].Bounds.Distance2(x));
+    while (!stack.empty())
+    {
+      const vtkTypeInt32 nodeId = stack.back().first;
+      const double nodeDist2 = stack.back().second;
+      stack.pop_back();
+      if (nodeDist2 > minDist2)
+      {
+        continue;
+      }
+      const Node& node = this->Nodes[nodeId];
+      if (node.IsLeaf())
+      {
+        for (vtkTypeInt32 k = node.Offset; k < node.Offset + node.Count; ++k)
+        {
+          if (this->CellBounds[k].Distance2(x) < minDist2)
+          {
+            const vtkIdType cellId = this->CellIds[k];
+            ds->GetCell(cellId, cell);
+            int stat = cell->EvaluatePosition(x, point, subId, pcoords, dist2, weights.data());
+            if (stat != -1 && dist2 < minDist2)
+            {
+              retVal = 1;
+              inside = stat;
+              minDist2 = dist2;
+              closestCellId = cellId;
+              closestSubId = subId;
+              closestPoint[0] = point[0];
+              closestPoint[1] = point[1];
+              closestPoint[2] = point[2];
+            }
+          }
+        }
+      }
+      else
+      {
+        // Visit the nearest child first
+        const double dist2First = this->Nodes[nodeId + 1].Bounds.Distance2(x);
+        const double dist2Second = this->Nodes[node.Offset].Bounds.Distance2(x);
+        if (dist2First <= dist2Second)
+        {
+          stack.emplace_back(node.Offset, dist2Second);
+          stack.emplace_back(nodeId + 1, dist2First);
+        }
+        else
+        {
+          stack.emplace_back(nodeId + 1, dist2First);
+          stack.emplace_back(node.Offset, dist2Second);
+        }
+      }
+    }
+
+    if (retVal)
+    {
+      ds->GetCell(closestCellId, cell);
+    }
+    return retVal;
+  }
+
+  // Closest intersection of one ray.
+  int IntersectWithLine(vtkDataSet* ds, const double p1[3], const double p2[3], double tol,
+    double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId,
+    vtkGenericCell* cell) const
+  {
+    const Ray ray(p1, p2);
+    const double pad = tol + this->Epsilon;
+    double tBest = 1.0, tEnter, tHit, xHit[3], pcoordsHit[3];
+    int subIdHit;
+    vtkIdType bestId = -1;
+
+    std::vector<std::pair<vtkTypeInt32, double>> stack;
+    if (ray.Hit(this->Nodes[0].Bounds, pad, tBest, tEnter))
+    {
+      stack.emplace_back(0, tEnter);
+    }
+    while (!stack.empty())
+    {
+      const vtkTypeInt32 nodeId = stack.back().first;
+      const double nodeT = stack.back().second;
+      stack.pop_back();
+      if (nodeT > tBest)
+      {
+        continue;
+      }
+      const Node& node = this->Nodes[nodeId];
+      if (node.IsLeaf())
+      {
+        for (vtkTypeInt32 k = node.Offset; k < node.Offset + node.Count; ++k)
+        {
+          if (!ray.Hit(this->CellBounds[k], pad, tBest, tEnter))
+          {
+            continue;
+          }
+          const vtkIdType candidateId = this->CellIds[k];
+          ds->GetCell(candidateId, cell);
+          if (cell->IntersectWithLine(p1, p2, tol, tHit, xHit, pcoordsHit, subIdHit) &&
+            IsCloser(tHit, candidateId, tBest, bestId))
+          {
+            bestId = candidateId;
+            tBest = tHit;
+            x[0] = xHit[0];
+            x[1] = xHit[1];
+            x[2] = xHit[2];
+            pcoords[0] = pcoordsHit[0];
+            pcoords[1] = pcoordsHit[1];
+            pcoords[2] = pcoordsHit[2];
+            subId = subIdHit;
+          }
+        }
+      }
+      else
+      {
+        // Push the farthest child first so that the nearest one is visited first
+        double tFirst, tSecond;
+        const bool hitFirst = ray.Hit(this->Nodes[nodeId + 1].Bounds, pad, tBest, tFirst);
+        const bool hitSecond = ray.Hit(this->Nodes[node.Offset].Bounds, pad, tBest, tSecond);
+        if (hitFirst && hitSecond && tFirst <= tSecond)
+        {
+          stack.emplace_back(node.Offset, tSecond);
+          stack.emplace_back(nodeId + 1, tFirst);
+        }
+        else
+        {
+          if (hitFirst)
+          {
+            stack.emplace_back(nodeId + 1, tFirst);
+          }
+          if (hitSecond)
+          {
+            stack.emplace_back(node.Offset, tSecond);
+          }
+        }
+      }
+    }
+
+    cellId = bestId;
+    if (bestId < 0)
+    {
+      return 0;
+    }
+    t = tBest;
+    ds->GetCell(bestId, cell);
+    return 1;
+  }
+
+  // Closest intersections of a packet of rays, sharing the traversal of the
+  // tree and the extraction of the cells.
+  void IntersectPacket(vtkDataSet* ds, RayPacket& packet, double tol, vtkGenericCell* cell,
+    std::vector<vtkTypeInt32>& stack) const
+  {
+    const double pad = tol + this->Epsilon;
+    unsigned char nodeHits[PacketSize], cellHits[PacketSize];
+    double tHit, xHit[3], pcoordsHit[3];
+    int subIdHit;
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+      const vtkTypeInt32 nodeId = stack.back();
+      const Node& node = this->Nodes[nodeId];
+      stack.pop_back();
+      if (!packet.Hit(node.Bounds, pad, nodeHits))
+      {
+        continue;
+      }
+      if (node.IsLeaf())
+      {
+        for (vtkTypeInt32 k = node.Offset; k < node.Offset + node.Count; ++k)
+        {
+          if (!packet.Hit(this->CellBounds[k], pad, cellHits))
+          {
+            continue;
+          }
+          const vtkIdType candidateId = this->CellIds[k];
+          ds->GetCell(candidateId, cell);
+          for (int l = 0; l < packet.Size; ++l)
+          {
+            if (nodeHits[l] && cellHits[l] &&
+              cell->IntersectWithLine(
+                packet.P1[l], packet.P2[l], tol, tHit, xHit, pcoordsHit, subIdHit) &&
+              IsCloser(tHit, candidateId, packet.TMax[l], packet.CellIds[l]))
+            {
+              packet.CellIds[l] = candidateId;
+              packet.TMax[l] = tHit;
+              packet.X[l][0] = xHit[0];
+              packet.X[l][1] = xHit[1];
+              packet.X[l][2] = xHit[2];
+            }
+          }
+        }
+      }
+      else if (packet.InvDir[node.Axis()][0] >= 0.0)
+      {
+        // Visit the child nearest to the first ray first
+        stack.push_back(node.Offset);
+        stack.push_back(nodeId + 1);
+      }
+      else
+      {
+        stack.push_back(nodeId + 1);
+        stack.push_back(node.Offset);
+      }
+    }
+  }
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Bins of the cell centers along one axis.
+struct Bin
+{
+  Box Bounds;
+  vtkIdType Count;
+
+  void Reset()
+  {
+    this->Bounds.Reset();
+    this->Count = 0;
+  }
+};
+
+// Maps the cell centers of a node to the bins along each axis.
+struct Binning
+{
+  int NumberOfBins;
+  double Min[3];
+  double Scale[3];
+
+  Binning(int numberOfBins, const Box& centerBounds)
+    : NumberOfBins(numberOfBins)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Min[i] = centerBounds.Min[i];
+      const double extent = static_cast<double>(centerBounds.Max[i]) - centerBounds.Min[i];
+      this->Scale[i] = extent > 0.0 ? numberOfBins / extent : 0.0;
+    }
+  }
+
+  bool IsDegenerate() const
+  {
+    return this->Scale[0] == 0.0 && this->Scale[1] == 0.0 && this->Scale[2] == 0.0;
+  }
+
+  int Index(float center, int axis) const
+  {
+    const int bin = static_cast<int>((center - this->Min[axis]) * this->Scale[axis]);
+    return bin < 0 ? 0 : (bin >= this->NumberOfBins ? this->NumberOfBins - 1 : bin);
+  }
+};
+
+//------------------------------------------------------------------------------
+// Builds the tree top-down, with the binned surface area heuristic.
+struct BVHBuilder
+{
+  const std::vector<Box>& Boxes;
+  const std::vector<std::array<float, 3>>& Centers;
+  vtkTypeInt32* Ids;
+  int NumberOfBins;
+  vtkIdType MaxLeafSize;
+
+  BVHBuilder(const std::vector<Box>& boxes, const std::vector<std::array<float, 3>>& centers,
+    vtkTypeInt32* ids, int numberOfBins, vtkIdType maxLeafSize)
+    : Boxes(boxes)
+    , Centers(centers)
+    , Ids(ids)
+    , NumberOfBins(numberOfBins)
+    , MaxLeafSize(maxLeafSize)
+  {
+  }
+
+  void GrowBounds(
+    const vtkTypeInt32* begin, const vtkTypeInt32* end, Box& bounds, Box& centerBounds) const
+  {
+    for (const vtkTypeInt32* id = begin; id != end; ++id)
+    {
+      bounds.Grow(this->Boxes[*id]);
+      centerBounds.Grow(this->Centers[*id].data());
+    }
+  }
+
+  void FillBins(
+    const vtkTypeInt32* begin, const vtkTypeInt32* end, const Binning& binning, Bin* bins) const
+  {
+    for (const vtkTypeInt32* id = begin; id != end; ++id)
+    {
+      const std::array<float, 3>& center = this->Centers[*id];
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        if (binning.Scale[axis] > 0.0)
+        {
+          Bin& bin = bins[axis * this->NumberOfBins + binning.Index(center[axis], axis)];
+          bin.Bounds.Grow(this->Boxes[*id]);
+          ++bin.Count;
+        }
+      }
+    }
+  }
+
+  // Split the range of cells of a node, given the bins of their centers.
+  // Returns the end of the first half, or nullptr if the node is a leaf.
+  vtkTypeInt32* Split(vtkTypeInt32* begin, vtkTypeInt32* end, const Box& bounds,
+    const Binning& binning, const Bin* bins, int& splitAxis) const
+  {
+    const vtkIdType count = end - begin;
+    if (count <= 1)
+    {
+      return nullptr;
+    }
+    if (binning.IsDegenerate())
+    {
+      // All the centers coincide: split in the middle if the leaf is too big
+      splitAxis = 0;
+      return count <= this->MaxLeafSize ? nullptr : begin + count / 2;
+    }
+
+    const bool useLength = bounds.Measure(false) <= 0.0;
+    const double measure = bounds.Measure(useLength);
+    const int numBins = this->NumberOfBins;
+    double rightMeasures[64];
+    vtkIdType rightCounts[64];
+    double bestCost = VTK_DOUBLE_MAX;
+    int splitBin = 0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (binning.Scale[axis] == 0.0)
+      {
+        continue;
+      }
+      const Bin* axisBins = bins + axis * numBins;
+      Box accumulated;
+      accumulated.Reset();
+      vtkIdType accumulatedCount = 0;
+      for (int i = numBins - 1; i > 0; --i)
+      {
+        accumulated.Grow(axisBins[i].Bounds);
+        accumulatedCount += axisBins[i].Count;
+        rightMeasures[i] = accumulated.Measure(useLength);
+        rightCounts[i] = accumulatedCount;
+      }
+      accumulated.Reset();
+      accumulatedCount = 0;
+      for (int i = 0; i < numBins - 1; ++i)
+      {
+        accumulated.Grow(axisBins[i].Bounds);
+        accumulatedCount += axisBins[i].Count;
+        if (accumulatedCount == 0 || rightCounts[i + 1] == 0)
+        {
+          continue;
+        }
+        const double cost = (accumulated.Measure(useLength) * accumulatedCount +
+                              rightMeasures[i + 1] * rightCounts[i + 1]) /
+          measure;
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          splitAxis = axis;
+          splitBin = i + 1;
+        }
+      }
+    }
+
+    if (bestCost == VTK_DOUBLE_MAX)
+    {
+      // Only empty cells: split in the middle if the leaf is too big
+      splitAxis = 0;
+      return count <= this->MaxLeafSize ? nullptr : begin + count / 2;
+    }
+    if (count <= this->MaxLeafSize && TraversalCost + bestCost >= count)
+    {
+      return nullptr;
+    }
+    const std::vector<std::array<float, 3>>& centers = this->Centers;
+    const int axis = splitAxis;
+    return std::partition(begin, end, [&](vtkTypeInt32 id) {
+      return binning.Index(centers[id][axis], axis) < splitBin;
+    });
+  }
+
+  // Build the subtree of a range of cells, in depth first order. Interior
+  // nodes refer to their second child with indices local to the subtree.
+  void BuildSubtree(vtkTypeInt32* begin, vtkTypeInt32* end, std::vector<Node>& nodes) const
+  {
+    struct Item
+    {
+      vtkTypeInt32* Begin;
+      vtkTypeInt32* End;
+      vtkIdType Parent; // node whose second child this is, or -1
+    };
+    std::vector<Item> stack(1, Item{ begin, end, -1 });
+    std::vector<Bin> bins(3 * this->NumberOfBins);
+    while (!stack.empty())
+    {
+      const Item item = stack.back();
+      stack.pop_back();
+      const vtkIdType nodeId = static_cast<vtkIdType>(nodes.size());
+      if (item.Parent >= 0)
+      {
+        nodes[item.Parent].Offset = static_cast<vtkTypeInt32>(nodeId);
+      }
+
+      Node node;
+      Box centerBounds;
+      node.Bounds.Reset();
+      centerBounds.Reset();
+      this->GrowBounds(item.Begin, item.End, node.Bounds, centerBounds);
+      const Binning binning(this->NumberOfBins, centerBounds);
+      for (Bin& bin : bins)
+      {
+        bin.Reset();
+      }
+      this->FillBins(item.Begin, item.End, binning, bins.data());
+
+      int axis = 0;
+      vtkTypeInt32* middle =
+        this->Split(item.Begin, item.End, node.Bounds, binning, bins.data(), axis);
+      if (middle)
+      {
+        node.Offset = -1;
+        node.Count = -1 - axis;
+        stack.push_back(Item{ middle, item.End, nodeId });
+        stack.push_back(Item{ item.Begin, middle, -1 });
+      }
+      else
+      {
+        node.Offset = static_cast<vtkTypeInt32>(item.Begin - this->Ids);
+        node.Count = static_cast<vtkTypeInt32>(item.End - item.Begin);
+      }
+      nodes.push_back(node);
+    }
+  }
+};
+
+// Bounds of the cells of a large node, and of their centers, in parallel.
+struct ComputeNodeBounds
+{
+  const BVHBuilder& Builder;
+  const vtkTypeInt32* Ids;
+  vtkSMPThreadLocal<std::array<Box, 2>> LocalBounds;
+  Box Bounds;
+  Box CenterBounds;
+
+  ComputeNodeBounds(const BVHBuilder& builder, const vtkTypeInt32* ids)
+    : Builder(builder)
+    , Ids(ids)
+  {
+  }
+
+  void Initialize()
+  {
+    std::array<Box, 2>& bounds = this->LocalBounds.Local();
+    bounds[0].Reset();
+    bounds[1].Reset();
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::array<Box, 2>& bounds = this->LocalBounds.Local();
+    this->Builder.GrowBounds(this->Ids + begin, this->Ids + end, bounds[0], bounds[1]);
+  }
+
+  void Reduce()
+  {
+    this->Bounds.Reset();
+    this->CenterBounds.Reset();
+    for (auto iter = this->LocalBounds.begin(); iter != this->LocalBounds.end(); ++iter)
+    {
+      this->Bounds.Grow((*iter)[0]);
+      this->CenterBounds.Grow((*iter)[1]);
+    }
+  }
+};
+
+// Bins of the cells of a large node, in parallel.
+struct ComputeNodeBins
+{
+  const BVHBuilder& Builder;
+  const vtkTypeInt32* Ids;
+  const Binning& Bins;
+  vtkSMPThreadLocal<std::vector<Bin>> LocalBins;
+  std::vector<Bin> Result;
+
+  ComputeNodeBins(const BVHBuilder& builder, const vtkTypeInt32* ids, const Binning& binning)
+    : Builder(builder)
+    , Ids(ids)
+    , Bins(binning)
+  {
+  }
+
+  void Initialize()
+  {
+    std::vector<Bin>& bins = this->LocalBins.Local();
+    bins.resize(3 * this->Builder.NumberOfBins);
+    for (Bin& bin : bins)
+    {
+      bin.Reset();
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    this->Builder.FillBins(
+      this->Ids + begin, this->Ids + end, this->Bins, this->LocalBins.Local().data());
+  }
+
+  void Reduce()
+  {
+    this->Result.resize(3 * this->Builder.NumberOfBins);
+    for (Bin& bin : this->Result)
+    {
+      bin.Reset();
+    }
+    for (auto iter = this->LocalBins.begin(); iter != this->LocalBins.end(); ++iter)
+    {
+      for (std::size_t i = 0; i < this->Result.size(); ++i)
+      {
+        this->Result[i].Bounds.Grow((*iter)[i].Bounds);
+        this->Result[i].Count += (*iter)[i].Count;
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Traces the packets of rays of IntersectWithLines().
+struct IntersectPackets
+{
+  const vtkBVHCellTree* Tree;
+  vtkDataSet* DataSet;
+  vtkPoints* P1s;
+  vtkPoints* P2s;
+  double Tol;
+  const std::vector<std::pair<vtkTypeUInt64, vtkIdType>>& Order;
+  vtkIdType* CellIds;
+  double* Ts;
+  vtkPoints* Xs;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<vtkTypeInt32>> Stack;
+
+  IntersectPackets(const vtkBVHCellTree* tree, vtkDataSet* ds, vtkPoints* p1s, vtkPoints* p2s,
+    double tol, const std::vector<std::pair<vtkTypeUInt64, vtkIdType>>& order, vtkIdType* cellIds,
+    double* ts, vtkPoints* xs)
+    : Tree(tree)
+    , DataSet(ds)
+    , P1s(p1s)
+    , P2s(p2s)
+    , Tol(tol)
+    , Order(order)
+    , CellIds(cellIds)
+    , Ts(ts)
+    , Xs(xs)
+  {
+  }
+
+  void operator()(vtkIdType beginPacket, vtkIdType endPacket)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    std::vector<vtkTypeInt32>& stack = this->Stack.Local();
+    const vtkIdType numRays = static_cast<vtkIdType>(this->Order.size());
+    RayPacket packet;
+    for (vtkIdType packetId = beginPacket; packetId < endPacket; ++packetId)
+    {
+      const vtkIdType first = packetId * PacketSize;
+      packet.Size = static_cast<int>(std::min<vtkIdType>(PacketSize, numRays - first));
+      for (int l = 0; l < PacketSize; ++l)
+      {
+        // Inactive rays repeat the first ray, with an empty range
+        const vtkIdType rayId = this->Order[first + (l < packet.Size ? l : 0)].second;
+        packet.RayIds[l] = rayId;
+        this->P1s->GetPoint(rayId, packet.P1[l]);
+        this->P2s->GetPoint(rayId, packet.P2[l]);
+        const Ray ray(packet.P1[l], packet.P2[l]);
+        for (int i = 0; i < 3; ++i)
+        {
+          packet.Origin[i][l] = ray.Origin[i];
+          packet.InvDir[i][l] = ray.InvDir[i];
+        }
+        packet.TMax[l] = l < packet.Size ? 1.0 : -1.0;
+        packet.CellIds[l] = -1;
+      }
+
+      this->Tree->IntersectPacket(this->DataSet, packet, this->Tol, cell, stack);
+
+      for (int l = 0; l < packet.Size; ++l)
+      {
+        const vtkIdType rayId = packet.RayIds[l];
+        const bool hit = packet.CellIds[l] >= 0;
+        this->CellIds[rayId] = packet.CellIds[l];
+        if (this->Ts)
+        {
+          this->Ts[rayId] = hit ? packet.TMax[l] : 0.0;
+        }
+        if (this->Xs)
+        {
+          double zero[3] = { 0.0, 0.0, 0.0 };
+          this->Xs->SetPoint(rayId, hit ? packet.X[l] : zero);
+        }
+      }
+    }
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+  this->NumberOfBins = 16;
+  this->Tree = nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  delete this->Tree;
+  this->Tree = nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return this->Tree ? static_cast<vtkIdType>(this->Tree->Nodes.size()) : 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  vtkDebugMacro(<< "Building BVH cell locator");
+
+  // Do we need to build?
+  if (this->Tree &&
+    ((this->BuildTime > this->MTime && this->BuildTime > this->DataSet->GetMTime()) ||
+      this->UseExistingSearchStructure))
+  {
+    return;
+  }
+
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< "No cells to build");
+    return;
+  }
+  if (numCells > VTK_INT_MAX / 2)
+  {
+    vtkErrorMacro(<< "Too many cells to build: " << numCells);
+    return;
+  }
+  this->FreeSearchStructure();
+
+  // Bounds and centers of the cells, in single precision. The first call
+  // to GetCellBounds() has side effects (e.g. building the cells of
+  // polydata) so it is not threaded.
+  std::vector<Box> boxes(numCells);
+  std::vector<std::array<float, 3>> centers(numCells);
+  double bds[6];
+  this->DataSet->GetCellBounds(0, bds);
+  vtkDataSet* ds = this->DataSet;
+  vtkSMPTools::For(0, numCells, [ds, &boxes, &centers](vtkIdType begin, vtkIdType end) {
+    double cellBounds[6];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      ds->GetCellBounds(cellId, cellBounds);
+      Box& box = boxes[cellId];
+      for (int i = 0; i < 3; ++i)
+      {
+        box.Min[i] = RoundDown(cellBounds[2 * i]);
+        box.Max[i] = RoundUp(cellBounds[2 * i + 1]);
+        centers[cellId][i] = static_cast<float>(0.5 * (cellBounds[2 * i] + cellBounds[2 * i + 1]));
+      }
+    }
+  });
+
+  vtkBVHCellTree* tree = new vtkBVHCellTree;
+  tree->MaxCellSize = this->DataSet->GetMaxCellSize();
+  tree->CellIds.resize(numCells);
+  std::iota(tree->CellIds.begin(), tree->CellIds.end(), 0);
+  vtkTypeInt32* ids = tree->CellIds.data();
+  const BVHBuilder builder(boxes, centers, ids, this->NumberOfBins,
+    std::max<vtkIdType>(this->NumberOfCellsPerNode, 1));
+
+  // Split the large nodes, binning their cells in parallel, until the
+  // remaining subtrees are small enough to be built by a single thread. The
+  // subtrees are represented by placeholder nodes (Count == 0) whose Offset
+  // is the index of the subtree.
+  const vtkIdType subtreeSize = std::max(
+    MinimumSubtreeSize, numCells / (8 * vtkSMPTools::GetEstimatedNumberOfThreads()));
+  struct Item
+  {
+    vtkTypeInt32* Begin;
+    vtkTypeInt32* End;
+    vtkIdType Parent;
+  };
+  std::vector<Node> topNodes;
+  std::vector<std::pair<vtkTypeInt32*, vtkTypeInt32*>> subtreeRanges;
+  std::vector<Item> stack(1, Item{ ids, ids + numCells, -1 });
+  while (!stack.empty())
+  {
+    const Item item = stack.back();
+    stack.pop_back();
+    const vtkIdType nodeId = static_cast<vtkIdType>(topNodes.size());
+    if (item.Parent >= 0)
+    {
+      topNodes[item.Parent].Offset = static_cast<vtkTypeInt32>(nodeId);
+    }
+    const vtkIdType count = item.End - item.Begin;
+
+    Node node;
+    if (count <= subtreeSize)
+    {
+      node.Bounds.Reset();
+      node.Offset = static_cast<vtkTypeInt32>(subtreeRanges.size());
+      node.Count = 0;
+      subtreeRanges.emplace_back(item.Begin, item.End);
+      topNodes.push_back(node);
+      continue;
+    }
+
+    ComputeNodeBounds nodeBounds(builder, item.Begin);
+    vtkSMPTools::For(0, count, nodeBounds);
+    node.Bounds = nodeBounds.Bounds;
+    const Binning binning(this->NumberOfBins, nodeBounds.CenterBounds);
+    ComputeNodeBins nodeBins(builder, item.Begin, binning);
+    vtkSMPTools::For(0, count, nodeBins);
+
+    int axis = 0;
+    vtkTypeInt32* middle =
+      builder.Split(item.Begin, item.End, node.Bounds, binning, nodeBins.Result.data(), axis);
+    if (middle)
+    {
+      node.Offset = -1;
+      node.Count = -1 - axis;
+      stack.push_back(Item{ middle, item.End, nodeId });
+      stack.push_back(Item{ item.Begin, middle, -1 });
+    }
+    else
+    {
+      node.Offset = static_cast<vtkTypeInt32>(item.Begin - ids);
+      node.Count = static_cast<vtkTypeInt32>(count);
+    }
+    topNodes.push_back(node);
+  }
+
+  // Build the subtrees concurrently
+  const vtkIdType numSubtrees = static_cast<vtkIdType>(subtreeRanges.size());
+  std::vector<std::vector<Node>> subtrees(numSubtrees);
+  vtkSMPTools::For(0, numSubtrees, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      builder.BuildSubtree(subtreeRanges[i].first, subtreeRanges[i].second, subtrees[i]);
+    }
+  });
+
+  // Replace the placeholders by their subtrees, keeping the depth first order
+  const vtkIdType numTopNodes = static_cast<vtkIdType>(topNodes.size());
+  std::vector<vtkIdType> nodeMap(numTopNodes);
+  vtkIdType numNodes = 0;
+  for (vtkIdType i = 0; i < numTopNodes; ++i)
+  {
+    nodeMap[i] = numNodes;
+    numNodes += topNodes[i].Count == 0
+      ? static_cast<vtkIdType>(subtrees[topNodes[i].Offset].size())
+      : 1;
+  }
+  tree->Nodes.resize(numNodes);
+  vtkSMPTools::For(0, numTopNodes, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType base = nodeMap[i];
+      if (topNodes[i].Count == 0)
+      {
+        const std::vector<Node>& subtree = subtrees[topNodes[i].Offset];
+        for (std::size_t j = 0; j < subtree.size(); ++j)
+        {
+          Node node = subtree[j];
+          if (!node.IsLeaf())
+          {
+            node.Offset += static_cast<vtkTypeInt32>(base);
+          }
+          tree->Nodes[base + j] = node;
+        }
+      }
+      else
+      {
+        Node node = topNodes[i];
+        if (!node.IsLeaf())
+        {
+          node.Offset = static_cast<vtkTypeInt32>(nodeMap[node.Offset]);
+        }
+        tree->Nodes[base] = node;
+      }
+    }
+  });
+
+  // Store the bounds of the cells in the order of the leaves
+  tree->CellBounds.resize(numCells);
+  vtkSMPTools::For(0, numCells, [tree, &boxes](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      tree->CellBounds[i] = boxes[tree->CellIds[i]];
+    }
+  });
+
+  // Tolerance absorbing the rounding errors of the ray-box tests
+  const Box& rootBounds = tree->Nodes[0].Bounds;
+  double magnitude = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    magnitude = std::max(magnitude, std::abs(static_cast<double>(rootBounds.Min[i])));
+    magnitude = std::max(magnitude, std::abs(static_cast<double>(rootBounds.Max[i])));
+  }
+  tree->Epsilon = 1e-12 * magnitude;
+
+  this->Tree = tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double pos[3], double, vtkGenericCell* cell, double pcoords[3], double* weights)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return -1;
+  }
+  return this->Tree->FindCell(this->DataSet, pos, cell, pcoords, weights);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+
+  const vtkBVHCellTree* tree = this->Tree;
+  std::vector<vtkTypeInt32> stack(1, 0);
+  while (!stack.empty())
+  {
+    const vtkTypeInt32 nodeId = stack.back();
+    const Node& node = tree->Nodes[nodeId];
+    stack.pop_back();
+    if (!node.Bounds.Intersects(bbox))
+    {
+      continue;
+    }
+    if (node.IsLeaf())
+    {
+      for (vtkTypeInt32 k = node.Offset; k < node.Offset + node.Count; ++k)
+      {
+        if (tree->CellBounds[k].Intersects(bbox))
+        {
+          cells->InsertNextId(tree->CellIds[k]);
+        }
+      }
+    }
+    else
+    {
+      stack.push_back(node.Offset);
+      stack.push_back(nodeId + 1);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsAlongLine(
+  const double p1[3], const double p2[3], double tolerance, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  auto insert = [cells](vtkIdType cellId) { cells->InsertNextId(cellId); };
+  this->Tree->ForEachCellAlongLine(p1, p2, tolerance + this->Tree->Epsilon, insert);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
+  vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2)
+{
+  int inside;
+  double radius = vtkMath::Inf();
+  double point[3] = { x[0], x[1], x[2] };
+  this->FindClosestPointWithinRadius(
+    point, radius, closestPoint, cell, cellId, subId, dist2, inside);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
+  int& inside)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->FindClosestPointWithinRadius(
+    this->DataSet, x, radius, closestPoint, cell, cellId, subId, dist2, inside);
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  cellId = -1;
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->IntersectWithLine(
+    this->DataSet, p1, p2, tol, t, x, pcoords, subId, cellId, cell);
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(
+  const double p1[3], const double p2[3], vtkPoints* points, vtkIdList* cellIds)
+{
+  if (points)
+  {
+    points->Reset();
+  }
+  if (cellIds)
+  {
+    cellIds->Reset();
+  }
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+
+  struct Hit
+  {
+    double T;
+    vtkIdType CellId;
+    double X[3];
+    bool operator<(const Hit& other) const
+    {
+      return this->T < other.T || (this->T == other.T && this->CellId < other.CellId);
+    }
+  };
+  std::vector<Hit> hits;
+  vtkDataSet* ds = this->DataSet;
+  vtkGenericCell* cell = this->GenericCell;
+  const double tol = this->Tolerance;
+  auto intersect = [&](vtkIdType cellId) {
+    Hit hit;
+    double pcoords[3];
+    int subId;
+    ds->GetCell(cellId, cell);
+    if (cell->IntersectWithLine(p1, p2, tol, hit.T, hit.X, pcoords, subId))
+    {
+      hit.CellId = cellId;
+      hits.push_back(hit);
+    }
+  };
+  this->Tree->ForEachCellAlongLine(p1, p2, tol + this->Tree->Epsilon, intersect);
+
+  std::sort(hits.begin(), hits.end());
+  for (const Hit& hit : hits)
+  {
+    if (points)
+    {
+      points->InsertNextPoint(hit.X);
+    }
+    if (cellIds)
+    {
+      cellIds->InsertNextId(hit.CellId);
+    }
+  }
+  return hits.empty() ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* ts, vtkPoints* xs)
+{
+  if (p1s->GetNumberOfPoints() != p2s->GetNumberOfPoints())
+  {
+    vtkErrorMacro(<< "The start and end points of the lines do not match");
+    cellIds->Reset();
+    return;
+  }
+  const vtkIdType numLines = p1s->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numLines);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+  }
+  if (xs)
+  {
+    xs->SetNumberOfPoints(numLines);
+  }
+  if (numLines < 1)
+  {
+    return;
+  }
+  this->PrepareBatchedQueries();
+  if (!this->Tree)
+  {
+    std::fill_n(cellIds->GetPointer(0), numLines, -1);
+    return;
+  }
+
+  // Sort the rays by direction octant, then along a Morton curve of their
+  // origins, so that the rays of a packet travel together.
+  const Box& bounds = this->Tree->Nodes[0].Bounds;
+  double scale[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double extent = static_cast<double>(bounds.Max[i]) - bounds.Min[i];
+    scale[i] = extent > 0.0 ? 1023.0 / extent : 0.0;
+  }
+  std::vector<std::pair<vtkTypeUInt64, vtkIdType>> order(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    double p1[3], p2[3];
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      p1s->GetPoint(lineId, p1);
+      p2s->GetPoint(lineId, p2);
+      vtkTypeUInt64 key = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        const double q = std::min(std::max((p1[i] - bounds.Min[i]) * scale[i], 0.0), 1023.0);
+        key |= SpreadBits(static_cast<vtkTypeUInt64>(q)) << i;
+        key |= static_cast<vtkTypeUInt64>(p2[i] < p1[i] ? 1 : 0) << (30 + i);
+      }
+      order[lineId] = std::make_pair(key, lineId);
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end());
+
+  IntersectPackets intersect(this->Tree, this->DataSet, p1s, p2s, tol, order,
+    cellIds->GetPointer(0), ts ? ts->GetPointer(0) : nullptr, xs);
+  vtkSMPTools::For(0, (numLines + PacketSize - 1) / PacketSize, intersect);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+
+  vtkNew<vtkPoints> pts;
+  pts->SetDataTypeToFloat();
+  vtkNew<vtkCellArray> polys;
+  static const vtkIdType faces[6][4] = { { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 },
+    { 2, 6, 7, 3 }, { 0, 2, 3, 1 }, { 4, 5, 7, 6 } };
+
+  std::vector<std::pair<vtkTypeInt32, int>> stack(1, std::make_pair(0, 0));
+  while (!stack.empty())
+  {
+    const vtkTypeInt32 nodeId = stack.back().first;
+    const int depth = stack.back().second;
+    stack.pop_back();
+    const Node& node = this->Tree->Nodes[nodeId];
+    if (depth < level && !node.IsLeaf())
+    {
+      stack.emplace_back(node.Offset, depth + 1);
+      stack.emplace_back(nodeId + 1, depth + 1);
+      continue;
+    }
+
+    const vtkIdType first = pts->GetNumberOfPoints();
+    for (int k = 0; k < 2; ++k)
+    {
+      for (int j = 0; j < 2; ++j)
+      {
+        for (int i = 0; i < 2; ++i)
+        {
+          pts->InsertNextPoint(i ? node.Bounds.Max[0] : node.Bounds.Min[0],
+            j ? node.Bounds.Max[1] : node.Bounds.Min[1],
+            k ? node.Bounds.Max[2] : node.Bounds.Min[2]);
+        }
+      }
+    }
+    for (int f = 0; f < 6; ++f)
+    {
+      vtkIdType face[4];
+      for (int i = 0; i < 4; ++i)
+      {
+        face[i] = first + faces[f][i];
+      }
+      polys->InsertNextCell(4, face);
+    }
+  }
+
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of Bins: " << this->NumberOfBins << "\n";
+  os << indent << "Number of Nodes: " << this->GetNumberOfNodes() << "\n";
+}
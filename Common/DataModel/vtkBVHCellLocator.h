@@ -0,0 +1,210 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   cell locator based on a bounding volume hierarchy
+ *
+ * vtkBVHCellLocator is a type of vtkAbstractCellLocator that organizes the
+ * cells in a bounding volume hierarchy (BVH): a binary tree of axis-aligned
+ * boxes whose leaves hold a few cells each. The tree is built top-down with
+ * the binned surface area heuristic (SAH), which splits each node along the
+ * candidate plane minimizing the expected cost of tracing a ray through it.
+ * The build is threaded with vtkSMPTools: the cell bounds and the bins of the
+ * large nodes are computed in parallel, then the subtrees are built
+ * concurrently.
+ *
+ * The nodes are stored depth first in a flat array of 32-byte records with
+ * single precision bounds, and the bounds of the cells are stored in leaf
+ * order, so that a traversal touches little memory. IntersectWithLines()
+ * sorts the rays so that neighboring rays travel together, then traces them
+ * by packets sharing one traversal of the tree, in parallel. The ray-box
+ * tests of a packet are laid out so that the compiler can vectorize them.
+ *
+ * This locator is designed for ray casting and picking against large
+ * surface meshes, but it also supports FindCell() and the closest point
+ * queries. All the queries are thread safe once the locator is built.
+ *
+ * @warning
+ * This class *always* caches cell bounds, in single precision rounded
+ * outwards. It supports up to VTK_INT_MAX / 2 cells.
+ *
+ * @sa
+ * vtkLocator vtkAbstractCellLocator vtkCellLocator vtkStaticCellLocator
+ * vtkCellTreeLocator vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+// Forward declaration for PIMPL
+struct vtkBVHCellTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator* New();
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Set the number of bins along each axis in which the cell centers are
+   * sorted to evaluate the candidate splits of a node. More bins give a
+   * better tree but a slower build. The default is 16.
+   */
+  vtkSetClampMacro(NumberOfBins, int, 2, 64);
+  vtkGetMacro(NumberOfBins, int);
+  //@}
+
+  /**
+   * Return the number of nodes of the tree. This has meaning only after the
+   * locator has been built.
+   */
+  vtkIdType GetNumberOfNodes();
+
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+
+  /**
+   * Test a point to find if it is inside a cell. Returns the cellId if inside
+   * or -1 if not.
+   */
+  vtkIdType FindCell(double pos[3], double vtkNotUsed, vtkGenericCell* cell, double pcoords[3],
+    double* weights) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindCell(double x[3]) override { return this->Superclass::FindCell(x); }
+
+  /**
+   * Return a list of unique cell ids whose bounds intersect a given bounding
+   * box. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Given a finite line defined by the two points (p1,p2), return the list
+   * of unique cell ids whose bounds, padded by the tolerance, intersect the
+   * line. The user must provide the vtkIdList cell list to populate.
+   */
+  void FindCellsAlongLine(
+    const double p1[3], const double p2[3], double tolerance, vtkIdList* cells) override;
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * The closest point is somewhere on a cell, it need not be one of the
+   * vertices of the cell. If a cell is found, "cell" contains the points and
+   * ptIds for the cell "cellId" upon exit.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3], vtkGenericCell* cell,
+    vtkIdType& cellId, int& subId, double& dist2) override;
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. This method returns 1 if a point is found within
+   * the specified radius, and 0 otherwise, in which case closestPoint,
+   * cellId, subId, and dist2 are undefined. If a closest point is found,
+   * "cell" contains the points and ptIds for the cell "cellId" upon exit, and
+   * inside returns the return value of the EvaluatePosition call to the
+   * closest cell; inside(=1) or outside(=0).
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell is returned as a cell id and as a generic cell.
+   * When several cells are hit at the same distance, the one with the
+   * smallest id is returned.
+   */
+  int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
+  }
+
+  /**
+   * Take the passed line segment and intersect it with the data set, using
+   * the Tolerance of the locator. Each intersected cell, and its
+   * intersection point, are added to cellIds and points in order of
+   * increasing distance from p1. Either list may be nullptr. Returns 1 if
+   * the line hits a cell, 0 otherwise.
+   */
+  int IntersectWithLine(
+    const double p1[3], const double p2[3], vtkPoints* points, vtkIdList* cellIds) override;
+
+  /**
+   * Intersect a set of lines with the cells. The rays are sorted so that
+   * neighboring rays are traced together, by packets sharing one traversal
+   * of the tree, and the packets are traced in parallel. The results are
+   * the same as those of IntersectWithLine().
+   */
+  void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds,
+    vtkDoubleArray* ts = nullptr, vtkPoints* xs = nullptr) override;
+
+  /**
+   * All the queries are thread safe once the locator is built.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation() outputs
+   * the boxes of the nodes at the given depth of the tree, and of the
+   * shallower leaves.
+   */
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  //@}
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  int NumberOfBins;
+  vtkBVHCellTree* Tree;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+#endif
@@ -28,6 +28,7 @@
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 
+#include <atomic>
 #include <vector>
 
 namespace detail
@@ -94,6 +95,21 @@ int IntersectWithCell(vtkCell* self, vtkCell* other, double tol)
   }
   return 0;
 }
+
+// Allocations counted by vtkCell::CountScratchAllocation().
+std::atomic<vtkIdType> NumberOfScratchAllocations(0);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkCell::GetNumberOfScratchAllocations()
+{
+  return detail::NumberOfScratchAllocations.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void vtkCell::CountScratchAllocation()
+{
+  detail::NumberOfScratchAllocations.fetch_add(1, std::memory_order_relaxed);
 }
 
 //------------------------------------------------------------------------------
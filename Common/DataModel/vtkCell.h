@@ -390,6 +390,17 @@ public:
   }
   virtual void InterpolateDerivs(const double vtkNotUsed(pcoords)[3], double* vtkNotUsed(derivs)) {}
 
+  /**
+   * Return the number of allocations made by cells for their internal
+   * storage, summed over all cells and threads: the cells instantiated when
+   * a vtkGenericCell first takes a cell type, and the scratch buffers grown
+   * by the triangulation and interpolation helpers of polygons and
+   * polyhedra. This count stops changing once a loop over cells of similar
+   * types and sizes is warm. Other allocations are not counted, so a hook
+   * on operator new is needed to check that a loop does not allocate.
+   */
+  static vtkIdType GetNumberOfScratchAllocations();
+
   // left public for quick computational access
   vtkPoints* Points;
   vtkIdList* PointIds;
@@ -398,9 +409,17 @@ protected:
   vtkCell();
   ~vtkCell() override;
 
+  /**
+   * Increment the count returned by GetNumberOfScratchAllocations().
+   */
+  static void CountScratchAllocation();
+
   double Bounds[6];
 
 private:
+  template <typename T>
+  friend class vtkCellScratchBuffer;
+
   vtkCell(const vtkCell&) = delete;
   void operator=(const vtkCell&) = delete;
 };
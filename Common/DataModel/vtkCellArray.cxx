@@ -276,12 +276,10 @@ struct ExtractAndInitialize
       return false;
     }
 
-    // Copy data:
+    // Copy data. The old arrays are released by SetData(), but may still be
+    // used by a shallow copy of this cell array, so they are left untouched.
     dst->DeepCopy(src);
 
-    // Free old memory:
-    src->Resize(0);
-
     return true;
   }
 };
@@ -525,6 +523,10 @@ vtkCellArray::vtkCellArray() = default;
 vtkCellArray::~vtkCellArray() = default;
 vtkStandardNewMacro(vtkCellArray);
 
+// Initialize static member that controls the automatic conversion of cell
+// arrays to 32-bit storage
+static bool vtkCellArrayGlobalCompactStorage = false;
+
 //=================== Begin Legacy Methods ===================================
 // These should be deprecated at some point as they are confusing or very slow
 
@@ -1067,6 +1069,18 @@ bool vtkCellArray::ConvertToSmallestStorage()
   return true;
 }
 
+//------------------------------------------------------------------------------
+void vtkCellArray::SetGlobalCompactStorage(bool compact)
+{
+  vtkCellArrayGlobalCompactStorage = compact;
+}
+
+//------------------------------------------------------------------------------
+bool vtkCellArray::GetGlobalCompactStorage()
+{
+  return vtkCellArrayGlobalCompactStorage;
+}
+
 //------------------------------------------------------------------------------
 bool vtkCellArray::AllocateExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
@@ -1084,10 +1098,18 @@ bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 // defining the cell.
 int vtkCellArray::GetMaxCellSize()
 {
+  // Small arrays, such as the faces of a polyhedron, are scanned directly:
+  // setting up the thread local results costs more than the scan.
+  const vtkIdType numCells = this->GetNumberOfCells();
+  if (numCells < 10000)
+  {
+    return static_cast<int>(this->Visit(FindMaxCell::Impl{}, 0, numCells));
+  }
+
   FindMaxCell finder{ this };
 
   // Grain size puts an even number of pages into each instance.
-  vtkSMPTools::For(0, this->GetNumberOfCells(), finder);
+  vtkSMPTools::For(0, numCells, finder);
 
   return static_cast<int>(finder.Result);
 }
@@ -1195,7 +1217,12 @@ void vtkCellArray::AppendLegacyFormat(const vtkIdType* data, vtkIdType len, vtkI
 //------------------------------------------------------------------------------
 void vtkCellArray::Squeeze()
 {
-  this->Visit(SqueezeImpl{});
+  // The converted arrays are allocated to their exact size.
+  if (!vtkCellArrayGlobalCompactStorage || !this->IsStorage64Bit() ||
+    !this->CanConvertTo32BitStorage() || !this->ConvertTo32BitStorage())
+  {
+    this->Visit(SqueezeImpl{});
+  }
 
   // Just delete the legacy buffer.
   this->LegacyData->Initialize();
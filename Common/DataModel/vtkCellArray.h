@@ -290,9 +290,10 @@ public:
   void Reset();
 
   /**
-   * Reclaim any extra memory while preserving data.
+   * Reclaim any extra memory while preserving data. When the global compact
+   * storage flag is on, this also converts to the smallest storage.
    *
-   * @sa ConvertToSmallestStorage
+   * @sa ConvertToSmallestStorage SetGlobalCompactStorage
    */
   void Squeeze();
 
@@ -486,6 +487,20 @@ public:
   bool ConvertToSmallestStorage();
   /**@}*/
 
+  /**
+   * Enable or disable the automatic compaction of cell arrays. When enabled,
+   * Squeeze() converts 64-bit storage to 32-bit storage whenever the offsets
+   * and point ids allow it, and the pipeline compacts the cell arrays of the
+   * vtkPolyData and vtkUnstructuredGrid outputs of every algorithm after it
+   * executes, except the cell arrays shared with its inputs. This halves the
+   * memory used, and traversed, by the connectivity of meshes with fewer than
+   * 2^31 points. It is disabled by default.
+   * @{
+   */
+  static void SetGlobalCompactStorage(bool compact);
+  static bool GetGlobalCompactStorage();
+  /**@}*/
+
   /**
    * Return the array used to store cell offsets. The 32/64 variants are only
    * valid when IsStorage64Bit() returns the appropriate value.
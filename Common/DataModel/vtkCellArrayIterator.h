@@ -58,6 +58,11 @@
  * referencing this storage, unpredictable and catastrophic results are
  * likely - hence do not modify the vtkCellArray while iterating.
  *
+ * GoToCell() and GoToFirstCell() record raw pointers to the offsets and
+ * connectivity of the vtkCellArray, so that the cells are then read
+ * without dispatching on the type of storage. With 32-bit storage, the
+ * point ids of each cell are widened to vtkIdType in a single tight loop.
+ *
  * @sa
  * vtkCellArray
  */
@@ -102,6 +107,7 @@ public:
   {
     this->CurrentCellId = cellId;
     this->NumberOfCells = this->CellArray->GetNumberOfCells();
+    this->UpdateStorage();
     assert(cellId <= this->NumberOfCells);
   }
 
@@ -147,6 +153,7 @@ public:
   {
     this->CurrentCellId = 0;
     this->NumberOfCells = this->CellArray->GetNumberOfCells();
+    this->UpdateStorage();
   }
 
   /**
@@ -176,16 +183,13 @@ public:
   void GetCurrentCell(vtkIdType& cellSize, vtkIdType const*& cellPoints)
   {
     assert(this->CurrentCellId < this->NumberOfCells);
-    // Either refer to vtkCellArray storage buffer, or copy into local buffer
-    if (this->CellArray->IsStorageShareable())
+    if (this->StorageIs64Bit)
     {
-      this->CellArray->GetCellAtId(this->CurrentCellId, cellSize, cellPoints);
+      this->GetCellFromStorage(this->Offsets64, this->Connectivity64, cellSize, cellPoints);
     }
-    else // or copy into local iterator buffer.
+    else
     {
-      this->CellArray->GetCellAtId(this->CurrentCellId, this->TempCell);
-      cellSize = this->TempCell->GetNumberOfIds();
-      cellPoints = this->TempCell->GetPointer(0);
+      this->GetCellFromStorage(this->Offsets32, this->Connectivity32, cellSize, cellPoints);
     }
   }
   void GetCurrentCell(vtkIdList* ids)
@@ -245,11 +249,67 @@ protected:
 
   vtkSetMacro(CellArray, vtkCellArray*);
 
+  /**
+   * Record the type of storage of the vtkCellArray and pointers to its
+   * offsets and connectivity.
+   */
+  void UpdateStorage()
+  {
+    this->StorageIs64Bit = this->CellArray->IsStorage64Bit();
+    if (this->StorageIs64Bit)
+    {
+      this->Offsets64 = this->CellArray->GetOffsetsArray64()->GetPointer(0);
+      this->Connectivity64 = this->CellArray->GetConnectivityArray64()->GetPointer(0);
+    }
+    else
+    {
+      this->Offsets32 = this->CellArray->GetOffsetsArray32()->GetPointer(0);
+      this->Connectivity32 = this->CellArray->GetConnectivityArray32()->GetPointer(0);
+    }
+  }
+
+  //@{
+  /**
+   * Return the current cell, either as a pointer into the vtkCellArray
+   * storage when it holds vtkIdTypes, or copied into the local buffer.
+   */
+  template <typename ValueType>
+  typename std::enable_if<std::is_same<ValueType, vtkIdType>::value>::type GetCellFromStorage(
+    const ValueType* offsets, const ValueType* connectivity, vtkIdType& cellSize,
+    vtkIdType const*& cellPoints)
+  {
+    const vtkIdType beginOffset = offsets[this->CurrentCellId];
+    cellSize = offsets[this->CurrentCellId + 1] - beginOffset;
+    cellPoints = connectivity + beginOffset;
+  }
+  template <typename ValueType>
+  typename std::enable_if<!std::is_same<ValueType, vtkIdType>::value>::type GetCellFromStorage(
+    const ValueType* offsets, const ValueType* connectivity, vtkIdType& cellSize,
+    vtkIdType const*& cellPoints)
+  {
+    const ValueType* begin = connectivity + offsets[this->CurrentCellId];
+    cellSize = offsets[this->CurrentCellId + 1] - offsets[this->CurrentCellId];
+    this->TempCell->SetNumberOfIds(cellSize);
+    vtkIdType* tempPtr = this->TempCell->GetPointer(0);
+    for (vtkIdType i = 0; i < cellSize; ++i)
+    {
+      tempPtr[i] = static_cast<vtkIdType>(begin[i]);
+    }
+    cellPoints = tempPtr;
+  }
+  //@}
+
   vtkSmartPointer<vtkCellArray> CellArray;
   vtkNew<vtkIdList> TempCell;
   vtkIdType CurrentCellId;
   vtkIdType NumberOfCells;
 
+  bool StorageIs64Bit = true;
+  const vtkCellArray::ArrayType32::ValueType* Offsets32 = nullptr;
+  const vtkCellArray::ArrayType32::ValueType* Connectivity32 = nullptr;
+  const vtkCellArray::ArrayType64::ValueType* Offsets64 = nullptr;
+  const vtkCellArray::ArrayType64::ValueType* Connectivity64 = nullptr;
+
 private:
   vtkCellArrayIterator(const vtkCellArrayIterator&) = delete;
   void operator=(const vtkCellArrayIterator&) = delete;
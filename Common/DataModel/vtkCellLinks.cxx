@@ -27,7 +27,6 @@ vtkStandardNewMacro(vtkCellLinks);
 //------------------------------------------------------------------------------
 vtkCellLinks::~vtkCellLinks()
 {
-  this->Type = vtkAbstractCellLinks::CELL_LINKS;
   this->Initialize();
 }
 
@@ -164,6 +164,7 @@ protected:
     , MaxId(-1)
     , Extend(1000)
   {
+    this->Type = vtkAbstractCellLinks::CELL_LINKS;
   }
   ~vtkCellLinks() override;
 
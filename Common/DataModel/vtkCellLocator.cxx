@@ -20,8 +20,12 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -59,6 +63,79 @@ inline int vtkNeighborCells::InsertNextPoint(int* x)
   return id / 3;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Compute the range of leaf octants overlapped by each cell.
+struct vtkOctantRanges
+{
+  vtkDataSet* DataSet;
+  double (*CellBounds)[6];
+  const double* Bounds;
+  const double* H;
+  double HTol[3];
+  int NumberOfDivisions;
+  int* Ranges;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double cellBounds[6], *boundsPtr = cellBounds;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      if (this->CellBounds)
+      {
+        boundsPtr = this->CellBounds[cellId];
+      }
+      else
+      {
+        this->DataSet->GetCellBounds(cellId, cellBounds);
+      }
+
+      // find min/max locations of bounding box
+      int* ijkMin = this->Ranges + 6 * cellId;
+      int* ijkMax = ijkMin + 3;
+      for (int i = 0; i < 3; i++)
+      {
+        ijkMin[i] =
+          static_cast<int>((boundsPtr[2 * i] - this->Bounds[2 * i] - this->HTol[i]) / this->H[i]);
+        ijkMax[i] = static_cast<int>(
+          (boundsPtr[2 * i + 1] - this->Bounds[2 * i] + this->HTol[i]) / this->H[i]);
+
+        if (ijkMin[i] < 0)
+        {
+          ijkMin[i] = 0;
+        }
+        if (ijkMax[i] >= this->NumberOfDivisions)
+        {
+          ijkMax[i] = this->NumberOfDivisions - 1;
+        }
+      }
+    }
+  }
+
+  // Visit the leaf octants overlapped by a range of cells
+  template <typename Visitor>
+  void ForEachOctant(vtkIdType begin, vtkIdType end, Visitor visit) const
+  {
+    const int ndivs = this->NumberOfDivisions;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      const int* ijk = this->Ranges + 6 * cellId;
+      for (int k = ijk[2]; k <= ijk[5]; k++)
+      {
+        for (int j = ijk[1]; j <= ijk[4]; j++)
+        {
+          for (int i = ijk[0]; i <= ijk[3]; i++)
+          {
+            visit(i + j * ndivs + static_cast<vtkIdType>(k) * ndivs * ndivs, cellId);
+          }
+        }
+      }
+    }
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 // Construct with automatic computation of divisions, averaging
 // 25 cells per bucket.
@@ -1189,13 +1266,12 @@ void vtkCellLocator::ForceBuildLocator()
 //
 void vtkCellLocator::BuildLocatorInternal()
 {
-  double length, cellBounds[6], *boundsPtr;
+  double length, cellBounds[6];
   vtkIdType numCells;
   int ndivs, product;
-  int i, j, k, ijkMin[3], ijkMax[3];
-  vtkIdType cellId, idx;
+  int i, j, k;
+  vtkIdType idx;
   int parentOffset;
-  vtkIdList* octant;
   int numCellsPerBucket = this->NumberOfCellsPerNode;
   int prod, numOctants;
   double hTol[3];
@@ -1273,61 +1349,73 @@ void vtkCellLocator::BuildLocatorInternal()
   }
 
   //  Insert each cell into the appropriate octant.  Make sure cell
-  //  falls within octant.
+  //  falls within octant. The range of octants overlapped by each cell is
+  //  computed in parallel, then the cells are counted and scattered into the
+  //  octants concurrently, and each octant is sorted so that it lists its
+  //  cells in the same order as a sequential insertion.
   //
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
   product = ndivs * ndivs;
-  boundsPtr = cellBounds;
-  for (cellId = 0; cellId < numCells; cellId++)
+
+  // This is done to cause non-thread safe initialization to occur due to
+  // side effects from GetCellBounds().
+  this->DataSet->GetCellBounds(0, cellBounds);
+
+  std::vector<int> ranges(6 * numCells);
+  vtkOctantRanges octantRanges;
+  octantRanges.DataSet = this->DataSet;
+  octantRanges.CellBounds = this->CellBounds;
+  octantRanges.Bounds = this->Bounds;
+  octantRanges.H = this->H;
+  octantRanges.NumberOfDivisions = ndivs;
+  octantRanges.Ranges = ranges.data();
+  for (i = 0; i < 3; i++)
   {
-    if (this->CellBounds)
-    {
-      boundsPtr = this->CellBounds[cellId];
-    }
-    else
-    {
-      this->DataSet->GetCellBounds(cellId, cellBounds);
-    }
+    octantRanges.HTol[i] = hTol[i];
+  }
+  vtkSMPTools::For(0, numCells, octantRanges);
 
-    // find min/max locations of bounding box
-    for (i = 0; i < 3; i++)
-    {
-      ijkMin[i] = static_cast<int>((boundsPtr[2 * i] - this->Bounds[2 * i] - hTol[i]) / this->H[i]);
-      ijkMax[i] =
-        static_cast<int>((boundsPtr[2 * i + 1] - this->Bounds[2 * i] + hTol[i]) / this->H[i]);
+  const vtkIdType numLeaves = static_cast<vtkIdType>(product) * ndivs;
+  std::vector<std::atomic<vtkIdType>> counts(numLeaves);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    octantRanges.ForEachOctant(begin, end, [&](vtkIdType leafId, vtkIdType) { counts[leafId]++; });
+  });
 
-      if (ijkMin[i] < 0)
-      {
-        ijkMin[i] = 0;
-      }
-      if (ijkMax[i] >= ndivs)
-      {
-        ijkMax[i] = ndivs - 1;
-      }
+  // Allocate the non-empty octants, and mark their parents
+  vtkIdListPtr* leaves = this->Tree + parentOffset;
+  for (idx = 0; idx < numLeaves; idx++)
+  {
+    if (counts[idx] > 0)
+    {
+      leaves[idx] = vtkIdList::New();
+      leaves[idx]->SetNumberOfIds(counts[idx]);
+      counts[idx] = 0;
+      i = static_cast<int>(idx % ndivs);
+      j = static_cast<int>((idx / ndivs) % ndivs);
+      k = static_cast<int>(idx / product);
+      this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
     }
+  }
+
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    octantRanges.ForEachOctant(begin, end,
+      [&](vtkIdType leafId, vtkIdType id) { leaves[leafId]->SetId(counts[leafId]++, id); });
+  });
 
-    // each octant between min/max point may have cell in it
-    for (k = ijkMin[2]; k <= ijkMax[2]; k++)
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType leafId = begin; leafId < end; leafId++)
     {
-      for (j = ijkMin[1]; j <= ijkMax[1]; j++)
+      if (leaves[leafId])
       {
-        for (i = ijkMin[0]; i <= ijkMax[0]; i++)
+        vtkIdType* ids = leaves[leafId]->GetPointer(0);
+        vtkIdType* idsEnd = ids + leaves[leafId]->GetNumberOfIds();
+        if (!std::is_sorted(ids, idsEnd))
         {
-          idx = parentOffset + i + j * ndivs + k * product;
-          this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
-          octant = this->Tree[idx];
-          if (!octant)
-          {
-            octant = vtkIdList::New();
-            octant->Allocate(numCellsPerBucket, numCellsPerBucket / 2);
-            this->Tree[idx] = octant;
-          }
-          octant->InsertNextId(cellId);
+          std::sort(ids, idsEnd);
         }
       }
     }
-
-  } // for all cells
+  });
 
   this->BuildTime.Modified();
 }
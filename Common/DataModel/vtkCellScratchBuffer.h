@@ -0,0 +1,60 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellScratchBuffer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCellScratchBuffer
+ * @brief   Growable scratch storage kept by a cell between calls.
+ *
+ * vtkCellScratchBuffer holds the temporary values of the helpers of a cell
+ * (triangulation vertices, interpolation weights...). Its storage only grows,
+ * so that a cell reused in a loop over similar cells stops allocating once
+ * it has seen the largest of them. Each growth is counted by
+ * vtkCell::GetNumberOfScratchAllocations().
+ *
+ * A buffer belongs to a single cell instance, and a cell is used by a single
+ * thread at a time: per-thread cells (e.g. one vtkGenericCell per thread)
+ * give per-thread scratch storage.
+ */
+
+#ifndef vtkCellScratchBuffer_h
+#define vtkCellScratchBuffer_h
+
+#include "vtkCell.h"
+
+#include <vector> // For vector
+
+template <typename T>
+class vtkCellScratchBuffer
+{
+public:
+  /**
+   * Return storage for at least @a size values. The values are left as they
+   * were, and are invalidated by the next call.
+   */
+  T* Get(vtkIdType size)
+  {
+    if (static_cast<std::size_t>(size) > this->Values.size())
+    {
+      vtkCell::CountScratchAllocation();
+      this->Values.resize(static_cast<std::size_t>(size));
+    }
+    return this->Values.data();
+  }
+
+private:
+  std::vector<T> Values;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkCellScratchBuffer.h
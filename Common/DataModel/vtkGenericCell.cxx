@@ -427,6 +427,7 @@ void vtkGenericCell::SetCellType(int cellType)
     else if (this->CellStore[cellType] == nullptr)
     {
       this->CellStore[cellType] = vtkGenericCell::InstantiateCell(cellType);
+      vtkCell::CountScratchAllocation();
       this->Cell = this->CellStore[cellType];
     }
     else
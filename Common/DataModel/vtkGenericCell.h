@@ -108,7 +108,8 @@ public:
    * method. It allows vtkGenericCell to act like any cell type by
    * dereferencing an internal instance of a concrete cell type. When
    * you set the cell type, you are resetting a pointer to an internal
-   * cell which is then used for computation.
+   * cell which is then used for computation. The internal cell of each type
+   * is created the first time this type is set, and reused afterwards.
    */
   void SetCellType(int cellType);
   void SetCellTypeToEmptyCell() { this->SetCellType(VTK_EMPTY_CELL); }
@@ -29,17 +29,22 @@
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkKdNode.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -49,6 +54,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace
 {
@@ -99,6 +105,51 @@ private:
 };
 }
 
+namespace
+{
+// Compute the centers of the cells of a data set, each thread using its own
+// cell and weights.
+struct ComputeCellCentersFunctor
+{
+  vtkDataSet* DataSet;
+  float* Centers;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+
+  ComputeCellCentersFunctor(vtkDataSet* set, float* centers)
+    : DataSet(set)
+    , Centers(centers)
+    , MaxCellSize(set->GetMaxCellSize())
+  {
+    // Trigger the non thread safe initialization of the cells, if any
+    vtkNew<vtkGenericCell> cell;
+    set->GetCell(0, cell);
+  }
+
+  void Initialize() { this->Weights.Local().resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double* weights = this->Weights.Local().data();
+    double pcoords[3], center[3];
+    float* cptr = this->Centers + 3 * begin;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId, cptr += 3)
+    {
+      this->DataSet->GetCell(cellId, cell);
+      int subId = cell->GetParametricCenter(pcoords);
+      cell->EvaluateLocation(subId, pcoords, center, weights);
+      cptr[0] = static_cast<float>(center[0]);
+      cptr[1] = static_cast<float>(center[1]);
+      cptr[2] = static_cast<float>(center[2]);
+    }
+  }
+
+  void Reduce() {}
+};
+}
+
 #define SCOPETIMER(msg)                                                                            \
   TimeLog _timer("KdTree: " msg, this->Timing);                                                    \
   (void)_timer
@@ -627,70 +678,30 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     return nullptr;
   }
 
-  int maxCellSize = 0;
-
   if (set)
   {
-    maxCellSize = set->GetMaxCellSize();
-  }
-  else
-  {
-    vtkCollectionSimpleIterator cookie;
-    this->DataSets->InitTraversal(cookie);
-    for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
-         iset = this->DataSets->GetNextDataSet(cookie))
-    {
-      int cellSize = iset->GetMaxCellSize();
-      maxCellSize = (cellSize > maxCellSize) ? cellSize : maxCellSize;
-    }
-  }
-
-  double* weights = new double[maxCellSize];
-
-  float* cptr = center;
-  double dcenter[3];
-
-  if (set)
-  {
-    for (int j = 0; j < totalCells; j++)
-    {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
-      {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-      }
-    }
+    ComputeCellCentersFunctor functor(set, center);
+    vtkSMPTools::For(0, totalCells, functor);
   }
   else
   {
+    float* cptr = center;
     vtkCollectionSimpleIterator cookie;
     this->DataSets->InitTraversal(cookie);
     for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
          iset = this->DataSets->GetNextDataSet(cookie))
     {
       int nCells = iset->GetNumberOfCells();
-
-      for (int j = 0; j < nCells; j++)
+      if (nCells > 0)
       {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
-        {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-        }
+        ComputeCellCentersFunctor functor(iset, cptr);
+        vtkSMPTools::For(0, nCells, functor);
+        cptr += 3 * nCells;
+        this->UpdateSubOperationProgress(static_cast<double>(cptr - center) / (3 * totalCells));
       }
     }
   }
 
-  delete[] weights;
-
   this->UpdateSubOperationProgress(1.0);
   return center;
 }
@@ -896,7 +907,7 @@ void vtkKdTree::BuildLocator()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    this->DivideRegionInParallel(kd, ptarray, nullptr);
 
     TIMERDONE("Build tree");
 
@@ -1229,6 +1240,74 @@ int vtkKdTree::DivideTest(int size, int level)
 }
 //------------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (!this->DivideRegionOnce(kd, c1, ids, level))
+  {
+    return 0;
+  }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int* leftIds = ids;
+  int* rightIds = ids ? ids + nleft : nullptr;
+
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+
+  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkKdTree::DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids)
+{
+  struct Region
+  {
+    vtkKdNode* Node;
+    float* Points;
+    int* Ids;
+    int Level;
+  };
+
+  // Divide the first levels breadth first, until there are enough subtrees
+  // to keep the threads busy. The regions of a level are disjoint ranges of
+  // the point array, so the subtrees can be divided concurrently.
+  int subtreeLevel = 0;
+  while ((1 << subtreeLevel) < 8 * vtkSMPTools::GetEstimatedNumberOfThreads() &&
+    subtreeLevel < 16)
+  {
+    ++subtreeLevel;
+  }
+
+  std::vector<Region> regions(1, Region{ kd, c1, ids, 0 });
+  for (int level = 0; level < subtreeLevel && !regions.empty(); ++level)
+  {
+    std::vector<Region> children;
+    for (const Region& region : regions)
+    {
+      if (this->DivideRegionOnce(region.Node, region.Points, region.Ids, level))
+      {
+        int nleft = region.Node->GetLeft()->GetNumberOfPoints();
+        children.push_back(Region{ region.Node->GetLeft(), region.Points, region.Ids, level + 1 });
+        children.push_back(Region{ region.Node->GetRight(), region.Points + nleft * 3,
+          region.Ids ? region.Ids + nleft : nullptr, level + 1 });
+      }
+    }
+    regions.swap(children);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const Region& region = regions[i];
+        this->DivideRegion(region.Node, region.Points, region.Ids, region.Level);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+int vtkKdTree::DivideRegionOnce(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1288,16 +1367,7 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
     return 0; // unable to divide region further
   }
 
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
-
-  int* leftIds = ids;
-  int* rightIds = ids ? ids + nleft : nullptr;
-
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
-
-  return 0;
+  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -1846,7 +1916,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionInParallel(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
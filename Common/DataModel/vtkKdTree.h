@@ -776,6 +776,14 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  // Divide a region in two, returns 0 if the region is not divided.
+  int DivideRegionOnce(vtkKdNode* kd, float* c1, int* ids, int level);
+
+  // Divide the first levels of the tree one region at a time, then divide
+  // the resulting subtrees concurrently. Builds the same tree as
+  // DivideRegion().
+  void DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids);
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
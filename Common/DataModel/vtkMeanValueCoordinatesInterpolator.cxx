@@ -60,10 +60,13 @@ public:
   }
 };
 
-// Special class that can iterate over different type of polygon representations
+// Special class that can iterate over different type of polygon representations.
+// The cells are read in place when the storage of the cell array can be shared,
+// and through a cell array iterator otherwise.
 class vtkMVCPolyIterator
 {
 public:
+  vtkCellArray* Cells;
   vtkSmartPointer<vtkCellArrayIterator> Iter;
   vtkIdType CurrentPolygonSize;
   const vtkIdType* Current;
@@ -73,36 +76,40 @@ public:
 
   vtkMVCPolyIterator(vtkCellArray* cells)
   {
+    this->Cells = cells;
     this->NumberOfPolygons = cells->GetNumberOfCells();
     this->MaxPolygonSize = cells->GetMaxCellSize();
-    this->Iter = vtk::TakeSmartPointer(cells->NewIterator());
-    this->Iter->GoToFirstCell();
-    if (!this->Iter->IsDoneWithTraversal())
+    if (!cells->IsStorageShareable())
     {
-      this->Iter->GetCurrentCell(this->CurrentPolygonSize, this->Current);
+      this->Iter = vtk::TakeSmartPointer(cells->NewIterator());
     }
-    else
-    {
-      this->CurrentPolygonSize = 0;
-      this->Current = nullptr;
-    }
-    this->Id = this->Iter->GetCurrentCellId();
+    this->Id = 0;
+    this->Load();
   }
 
   const vtkIdType* operator++()
   {
-    this->Iter->GoToNextCell();
-    if (!this->Iter->IsDoneWithTraversal())
+    this->Id++;
+    this->Load();
+    return this->Current;
+  }
+
+private:
+  void Load()
+  {
+    if (this->Id >= this->NumberOfPolygons)
+    {
+      this->CurrentPolygonSize = 0;
+      this->Current = nullptr;
+    }
+    else if (this->Iter)
     {
-      this->Iter->GetCurrentCell(this->CurrentPolygonSize, this->Current);
+      this->Iter->GetCellAtId(this->Id, this->CurrentPolygonSize, this->Current);
     }
     else
     {
-      this->CurrentPolygonSize = 0;
-      this->Current = nullptr;
+      this->Cells->GetCellAtId(this->Id, this->CurrentPolygonSize, this->Current);
     }
-    this->Id = this->Iter->GetCurrentCellId();
-    return this->Current;
   }
 };
 
@@ -122,7 +129,8 @@ namespace
 struct ComputeWeightsForPolygonMesh
 {
   template <typename PtArrayT>
-  void operator()(PtArrayT* ptArray, const double x[3], vtkMVCPolyIterator& iter, double* weights)
+  void operator()(PtArrayT* ptArray, const double x[3], vtkMVCPolyIterator& iter, double* weights,
+    double* scratch)
   {
     const auto points = vtk::DataArrayTupleRange<3>(ptArray);
     const vtkIdType npts = points.size();
@@ -130,9 +138,11 @@ struct ComputeWeightsForPolygonMesh
     // Begin by initializing weights.
     std::fill_n(weights, static_cast<size_t>(npts), 0.);
 
-    // create local array for storing point-to-vertex vectors and distances
-    std::vector<double> dist(npts);
-    std::vector<double> uVec(3 * npts);
+    // point-to-vertex vectors and distances, followed by the angles of a polygon
+    double* dist = scratch;
+    double* uVec = dist + npts;
+    double* alpha = uVec + 3 * npts;
+    double* theta = alpha + iter.MaxPolygonSize;
     static constexpr double eps = 0.00000001;
 
     for (vtkIdType pid = 0; pid < npts; ++pid)
@@ -144,7 +154,7 @@ struct ComputeWeightsForPolygonMesh
       uVec[3 * pid + 2] = pt[2] - x[2];
 
       // distance
-      dist[pid] = vtkMath::Norm(uVec.data() + 3 * pid);
+      dist[pid] = vtkMath::Norm(uVec + 3 * pid);
 
       // handle special case when the point is really close to a vertex
       if (dist[pid] < eps)
@@ -160,20 +170,12 @@ struct ComputeWeightsForPolygonMesh
     }
 
     // Now loop over all triangle to compute weights
-    std::vector<double*> u(iter.MaxPolygonSize);
-    std::vector<double> alpha(iter.MaxPolygonSize);
-    std::vector<double> theta(iter.MaxPolygonSize);
-
     const vtkIdType* poly = iter.Current;
+    const auto u = [&](int j) { return uVec + 3 * poly[j]; };
     while (iter.Id < iter.NumberOfPolygons)
     {
       int nPolyPts = iter.CurrentPolygonSize;
 
-      for (int j = 0; j < nPolyPts; j++)
-      {
-        u[j] = uVec.data() + 3 * poly[j];
-      }
-
       // unit vector v.
       double v[3] = { 0., 0., 0. };
       double l;
@@ -181,19 +183,19 @@ struct ComputeWeightsForPolygonMesh
       double temp[3];
       for (int j = 0; j < nPolyPts - 1; j++)
       {
-        vtkMath::Cross(u[j], u[j + 1], temp);
+        vtkMath::Cross(u(j), u(j + 1), temp);
         vtkMath::Normalize(temp);
 
-        l = sqrt(vtkMath::Distance2BetweenPoints(u[j], u[j + 1]));
+        l = sqrt(vtkMath::Distance2BetweenPoints(u(j), u(j + 1)));
         angle = 2.0 * asin(l / 2.0);
 
         v[0] += 0.5 * angle * temp[0];
         v[1] += 0.5 * angle * temp[1];
         v[2] += 0.5 * angle * temp[2];
       }
-      l = sqrt(vtkMath::Distance2BetweenPoints(u[nPolyPts - 1], u[0]));
+      l = sqrt(vtkMath::Distance2BetweenPoints(u(nPolyPts - 1), u(0)));
       angle = 2.0 * asin(l / 2.0);
-      vtkMath::Cross(u[nPolyPts - 1], u[0], temp);
+      vtkMath::Cross(u(nPolyPts - 1), u(0), temp);
       vtkMath::Normalize(temp);
       v[0] += 0.5 * angle * temp[0];
       v[1] += 0.5 * angle * temp[1];
@@ -204,7 +206,7 @@ struct ComputeWeightsForPolygonMesh
       // The direction of v depends on the orientation (clockwise or
       // contour-clockwise) of the polygon. We want to make sure that v
       // starts from x and point towards the polygon.
-      if (vtkMath::Dot(v, u[0]) < 0)
+      if (vtkMath::Dot(v, u(0)) < 0)
       {
         v[0] = -v[0];
         v[1] = -v[1];
@@ -216,9 +218,9 @@ struct ComputeWeightsForPolygonMesh
       for (int j = 0; j < nPolyPts - 1; j++)
       {
         // alpha
-        vtkMath::Cross(u[j], v, n0);
+        vtkMath::Cross(u(j), v, n0);
         vtkMath::Normalize(n0);
-        vtkMath::Cross(u[j + 1], v, n1);
+        vtkMath::Cross(u(j + 1), v, n1);
         vtkMath::Normalize(n1);
 
         // alpha[j] = acos(vtkMath::Dot(n0, n1));
@@ -231,14 +233,14 @@ struct ComputeWeightsForPolygonMesh
         }
 
         // theta_j
-        // theta[j] = acos(vtkMath::Dot(u[j], v));
-        l = sqrt(vtkMath::Distance2BetweenPoints(u[j], v));
+        // theta[j] = acos(vtkMath::Dot(u(j), v));
+        l = sqrt(vtkMath::Distance2BetweenPoints(u(j), v));
         theta[j] = 2.0 * asin(l / 2.0);
       }
 
-      vtkMath::Cross(u[nPolyPts - 1], v, n0);
+      vtkMath::Cross(u(nPolyPts - 1), v, n0);
       vtkMath::Normalize(n0);
-      vtkMath::Cross(u[0], v, n1);
+      vtkMath::Cross(u(0), v, n1);
       vtkMath::Normalize(n1);
       // alpha[nPolyPts-1] = acos(vtkMath::Dot(n0, n1));
       l = sqrt(vtkMath::Distance2BetweenPoints(n0, n1));
@@ -249,8 +251,8 @@ struct ComputeWeightsForPolygonMesh
         alpha[nPolyPts - 1] = -alpha[nPolyPts - 1];
       }
 
-      // theta[nPolyPts-1] = acos(vtkMath::Dot(u[nPolyPts-1], v));
-      l = sqrt(vtkMath::Distance2BetweenPoints(u[nPolyPts - 1], v));
+      // theta[nPolyPts-1] = acos(vtkMath::Dot(u(nPolyPts-1), v));
+      l = sqrt(vtkMath::Distance2BetweenPoints(u(nPolyPts - 1), v));
       theta[nPolyPts - 1] = 2.0 * asin(l / 2.0);
 
       bool outlierFlag = false;
@@ -286,10 +288,10 @@ struct ComputeWeightsForPolygonMesh
         // recompute theta, the theta computed previously are not robust
         for (int j = 0; j < nPolyPts - 1; j++)
         {
-          l = sqrt(vtkMath::Distance2BetweenPoints(u[j], u[j + 1]));
+          l = sqrt(vtkMath::Distance2BetweenPoints(u(j), u(j + 1)));
           theta[j] = 2.0 * asin(l / 2.0);
         }
-        l = sqrt(vtkMath::Distance2BetweenPoints(u[nPolyPts - 1], u[0]));
+        l = sqrt(vtkMath::Distance2BetweenPoints(u(nPolyPts - 1), u(0)));
         theta[nPolyPts - 1] = 2.0 * asin(l / 2.0);
 
         double sumWeight;
@@ -347,7 +349,8 @@ struct ComputeWeightsForPolygonMesh
 struct ComputeWeightsForTriangleMesh
 {
   template <typename PtArrayT>
-  void operator()(PtArrayT* ptArray, const double x[3], vtkMVCTriIterator& iter, double* weights)
+  void operator()(PtArrayT* ptArray, const double x[3], vtkMVCTriIterator& iter, double* weights,
+    double* scratch)
   {
     // Points are organized {(x,y,z), (x,y,z), ....}
     // Tris are organized {(i,j,k), (i,j,k), ....}
@@ -361,9 +364,9 @@ struct ComputeWeightsForTriangleMesh
     // Begin by initializing weights.
     std::fill(weights, weightsEnd, 0.);
 
-    // create local array for storing point-to-vertex vectors and distances
-    std::vector<double> dist(static_cast<size_t>(npts));
-    std::vector<double> uVec(static_cast<size_t>(3 * npts));
+    // point-to-vertex vectors and distances
+    double* dist = scratch;
+    double* uVec = dist + npts;
     static constexpr double eps = 0.000000001;
     for (vtkIdType pid = 0; pid < npts; ++pid)
     {
@@ -374,7 +377,7 @@ struct ComputeWeightsForTriangleMesh
       uVec[3 * pid + 2] = pt[2] - x[2];
 
       // distance
-      dist[pid] = vtkMath::Norm(uVec.data() + 3 * pid);
+      dist[pid] = vtkMath::Norm(uVec + 3 * pid);
 
       // handle special case when the point is really close to a vertex
       if (dist[pid] < eps)
@@ -398,9 +401,9 @@ struct ComputeWeightsForTriangleMesh
       vtkIdType pid2 = iter.Current[2];
 
       // unit vector
-      double* u0 = uVec.data() + 3 * pid0;
-      double* u1 = uVec.data() + 3 * pid1;
-      double* u2 = uVec.data() + 3 * pid2;
+      double* u0 = uVec + 3 * pid0;
+      double* u1 = uVec + 3 * pid1;
+      double* u2 = uVec + 3 * pid2;
 
       // edge length
       double l0 = sqrt(vtkMath::Distance2BetweenPoints(u1, u2));
@@ -520,8 +523,9 @@ void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeights(
   // Below the vtkCellArray has three entries per triangle {(i,j,k), (i,j,k), ....}
   vtkMVCTriIterator iter(tris->GetNumberOfIds(), 3, t);
 
+  std::vector<double> scratch(pts ? static_cast<size_t>(4 * pts->GetNumberOfPoints()) : 0);
   vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeightsForTriangleMesh(
-    x, pts, iter, weights);
+    x, pts, iter, weights, scratch.data());
 }
 
 //------------------------------------------------------------------------------
@@ -529,6 +533,24 @@ void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeights(
 // (with vtkCellArray). Satisfy classes' public API.
 void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeights(
   const double x[3], vtkPoints* pts, vtkCellArray* cells, double* weights)
+{
+  std::vector<double> scratch(
+    static_cast<size_t>(vtkMeanValueCoordinatesInterpolator::GetScratchSize(pts, cells)));
+  vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeights(
+    x, pts, cells, weights, scratch.data());
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkMeanValueCoordinatesInterpolator::GetScratchSize(vtkPoints* pts, vtkCellArray* cells)
+{
+  // Four values per point (distance and unit vector), and two per vertex of
+  // the largest polygon (angles).
+  return (pts ? 4 * pts->GetNumberOfPoints() : 0) + (cells ? 2 * cells->GetMaxCellSize() : 0);
+}
+
+//------------------------------------------------------------------------------
+void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeights(
+  const double x[3], vtkPoints* pts, vtkCellArray* cells, double* weights, double* scratch)
 {
   // Check the input
   if (!cells)
@@ -564,20 +586,20 @@ void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeights(
     vtkMVCTriIterator iter(cells->GetNumberOfConnectivityIds(), 3, t);
 
     vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeightsForTriangleMesh(
-      x, pts, iter, weights);
+      x, pts, iter, weights, scratch);
   }
   else
   {
     vtkMVCPolyIterator iter(cells);
 
     vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeightsForPolygonMesh(
-      x, pts, iter, weights);
+      x, pts, iter, weights, scratch);
   }
 }
 
 //------------------------------------------------------------------------------
 void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeightsForTriangleMesh(
-  const double x[3], vtkPoints* pts, vtkMVCTriIterator& iter, double* weights)
+  const double x[3], vtkPoints* pts, vtkMVCTriIterator& iter, double* weights, double* scratch)
 {
   // Check the input
   if (!pts || !weights)
@@ -598,15 +620,15 @@ void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeightsForTriangle
   using Dispatcher = vtkArrayDispatch::DispatchByValueType<Reals>;
 
   ComputeWeightsForTriangleMesh worker;
-  if (!Dispatcher::Execute(pts->GetData(), worker, x, iter, weights))
+  if (!Dispatcher::Execute(pts->GetData(), worker, x, iter, weights, scratch))
   { // fallback for weird arrays:
-    worker(pts->GetData(), x, iter, weights);
+    worker(pts->GetData(), x, iter, weights, scratch);
   }
 }
 
 //------------------------------------------------------------------------------
 void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeightsForPolygonMesh(
-  const double x[3], vtkPoints* pts, vtkMVCPolyIterator& iter, double* weights)
+  const double x[3], vtkPoints* pts, vtkMVCPolyIterator& iter, double* weights, double* scratch)
 {
   // Check the input
   if (!pts || !weights)
@@ -627,9 +649,9 @@ void vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeightsForPolygonM
   using Dispatcher = vtkArrayDispatch::DispatchByValueType<Reals>;
 
   ComputeWeightsForPolygonMesh worker;
-  if (!Dispatcher::Execute(pts->GetData(), worker, x, iter, weights))
+  if (!Dispatcher::Execute(pts->GetData(), worker, x, iter, weights, scratch))
   { // fallback for weird arrays:
-    worker(pts->GetData(), x, iter, weights);
+    worker(pts->GetData(), x, iter, weights, scratch);
   }
 }
 
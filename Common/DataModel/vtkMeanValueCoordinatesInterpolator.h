@@ -86,6 +86,16 @@ public:
   static void ComputeInterpolationWeights(
     const double x[3], vtkPoints* pts, vtkCellArray* tris, double* weights);
 
+  /**
+   * As above, but use @a scratch, an array of at least GetScratchSize(pts,
+   * tris) values, for the temporary values of the computation instead of
+   * allocating them. Callers that keep this array between calls (e.g.
+   * vtkPolyhedron) interpolate without allocating.
+   */
+  static void ComputeInterpolationWeights(
+    const double x[3], vtkPoints* pts, vtkCellArray* tris, double* weights, double* scratch);
+  static vtkIdType GetScratchSize(vtkPoints* pts, vtkCellArray* tris);
+
 protected:
   vtkMeanValueCoordinatesInterpolator();
   ~vtkMeanValueCoordinatesInterpolator() override;
@@ -93,14 +103,14 @@ protected:
   /**
    * Internal method that sets up the processing of triangular meshes.
    */
-  static void ComputeInterpolationWeightsForTriangleMesh(
-    const double x[3], vtkPoints* pts, vtkMVCTriIterator& iter, double* weights);
+  static void ComputeInterpolationWeightsForTriangleMesh(const double x[3], vtkPoints* pts,
+    vtkMVCTriIterator& iter, double* weights, double* scratch);
 
   /**
    * Internal method that sets up the processing of general polyhedron meshes.
    */
-  static void ComputeInterpolationWeightsForPolygonMesh(
-    const double x[3], vtkPoints* pts, vtkMVCPolyIterator& iter, double* weights);
+  static void ComputeInterpolationWeightsForPolygonMesh(const double x[3], vtkPoints* pts,
+    vtkMVCPolyIterator& iter, double* weights, double* scratch);
 
 private:
   vtkMeanValueCoordinatesInterpolator(const vtkMeanValueCoordinatesInterpolator&) = delete;
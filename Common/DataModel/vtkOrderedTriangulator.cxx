@@ -155,9 +155,44 @@ struct OTFace // used during tetra construction
 typedef std::vector<OTFace*> FaceListType;
 typedef std::vector<OTFace*>::iterator FaceListIterator;
 
+//---Allocates the nodes of the tetra list in the heap of the mesh. The nodes
+// are released all at once by the heap reset of InitTriangulation(), so a
+// triangulator reused for many cells stops allocating once its heap is large
+// enough.
+template <typename T>
+struct OTHeapAllocator
+{
+  typedef T value_type;
+
+  OTHeapAllocator(vtkHeap* heap)
+    : Heap(heap)
+  {
+  }
+  template <typename U>
+  OTHeapAllocator(const OTHeapAllocator<U>& other)
+    : Heap(other.Heap)
+  {
+  }
+
+  T* allocate(std::size_t n) { return static_cast<T*>(this->Heap->AllocateMemory(n * sizeof(T))); }
+  void deallocate(T*, std::size_t) {}
+
+  vtkHeap* Heap;
+};
+template <typename T, typename U>
+bool operator==(const OTHeapAllocator<T>& a, const OTHeapAllocator<U>& b)
+{
+  return a.Heap == b.Heap;
+}
+template <typename T, typename U>
+bool operator!=(const OTHeapAllocator<T>& a, const OTHeapAllocator<U>& b)
+{
+  return a.Heap != b.Heap;
+}
+
 //---Class represents a tetrahedron (and related typedefs)--------------------
-typedef std::list<OTTetra*> TetraListType;
-typedef std::list<OTTetra*>::iterator TetraListIterator;
+typedef std::list<OTTetra*, OTHeapAllocator<OTTetra*>> TetraListType;
+typedef TetraListType::iterator TetraListIterator;
 struct TetraStackType : public std::stack<OTTetra*>
 {
   TetraStackType()
@@ -223,7 +258,8 @@ struct OTTetra
 struct vtkOTMesh
 {
   vtkOTMesh(vtkHeap* heap)
-    : NumberOfTetrasClassifiedInside(0)
+    : Tetras(OTHeapAllocator<OTTetra*>(heap))
+    , NumberOfTetrasClassifiedInside(0)
     , NumberOfTemplates(0)
   {
     this->EdgeTable = vtkEdgeTable::New();
@@ -355,8 +391,8 @@ void vtkOrderedTriangulator::InitTriangulation(
 //------------------------------------------------------------------------------
 void vtkOrderedTriangulator::InitTriangulation(double bounds[6], int numPts)
 {
-  this->Heap->Reset();
   this->Mesh->Reset();
+  this->Heap->Reset();
   this->NumberOfPoints = 0;
   this->MaximumNumberOfPoints = numPts;
   this->Mesh->Points.resize(numPts + 6);
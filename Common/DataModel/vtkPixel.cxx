@@ -301,8 +301,8 @@ int vtkPixel::CellBoundary(int vtkNotUsed(subId), const double pcoords[3], vtkId
 static int edges[4][2] = { { 0, 1 }, { 1, 3 }, { 2, 3 }, { 0, 2 } };
 
 void vtkPixel::Contour(double value, vtkDataArray* cellScalars, vtkIncrementalPointLocator* locator,
-  vtkCellArray* vtkNotUsed(verts), vtkCellArray* lines, vtkCellArray* vtkNotUsed(polys),
-  vtkPointData* inPd, vtkPointData* outPd, vtkCellData* inCd, vtkIdType cellId, vtkCellData* outCd)
+  vtkCellArray* verts, vtkCellArray* lines, vtkCellArray* vtkNotUsed(polys), vtkPointData* inPd,
+  vtkPointData* outPd, vtkCellData* inCd, vtkIdType cellId, vtkCellData* outCd)
 {
   static const int CASE_MASK[4] = { 1, 2, 8, 4 }; // note differenceom quad!
   vtkMarchingSquaresLineCases* lineCase;
@@ -311,6 +311,7 @@ void vtkPixel::Contour(double value, vtkDataArray* cellScalars, vtkIncrementalPo
   int newCellId;
   vtkIdType pts[2];
   double t, x1[3], x2[3], x[3];
+  vtkIdType offset = verts->GetNumberOfCells();
 
   // Build the case table
   for (i = 0, index = 0; i < 4; i++)
@@ -350,7 +351,7 @@ void vtkPixel::Contour(double value, vtkDataArray* cellScalars, vtkIncrementalPo
     // check for degenerate line
     if (pts[0] != pts[1])
     {
-      newCellId = lines->InsertNextCell(2, pts);
+      newCellId = offset + lines->InsertNextCell(2, pts);
       if (outCd)
       {
         outCd->CopyData(inCd, cellId, newCellId);
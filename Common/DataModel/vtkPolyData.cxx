@@ -33,12 +33,14 @@
 #include "vtkQuad.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkVertex.h"
 
 #include <stdexcept>
+#include <utility>
 
 // vtkPolyDataInternals.h methods:
 namespace vtkPolyData_detail
@@ -979,19 +981,40 @@ void vtkPolyData::BuildLinks(int initialSize)
     this->BuildCells();
   }
 
-  this->Links = vtkSmartPointer<vtkCellLinks>::New();
-  if (initialSize > 0)
+  // Static links are built in parallel into two flat arrays. Only editable
+  // datasets need the per-point lists of vtkCellLinks.
+  if (!this->Editable)
   {
-    this->Links->Allocate(initialSize);
+    this->Links = vtkSmartPointer<vtkStaticCellLinks>::New();
   }
   else
   {
-    this->Links->Allocate(this->GetNumberOfPoints());
+    vtkNew<vtkCellLinks> links;
+    links->Allocate(initialSize > 0 ? initialSize : this->GetNumberOfPoints());
+    this->Links = std::move(links);
   }
 
   this->Links->BuildLinks(this);
 }
 
+//------------------------------------------------------------------------------
+vtkAbstractCellLinks* vtkPolyData::GetCellLinks()
+{
+  return this->Links;
+}
+
+//------------------------------------------------------------------------------
+vtkCellLinks* vtkPolyData::GetEditableLinks()
+{
+  if (!this->Links || this->Links->GetType() != vtkAbstractCellLinks::CELL_LINKS)
+  {
+    vtkDebugMacro("Building editable links");
+    this->Editable = true;
+    this->BuildLinks();
+  }
+  return static_cast<vtkCellLinks*>(this->Links.Get());
+}
+
 //------------------------------------------------------------------------------
 // Copy a cells point ids into list provided. (Less efficient.)
 void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList* ptIds)
@@ -1025,8 +1048,7 @@ void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdList* cellIds)
   }
   cellIds->Reset();
 
-  numCells = this->Links->GetNcells(ptId);
-  cells = this->Links->GetCells(ptId);
+  this->GetPointCells(ptId, numCells, cells);
 
   for (i = 0; i < numCells; i++)
   {
@@ -1034,6 +1056,32 @@ void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdList* cellIds)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdType& ncells, vtkIdType*& cells)
+{
+  if (this->Links->GetType() == vtkAbstractCellLinks::CELL_LINKS)
+  {
+    vtkCellLinks* links = static_cast<vtkCellLinks*>(this->Links.Get());
+    ncells = links->GetNcells(ptId);
+    cells = links->GetCells(ptId);
+  }
+  else
+  {
+    vtkStaticCellLinks* links = static_cast<vtkStaticCellLinks*>(this->Links.Get());
+    ncells = links->GetNcells(ptId);
+    cells = links->GetCells(ptId);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyData::GetPointCells(vtkIdType ptId, unsigned short& ncells, vtkIdType*& cells)
+{
+  VTK_LEGACY_BODY(vtkPolyData::GetPointCells, "VTK 9.0");
+  vtkIdType numCells;
+  this->GetPointCells(ptId, numCells, cells);
+  ncells = static_cast<unsigned short>(numCells);
+}
+
 //------------------------------------------------------------------------------
 // Insert a cell of type VTK_VERTEX, VTK_POLY_VERTEX, VTK_LINE, VTK_POLY_LINE,
 // VTK_TRIANGLE, VTK_QUAD, VTK_POLYGON, or VTK_TRIANGLE_STRIP.  Make sure that
@@ -1187,7 +1235,7 @@ void vtkPolyData::ReverseCell(vtkIdType cellId)
 // use this method, make sure points are available and BuildLinks() has been invoked.)
 vtkIdType vtkPolyData::InsertNextLinkedPoint(int numLinks)
 {
-  return this->Links->InsertNextPoint(numLinks);
+  return this->GetEditableLinks()->InsertNextPoint(numLinks);
 }
 
 //------------------------------------------------------------------------------
@@ -1197,7 +1245,7 @@ vtkIdType vtkPolyData::InsertNextLinkedPoint(int numLinks)
 // and BuildLinks() has been invoked.)
 vtkIdType vtkPolyData::InsertNextLinkedPoint(double x[3], int numLinks)
 {
-  this->Links->InsertNextPoint(numLinks);
+  this->GetEditableLinks()->InsertNextPoint(numLinks);
   return this->Points->InsertNextPoint(x);
 }
 
@@ -1209,12 +1257,14 @@ vtkIdType vtkPolyData::InsertNextLinkedCell(int type, int npts, const vtkIdType
 {
   vtkIdType i, id;
 
+  // Get the links before the cell is inserted, in case they are rebuilt.
+  vtkCellLinks* links = this->GetEditableLinks();
   id = this->InsertNextCell(type, npts, pts);
 
   for (i = 0; i < npts; i++)
   {
-    this->Links->ResizeCellList(pts[i], 1);
-    this->Links->AddCellReference(id, pts[i]);
+    links->ResizeCellList(pts[i], 1);
+    links->AddCellReference(id, pts[i]);
   }
 
   return id;
@@ -1227,7 +1277,7 @@ vtkIdType vtkPolyData::InsertNextLinkedCell(int type, int npts, const vtkIdType
 // operator ResizeCellList() to do this if necessary.
 void vtkPolyData::RemoveReferenceToCell(vtkIdType ptId, vtkIdType cellId)
 {
-  this->Links->RemoveCellReference(cellId, ptId);
+  this->GetEditableLinks()->RemoveCellReference(cellId, ptId);
 }
 
 //------------------------------------------------------------------------------
@@ -1237,7 +1287,7 @@ void vtkPolyData::RemoveReferenceToCell(vtkIdType ptId, vtkIdType cellId)
 // operator ResizeCellList() to do this if necessary.
 void vtkPolyData::AddReferenceToCell(vtkIdType ptId, vtkIdType cellId)
 {
-  this->Links->AddCellReference(cellId, ptId);
+  this->GetEditableLinks()->AddCellReference(cellId, ptId);
 }
 
 //------------------------------------------------------------------------------
@@ -1272,10 +1322,12 @@ void vtkPolyData::ReplaceCell(vtkIdType cellId, int npts, const vtkIdType pts[])
 // link list is changing size.
 void vtkPolyData::ReplaceLinkedCell(vtkIdType cellId, int npts, const vtkIdType pts[])
 {
+  // Get the links before the cell is replaced, in case they are rebuilt.
+  vtkCellLinks* links = this->GetEditableLinks();
   this->ReplaceCell(cellId, npts, pts);
   for (int i = 0; i < npts; i++)
   {
-    this->Links->InsertNextCellReference(pts[i], cellId);
+    links->InsertNextCellReference(pts[i], cellId);
   }
 }
 
@@ -1288,14 +1340,13 @@ void vtkPolyData::GetCellEdgeNeighbors(
 {
   cellIds->Reset();
 
-  const vtkCellLinks::Link& link1(this->Links->GetLink(p1));
-  const vtkCellLinks::Link& link2(this->Links->GetLink(p2));
-
-  const vtkIdType* cells1 = link1.cells;
-  const vtkIdType* cells1End = cells1 + link1.ncells;
+  vtkIdType ncells1, ncells2;
+  vtkIdType *cells1, *cells2;
+  this->GetPointCells(p1, ncells1, cells1);
+  this->GetPointCells(p2, ncells2, cells2);
 
-  const vtkIdType* cells2 = link2.cells;
-  const vtkIdType* cells2End = cells2 + link2.ncells;
+  const vtkIdType* cells1End = cells1 + ncells1;
+  const vtkIdType* cells2End = cells2 + ncells2;
 
   while (cells1 != cells1End)
   {
@@ -1331,8 +1382,9 @@ void vtkPolyData::GetCellNeighbors(vtkIdType cellId, vtkIdList* ptIds, vtkIdList
 
   // load list with candidate cells, remove current cell
   vtkIdType ptId = ptIds->GetId(0);
-  int numPrime = this->Links->GetNcells(ptId);
-  vtkIdType* primeCells = this->Links->GetCells(ptId);
+  vtkIdType numPrime;
+  vtkIdType* primeCells;
+  this->GetPointCells(ptId, numPrime, primeCells);
   numPts = ptIds->GetNumberOfIds();
 
   // for each potential cell
@@ -1345,8 +1397,9 @@ void vtkPolyData::GetCellNeighbors(vtkIdType cellId, vtkIdList* ptIds, vtkIdList
       for (allFound = 1, i = 1; i < numPts && allFound; i++)
       {
         ptId = ptIds->GetId(i);
-        int numCurrent = this->Links->GetNcells(ptId);
-        vtkIdType* currentCells = this->Links->GetCells(ptId);
+        vtkIdType numCurrent;
+        vtkIdType* currentCells;
+        this->GetPointCells(ptId, numCurrent, currentCells);
         oneFound = 0;
         for (j = 0; j < numCurrent; j++)
         {
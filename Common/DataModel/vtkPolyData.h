@@ -346,12 +346,24 @@ public:
 
   /**
    * Create upward links from points to cells that use each point. Enables
-   * topologically complex queries. Normally the links array is allocated
-   * based on the number of points in the vtkPolyData. The optional
-   * initialSize parameter can be used to allocate a larger size initially.
+   * topologically complex queries. Unless the dataset is Editable, the links
+   * are a vtkStaticCellLinks built in parallel; otherwise they are a
+   * vtkCellLinks, which supports the editing methods below. These methods
+   * turn Editable on and rebuild static links as vtkCellLinks when they are
+   * first called, so set Editable before building the links to avoid building
+   * them twice. The vtkCellLinks array is normally allocated based on the
+   * number of points in the vtkPolyData, and the optional initialSize
+   * parameter can be used to allocate a larger size initially.
    */
   void BuildLinks(int initialSize = 0);
 
+  /**
+   * Get the links from points to cells, or nullptr if they have not been
+   * built. This is a vtkStaticCellLinks unless the dataset is Editable, in
+   * which case it is a vtkCellLinks.
+   */
+  vtkAbstractCellLinks* GetCellLinks();
+
   /**
    * Release data structure that allows random access of the cells. This must
    * be done before a 2nd call to BuildLinks(). DeleteCells implicitly deletes
@@ -673,7 +685,12 @@ protected:
   // supporting structures for more complex topological operations
   // built only when necessary
   vtkSmartPointer<CellMap> Cells;
-  vtkSmartPointer<vtkCellLinks> Links;
+  vtkSmartPointer<vtkAbstractCellLinks> Links;
+
+  // The editing methods need the per-point lists of vtkCellLinks. Return the
+  // links, after turning Editable on and rebuilding them as vtkCellLinks if
+  // they are missing or static.
+  vtkCellLinks* GetEditableLinks();
 
   vtkNew<vtkIdList> LegacyBuffer;
 
@@ -698,20 +715,6 @@ private:
   void operator=(const vtkPolyData&) = delete;
 };
 
-//------------------------------------------------------------------------------
-inline void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdType& ncells, vtkIdType*& cells)
-{
-  ncells = this->Links->GetNcells(ptId);
-  cells = this->Links->GetCells(ptId);
-}
-
-inline void vtkPolyData::GetPointCells(vtkIdType ptId, unsigned short& ncells, vtkIdType*& cells)
-{
-  VTK_LEGACY_BODY(vtkPolyData::GetPointCells, "VTK 9.0");
-  ncells = static_cast<unsigned short>(this->Links->GetNcells(ptId));
-  cells = this->Links->GetCells(ptId);
-}
-
 //------------------------------------------------------------------------------
 inline vtkIdType vtkPolyData::GetNumberOfCells()
 {
@@ -780,7 +783,7 @@ inline int vtkPolyData::IsPointUsedByCell(vtkIdType ptId, vtkIdType cellId)
 //------------------------------------------------------------------------------
 inline void vtkPolyData::DeletePoint(vtkIdType ptId)
 {
-  this->Links->DeletePoint(ptId);
+  this->GetEditableLinks()->DeletePoint(ptId);
 }
 
 //------------------------------------------------------------------------------
@@ -795,10 +798,11 @@ inline void vtkPolyData::RemoveCellReference(vtkIdType cellId)
   const vtkIdType* pts;
   vtkIdType npts;
 
+  vtkCellLinks* links = this->GetEditableLinks();
   this->GetCellPoints(cellId, npts, pts);
   for (vtkIdType i = 0; i < npts; i++)
   {
-    this->Links->RemoveCellReference(cellId, pts[i]);
+    links->RemoveCellReference(cellId, pts[i]);
   }
 }
 
@@ -808,17 +812,18 @@ inline void vtkPolyData::AddCellReference(vtkIdType cellId)
   const vtkIdType* pts;
   vtkIdType npts;
 
+  vtkCellLinks* links = this->GetEditableLinks();
   this->GetCellPoints(cellId, npts, pts);
   for (vtkIdType i = 0; i < npts; i++)
   {
-    this->Links->AddCellReference(cellId, pts[i]);
+    links->AddCellReference(cellId, pts[i]);
   }
 }
 
 //------------------------------------------------------------------------------
 inline void vtkPolyData::ResizeCellList(vtkIdType ptId, int size)
 {
-  this->Links->ResizeCellList(ptId, size);
+  this->GetEditableLinks()->ResizeCellList(ptId, size);
 }
 
 //------------------------------------------------------------------------------
@@ -16,6 +16,7 @@
 
 #include "vtkBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellScratchBuffer.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkIncrementalPointLocator.h"
@@ -23,6 +24,7 @@
 #include "vtkMath.h"
 #include "vtkMathUtilities.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPoints.h"
@@ -33,6 +35,30 @@
 
 #include <vector>
 
+//------------------------------------------------------------------------------
+// Special structures for building loops. This is a double-linked list.
+typedef struct _vtkPolyVertex
+{
+  int id;
+  double x[3];
+  double measure;
+  _vtkPolyVertex* next;
+  _vtkPolyVertex* previous;
+} vtkLocalPolyVertex;
+
+//------------------------------------------------------------------------------
+// Storage kept between calls, so that polygons reused in a loop over cells
+// triangulate and interpolate without allocating.
+class vtkPolygonScratch
+{
+public:
+  vtkCellScratchBuffer<vtkLocalPolyVertex> Vertices;
+  vtkCellScratchBuffer<double> Weights;
+  vtkCellScratchBuffer<double> Samples;
+  vtkCellScratchBuffer<double> MVC;
+  vtkNew<vtkPriorityQueue> VertexQueue;
+};
+
 vtkStandardNewMacro(vtkPolygon);
 
 //------------------------------------------------------------------------------
@@ -46,6 +72,7 @@ vtkPolygon::vtkPolygon()
   this->TriScalars = vtkDoubleArray::New();
   this->TriScalars->Allocate(3);
   this->Line = vtkLine::New();
+  this->Scratch = new vtkPolygonScratch;
   this->Tolerance = 0.0;
   this->SuccessfulTriangulation = 0;
   this->Normal[0] = this->Normal[1] = this->Normal[2] = 0.0;
@@ -60,6 +87,7 @@ vtkPolygon::~vtkPolygon()
   this->Quad->Delete();
   this->TriScalars->Delete();
   this->Line->Delete();
+  delete this->Scratch;
 }
 
 //------------------------------------------------------------------------------
@@ -468,8 +496,8 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
   }
 
   // create local array for storing point-to-vertex vectors and distances
-  std::vector<double> dist(numPts);
-  std::vector<double> uVec(3 * numPts);
+  double* dist = this->Scratch->MVC.Get(5 * numPts);
+  double* uVec = dist + numPts;
   static const double eps = 0.00000001;
   for (int i = 0; i < numPts; i++)
   {
@@ -482,7 +510,7 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
     uVec[3 * i + 2] = pt[2] - x[2];
 
     // distance
-    dist[i] = vtkMath::Norm(uVec.data() + 3 * i);
+    dist[i] = vtkMath::Norm(uVec + 3 * i);
 
     // handle special case when the point is really close to a vertex
     if (dist[i] < eps)
@@ -501,7 +529,7 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
   // To do consider the simplification of
   // tan(alpha/2) = (1-cos(alpha))/sin(alpha)
   //              = (d0*d1 - cross(u0, u1))/(2*dot(u0,u1))
-  std::vector<double> tanHalfTheta(numPts);
+  double* tanHalfTheta = uVec + 3 * numPts;
   for (int i = 0; i < numPts; i++)
   {
     int i1 = i + 1;
@@ -510,8 +538,8 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
       i1 = 0;
     }
 
-    double* u0 = uVec.data() + 3 * i;
-    double* u1 = uVec.data() + 3 * i1;
+    double* u0 = uVec + 3 * i;
+    double* u1 = uVec + 3 * i1;
 
     double l = sqrt(vtkMath::Distance2BetweenPoints(u0, u1));
     double theta = 2.0 * asin(l / 2.0);
@@ -1033,17 +1061,14 @@ int vtkPolygon::BoundedTriangulate(vtkIdList* outTris, double tolerance)
   double p[3][3];
 
   // For most polygons, there should be fewer than VTK_CELL_SIZE points. In
-  // the event that we have a huge polygon, dynamically allocate an
-  // appropriately sized array.
-  std::vector<double> area_dynamic;
+  // the event that we have a huge polygon, use the scratch storage.
   if (numPts - 2 <= VTK_CELL_SIZE)
   {
     area = &area_static[0];
   }
   else
   {
-    area_dynamic.resize(numPts - 2);
-    area = area_dynamic.data();
+    area = this->Scratch->Samples.Get(numPts - 2);
   }
 
   for (i = 0; i < numPts; i++)
@@ -1089,21 +1114,10 @@ int vtkPolygon::BoundedTriangulate(vtkIdList* outTris, double tolerance)
 }
 
 //------------------------------------------------------------------------------
-// Special structures for building loops. This is a double-linked list.
-typedef struct _vtkPolyVertex
-{
-  int id;
-  double x[3];
-  double measure;
-  _vtkPolyVertex* next;
-  _vtkPolyVertex* previous;
-} vtkLocalPolyVertex;
-
 class vtkPolyVertexList
 { // structure to support triangulation
 public:
-  vtkPolyVertexList(vtkIdList* ptIds, vtkPoints* pts, double tol2);
-  ~vtkPolyVertexList();
+  vtkPolyVertexList(vtkIdList* ptIds, vtkPoints* pts, double tol2, vtkPolygonScratch* scratch);
 
   int ComputeNormal();
   double ComputeMeasure(vtkLocalPolyVertex* vtx);
@@ -1120,11 +1134,12 @@ public:
 
 //------------------------------------------------------------------------------
 // tolerance is squared
-vtkPolyVertexList::vtkPolyVertexList(vtkIdList* ptIds, vtkPoints* pts, double tol2)
+vtkPolyVertexList::vtkPolyVertexList(
+  vtkIdList* ptIds, vtkPoints* pts, double tol2, vtkPolygonScratch* scratch)
 {
   int numVerts = ptIds->GetNumberOfIds();
   this->NumberOfVerts = numVerts;
-  this->Array = new vtkLocalPolyVertex[numVerts];
+  this->Array = scratch->Vertices.Get(numVerts);
   int i;
 
   // now load the data into the array
@@ -1172,12 +1187,6 @@ vtkPolyVertexList::vtkPolyVertexList(vtkIdList* ptIds, vtkPoints* pts, double to
   }
 }
 
-//------------------------------------------------------------------------------
-vtkPolyVertexList::~vtkPolyVertexList()
-{
-  delete[] this->Array;
-}
-
 //------------------------------------------------------------------------------
 // Remove the vertex from the polygon (forming a triangle with
 // its previous and next neighbors, and reinsert the neighbors
@@ -1384,7 +1393,8 @@ int vtkPolyVertexList::CanRemoveVertex(int id, double tolerance)
 // long as the polygon edges do not self intersect).
 int vtkPolygon::EarCutTriangulation()
 {
-  vtkPolyVertexList poly(this->PointIds, this->Points, this->Tolerance * this->Tolerance);
+  vtkPolyVertexList poly(
+    this->PointIds, this->Points, this->Tolerance * this->Tolerance, this->Scratch);
   vtkLocalPolyVertex* vtx;
   int i, id;
 
@@ -1399,8 +1409,8 @@ int vtkPolygon::EarCutTriangulation()
   // vertex. Place the structure into a priority queue (those
   // vertices with smallest angle are to be removed first).
   //
-  vtkPriorityQueue* VertexQueue = vtkPriorityQueue::New();
-  VertexQueue->Allocate(poly.NumberOfVerts);
+  vtkPriorityQueue* VertexQueue = this->Scratch->VertexQueue;
+  VertexQueue->Reset();
   for (i = 0, vtx = poly.Head; i < poly.NumberOfVerts; i++, vtx = vtx->next)
   {
     // concave (negative measure) vertices are not eligible for removal
@@ -1435,9 +1445,6 @@ int vtkPolygon::EarCutTriangulation()
     } // concave
   }   // while
 
-  // Clean up
-  VertexQueue->Delete();
-
   if (poly.NumberOfVerts > 2) // couldn't triangulate
   {
     return (this->SuccessfulTriangulation = 0);
@@ -1452,7 +1459,8 @@ int vtkPolygon::EarCutTriangulation()
 // starting at a user-defined seed value.
 int vtkPolygon::UnbiasedEarCutTriangulation(int seed)
 {
-  vtkPolyVertexList poly(this->PointIds, this->Points, this->Tolerance * this->Tolerance);
+  vtkPolyVertexList poly(
+    this->PointIds, this->Points, this->Tolerance * this->Tolerance, this->Scratch);
 
   // First compute the polygon normal the correct way
   //
@@ -1501,7 +1509,7 @@ int vtkPolygon::CellBoundary(int vtkNotUsed(subId), const double pcoords[3], vtk
   double p0[3], p10[3], l10, p20[3], l20, n[3];
 
   pts->Reset();
-  std::vector<double> weights(numPts);
+  double* weights = this->Scratch->Weights.Get(numPts);
 
   // determine global coordinates given parametric coordinates
   this->ParameterizePolygon(p0, p10, l10, p20, l20, n);
@@ -1512,7 +1520,7 @@ int vtkPolygon::CellBoundary(int vtkNotUsed(subId), const double pcoords[3], vtk
 
   // find edge with largest and next largest weight values. This will be
   // the closest edge.
-  this->InterpolateFunctions(x, weights.data());
+  this->InterpolateFunctions(x, weights);
   for (i = 0; i < numPts; i++)
   {
     if (weights[i] > largestWeight)
@@ -1660,8 +1668,8 @@ int vtkPolygon::IntersectWithLine(const double p1[3], const double p2[3], double
 
   // Evaluate position
   //
-  std::vector<double> weights(npts);
-  if (this->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights.data()) >= 0)
+  double* weights = this->Scratch->Weights.Get(npts);
+  if (this->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights) >= 0)
   {
     if (dist2 <= tol2)
     {
@@ -1753,8 +1761,8 @@ void vtkPolygon::Derivatives(
   }
 
   int numVerts = this->PointIds->GetNumberOfIds();
-  std::vector<double> weights(numVerts);
-  std::vector<double> sample(dim * 3);
+  double* weights = this->Scratch->Weights.Get(numVerts);
+  double* sample = this->Scratch->Samples.Get(dim * 3);
 
   // compute positions of three sample points
   for (i = 0; i < 3; i++)
@@ -1767,7 +1775,7 @@ void vtkPolygon::Derivatives(
   // for each sample point, sample data values
   for (idx = 0, k = 0; k < 3; k++) // loop over three sample points
   {
-    this->InterpolateFunctions(x[k], weights.data());
+    this->InterpolateFunctions(x[k], weights);
     for (j = 0; j < dim; j++, idx++) // over number of derivates requested
     {
       sample[idx] = 0.0;
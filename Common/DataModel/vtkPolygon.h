@@ -35,6 +35,7 @@ class vtkPoints;
 class vtkQuad;
 class vtkTriangle;
 class vtkIncrementalPointLocator;
+class vtkPolygonScratch;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkPolygon : public vtkCell
 {
@@ -244,6 +245,7 @@ protected:
   vtkQuad* Quad;
   vtkDoubleArray* TriScalars;
   vtkLine* Line;
+  vtkPolygonScratch* Scratch; // storage reused by the helpers
 
   // Parameter indicating whether to use Mean Value Coordinate algorithm
   // for interpolation. The parameter is false by default.
@@ -20,22 +20,27 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
+#include "vtkCellScratchBuffer.h"
 #include "vtkEdgeTable.h"
 #include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkMeanValueCoordinatesInterpolator.h"
+#include "vtkNew.h"
 #include "vtkOrderedTriangulator.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkQuad.h"
+#include "vtkSmartPointer.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkVector.h"
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <set>
@@ -49,10 +54,63 @@ vtkStandardNewMacro(vtkPolyhedron);
 
 // Special typedef
 typedef vector<vtkIdType> vtkIdVectorType;
-class vtkPointIdMap : public map<vtkIdType, vtkIdType>
+class vtkPointIdMap : public unordered_map<vtkIdType, vtkIdType>
 {
 };
 
+// Polyhedra with more faces than this use a cell locator to accelerate the
+// ray intersections of IsInside(). Below, looping over the faces is faster
+// than building it.
+static const vtkIdType VTK_MAX_FACES_WITHOUT_LOCATOR = 25;
+
+// The faces of a cell loaded from an unstructured grid are read from the
+// compressed sparse row faces of the grid. The grid arrays and the cell id
+// identify the cell, so that loading it again is detected without comparing
+// its points and faces.
+class vtkPolyhedronGridCell
+{
+public:
+  struct Key
+  {
+    const void* Grid = nullptr;
+    vtkIdType CellId = -1;
+    vtkMTimeType FacesMTime = 0;
+    vtkMTimeType PointsMTime = 0;
+    vtkMTimeType CellsMTime = 0;
+
+    bool operator==(const Key& other) const
+    {
+      return this->Grid == other.Grid && this->CellId == other.CellId &&
+        this->FacesMTime == other.FacesMTime && this->PointsMTime == other.PointsMTime &&
+        this->CellsMTime == other.CellsMTime;
+    }
+  };
+
+  // The faces of the grid, nullptr when the faces were given to
+  // SetFaces(vtkIdType*) and copied to GlobalFaces.
+  vtkSmartPointer<vtkCellArray> Faces;
+  vtkSmartPointer<vtkCellArray> FaceLocations;
+
+  Key Loaded;      // the cell given to the last SetFaces()
+  Key Initialized; // the cell of the last Initialize()
+
+  vtkNew<vtkIdList> FaceIds;    // the ids of the faces of the cell in Faces
+  vtkNew<vtkIdList> FacePoints; // the point ids of the last face read
+  bool GlobalFacesCopied = false;
+};
+
+// Storage kept between calls, so that a polyhedron called again on the cell it
+// holds triangulates and interpolates without allocating. Loading another cell
+// still allocates, to rebuild its edge and face tables, polydata and locator.
+class vtkPolyhedronScratch
+{
+public:
+  vtkCellScratchBuffer<double> Weights;
+  vtkCellScratchBuffer<double> Samples;
+  vtkCellScratchBuffer<double> MVC;
+  vtkNew<vtkOrderedTriangulator> Triangulator;
+};
+
 // an edge consists of two id's and their order
 // is *not* important. To that end special hash and
 // equals functions have been made
@@ -190,6 +248,8 @@ vtkPolyhedron::vtkPolyhedron()
   this->CellLocator = vtkCellLocator::New();
   this->CellIds = vtkIdList::New();
   this->Cell = vtkGenericCell::New();
+  this->GridCell = new vtkPolyhedronGridCell;
+  this->Scratch = new vtkPolyhedronScratch;
 }
 
 //------------------------------------------------------------------------------
@@ -212,6 +272,8 @@ vtkPolyhedron::~vtkPolyhedron()
   this->CellLocator->Delete();
   this->CellIds->Delete();
   this->Cell->Delete();
+  delete this->GridCell;
+  delete this->Scratch;
 }
 
 //------------------------------------------------------------------------------
@@ -250,8 +312,10 @@ void vtkPolyhedron::ConstructPolyData()
   this->Polys->AllocateExact(numCells, connSize);
   this->Polys->ImportLegacyFormat(this->Faces->GetPointer(1), this->Faces->GetNumberOfValues() - 1);
 
-  // Standard setup
+  // Standard setup. The points of the cell are loaded in place, so mark them
+  // modified for the polydata to recompute its bounds, which the locator uses.
   this->PolyData->Initialize();
+  this->Points->Modified();
   this->PolyData->SetPoints(this->Points);
   this->PolyData->SetPolys(this->Polys);
 
@@ -311,6 +375,20 @@ void vtkPolyhedron::ComputePositionFromParametricCoordinate(const double pc[3],
 // points, point ids, and faces have been loaded.
 void vtkPolyhedron::Initialize()
 {
+  // Filters often load the same cell of a grid several times in a row, e.g.
+  // when probing. The structures built for it are then still valid.
+  vtkPolyhedronGridCell* gridCell = this->GridCell;
+  if (gridCell->Loaded.Grid && gridCell->Loaded == gridCell->Initialized)
+  {
+    return;
+  }
+  gridCell->Initialized = gridCell->Loaded;
+  if (gridCell->Faces)
+  {
+    gridCell->FaceLocations->GetCellAtId(gridCell->Loaded.CellId, gridCell->FaceIds);
+    gridCell->GlobalFacesCopied = false;
+  }
+
   // Clear out any remaining memory.
   this->PointIdMap->clear();
 
@@ -318,6 +396,7 @@ void vtkPolyhedron::Initialize()
   // ids. This is a fancy way of saying that we have to be able to rapidly go
   // from a PointId[i] to the location i in the cell.
   vtkIdType i, id, numPointIds = this->PointIds->GetNumberOfIds();
+  this->PointIdMap->reserve(numPointIds);
   for (i = 0; i < numPointIds; ++i)
   {
     id = this->PointIds->GetId(i);
@@ -399,26 +478,25 @@ int vtkPolyhedron::GenerateEdges()
   }
 
   // check the number of faces and return if there aren't any
-  if (this->GlobalFaces->GetNumberOfTuples() == 0 || this->GlobalFaces->GetValue(0) <= 0)
+  vtkIdType nfaces = this->GetNumberOfGlobalFaces();
+  if (nfaces <= 0)
   {
     return 0;
   }
 
   // Loop over all faces, inserting edges into the table
-  vtkIdType* faces = this->GlobalFaces->GetPointer(0);
-  vtkIdType nfaces = faces[0];
-  vtkIdType* face = faces + 1;
+  const vtkIdType* face;
   vtkIdType fid, i, edge[2], npts, edgeFaces[2], edgeId;
   edgeFaces[1] = -1;
 
   this->EdgeTable->InitEdgeInsertion(this->Points->GetNumberOfPoints(), 1);
   for (fid = 0; fid < nfaces; ++fid)
   {
-    npts = face[0];
-    for (i = 1; i <= npts; ++i)
+    this->GetGlobalFace(fid, npts, face);
+    for (i = 0; i < npts; ++i)
     {
       edge[0] = (*this->PointIdMap)[face[i]];
-      edge[1] = (*this->PointIdMap)[(i != npts ? face[i + 1] : face[1])];
+      edge[1] = (*this->PointIdMap)[(i != npts - 1 ? face[i + 1] : face[0])];
       edgeFaces[0] = fid;
       if ((edgeId = this->EdgeTable->IsEdge(edge[0], edge[1])) == (-1))
       {
@@ -431,7 +509,6 @@ int vtkPolyhedron::GenerateEdges()
         this->EdgeFaces->SetComponent(edgeId, 1, fid);
       }
     }
-    face += face[0] + 1;
   } // for all faces
 
   // Okay all done
@@ -448,12 +525,40 @@ int vtkPolyhedron::GetNumberOfFaces()
     this->GenerateFaces();
   }
 
+  return static_cast<int>(this->GetNumberOfGlobalFaces());
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPolyhedron::GetNumberOfGlobalFaces()
+{
+  if (this->GridCell->Faces)
+  {
+    return this->GridCell->FaceIds->GetNumberOfIds();
+  }
+
   if (this->GlobalFaces->GetNumberOfTuples() == 0)
   {
     return 0;
   }
 
-  return static_cast<int>(this->GlobalFaces->GetValue(0));
+  return this->GlobalFaces->GetValue(0);
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedron::GetGlobalFace(vtkIdType faceId, vtkIdType& npts, const vtkIdType*& pts)
+{
+  vtkPolyhedronGridCell* gridCell = this->GridCell;
+  if (gridCell->Faces)
+  {
+    gridCell->Faces->GetCellAtId(gridCell->FaceIds->GetId(faceId), gridCell->FacePoints);
+    npts = gridCell->FacePoints->GetNumberOfIds();
+    pts = gridCell->FacePoints->GetPointer(0);
+    return;
+  }
+
+  const vtkIdType* face = this->GlobalFaces->GetPointer(this->FaceLocations->GetValue(faceId));
+  npts = face[0];
+  pts = face + 1;
 }
 
 //------------------------------------------------------------------------------
@@ -464,33 +569,44 @@ void vtkPolyhedron::GenerateFaces()
     return;
   }
 
-  if (this->GlobalFaces->GetNumberOfTuples() == 0)
+  vtkIdType nfaces = this->GetNumberOfGlobalFaces();
+  if (nfaces == 0)
   {
     return;
   }
 
+  // The canonical faces have the layout of the SetFaces() face stream.
+  vtkIdType fid, numValues = this->GlobalFaces->GetNumberOfTuples();
+  vtkPolyhedronGridCell* gridCell = this->GridCell;
+  if (gridCell->Faces)
+  {
+    numValues = 1 + nfaces;
+    for (fid = 0; fid < nfaces; ++fid)
+    {
+      numValues += gridCell->Faces->GetCellSize(gridCell->FaceIds->GetId(fid));
+    }
+  }
+
   // Basically we just run through the faces and change the global ids to the
-  // canonical ids using the PointIdMap.
-  this->Faces->SetNumberOfTuples(this->GlobalFaces->GetNumberOfTuples());
-  vtkIdType* gFaces = this->GlobalFaces->GetPointer(0);
+  // canonical ids using the PointIdMap, recording where each face starts.
+  this->Faces->SetNumberOfTuples(numValues);
+  this->FaceLocations->SetNumberOfValues(nfaces);
   vtkIdType* faces = this->Faces->GetPointer(0);
-  vtkIdType nfaces = gFaces[0];
   faces[0] = nfaces;
-  vtkIdType* gFace = gFaces + 1;
   vtkIdType* face = faces + 1;
-  vtkIdType fid, i, id, npts;
+  const vtkIdType* gFace;
+  vtkIdType i, npts;
 
   for (fid = 0; fid < nfaces; ++fid)
   {
-    npts = gFace[0];
+    this->GetGlobalFace(fid, npts, gFace);
+    this->FaceLocations->SetValue(fid, face - faces);
     face[0] = npts;
-    for (i = 1; i <= npts; ++i)
+    for (i = 0; i < npts; ++i)
     {
-      id = (*this->PointIdMap)[gFace[i]];
-      face[i] = id;
+      face[i + 1] = (*this->PointIdMap)[gFace[i]];
     }
-    gFace += gFace[0] + 1;
-    face += face[0] + 1;
+    face += npts + 1;
   } // for all faces
 
   // Okay we've done the deed
@@ -500,7 +616,7 @@ void vtkPolyhedron::GenerateFaces()
 //------------------------------------------------------------------------------
 vtkCell* vtkPolyhedron::GetFace(int faceId)
 {
-  if (faceId < 0 || faceId >= this->GlobalFaces->GetValue(0))
+  if (faceId < 0 || faceId >= this->GetNumberOfGlobalFaces())
   {
     return nullptr;
   }
@@ -508,17 +624,18 @@ vtkCell* vtkPolyhedron::GetFace(int faceId)
   this->GenerateFaces();
 
   // Okay load up the polygon
-  vtkIdType i, p, loc = this->FaceLocations->GetValue(faceId);
-  vtkIdType* face = this->GlobalFaces->GetPointer(loc);
+  vtkIdType i, p, npts;
+  const vtkIdType* face;
+  this->GetGlobalFace(faceId, npts, face);
 
-  this->Polygon->PointIds->SetNumberOfIds(face[0]);
-  this->Polygon->Points->SetNumberOfPoints(face[0]);
+  this->Polygon->PointIds->SetNumberOfIds(npts);
+  this->Polygon->Points->SetNumberOfPoints(npts);
 
   // grab faces in global id space
-  for (i = 0; i < face[0]; ++i)
+  for (i = 0; i < npts; ++i)
   {
-    this->Polygon->PointIds->SetId(i, face[i + 1]);
-    p = (*this->PointIdMap)[face[i + 1]];
+    this->Polygon->PointIds->SetId(i, face[i]);
+    p = (*this->PointIdMap)[face[i]];
     this->Polygon->Points->SetPoint(i, this->Points->GetPoint(p));
   }
 
@@ -532,39 +649,77 @@ void vtkPolyhedron::SetFaces(vtkIdType* faces)
   // Set up face structure
   this->GlobalFaces->Reset();
   this->FaceLocations->Reset();
+  this->GridCell->Faces = nullptr;
+  this->GridCell->FaceLocations = nullptr;
+  this->GridCell->Loaded = vtkPolyhedronGridCell::Key();
+  this->GridCell->Initialized = vtkPolyhedronGridCell::Key();
 
   if (!faces)
   {
     return;
   }
 
+  // Locate the faces, then copy the whole face stream at once.
   vtkIdType nfaces = faces[0];
   this->FaceLocations->SetNumberOfValues(nfaces);
-
-  this->GlobalFaces->InsertNextValue(nfaces);
-  vtkIdType* face = faces + 1;
   vtkIdType faceLoc = 1;
-  vtkIdType i, fid, npts;
-
-  for (fid = 0; fid < nfaces; ++fid)
+  for (vtkIdType fid = 0; fid < nfaces; ++fid)
   {
-    npts = face[0];
-    this->GlobalFaces->InsertNextValue(npts);
-    for (i = 1; i <= npts; ++i)
-    {
-      this->GlobalFaces->InsertNextValue(face[i]);
-    }
     this->FaceLocations->SetValue(fid, faceLoc);
+    faceLoc += faces[faceLoc] + 1;
+  }
 
-    faceLoc += face[0] + 1;
-    face = faces + faceLoc;
-  } // for all faces
+  this->GlobalFaces->SetNumberOfValues(faceLoc);
+  std::copy(faces, faces + faceLoc, this->GlobalFaces->GetPointer(0));
+}
+
+//------------------------------------------------------------------------------
+// Specify the faces for this cell from the faces of a grid.
+void vtkPolyhedron::SetFaces(vtkUnstructuredGrid* grid, vtkIdType cellId)
+{
+  vtkCellArray* faces = grid->GetPolyhedronFaces();
+  vtkCellArray* faceLocations = grid->GetPolyhedronFaceLocations();
+  if (!faces || cellId >= faceLocations->GetNumberOfCells())
+  {
+    this->SetFaces(nullptr);
+    return;
+  }
+
+  vtkPolyhedronGridCell* gridCell = this->GridCell;
+  gridCell->Faces = faces;
+  gridCell->FaceLocations = faceLocations;
+  gridCell->Loaded.Grid = grid;
+  gridCell->Loaded.CellId = cellId;
+  gridCell->Loaded.FacesMTime = faces->GetMTime();
+  gridCell->Loaded.PointsMTime = grid->GetPoints() ? grid->GetPoints()->GetMTime() : 0;
+  gridCell->Loaded.CellsMTime = grid->GetCells()->GetMTime();
 }
 
 //------------------------------------------------------------------------------
 // Return the list of faces for this cell.
 vtkIdType* vtkPolyhedron::GetFaces()
 {
+  // The faces read from a grid are copied to the face stream on demand.
+  vtkPolyhedronGridCell* gridCell = this->GridCell;
+  if (gridCell->Faces && !gridCell->GlobalFacesCopied)
+  {
+    const vtkIdType nfaces = this->GetNumberOfGlobalFaces();
+    this->GlobalFaces->Reset();
+    this->GlobalFaces->InsertNextValue(nfaces);
+    vtkIdType npts;
+    const vtkIdType* face;
+    for (vtkIdType fid = 0; fid < nfaces; ++fid)
+    {
+      this->GetGlobalFace(fid, npts, face);
+      this->GlobalFaces->InsertNextValue(npts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        this->GlobalFaces->InsertNextValue(face[i]);
+      }
+    }
+    gridCell->GlobalFacesCopied = true;
+  }
+
   if (!this->GlobalFaces->GetNumberOfTuples())
   {
     return nullptr;
@@ -668,7 +823,7 @@ int vtkPolyhedron::IsInside(const double x[3], double tolerance)
   // Otherwise brute force looping over cells is used.
   vtkIdType* faceArray = this->Faces->GetPointer(0);
   vtkIdType nfaces = *faceArray++;
-  if (nfaces > 25)
+  if (nfaces > VTK_MAX_FACES_WITHOUT_LOCATOR)
   {
     this->ConstructLocator();
   }
@@ -1107,8 +1262,8 @@ void vtkPolyhedron::Derivatives(
   this->ConstructPolyData();
   int numVerts = this->PolyData->GetNumberOfPoints();
 
-  double* weights = new double[numVerts];
-  double* sample = new double[dim * 4];
+  double* weights = this->Scratch->Weights.Get(numVerts);
+  double* sample = this->Scratch->Samples.Get(dim * 4);
   // for each sample point, sample data values
   for (idx = 0, k = 0; k < 4; k++) // loop over three sample points
   {
@@ -1149,9 +1304,6 @@ void vtkPolyhedron::Derivatives(
     derivs[3 * j + 1] = ddx * v1[1] + ddy * v2[1] + ddz * v3[1];
     derivs[3 * j + 2] = ddx * v1[2] + ddy * v2[2] + ddz * v3[2];
   }
-
-  delete[] weights;
-  delete[] sample;
 }
 
 //------------------------------------------------------------------------------
@@ -1172,8 +1324,12 @@ void vtkPolyhedron::InterpolateFunctions(const double x[3], double* sf)
   {
     return;
   }
+  vtkPoints* points = this->PolyData->GetPoints();
+  const vtkIdType scratchSize =
+    vtkMeanValueCoordinatesInterpolator::GetScratchSize(points, this->Polys);
+  double* scratch = this->Scratch->MVC.Get(scratchSize);
   vtkMeanValueCoordinatesInterpolator::ComputeInterpolationWeights(
-    x, this->PolyData->GetPoints(), this->Polys, sf);
+    x, points, this->Polys, sf, scratch);
 }
 
 //------------------------------------------------------------------------------
@@ -1197,8 +1353,7 @@ int vtkPolyhedron::Triangulate(int vtkNotUsed(index), vtkIdList* ptIds, vtkPoint
   this->ComputeBounds();
 
   // use ordered triangulator to triangulate the polyhedron.
-  vtkSmartPointer<vtkOrderedTriangulator> triangulator =
-    vtkSmartPointer<vtkOrderedTriangulator>::New();
+  vtkOrderedTriangulator* triangulator = this->Scratch->Triangulator;
 
   triangulator->InitTriangulation(this->Bounds, this->GetNumberOfPoints());
   triangulator->PreSortedOff();
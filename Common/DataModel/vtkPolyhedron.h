@@ -46,6 +46,8 @@ class vtkTetra;
 class vtkPolygon;
 class vtkLine;
 class vtkPointIdMap;
+class vtkPolyhedronGridCell;
+class vtkPolyhedronScratch;
 class vtkIdToIdVectorMapType;
 class vtkIdToIdMapType;
 class vtkEdgeTable;
@@ -53,6 +55,7 @@ class vtkPolyData;
 class vtkCellLocator;
 class vtkGenericCell;
 class vtkPointLocator;
+class vtkUnstructuredGrid;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkPolyhedron : public vtkCell3D
 {
@@ -274,6 +277,16 @@ public:
   vtkIdType* GetFaces() override;
   //@}
 
+  /**
+   * Specify the faces of the cell cellId of an unstructured grid. They are
+   * read from the compressed sparse row faces of the grid (see
+   * vtkUnstructuredGrid::GetPolyhedronFaces()) instead of being copied. The
+   * point ids and points of the cell are set separately, as GetCell() does.
+   * When the same cell of a grid whose points and cells have not been
+   * modified is loaded again, Initialize() keeps the structures built for it.
+   */
+  void SetFaces(vtkUnstructuredGrid* grid, vtkIdType cellId);
+
   /**
    * A method particular to vtkPolyhedron. It determines whether a point x[3]
    * is inside the polyhedron or not (returns 1 is the point is inside, 0
@@ -308,6 +321,12 @@ protected:
   vtkIdTypeArray* GlobalFaces; // these are numbered in global id space
   vtkIdTypeArray* FaceLocations;
 
+  // Access the faces in global id space, whether they were copied by
+  // SetFaces() or are read from a grid. The point ids of a face are valid
+  // until the next face is read.
+  vtkIdType GetNumberOfGlobalFaces();
+  void GetGlobalFace(vtkIdType faceId, vtkIdType& npts, const vtkIdType*& pts);
+
   // vtkCell has the data members Points (x,y,z coordinates) and PointIds
   // (global cell ids corresponding to cell canonical numbering (0,1,2,....)).
   // These data members are implicitly organized in canonical space, i.e., where
@@ -348,6 +367,13 @@ protected:
   vtkIdList* CellIds;
   vtkGenericCell* Cell;
 
+  // The grid and cell the faces are read from. When the same cell is loaded
+  // again, the structures built above are reused.
+  vtkPolyhedronGridCell* GridCell;
+
+  // Storage reused by the triangulation and interpolation helpers.
+  vtkPolyhedronScratch* Scratch;
+
 private:
   vtkPolyhedron(const vtkPolyhedron&) = delete;
   void operator=(const vtkPolyhedron&) = delete;
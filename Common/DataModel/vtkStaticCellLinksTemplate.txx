@@ -24,6 +24,7 @@
 #include "vtkPolyData.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 
@@ -151,8 +152,9 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkDataSet* ds)
   // Now build the links. The summation from the prefix sum indicates where
   // the cells are to be inserted. Each time a cell is inserted, the offset
   // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for (cellId = 0; cellId < this->NumCells; ++cellId)
+  // points to the beginning of each cell run. The cells are visited in
+  // reverse order so that each run is sorted in increasing order.
+  for (cellId = this->NumCells - 1; cellId >= 0; --cellId)
   {
     ds->GetCellPoints(cellId, cellPts);
     npts = cellPts->GetNumberOfIds();
@@ -204,8 +206,9 @@ struct BuildLinks
     // Now build the links. The summation from the prefix sum indicates where
     // the cells are to be inserted. Each time a cell is inserted, the offset
     // is decremented. In the end, the offset array is also constructed as it
-    // points to the beginning of each cell run.
-    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    // points to the beginning of each cell run. The cells are visited in
+    // reverse order so that each run is sorted in increasing order.
+    for (vtkIdType cellId = numCells - 1; cellId >= 0; --cellId)
     {
       const auto cell = state.GetCellRange(cellId);
       for (const ValueType cellPtId : cell)
@@ -317,19 +320,46 @@ struct InsertLinks
   std::atomic<TIds>* Counts;
   const TIds* Offsets;
   TIds* Links;
+  TIds IdOffset;
 
-  InsertLinks(vtkCellArray* cellArray, std::atomic<TIds>* counts, const TIds* offsets, TIds* links)
+  InsertLinks(vtkCellArray* cellArray, std::atomic<TIds>* counts, const TIds* offsets, TIds* links,
+    TIds idOffset = 0)
     : CellArray(cellArray)
     , Counts(counts)
     , Offsets(offsets)
     , Links(links)
+    , IdOffset(idOffset)
   {
   }
 
   void operator()(vtkIdType cellId, vtkIdType endCellId)
   {
     this->CellArray->Visit(vtkSCLT_detail::BuildLinksThreaded{}, this->Offsets, this->Counts,
-      this->Links, cellId, endCellId);
+      this->Links, cellId, endCellId, this->IdOffset);
+  }
+};
+
+// The threads insert the cells of a point in any order. Sort each run so
+// that the links do not depend on the number of threads, and match the order
+// of the serial build and of vtkCellLinks.
+template <typename TIds>
+struct SortLinks
+{
+  const TIds* Offsets;
+  TIds* Links;
+
+  SortLinks(const TIds* offsets, TIds* links)
+    : Offsets(offsets)
+    , Links(links)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      std::sort(this->Links + this->Offsets[ptId], this->Links + this->Offsets[ptId + 1]);
+    }
   }
 };
 
@@ -375,6 +405,9 @@ void vtkStaticCellLinksTemplate<TIds>::ThreadedBuildLinks(
   InsertLinks<TIds> insertLinks(cellArray, counts, this->Offsets, this->Links);
   vtkSMPTools::For(0, numCells, insertLinks);
 
+  SortLinks<TIds> sortLinks(this->Offsets, this->Links);
+  vtkSMPTools::For(0, numPts, sortLinks);
+
   // Clean up
   delete[] counts;
 }
@@ -457,18 +490,51 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkPolyData* pd)
   this->Links = new TIds[this->LinksSize + 1];
   this->Links[this->LinksSize] = this->NumPts;
   this->Offsets = new TIds[this->NumPts + 1];
-  this->Offsets[this->NumPts] = this->LinksSize;
-  std::fill_n(this->Offsets, this->NumPts + 1, 0);
 
   // Now create the links.
   vtkIdType npts, CellId, ptId;
 
+  if (!this->SequentialProcessing)
+  {
+    // Count the point uses of the four arrays in parallel.
+    std::atomic<TIds>* counts = new std::atomic<TIds>[this->NumPts] {};
+    for (j = 0; j < 4; ++j)
+    {
+      CountUses<TIds> count(cellArrays[j], counts);
+      vtkSMPTools::For(0, numCells[j], count);
+    }
+
+    // Perform prefix sum to determine offsets
+    this->Offsets[0] = 0;
+    for (ptId = 1; ptId < this->NumPts; ++ptId)
+    {
+      npts = counts[ptId - 1];
+      this->Offsets[ptId] = this->Offsets[ptId - 1] + npts;
+    }
+    this->Offsets[this->NumPts] = this->LinksSize;
+
+    // Insert the cell ids of the four arrays in parallel, then sort the runs.
+    for (CellId = 0, j = 0; j < 4; ++j)
+    {
+      InsertLinks<TIds> insertLinks(
+        cellArrays[j], counts, this->Offsets, this->Links, static_cast<TIds>(CellId));
+      vtkSMPTools::For(0, numCells[j], insertLinks);
+      CellId += numCells[j];
+    }
+    SortLinks<TIds> sortLinks(this->Offsets, this->Links);
+    vtkSMPTools::For(0, this->NumPts, sortLinks);
+
+    delete[] counts;
+    return;
+  }
+
+  std::fill_n(this->Offsets, this->NumPts + 1, 0);
+
   // Visit the four arrays
-  for (CellId = 0, j = 0; j < 4; ++j)
+  for (j = 0; j < 4; ++j)
   {
     // Count number of point uses
-    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j], CellId);
-    CellId += numCells[j];
+    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j]);
   } // for each of the four polydata cell arrays
 
   // Perform prefix sum (inclusive scan)
@@ -481,11 +547,12 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkPolyData* pd)
   // Now build the links. The summation from the prefix sum indicates where
   // the cells are to be inserted. Each time a cell is inserted, the offset
   // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for (CellId = 0, j = 0; j < 4; ++j)
+  // points to the beginning of each cell run. The arrays are visited in
+  // reverse order, like their cells, so that each run is sorted.
+  for (CellId = this->NumCells, j = 3; j >= 0; --j)
   {
+    CellId -= numCells[j];
     cellArrays[j]->Visit(vtkSCLT_detail::BuildLinks{}, this->Offsets, this->Links, CellId);
-    CellId += numCells[j];
   } // for each of the four polydata arrays
   this->Offsets[this->NumPts] = this->LinksSize;
 }
@@ -131,6 +131,13 @@ public:
   void FindClosestPoint(const double x[3], double closestPoint[3], vtkGenericCell* cell,
     vtkIdType& cellId, int& subId, double& dist2) override;
 
+  /**
+   * FindCell(), FindClosestPoint(), FindClosestPointWithinRadius() and
+   * IntersectWithLine() are thread safe when each thread passes its own
+   * vtkGenericCell, so the batched queries are run in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   /**
    * Return the closest point within a specified radius and the cell which is
    * closest to the point x. The closest point is somewhere on a cell, it
@@ -108,6 +108,12 @@ public:
    */
   vtkIdType FindClosestPoint(const double x[3]) override;
 
+  /**
+   * The queries of this locator are thread safe once it is built, so the
+   * batched queries are run in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   //@{
   /**
    * Given a position x and a radius r, return the id of the point closest to
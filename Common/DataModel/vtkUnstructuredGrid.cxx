@@ -79,6 +79,7 @@
 #include "vtkTriQuadraticHexahedron.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleStrip.h"
+#include "vtkTypeInt64Array.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGridCellIterator.h"
 #include "vtkVertex.h"
@@ -179,6 +180,10 @@ vtkUnstructuredGrid::vtkUnstructuredGrid()
   this->Information->Set(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS(), 0);
 
   this->DistinctCellTypesUpdateMTime = 0;
+  this->PolyhedronFacesUpdateMTime[0] = 0;
+  this->PolyhedronFacesUpdateMTime[1] = 0;
+  this->PolyhedronFacesUpdateSize[0] = 0;
+  this->PolyhedronFacesUpdateSize[1] = 0;
 
   this->AllocateExact(1024, 1024);
 }
@@ -965,7 +970,7 @@ vtkCell* vtkUnstructuredGrid::GetCell(vtkIdType cellId)
       {
         this->Polyhedron = vtkPolyhedron::New();
       }
-      this->Polyhedron->SetFaces(this->GetFaces(cellId));
+      this->Polyhedron->SetFaces(this, cellId);
       cell = this->Polyhedron;
       break;
 
@@ -1012,8 +1017,13 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell* cell)
   this->Connectivity->GetCellAtId(cellId, cell->PointIds);
   this->Points->GetPoints(cell->PointIds, cell->Points);
 
-  // Explicit face representation
-  if (cell->RequiresExplicitFaceRepresentation())
+  // Explicit face representation. Polyhedra read their faces from the
+  // compressed sparse row form instead of copying them.
+  if (cellType == VTK_POLYHEDRON)
+  {
+    static_cast<vtkPolyhedron*>(cell->GetRepresentativeCell())->SetFaces(this, cellId);
+  }
+  else if (cell->RequiresExplicitFaceRepresentation())
   {
     cell->SetFaces(this->GetFaces(cellId));
   }
@@ -1325,6 +1335,161 @@ vtkIdTypeArray* vtkUnstructuredGrid::GetFaceLocations()
   return this->FaceLocations;
 }
 
+//------------------------------------------------------------------------------
+// Support the compressed sparse row form of the polyhedron faces.
+namespace
+{ // anonymous
+
+// First pass: count the faces of each cell, and the point ids of its faces.
+struct CountPolyhedronFaces
+{
+  const vtkIdType* Faces;
+  const vtkIdType* FaceLocations;
+  vtkTypeInt64* NumberOfFaces;
+  vtkTypeInt64* NumberOfFaceIds;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType loc = this->FaceLocations[cellId];
+      vtkIdType nfaces = 0;
+      vtkIdType nids = 0;
+      if (loc >= 0)
+      {
+        const vtkIdType* face = this->Faces + loc;
+        nfaces = *face++;
+        for (vtkIdType i = 0; i < nfaces; ++i)
+        {
+          nids += face[0];
+          face += face[0] + 1;
+        }
+      }
+      this->NumberOfFaces[cellId] = nfaces;
+      this->NumberOfFaceIds[cellId] = nids;
+    }
+  }
+};
+
+// Second pass: copy the faces of each cell from the offsets computed by a
+// prefix sum of the counts.
+struct FillPolyhedronFaces
+{
+  const vtkIdType* Faces;
+  const vtkIdType* FaceLocations;
+  const vtkTypeInt64* CellOffsets;
+  const vtkTypeInt64* CellIdOffsets;
+  vtkTypeInt64* FaceOffsets;
+  vtkTypeInt64* FaceConnectivity;
+  vtkTypeInt64* FaceIds;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType loc = this->FaceLocations[cellId];
+      if (loc < 0)
+      {
+        continue;
+      }
+      const vtkIdType* face = this->Faces + loc;
+      const vtkIdType nfaces = *face++;
+      vtkTypeInt64 faceId = this->CellOffsets[cellId];
+      vtkTypeInt64 offset = this->CellIdOffsets[cellId];
+      for (vtkIdType i = 0; i < nfaces; ++i, ++faceId)
+      {
+        this->FaceIds[faceId] = faceId;
+        this->FaceOffsets[faceId] = offset;
+        std::copy(face + 1, face + 1 + face[0], this->FaceConnectivity + offset);
+        offset += face[0];
+        face += face[0] + 1;
+      }
+    }
+  }
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------------
+vtkCellArray* vtkUnstructuredGrid::GetPolyhedronFaces()
+{
+  this->BuildPolyhedronFaces();
+  return this->PolyhedronFaces;
+}
+
+//------------------------------------------------------------------------------
+vtkCellArray* vtkUnstructuredGrid::GetPolyhedronFaceLocations()
+{
+  this->BuildPolyhedronFaces();
+  return this->PolyhedronFaceLocations;
+}
+
+//------------------------------------------------------------------------------
+void vtkUnstructuredGrid::BuildPolyhedronFaces()
+{
+  if (!this->Faces || !this->FaceLocations)
+  {
+    this->PolyhedronFaces = nullptr;
+    this->PolyhedronFaceLocations = nullptr;
+    return;
+  }
+  if (this->PolyhedronFaces && this->PolyhedronFacesUpdateMTime[0] == this->Faces->GetMTime() &&
+    this->PolyhedronFacesUpdateMTime[1] == this->FaceLocations->GetMTime() &&
+    this->PolyhedronFacesUpdateSize[0] == this->Faces->GetNumberOfValues() &&
+    this->PolyhedronFacesUpdateSize[1] == this->FaceLocations->GetNumberOfValues())
+  {
+    return;
+  }
+
+  // The offsets of each cell in the two arrays are the prefix sums of the
+  // counts of faces and face point ids.
+  const vtkIdType numCells = this->FaceLocations->GetNumberOfValues();
+  vtkNew<vtkTypeInt64Array> cellOffsets;
+  vtkNew<vtkTypeInt64Array> cellIdOffsets;
+  cellOffsets->SetNumberOfValues(numCells + 1);
+  cellIdOffsets->SetNumberOfValues(numCells + 1);
+  vtkTypeInt64* numFaces = cellOffsets->GetPointer(0);
+  vtkTypeInt64* numFaceIds = cellIdOffsets->GetPointer(0);
+
+  CountPolyhedronFaces counter{ this->Faces->GetPointer(0), this->FaceLocations->GetPointer(0),
+    numFaces + 1, numFaceIds + 1 };
+  vtkSMPTools::For(0, numCells, counter);
+  numFaces[0] = 0;
+  numFaceIds[0] = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    numFaces[cellId + 1] += numFaces[cellId];
+    numFaceIds[cellId + 1] += numFaceIds[cellId];
+  }
+  const vtkIdType totalFaces = numFaces[numCells];
+  const vtkIdType totalFaceIds = numFaceIds[numCells];
+
+  vtkNew<vtkTypeInt64Array> faceOffsets;
+  vtkNew<vtkTypeInt64Array> faceConnectivity;
+  vtkNew<vtkTypeInt64Array> faceIds;
+  faceOffsets->SetNumberOfValues(totalFaces + 1);
+  faceConnectivity->SetNumberOfValues(totalFaceIds);
+  faceIds->SetNumberOfValues(totalFaces);
+  faceOffsets->SetValue(totalFaces, totalFaceIds);
+
+  FillPolyhedronFaces filler{ this->Faces->GetPointer(0), this->FaceLocations->GetPointer(0),
+    numFaces, numFaceIds, faceOffsets->GetPointer(0), faceConnectivity->GetPointer(0),
+    faceIds->GetPointer(0) };
+  vtkSMPTools::For(0, numCells, filler);
+
+  this->PolyhedronFaces = vtkSmartPointer<vtkCellArray>::New();
+  this->PolyhedronFaces->SetData(faceOffsets, faceConnectivity);
+  this->PolyhedronFaces->ConvertToSmallestStorage();
+  this->PolyhedronFaceLocations = vtkSmartPointer<vtkCellArray>::New();
+  this->PolyhedronFaceLocations->SetData(cellOffsets, faceIds);
+  this->PolyhedronFaceLocations->ConvertToSmallestStorage();
+
+  this->PolyhedronFacesUpdateMTime[0] = this->Faces->GetMTime();
+  this->PolyhedronFacesUpdateMTime[1] = this->FaceLocations->GetMTime();
+  this->PolyhedronFacesUpdateSize[0] = this->Faces->GetNumberOfValues();
+  this->PolyhedronFacesUpdateSize[1] = this->FaceLocations->GetNumberOfValues();
+}
+
 //------------------------------------------------------------------------------
 void vtkUnstructuredGrid::SetCells(int type, vtkCellArray* cells)
 {
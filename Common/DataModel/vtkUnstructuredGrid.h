@@ -381,6 +381,23 @@ public:
   vtkIdTypeArray* GetFaceLocations();
   //@}
 
+  //@{
+  /**
+   * Get the faces of the polyhedron cells in compressed sparse row form.
+   * Each cell of the PolyhedronFaces array is a face, given by its point
+   * ids, and each cell of the PolyhedronFaceLocations array lists the ids
+   * of the faces of the corresponding cell of the grid (none for the other
+   * types of cells). Both use 32-bit storage when the ids allow it. They are
+   * built in parallel from GetFaces() and GetFaceLocations() on first use and
+   * cached until these arrays change, so call one of these methods, or
+   * GetCell() on a polyhedron, before using them from several threads.
+   * GetCell() reads the faces of the polyhedra from them. Return nullptr if
+   * the grid has no explicit faces.
+   */
+  vtkCellArray* GetPolyhedronFaces();
+  vtkCellArray* GetPolyhedronFaceLocations();
+  //@}
+
   /**
    * Special function used by vtkUnstructuredGridReader.
    * By default vtkUnstructuredGrid does not contain face information, which is
@@ -566,6 +583,16 @@ protected:
   vtkSmartPointer<vtkIdTypeArray> Faces;
   vtkSmartPointer<vtkIdTypeArray> FaceLocations;
 
+  // The compressed sparse row form of the faces is built on demand. The
+  // modification times and sizes of the Faces and FaceLocations arrays it was
+  // built from are kept to know when it is out of date, since inserting cells
+  // does not modify these arrays.
+  vtkSmartPointer<vtkCellArray> PolyhedronFaces;
+  vtkSmartPointer<vtkCellArray> PolyhedronFaceLocations;
+  vtkMTimeType PolyhedronFacesUpdateMTime[2];
+  vtkIdType PolyhedronFacesUpdateSize[2];
+  void BuildPolyhedronFaces();
+
   // Legacy support -- stores the old-style cell array locations.
   vtkSmartPointer<vtkIdTypeArray> CellLocations;
 
@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompactCellArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the pipeline compacts the cell arrays an algorithm generates
+// when vtkCellArray::SetGlobalCompactStorage() is on, but leaves alone the
+// ones its output shares with its input.
+
+#include "vtkCellArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+// Shallow copies its input to its output.
+class PassCells : public vtkPassInputTypeAlgorithm
+{
+public:
+  static PassCells* New();
+  vtkTypeMacro(PassCells, vtkPassInputTypeAlgorithm);
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
+    vtkDataObject* output = vtkDataObject::GetData(outputVector);
+    output->ShallowCopy(input);
+    return 1;
+  }
+};
+vtkStandardNewMacro(PassCells);
+
+vtkSmartPointer<vtkCellArray> MakeCells()
+{
+  vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+  cells->Use64BitStorage();
+  cells->InsertNextCell({ 0, 1, 2, 3 });
+  cells->InsertNextCell({ 1, 2, 3, 4 });
+  return cells;
+}
+
+vtkSmartPointer<vtkPoints> MakePoints()
+{
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 1.0, 0.0);
+  points->InsertNextPoint(0.0, 0.0, 1.0);
+  points->InsertNextPoint(1.0, 1.0, 1.0);
+  return points;
+}
+
+// The cell arrays of the input must keep their 64-bit storage, and the
+// output must still share them.
+bool CheckPassThrough(vtkDataObject* input, vtkCellArray* cells)
+{
+  vtkNew<PassCells> pass;
+  pass->SetInputDataObject(input);
+  pass->Update();
+  if (!cells->IsStorage64Bit() || cells->GetNumberOfCells() != 2)
+  {
+    std::cerr << "The cells of the " << input->GetClassName() << " input were converted"
+              << std::endl;
+    return false;
+  }
+  vtkDataObject* output = pass->GetOutputDataObject(0);
+  if (vtkMultiBlockDataSet* blocks = vtkMultiBlockDataSet::SafeDownCast(output))
+  {
+    output = blocks->GetBlock(0);
+  }
+  vtkCellArray* outputCells = vtkPolyData::SafeDownCast(output)
+    ? vtkPolyData::SafeDownCast(output)->GetPolys()
+    : vtkUnstructuredGrid::SafeDownCast(output)->GetCells();
+  if (outputCells != cells)
+  {
+    std::cerr << "The output does not share the cells of the " << input->GetClassName()
+              << " input" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCompactCellArrays(int, char*[])
+{
+  vtkCellArray::SetGlobalCompactStorage(true);
+  int result = EXIT_SUCCESS;
+
+  // Generated cells are compacted.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+  if (sphere->GetOutput()->GetPolys()->IsStorage64Bit())
+  {
+    std::cerr << "The cells of the sphere were not compacted" << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(MakePoints());
+  vtkSmartPointer<vtkCellArray> polys = MakeCells();
+  polyData->SetPolys(polys);
+  if (!CheckPassThrough(polyData, polys))
+  {
+    result = EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(MakePoints());
+  vtkSmartPointer<vtkCellArray> tetras = MakeCells();
+  grid->SetCells(VTK_TETRA, tetras);
+  if (!CheckPassThrough(grid, tetras))
+  {
+    result = EXIT_FAILURE;
+  }
+
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  vtkNew<vtkPolyData> block;
+  block->SetPoints(MakePoints());
+  vtkSmartPointer<vtkCellArray> blockPolys = MakeCells();
+  block->SetPolys(blockPolys);
+  blocks->SetBlock(0, block);
+  if (!CheckPassThrough(blocks, blockPolys))
+  {
+    result = EXIT_FAILURE;
+  }
+
+  vtkCellArray::SetGlobalCompactStorage(false);
+  return result;
+}
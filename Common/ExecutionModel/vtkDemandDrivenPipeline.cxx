@@ -16,8 +16,11 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTypes.h"
@@ -34,11 +37,52 @@
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+#include "vtkUnstructuredGrid.h"
 
+#include <set>
 #include <vector>
 
 vtkStandardNewMacro(vtkDemandDrivenPipeline);
 
+//------------------------------------------------------------------------------
+// Collect the cell arrays of a polydata or unstructured grid, or of the blocks
+// of a composite dataset.
+static void vtkDemandDrivenPipelineGetCells(
+  vtkDataObject* dataObject, std::set<vtkCellArray*>& cells)
+{
+  if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(dataObject))
+  {
+    vtkCellArray* cellArrays[4] = { polyData->GetVerts(), polyData->GetLines(),
+      polyData->GetPolys(), polyData->GetStrips() };
+    for (vtkCellArray* cellArray : cellArrays)
+    {
+      if (cellArray)
+      {
+        cells.insert(cellArray);
+      }
+    }
+  }
+  else if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(dataObject))
+  {
+    if (grid->GetCells())
+    {
+      cells.insert(grid->GetCells());
+    }
+  }
+  else if (vtkCompositeDataSet* composite = vtkCompositeDataSet::SafeDownCast(dataObject))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(composite->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkDemandDrivenPipelineGetCells(iter->GetCurrentDataObject(), cells);
+    }
+  }
+}
+
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, DATA_NOT_GENERATED, Integer);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, RELEASE_DATA, Integer);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA, Request);
@@ -534,6 +578,41 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(
     this->Algorithm->UpdateProgress(1.0);
   }
 
+  // Compact the cell arrays of the generated outputs if requested. The data
+  // given to a trivial producer, and the cell arrays an output shares with an
+  // input, as pass-through filters do, belong to the caller or to upstream
+  // algorithms and are left untouched.
+  int i, j;
+  if (vtkCellArray::GetGlobalCompactStorage() && !vtkTrivialProducer::SafeDownCast(this->Algorithm))
+  {
+    std::set<vtkCellArray*> outputCells;
+    for (i = 0; i < outputs->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkInformation* outInfo = outputs->GetInformationObject(i);
+      vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      if (data && !outInfo->Get(DATA_NOT_GENERATED()))
+      {
+        vtkDemandDrivenPipelineGetCells(data, outputCells);
+      }
+    }
+    std::set<vtkCellArray*> inputCells;
+    for (i = 0; !outputCells.empty() && i < this->Algorithm->GetNumberOfInputPorts(); ++i)
+    {
+      for (j = 0; j < inInfoVec[i]->GetNumberOfInformationObjects(); ++j)
+      {
+        vtkInformation* inInfo = inInfoVec[i]->GetInformationObject(j);
+        vtkDemandDrivenPipelineGetCells(inInfo->Get(vtkDataObject::DATA_OBJECT()), inputCells);
+      }
+    }
+    for (vtkCellArray* cellArray : outputCells)
+    {
+      if (inputCells.find(cellArray) == inputCells.end())
+      {
+        cellArray->ConvertToSmallestStorage();
+      }
+    }
+  }
+
   // Tell observers the algorithm is done executing.
   this->Algorithm->InvokeEvent(vtkCommand::EndEvent, nullptr);
 
@@ -541,7 +620,6 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(
   this->MarkOutputsGenerated(request, inInfoVec, outputs);
 
   // Remove any not-generated mark.
-  int i, j;
   for (i = 0; i < outputs->GetNumberOfInformationObjects(); ++i)
   {
     vtkInformation* outInfo = outputs->GetInformationObject(i);
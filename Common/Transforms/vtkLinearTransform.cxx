@@ -209,12 +209,13 @@ void vtkLinearTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
 
   this->Update();
 
-  // operate directly on the memory to avoid GetPoint()/SetPoint() calls.
+  // operate directly on the memory to avoid GetPoint()/SetPoint() calls,
+  // unless the input points are not stored contiguously (e.g. implicit arrays).
   vtkDataArray* inArray = inPts->GetData();
   vtkDataArray* outArray = outPts->GetData();
-  int inType = inArray->GetDataType();
+  int inType = inArray->HasStandardMemoryLayout() ? inArray->GetDataType() : VTK_VOID;
   int outType = outArray->GetDataType();
-  void* inPtr = inArray->GetVoidPointer(0);
+  void* inPtr = inType != VTK_VOID ? inArray->GetVoidPointer(0) : nullptr;
   void* outPtr = outArray->WriteVoidPointer(3 * m, 3 * n);
 
   if (inType == VTK_FLOAT && outType == VTK_FLOAT)
@@ -0,0 +1,295 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourGridParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that contouring and cutting an unstructured grid of cells of mixed
+// dimensions in parallel gives the same output as the serial loops, whatever
+// the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourGrid.h"
+#include "vtkCutter.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphere.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+// Merges points as vtkMergePoints does, but is not a plain vtkMergePoints,
+// which makes the filters contour serially.
+class SerialMergePoints : public vtkMergePoints
+{
+public:
+  static SerialMergePoints* New();
+  vtkTypeMacro(SerialMergePoints, vtkMergePoints);
+};
+vtkStandardNewMacro(SerialMergePoints);
+
+// A grid of hexahedra interleaved with vertices, lines, pixels and
+// triangles, large enough to be contoured by several chunks.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int resolution)
+{
+  const int n = resolution + 1;
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Distance");
+  vtkNew<vtkDoubleArray> height;
+  height->SetName("Height");
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const double x[3] = { 0.5 * i, 0.5 * j, 0.5 * k };
+        points->InsertNextPoint(x);
+        const double c = 0.25 * resolution;
+        scalars->InsertNextValue(
+          (x[0] - c) * (x[0] - c) + (x[1] - c) * (x[1] - c) + (x[2] - c) * (x[2] - c));
+        height->InsertNextValue(x[2]);
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->GetPointData()->AddArray(height);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  auto id = [n](int i, int j, int k) { return static_cast<vtkIdType>((k * n + j) * n + i); };
+  for (int k = 0; k < resolution; ++k)
+  {
+    for (int j = 0; j < resolution; ++j)
+    {
+      for (int i = 0; i < resolution; ++i)
+      {
+        const int r = i + 2 * j + 3 * k;
+        if (r % 11 == 0)
+        {
+          const vtkIdType vertex[1] = { id(i, j, k) };
+          cellIds->InsertNextValue(grid->InsertNextCell(VTK_VERTEX, 1, vertex));
+        }
+        if (r % 5 == 0)
+        {
+          const vtkIdType line[2] = { id(i, j, k), id(i + 1, j + 1, k) };
+          cellIds->InsertNextValue(grid->InsertNextCell(VTK_LINE, 2, line));
+        }
+        if (r % 7 == 0)
+        {
+          const vtkIdType pixel[4] = { id(i, j, k), id(i + 1, j, k), id(i, j, k + 1),
+            id(i + 1, j, k + 1) };
+          cellIds->InsertNextValue(grid->InsertNextCell(VTK_PIXEL, 4, pixel));
+        }
+        if (r % 3 == 0)
+        {
+          const vtkIdType triangle[3] = { id(i, j, k), id(i, j + 1, k), id(i, j, k + 1) };
+          cellIds->InsertNextValue(grid->InsertNextCell(VTK_TRIANGLE, 3, triangle));
+        }
+        const vtkIdType hexahedron[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        cellIds->InsertNextValue(grid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedron));
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+bool SameCells(vtkCellArray* cells, vtkCellArray* expected, const char* name)
+{
+  vtkNew<vtkIdTypeArray> connectivity, expectedConnectivity;
+  cells->ExportLegacyFormat(connectivity);
+  expected->ExportLegacyFormat(expectedConnectivity);
+  if (connectivity->GetNumberOfValues() != expectedConnectivity->GetNumberOfValues())
+  {
+    std::cerr << "Wrong number of " << name << ": " << cells->GetNumberOfCells() << " instead of "
+              << expected->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < connectivity->GetNumberOfValues(); ++i)
+  {
+    if (connectivity->GetValue(i) != expectedConnectivity->GetValue(i))
+    {
+      std::cerr << "The " << name << " differ" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameArrays(vtkFieldData* data, vtkFieldData* expected, const char* name)
+{
+  if (data->GetNumberOfArrays() != expected->GetNumberOfArrays())
+  {
+    std::cerr << "Wrong number of " << name << " arrays" << std::endl;
+    return false;
+  }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(a);
+    // The cut scalars have no name: compare the arrays in order.
+    vtkDataArray* array = data->GetArray(a);
+    if (!array || array->GetDataType() != expectedArray->GetDataType() ||
+      array->GetNumberOfTuples() != expectedArray->GetNumberOfTuples())
+    {
+      std::cerr << "Wrong " << name << " array " << a << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+    {
+      if (array->GetTuple1(i) != expectedArray->GetTuple1(i))
+      {
+        std::cerr << "The " << name << " array " << a << " differs at " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong number of points: " << output->GetNumberOfPoints() << " instead of "
+              << expected->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  if (output->GetPoints()->GetDataType() != expected->GetPoints()->GetDataType())
+  {
+    std::cerr << "Wrong point type" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    const double* x = output->GetPoint(i);
+    const double* y = expected->GetPoint(i);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  return SameCells(output->GetVerts(), expected->GetVerts(), "verts") &&
+    SameCells(output->GetLines(), expected->GetLines(), "lines") &&
+    SameCells(output->GetPolys(), expected->GetPolys(), "polys") &&
+    SameArrays(output->GetPointData(), expected->GetPointData(), "point data") &&
+    SameArrays(output->GetCellData(), expected->GetCellData(), "cell data");
+}
+
+// The verts come from the lines, the lines from the pixels and the
+// triangles: each output cell must have the cell data of an input cell of
+// the matching dimension.
+bool CheckCellData(vtkPolyData* output, vtkUnstructuredGrid* grid)
+{
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  const vtkIdType numVerts = output->GetNumberOfVerts();
+  const vtkIdType numLines = output->GetNumberOfLines();
+  if (numVerts == 0 || numLines == 0 || output->GetNumberOfPolys() == 0)
+  {
+    std::cerr << "Missing output cells" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < cellIds->GetNumberOfTuples(); ++i)
+  {
+    const int cellType = grid->GetCellType(static_cast<vtkIdType>(cellIds->GetTuple1(i)));
+    const bool valid = i < numVerts
+      ? cellType == VTK_LINE
+      : (i < numVerts + numLines ? cellType == VTK_PIXEL || cellType == VTK_TRIANGLE
+                                 : cellType == VTK_HEXAHEDRON);
+    if (!valid)
+    {
+      std::cerr << "Output cell " << i << " has the cell data of a cell of type " << cellType
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestContourGridParallel(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(24);
+
+  vtkNew<vtkContourGrid> serialContour;
+  serialContour->SetInputData(grid);
+  serialContour->SetValue(0, 9.3);
+  serialContour->SetValue(1, 20.1);
+  vtkNew<SerialMergePoints> contourLocator;
+  serialContour->SetLocator(contourLocator);
+  serialContour->Update();
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(3.0, 3.0, 3.0);
+  sphere->SetRadius(4.1);
+  vtkNew<vtkCutter> serialCutter;
+  serialCutter->SetInputData(grid);
+  serialCutter->SetCutFunction(sphere);
+  serialCutter->GenerateCutScalarsOn();
+  vtkNew<SerialMergePoints> cutterLocator;
+  serialCutter->SetLocator(cutterLocator);
+  serialCutter->Update();
+
+  if (!CheckCellData(serialContour->GetOutput(), grid) ||
+    !CheckCellData(serialCutter->GetOutput(), grid))
+  {
+    return EXIT_FAILURE;
+  }
+
+  const int numThreads[3] = { 1, 2, 4 };
+  for (int n : numThreads)
+  {
+    vtkSMPTools::Initialize(n);
+
+    vtkNew<vtkContourGrid> contour;
+    contour->SetInputData(grid);
+    contour->SetValue(0, 9.3);
+    contour->SetValue(1, 20.1);
+    contour->Update();
+    if (!SameOutput(contour->GetOutput(), serialContour->GetOutput()))
+    {
+      std::cerr << "vtkContourGrid differs from the serial output with " << n << " threads"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkNew<vtkCutter> cutter;
+    cutter->SetInputData(grid);
+    cutter->SetCutFunction(sphere);
+    cutter->GenerateCutScalarsOn();
+    cutter->Update();
+    if (!SameOutput(cutter->GetOutput(), serialCutter->GetOutput()))
+    {
+      std::cerr << "vtkCutter differs from the serial output with " << n << " threads"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormalsThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkPolyDataNormals splits the points along feature edges as the
+// sequential algorithm does, and gives the same output whatever the number
+// of threads.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkCubeSource.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkTriangleFilter.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> ComputeNormals(vtkPolyData* input, double featureAngle)
+{
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(input);
+  normals->SetFeatureAngle(featureAngle);
+  normals->ComputeCellNormalsOn();
+  normals->Update();
+  return normals->GetOutput();
+}
+
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong number of points: " << output->GetNumberOfPoints() << " instead of "
+              << expected->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    const double* x = output->GetPoint(i);
+    const double* y = expected->GetPoint(i);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> polys, expectedPolys;
+  output->GetPolys()->ExportLegacyFormat(polys);
+  expected->GetPolys()->ExportLegacyFormat(expectedPolys);
+  if (polys->GetNumberOfValues() != expectedPolys->GetNumberOfValues())
+  {
+    std::cerr << "Wrong number of polygons" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < polys->GetNumberOfValues(); ++i)
+  {
+    if (polys->GetValue(i) != expectedPolys->GetValue(i))
+    {
+      std::cerr << "The polygons differ" << std::endl;
+      return false;
+    }
+  }
+
+  vtkDataArray* arrays[2] = { output->GetPointData()->GetNormals(),
+    output->GetCellData()->GetNormals() };
+  vtkDataArray* expectedArrays[2] = { expected->GetPointData()->GetNormals(),
+    expected->GetCellData()->GetNormals() };
+  for (int a = 0; a < 2; ++a)
+  {
+    if (arrays[a]->GetNumberOfTuples() != expectedArrays[a]->GetNumberOfTuples())
+    {
+      std::cerr << "Wrong number of normals" << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < arrays[a]->GetNumberOfTuples(); ++i)
+    {
+      const double* n = arrays[a]->GetTuple3(i);
+      const double* m = expectedArrays[a]->GetTuple3(i);
+      if (n[0] != m[0] || n[1] != m[1] || n[2] != m[2])
+      {
+        std::cerr << (a == 0 ? "Point" : "Cell") << " normal " << i << " differs" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Every corner of a cube is shared by three faces and must be split in three
+// points, each one with the normal of its face.
+bool CheckCube(vtkPolyData* cube)
+{
+  vtkSmartPointer<vtkPolyData> output = ComputeNormals(cube, 30.0);
+  if (output->GetNumberOfPoints() != 24)
+  {
+    std::cerr << "The cube has " << output->GetNumberOfPoints() << " points instead of 24"
+              << std::endl;
+    return false;
+  }
+  vtkDataArray* pointNormals = output->GetPointData()->GetNormals();
+  vtkDataArray* cellNormals = output->GetCellData()->GetNormals();
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType cellId = 0;
+  for (output->GetPolys()->InitTraversal(); output->GetPolys()->GetNextCell(npts, pts); ++cellId)
+  {
+    const double* n = cellNormals->GetTuple3(cellId);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const double* m = pointNormals->GetTuple3(pts[i]);
+      if (std::abs(n[0] - m[0]) > 1e-6 || std::abs(n[1] - m[1]) > 1e-6 ||
+        std::abs(n[2] - m[2]) > 1e-6)
+      {
+        std::cerr << "Point " << pts[i] << " of the cube is not split" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPolyDataNormalsThreads(int, char*[])
+{
+  vtkNew<vtkCubeSource> cubeSource;
+  vtkNew<vtkTriangleFilter> cubeTriangles;
+  cubeTriangles->SetInputConnection(cubeSource->GetOutputPort());
+  vtkNew<vtkCleanPolyData> cube;
+  cube->SetInputConnection(cubeTriangles->GetOutputPort());
+  cube->Update();
+  if (!CheckCube(cube->GetOutput()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The poles of a sphere of high resolution are used by many cells, and a
+  // small feature angle splits many points. Strips are decomposed first.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(1000);
+  sphere->SetPhiResolution(40);
+  vtkNew<vtkSphereSource> stripSphere;
+  stripSphere->SetCenter(3.0, 0.0, 0.0);
+  stripSphere->SetThetaResolution(30);
+  stripSphere->SetPhiResolution(30);
+  vtkNew<vtkStripper> strips;
+  strips->SetInputConnection(stripSphere->GetOutputPort());
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputConnection(sphere->GetOutputPort());
+  append->AddInputConnection(strips->GetOutputPort());
+  append->AddInputConnection(cube->GetOutputPort());
+  append->Update();
+
+  const double featureAngles[2] = { 5.0, 30.0 };
+  for (double featureAngle : featureAngles)
+  {
+    vtkSMPTools::Initialize(1);
+    vtkSmartPointer<vtkPolyData> expected = ComputeNormals(append->GetOutput(), featureAngle);
+    const int numThreads[2] = { 2, 4 };
+    for (int n : numThreads)
+    {
+      vtkSMPTools::Initialize(n);
+      vtkSmartPointer<vtkPolyData> output = ComputeNormals(append->GetOutput(), featureAngle);
+      if (!SameOutput(output, expected))
+      {
+        std::cerr << "The output with " << n << " threads and a feature angle of "
+                  << featureAngle << " differs from the one with 1 thread" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
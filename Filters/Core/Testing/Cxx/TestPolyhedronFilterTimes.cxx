@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyhedronFilterTimes.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Times vtkContourGrid and vtkProbeFilter on meshes of polyhedra of
+// increasing size, and checks their results against the linear field the
+// meshes carry.
+
+#include <vtkContourGrid.h>
+#include <vtkDataArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkProbeFilter.h>
+#include <vtkTimerLog.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+double Field(const double x[3])
+{
+  return x[0] + 2.0 * x[1] + 3.0 * x[2];
+}
+
+// A block of n^3 unit cubes, each one a polyhedron with six quadrilateral
+// faces, carrying the linear field above.
+void MakePolyhedra(int n, vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("field");
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        const double x[3] = { static_cast<double>(i), static_cast<double>(j),
+          static_cast<double>(k) };
+        points->InsertNextPoint(x);
+        scalars->InsertNextValue(Field(x));
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+
+  const vtkIdType di = 1, dj = n + 1, dk = (n + 1) * (n + 1);
+  grid->Allocate(n * n * n);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType p = i * di + j * dj + k * dk;
+        const vtkIdType pts[8] = { p, p + di, p + di + dj, p + dj, p + dk, p + di + dk,
+          p + di + dj + dk, p + dj + dk };
+        const vtkIdType faces[30] = { 4, pts[0], pts[3], pts[2], pts[1], 4, pts[4], pts[5],
+          pts[6], pts[7], 4, pts[0], pts[1], pts[5], pts[4], 4, pts[2], pts[3], pts[7], pts[6],
+          4, pts[0], pts[4], pts[7], pts[3], 4, pts[1], pts[2], pts[6], pts[5] };
+        grid->InsertNextCell(VTK_POLYHEDRON, 8, pts, 6, faces);
+      }
+    }
+  }
+}
+
+// Every point of the contours must lie on one of the isosurfaces, up to the
+// precision of the float points of the output.
+int TimeContour(vtkUnstructuredGrid* grid, int n, double& time)
+{
+  vtkNew<vtkContourGrid> contour;
+  contour->SetInputData(grid);
+  // The values avoid the points of the mesh.
+  const int numValues = 5;
+  for (int i = 0; i < numValues; ++i)
+  {
+    contour->SetValue(i, 6.0 * n * (i + 0.5) / numValues + 0.25);
+  }
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  contour->Update();
+  timer->StopTimer();
+  time = timer->GetElapsedTime();
+
+  vtkPolyData* output = contour->GetOutput();
+  if (output->GetNumberOfCells() == 0)
+  {
+    std::cerr << "Empty contour of " << grid->GetNumberOfCells() << " polyhedra" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    bool onContour = false;
+    for (int i = 0; i < numValues && !onContour; ++i)
+    {
+      onContour = std::abs(Field(x) - contour->GetValue(i)) < 1e-4;
+    }
+    if (!onContour)
+    {
+      std::cerr << "Contour point " << ptId << " is not on an isosurface" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Probe the mesh at the points of an image inside it. Mean value coordinates
+// interpolate linear fields exactly.
+int TimeProbe(vtkUnstructuredGrid* grid, int n, double& time)
+{
+  vtkNew<vtkImageData> image;
+  const int dim = 2 * n;
+  image->SetDimensions(dim, dim, dim);
+  image->SetOrigin(0.01, 0.01, 0.01);
+  const double spacing = (n - 0.02) / (dim - 1);
+  image->SetSpacing(spacing, spacing, spacing);
+
+  vtkNew<vtkProbeFilter> probe;
+  probe->SetInputData(image);
+  probe->SetSourceData(grid);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  probe->Update();
+  timer->StopTimer();
+  time = timer->GetElapsedTime();
+
+  vtkDataSet* output = probe->GetOutput();
+  vtkDataArray* values = output->GetPointData()->GetArray("field");
+  if (!values || probe->GetValidPoints()->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    std::cerr << "Points of the image were not found in the polyhedra" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    if (std::abs(values->GetTuple1(ptId) - Field(x)) > 1e-6)
+    {
+      std::cerr << "Wrong probed value at point " << ptId << ": " << values->GetTuple1(ptId)
+                << " instead of " << Field(x) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestPolyhedronFilterTimes(int, char*[])
+{
+  // The times are only reported.
+  const int sizes[] = { 10, 20, 30 };
+  for (int n : sizes)
+  {
+    vtkNew<vtkUnstructuredGrid> grid;
+    MakePolyhedra(n, grid);
+    double contourTime, probeTime;
+    if (TimeContour(grid, n, contourTime) != EXIT_SUCCESS ||
+      TimeProbe(grid, n, probeTime) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+    std::cout << grid->GetNumberOfCells() << " polyhedra: vtkContourGrid " << contourTime
+              << " s, vtkProbeFilter " << probeTime << " s" << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,215 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the parallel edge collapses of vtkQuadricDecimation with the
+// sequential ones: reduction, validity of the triangles, Hausdorff distance
+// to the input surface, and reproducibility.
+
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkHausdorffDistancePointSetFilter.h>
+#include <vtkNew.h>
+#include <vtkPlaneSource.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkQuadricDecimation.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkTimerLog.h>
+#include <vtkTriangleFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Hausdorff distance between the input and the decimated surface.
+double ComputeDistance(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkNew<vtkHausdorffDistancePointSetFilter> distance;
+  distance->SetInputData(0, input);
+  distance->SetInputData(1, output);
+  distance->SetTargetDistanceMethodToPointToCell();
+  distance->Update();
+  return distance->GetHausdorffDistance();
+}
+
+bool HasValidTriangles(vtkPolyData* output)
+{
+  const vtkIdType numPts = output->GetNumberOfPoints();
+  auto iter = vtk::TakeSmartPointer(output->GetPolys()->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    if (npts != 3 || pts[0] == pts[1] || pts[1] == pts[2] || pts[0] == pts[2] ||
+      *std::min_element(pts, pts + 3) < 0 || *std::max_element(pts, pts + 3) >= numPts)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsSame(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetPolys()->GetNumberOfConnectivityIds() != b->GetPolys()->GetNumberOfConnectivityIds())
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double xa[3], xb[3];
+    a->GetPoint(ptId, xa);
+    b->GetPoint(ptId, xb);
+    if (xa[0] != xb[0] || xa[1] != xb[1] || xa[2] != xb[2])
+    {
+      return false;
+    }
+  }
+  vtkDataArray* connA = a->GetPolys()->GetConnectivityArray();
+  vtkDataArray* connB = b->GetPolys()->GetConnectivityArray();
+  for (vtkIdType i = 0; i < connA->GetNumberOfValues(); ++i)
+  {
+    if (connA->GetTuple1(i) != connB->GetTuple1(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+int TestSurface(const char* name, vtkPolyData* surface)
+{
+  int status = EXIT_SUCCESS;
+  for (double targetReduction : { 0.5, 0.9 })
+  {
+    vtkNew<vtkTimerLog> timer;
+    vtkNew<vtkQuadricDecimation> serial;
+    serial->SetInputData(surface);
+    serial->SetTargetReduction(targetReduction);
+    timer->StartTimer();
+    serial->Update();
+    timer->StopTimer();
+    const double serialTime = timer->GetElapsedTime();
+
+    vtkNew<vtkQuadricDecimation> parallel;
+    parallel->SetInputData(surface);
+    parallel->SetTargetReduction(targetReduction);
+    parallel->ParallelCollapsesOn();
+    timer->StartTimer();
+    parallel->Update();
+    timer->StopTimer();
+    const double parallelTime = timer->GetElapsedTime();
+
+    const double serialDistance = ComputeDistance(surface, serial->GetOutput());
+    const double parallelDistance = ComputeDistance(surface, parallel->GetOutput());
+    std::cout << name << " target " << targetReduction << ": sequential "
+              << serial->GetOutput()->GetNumberOfPolys() << " triangles, distance "
+              << serialDistance << ", " << serialTime << " s; parallel "
+              << parallel->GetOutput()->GetNumberOfPolys() << " triangles, distance "
+              << parallelDistance << ", " << parallelTime << " s" << std::endl;
+
+    if (std::abs(parallel->GetActualReduction() - targetReduction) > 0.01)
+    {
+      std::cerr << "Parallel reduction " << parallel->GetActualReduction() << " instead of "
+                << targetReduction << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (!HasValidTriangles(parallel->GetOutput()))
+    {
+      std::cerr << "Parallel decimation generated invalid triangles" << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (parallelDistance > 2.0 * serialDistance + 1e-6)
+    {
+      std::cerr << "Parallel decimation is too far from the input: " << parallelDistance
+                << " vs " << serialDistance << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    vtkNew<vtkQuadricDecimation> again;
+    again->SetInputData(surface);
+    again->SetTargetReduction(targetReduction);
+    again->ParallelCollapsesOn();
+    again->Update();
+    if (!IsSame(parallel->GetOutput(), again->GetOutput()))
+    {
+      std::cerr << "Parallel decimation is not reproducible" << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  // Volume preservation is only implemented by the sequential collapses.
+  vtkNew<vtkQuadricDecimation> serial;
+  serial->SetInputData(surface);
+  serial->SetTargetReduction(0.5);
+  serial->VolumePreservationOn();
+  serial->Update();
+  vtkNew<vtkQuadricDecimation> parallel;
+  parallel->SetInputData(surface);
+  parallel->SetTargetReduction(0.5);
+  parallel->VolumePreservationOn();
+  parallel->ParallelCollapsesOn();
+  parallel->Update();
+  if (!IsSame(serial->GetOutput(), parallel->GetOutput()))
+  {
+    std::cerr << "Volume preservation should use the sequential collapses" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  return status;
+}
+}
+
+int TestQuadricDecimation(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(100);
+  sphere->Update();
+  if (TestSurface("sphere", sphere->GetOutput()) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // an open surface, to exercise the boundary constraints
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(100, 100);
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(plane->GetOutputPort());
+  triangles->Update();
+  vtkSmartPointer<vtkPolyData> wave = triangles->GetOutput();
+  vtkNew<vtkPoints> wavePoints;
+  wavePoints->SetDataTypeToDouble();
+  wavePoints->SetNumberOfPoints(wave->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < wave->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    wave->GetPoint(ptId, x);
+    x[2] = 0.1 * std::sin(6.0 * x[0]) * std::cos(4.0 * x[1]);
+    wavePoints->SetPoint(ptId, x);
+  }
+  wave->SetPoints(wavePoints);
+  if (TestSurface("wave", wave) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCleanPolyData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkStaticCleanPolyData keeps the type and values of the cell
+// data, including arrays that are not data arrays, in the order of the
+// output cells.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCleanPolyData.h"
+#include "vtkStringArray.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+int CheckCellData(vtkPolyData* output, const vtkIdType* expectedIds, vtkIdType numCells)
+{
+  vtkIntArray* ints = vtkIntArray::SafeDownCast(output->GetCellData()->GetArray("ints"));
+  vtkDoubleArray* doubles =
+    vtkDoubleArray::SafeDownCast(output->GetCellData()->GetArray("doubles"));
+  vtkStringArray* strings =
+    vtkStringArray::SafeDownCast(output->GetCellData()->GetAbstractArray("strings"));
+  if (!ints || !doubles || (strings == nullptr) != (numCells == 0))
+  {
+    std::cerr << "Missing cell data array or wrong type" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (output->GetNumberOfCells() != 4 || ints->GetNumberOfTuples() != 4 ||
+    doubles->GetNumberOfTuples() != 4 || (strings && strings->GetNumberOfTuples() != numCells))
+  {
+    std::cerr << "Wrong number of cells or cell data tuples" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType cellId = 0; cellId < 4; ++cellId)
+  {
+    const vtkIdType inCellId = expectedIds[cellId];
+    if (ints->GetValue(cellId) != 16777217 + inCellId ||
+      doubles->GetValue(cellId) != 0.5 + inCellId ||
+      (strings && strings->GetValue(cellId) != "cell" + std::to_string(inCellId)))
+    {
+      std::cerr << "Wrong cell data for output cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestStaticCleanPolyData(int, char*[])
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 1.0, 0.0);
+  points->InsertNextPoint(0.0, 0.0, 0.0); // Repeated point 0
+
+  // Cell 3 degenerates to a line once the points are merged, so it comes
+  // before the triangle of cell 2 in the output.
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType vert[1] = { 0 };
+  const vtkIdType line[2] = { 0, 1 };
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  const vtkIdType degenerate[3] = { 0, 1, 3 };
+  verts->InsertNextCell(1, vert);
+  lines->InsertNextCell(2, line);
+  polys->InsertNextCell(3, triangle);
+  polys->InsertNextCell(3, degenerate);
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+  input->SetPolys(polys);
+
+  // 16777217 cannot be represented by a float.
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("ints");
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("doubles");
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("strings");
+  for (vtkIdType cellId = 0; cellId < 4; ++cellId)
+  {
+    ints->InsertNextValue(static_cast<int>(16777217 + cellId));
+    doubles->InsertNextValue(0.5 + cellId);
+    strings->InsertNextValue("cell" + std::to_string(cellId));
+  }
+  input->GetCellData()->AddArray(ints);
+  input->GetCellData()->AddArray(doubles);
+
+  // Data arrays only are copied in parallel, with a string array the cell
+  // data is copied afterwards.
+  const vtkIdType expectedIds[4] = { 0, 1, 3, 2 };
+  vtkNew<vtkStaticCleanPolyData> clean;
+  clean->SetInputData(input);
+  clean->Update();
+  if (CheckCellData(clean->GetOutput(), expectedIds, 0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  input->GetCellData()->AddArray(strings);
+  clean->Update();
+  if (CheckCellData(clean->GetOutput(), expectedIds, 4) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that thresholding an unstructured grid, which is threaded, gives the
+// same output as thresholding the image data it is made of, which uses the
+// serial loop, whatever the number of threads.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+// The voxels of the image, with the same points and attributes.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(vtkImageData* image)
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    points->SetPoint(i, image->GetPoint(i));
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(image->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+  {
+    image->GetCellPoints(i, ptIds);
+    grid->InsertNextCell(VTK_VOXEL, ptIds);
+  }
+  grid->GetPointData()->ShallowCopy(image->GetPointData());
+  grid->GetCellData()->ShallowCopy(image->GetCellData());
+  return grid;
+}
+
+bool SameArrays(vtkFieldData* data, vtkFieldData* expected, const char* name)
+{
+  if (data->GetNumberOfArrays() != expected->GetNumberOfArrays())
+  {
+    std::cerr << "Wrong number of " << name << " arrays" << std::endl;
+    return false;
+  }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* array = data->GetArray(a);
+    vtkDataArray* expectedArray = expected->GetArray(a);
+    if (array->GetDataType() != expectedArray->GetDataType() ||
+      array->GetNumberOfTuples() != expectedArray->GetNumberOfTuples())
+    {
+      std::cerr << "Wrong " << name << " array " << a << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+    {
+      if (array->GetTuple1(i) != expectedArray->GetTuple1(i))
+      {
+        std::cerr << "The " << name << " array " << a << " differs at " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkUnstructuredGrid* output, vtkUnstructuredGrid* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Extracted " << output->GetNumberOfCells() << " cells and "
+              << output->GetNumberOfPoints() << " points instead of "
+              << expected->GetNumberOfCells() << " and " << expected->GetNumberOfPoints()
+              << std::endl;
+    return false;
+  }
+  if (output->GetPoints()->GetDataType() != expected->GetPoints()->GetDataType())
+  {
+    std::cerr << "Wrong point type" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    const double* x = output->GetPoint(i);
+    const double* y = expected->GetPoint(i);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> ptIds, expectedPtIds;
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    output->GetCellPoints(i, ptIds);
+    expected->GetCellPoints(i, expectedPtIds);
+    if (output->GetCellType(i) != expected->GetCellType(i) ||
+      ptIds->GetNumberOfIds() != expectedPtIds->GetNumberOfIds())
+    {
+      std::cerr << "Cell " << i << " differs" << std::endl;
+      return false;
+    }
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      if (ptIds->GetId(j) != expectedPtIds->GetId(j))
+      {
+        std::cerr << "Cell " << i << " differs" << std::endl;
+        return false;
+      }
+    }
+  }
+  return SameArrays(output->GetPointData(), expected->GetPointData(), "point data") &&
+    SameArrays(output->GetCellData(), expected->GetCellData(), "cell data");
+}
+
+// Threshold the image and the grid with the given settings and compare them.
+bool CompareThresholds(vtkImageData* image, vtkUnstructuredGrid* grid, int association,
+  const char* arrayName, bool allScalars, bool continuousRange, bool invert)
+{
+  vtkNew<vtkThreshold> serial;
+  serial->SetInputData(image);
+  vtkNew<vtkThreshold> threaded;
+  threaded->SetInputData(grid);
+  vtkThreshold* filters[2] = { serial, threaded };
+  for (vtkThreshold* filter : filters)
+  {
+    filter->SetInputArrayToProcess(0, 0, 0, association, arrayName);
+    filter->ThresholdBetween(120.0, 180.0);
+    filter->SetAllScalars(allScalars);
+    filter->SetUseContinuousCellRange(continuousRange);
+    filter->SetInvert(invert);
+    filter->Update();
+  }
+  if (serial->GetOutput()->GetNumberOfCells() == 0 ||
+    !SameOutput(threaded->GetOutput(), serial->GetOutput()))
+  {
+    std::cerr << "Wrong output for " << arrayName << ", AllScalars " << allScalars
+              << ", UseContinuousCellRange " << continuousRange << ", Invert " << invert
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestThresholdThreads(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  source->Update();
+  vtkNew<vtkImageData> image;
+  image->ShallowCopy(source->GetOutput());
+
+  // Cell scalars and an id array to follow the points.
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfValues(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    pointIds->SetValue(i, i);
+  }
+  image->GetPointData()->AddArray(pointIds);
+  vtkDataArray* pointScalars = image->GetPointData()->GetScalars();
+  vtkNew<vtkIdList> ptIds;
+  vtkSmartPointer<vtkDataArray> cellScalars;
+  cellScalars.TakeReference(pointScalars->NewInstance());
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+  {
+    image->GetCellPoints(i, ptIds);
+    cellScalars->SetTuple1(i, pointScalars->GetTuple1(ptIds->GetId(i % 8)));
+  }
+  image->GetCellData()->AddArray(cellScalars);
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(image);
+
+  const int numThreads[3] = { 1, 2, 4 };
+  for (int n : numThreads)
+  {
+    vtkSMPTools::Initialize(n);
+    for (int mode = 0; mode < 8; ++mode)
+    {
+      if (!CompareThresholds(image, grid, vtkDataObject::FIELD_ASSOCIATION_POINTS,
+            pointScalars->GetName(), (mode & 1) != 0, (mode & 2) != 0, (mode & 4) != 0))
+      {
+        std::cerr << "With " << n << " threads" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (!CompareThresholds(
+          image, grid, vtkDataObject::FIELD_ASSOCIATION_CELLS, "CellScalars", false, false, false))
+    {
+      std::cerr << "With " << n << " threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -17,10 +17,10 @@
 #include "vtkAbstractCellLinks.h"
 #include "vtkArrayDispatch.h"
 #include "vtkArrayListTemplate.h" // For processing attribute data
-#include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -184,6 +184,30 @@ int FastPolyDataPath(
   }
 }
 
+//------------------------------------------------------------------------------
+// The dimension of the cells of a dataset, found once per cell type instead of
+// loading each cell.
+class CellDimensions
+{
+public:
+  CellDimensions() { std::fill_n(this->Dimensions, VTK_NUMBER_OF_CELL_TYPES, -1); }
+
+  int operator()(vtkDataSet* src, vtkIdType cellId)
+  {
+    const int cellType = src->GetCellType(cellId);
+    if (this->Dimensions[cellType] < 0)
+    {
+      this->Cell->SetCellType(cellType);
+      this->Dimensions[cellType] = this->Cell->GetCellDimension();
+    }
+    return this->Dimensions[cellType];
+  }
+
+private:
+  int Dimensions[VTK_NUMBER_OF_CELL_TYPES];
+  vtkNew<vtkGenericCell> Cell;
+};
+
 //------------------------------------------------------------------------------
 // Helper template function that implement the major part of the algorithm
 // which will be expanded by the vtkTemplateMacro. The template function is
@@ -208,15 +232,16 @@ struct Spread
     auto dstTuples = vtk::DataArrayTupleRange(dstarray);
 
     // accumulate
+    CellDimensions cellDimensions;
     if (contributingCellOption != vtkCellDataToPointData::Patch)
     {
+      vtkNew<vtkIdList> pids;
       for (vtkIdType cid = 0; cid < ncells; ++cid)
       {
-        vtkCell* cell = src->GetCell(cid);
-        if (cell->GetCellDimension() >= highestCellDimension)
+        if (cellDimensions(src, cid) >= highestCellDimension)
         {
           const auto srcTuple = srcTuples[cid];
-          vtkIdList* pids = cell->GetPointIds();
+          src->GetCellPoints(cid, pids);
           for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
           {
             const vtkIdType ptId = pids->GetId(i);
@@ -255,7 +280,7 @@ struct Spread
         for (vtkIdType pc = 0; pc < numPatchCells; pc++)
         {
           vtkIdType cellId = cellsOnPoint->GetId(pc);
-          int cellDimension = src->GetCell(cellId)->GetCellDimension();
+          int cellDimension = cellDimensions(src, cellId);
           numPointCells[cellDimension] += 1;
           const auto srcTuple = srcTuples[cellId];
           for (int comp = 0; comp < ncomps; comp++)
@@ -628,12 +653,13 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
     num->SetNumberOfComponents(1);
     num->SetNumberOfTuples(npoints);
     std::fill_n(num->GetPointer(0), npoints, 0u);
+    CellDimensions cellDimensions;
     if (this->ContributingCellOption == vtkCellDataToPointData::DataSetMax)
     {
       int maxDimension = src->IsA("vtkPolyData") == 1 ? 2 : 3;
       for (vtkIdType i = 0; i < src->GetNumberOfCells(); i++)
       {
-        int dim = src->GetCell(i)->GetCellDimension();
+        int dim = cellDimensions(src, i);
         if (dim > highestCellDimension)
         {
           highestCellDimension = dim;
@@ -647,7 +673,7 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
     vtkNew<vtkIdList> pids;
     for (vtkIdType cid = 0; cid < ncells; ++cid)
     {
-      if (src->GetCell(cid)->GetCellDimension() >= highestCellDimension)
+      if (cellDimensions(src, cid) >= highestCellDimension)
       {
         src->GetCellPoints(cid, pids);
         for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
@@ -38,6 +38,7 @@
 #include "vtkSimpleScalarTree.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
@@ -192,15 +193,30 @@ void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData*
   cellScalars->SetNumberOfComponents(inScalars->GetNumberOfComponents());
   cellScalars->Allocate(VTK_CELL_SIZE * inScalars->GetNumberOfComponents());
 
-  // locator used to merge potentially duplicate points
-  locator->InitPointInsertion(newPts, input->GetBounds(), input->GetNumberOfPoints());
-
   // interpolate data along edge
   // if we did not ask for scalars to be computed, don't copy them
   if (!computeScalars)
   {
     outPd->CopyScalarsOff();
   }
+
+  // Cells are contoured in parallel when the default point merging is used.
+  if (!useScalarTree && vtkContourHelper::CanContourInParallel(input, locator))
+  {
+    vtkContourHelper::ContourInParallel(self, vtkUnstructuredGrid::SafeDownCast(input), inScalars,
+      inPd, inCd, values, static_cast<int>(numContours), generateTriangles, newPts->GetDataType(),
+      output);
+
+    newPts->Delete();
+    newVerts->Delete();
+    newLines->Delete();
+    newPolys->Delete();
+    return;
+  }
+
+  // locator used to merge potentially duplicate points
+  locator->InitPointInsertion(newPts, input->GetBounds(), input->GetNumberOfPoints());
+
   outPd->InterpolateAllocate(inPd, estimatedSize, estimatedSize);
   outCd->CopyAllocate(inCd, estimatedSize, estimatedSize);
 
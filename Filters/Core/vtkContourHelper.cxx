@@ -14,14 +14,35 @@
 =========================================================================*/
 #include "vtkContourHelper.h"
 
+#include "vtkAlgorithm.h"
+#include "vtkBoundingBox.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellTypes.h"
+#include "vtkCutter.h"
 #include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkIdListCollection.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkPolygonBuilder.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
 
 //------------------------------------------------------------------------------
 vtkContourHelper::vtkContourHelper(vtkIncrementalPointLocator* locator, vtkCellArray* verts,
@@ -110,3 +131,474 @@ void vtkContourHelper::Contour(
     this->PolyCollection->RemoveAllItems();
   }
 }
+
+namespace
+{
+// Cells are contoured by chunks whose outputs are concatenated in cell order.
+constexpr vtkIdType ContourChunkSize = 4096;
+
+// The output of a chunk of cells. Cells[0], Cells[1] and Cells[2] hold the
+// verts, lines and polys; the cell data of a chunk is laid out as the one of
+// a vtkPolyData: verts, then lines, then polys. The cells of dimension d + 1
+// are contoured after those of dimension d, and PointsEnd[d] is the number of
+// points once they are.
+struct ContourChunk
+{
+  vtkSmartPointer<vtkPoints> Points;
+  vtkIdType PointsEnd[3];
+  vtkSmartPointer<vtkCellArray> Cells[3];
+  vtkSmartPointer<vtkPointData> PointData;
+  vtkSmartPointer<vtkCellData> CellData;
+};
+
+// A cell of a chunk that needs to be contoured, with its scalar range.
+struct ContourCandidate
+{
+  vtkIdType CellId;
+  double Range[2];
+};
+
+// Contours chunks of cells, each one with its own locator and output.
+struct ContourCellsWorker
+{
+  vtkUnstructuredGrid* Input;
+  vtkDataArray* Scalars;
+  vtkPointData* InPd;
+  vtkCellData* InCd;
+  vtkPointData* OutPd;
+  const double* Values;
+  int NumValues;
+  bool OutputTriangles;
+  int PointsType;
+  std::vector<ContourChunk>& Chunks;
+  unsigned char CellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> CellPointIds;
+  vtkSMPThreadLocalObject<vtkDoubleArray> CellScalars;
+  vtkSMPThreadLocal<std::vector<ContourCandidate>> Candidates[3];
+
+  ContourCellsWorker(vtkUnstructuredGrid* input, vtkDataArray* scalars, vtkPointData* inPd,
+    vtkCellData* inCd, vtkPointData* outPd, const double* values, int numValues,
+    bool outputTriangles, int pointsType, std::vector<ContourChunk>& chunks)
+    : Input(input)
+    , Scalars(scalars)
+    , InPd(inPd)
+    , InCd(inCd)
+    , OutPd(outPd)
+    , Values(values)
+    , NumValues(numValues)
+    , OutputTriangles(outputTriangles)
+    , PointsType(pointsType)
+    , Chunks(chunks)
+  {
+    vtkCutter::GetCellTypeDimensions(this->CellTypeDimensions);
+  }
+
+  // Computes the scalar range of the cell whose point ids are given.
+  void GetCellRange(vtkIdList* ptIds, vtkDoubleArray* cellScalars, double range[2])
+  {
+    cellScalars->SetNumberOfTuples(ptIds->GetNumberOfIds());
+    this->Scalars->GetTuples(ptIds, cellScalars);
+    range[0] = VTK_DOUBLE_MAX;
+    range[1] = VTK_DOUBLE_MIN;
+    const double* cellScalarsPtr = cellScalars->GetPointer(0);
+    const vtkIdType numScalars = cellScalars->GetNumberOfValues();
+    for (vtkIdType i = 0; i < numScalars; ++i)
+    {
+      range[0] = std::min(range[0], cellScalarsPtr[i]);
+      range[1] = std::max(range[1], cellScalarsPtr[i]);
+    }
+  }
+
+  bool IsInRange(double value, const double range[2])
+  {
+    return value >= range[0] && value <= range[1];
+  }
+
+  void Initialize()
+  {
+    this->CellScalars.Local()->SetNumberOfComponents(this->Scalars->GetNumberOfComponents());
+  }
+
+  void operator()(vtkIdType beginChunk, vtkIdType endChunk)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* ptIds = this->CellPointIds.Local();
+    vtkDoubleArray* cellScalars = this->CellScalars.Local();
+    std::vector<ContourCandidate>* candidates[3] = { &this->Candidates[0].Local(),
+      &this->Candidates[1].Local(), &this->Candidates[2].Local() };
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    double x[3];
+
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      // Find the cells to contour, by dimension, and their bounds.
+      vtkBoundingBox bbox;
+      for (int dim = 0; dim < 3; ++dim)
+      {
+        candidates[dim]->clear();
+      }
+      const vtkIdType endCellId = std::min((chunkId + 1) * ContourChunkSize, numCells);
+      for (vtkIdType cellId = chunkId * ContourChunkSize; cellId < endCellId; ++cellId)
+      {
+        const int cellType = this->Input->GetCellType(cellId);
+        // Points cannot be cut. Grids with unknown cell types are contoured
+        // serially, see CanContourInParallel().
+        if (this->CellTypeDimensions[cellType] == 0)
+        {
+          continue;
+        }
+        this->Input->GetCellPoints(cellId, ptIds);
+        ContourCandidate candidate;
+        candidate.CellId = cellId;
+        this->GetCellRange(ptIds, cellScalars, candidate.Range);
+        bool needCell = false;
+        for (int i = 0; i < this->NumValues && !needCell; ++i)
+        {
+          needCell = this->IsInRange(this->Values[i], candidate.Range);
+        }
+        if (needCell)
+        {
+          candidates[this->CellTypeDimensions[cellType] - 1]->push_back(candidate);
+          for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+          {
+            this->Input->GetPoint(ptIds->GetId(i), x);
+            bbox.AddPoint(x);
+          }
+        }
+      }
+      const vtkIdType numCandidates = static_cast<vtkIdType>(
+        candidates[0]->size() + candidates[1]->size() + candidates[2]->size());
+      if (numCandidates == 0)
+      {
+        continue;
+      }
+
+      // Contour them from low to high dimension.
+      ContourChunk& chunk = this->Chunks[chunkId];
+      const vtkIdType estimatedSize = std::max<vtkIdType>(numCandidates * this->NumValues, 64);
+      chunk.Points = vtkSmartPointer<vtkPoints>::New();
+      chunk.Points->SetDataType(this->PointsType);
+      for (int dim = 0; dim < 3; ++dim)
+      {
+        chunk.Cells[dim] = vtkSmartPointer<vtkCellArray>::New();
+      }
+      chunk.PointData = vtkSmartPointer<vtkPointData>::New();
+      for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++i)
+      {
+        chunk.PointData->SetCopyAttribute(i,
+          this->OutPd->GetCopyAttribute(i, vtkDataSetAttributes::INTERPOLATE),
+          vtkDataSetAttributes::INTERPOLATE);
+      }
+      chunk.PointData->InterpolateAllocate(this->InPd, estimatedSize, estimatedSize);
+      chunk.CellData = vtkSmartPointer<vtkCellData>::New();
+      chunk.CellData->CopyAllocate(this->InCd, estimatedSize, estimatedSize);
+
+      vtkNew<vtkMergePoints> locator;
+      double bounds[6];
+      bbox.GetBounds(bounds);
+      locator->InitPointInsertion(chunk.Points, bounds, estimatedSize);
+      vtkContourHelper helper(locator, chunk.Cells[0], chunk.Cells[1], chunk.Cells[2], this->InPd,
+        this->InCd, chunk.PointData, chunk.CellData, static_cast<int>(estimatedSize),
+        this->OutputTriangles);
+      for (int dim = 0; dim < 3; ++dim)
+      {
+        for (const ContourCandidate& candidate : *candidates[dim])
+        {
+          this->Input->GetCell(candidate.CellId, cell);
+          cellScalars->SetNumberOfTuples(cell->GetNumberOfPoints());
+          this->Scalars->GetTuples(cell->GetPointIds(), cellScalars);
+          for (int i = 0; i < this->NumValues; ++i)
+          {
+            if (this->IsInRange(this->Values[i], candidate.Range))
+            {
+              helper.Contour(cell, this->Values[i], cellScalars, candidate.CellId);
+            }
+          }
+        }
+        chunk.PointsEnd[dim] = chunk.Points->GetNumberOfPoints();
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Concatenates the chunks, merging the points that have the same
+// coordinates. The points are concatenated in the order in which the serial
+// contouring inserts them: the points of the cells of dimension 1 of all the
+// chunks, then those of dimension 2, then those of dimension 3. Each group of
+// coincident points is represented by its first occurrence, which gives the
+// point its id and its point data.
+template <typename TPoint>
+void MergeContourChunks(std::vector<ContourChunk>& chunks, int pointsType, vtkPointData* outPd,
+  vtkCellData* outCd, vtkPolyData* output)
+{
+  const vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  std::vector<vtkIdType> pointOffsets[3], cellOffsets[3], connOffsets[3];
+  for (int dim = 0; dim < 3; ++dim)
+  {
+    pointOffsets[dim].resize(numChunks + 1, 0);
+    cellOffsets[dim].resize(numChunks + 1, 0);
+    connOffsets[dim].resize(numChunks + 1, 0);
+  }
+  for (int dim = 0; dim < 3; ++dim)
+  {
+    pointOffsets[dim][0] = dim == 0 ? 0 : pointOffsets[dim - 1][numChunks];
+    for (vtkIdType chunkId = 0; chunkId < numChunks; ++chunkId)
+    {
+      const ContourChunk& chunk = chunks[chunkId];
+      const bool empty = chunk.Points == nullptr;
+      pointOffsets[dim][chunkId + 1] = pointOffsets[dim][chunkId] +
+        (empty ? 0 : chunk.PointsEnd[dim] - (dim == 0 ? 0 : chunk.PointsEnd[dim - 1]));
+      cellOffsets[dim][chunkId + 1] =
+        cellOffsets[dim][chunkId] + (empty ? 0 : chunk.Cells[dim]->GetNumberOfCells());
+      connOffsets[dim][chunkId + 1] =
+        connOffsets[dim][chunkId] + (empty ? 0 : chunk.Cells[dim]->GetNumberOfConnectivityIds());
+    }
+  }
+  const vtkIdType numPts = pointOffsets[2][numChunks];
+
+  // The index of a point of a chunk among all the points.
+  auto globalId = [&pointOffsets, &chunks](vtkIdType chunkId, vtkIdType ptId) {
+    const vtkIdType* end = chunks[chunkId].PointsEnd;
+    const int dim = ptId < end[0] ? 0 : (ptId < end[1] ? 1 : 2);
+    return pointOffsets[dim][chunkId] + ptId - (dim == 0 ? 0 : end[dim - 1]);
+  };
+
+  // Gather the coordinates of all the points.
+  std::vector<TPoint> coords(3 * numPts);
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      const ContourChunk& chunk = chunks[chunkId];
+      if (chunk.Points)
+      {
+        const TPoint* chunkCoords =
+          static_cast<TPoint*>(chunk.Points->GetData()->GetVoidPointer(0));
+        for (int dim = 0; dim < 3; ++dim)
+        {
+          const vtkIdType begin = dim == 0 ? 0 : chunk.PointsEnd[dim - 1];
+          std::copy(chunkCoords + 3 * begin, chunkCoords + 3 * chunk.PointsEnd[dim],
+            coords.begin() + 3 * pointOffsets[dim][chunkId]);
+        }
+      }
+    }
+  });
+
+  // Sort the points by coordinates, then by order of occurrence, so that
+  // coincident points are consecutive and start with their first occurrence.
+  std::vector<vtkIdType> order(numPts);
+  std::iota(order.begin(), order.end(), 0);
+  const TPoint* x = coords.data();
+  vtkSMPTools::Sort(order.begin(), order.end(), [x](vtkIdType a, vtkIdType b) {
+    const TPoint* xa = x + 3 * a;
+    const TPoint* xb = x + 3 * b;
+    if (xa[0] != xb[0])
+    {
+      return xa[0] < xb[0];
+    }
+    if (xa[1] != xb[1])
+    {
+      return xa[1] < xb[1];
+    }
+    if (xa[2] != xb[2])
+    {
+      return xa[2] < xb[2];
+    }
+    return a < b;
+  });
+  auto coincident = [x](vtkIdType a, vtkIdType b) {
+    const TPoint* xa = x + 3 * a;
+    const TPoint* xb = x + 3 * b;
+    return xa[0] == xb[0] && xa[1] == xb[1] && xa[2] == xb[2];
+  };
+
+  // pointMap[i] is first the first occurrence of point i; output ids are
+  // given to the first occurrences in order.
+  std::vector<vtkIdType> pointMap(numPts);
+  std::vector<vtkIdType> newIds(numPts + 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType first = i;
+      while (first > 0 && coincident(order[first - 1], order[i]))
+      {
+        --first;
+      }
+      pointMap[order[i]] = order[first];
+      newIds[order[i]] = first == i ? 1 : 0;
+    }
+  });
+  newIds[numPts] = 0;
+  vtkSMPTools::ExclusiveScan(newIds.begin(), newIds.end(), newIds.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = newIds[numPts];
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      pointMap[i] = newIds[pointMap[i]];
+    }
+  });
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(pointsType);
+  newPts->SetNumberOfPoints(numNewPts);
+  TPoint* newCoords = static_cast<TPoint*>(newPts->GetData()->GetVoidPointer(0));
+  outPd->SetNumberOfTuples(numNewPts);
+
+  const vtkIdType numOutCells[3] = { cellOffsets[0][numChunks], cellOffsets[1][numChunks],
+    cellOffsets[2][numChunks] };
+  const vtkIdType cellDataOffsets[3] = { 0, numOutCells[0], numOutCells[0] + numOutCells[1] };
+  outCd->SetNumberOfTuples(cellDataOffsets[2] + numOutCells[2]);
+  vtkNew<vtkIdTypeArray> offsets[3];
+  vtkNew<vtkIdTypeArray> conn[3];
+  for (int dim = 0; dim < 3; ++dim)
+  {
+    offsets[dim]->SetNumberOfValues(numOutCells[dim] + 1);
+    offsets[dim]->SetValue(numOutCells[dim], connOffsets[dim][numChunks]);
+    conn[dim]->SetNumberOfValues(connOffsets[dim][numChunks]);
+  }
+
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      ContourChunk& chunk = chunks[chunkId];
+      if (!chunk.Points)
+      {
+        continue;
+      }
+
+      // Points and point data of the first occurrences.
+      const vtkIdType numChunkPts = chunk.Points->GetNumberOfPoints();
+      for (vtkIdType i = 0; i < numChunkPts; ++i)
+      {
+        const vtkIdType ptId = globalId(chunkId, i);
+        if (newIds[ptId + 1] != newIds[ptId])
+        {
+          std::copy(x + 3 * ptId, x + 3 * ptId + 3, newCoords + 3 * newIds[ptId]);
+          outPd->SetTuple(newIds[ptId], i, chunk.PointData);
+        }
+      }
+
+      // Cells and cell data.
+      vtkIdType chunkCellDataId = 0;
+      for (int dim = 0; dim < 3; ++dim)
+      {
+        vtkIdType* offsetsPtr = offsets[dim]->GetPointer(0);
+        vtkIdType* connPtr = conn[dim]->GetPointer(0);
+        vtkIdType cellId = cellOffsets[dim][chunkId];
+        vtkIdType connId = connOffsets[dim][chunkId];
+        vtkCellArray* cells = chunk.Cells[dim];
+        const vtkIdType numChunkCells = cells->GetNumberOfCells();
+        vtkIdType npts;
+        const vtkIdType* pts;
+        for (vtkIdType i = 0; i < numChunkCells; ++i, ++cellId, ++chunkCellDataId)
+        {
+          cells->GetCellAtId(i, npts, pts);
+          offsetsPtr[cellId] = connId;
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            connPtr[connId++] = pointMap[globalId(chunkId, pts[j])];
+          }
+          outCd->SetTuple(cellDataOffsets[dim] + cellId, chunkCellDataId, chunk.CellData);
+        }
+      }
+
+      // Release the chunk as soon as it has been copied.
+      chunk = ContourChunk();
+    }
+  });
+
+  output->SetPoints(newPts);
+  void (vtkPolyData::*setCells[3])(vtkCellArray*) = { &vtkPolyData::SetVerts,
+    &vtkPolyData::SetLines, &vtkPolyData::SetPolys };
+  for (int dim = 0; dim < 3; ++dim)
+  {
+    if (numOutCells[dim] > 0)
+    {
+      vtkNew<vtkCellArray> cells;
+      cells->SetData(offsets[dim], conn[dim]);
+      (output->*setCells[dim])(cells);
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkContourHelper::CanContourInParallel(
+  vtkDataSet* input, vtkIncrementalPointLocator* locator)
+{
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!grid || !grid->GetPoints() ||
+    (locator && strcmp(locator->GetClassName(), "vtkMergePoints") != 0))
+  {
+    return false;
+  }
+  const int pointsType = grid->GetPoints()->GetDataType();
+  if (pointsType != VTK_FLOAT && pointsType != VTK_DOUBLE)
+  {
+    return false;
+  }
+
+  // Higher order cells read their degrees from the cell data, which is not
+  // thread safe. Polyhedra overwrite the data of merged points, so their
+  // output depends on the global order in which cells are processed. Unknown
+  // cell types are left to the serial loops, which report them.
+  vtkNew<vtkCellTypes> cellTypes;
+  grid->GetCellTypes(cellTypes);
+  for (vtkIdType i = 0; i < cellTypes->GetNumberOfTypes(); ++i)
+  {
+    const int cellType = cellTypes->GetCellType(i);
+    if ((cellType >= VTK_LAGRANGE_CURVE && cellType <= VTK_BEZIER_PYRAMID) ||
+      cellType == VTK_POLYHEDRON || cellType >= VTK_NUMBER_OF_CELL_TYPES)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkContourHelper::ContourInParallel(vtkAlgorithm* filter, vtkUnstructuredGrid* input,
+  vtkDataArray* scalars, vtkPointData* inPd, vtkCellData* inCd, const double* values,
+  int numValues, bool outputTriangles, int pointsType, vtkPolyData* output)
+{
+  vtkPointData* outPd = output->GetPointData();
+  vtkCellData* outCd = output->GetCellData();
+  outPd->InterpolateAllocate(inPd);
+  outCd->CopyAllocate(inCd);
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numChunks = (numCells + ContourChunkSize - 1) / ContourChunkSize;
+  std::vector<ContourChunk> chunks(numChunks);
+  ContourCellsWorker worker(input, scalars, inPd, inCd, outPd, values, numValues,
+    outputTriangles, pointsType, chunks);
+
+  // Contour the chunks by batches, to update the progress and check for an
+  // abort from the calling thread between them. An abort leaves the remaining
+  // chunks empty.
+  const vtkIdType batchSize = std::max<vtkIdType>(
+    numChunks / 10 + 1, vtkSMPTools::GetEstimatedNumberOfThreads());
+  for (vtkIdType beginChunk = 0; beginChunk < numChunks; beginChunk += batchSize)
+  {
+    if (filter)
+    {
+      filter->UpdateProgress(static_cast<double>(beginChunk) / numChunks);
+      if (filter->GetAbortExecute())
+      {
+        break;
+      }
+    }
+    vtkSMPTools::For(beginChunk, std::min(beginChunk + batchSize, numChunks), 1, worker);
+  }
+
+  if (pointsType == VTK_DOUBLE)
+  {
+    MergeContourChunks<double>(chunks, pointsType, outPd, outCd, output);
+  }
+  else
+  {
+    MergeContourChunks<float>(chunks, pointsType, outPd, outCd, output);
+  }
+}
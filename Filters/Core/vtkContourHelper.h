@@ -20,6 +20,9 @@
  *  produce either triangles and/or polygons based on the outputTriangles parameter
  *  When working with multidimensional dataset, it is needed to process cells
  *  from low to high dimensions.
+ *
+ *  It also provides a threaded contouring path for unstructured grids, see
+ *  ContourInParallel().
  * @sa
  * vtkContourGrid vtkCutter vtkContourFilter
  */
@@ -31,13 +34,17 @@
 #include "vtkPolygonBuilder.h"    //for a member variable
 #include "vtkSmartPointer.h"      //for a member variable
 
+class vtkAlgorithm;
 class vtkIncrementalPointLocator;
 class vtkCellArray;
 class vtkPointData;
 class vtkCellData;
 class vtkCell;
 class vtkDataArray;
+class vtkDataSet;
 class vtkIdListCollection;
+class vtkPolyData;
+class vtkUnstructuredGrid;
 
 class VTKFILTERSCORE_EXPORT vtkContourHelper
 {
@@ -48,6 +55,33 @@ public:
   ~vtkContourHelper();
   void Contour(vtkCell* cell, double value, vtkDataArray* cellScalars, vtkIdType cellId);
 
+  /**
+   * Return true if ContourInParallel() can process the given input with the
+   * given point locator: the input must be a vtkUnstructuredGrid with float
+   * or double points and without polyhedra, higher order (Lagrange or
+   * Bezier) or unknown cells, and the locator must be a plain vtkMergePoints
+   * (or nullptr), since other locators may merge points with a tolerance.
+   */
+  static bool CanContourInParallel(vtkDataSet* input, vtkIncrementalPointLocator* locator);
+
+  /**
+   * Contour all the cells of an unstructured grid for the given values in
+   * parallel with vtkSMPTools. Chunks of cells are contoured independently,
+   * each with its own vtkGenericCell, vtkMergePoints locator and output
+   * arrays; their points and cells are then concatenated in the order of the
+   * serial loops, which contour the cells from low to high dimension, and
+   * their coincident points merged. The output is thus the same as the one
+   * of these loops with a vtkMergePoints locator, and does not depend on the
+   * number of threads. filter, if not nullptr, has its progress updated and
+   * its abort flag checked from the calling thread. scalars are the point
+   * scalars to contour, inPd the point data to interpolate (the copy flags
+   * of the output point data are honored) and pointsType the data type of
+   * the output points, VTK_FLOAT or VTK_DOUBLE.
+   */
+  static void ContourInParallel(vtkAlgorithm* filter, vtkUnstructuredGrid* input,
+    vtkDataArray* scalars, vtkPointData* inPd, vtkCellData* inCd, const double* values,
+    int numValues, bool outputTriangles, int pointsType, vtkPolyData* output);
+
 private:
   vtkContourHelper(const vtkContourHelper&) = delete;
   vtkContourHelper& operator=(const vtkContourHelper&) = delete;
@@ -47,6 +47,7 @@
 #include "vtkSynchronizedTemplates3D.h"
 #include "vtkSynchronizedTemplatesCutter3D.h"
 #include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
@@ -802,6 +803,29 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
     inPD = input->GetPointData();
   }
   outPD = output->GetPointData();
+
+  // Cells are contoured in parallel when the default point merging and
+  // output order are used.
+  if (this->SortBy == VTK_SORT_BY_VALUE &&
+    vtkContourHelper::CanContourInParallel(input, this->Locator))
+  {
+    this->CutFunction->FunctionValue(inputPointSet->GetPoints()->GetData(), cutScalars);
+    vtkContourHelper::ContourInParallel(this, vtkUnstructuredGrid::SafeDownCast(input), cutScalars,
+      inPD, inCD, contourValues, numContours, this->GenerateTriangles != 0,
+      newPoints->GetDataType(), output);
+
+    cutScalars->Delete();
+    if (this->GenerateCutScalars)
+    {
+      inPD->Delete();
+    }
+    newPoints->Delete();
+    newVerts->Delete();
+    newLines->Delete();
+    newPolys->Delete();
+    return;
+  }
+
   outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
   outCD->CopyAllocate(inCD, estimatedSize, estimatedSize / 2);
 
@@ -210,6 +210,7 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
       this->Mesh = nullptr;
     }
     this->Mesh = vtkPolyData::New();
+    this->Mesh->EditableOn(); // the links are modified by the collapses
 
     newPts = vtkPoints::New();
 
@@ -359,6 +359,7 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   this->NumberOfDegeneracies = 0;
 
   this->Mesh = vtkPolyData::New();
+  this->Mesh->EditableOn(); // the links are modified by the insertions
 
   // If the user specified a transform, apply it to the input data.
   //
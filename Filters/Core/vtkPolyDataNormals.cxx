@@ -15,6 +15,7 @@
 #include "vtkPolyDataNormals.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -27,12 +28,406 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangleStrip.h"
 
-#include "vtkNew.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+namespace
+{
+
+// Compute the normal of every polygon.
+struct ComputePolyNormals
+{
+  vtkPoints* Points;
+  vtkCellArray* Polys;
+  float* Normals;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> PolyIterator;
+
+  ComputePolyNormals(vtkPoints* points, vtkCellArray* polys, float* normals)
+    : Points(points)
+    , Polys(polys)
+    , Normals(normals)
+  {
+  }
+
+  void Initialize() { this->PolyIterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* polyIter = this->PolyIterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double n[3];
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      polyIter->GetCellAtId(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      float* normal = this->Normals + 3 * cellId;
+      normal[0] = static_cast<float>(n[0]);
+      normal[1] = static_cast<float>(n[1]);
+      normal[2] = static_cast<float>(n[2]);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Split the mesh at the points lying on feature edges. The cells using a
+// point are grouped into regions of edge connected cells that are not
+// separated by a feature edge, and the cells of every region but the first
+// one get their own copy of the point. This runs in two passes over the
+// points: the first one counts the copies of every point, the second one,
+// given the id of the first copy of every point (a prefix sum of the counts),
+// records the replacements of the point in the cells, which are applied
+// afterwards. Copies are numbered the same way as if the points were
+// processed one after the other, so the output does not depend on the number
+// of threads.
+struct SplitPoints
+{
+  struct Replacement
+  {
+    vtkIdType CellId;
+    vtkIdType PtId;
+    vtkIdType NewPtId;
+  };
+
+  vtkPolyData* OldMesh;
+  vtkCellArray* OldPolys;
+  const float* PolyNormals;
+  double CosAngle;
+  vtkIdType NumPts;
+  vtkIdType* Counts;
+  const vtkIdType* Offsets; // nullptr while counting
+  vtkIdType* Map;           // new point id -> old point id
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> PolyIterator;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  // Find the first position of a cell in the list of the cells using the
+  // current point. Short lists, the common case, are searched linearly. Long
+  // ones, such as around the poles of a sphere, are sorted once as (cell id,
+  // position) pairs and searched by bisection. This only needs memory for the
+  // cells of one point per thread.
+  struct CellPositions
+  {
+    const vtkIdType* Cells = nullptr;
+    vtkIdType NumCells = 0;
+    std::vector<std::pair<vtkIdType, vtkIdType>> Sorted;
+
+    void Set(vtkIdType ncells, const vtkIdType* cells)
+    {
+      this->Cells = cells;
+      this->NumCells = ncells;
+      this->Sorted.clear();
+      if (ncells > 32)
+      {
+        for (vtkIdType j = 0; j < ncells; ++j)
+        {
+          this->Sorted.emplace_back(cells[j], j);
+        }
+        std::sort(this->Sorted.begin(), this->Sorted.end());
+      }
+    }
+
+    vtkIdType Find(vtkIdType cellId) const
+    {
+      if (this->Sorted.empty())
+      {
+        return std::find(this->Cells, this->Cells + this->NumCells, cellId) - this->Cells;
+      }
+      return std::lower_bound(
+        this->Sorted.begin(), this->Sorted.end(), std::make_pair(cellId, vtkIdType(0)))
+        ->second;
+    }
+  };
+  vtkSMPThreadLocal<CellPositions> Positions;
+  vtkSMPThreadLocal<std::vector<int>> Regions;
+  vtkSMPThreadLocal<std::vector<Replacement>> Replacements;
+
+  SplitPoints(
+    vtkPolyData* oldMesh, const float* polyNormals, double cosAngle, vtkIdType* counts)
+    : OldMesh(oldMesh)
+    , OldPolys(oldMesh->GetPolys())
+    , PolyNormals(polyNormals)
+    , CosAngle(cosAngle)
+    , NumPts(oldMesh->GetNumberOfPoints())
+    , Counts(counts)
+    , Offsets(nullptr)
+    , Map(nullptr)
+  {
+  }
+
+  void Initialize()
+  {
+    this->PolyIterator.Local().TakeReference(this->OldPolys->NewIterator());
+    this->CellIds.Local()->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkCellArrayIterator* polyIter = this->PolyIterator.Local();
+    vtkIdList* cellIds = this->CellIds.Local();
+    CellPositions& positions = this->Positions.Local();
+    std::vector<int>& regions = this->Regions.Local();
+    vtkIdType ncells;
+    vtkIdType* cells;
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (this->Offsets && this->Counts[ptId] == 0)
+      {
+        continue; // nothing to replace
+      }
+      // Get the cells using this point and make sure that we have to do something
+      this->OldMesh->GetPointCells(ptId, ncells, cells);
+      if (ncells <= 1)
+      {
+        this->Counts[ptId] = 0; // point does not need to be further disconnected
+        continue;
+      }
+
+      // Only the cells using this point are looked up: the neighbors visited
+      // around the point all use it.
+      positions.Set(ncells, cells);
+      regions.resize(static_cast<size_t>(ncells));
+      int numRegions =
+        this->MarkRegions(ptId, ncells, cells, positions, regions.data(), polyIter, cellIds);
+      if (!this->Offsets)
+      {
+        this->Counts[ptId] = numRegions - 1;
+      }
+      else
+      {
+        this->ReplacePoint(ptId, ncells, cells, positions, regions.data());
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  // The region of a cell is stored at the first position of the cell in the
+  // list of cells using the point (a cell may use a point more than once).
+  static int& Region(vtkIdType cellId, const CellPositions& positions, int* regions)
+  {
+    return regions[positions.Find(cellId)];
+  }
+
+  // Mark the region of every cell using ptId and return the number of regions.
+  int MarkRegions(vtkIdType ptId, vtkIdType ncells, const vtkIdType* cells,
+    const CellPositions& positions, int* regions, vtkCellArrayIterator* polyIter,
+    vtkIdList* cellIds)
+  {
+    // Start moving around the "cycle" of points using the point. Label
+    // each subregion of cells connected to this point that are connected (and
+    // not separated by a feature edge) with a given region number.
+    //
+    // Start by initializing the cells as unvisited
+    std::fill_n(regions, ncells, -1);
+
+    // Loop over all cells and mark the region that each is in.
+    //
+    vtkIdType numPts;
+    const vtkIdType* pts;
+    int numRegions = 0;
+    vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+    for (vtkIdType j = 0; j < ncells; j++) // for all cells connected to point
+    {
+      if (Region(cells[j], positions, regions) < 0) // for all unvisited cells
+      {
+        Region(cells[j], positions, regions) = numRegions;
+        // okay, mark all the cells connected to this seed cell and using ptId
+        polyIter->GetCellAtId(cells[j], numPts, pts);
+
+        // find the two edges
+        for (spot = 0; spot < numPts; spot++)
+        {
+          if (pts[spot] == ptId)
+          {
+            break;
+          }
+        }
+
+        if (spot == 0)
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[numPts - 1];
+        }
+        else if (spot == (numPts - 1))
+        {
+          neiPt[0] = pts[spot - 1];
+          neiPt[1] = pts[0];
+        }
+        else
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[spot - 1];
+        }
+
+        for (int i = 0; i < 2; i++) // for each of the two edges of the seed cell
+        {
+          cellId = cells[j];
+          nei = neiPt[i];
+          while (cellId >= 0) // while we can grow this region
+          {
+            this->OldMesh->GetCellEdgeNeighbors(cellId, ptId, nei, cellIds);
+            if (cellIds->GetNumberOfIds() == 1 &&
+              Region((neiCellId = cellIds->GetId(0)), positions, regions) < 0)
+            {
+              const float* thisNormal = this->PolyNormals + 3 * cellId;
+              const float* neiNormal = this->PolyNormals + 3 * neiCellId;
+
+              if (static_cast<double>(thisNormal[0]) * neiNormal[0] +
+                  static_cast<double>(thisNormal[1]) * neiNormal[1] +
+                  static_cast<double>(thisNormal[2]) * neiNormal[2] >
+                this->CosAngle)
+              {
+                // visit and arrange to visit next edge neighbor
+                Region(neiCellId, positions, regions) = numRegions;
+                cellId = neiCellId;
+                polyIter->GetCellAtId(cellId, numPts, pts);
+
+                for (spot = 0; spot < numPts; spot++)
+                {
+                  if (pts[spot] == ptId)
+                  {
+                    break;
+                  }
+                }
+
+                if (spot == 0)
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
+                }
+                else if (spot == (numPts - 1))
+                {
+                  nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
+                }
+                else
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
+                }
+
+              } // if not separated by edge angle
+              else
+              {
+                cellId = -1; // separated by edge angle
+              }
+            } // if can move to edge neighbor
+            else
+            {
+              cellId = -1; // separated by previous visit, boundary, or non-manifold
+            }
+          } // while visit wave is propagating
+        }   // for each of the two edges of the starting cell
+        numRegions++;
+      } // if cell is unvisited
+    }   // for all cells connected to point ptId
+
+    return numRegions;
+  }
+
+  // For all cells not in the first region, the ptId is replaced with a new
+  // ptId, which is a duplicate of the first point, but disconnected
+  // topologically.
+  void ReplacePoint(vtkIdType ptId, vtkIdType ncells, const vtkIdType* cells,
+    const CellPositions& positions, int* regions)
+  {
+    std::vector<Replacement>& replacements = this->Replacements.Local();
+    const vtkIdType lastId = this->NumPts + this->Offsets[ptId];
+    for (vtkIdType j = 0; j < ncells; j++)
+    {
+      const int region = Region(cells[j], positions, regions);
+      if (region > 0) // replace point if splitting needed
+      {
+        const vtkIdType replacementPoint = lastId + region - 1;
+        this->Map[replacementPoint] = ptId;
+        replacements.push_back(Replacement{ cells[j], ptId, replacementPoint });
+      } // if not in first regions and requiring splitting
+    }   // for all cells connected to ptId
+  }
+};
+
+// Accumulate the normals of the polygons using each point and normalize the
+// sum. Polygon normals are added in increasing polygon id order so that the
+// result does not depend on the number of threads.
+struct AccumulatePointNormals
+{
+  vtkStaticCellLinksTemplate<vtkIdType>* Links;
+  const float* PolyNormals;
+  float* Normals;
+  double FlipDirection;
+
+  AccumulatePointNormals(vtkStaticCellLinksTemplate<vtkIdType>* links, const float* polyNormals,
+    float* normals, double flipDirection)
+    : Links(links)
+    , PolyNormals(polyNormals)
+    , Normals(normals)
+    , FlipDirection(flipDirection)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* cells = this->Links->GetCells(ptId);
+      const vtkIdType ncells = this->Links->GetNcells(ptId);
+      std::sort(cells, cells + ncells);
+
+      float* n = this->Normals + 3 * ptId;
+      n[0] = n[1] = n[2] = 0.0f;
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        const float* polyNormal = this->PolyNormals + 3 * cells[i];
+        n[0] += polyNormal[0];
+        n[1] += polyNormal[1];
+        n[2] += polyNormal[2];
+      }
+
+      const double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * this->FlipDirection;
+      if (length != 0.0)
+      {
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+      }
+    }
+  }
+};
+
+// Run the functor over [0, n) by batches, updating the progress of the
+// filter from progressBegin to progressEnd and checking for an abort between
+// them. Return false if the execution was aborted.
+template <typename Functor>
+bool ForWithProgress(
+  vtkAlgorithm* filter, vtkIdType n, Functor& functor, double progressBegin, double progressEnd)
+{
+  const vtkIdType batchSize =
+    std::max<vtkIdType>(n / 10 + 1, 1000 * vtkSMPTools::GetEstimatedNumberOfThreads());
+  for (vtkIdType begin = 0; begin < n; begin += batchSize)
+  {
+    filter->UpdateProgress(
+      progressBegin + (progressEnd - progressBegin) * static_cast<double>(begin) / n);
+    if (filter->GetAbortExecute())
+    {
+      return false;
+    }
+    vtkSMPTools::For(begin, std::min(begin + batchSize, n), functor);
+  }
+  return true;
+}
+
+} // anonymous namespace
+
 // Construct with feature angle=30, splitting and consistency turned on,
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -53,7 +448,6 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   this->CellIds = nullptr;
   this->CellPoints = nullptr;
   this->NeighborPoints = nullptr;
-  this->Map = nullptr;
   this->OldMesh = nullptr;
   this->NewMesh = nullptr;
   this->Visited = nullptr;
@@ -91,7 +485,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDataSetAttributes* outCD = output->GetCellData();
   double n[3];
   vtkCellArray* newPolys;
-  vtkIdType ptId, oldId;
+  vtkIdType ptId;
 
   vtkDebugMacro(<< "Generating surface normals");
 
@@ -191,7 +585,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   // The visited array keeps track of which polygons have been visited.
   //
-  if (this->Consistency || this->Splitting || this->AutoOrientNormals)
+  if (this->Consistency || this->AutoOrientNormals)
   {
     this->Visited = new int[numPolys];
     memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys * sizeof(int));
@@ -362,19 +756,10 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->PolyNormals->SetTuple(cellId, n);
   }
 
-  for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-  {
-    if ((cellId % 1000) == 0)
-    {
-      this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
-    }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(offsetCells + cellId, n);
-  }
+  float* fPolyNormals = this->PolyNormals->WritePointer(0, 3 * (offsetCells + numPolys));
+  ComputePolyNormals polyNormalsWorker(inPts, newPolys, fPolyNormals + 3 * offsetCells);
+  ForWithProgress(this, numPolys, polyNormalsWorker, 0.333, 0.5);
+  this->UpdateProgress(0.5);
 
   // Split mesh if sharp features
   if (this->Splitting)
@@ -384,23 +769,42 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     // connectivity.
     //
     this->CosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+
+    // First count the new points created at each point, then give them ids
+    // and replace the points in the polygons. No point is split once the
+    // execution is aborted.
+    std::vector<vtkIdType> counts(numPts);
+    std::vector<vtkIdType> offsets(numPts);
+    SplitPoints splitter(this->OldMesh, fPolyNormals, this->CosAngle, counts.data());
+    if (!ForWithProgress(this, numPts, splitter, 0.5, 0.7))
+    {
+      std::fill(counts.begin(), counts.end(), 0);
+    }
+    vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets.begin(), vtkIdType(0));
+    numNewPts = numPts + offsets.back() + counts.back();
+
     //  Splitting will create new points.  We have to create index array
     // to map new points into old points.
     //
-    this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (vtkIdType i = 0; i < numPts; i++)
+    vtkNew<vtkIdList> map;
+    map->SetNumberOfIds(numNewPts);
+    vtkIdType* mapIds = map->GetPointer(0);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType beginPtId, vtkIdType endPtId) {
+      std::iota(mapIds + beginPtId, mapIds + endPtId, beginPtId);
+    });
+
+    splitter.Offsets = offsets.data();
+    splitter.Map = mapIds;
+    vtkSMPTools::For(0, numPts, splitter);
+    for (auto& replacements : splitter.Replacements)
     {
-      this->Map->SetId(i, i);
+      for (const auto& replacement : replacements)
+      {
+        this->NewMesh->ReplaceCellPoint(
+          replacement.CellId, replacement.PtId, replacement.NewPtId);
+      }
     }
 
-    for (ptId = 0; ptId < numPts; ptId++)
-    {
-      this->MarkAndSplit(ptId);
-    } // for all input points
-
-    numNewPts = this->Map->GetNumberOfIds();
-
     vtkDebugMacro(<< "Created " << numNewPts - numPts << " new points");
 
     //  Now need to map attributes of old points into new points.
@@ -433,13 +837,22 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     newPts->SetNumberOfPoints(numNewPts);
-    for (ptId = 0; ptId < numNewPts; ptId++)
-    {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId, inPts->GetPoint(oldId));
-      outPD->CopyData(pd, oldId, ptId);
-    }
-    this->Map->Delete();
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType beginPtId, vtkIdType endPtId) {
+      double x[3];
+      for (vtkIdType newPtId = beginPtId; newPtId < endPtId; ++newPtId)
+      {
+        inPts->GetPoint(mapIds[newPtId], x);
+        newPts->SetPoint(newPtId, x);
+      }
+    });
+
+    vtkNew<vtkIdList> newIds;
+    newIds->SetNumberOfIds(numNewPts);
+    vtkIdType* newIdsPtr = newIds->GetPointer(0);
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType beginPtId, vtkIdType endPtId) {
+      std::iota(newIdsPtr + beginPtId, newIdsPtr + endPtId, beginPtId);
+    });
+    outPD->CopyData(pd, map, newIds);
   } // splitting
 
   else // no splitting, so no new points
@@ -449,7 +862,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     outPD->PassData(pd);
   }
 
-  if (this->Consistency || this->Splitting)
+  if (this->Consistency || this->AutoOrientNormals)
   {
     delete[] this->Visited;
     this->CellIds->Delete();
@@ -475,35 +888,18 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   newNormals->SetNumberOfTuples(numNewPts);
   newNormals->SetName("Normals");
   float* fNormals = newNormals->WritePointer(0, 3 * numNewPts);
-  std::fill_n(fNormals, 3 * numNewPts, 0);
-
-  float* fPolyNormals = this->PolyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
 
   if (this->ComputePointNormals)
   {
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); ++cellId)
-    {
-      for (vtkIdType i = 0; i < npts; ++i)
-      {
-        fNormals[3 * pts[i]] += fPolyNormals[3 * cellId];
-        fNormals[3 * pts[i] + 1] += fPolyNormals[3 * cellId + 1];
-        fNormals[3 * pts[i] + 2] += fPolyNormals[3 * cellId + 2];
-      }
-    }
-
-    for (vtkIdType i = 0; i < numNewPts; ++i)
-    {
-      const double length =
-        sqrt(fNormals[3 * i] * fNormals[3 * i] + fNormals[3 * i + 1] * fNormals[3 * i + 1] +
-          fNormals[3 * i + 2] * fNormals[3 * i + 2]) *
-        flipDirection;
-      if (length != 0.0)
-      {
-        fNormals[3 * i] /= length;
-        fNormals[3 * i + 1] /= length;
-        fNormals[3 * i + 2] /= length;
-      }
-    }
+    vtkStaticCellLinksTemplate<vtkIdType> links;
+    links.ThreadedBuildLinks(numNewPts, numPolys, newPolys);
+    AccumulatePointNormals pointNormalsWorker(
+      &links, fPolyNormals + 3 * offsetCells, fNormals, flipDirection);
+    vtkSMPTools::For(0, numNewPts, pointNormalsWorker);
+  }
+  else
+  {
+    vtkSMPTools::Fill(fNormals, fNormals + 3 * numNewPts, 0.0f);
   }
 
   //  Update ourselves.  If no new nodes have been created (i.e., no
@@ -624,155 +1020,6 @@ void vtkPolyDataNormals::TraverseAndOrder()
   } // while wave still propagating
 }
 
-//
-//  Mark polygons around vertex.  Create new vertex (if necessary) and
-//  replace (i.e., split mesh).
-//
-void vtkPolyDataNormals::MarkAndSplit(vtkIdType ptId)
-{
-  int i, j;
-
-  // Get the cells using this point and make sure that we have to do something
-  vtkIdType ncells;
-  vtkIdType* cells;
-  this->OldMesh->GetPointCells(ptId, ncells, cells);
-  if (ncells <= 1)
-  {
-    return; // point does not need to be further disconnected
-  }
-
-  // Start moving around the "cycle" of points using the point. Label
-  // each point as requiring a visit. Then label each subregion of cells
-  // connected to this point that are connected (and not separated by
-  // a feature edge) with a given region number. For each N regions
-  // created, N-1 duplicate (split) points are created. The split point
-  // replaces the current point ptId in the polygons connectivity array.
-  //
-  // Start by initializing the cells as unvisited
-  for (i = 0; i < ncells; i++)
-  {
-    this->Visited[cells[i]] = -1;
-  }
-
-  // Loop over all cells and mark the region that each is in.
-  //
-  vtkIdType numPts;
-  const vtkIdType* pts;
-  int numRegions = 0;
-  vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
-  double thisNormal[3], neiNormal[3];
-  for (j = 0; j < ncells; j++) // for all cells connected to point
-  {
-    if (this->Visited[cells[j]] < 0) // for all unvisited cells
-    {
-      this->Visited[cells[j]] = numRegions;
-      // okay, mark all the cells connected to this seed cell and using ptId
-      this->OldMesh->GetCellPoints(cells[j], numPts, pts);
-
-      // find the two edges
-      for (spot = 0; spot < numPts; spot++)
-      {
-        if (pts[spot] == ptId)
-        {
-          break;
-        }
-      }
-
-      if (spot == 0)
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[numPts - 1];
-      }
-      else if (spot == (numPts - 1))
-      {
-        neiPt[0] = pts[spot - 1];
-        neiPt[1] = pts[0];
-      }
-      else
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[spot - 1];
-      }
-
-      for (i = 0; i < 2; i++) // for each of the two edges of the seed cell
-      {
-        cellId = cells[j];
-        nei = neiPt[i];
-        while (cellId >= 0) // while we can grow this region
-        {
-          this->OldMesh->GetCellEdgeNeighbors(cellId, ptId, nei, this->CellIds);
-          if (this->CellIds->GetNumberOfIds() == 1 &&
-            this->Visited[(neiCellId = this->CellIds->GetId(0))] < 0)
-          {
-            this->PolyNormals->GetTuple(cellId, thisNormal);
-            this->PolyNormals->GetTuple(neiCellId, neiNormal);
-
-            if (vtkMath::Dot(thisNormal, neiNormal) > CosAngle)
-            {
-              // visit and arrange to visit next edge neighbor
-              this->Visited[neiCellId] = numRegions;
-              cellId = neiCellId;
-              this->OldMesh->GetCellPoints(cellId, numPts, pts);
-
-              for (spot = 0; spot < numPts; spot++)
-              {
-                if (pts[spot] == ptId)
-                {
-                  break;
-                }
-              }
-
-              if (spot == 0)
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
-              }
-              else if (spot == (numPts - 1))
-              {
-                nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
-              }
-              else
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
-              }
-
-            } // if not separated by edge angle
-            else
-            {
-              cellId = -1; // separated by edge angle
-            }
-          } // if can move to edge neighbor
-          else
-          {
-            cellId = -1; // separated by previous visit, boundary, or non-manifold
-          }
-        } // while visit wave is propagating
-      }   // for each of the two edges of the starting cell
-      numRegions++;
-    } // if cell is unvisited
-  }   // for all cells connected to point ptId
-
-  if (numRegions <= 1)
-  {
-    return; // a single region, no splitting ever required
-  }
-
-  // Okay, for all cells not in the first region, the ptId is
-  // replaced with a new ptId, which is a duplicate of the first
-  // point, but disconnected topologically.
-  //
-  vtkIdType lastId = this->Map->GetNumberOfIds();
-  vtkIdType replacementPoint;
-  for (j = 0; j < ncells; j++)
-  {
-    if (this->Visited[cells[j]] > 0) // replace point if splitting needed
-    {
-      replacementPoint = lastId + this->Visited[cells[j]] - 1;
-      this->Map->InsertId(replacementPoint, ptId);
-      this->NewMesh->ReplaceCellPoint(cells[j], ptId, replacementPoint);
-    } // if not in first regions and requiring splitting
-  }   // for all cells connected to ptId
-}
-
 void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
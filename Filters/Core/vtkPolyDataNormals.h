@@ -39,6 +39,11 @@
  * are split and new points generated to prevent blurry edges (due to
  * Gouraud shading).
  *
+ * The computation of the polygon normals, the splitting of sharp edges and
+ * the averaging at the points are multi-threaded using vtkSMPTools; the
+ * result does not depend on the number of threads. Enforcing consistent
+ * orientation (Consistency, AutoOrientNormals) remains sequential.
+ *
  * @warning
  * Normals are computed only for polygons and triangle strips. Normals are
  * not computed for lines or vertices.
@@ -197,7 +202,6 @@ private:
   vtkIdList* CellIds;
   vtkIdList* CellPoints;
   vtkIdList* NeighborPoints;
-  vtkIdList* Map;
   vtkPolyData* OldMesh;
   vtkPolyData* NewMesh;
   int* Visited;
@@ -208,11 +212,6 @@ private:
   // checked and properly ordered polygons.
   void TraverseAndOrder(void);
 
-  // Check the point id give to see whether it lies on a feature
-  // edge. If so, split the point (i.e., duplicate it) to topologically
-  // separate the mesh.
-  void MarkAndSplit(vtkIdType ptId);
-
 private:
   vtkPolyDataNormals(const vtkPolyDataNormals&) = delete;
   void operator=(const vtkPolyDataNormals&) = delete;
@@ -31,6 +31,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -637,67 +638,6 @@ void vtkProbeFilter::ProbeImagePointsInCell(vtkCell* cell, vtkIdType cellId, vtk
 }
 
 //------------------------------------------------------------------------------
-namespace
-{
-
-class CellStorage
-{
-public:
-  CellStorage() { this->Initialize(); }
-
-  ~CellStorage() { this->Clear(); }
-
-  // Copying does not make sense for this class but vtkSMPThreadLocal needs
-  // these functions to compile. Just initialize the object.
-  CellStorage(const CellStorage&) { this->Initialize(); }
-
-  CellStorage& operator=(const CellStorage& other)
-  {
-    if (this == &other)
-    {
-      return *this;
-    }
-
-    this->Clear();
-    this->Initialize();
-    return *this;
-  }
-
-  vtkCell* GetCell(vtkDataSet* dataset, vtkIdType cellId)
-  {
-    int celltype = dataset->GetCellType(cellId);
-    vtkGenericCell*& gc = this->Cells[celltype];
-    if (!gc)
-    {
-      gc = vtkGenericCell::New();
-    }
-    dataset->GetCell(cellId, gc);
-    return gc->GetRepresentativeCell();
-  }
-
-private:
-  void Initialize()
-  {
-    vtkGenericCell* null = nullptr;
-    std::fill(this->Cells, this->Cells + VTK_NUMBER_OF_CELL_TYPES, null);
-  }
-
-  void Clear()
-  {
-    for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
-    {
-      if (this->Cells[i])
-      {
-        this->Cells[i]->Delete();
-      }
-    }
-  }
-
-  vtkGenericCell* Cells[VTK_NUMBER_OF_CELL_TYPES];
-};
-
-} // anonymous namespace
-
 class vtkProbeFilter::ProbeImageDataWorklet
 {
 public:
@@ -731,10 +671,13 @@ public:
       weights = &dynamicweights[0];
     }
 
-    CellStorage& cs = this->Cells.Local();
+    // The generic cell keeps one cell of each type, reused for every cell
+    // of that type processed by this thread.
+    vtkGenericCell* gcell = this->Cells.Local();
     for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
     {
-      vtkCell* cell = cs.GetCell(this->Source, cellId);
+      this->Source->GetCell(cellId, gcell);
+      vtkCell* cell = gcell->GetRepresentativeCell();
       this->ProbeFilter->ProbeImagePointsInCell(cell, cellId, this->Source, this->SrcBlockId,
         this->Start, this->Spacing, this->Dim, this->OutPointData, this->MaskArray, weights);
     }
@@ -752,7 +695,7 @@ private:
   int MaxCellSize;
 
   vtkSMPThreadLocal<std::vector<double>> WeightsBuffer;
-  vtkSMPThreadLocal<CellStorage> Cells;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cells;
 };
 
 //------------------------------------------------------------------------------
@@ -46,17 +46,380 @@
 #include "vtkEdgeTable.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Compute the cost of collapsing the edge pt1-pt2 whose summed geometric
+// quadric is quad, and the point x that gives this cost.
+double ComputeGeometricCost(const double* quad, const double pt1[3], const double pt2[3], double* x)
+{
+  static const double errorNumber = 1e-10;
+  double temp[3], A[3][3], b[3];
+  double cost = 0.0;
+  const double* index;
+  int i, j;
+  double newPoint[4];
+  double v[3], c, norm, normTemp, temp2[3];
+
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
+
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
+
+  norm = vtkMath::Norm(A[0]);
+  normTemp = vtkMath::Norm(A[1]);
+  norm = norm > normTemp ? norm : normTemp;
+  normTemp = vtkMath::Norm(A[2]);
+  norm = norm > normTemp ? norm : normTemp;
+
+  if (fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
+  {
+    // it would be better to use the normal of the matrix to test singularity??
+    vtkMath::LinearSolve3x3(A, b, x);
+    vtkMath::Multiply3x3(A, x, temp);
+    // error too high, backup plans
+  }
+  else
+  {
+    // cheapest point along the edge
+    v[0] = pt2[0] - pt1[0];
+    v[1] = pt2[1] - pt1[1];
+    v[2] = pt2[2] - pt1[2];
+
+    // equation for the edge pt1 + c * v
+    // attempt least squares fit for c for A*(pt1 + c * v) = b
+    vtkMath::Multiply3x3(A, v, temp2);
+    if (vtkMath::Dot(temp2, temp2) > errorNumber)
+    {
+      vtkMath::Multiply3x3(A, pt1, temp);
+      for (i = 0; i < 3; i++)
+        temp[i] = b[i] - temp[i];
+      c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
+      for (i = 0; i < 3; i++)
+        x[i] = pt1[i] + c * v[i];
+    }
+    else
+    {
+      // use mid point
+      // might want to change to best of mid and end points??
+      for (i = 0; i < 3; i++)
+      {
+        x[i] = 0.5 * (pt1[i] + pt2[i]);
+      }
+    }
+  }
+
+  newPoint[0] = x[0];
+  newPoint[1] = x[1];
+  newPoint[2] = x[2];
+  newPoint[3] = 1;
+
+  // Compute the cost
+  // x'*quad*x
+  index = quad;
+  for (i = 0; i < 4; i++)
+  {
+    cost += (*index++) * newPoint[i] * newPoint[i];
+    for (j = i + 1; j < 4; j++)
+    {
+      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
+    }
+  }
+
+  return cost;
+}
+
+// Fraction of the edges of the mesh that are considered for a collapse in
+// each round of the parallel decimation.
+constexpr double ParallelCandidateFraction = 0.125;
+
+//------------------------------------------------------------------------------
+// The triangles using each point, in increasing triangle order. Deleted
+// triangles have their point ids set to -1.
+struct TriangleLinks
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Triangles;
+
+  void Build(const std::vector<vtkIdType>& tris, vtkIdType numPts)
+  {
+    const vtkIdType numTris = static_cast<vtkIdType>(tris.size() / 3);
+    std::vector<std::atomic<vtkIdType>> cursors(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        cursors[ptId].store(0, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+      for (const vtkIdType* tri = tris.data() + 3 * begin; tri != tris.data() + 3 * end; tri += 3)
+      {
+        if (tri[0] >= 0)
+        {
+          for (int i = 0; i < 3; ++i)
+          {
+            cursors[tri[i]].fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+    });
+
+    this->Offsets.resize(numPts + 1);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        this->Offsets[ptId] = cursors[ptId].load(std::memory_order_relaxed);
+      }
+    });
+    this->Offsets[numPts] = 0;
+    vtkSMPTools::ExclusiveScan(
+      this->Offsets.begin(), this->Offsets.end(), this->Offsets.begin(), vtkIdType(0));
+
+    this->Triangles.resize(this->Offsets[numPts]);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        cursors[ptId].store(this->Offsets[ptId], std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType triId = begin; triId < end; ++triId)
+      {
+        const vtkIdType* tri = tris.data() + 3 * triId;
+        if (tri[0] >= 0)
+        {
+          for (int i = 0; i < 3; ++i)
+          {
+            this->Triangles[cursors[tri[i]].fetch_add(1, std::memory_order_relaxed)] = triId;
+          }
+        }
+      }
+    });
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        std::sort(this->Triangles.begin() + this->Offsets[ptId],
+          this->Triangles.begin() + this->Offsets[ptId + 1]);
+      }
+    });
+  }
+
+  const vtkIdType* Begin(vtkIdType ptId) const
+  {
+    return this->Triangles.data() + this->Offsets[ptId];
+  }
+  const vtkIdType* End(vtkIdType ptId) const
+  {
+    return this->Triangles.data() + this->Offsets[ptId + 1];
+  }
+};
+
+//------------------------------------------------------------------------------
+// Scramble the points of an edge to order the edges of equal cost, which are
+// common on regular meshes: following the point numbering instead would let
+// only a few of them be collapsed in each round.
+std::uint64_t EdgeTieBreak(vtkIdType pt0Id, vtkIdType pt1Id)
+{
+  std::uint64_t x = static_cast<std::uint64_t>(pt0Id) * 0x9e3779b97f4a7c15ULL ^
+    static_cast<std::uint64_t>(pt1Id);
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+//------------------------------------------------------------------------------
+bool TriangleHasPoint(const vtkIdType* tri, vtkIdType ptId)
+{
+  return tri[0] == ptId || tri[1] == ptId || tri[2] == ptId;
+}
+
+//------------------------------------------------------------------------------
+// Compute the geometric quadrics of all the points, the same way as
+// InitializeQuadrics() and AddBoundaryConstraints() do, each thread summing
+// the contributions of the triangles of its points.
+void InitializeParallelQuadrics(const std::vector<double>& coords,
+  const std::vector<vtkIdType>& tris, const TriangleLinks& links, std::vector<double>& quadrics)
+{
+  const vtkIdType numPts = static_cast<vtkIdType>(coords.size() / 3);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double QEM[11];
+    double n[3], tempP1[3], tempP2[3], d, triArea2;
+    double e0[3], e1[3], c, w;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      double* quadric = quadrics.data() + 11 * ptId;
+
+      // the planes of the triangles
+      for (const vtkIdType* triId = links.Begin(ptId); triId != links.End(ptId); ++triId)
+      {
+        const vtkIdType* pts = tris.data() + 3 * *triId;
+        const double* point0 = coords.data() + 3 * pts[0];
+        const double* point1 = coords.data() + 3 * pts[1];
+        const double* point2 = coords.data() + 3 * pts[2];
+        for (int i = 0; i < 3; i++)
+        {
+          tempP1[i] = point1[i] - point0[i];
+          tempP2[i] = point2[i] - point0[i];
+        }
+        vtkMath::Cross(tempP1, tempP2, n);
+        triArea2 = vtkMath::Normalize(n) * 0.5;
+        d = -vtkMath::Dot(n, point0);
+
+        QEM[0] = n[0] * n[0];
+        QEM[1] = n[0] * n[1];
+        QEM[2] = n[0] * n[2];
+        QEM[3] = d * n[0];
+        QEM[4] = n[1] * n[1];
+        QEM[5] = n[1] * n[2];
+        QEM[6] = d * n[1];
+        QEM[7] = n[2] * n[2];
+        QEM[8] = d * n[2];
+        QEM[9] = d * d;
+        QEM[10] = 1;
+        for (int j = 0; j < 11; j++)
+        {
+          quadric[j] += QEM[j] * triArea2;
+        }
+      }
+
+      // the planes orthogonal to the free boundary edges
+      for (const vtkIdType* triId = links.Begin(ptId); triId != links.End(ptId); ++triId)
+      {
+        const vtkIdType* pts = tris.data() + 3 * *triId;
+        for (int i = 0; i < 3; i++)
+        {
+          const vtkIdType p1 = pts[i];
+          const vtkIdType p2 = pts[(i + 1) % 3];
+          if (p1 != ptId && p2 != ptId)
+          {
+            continue;
+          }
+          const vtkIdType numEdgeTris = std::count_if(links.Begin(p1), links.End(p1),
+            [&](vtkIdType other) { return TriangleHasPoint(tris.data() + 3 * other, p2); });
+          if (numEdgeTris != 1)
+          {
+            continue;
+          }
+          const double* t0 = coords.data() + 3 * pts[(i + 2) % 3];
+          const double* t1 = coords.data() + 3 * p1;
+          const double* t2 = coords.data() + 3 * p2;
+          for (int j = 0; j < 3; j++)
+          {
+            e0[j] = t2[j] - t1[j];
+            e1[j] = t0[j] - t1[j];
+          }
+          c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+          for (int j = 0; j < 3; j++)
+          {
+            n[j] = e1[j] - c * e0[j];
+          }
+          vtkMath::Normalize(n);
+          d = -vtkMath::Dot(n, t1);
+          w = vtkMath::Norm(e0);
+
+          QEM[0] = n[0] * n[0];
+          QEM[1] = n[0] * n[1];
+          QEM[2] = n[0] * n[2];
+          QEM[3] = d * n[0];
+          QEM[4] = n[1] * n[1];
+          QEM[5] = n[1] * n[2];
+          QEM[6] = d * n[1];
+          QEM[7] = n[2] * n[2];
+          QEM[8] = d * n[2];
+          QEM[9] = d * d;
+          QEM[10] = 1;
+          for (int j = 0; j < 11; j++)
+          {
+            quadric[j] += QEM[j] * w;
+          }
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Collect the edges of the live triangles, as pairs of point ids (p, q) with
+// p < q, sorted by p then q.
+void BuildParallelEdges(vtkIdType numPts, const std::vector<vtkIdType>& tris,
+  const TriangleLinks& links, std::vector<vtkIdType>& edges)
+{
+  vtkSMPThreadLocal<std::vector<vtkIdType>> neighborsTL;
+  auto getNeighbors = [&](vtkIdType ptId, std::vector<vtkIdType>& neighbors) {
+    neighbors.clear();
+    for (const vtkIdType* triId = links.Begin(ptId); triId != links.End(ptId); ++triId)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        const vtkIdType neighbor = tris[3 * *triId + i];
+        if (neighbor > ptId)
+        {
+          neighbors.push_back(neighbor);
+        }
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  };
+
+  std::vector<vtkIdType> edgeOffsets(numPts + 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<vtkIdType>& neighbors = neighborsTL.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      getNeighbors(ptId, neighbors);
+      edgeOffsets[ptId] = static_cast<vtkIdType>(neighbors.size());
+    }
+  });
+  edgeOffsets[numPts] = 0;
+  vtkSMPTools::ExclusiveScan(
+    edgeOffsets.begin(), edgeOffsets.end(), edgeOffsets.begin(), vtkIdType(0));
+
+  edges.resize(2 * edgeOffsets[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<vtkIdType>& neighbors = neighborsTL.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      getNeighbors(ptId, neighbors);
+      vtkIdType* edge = edges.data() + 2 * edgeOffsets[ptId];
+      for (vtkIdType neighbor : neighbors)
+      {
+        *edge++ = ptId;
+        *edge++ = neighbor;
+      }
+    }
+  });
+}
+}
+
 //------------------------------------------------------------------------------
 vtkQuadricDecimation::vtkQuadricDecimation()
 {
@@ -74,6 +437,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
 
   this->AttributeErrorMetric = 0;
   this->VolumePreservation = 0;
+  this->ParallelCollapses = 0;
   this->ScalarsAttribute = 1;
   this->VectorsAttribute = 1;
   this->NormalsAttribute = 1;
@@ -215,6 +579,14 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  // The parallel collapses only minimize the geometric error, without the
+  // volume preservation constraint.
+  if (this->ParallelCollapses && !this->AttributeErrorMetric && !this->VolumePreservation)
+  {
+    this->ParallelDecimate(input, output);
+    return 1;
+  }
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
   pointData = vtkPointData::New();
@@ -222,6 +594,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   // copy the input (only polys) to our working mesh
   this->Mesh = vtkPolyData::New();
+  this->Mesh->EditableOn(); // the links are modified by the collapses
   points->DeepCopy(input->GetPoints());
   this->Mesh->SetPoints(points);
   points->Delete();
@@ -849,15 +1222,9 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 {
-  static const double errorNumber = 1e-10;
-  double temp[3], A[3][3], b[3];
   vtkIdType pointIds[2];
-  double cost = 0.0;
-  double* index;
-  int i, j;
-  double newPoint[4];
-  double v[3], c, norm, normTemp, temp2[3];
   double pt1[3], pt2[3];
+  int i;
 
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
@@ -868,80 +1235,9 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
-
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
-
-  norm = vtkMath::Norm(A[0]);
-  normTemp = vtkMath::Norm(A[1]);
-  norm = norm > normTemp ? norm : normTemp;
-  normTemp = vtkMath::Norm(A[2]);
-  norm = norm > normTemp ? norm : normTemp;
-
-  if (fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
-  {
-    // it would be better to use the normal of the matrix to test singularity??
-    vtkMath::LinearSolve3x3(A, b, x);
-    vtkMath::Multiply3x3(A, x, temp);
-    // error too high, backup plans
-  }
-  else
-  {
-    // cheapest point along the edge
-    this->Mesh->GetPoints()->GetPoint(pointIds[0], pt1);
-    this->Mesh->GetPoints()->GetPoint(pointIds[1], pt2);
-    v[0] = pt2[0] - pt1[0];
-    v[1] = pt2[1] - pt1[1];
-    v[2] = pt2[2] - pt1[2];
-
-    // equation for the edge pt1 + c * v
-    // attempt least squares fit for c for A*(pt1 + c * v) = b
-    vtkMath::Multiply3x3(A, v, temp2);
-    if (vtkMath::Dot(temp2, temp2) > errorNumber)
-    {
-      vtkMath::Multiply3x3(A, pt1, temp);
-      for (i = 0; i < 3; i++)
-        temp[i] = b[i] - temp[i];
-      c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
-      for (i = 0; i < 3; i++)
-        x[i] = pt1[i] + c * v[i];
-    }
-    else
-    {
-      // use mid point
-      // might want to change to best of mid and end points??
-      for (i = 0; i < 3; i++)
-      {
-        x[i] = 0.5 * (pt1[i] + pt2[i]);
-      }
-    }
-  }
-
-  newPoint[0] = x[0];
-  newPoint[1] = x[1];
-  newPoint[2] = x[2];
-  newPoint[3] = 1;
-
-  // Compute the cost
-  // x'*quad*x
-  index = this->TempQuad;
-  for (i = 0; i < 4; i++)
-  {
-    cost += (*index++) * newPoint[i] * newPoint[i];
-    for (j = i + 1; j < 4; j++)
-    {
-      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
-    }
-  }
-
-  return cost;
+  this->Mesh->GetPoints()->GetPoint(pointIds[0], pt1);
+  this->Mesh->GetPoints()->GetPoint(pointIds[1], pt2);
+  return ComputeGeometricCost(this->TempQuad, pt1, pt2, x);
 }
 
 //------------------------------------------------------------------------------
@@ -1240,6 +1536,333 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
   return numDeleted;
 }
 
+//------------------------------------------------------------------------------
+void vtkQuadricDecimation::ParallelDecimate(vtkPolyData* input, vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Working copy of the points and of the triangles. Collapsed points keep
+  // their quadric but are not used by any triangle anymore.
+  std::vector<double> coords(3 * numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      input->GetPoint(ptId, coords.data() + 3 * ptId);
+    }
+  });
+  std::vector<vtkIdType> tris;
+  tris.reserve(3 * input->GetNumberOfPolys());
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* inPolys = input->GetPolys();
+  for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts);)
+  {
+    if (npts == 3)
+    {
+      tris.insert(tris.end(), pts, pts + 3);
+    }
+  }
+  const vtkIdType numTris = static_cast<vtkIdType>(tris.size() / 3);
+
+  vtkDebugMacro(<< "Computing Quadrics");
+  TriangleLinks links;
+  links.Build(tris, numPts);
+  std::vector<double> quadrics(11 * numPts, 0.0);
+  InitializeParallelQuadrics(coords, tris, links, quadrics);
+  this->UpdateProgress(0.15);
+
+  auto isAlive = [&](vtkIdType triId) { return tris[3 * triId] >= 0; };
+  auto deleteTriangle = [&](vtkIdType triId) {
+    std::fill_n(tris.begin() + 3 * triId, 3, vtkIdType(-1));
+  };
+
+  // Same test as IsGoodPlacement() on the working mesh.
+  auto isGoodPlacement = [&](vtkIdType pt0Id, vtkIdType pt1Id, const double* x) {
+    for (int side = 0; side < 2; ++side)
+    {
+      const vtkIdType ptId = side == 0 ? pt0Id : pt1Id;
+      const vtkIdType otherId = side == 0 ? pt1Id : pt0Id;
+      for (const vtkIdType* triId = links.Begin(ptId); triId != links.End(ptId); ++triId)
+      {
+        const vtkIdType* tri = tris.data() + 3 * *triId;
+        if (TriangleHasPoint(tri, otherId))
+        {
+          continue;
+        }
+        for (int i = 0; i < 3; i++)
+        {
+          if (tri[i] == ptId &&
+            !this->TrianglePlaneCheck(coords.data() + 3 * tri[i],
+              coords.data() + 3 * tri[(i + 1) % 3], coords.data() + 3 * tri[(i + 2) % 3], x))
+          {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  };
+
+  this->ActualReduction = 0.0;
+  this->NumberOfEdgeCollapses = 0;
+  vtkIdType numDeletedTris = 0;
+  std::vector<vtkIdType> edges;
+  std::vector<double> costs;
+  std::vector<double> targets;
+  std::vector<vtkIdType> candidates;
+  std::vector<unsigned char> winners;
+  std::vector<unsigned char> claimed(numTris);
+  int abort = 0;
+  while (!abort && numTris > 0 && this->ActualReduction < this->TargetReduction)
+  {
+    // Cost and target point of all the edges of the current mesh.
+    BuildParallelEdges(numPts, tris, links, edges);
+    const vtkIdType numEdges = static_cast<vtkIdType>(edges.size() / 2);
+    costs.resize(numEdges);
+    targets.resize(3 * numEdges);
+    vtkSMPTools::For(0, numEdges, [&](vtkIdType begin, vtkIdType end) {
+      double quad[11];
+      for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+      {
+        const vtkIdType pt0Id = edges[2 * edgeId];
+        const vtkIdType pt1Id = edges[2 * edgeId + 1];
+        for (int i = 0; i < 11; i++)
+        {
+          quad[i] = quadrics[11 * pt0Id + i] + quadrics[11 * pt1Id + i];
+        }
+        double* x = targets.data() + 3 * edgeId;
+        costs[edgeId] = ComputeGeometricCost(
+          quad, coords.data() + 3 * pt0Id, coords.data() + 3 * pt1Id, x);
+        if (!isGoodPlacement(pt0Id, pt1Id, x))
+        {
+          costs[edgeId] = VTK_DOUBLE_MAX;
+        }
+      }
+    });
+
+    // The cheapest edges, up to what is needed to reach the target reduction
+    // (a collapse usually deletes two triangles), are the candidates.
+    const double numRemainingTris = this->TargetReduction * numTris - numDeletedTris;
+    vtkIdType numCandidates = std::min(
+      static_cast<vtkIdType>(std::ceil(ParallelCandidateFraction * numEdges)),
+      static_cast<vtkIdType>(std::ceil(numRemainingTris / 2.0)));
+    numCandidates = std::max(std::min(numCandidates, numEdges), vtkIdType(1));
+    auto cheaper = [&](vtkIdType a, vtkIdType b) {
+      if (costs[a] != costs[b])
+      {
+        return costs[a] < costs[b];
+      }
+      const std::uint64_t tieA = EdgeTieBreak(edges[2 * a], edges[2 * a + 1]);
+      const std::uint64_t tieB = EdgeTieBreak(edges[2 * b], edges[2 * b + 1]);
+      return tieA < tieB || (tieA == tieB && a < b);
+    };
+    candidates.resize(numEdges);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    std::nth_element(
+      candidates.begin(), candidates.begin() + (numCandidates - 1), candidates.end(), cheaper);
+    vtkSMPTools::Sort(candidates.begin(), candidates.begin() + numCandidates, cheaper);
+    numCandidates = static_cast<vtkIdType>(
+      std::lower_bound(candidates.begin(), candidates.begin() + numCandidates, VTK_DOUBLE_MAX,
+        [&](vtkIdType edgeId, double cost) { return costs[edgeId] < cost; }) -
+      candidates.begin());
+
+    // The candidates are selected in order of increasing cost, skipping the
+    // ones that share a triangle with a selected one, so that the collapses
+    // of a round modify disjoint sets of triangles and points. This is cheap
+    // compared to the rest of the round and keeps the order of the sequential
+    // algorithm as much as possible.
+    std::fill(claimed.begin(), claimed.end(), 0);
+    winners.assign(numCandidates, 0);
+    for (vtkIdType rank = 0; rank < numCandidates; ++rank)
+    {
+      const vtkIdType* edge = edges.data() + 2 * candidates[rank];
+      auto isClaimed = [&](vtkIdType triId) { return claimed[triId] != 0; };
+      if (std::none_of(links.Begin(edge[0]), links.End(edge[0]), isClaimed) &&
+        std::none_of(links.Begin(edge[1]), links.End(edge[1]), isClaimed))
+      {
+        winners[rank] = 1;
+        for (int side = 0; side < 2; ++side)
+        {
+          for (const vtkIdType* triId = links.Begin(edge[side]); triId != links.End(edge[side]);
+               ++triId)
+          {
+            claimed[*triId] = 1;
+          }
+        }
+      }
+    }
+
+    // Collapse the winners, keeping the first point of their edge, the same
+    // way as CollapseEdge().
+    std::atomic<vtkIdType> numRoundCollapses(0);
+    std::atomic<vtkIdType> numRoundDeletedTris(0);
+    vtkSMPTools::For(0, numCandidates, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType numCollapses = 0;
+      vtkIdType numDeleted = 0;
+      for (vtkIdType rank = begin; rank < end; ++rank)
+      {
+        if (!winners[rank])
+        {
+          continue;
+        }
+        const vtkIdType edgeId = candidates[rank];
+        const vtkIdType pt0Id = edges[2 * edgeId];
+        const vtkIdType pt1Id = edges[2 * edgeId + 1];
+        std::copy_n(targets.data() + 3 * edgeId, 3, coords.data() + 3 * pt0Id);
+        for (int i = 0; i < 11; i++)
+        {
+          quadrics[11 * pt0Id + i] += quadrics[11 * pt1Id + i];
+        }
+
+        for (const vtkIdType* triId = links.Begin(pt0Id); triId != links.End(pt0Id); ++triId)
+        {
+          if (isAlive(*triId) && TriangleHasPoint(tris.data() + 3 * *triId, pt1Id))
+          {
+            deleteTriangle(*triId);
+            numDeleted++;
+          }
+        }
+        for (const vtkIdType* triId = links.Begin(pt1Id); triId != links.End(pt1Id); ++triId)
+        {
+          if (!isAlive(*triId))
+          {
+            continue;
+          }
+          vtkIdType newTri[3];
+          std::replace_copy(tris.begin() + 3 * *triId, tris.begin() + 3 * *triId + 3, newTri,
+            pt1Id, pt0Id);
+          // making sure we don't already have the triangle we're about to
+          // change this one to
+          auto isSame = [&](vtkIdType otherId) {
+            const vtkIdType* other = tris.data() + 3 * otherId;
+            return otherId != *triId && isAlive(otherId) && TriangleHasPoint(other, newTri[0]) &&
+              TriangleHasPoint(other, newTri[1]) && TriangleHasPoint(other, newTri[2]);
+          };
+          if (std::any_of(links.Begin(pt0Id), links.End(pt0Id), isSame) ||
+            std::any_of(links.Begin(pt1Id), triId, isSame))
+          {
+            deleteTriangle(*triId);
+            numDeleted++;
+          }
+          else
+          {
+            std::copy_n(newTri, 3, tris.begin() + 3 * *triId);
+          }
+        }
+        numCollapses++;
+      }
+      numRoundCollapses += numCollapses;
+      numRoundDeletedTris += numDeleted;
+    });
+
+    if (numRoundCollapses == 0)
+    {
+      break;
+    }
+    this->NumberOfEdgeCollapses += static_cast<int>(numRoundCollapses);
+    numDeletedTris += numRoundDeletedTris;
+    this->ActualReduction = static_cast<double>(numDeletedTris) / numTris;
+    vtkDebugMacro(<< "Collapsed " << numRoundCollapses << " edges out of " << numEdges);
+    this->UpdateProgress(
+      0.15 + 0.85 * std::min(this->ActualReduction / this->TargetReduction, 1.0));
+    abort = this->GetAbortExecute();
+
+    links.Build(tris, numPts);
+  }
+
+  vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses);
+
+  // Copy the live triangles to the output, numbering the points in order of
+  // first use like CopyCells() does.
+  std::vector<vtkIdType> cellMap(numTris + 1);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      cellMap[triId] = isAlive(triId) ? 1 : 0;
+    }
+  });
+  cellMap[numTris] = 0;
+  vtkSMPTools::ExclusiveScan(cellMap.begin(), cellMap.end(), cellMap.begin(), vtkIdType(0));
+  const vtkIdType numNewTris = cellMap[numTris];
+  const vtkIdType connSize = 3 * numNewTris;
+
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  vtkIdType* connPtr = conn->GetPointer(0);
+  std::vector<std::atomic<vtkIdType>> firstUse(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstUse[ptId].store(connSize, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      if (!isAlive(triId))
+      {
+        continue;
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        const vtkIdType position = 3 * cellMap[triId] + i;
+        const vtkIdType ptId = tris[3 * triId + i];
+        connPtr[position] = ptId;
+        std::atomic<vtkIdType>& ptFirstUse = firstUse[ptId];
+        vtkIdType current = ptFirstUse.load(std::memory_order_relaxed);
+        while (position < current &&
+          !ptFirstUse.compare_exchange_weak(current, position, std::memory_order_relaxed))
+        {
+        }
+      }
+    }
+  });
+
+  std::vector<vtkIdType> usedIds(connSize + 1);
+  vtkSMPTools::For(0, connSize, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType position = begin; position < end; ++position)
+    {
+      usedIds[position] =
+        firstUse[connPtr[position]].load(std::memory_order_relaxed) == position ? 1 : 0;
+    }
+  });
+  usedIds[connSize] = 0;
+  vtkSMPTools::ExclusiveScan(usedIds.begin(), usedIds.end(), usedIds.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = usedIds[connSize];
+
+  vtkNew<vtkPoints> newPoints;
+  newPoints->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, connSize, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType position = begin; position < end; ++position)
+    {
+      const vtkIdType ptId = connPtr[position];
+      const vtkIdType ptFirstUse = firstUse[ptId].load(std::memory_order_relaxed);
+      const vtkIdType newId = usedIds[ptFirstUse];
+      if (ptFirstUse == position)
+      {
+        newPoints->SetPoint(newId, coords.data() + 3 * ptId);
+      }
+      connPtr[position] = newId;
+    }
+  });
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewTris + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkSMPTools::For(0, numNewTris + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      offsetsPtr[triId] = 3 * triId;
+    }
+  });
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->SetData(offsets, conn);
+
+  output->Reset();
+  output->SetPoints(newPoints);
+  output->SetPolys(newPolys);
+}
+
 // triangle t0, t1, t2 and point x
 // determines if t0 and x are on the same side of the plane defined by
 // t1 and t2, and parallel to the normal of the triangle
@@ -1455,6 +2078,7 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Attribute Error Metric: " << (this->AttributeErrorMetric ? "On\n" : "Off\n");
   os << indent << "Volume Preservation: " << (this->VolumePreservation ? "On\n" : "Off\n");
+  os << indent << "Parallel Collapses: " << (this->ParallelCollapses ? "On\n" : "Off\n");
   os << indent << "Scalars Attribute: " << (this->ScalarsAttribute ? "On\n" : "Off\n");
   os << indent << "Vectors Attribute: " << (this->VectorsAttribute ? "On\n" : "Off\n");
   os << indent << "Normals Attribute: " << (this->NormalsAttribute ? "On\n" : "Off\n");
@@ -48,6 +48,14 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * When ParallelCollapses is on (and AttributeErrorMetric and
+ * VolumePreservation are off), the priority queue is replaced by rounds of
+ * collapses computed with vtkSMPTools: in each round, the cheapest edges that
+ * do not share a triangle with a cheaper selected edge are collapsed
+ * concurrently, and the costs are updated in parallel. This scales with the
+ * number of threads, and gives a mesh with an error comparable to, but not
+ * identical to, the one of the sequential algorithm.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -148,6 +156,19 @@ public:
   vtkGetMacro(TensorsWeight, double);
   //@}
 
+  //@{
+  /**
+   * Decide whether to decimate with rounds of independent edge collapses
+   * performed in parallel instead of one collapse at a time. The output
+   * differs from the sequential one: the collapse order is only
+   * approximately the order of increasing cost. This is ignored when
+   * AttributeErrorMetric or VolumePreservation is on. Off by default.
+   */
+  vtkSetMacro(ParallelCollapses, vtkTypeBool);
+  vtkGetMacro(ParallelCollapses, vtkTypeBool);
+  vtkBooleanMacro(ParallelCollapses, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Get the actual reduction. This value is only valid after the
@@ -210,6 +231,12 @@ protected:
    */
   vtkIdType GetEdgeCellId(vtkIdType p1Id, vtkIdType p2Id);
 
+  /**
+   * Decimate the triangles of the input with rounds of parallel collapses of
+   * independent edges, see ParallelCollapses.
+   */
+  void ParallelDecimate(vtkPolyData* input, vtkPolyData* output);
+
   int IsGoodPlacement(vtkIdType pt0Id, vtkIdType pt1Id, const double* x);
   int TrianglePlaneCheck(
     const double t0[3], const double t1[3], const double t2[3], const double* x);
@@ -234,6 +261,7 @@ protected:
   double ActualReduction;
   vtkTypeBool AttributeErrorMetric;
   vtkTypeBool VolumePreservation;
+  vtkTypeBool ParallelCollapses;
 
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
@@ -17,19 +17,26 @@
 #include "vtkArrayDispatch.h"
 #include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkStaticCleanPolyData);
 
@@ -37,18 +44,21 @@ namespace
 { // anonymous
 
 //------------------------------------------------------------------------------
-// Fast, threaded way to copy new points and attribute data to output.
+// Fast, threaded way to copy new points and attribute data to output. Only
+// the points that are kept (i.e., not merged into another point) are copied.
 template <typename InArrayT, typename OutArrayT>
 struct CopyPointsAlgorithm
 {
-  vtkIdType* PtMap;
+  const vtkIdType* MergeMap;
+  const vtkIdType* PtMap;
   InArrayT* InPts;
   OutArrayT* OutPts;
   ArrayList Arrays;
 
-  CopyPointsAlgorithm(vtkIdType* ptMap, InArrayT* inPts, vtkPointData* inPD, vtkIdType numNewPts,
-    OutArrayT* outPts, vtkPointData* outPD)
-    : PtMap(ptMap)
+  CopyPointsAlgorithm(const vtkIdType* mergeMap, const vtkIdType* ptMap, InArrayT* inPts,
+    vtkPointData* inPD, vtkIdType numNewPts, OutArrayT* outPts, vtkPointData* outPD)
+    : MergeMap(mergeMap)
+    , PtMap(ptMap)
     , InPts(inPts)
     , OutPts(outPts)
   {
@@ -59,6 +69,7 @@ struct CopyPointsAlgorithm
   {
     using OutValueT = vtk::GetAPIType<OutArrayT>;
 
+    const vtkIdType* mergeMap = this->MergeMap;
     const vtkIdType* ptMap = this->PtMap;
 
     const auto inPoints = vtk::DataArrayTupleRange<3>(this->InPts);
@@ -66,9 +77,9 @@ struct CopyPointsAlgorithm
 
     for (; ptId < endPtId; ++ptId)
     {
-      const vtkIdType outPtId = ptMap[ptId];
-      if (outPtId != -1)
+      if (mergeMap[ptId] == ptId)
       {
+        const vtkIdType outPtId = ptMap[ptId];
         const auto inP = inPoints[ptId];
         auto outP = outPoints[outPtId];
         outP[0] = static_cast<OutValueT>(inP[0]);
@@ -83,17 +94,209 @@ struct CopyPointsAlgorithm
 struct CopyPointsLauncher
 {
   template <typename InArrayT, typename OutArrayT>
-  void operator()(InArrayT* inPts, OutArrayT* outPts, vtkIdType* ptMap, vtkPointData* inPD,
-    vtkIdType numNewPts, vtkPointData* outPD)
+  void operator()(InArrayT* inPts, OutArrayT* outPts, const vtkIdType* mergeMap,
+    const vtkIdType* ptMap, vtkPointData* inPD, vtkIdType numNewPts, vtkPointData* outPD)
   {
     const vtkIdType numPts = inPts->GetNumberOfTuples();
 
-    CopyPointsAlgorithm<InArrayT, OutArrayT> algo{ ptMap, inPts, inPD, numNewPts, outPts, outPD };
+    CopyPointsAlgorithm<InArrayT, OutArrayT> algo{ mergeMap, ptMap, inPts, inPD, numNewPts, outPts,
+      outPD };
 
     vtkSMPTools::For(0, numPts, algo);
   }
 };
 
+//------------------------------------------------------------------------------
+// The output cell arrays, in the order in which their cell data is stored.
+enum OutputCells : signed char
+{
+  NoCells = -1,
+  Verts = 0,
+  Lines = 1,
+  Polys = 2,
+  Strips = 3,
+  NumberOfOutputCells = 4
+};
+
+// Decide which output cell array each input cell of one cell array goes to
+// (a degenerate cell may be converted to a simpler type, or be removed), and
+// with how many points. The input cells are numbered across the verts,
+// lines, polys and strips in this order, as their cell data.
+struct ClassifyCells
+{
+  vtkCellArray* Cells;
+  OutputCells InputType;
+  vtkIdType CellOffset;
+  const vtkIdType* PtMap;
+  bool LinesToPoints;
+  bool PolysToLines;
+  bool StripsToPolys;
+  signed char* Destinations;
+  vtkIdType* Sizes;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterators;
+  vtkSMPThreadLocal<std::array<vtkIdType, NumberOfOutputCells>> LocalCounts;
+  std::array<vtkIdType, NumberOfOutputCells> Counts;
+
+  ClassifyCells(vtkCellArray* cells, OutputCells inputType, vtkIdType cellOffset,
+    const vtkIdType* ptMap, vtkStaticCleanPolyData* filter, signed char* destinations,
+    vtkIdType* sizes)
+    : Cells(cells)
+    , InputType(inputType)
+    , CellOffset(cellOffset)
+    , PtMap(ptMap)
+    , LinesToPoints(filter->GetConvertLinesToPoints() != 0)
+    , PolysToLines(filter->GetConvertPolysToLines() != 0)
+    , StripsToPolys(filter->GetConvertStripsToPolys() != 0)
+    , Destinations(destinations)
+    , Sizes(sizes)
+  {
+    this->Counts.fill(0);
+  }
+
+  void Initialize()
+  {
+    this->Iterators.Local().TakeReference(this->Cells->NewIterator());
+    this->LocalCounts.Local().fill(0);
+  }
+
+  OutputCells Classify(vtkIdType npts, const vtkIdType* pts, vtkIdType& numCellPts) const
+  {
+    numCellPts = npts;
+    switch (this->InputType)
+    {
+      case Verts:
+        return npts > 0 ? Verts : NoCells;
+      case Lines:
+        if (npts > 1 || !this->LinesToPoints)
+        {
+          return Lines;
+        }
+        return npts == 1 ? Verts : NoCells;
+      case Polys:
+        if (npts > 2 && this->PtMap[pts[0]] == this->PtMap[pts[npts - 1]])
+        {
+          numCellPts--;
+        }
+        if (numCellPts > 2 || !this->PolysToLines)
+        {
+          return Polys;
+        }
+        if (numCellPts == 2 || !this->LinesToPoints)
+        {
+          return Lines;
+        }
+        return numCellPts == 1 ? Verts : NoCells;
+      default:
+        if (npts > 3 || !this->StripsToPolys)
+        {
+          return Strips;
+        }
+        if (npts == 3 || !this->PolysToLines)
+        {
+          return Polys;
+        }
+        if (npts == 2 || !this->LinesToPoints)
+        {
+          return Lines;
+        }
+        return npts == 1 ? Verts : NoCells;
+    }
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterators.Local();
+    std::array<vtkIdType, NumberOfOutputCells>& counts = this->LocalCounts.Local();
+    vtkIdType npts, numCellPts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      const OutputCells type = this->Classify(npts, pts, numCellPts);
+      this->Destinations[this->CellOffset + cellId] = type;
+      if (type != NoCells)
+      {
+        this->Sizes[this->CellOffset + cellId] = numCellPts;
+        counts[type]++;
+      }
+      else
+      {
+        this->Sizes[this->CellOffset + cellId] = 0;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (const auto& counts : this->LocalCounts)
+    {
+      for (int type = 0; type < NumberOfOutputCells; ++type)
+      {
+        this->Counts[type] += counts[type];
+      }
+    }
+  }
+};
+
+// Copy the input cells of one cell array that go to the output cell array
+// being built, with their new point ids and their cell data. CellIds and
+// ConnOffsets are the prefix sums of the output cells and of their sizes
+// over all the input cells. When the cell data cannot be copied in parallel,
+// CellArrays is null and the input cell of each output cell is recorded in
+// InCellIds instead.
+struct CopyCells
+{
+  vtkCellArray* Cells;
+  vtkIdType CellOffset;
+  OutputCells OutputType;
+  vtkIdType OutputCellOffset;
+  const signed char* Destinations;
+  const vtkIdType* CellIds;
+  const vtkIdType* ConnOffsets;
+  const vtkIdType* PtMap;
+  vtkIdType* OutOffsets;
+  vtkIdType* OutConn;
+  ArrayList* CellArrays;
+  vtkIdType* InCellIds;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterators;
+
+  void Initialize() { this->Iterators.Local().TakeReference(this->Cells->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterators.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType inCellId = this->CellOffset + cellId;
+      if (this->Destinations[inCellId] != this->OutputType)
+      {
+        continue;
+      }
+      iter->GetCellAtId(cellId, npts, pts);
+      const vtkIdType outCellId = this->CellIds[inCellId];
+      const vtkIdType offset = this->ConnOffsets[inCellId];
+      const vtkIdType numCellPts = this->ConnOffsets[inCellId + 1] - offset;
+      this->OutOffsets[outCellId] = offset;
+      for (vtkIdType i = 0; i < numCellPts; ++i)
+      {
+        this->OutConn[offset + i] = this->PtMap[pts[i]];
+      }
+      if (this->CellArrays)
+      {
+        this->CellArrays->Copy(inCellId, this->OutputCellOffset + outCellId);
+      }
+      else
+      {
+        this->InCellIds[this->OutputCellOffset + outCellId] = inCellId;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -174,30 +377,20 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
-  vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
-
-  // we'll be needing these
-  vtkIdType inCellID, newId;
-  vtkIdType i;
-  vtkIdType ptId;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
 
-  vtkCellArray *inVerts = input->GetVerts(), *newVerts = nullptr;
-  vtkCellArray *inLines = input->GetLines(), *newLines = nullptr;
-  vtkCellArray *inPolys = input->GetPolys(), *newPolys = nullptr;
-  vtkCellArray *inStrips = input->GetStrips(), *newStrips = nullptr;
+  vtkCellArray* inCells[NumberOfOutputCells] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
 
   vtkPointData* inPD = input->GetPointData();
   vtkCellData* inCD = input->GetCellData();
 
   // The merge map indicates which points are merged with what points
-  vtkIdType* mergeMap = new vtkIdType[numPts];
+  std::vector<vtkIdType> mergeMap(numPts);
   this->Locator->SetDataSet(input);
   this->Locator->BuildLocator();
   double tol =
     (this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength());
-  this->Locator->MergePoints(tol, mergeMap);
+  this->Locator->MergePoints(tol, mergeMap.data());
 
   vtkPointData* outPD = output->GetPointData();
   vtkCellData* outCD = output->GetCellData();
@@ -206,25 +399,32 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
 
   // Prefix sum: count the number of new points; allocate memory. Populate the
   // point map (old points to new).
-  vtkIdType* pointMap = new vtkIdType[numPts];
-  vtkIdType id, numNewPts = 0;
-  // Count and map points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] == id)
+  std::vector<vtkIdType> pointMap(numPts + 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pointMap[id] = numNewPts++;
+      pointMap[id] = (mergeMap[id] == id ? 1 : 0);
     }
-  }
-  // Now map old merged points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] != id)
+  });
+  pointMap[numPts] = 0;
+  vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end(), pointMap.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = pointMap[numPts];
+  // Now map old merged points to new points. Points are always merged into
+  // points with a smaller id, which may themselves have been merged.
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pointMap[id] = pointMap[mergeMap[id]];
+      vtkIdType mergedId = mergeMap[id];
+      if (mergedId != id)
+      {
+        while (mergeMap[mergedId] != mergedId)
+        {
+          mergedId = mergeMap[mergedId];
+        }
+        pointMap[id] = pointMap[mergedId];
+      }
     }
-  }
-  delete[] mergeMap;
+  });
 
   vtkPoints* newPts = inPts->NewInstance();
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
@@ -249,311 +449,142 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<FastValueTypes, FastValueTypes>;
 
   CopyPointsLauncher launcher;
-  if (!Dispatcher::Execute(inArray, outArray, launcher, pointMap, inPD, numNewPts, outPD))
+  if (!Dispatcher::Execute(
+        inArray, outArray, launcher, mergeMap.data(), pointMap.data(), inPD, numNewPts, outPD))
   { // Fallback to slow path for unusual types:
-    launcher(inArray, outArray, pointMap, inPD, numNewPts, outPD);
+    launcher(inArray, outArray, mergeMap.data(), pointMap.data(), inPD, numNewPts, outPD);
   }
+  this->UpdateProgress(0.25);
 
-  // Finally, remap the topology to use new point ids. Celldata needs to be
-  // copied correctly. If a poly is converted to a line, or a line to a
-  // point, then using a CellCounter will not do, as the cells should be
-  // ordered verts, lines, polys, strips. We need to maintain separate cell
-  // data lists so we can copy them all correctly. Tedious but easy to
-  // implement. We can use outCD for vertex cell data, then add the rest
-  // at the end.
-  vtkCellData* outLineData = nullptr;
-  vtkCellData* outPolyData = nullptr;
-  vtkCellData* outStrpData = nullptr;
-  vtkIdType vertIDcounter = 0, lineIDcounter = 0;
-  vtkIdType polyIDcounter = 0, strpIDcounter = 0;
-
-  // Begin to adjust topology.
-  //
-  // Vertices are renumbered and we remove duplicates
-  vtkIdType numCellPts;
-  inCellID = 0;
-  if (!this->GetAbortExecute() && inVerts->GetNumberOfCells() > 0)
+  // Finally, remap the topology to use new point ids. A degenerate cell may
+  // be converted to a simpler type (e.g. a poly to a line), and the output
+  // cells and their cell data must be ordered verts, lines, polys, strips.
+  // So the input cells are first classified in parallel, then each output
+  // cell array is filled in parallel, using prefix sums over the input cells
+  // to locate the output cells and their connectivity.
+  vtkIdType inCellOffsets[NumberOfOutputCells + 1];
+  inCellOffsets[0] = 0;
+  for (int type = 0; type < NumberOfOutputCells; ++type)
   {
-    newVerts = vtkCellArray::New();
-    newVerts->AllocateEstimate(inVerts->GetNumberOfCells(), 1);
-
-    vtkDebugMacro(<< "Starting Verts " << inCellID);
-    for (inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts); inCellID++)
+    inCellOffsets[type + 1] = inCellOffsets[type] + inCells[type]->GetNumberOfCells();
+  }
+  const vtkIdType numCells = inCellOffsets[NumberOfOutputCells];
+  std::vector<signed char> destinations(numCells);
+  std::vector<vtkIdType> sizes(numCells);
+  vtkIdType numNewCells[NumberOfOutputCells] = { 0, 0, 0, 0 };
+  for (int type = 0; type < NumberOfOutputCells; ++type)
+  {
+    if (inCells[type]->GetNumberOfCells() > 0)
     {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      } // for all points of vertex cell
-
-      if (numCellPts > 0)
+      ClassifyCells classify(inCells[type], static_cast<OutputCells>(type), inCellOffsets[type],
+        pointMap.data(), this, destinations.data(), sizes.data());
+      vtkSMPTools::For(0, inCells[type]->GetNumberOfCells(), classify);
+      for (int outType = 0; outType < NumberOfOutputCells; ++outType)
       {
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in vertex test");
-        }
-        vertIDcounter++;
+        numNewCells[outType] += classify.Counts[outType];
       }
     }
   }
-  this->UpdateProgress(0.25);
-
-  // lines reduced to one point are eliminated or made into verts
-  if (!this->GetAbortExecute() && inLines->GetNumberOfCells() > 0)
+  this->UpdateProgress(0.5);
+
+  // The cell data is copied in parallel when all its arrays are data arrays
+  // of a type known to ArrayList, without promoting them to float. Otherwise,
+  // e.g. for string arrays, it is copied afterwards with CopyData().
+  const vtkIdType numOutCells =
+    std::accumulate(numNewCells, numNewCells + NumberOfOutputCells, vtkIdType(0));
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, inCD, outCD, 0.0, false);
+  bool parallelCellData = true;
+  for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
   {
-    newLines = vtkCellArray::New();
-    newLines->AllocateEstimate(inLines->GetNumberOfCells(), 2);
-    outLineData = vtkCellData::New();
-    outLineData->CopyAllocate(inCD);
-    //
-    vtkDebugMacro(<< "Starting Lines " << inCellID);
-    for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts); inCellID++)
+    vtkAbstractArray* outArray = outCD->GetAbstractArray(i);
+    if (std::none_of(cellArrays.Arrays.begin(), cellArrays.Arrays.end(),
+          [outArray](BaseArrayPair* pair) { return pair->OutputArray == outArray; }))
     {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      } // for all cell points
-
-      if ((numCellPts > 1) || !this->ConvertLinesToPoints)
-      {
-        newId = newLines->InsertNextCell(numCellPts, updatedPts);
-        outLineData->CopyData(inCD, inCellID, newId);
-        if (lineIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Line ID fault in line test");
-        }
-        lineIDcounter++;
-      }
-      else if (numCellPts == 1)
-      {
-        if (!newVerts)
-        {
-          newVerts = vtkCellArray::New();
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in line test");
-        }
-        vertIDcounter++;
-      }
+      parallelCellData = false;
     }
-    vtkDebugMacro(<< "Removed " << inLines->GetNumberOfCells() - newLines->GetNumberOfCells()
-                  << " lines");
   }
-  this->UpdateProgress(0.50);
+  std::vector<vtkIdType> inCellIds(parallelCellData ? 0 : numOutCells);
 
-  // polygons reduced to two points or less are either eliminated
-  // or converted to lines or points if enabled
-  if (!this->GetAbortExecute() && inPolys->GetNumberOfCells() > 0)
+  std::vector<vtkIdType> cellIds(numCells + 1);
+  std::vector<vtkIdType> connOffsets(numCells + 1);
+  vtkIdType outCellOffset = 0;
+  vtkSmartPointer<vtkCellArray> newCells[NumberOfOutputCells];
+  for (int outType = 0; outType < NumberOfOutputCells && !this->GetAbortExecute(); ++outType)
   {
-    newPolys = vtkCellArray::New();
-    newPolys->AllocateCopy(inPolys);
-    outPolyData = vtkCellData::New();
-    outPolyData->CopyAllocate(inCD);
-
-    vtkDebugMacro(<< "Starting Polys " << inCellID);
-    for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); inCellID++)
+    if (numNewCells[outType] == 0)
     {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      } // for points in cell
-
-      if (numCellPts > 2 && updatedPts[0] == updatedPts[numCellPts - 1])
-      {
-        numCellPts--;
-      }
-      if ((numCellPts > 2) || !this->ConvertPolysToLines)
+      continue;
+    }
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
       {
-        newId = newPolys->InsertNextCell(numCellPts, updatedPts);
-        outPolyData->CopyData(inCD, inCellID, newId);
-        if (polyIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Poly ID fault in poly test");
-        }
-        polyIDcounter++;
+        const bool isOutput = destinations[cellId] == outType;
+        cellIds[cellId] = isOutput ? 1 : 0;
+        connOffsets[cellId] = isOutput ? sizes[cellId] : 0;
       }
-      else if ((numCellPts == 2) || !this->ConvertLinesToPoints)
-      {
-        if (!newLines)
-        {
-          newLines = vtkCellArray::New();
-          newLines->AllocateEstimate(5, 2);
-          outLineData = vtkCellData::New();
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(numCellPts, updatedPts);
-        outLineData->CopyData(inCD, inCellID, newId);
-        if (lineIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Line ID fault in poly test");
-        }
-        lineIDcounter++;
-      }
-      else if (numCellPts == 1)
+    });
+    cellIds[numCells] = 0;
+    connOffsets[numCells] = 0;
+    vtkSMPTools::ExclusiveScan(cellIds.begin(), cellIds.end(), cellIds.begin(), vtkIdType(0));
+    vtkSMPTools::ExclusiveScan(
+      connOffsets.begin(), connOffsets.end(), connOffsets.begin(), vtkIdType(0));
+    const vtkIdType connSize = connOffsets[numCells];
+
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numNewCells[outType] + 1);
+    offsets->SetValue(numNewCells[outType], connSize);
+    vtkNew<vtkIdTypeArray> conn;
+    conn->SetNumberOfValues(connSize);
+    for (int type = 0; type < NumberOfOutputCells; ++type)
+    {
+      if (inCells[type]->GetNumberOfCells() > 0)
       {
-        if (!newVerts)
-        {
-          newVerts = vtkCellArray::New();
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in poly test");
-        }
-        vertIDcounter++;
+        CopyCells copy{ inCells[type], inCellOffsets[type], static_cast<OutputCells>(outType),
+          outCellOffset, destinations.data(), cellIds.data(), connOffsets.data(),
+          pointMap.data(), offsets->GetPointer(0), conn->GetPointer(0),
+          parallelCellData ? &cellArrays : nullptr, inCellIds.data(), {} };
+        vtkSMPTools::For(0, inCells[type]->GetNumberOfCells(), copy);
       }
     }
-    vtkDebugMacro(<< "Removed " << inPolys->GetNumberOfCells() - newPolys->GetNumberOfCells()
-                  << " polys");
+    newCells[outType] = vtkSmartPointer<vtkCellArray>::New();
+    newCells[outType]->SetData(offsets, conn);
+    outCellOffset += numNewCells[outType];
+    this->UpdateProgress(0.5 + 0.125 * (outType + 1));
   }
-  this->UpdateProgress(0.75);
 
-  // triangle strips can reduced to polys/lines/points etc
-  if (!this->GetAbortExecute() && inStrips->GetNumberOfCells() > 0)
+  if (!parallelCellData)
   {
-    newStrips = vtkCellArray::New();
-    newStrips->AllocateCopy(inStrips);
-    outStrpData = vtkCellData::New();
-    outStrpData->CopyAllocate(inCD);
-
-    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts); inCellID++)
+    for (vtkIdType cellId = 0; cellId < outCellOffset; ++cellId)
     {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      }
-      if ((numCellPts > 3) || !this->ConvertStripsToPolys)
-      {
-        newId = newStrips->InsertNextCell(numCellPts, updatedPts);
-        outStrpData->CopyData(inCD, inCellID, newId);
-        if (strpIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Strip ID fault in strip test");
-        }
-        strpIDcounter++;
-      }
-      else if ((numCellPts == 3) || !this->ConvertPolysToLines)
-      {
-        if (!newPolys)
-        {
-          newPolys = vtkCellArray::New();
-          newPolys->AllocateEstimate(5, 3);
-          outPolyData = vtkCellData::New();
-          outPolyData->CopyAllocate(inCD);
-        }
-        newId = newPolys->InsertNextCell(numCellPts, updatedPts);
-        outPolyData->CopyData(inCD, inCellID, newId);
-        if (polyIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Poly ID fault in strip test");
-        }
-        polyIDcounter++;
-      }
-      else if ((numCellPts == 2) || !this->ConvertLinesToPoints)
-      {
-        if (!newLines)
-        {
-          newLines = vtkCellArray::New();
-          newLines->AllocateEstimate(5, 2);
-          outLineData = vtkCellData::New();
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(numCellPts, updatedPts);
-        outLineData->CopyData(inCD, inCellID, newId);
-        if (lineIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Line ID fault in strip test");
-        }
-        lineIDcounter++;
-      }
-      else if (numCellPts == 1)
-      {
-        if (!newVerts)
-        {
-          newVerts = vtkCellArray::New();
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in strip test");
-        }
-        vertIDcounter++;
-      }
+      outCD->CopyData(inCD, inCellIds[cellId], cellId);
     }
-    vtkDebugMacro(<< "Removed " << inStrips->GetNumberOfCells() - newStrips->GetNumberOfCells()
-                  << " strips");
   }
 
-  vtkDebugMacro(<< "Removed " << numNewPts - newPts->GetNumberOfPoints() << " points");
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
+  vtkDebugMacro(<< "Removed " << numCells - outCellOffset << " cells");
 
   // Update ourselves and release memory
   //
   this->Locator->Initialize(); // release memory.
-  delete[] updatedPts;
-  delete[] pointMap;
-
-  // Now transfer all CellData from Lines/Polys/Strips into final
-  // Cell data output
-  vtkIdType combinedCellID = vertIDcounter;
-  if (newLines)
-  {
-    for (i = 0; i < lineIDcounter; ++i, ++combinedCellID)
-    {
-      outCD->CopyData(outLineData, i, combinedCellID);
-    }
-    outLineData->Delete();
-  }
-  if (newPolys)
-  {
-    for (i = 0; i < polyIDcounter; ++i, ++combinedCellID)
-    {
-      outCD->CopyData(outPolyData, i, combinedCellID);
-    }
-    outPolyData->Delete();
-  }
-  if (newStrips)
-  {
-    for (i = 0; i < strpIDcounter; ++i, ++combinedCellID)
-    {
-      outCD->CopyData(outStrpData, i, combinedCellID);
-    }
-    outStrpData->Delete();
-  }
 
   output->SetPoints(newPts);
   newPts->Delete();
-  if (newVerts)
+  if (newCells[Verts])
   {
-    output->SetVerts(newVerts);
-    newVerts->Delete();
+    output->SetVerts(newCells[Verts]);
   }
-  if (newLines)
+  if (newCells[Lines])
   {
-    output->SetLines(newLines);
-    newLines->Delete();
+    output->SetLines(newCells[Lines]);
   }
-  if (newPolys)
+  if (newCells[Polys])
   {
-    output->SetPolys(newPolys);
-    newPolys->Delete();
+    output->SetPolys(newCells[Polys]);
   }
-  if (newStrips)
+  if (newCells[Strips])
   {
-    output->SetStrips(newStrips);
-    newStrips->Delete();
+    output->SetStrips(newCells[Strips]);
   }
 
   return 1;
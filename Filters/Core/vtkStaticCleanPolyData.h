@@ -59,9 +59,11 @@
  * vtkVertexGlyphFilter) before using the vtkStaticCleanPolyData filter.
  *
  * @warning
- * This class has been threaded with vtkSMPTools. Using TBB or other
- * non-sequential type (set in the CMake variable
- * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ * This class has been threaded with vtkSMPTools: point merging, the
+ * renumbering and conversion of the cells, and the copy of the point and
+ * cell data all run in parallel. Using TBB or other non-sequential type (set
+ * in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE) may improve performance
+ * significantly.
  *
  * @sa
  * vtkCleanPolyData
@@ -15,17 +15,26 @@
 #include "vtkThreshold.h"
 
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
@@ -152,7 +161,6 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   outCD->CopyAllocate(cd);
 
   numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
 
   newPoints = vtkPoints::New();
 
@@ -178,104 +186,260 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
     newPoints->SetDataType(VTK_DOUBLE);
   }
 
-  newPoints->Allocate(numPts);
-
-  pointMap = vtkIdList::New(); // maps old point ids into new
-  pointMap->SetNumberOfIds(numPts);
-  for (i = 0; i < numPts; i++)
-  {
-    pointMap->SetId(i, -1);
-  }
-
-  newCellPts = vtkIdList::New();
-
   // are we using pointScalars?
   int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
   bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
 
-  // Check that the scalars of each cell satisfy the threshold criterion
-  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
+  vtkUnstructuredGrid* inputUG = vtkUnstructuredGrid::SafeDownCast(input);
+  if (inputUG && !inputUG->GetFaces())
   {
-    cell = input->GetCell(cellId);
-    cellPts = cell->GetPointIds();
-    numCellPts = cell->GetNumberOfPoints();
+    this->ThreadedUnstructuredGridExecute(inputUG, inScalars, usePointScalars, newPoints, output);
+  }
+  else
+  {
+    output->Allocate(input->GetNumberOfCells());
+    newPoints->Allocate(numPts);
+
+    pointMap = vtkIdList::New(); // maps old point ids into new
+    pointMap->SetNumberOfIds(numPts);
+    for (i = 0; i < numPts; i++)
+    {
+      pointMap->SetId(i, -1);
+    }
+
+    newCellPts = vtkIdList::New();
 
-    if (usePointScalars)
+    // Check that the scalars of each cell satisfy the threshold criterion
+    for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
     {
-      if (this->AllScalars)
+      cell = input->GetCell(cellId);
+      cellPts = cell->GetPointIds();
+      numCellPts = cell->GetNumberOfPoints();
+
+      keepCell = this->EvaluateCellKeep(inScalars, usePointScalars, cellId, cellPts, numCellPts);
+
+      if (numCellPts > 0 && keepCell)
       {
-        keepCell = 1;
-        for (i = 0; keepCell && (i < numCellPts); i++)
+        // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
+        for (i = 0; i < numCellPts; i++)
         {
           ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents(inScalars, ptId);
-        }
-      }
-      else
-      {
-        if (!this->UseContinuousCellRange)
-        {
-          keepCell = 0;
-          for (i = 0; (!keepCell) && (i < numCellPts); i++)
+          if ((newId = pointMap->GetId(ptId)) < 0)
           {
-            ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents(inScalars, ptId);
+            input->GetPoint(ptId, x);
+            newId = newPoints->InsertNextPoint(x);
+            pointMap->SetId(ptId, newId);
+            outPD->CopyData(pd, ptId, newId);
           }
+          newCellPts->InsertId(i, newId);
         }
-        else
+        // special handling for polyhedron cells
+        if (inputUG && input->GetCellType(cellId) == VTK_POLYHEDRON)
         {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
+          newCellPts->Reset();
+          inputUG->GetFaceStream(cellId, newCellPts);
+          vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap->GetPointer(0));
         }
-      }
+        newCellId = output->InsertNextCell(cell->GetCellType(), newCellPts);
+        outCD->CopyData(cd, cellId, newCellId);
+        newCellPts->Reset();
+      } // satisfied thresholding
+    }   // for all cells
+
+    pointMap->Delete();
+    newCellPts->Delete();
+  }
+
+  vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
+
+  // now clean up / update ourselves
+
+  output->SetPoints(newPoints);
+  newPoints->Delete();
+
+  output->Squeeze();
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+// Parallel version of the cell loop of RequestData() for unstructured grids
+// without polyhedra. The cells are evaluated in parallel, then the output
+// connectivity and offsets are laid out with prefix sums and written
+// directly. As in the serial loop, output points are numbered in the order
+// they are first used by the output cells, so the output does not depend on
+// the number of threads.
+void vtkThreshold::ThreadedUnstructuredGridExecute(vtkUnstructuredGrid* input,
+  vtkDataArray* inScalars, bool usePointScalars, vtkPoints* newPoints, vtkUnstructuredGrid* output)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkSMPThreadLocalObject<vtkIdList> cellPoints;
+
+  // First pass: the size of the output cell of each input cell, 0 if the
+  // cell is not kept. Prefix sums give the output connectivity offsets and
+  // the output cell ids.
+  std::vector<vtkIdType> connOffsets(numCells + 1);
+  std::vector<vtkIdType> cellMap(numCells + 1);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = cellPoints.Local();
+    for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+    {
+      input->GetCellPoints(cellId, cellPts);
+      const int numCellPts = static_cast<int>(cellPts->GetNumberOfIds());
+      const bool keepCell = numCellPts > 0 &&
+        this->EvaluateCellKeep(inScalars, usePointScalars, cellId, cellPts, numCellPts);
+      connOffsets[cellId] = keepCell ? numCellPts : 0;
+      cellMap[cellId] = keepCell ? 1 : 0;
+    }
+  });
+  connOffsets[numCells] = 0;
+  cellMap[numCells] = 0;
+  vtkSMPTools::ExclusiveScan(
+    connOffsets.begin(), connOffsets.end(), connOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(cellMap.begin(), cellMap.end(), cellMap.begin(), vtkIdType(0));
+  const vtkIdType connSize = connOffsets[numCells];
+  const vtkIdType numOutCells = cellMap[numCells];
+
+  // Second pass: write the cells with the input point ids, and record the
+  // first position at which each input point is used.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numOutCells + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numOutCells);
+  vtkNew<vtkIdList> keptCellIds;
+  keptCellIds->SetNumberOfIds(numOutCells);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connPtr = conn->GetPointer(0);
+  unsigned char* typesPtr = types->GetPointer(0);
+  vtkIdType* keptCellIdsPtr = keptCellIds->GetPointer(0);
+  offsetsPtr[numOutCells] = connSize;
+
+  std::vector<std::atomic<vtkIdType>> firstUse(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType beginPtId, vtkIdType endPtId) {
+    for (vtkIdType ptId = beginPtId; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(connSize, std::memory_order_relaxed);
     }
-    else // use cell scalars
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = cellPoints.Local();
+    for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
     {
-      keepCell = this->EvaluateComponents(inScalars, cellId);
+      const vtkIdType newCellId = cellMap[cellId];
+      if (newCellId == cellMap[cellId + 1])
+      {
+        continue;
+      }
+      input->GetCellPoints(cellId, cellPts);
+      vtkIdType position = connOffsets[cellId];
+      offsetsPtr[newCellId] = position;
+      typesPtr[newCellId] = static_cast<unsigned char>(input->GetCellType(cellId));
+      keptCellIdsPtr[newCellId] = cellId;
+      for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); ++i, ++position)
+      {
+        const vtkIdType ptId = cellPts->GetId(i);
+        connPtr[position] = ptId;
+        std::atomic<vtkIdType>& ptFirstUse = firstUse[ptId];
+        vtkIdType current = ptFirstUse.load(std::memory_order_relaxed);
+        while (position < current &&
+          !ptFirstUse.compare_exchange_weak(current, position, std::memory_order_relaxed))
+        {
+        }
+      }
     }
+  });
 
-    // Invert the keep flag if the Invert option is enabled.
-    keepCell = this->Invert ? (1 - keepCell) : keepCell;
+  // Output point ids: usedIds[position] is the id of the point first used at
+  // position.
+  std::vector<vtkIdType> usedIds(connSize + 1);
+  vtkSMPTools::For(0, connSize, [&](vtkIdType beginPos, vtkIdType endPos) {
+    for (vtkIdType position = beginPos; position < endPos; ++position)
+    {
+      usedIds[position] =
+        firstUse[connPtr[position]].load(std::memory_order_relaxed) == position ? 1 : 0;
+    }
+  });
+  usedIds[connSize] = 0;
+  vtkSMPTools::ExclusiveScan(usedIds.begin(), usedIds.end(), usedIds.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = usedIds[connSize];
+
+  // Third pass: copy the points and renumber the connectivity.
+  newPoints->SetNumberOfPoints(numNewPts);
+  vtkNew<vtkIdList> pointIds;
+  pointIds->SetNumberOfIds(numNewPts);
+  vtkIdType* pointIdsPtr = pointIds->GetPointer(0);
+  vtkSMPTools::For(0, connSize, [&](vtkIdType beginPos, vtkIdType endPos) {
+    double x[3];
+    for (vtkIdType position = beginPos; position < endPos; ++position)
+    {
+      const vtkIdType ptId = connPtr[position];
+      const vtkIdType ptFirstUse = firstUse[ptId].load(std::memory_order_relaxed);
+      const vtkIdType newId = usedIds[ptFirstUse];
+      if (ptFirstUse == position)
+      {
+        input->GetPoint(ptId, x);
+        newPoints->SetPoint(newId, x);
+        pointIdsPtr[newId] = ptId;
+      }
+      connPtr[position] = newId;
+    }
+  });
+
+  // The attributes are copied in bulk.
+  vtkNew<vtkIdList> newIds;
+  newIds->SetNumberOfIds(std::max(numNewPts, numOutCells));
+  std::iota(newIds->GetPointer(0), newIds->GetPointer(0) + newIds->GetNumberOfIds(), 0);
+  newIds->SetNumberOfIds(numNewPts);
+  output->GetPointData()->CopyData(input->GetPointData(), pointIds, newIds);
+  newIds->SetNumberOfIds(numOutCells);
+  output->GetCellData()->CopyData(input->GetCellData(), keptCellIds, newIds);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, conn);
+  output->SetCells(types, cells);
+}
 
-    if (numCellPts > 0 && keepCell)
+//------------------------------------------------------------------------------
+int vtkThreshold::EvaluateCellKeep(vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId,
+  vtkIdList* cellPts, int numCellPts)
+{
+  int keepCell;
+  if (usePointScalars)
+  {
+    if (this->AllScalars)
+    {
+      keepCell = 1;
+      for (int i = 0; keepCell && (i < numCellPts); i++)
+      {
+        keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+      }
+    }
+    else
     {
-      // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
-      for (i = 0; i < numCellPts; i++)
+      if (!this->UseContinuousCellRange)
       {
-        ptId = cellPts->GetId(i);
-        if ((newId = pointMap->GetId(ptId)) < 0)
+        keepCell = 0;
+        for (int i = 0; (!keepCell) && (i < numCellPts); i++)
         {
-          input->GetPoint(ptId, x);
-          newId = newPoints->InsertNextPoint(x);
-          pointMap->SetId(ptId, newId);
-          outPD->CopyData(pd, ptId, newId);
+          keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
         }
-        newCellPts->InsertId(i, newId);
       }
-      // special handling for polyhedron cells
-      if (vtkUnstructuredGrid::SafeDownCast(input) && input->GetCellType(cellId) == VTK_POLYHEDRON)
+      else
       {
-        newCellPts->Reset();
-        vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap->GetPointer(0));
+        keepCell = this->EvaluateCell(scalars, cellPts, numCellPts);
       }
-      newCellId = output->InsertNextCell(cell->GetCellType(), newCellPts);
-      outCD->CopyData(cd, cellId, newCellId);
-      newCellPts->Reset();
-    } // satisfied thresholding
-  }   // for all cells
-
-  vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
-
-  // now clean up / update ourselves
-  pointMap->Delete();
-  newCellPts->Delete();
-
-  output->SetPoints(newPoints);
-  newPoints->Delete();
-
-  output->Squeeze();
+    }
+  }
+  else // use cell scalars
+  {
+    keepCell = this->EvaluateComponents(scalars, cellId);
+  }
 
-  return 1;
+  // Invert the keep flag if the Invert option is enabled.
+  return this->Invert ? (1 - keepCell) : keepCell;
 }
 
 int vtkThreshold::EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts)
@@ -51,6 +51,8 @@
 
 class vtkDataArray;
 class vtkIdList;
+class vtkPoints;
+class vtkUnstructuredGrid;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
 {
@@ -233,6 +235,20 @@ protected:
   int EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts);
   int EvaluateCell(vtkDataArray* scalars, int c, vtkIdList* cellPts, int numCellPts);
 
+  /**
+   * Return whether a cell satisfies the threshold criterion, taking Invert
+   * into account. This method is called concurrently by the threaded path.
+   */
+  int EvaluateCellKeep(vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId,
+    vtkIdList* cellPts, int numCellPts);
+
+  /**
+   * Threaded extraction used for unstructured grids without polyhedra. The
+   * output is the same as the one of the serial extraction.
+   */
+  void ThreadedUnstructuredGridExecute(vtkUnstructuredGrid* input, vtkDataArray* inScalars,
+    bool usePointScalars, vtkPoints* newPoints, vtkUnstructuredGrid* output);
+
 private:
   vtkThreshold(const vtkThreshold&) = delete;
   void operator=(const vtkThreshold&) = delete;
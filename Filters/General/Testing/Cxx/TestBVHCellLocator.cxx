@@ -0,0 +1,316 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the queries of vtkBVHCellLocator against vtkStaticCellLocator, and
+// times the build and the ray casting of the cell locators on a large
+// triangle mesh.
+
+#include <vtkBVHCellLocator.h>
+#include <vtkCellLocator.h>
+#include <vtkCellTreeLocator.h>
+#include <vtkCellTypeSource.h>
+#include <vtkDoubleArray.h>
+#include <vtkGenericCell.h>
+#include <vtkIdList.h>
+#include <vtkMath.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkModifiedBSPTree.h>
+#include <vtkNew.h>
+#include <vtkOBBTree.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+#include <vtkStaticCellLocator.h>
+#include <vtkTimerLog.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+void RandomPoints(vtkPoints* points, vtkIdType numPts, double range, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = random->GetRangeValue(-range, range);
+      random->Next();
+    }
+    points->SetPoint(ptId, x);
+  }
+}
+
+// Cast the rays one at a time, return the number of hits.
+vtkIdType CastRays(vtkAbstractCellLocator* locator, vtkPoints* p1s, vtkPoints* p2s,
+  std::vector<double>& ts, std::vector<vtkIdType>& cellIds)
+{
+  vtkNew<vtkGenericCell> cell;
+  const vtkIdType numRays = p1s->GetNumberOfPoints();
+  ts.assign(numRays, -1.0);
+  cellIds.assign(numRays, -1);
+  vtkIdType numHits = 0;
+  for (vtkIdType rayId = 0; rayId < numRays; ++rayId)
+  {
+    double p1[3], p2[3], t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId = -1;
+    p1s->GetPoint(rayId, p1);
+    p2s->GetPoint(rayId, p2);
+    if (locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell))
+    {
+      ts[rayId] = t;
+      cellIds[rayId] = cellId;
+      ++numHits;
+    }
+  }
+  return numHits;
+}
+
+int TestRays(vtkPolyData* surface, vtkPoints* p1s, vtkPoints* p2s)
+{
+  int status = EXIT_SUCCESS;
+  vtkNew<vtkTimerLog> timer;
+
+  // Reference results
+  vtkNew<vtkStaticCellLocator> reference;
+  reference->SetDataSet(surface);
+  reference->BuildLocator();
+  std::vector<double> referenceTs;
+  std::vector<vtkIdType> referenceIds;
+  CastRays(reference, p1s, p2s, referenceTs, referenceIds);
+
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(surface);
+  timer->StartTimer();
+  bvh->BuildLocator();
+  timer->StopTimer();
+  std::cout << "vtkBVHCellLocator: " << bvh->GetNumberOfNodes() << " nodes built in "
+            << timer->GetElapsedTime() << " s" << std::endl;
+
+  std::vector<double> ts;
+  std::vector<vtkIdType> cellIds;
+  CastRays(bvh, p1s, p2s, ts, cellIds);
+  vtkIdType numMismatches = 0;
+  for (std::size_t i = 0; i < ts.size(); ++i)
+  {
+    if ((cellIds[i] < 0) != (referenceIds[i] < 0) ||
+      (cellIds[i] >= 0 && std::abs(ts[i] - referenceTs[i]) > 1e-9))
+    {
+      ++numMismatches;
+    }
+  }
+  if (numMismatches > 0)
+  {
+    std::cerr << "IntersectWithLine differs from vtkStaticCellLocator for " << numMismatches
+              << " rays" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  vtkNew<vtkIdList> batchIds;
+  vtkNew<vtkDoubleArray> batchTs;
+  vtkNew<vtkPoints> batchXs;
+  bvh->IntersectWithLines(p1s, p2s, 0.0, batchIds, batchTs, batchXs);
+  for (std::size_t i = 0; i < ts.size(); ++i)
+  {
+    if (batchIds->GetId(i) != cellIds[i] || (cellIds[i] >= 0 && batchTs->GetValue(i) != ts[i]))
+    {
+      std::cerr << "IntersectWithLines differs from IntersectWithLine for ray " << i << std::endl;
+      status = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  // All the intersections along a line through the sphere
+  const double p1[3] = { -2.0, 0.01, 0.02 };
+  const double p2[3] = { 2.0, 0.01, 0.02 };
+  vtkNew<vtkPoints> hitPoints;
+  vtkNew<vtkIdList> hitIds;
+  bvh->IntersectWithLine(p1, p2, hitPoints, hitIds);
+  const vtkIdType numHits = hitIds->GetNumberOfIds();
+  if (numHits < 2 || hitPoints->GetNumberOfPoints() != numHits ||
+    std::abs(hitPoints->GetPoint(0)[0] + 0.5) > 0.01 ||
+    std::abs(hitPoints->GetPoint(numHits - 1)[0] - 0.5) > 0.01)
+  {
+    std::cerr << "Wrong intersections along the x axis" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  for (vtkIdType i = 1; i < numHits; ++i)
+  {
+    double previous[3], current[3];
+    hitPoints->GetPoint(i - 1, previous);
+    hitPoints->GetPoint(i, current);
+    if (previous[0] > current[0])
+    {
+      std::cerr << "The intersections are not sorted along the line" << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
+
+int TestClosestPoints(vtkPolyData* surface, vtkPoints* points)
+{
+  // vtkStaticCellLocator only searches the neighborhood of the point, use the
+  // exhaustive search of vtkCellLocator as the reference.
+  vtkNew<vtkCellLocator> reference;
+  reference->SetDataSet(surface);
+  reference->BuildLocator();
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(surface);
+  bvh->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], closest[3], referenceClosest[3], dist2, referenceDist2;
+    vtkIdType cellId, referenceId;
+    int subId;
+    points->GetPoint(ptId, x);
+    bvh->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    reference->FindClosestPoint(x, referenceClosest, cell, referenceId, subId, referenceDist2);
+    if (cellId < 0 || std::abs(dist2 - referenceDist2) > 1e-12)
+    {
+      std::cerr << "FindClosestPoint differs from vtkCellLocator for point " << ptId
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestFindCell(vtkPoints* points)
+{
+  vtkNew<vtkCellTypeSource> tetras;
+  tetras->SetCellType(VTK_TETRA);
+  tetras->SetBlocksDimensions(10, 10, 10);
+  tetras->Update();
+  vtkUnstructuredGrid* volume = tetras->GetOutput();
+
+  vtkNew<vtkStaticCellLocator> reference;
+  reference->SetDataSet(volume);
+  reference->BuildLocator();
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(volume);
+  bvh->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[4], dist2;
+  int subId;
+  vtkIdType numFound = 0;
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    // map the points in [-1,1] to the bounds of the volume, with a margin
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = 5.0 + 5.5 * x[i];
+    }
+    const vtkIdType cellId = bvh->FindCell(x, 0.0, cell, pcoords, weights);
+    const vtkIdType referenceId = reference->FindCell(x, 0.0, cell, pcoords, weights);
+    if ((cellId < 0) != (referenceId < 0))
+    {
+      std::cerr << "FindCell differs from vtkStaticCellLocator for point " << ptId << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (cellId >= 0)
+    {
+      volume->GetCell(cellId, cell);
+      if (cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights) != 1)
+      {
+        std::cerr << "FindCell returned a cell not containing point " << ptId << std::endl;
+        return EXIT_FAILURE;
+      }
+      ++numFound;
+    }
+  }
+  return numFound > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Time the build and the ray casting of the cell locators.
+void Benchmark(vtkPolyData* surface, vtkPoints* p1s, vtkPoints* p2s)
+{
+  vtkNew<vtkCellLocator> cellLocator;
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  vtkNew<vtkCellTreeLocator> treeLocator;
+  vtkNew<vtkModifiedBSPTree> bspTree;
+  vtkNew<vtkOBBTree> obbTree;
+  vtkNew<vtkBVHCellLocator> bvh;
+  vtkAbstractCellLocator* locators[] = { cellLocator, staticLocator, treeLocator, bspTree,
+    obbTree, bvh };
+
+  vtkNew<vtkTimerLog> timer;
+  std::vector<double> ts;
+  std::vector<vtkIdType> cellIds;
+  for (vtkAbstractCellLocator* locator : locators)
+  {
+    locator->SetDataSet(surface);
+    timer->StartTimer();
+    locator->BuildLocator();
+    timer->StopTimer();
+    const double buildTime = timer->GetElapsedTime();
+    timer->StartTimer();
+    const vtkIdType numHits = CastRays(locator, p1s, p2s, ts, cellIds);
+    timer->StopTimer();
+    std::cout << locator->GetClassName() << ": build " << buildTime << " s, "
+              << p1s->GetNumberOfPoints() << " rays " << timer->GetElapsedTime() << " s ("
+              << numHits << " hits)" << std::endl;
+  }
+
+  vtkNew<vtkIdList> batchIds;
+  timer->StartTimer();
+  bvh->IntersectWithLines(p1s, p2s, 0.0, batchIds);
+  timer->StopTimer();
+  std::cout << "vtkBVHCellLocator::IntersectWithLines: " << timer->GetElapsedTime() << " s"
+            << std::endl;
+}
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(100);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+
+  vtkNew<vtkPoints> p1s;
+  RandomPoints(p1s, 20000, 1.0, 1);
+  vtkNew<vtkPoints> p2s;
+  RandomPoints(p2s, 20000, 1.0, 2);
+
+  if (TestRays(surface, p1s, p2s) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+  vtkNew<vtkPoints> points;
+  RandomPoints(points, 2000, 1.0, 3);
+  if (TestClosestPoints(surface, points) != EXIT_SUCCESS || TestFindCell(points) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  Benchmark(surface, p1s, p2s);
+  return status;
+}
@@ -15,7 +15,9 @@
 
 #include <vtkImageDataToPointSet.h>
 
+#include <vtkDataArray.h>
 #include <vtkImageData.h>
+#include <vtkPoints.h>
 #include <vtkRTAnalyticSource.h>
 #include <vtkStructuredGrid.h>
 
@@ -83,5 +85,37 @@ int TestImageDataToPointSet(int, char*[])
     }
   }
 
+  // The coordinates are stored by default.
+  vtkPoints* points = image2points->GetOutput()->GetPoints();
+  if (points->GetData()->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate)
+  {
+    std::cout << "Point coordinates are not stored" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Implicit coordinates are computed from the image rather than stored.
+  image2points->ImplicitPointsOn();
+  image2points->Update();
+  outData = image2points->GetOutput();
+  vtkDataArray* coordinates = image2points->GetOutput()->GetPoints()->GetData();
+  if (coordinates->GetActualMemorySize() > 1)
+  {
+    std::cout << "Point coordinates use " << coordinates->GetActualMemorySize() << " KiB"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType pointId = 0; pointId < numPoints; pointId++)
+  {
+    double inPoint[3];
+    double outPoint[3];
+    inData->GetPoint(pointId, inPoint);
+    outData->GetPoint(pointId, outPoint);
+    if ((inPoint[0] != outPoint[0]) || (inPoint[1] != outPoint[1]) || (inPoint[2] != outPoint[2]))
+    {
+      std::cout << "Got mismatched implicit point coordinates." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,250 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorBatchQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the batched queries of the cell and point locators with the
+// equivalent queries made one at a time.
+
+#include <vtkCellTreeLocator.h>
+#include <vtkCellTypeSource.h>
+#include <vtkDoubleArray.h>
+#include <vtkGenericCell.h>
+#include <vtkIdList.h>
+#include <vtkMath.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPointLocator.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+#include <vtkStaticCellLocator.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+void RandomPoints(vtkPoints* points, vtkIdType numPts, const double bounds[6], int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = random->GetRangeValue(bounds[2 * i], bounds[2 * i + 1]);
+      random->Next();
+    }
+    points->SetPoint(ptId, x);
+  }
+}
+
+int TestFindCells(vtkAbstractCellLocator* locator, vtkPoints* points)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  locator->FindCells(points, 0.0, cellIds, pcoords);
+
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(locator->GetDataSet()->GetMaxCellSize());
+  vtkIdType numFound = 0;
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], pc[3];
+    points->GetPoint(ptId, x);
+    vtkIdType cellId = locator->FindCell(x, 0.0, cell, pc, weights.data());
+    if (cellId != cellIds->GetId(ptId) ||
+      (cellId >= 0 && vtkMath::Distance2BetweenPoints(pc, pcoords->GetTuple3(ptId)) > 1e-12))
+    {
+      std::cerr << locator->GetClassName() << ": FindCells differs for point " << ptId
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    numFound += cellId >= 0 ? 1 : 0;
+  }
+  if (numFound == 0)
+  {
+    std::cerr << locator->GetClassName() << ": FindCells found no cell" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestIntersectWithLines(vtkAbstractCellLocator* locator, vtkPoints* p1s, vtkPoints* p2s)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkPoints> xs;
+  xs->SetDataTypeToDouble();
+  locator->IntersectWithLines(p1s, p2s, 0.0, cellIds, ts, xs);
+
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType numHits = 0;
+  for (vtkIdType lineId = 0; lineId < p1s->GetNumberOfPoints(); ++lineId)
+  {
+    double p1[3], p2[3], t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId = -1;
+    p1s->GetPoint(lineId, p1);
+    p2s->GetPoint(lineId, p2);
+    if (!locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (cellId != cellIds->GetId(lineId) ||
+      (cellId >= 0 &&
+        (t != ts->GetValue(lineId) ||
+          vtkMath::Distance2BetweenPoints(x, xs->GetPoint(lineId)) > 0.0)))
+    {
+      std::cerr << locator->GetClassName() << ": IntersectWithLines differs for line " << lineId
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    numHits += cellId >= 0 ? 1 : 0;
+  }
+  if (numHits == 0)
+  {
+    std::cerr << locator->GetClassName() << ": IntersectWithLines found no hit" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestFindClosestPoints(vtkAbstractCellLocator* locator, vtkPoints* points)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkPoints> closestPoints;
+  closestPoints->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> dist2s;
+  locator->FindClosestPoints(points, cellIds, closestPoints, dist2s);
+
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], closest[3], dist2;
+    vtkIdType cellId;
+    int subId;
+    points->GetPoint(ptId, x);
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    if (cellId < 0 || cellId != cellIds->GetId(ptId) || dist2 != dist2s->GetValue(ptId) ||
+      vtkMath::Distance2BetweenPoints(closest, closestPoints->GetPoint(ptId)) > 0.0)
+    {
+      std::cerr << locator->GetClassName() << ": FindClosestPoints differs for point " << ptId
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestPointLocator(vtkAbstractPointLocator* locator, vtkDataSet* dataSet, vtkPoints* points)
+{
+  locator->SetDataSet(dataSet);
+  locator->BuildLocator();
+  vtkNew<vtkIdList> ptIds;
+  locator->FindClosestPoints(points, ptIds);
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    vtkIdType closest = locator->FindClosestPoint(x);
+    if (closest < 0 || closest != ptIds->GetId(ptId))
+    {
+      std::cerr << locator->GetClassName() << ": FindClosestPoints differs for point " << ptId
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestLocatorBatchQueries(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+
+  vtkNew<vtkCellTypeSource> tetras;
+  tetras->SetCellType(VTK_TETRA);
+  tetras->SetBlocksDimensions(12, 12, 12);
+  tetras->Update();
+  vtkUnstructuredGrid* volume = tetras->GetOutput();
+  double volumeBounds[6];
+  volume->GetBounds(volumeBounds);
+  double queryBounds[6];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double pad = 0.1 * (volumeBounds[2 * i + 1] - volumeBounds[2 * i]);
+    queryBounds[2 * i] = volumeBounds[2 * i] - pad;
+    queryBounds[2 * i + 1] = volumeBounds[2 * i + 1] + pad;
+  }
+  vtkNew<vtkPoints> queryPoints;
+  RandomPoints(queryPoints, 5000, queryBounds, 1);
+  vtkNew<vtkPoints> lineEnds;
+  RandomPoints(lineEnds, 5000, queryBounds, 2);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+  const double sphereBounds[6] = { -1.0, 1.0, -1.0, 1.0, -1.0, 1.0 };
+  vtkNew<vtkPoints> spherePoints;
+  RandomPoints(spherePoints, 5000, sphereBounds, 3);
+  vtkNew<vtkPoints> sphereEnds;
+  RandomPoints(sphereEnds, 5000, sphereBounds, 4);
+
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  vtkNew<vtkCellTreeLocator> treeLocator;
+  vtkAbstractCellLocator* cellLocators[] = { staticLocator, treeLocator };
+  for (vtkAbstractCellLocator* locator : cellLocators)
+  {
+    locator->SetDataSet(volume);
+    locator->BuildLocator();
+    if (!locator->SupportsConcurrentQueries())
+    {
+      std::cerr << locator->GetClassName() << " does not support concurrent queries" << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (TestFindCells(locator, queryPoints) != EXIT_SUCCESS ||
+      TestIntersectWithLines(locator, queryPoints, lineEnds) != EXIT_SUCCESS)
+    {
+      status = EXIT_FAILURE;
+    }
+
+    locator->SetDataSet(surface);
+    locator->BuildLocator();
+    if (TestIntersectWithLines(locator, spherePoints, sphereEnds) != EXIT_SUCCESS)
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+  if (TestFindClosestPoints(staticLocator, spherePoints) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  vtkNew<vtkStaticPointLocator> staticPointLocator;
+  vtkNew<vtkPointLocator> pointLocator;
+  if (TestPointLocator(staticPointLocator, volume, queryPoints) != EXIT_SUCCESS ||
+    TestPointLocator(pointLocator, surface, spherePoints) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
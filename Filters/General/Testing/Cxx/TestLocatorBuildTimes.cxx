@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorBuildTimes.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Times the build of vtkCellLocator, vtkCellTreeLocator and vtkKdTree on
+// meshes of increasing size, and checks that the locators built with
+// several threads answer every query exactly as the ones built with one
+// thread.
+
+#include <vtkCellLocator.h>
+#include <vtkCellTreeLocator.h>
+#include <vtkCellTypeSource.h>
+#include <vtkGenericCell.h>
+#include <vtkIdList.h>
+#include <vtkKdTree.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkSphereSource.h>
+#include <vtkTimerLog.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+void RandomPoint(vtkMinimalStandardRandomSequence* random, const double bounds[6], double x[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = random->GetRangeValue(bounds[2 * i] - 0.1, bounds[2 * i + 1] + 0.1);
+    random->Next();
+  }
+}
+
+// Build a locator of the same class as the given one on the data set, with
+// the given number of threads, and return the build time.
+template <typename LocatorT>
+double BuildLocator(LocatorT* locator, vtkDataSet* dataSet, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  locator->SetDataSet(dataSet);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  locator->BuildLocator();
+  timer->StopTimer();
+  vtkSMPTools::Initialize();
+  return timer->GetElapsedTime();
+}
+
+double BuildKdTree(vtkKdTree* kdTree, vtkDataSet* dataSet, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  kdTree->AddDataSet(dataSet);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  kdTree->BuildLocator();
+  timer->StopTimer();
+  vtkSMPTools::Initialize();
+  return timer->GetElapsedTime();
+}
+
+// Compare the intersections along random lines, and the cells containing
+// random points of a volume mesh, with the ones of the serial build.
+int CompareQueries(vtkAbstractCellLocator* locator, vtkAbstractCellLocator* serial,
+  vtkDataSet* dataSet, bool findCells, int numThreads)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  double bounds[6];
+  dataSet->GetBounds(bounds);
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(dataSet->GetMaxCellSize());
+  for (int i = 0; i < 1000; ++i)
+  {
+    double p1[3], p2[3], t, serialT, x[3], serialX[3], pcoords[3];
+    int subId;
+    vtkIdType cellId = -1, serialId = -1;
+    RandomPoint(random, bounds, p1);
+    RandomPoint(random, bounds, p2);
+    int hit = locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell);
+    int serialHit =
+      serial->IntersectWithLine(p1, p2, 0.0, serialT, serialX, pcoords, subId, serialId, cell);
+    if (hit != serialHit ||
+      (hit &&
+        (cellId != serialId || t != serialT || x[0] != serialX[0] || x[1] != serialX[1] ||
+          x[2] != serialX[2])))
+    {
+      std::cerr << locator->GetClassName() << " built with " << numThreads
+                << " threads: IntersectWithLine differs for line " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (findCells)
+    {
+      cellId = locator->FindCell(p1, 0.0, cell, pcoords, weights.data());
+      serialId = serial->FindCell(p1, 0.0, cell, pcoords, weights.data());
+      if (cellId != serialId)
+      {
+        std::cerr << locator->GetClassName() << " built with " << numThreads
+                  << " threads: FindCell differs for point " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Check that the regions and their cell lists are the ones of the serial
+// build.
+int CompareKdTrees(vtkKdTree* kdTree, vtkKdTree* serial, int numThreads)
+{
+  if (kdTree->GetNumberOfRegions() != serial->GetNumberOfRegions())
+  {
+    std::cerr << "vtkKdTree built with " << numThreads << " threads has "
+              << kdTree->GetNumberOfRegions() << " regions instead of "
+              << serial->GetNumberOfRegions() << std::endl;
+    return EXIT_FAILURE;
+  }
+  kdTree->CreateCellLists();
+  serial->CreateCellLists();
+  for (int regionId = 0; regionId < kdTree->GetNumberOfRegions(); ++regionId)
+  {
+    double bounds[6], serialBounds[6];
+    kdTree->GetRegionBounds(regionId, bounds);
+    serial->GetRegionBounds(regionId, serialBounds);
+    vtkIdList* cellIds = kdTree->GetCellList(regionId);
+    vtkIdList* serialIds = serial->GetCellList(regionId);
+    bool same = cellIds->GetNumberOfIds() == serialIds->GetNumberOfIds();
+    for (int i = 0; same && i < 6; ++i)
+    {
+      same = bounds[i] == serialBounds[i];
+    }
+    for (vtkIdType i = 0; same && i < cellIds->GetNumberOfIds(); ++i)
+    {
+      same = cellIds->GetId(i) == serialIds->GetId(i);
+    }
+    if (!same)
+    {
+      std::cerr << "vtkKdTree built with " << numThreads << " threads: region " << regionId
+                << " differs" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Build the three locators with one thread and with numThreads threads,
+// compare them and return the build times with numThreads threads.
+int CompareBuilds(vtkDataSet* dataSet, bool findCells, int numThreads, double times[3])
+{
+  vtkNew<vtkCellLocator> serialCellLocator, cellLocator;
+  vtkNew<vtkCellTreeLocator> serialTreeLocator, treeLocator;
+  vtkNew<vtkKdTree> serialKdTree, kdTree;
+  serialCellLocator->CacheCellBoundsOn();
+  cellLocator->CacheCellBoundsOn();
+  BuildLocator(serialCellLocator.GetPointer(), dataSet, 1);
+  BuildLocator(serialTreeLocator.GetPointer(), dataSet, 1);
+  BuildKdTree(serialKdTree, dataSet, 1);
+  times[0] = BuildLocator(cellLocator.GetPointer(), dataSet, numThreads);
+  times[1] = BuildLocator(treeLocator.GetPointer(), dataSet, numThreads);
+  times[2] = BuildKdTree(kdTree, dataSet, numThreads);
+  if (CompareQueries(cellLocator, serialCellLocator, dataSet, findCells, numThreads) !=
+      EXIT_SUCCESS ||
+    CompareQueries(treeLocator, serialTreeLocator, dataSet, findCells, numThreads) !=
+      EXIT_SUCCESS ||
+    CompareKdTrees(kdTree, serialKdTree, numThreads) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestLocatorBuildTimes(int, char*[])
+{
+  const int numThreads[] = { 2, 4 };
+  const char* names[3] = { "vtkCellLocator", "vtkCellTreeLocator", "vtkKdTree" };
+
+  // Surfaces of increasing size. The build times are only reported: the
+  // build time per cell should not grow much faster than log(cells).
+  const int resolutions[] = { 64, 256, 512 };
+  for (int resolution : resolutions)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(resolution);
+    sphere->SetPhiResolution(resolution / 2);
+    sphere->Update();
+    vtkPolyData* surface = sphere->GetOutput();
+    for (int n : numThreads)
+    {
+      double times[3];
+      if (CompareBuilds(surface, false, n, times) != EXIT_SUCCESS)
+      {
+        return EXIT_FAILURE;
+      }
+      std::cout << surface->GetNumberOfCells() << " cells, " << n << " threads:";
+      for (int i = 0; i < 3; ++i)
+      {
+        std::cout << " " << names[i] << " " << times[i] << " s";
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  vtkNew<vtkCellTypeSource> hexahedra;
+  hexahedra->SetCellType(VTK_HEXAHEDRON);
+  hexahedra->SetBlocksDimensions(20, 20, 20);
+  hexahedra->Update();
+  for (int n : numThreads)
+  {
+    double times[3];
+    if (CompareBuilds(hexahedra->GetOutput(), true, n, times) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
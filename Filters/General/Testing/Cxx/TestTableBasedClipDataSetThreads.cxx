@@ -0,0 +1,329 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkTableBasedClipDataSet gives the same output with several
+// threads as with a single one, for all the types of input it clips by
+// chunks of cells.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Add the point scalars used for clipping and an id array to follow the
+// cells.
+void AddArrays(vtkDataSet* dataSet)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfValues(dataSet->GetNumberOfPoints());
+  double x[3];
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfPoints(); ++i)
+  {
+    dataSet->GetPoint(i, x);
+    scalars->SetValue(i, std::sin(x[0]) + std::cos(0.7 * x[1]) + 0.3 * x[2]);
+  }
+  dataSet->GetPointData()->SetScalars(scalars);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(dataSet->GetNumberOfCells());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfCells(); ++i)
+  {
+    cellIds->SetValue(i, i);
+  }
+  dataSet->GetCellData()->AddArray(cellIds);
+}
+
+vtkSmartPointer<vtkRectilinearGrid> MakeRectilinearGrid(int n)
+{
+  vtkNew<vtkDoubleArray> coords[3];
+  for (int c = 0; c < 3; ++c)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      coords[c]->InsertNextValue(0.02 * i * i + 0.1 * c * i);
+    }
+  }
+  vtkSmartPointer<vtkRectilinearGrid> grid = vtkSmartPointer<vtkRectilinearGrid>::New();
+  grid->SetDimensions(n, n, n);
+  grid->SetXCoordinates(coords[0]);
+  grid->SetYCoordinates(coords[1]);
+  grid->SetZCoordinates(coords[2]);
+  AddArrays(grid);
+  return grid;
+}
+
+vtkSmartPointer<vtkStructuredGrid> MakeStructuredGrid(int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        points->InsertNextPoint(0.3 * i + 0.05 * j, 0.3 * j, 0.3 * k + 0.02 * i * j);
+      }
+    }
+  }
+  vtkSmartPointer<vtkStructuredGrid> grid = vtkSmartPointer<vtkStructuredGrid>::New();
+  grid->SetDimensions(n, n, n);
+  grid->SetPoints(points);
+  AddArrays(grid);
+  return grid;
+}
+
+// Hexahedra, wedges and tetrahedra filling a block, with some quads, lines
+// and vertices in between.
+vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid(int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        points->InsertNextPoint(0.3 * i, 0.3 * j, 0.3 * k);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  auto id = [n](int i, int j, int k) { return static_cast<vtkIdType>((k * n + j) * n + i); };
+  for (int k = 0; k + 1 < n; ++k)
+  {
+    for (int j = 0; j + 1 < n; ++j)
+    {
+      for (int i = 0; i + 1 < n; ++i)
+      {
+        const vtkIdType p[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        switch ((i + j + k) % 3)
+        {
+          case 0:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+            break;
+          case 1:
+          {
+            const vtkIdType wedges[2][6] = { { p[0], p[1], p[3], p[4], p[5], p[7] },
+              { p[1], p[2], p[3], p[5], p[6], p[7] } };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedges[0]);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedges[1]);
+            break;
+          }
+          default:
+          {
+            const vtkIdType tets[5][4] = { { p[0], p[1], p[3], p[4] }, { p[1], p[2], p[3], p[6] },
+              { p[1], p[4], p[5], p[6] }, { p[3], p[4], p[6], p[7] }, { p[1], p[3], p[4], p[6] } };
+            for (const vtkIdType* tet : tets)
+            {
+              grid->InsertNextCell(VTK_TETRA, 4, tet);
+            }
+          }
+        }
+        if ((i + 2 * j) % 7 == 0)
+        {
+          grid->InsertNextCell(VTK_QUAD, 4, p);
+        }
+        if ((i + j + 2 * k) % 11 == 0)
+        {
+          grid->InsertNextCell(VTK_LINE, 2, p + 5);
+          grid->InsertNextCell(VTK_VERTEX, 1, p + 2);
+        }
+      }
+    }
+  }
+  AddArrays(grid);
+  return grid;
+}
+
+bool SameArrays(vtkFieldData* data, vtkFieldData* expected, const char* name)
+{
+  if (data->GetNumberOfArrays() != expected->GetNumberOfArrays())
+  {
+    std::cerr << "Wrong number of " << name << " arrays" << std::endl;
+    return false;
+  }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* array = data->GetArray(a);
+    vtkDataArray* expectedArray = expected->GetArray(a);
+    if (array->GetDataType() != expectedArray->GetDataType() ||
+      array->GetNumberOfValues() != expectedArray->GetNumberOfValues())
+    {
+      std::cerr << "Wrong " << name << " array " << a << std::endl;
+      return false;
+    }
+    const int numComps = array->GetNumberOfComponents();
+    for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+    {
+      if (array->GetComponent(i / numComps, static_cast<int>(i % numComps)) !=
+        expectedArray->GetComponent(i / numComps, static_cast<int>(i % numComps)))
+      {
+        std::cerr << "The " << name << " array " << a << " differs at " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkUnstructuredGrid* output, vtkUnstructuredGrid* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Clipped " << output->GetNumberOfCells() << " cells and "
+              << output->GetNumberOfPoints() << " points instead of "
+              << expected->GetNumberOfCells() << " and " << expected->GetNumberOfPoints()
+              << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    const double* x = output->GetPoint(i);
+    const double* y = expected->GetPoint(i);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> ptIds, expectedPtIds;
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    output->GetCellPoints(i, ptIds);
+    expected->GetCellPoints(i, expectedPtIds);
+    bool same = output->GetCellType(i) == expected->GetCellType(i) &&
+      ptIds->GetNumberOfIds() == expectedPtIds->GetNumberOfIds();
+    for (vtkIdType j = 0; same && j < ptIds->GetNumberOfIds(); ++j)
+    {
+      same = ptIds->GetId(j) == expectedPtIds->GetId(j);
+    }
+    if (!same)
+    {
+      std::cerr << "Cell " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  return SameArrays(output->GetPointData(), expected->GetPointData(), "point data") &&
+    SameArrays(output->GetCellData(), expected->GetCellData(), "cell data");
+}
+
+// Clip the input with 1, 2 and 4 threads and compare both outputs.
+bool CompareThreads(vtkDataSet* input, const char* name, bool useFunction, bool insideOut)
+{
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(1.0, 0.8, 0.6);
+  plane->SetNormal(1.0, 0.5, 0.2);
+  vtkSmartPointer<vtkUnstructuredGrid> expected[2];
+  const int numThreads[3] = { 1, 2, 4 };
+  for (int n : numThreads)
+  {
+    vtkSMPTools::Initialize(n);
+    vtkNew<vtkTableBasedClipDataSet> clipper;
+    clipper->SetInputData(input);
+    if (useFunction)
+    {
+      clipper->SetClipFunction(plane);
+      clipper->GenerateClipScalarsOn();
+    }
+    else
+    {
+      clipper->SetValue(0.4);
+    }
+    clipper->SetInsideOut(insideOut);
+    clipper->GenerateClippedOutputOn();
+    clipper->Update();
+    vtkUnstructuredGrid* outputs[2] = { clipper->GetOutput(), clipper->GetClippedOutput() };
+    for (int i = 0; i < 2; ++i)
+    {
+      if (n == 1)
+      {
+        if (outputs[i]->GetNumberOfCells() == 0)
+        {
+          std::cerr << "Empty output for the " << name << std::endl;
+          return false;
+        }
+        expected[i] = vtkSmartPointer<vtkUnstructuredGrid>::New();
+        expected[i]->DeepCopy(outputs[i]);
+      }
+      else if (!SameOutput(outputs[i], expected[i]))
+      {
+        std::cerr << "The " << (i == 0 ? "output" : "clipped output") << " for the " << name
+                  << " with " << n << " threads differs from the one with 1 thread" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestTableBasedClipDataSetThreads(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-16, 16, -16, 16, -16, 16);
+  source->Update();
+  vtkNew<vtkImageData> image;
+  image->ShallowCopy(source->GetOutput());
+  AddArrays(image);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(2.0);
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(100);
+  sphere->Update();
+  vtkNew<vtkPolyData> polyData;
+  polyData->ShallowCopy(sphere->GetOutput());
+  AddArrays(polyData);
+
+  vtkSmartPointer<vtkDataSet> inputs[5] = { image, MakeRectilinearGrid(25),
+    MakeStructuredGrid(25), MakeUnstructuredGrid(20), polyData };
+  const char* names[5] = { "image", "rectilinear grid", "structured grid", "unstructured grid",
+    "polydata" };
+  for (int i = 0; i < 5; ++i)
+  {
+    for (int mode = 0; mode < 4; ++mode)
+    {
+      if (!CompareThreads(inputs[i], names[i], (mode & 1) != 0, (mode & 2) != 0))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
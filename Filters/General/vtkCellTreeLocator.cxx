@@ -21,8 +21,11 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -45,6 +48,10 @@ enum
   NEG_Z
 };
 #define CELLTREE_MAX_DEPTH 32
+// Number of buckets along each axis to evaluate the splits of a node
+#define CELLTREE_BUCKETS 6
+// Nodes with more cells are binned in parallel
+#define CELLTREE_PARALLEL_SIZE 65536
 }
 
 //------------------------------------------------------------------------------
@@ -295,47 +302,174 @@ private:
     }
   }
 
+  // Compute the bounds of a range of cells, in parallel.
+  struct MinMaxFunctor
+  {
+    const PerCell* Cells;
+    vtkSMPThreadLocal<std::array<float, 6>> LocalMinMax;
+    float Min[3];
+    float Max[3];
+
+    void Initialize()
+    {
+      std::array<float, 6>& minMax = this->LocalMinMax.Local();
+      std::fill(minMax.begin(), minMax.begin() + 3, std::numeric_limits<float>::max());
+      std::fill(minMax.begin() + 3, minMax.end(), -std::numeric_limits<float>::max());
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      std::array<float, 6>& minMax = this->LocalMinMax.Local();
+      for (const PerCell* pc = this->Cells + begin; pc != this->Cells + end; ++pc)
+      {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+          minMax[d] = std::min(minMax[d], pc->Min[d]);
+          minMax[d + 3] = std::max(minMax[d + 3], pc->Max[d]);
+        }
+      }
+    }
+
+    void Reduce()
+    {
+      std::fill(this->Min, this->Min + 3, std::numeric_limits<float>::max());
+      std::fill(this->Max, this->Max + 3, -std::numeric_limits<float>::max());
+      for (const std::array<float, 6>& minMax : this->LocalMinMax)
+      {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+          this->Min[d] = std::min(this->Min[d], minMax[d]);
+          this->Max[d] = std::max(this->Max[d], minMax[d + 3]);
+        }
+      }
+    }
+  };
+
+  void FindMinMaxInParallel(const PerCell* begin, const PerCell* end, float* min, float* max)
+  {
+    if (end - begin < CELLTREE_PARALLEL_SIZE)
+    {
+      this->FindMinMax(begin, end, min, max);
+      return;
+    }
+    MinMaxFunctor functor;
+    functor.Cells = begin;
+    vtkSMPTools::For(0, end - begin, functor);
+    std::copy(functor.Min, functor.Min + 3, min);
+    std::copy(functor.Max, functor.Max + 3, max);
+  }
+
+  // Sort the centers of a range of cells into buckets, in parallel. The
+  // buckets only hold counts and extrema, so they do not depend on the
+  // order in which the cells are processed.
+  struct BinFunctor
+  {
+    const PerCell* Cells;
+    const float* Min;
+    const float* InverseExtent;
+    vtkSMPThreadLocal<std::vector<Bucket>> LocalBuckets;
+    std::vector<Bucket> Buckets;
+
+    void Initialize() { this->LocalBuckets.Local().resize(3 * CELLTREE_BUCKETS); }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      Bucket* b = this->LocalBuckets.Local().data();
+      for (const PerCell* pc = this->Cells + begin; pc != this->Cells + end; ++pc)
+      {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+          float cen = (pc->Min[d] + pc->Max[d]) / 2.0f;
+          int ind = (int)((cen - this->Min[d]) * this->InverseExtent[d]);
+
+          if (ind < 0)
+          {
+            ind = 0;
+          }
+
+          if (ind >= CELLTREE_BUCKETS)
+          {
+            ind = CELLTREE_BUCKETS - 1;
+          }
+
+          b[d * CELLTREE_BUCKETS + ind].Add(pc->Min[d], pc->Max[d]);
+        }
+      }
+    }
+
+    void Reduce()
+    {
+      this->Buckets.assign(3 * CELLTREE_BUCKETS, Bucket());
+      for (const std::vector<Bucket>& local : this->LocalBuckets)
+      {
+        for (std::size_t i = 0; i < local.size(); ++i)
+        {
+          this->Buckets[i].Cnt += local[i].Cnt;
+          this->Buckets[i].Min = std::min(this->Buckets[i].Min, local[i].Min);
+          this->Buckets[i].Max = std::max(this->Buckets[i].Max, local[i].Max);
+        }
+      }
+    }
+  };
+
   // -------------------------------------------------------------------------
 
-  void Split(unsigned int index, float min[3], float max[3])
+  // Split a node in two children appended to nodes, and return the bounds
+  // of the children. Returns false when the node is left as a leaf. The
+  // cells of large nodes are binned in parallel.
+  bool SplitNode(std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes, unsigned int index,
+    const float min[3], const float max[3], float lmin[3], float lmax[3], float rmin[3],
+    float rmax[3])
   {
-    unsigned int start = this->m_nodes[index].Start();
-    unsigned int size = this->m_nodes[index].Size();
+    unsigned int start = nodes[index].Start();
+    unsigned int size = nodes[index].Size();
 
     if (size < this->m_leafsize)
     {
-      return;
+      return false;
     }
 
     PerCell* begin = &(this->m_pc[start]);
     PerCell* end = &(this->m_pc[0]) + start + size;
     PerCell* mid = begin;
 
-    const int nbuckets = 6;
+    const int nbuckets = CELLTREE_BUCKETS;
 
     const float ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
     const float iext[3] = { nbuckets / ext[0], nbuckets / ext[1], nbuckets / ext[2] };
 
     Bucket b[3][nbuckets];
 
-    for (const PerCell* pc = begin; pc != end; ++pc)
+    if (size >= CELLTREE_PARALLEL_SIZE)
     {
-      for (unsigned int d = 0; d < 3; ++d)
+      BinFunctor functor;
+      functor.Cells = begin;
+      functor.Min = min;
+      functor.InverseExtent = iext;
+      vtkSMPTools::For(0, size, functor);
+      std::copy(functor.Buckets.begin(), functor.Buckets.end(), &b[0][0]);
+    }
+    else
+    {
+      for (const PerCell* pc = begin; pc != end; ++pc)
       {
-        float cen = (pc->Min[d] + pc->Max[d]) / 2.0f;
-        int ind = (int)((cen - min[d]) * iext[d]);
-
-        if (ind < 0)
+        for (unsigned int d = 0; d < 3; ++d)
         {
-          ind = 0;
-        }
+          float cen = (pc->Min[d] + pc->Max[d]) / 2.0f;
+          int ind = (int)((cen - min[d]) * iext[d]);
 
-        if (ind >= nbuckets)
-        {
-          ind = nbuckets - 1;
-        }
+          if (ind < 0)
+          {
+            ind = 0;
+          }
+
+          if (ind >= nbuckets)
+          {
+            ind = nbuckets - 1;
+          }
 
-        b[d][ind].Add(pc->Min[d], pc->Max[d]);
+          b[d][ind].Add(pc->Min[d], pc->Max[d]);
+        }
       }
     }
 
@@ -349,22 +483,22 @@ private:
 
       for (unsigned int n = 0; n < (unsigned int)nbuckets - 1; ++n)
       {
-        float lmax = -std::numeric_limits<float>::max();
-        float rmin = std::numeric_limits<float>::max();
+        float lmaxb = -std::numeric_limits<float>::max();
+        float rminb = std::numeric_limits<float>::max();
 
         for (unsigned int m = 0; m <= n; ++m)
         {
-          if (b[d][m].Max > lmax)
+          if (b[d][m].Max > lmaxb)
           {
-            lmax = b[d][m].Max;
+            lmaxb = b[d][m].Max;
           }
         }
 
         for (unsigned int m = n + 1; m < (unsigned int)nbuckets; ++m)
         {
-          if (b[d][m].Min < rmin)
+          if (b[d][m].Min < rminb)
           {
-            rmin = b[d][m].Min;
+            rminb = b[d][m].Min;
           }
         }
 
@@ -372,12 +506,13 @@ private:
         // JB : added if (...) to stop floating point error if rmin is unset
         // this happens when some buckets are empty (bad volume calc)
         //
-        if (lmax != -std::numeric_limits<float>::max() && rmin != std::numeric_limits<float>::max())
+        if (lmaxb != -std::numeric_limits<float>::max() &&
+          rminb != std::numeric_limits<float>::max())
         {
           sum += b[d][n].Cnt;
 
-          float lvol = (lmax - min[d]) / ext[d];
-          float rvol = (max[d] - rmin) / ext[d];
+          float lvol = (lmaxb - min[d]) / ext[d];
+          float rvol = (max[d] - rminb) / ext[d];
 
           float c = lvol * sum + rvol * (size - sum);
 
@@ -405,10 +540,8 @@ private:
       std::nth_element(begin, mid, end, CenterOrder(dim));
     }
 
-    float lmin[3], lmax[3], rmin[3], rmax[3];
-
-    FindMinMax(begin, mid, lmin, lmax);
-    FindMinMax(mid, end, rmin, rmax);
+    this->FindMinMaxInParallel(begin, mid, lmin, lmax);
+    this->FindMinMaxInParallel(mid, end, rmin, rmax);
 
     float clip[2] = { lmax[dim], rmin[dim] };
 
@@ -416,66 +549,160 @@ private:
     child[0].MakeLeaf(begin - &(this->m_pc[0]), mid - begin);
     child[1].MakeLeaf(mid - &(this->m_pc[0]), end - mid);
 
-    this->m_nodes[index].MakeNode((int)m_nodes.size(), dim, clip);
-    this->m_nodes.insert(m_nodes.end(), child, child + 2);
-
-    Split(this->m_nodes[index].GetLeftChildIndex(), lmin, lmax);
-    Split(this->m_nodes[index].GetRightChildIndex(), rmin, rmax);
+    nodes[index].MakeNode((int)nodes.size(), dim, clip);
+    nodes.insert(nodes.end(), child, child + 2);
+    return true;
   }
 
-public:
-  vtkCellTreeBuilder()
+  void Split(
+    std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes, unsigned int index, float min[3],
+    float max[3])
   {
-    this->m_buckets = 5;
-    this->m_leafsize = 8;
+    float lmin[3], lmax[3], rmin[3], rmax[3];
+    if (!this->SplitNode(nodes, index, min, max, lmin, lmax, rmin, rmax))
+    {
+      return;
+    }
+
+    Split(nodes, nodes[index].GetLeftChildIndex(), lmin, lmax);
+    Split(nodes, nodes[index].GetRightChildIndex(), rmin, rmax);
   }
 
-  void Build(vtkCellTreeLocator* ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds)
+  // A node split after the top of the tree is built, with its own nodes.
+  struct Subtree
   {
-    const vtkIdType size = ds->GetNumberOfCells();
-    double cellBounds[6];
-    this->m_pc.resize(size);
-
-    float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-      std::numeric_limits<float>::max() };
-
-    float max[3] = {
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-    };
+    unsigned int Index;
+    float Min[3];
+    float Max[3];
+    std::vector<vtkCellTreeLocator::vtkCellTreeNode> Nodes;
+  };
 
-    for (vtkIdType i = 0; i < size; ++i)
+  // Split the top of the tree breadth first, binning the large nodes in
+  // parallel, then split the remaining subtrees concurrently. The nodes of
+  // a subtree own disjoint ranges of cells, and the tree is the same as the
+  // one built by a sequential Split().
+  void SplitInParallel(float min[3], float max[3])
+  {
+    const unsigned int size = this->m_nodes[0].Size();
+    const unsigned int subtreeSize = std::max(static_cast<unsigned int>(CELLTREE_PARALLEL_SIZE),
+      size / (8 * vtkSMPTools::GetEstimatedNumberOfThreads()));
+
+    std::vector<Subtree> subtrees;
+    std::vector<Subtree> pending(1);
+    pending[0].Index = 0;
+    std::copy(min, min + 3, pending[0].Min);
+    std::copy(max, max + 3, pending[0].Max);
+    while (!pending.empty())
     {
-      this->m_pc[i].Ind = i;
-
-      double* boundsPtr = cellBounds;
-      if (ctl->CellBounds)
+      Subtree node = pending.back();
+      pending.pop_back();
+      if (this->m_nodes[node.Index].Size() <= subtreeSize)
       {
-        boundsPtr = ctl->CellBounds[i];
+        subtrees.push_back(node);
+        continue;
       }
-      else
+      Subtree left, right;
+      if (this->SplitNode(this->m_nodes, node.Index, node.Min, node.Max, left.Min, left.Max,
+            right.Min, right.Max))
       {
-        ds->GetCellBounds(i, boundsPtr);
+        left.Index = this->m_nodes[node.Index].GetLeftChildIndex();
+        right.Index = this->m_nodes[node.Index].GetRightChildIndex();
+        pending.push_back(right);
+        pending.push_back(left);
       }
+    }
 
-      for (int d = 0; d < 3; ++d)
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+      [this, &subtrees](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          Subtree& subtree = subtrees[i];
+          subtree.Nodes.assign(1, this->m_nodes[subtree.Index]);
+          this->Split(subtree.Nodes, 0, subtree.Min, subtree.Max);
+        }
+      });
+
+    // Append the nodes of the subtrees, their root replacing the leaf they
+    // were split from.
+    for (Subtree& subtree : subtrees)
+    {
+      const unsigned int offset = static_cast<unsigned int>(this->m_nodes.size()) - 1;
+      for (vtkCellTreeLocator::vtkCellTreeNode& node : subtree.Nodes)
       {
-        this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
-        this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
+        if (node.IsNode())
+        {
+          node.SetChildren(node.GetLeftChildIndex() + offset);
+        }
+      }
+      this->m_nodes[subtree.Index] = subtree.Nodes[0];
+      this->m_nodes.insert(this->m_nodes.end(), subtree.Nodes.begin() + 1, subtree.Nodes.end());
+    }
+  }
 
-        if (this->m_pc[i].Min[d] < min[d])
+  // Copy the bounds of the cells, and compute the bounds of the data set.
+  struct PerCellFunctor : public MinMaxFunctor
+  {
+    vtkCellTreeLocator* Locator;
+    vtkDataSet* DataSet;
+    PerCell* Output;
+
+    void Initialize() { this->MinMaxFunctor::Initialize(); }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      double cellBounds[6];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        this->Output[i].Ind = i;
+
+        double* boundsPtr = cellBounds;
+        if (this->Locator->CellBounds)
         {
-          min[d] = this->m_pc[i].Min[d];
+          boundsPtr = this->Locator->CellBounds[i];
+        }
+        else
+        {
+          this->DataSet->GetCellBounds(i, boundsPtr);
         }
 
-        if (this->m_pc[i].Max[d] > max[d]) /// This can be m_pc[i].max[d] instead of min
+        for (int d = 0; d < 3; ++d)
         {
-          max[d] = this->m_pc[i].Max[d];
+          this->Output[i].Min[d] = boundsPtr[2 * d + 0];
+          this->Output[i].Max[d] = boundsPtr[2 * d + 1];
         }
       }
+      this->MinMaxFunctor::operator()(begin, end);
     }
 
+    void Reduce() { this->MinMaxFunctor::Reduce(); }
+  };
+
+public:
+  vtkCellTreeBuilder()
+  {
+    this->m_buckets = 5;
+    this->m_leafsize = 8;
+  }
+
+  void Build(vtkCellTreeLocator* ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds)
+  {
+    const vtkIdType size = ds->GetNumberOfCells();
+    this->m_pc.resize(size);
+
+    // This is done to cause non-thread safe initialization to occur due to
+    // side effects from GetCellBounds().
+    double cellBounds[6];
+    ds->GetCellBounds(0, cellBounds);
+
+    PerCellFunctor perCell;
+    perCell.Locator = ctl;
+    perCell.DataSet = ds;
+    perCell.Output = this->m_pc.data();
+    perCell.Cells = this->m_pc.data();
+    vtkSMPTools::For(0, size, perCell);
+    float* min = perCell.Min;
+    float* max = perCell.Max;
+
     ct.DataBBox[0] = min[0];
     ct.DataBBox[1] = max[0];
     ct.DataBBox[2] = min[1];
@@ -487,7 +714,7 @@ public:
     root.MakeLeaf(0, size);
     this->m_nodes.push_back(root);
 
-    Split(0, min, max);
+    this->SplitInParallel(min, max);
 
     ct.Nodes.resize(this->m_nodes.size());
     ct.Nodes[0] = this->m_nodes[0];
@@ -684,18 +911,15 @@ double _getMinDistNEG_Z(const double origin[3], const double dir[3], const doubl
 typedef std::pair<double, int> Intersection;
 
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
 }
 
+// The traversal only uses local state and the given cell, so that it can be
+// run concurrently with a cell per thread.
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds, vtkGenericCell* cell)
 {
   //
   vtkCellTreeNode *node, *near, *far;
@@ -790,7 +1014,8 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
         node = near;
       }
     }
-    double t_hit, ipt[3];
+    double t_hit, ipt[3], ipcoords[3];
+    int isubId;
     // Ok, so we're a leaf node, first check the BBox against the ray
     // then test the candidates in our sorted ray direction order
     _tmin = tmin;
@@ -822,16 +1047,21 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
       ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(
+              cell_ID, p1, p2, tol, t_hit, ipt, ipcoords, isubId, cell))
         {
           if (t_hit < closest_intersection)
           {
             HIT = true;
             closest_intersection = t_hit;
             cellIds = cell_ID;
+            subId = isubId;
             x[0] = ipt[0];
             x[1] = ipt[1];
             x[2] = ipt[2];
+            pcoords[0] = ipcoords[0];
+            pcoords[1] = ipcoords[1];
+            pcoords[2] = ipcoords[2];
           }
         }
       }
@@ -841,6 +1071,7 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellIds, cell);
   }
   //
   return HIT;
@@ -1218,6 +1449,19 @@ void vtkCellTreeLocator::Classify(const double origin[3], const double dir[3], d
   }
 }
 //------------------------------------------------------------------------------
+int vtkCellTreeLocator::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+  vtkGenericCell* cell)
+{
+  if (cell == this->GenericCell)
+  {
+    return this->IntersectCellInternal(cell_ID, p1, p2, tol, t, ipt, pcoords, subId);
+  }
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
+    const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+}
+//------------------------------------------------------------------------------
 int vtkCellTreeLocator::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
   const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId)
 {
@@ -122,6 +122,17 @@ public:
    */
   vtkIdType FindCell(double x[3]) override { return this->Superclass::FindCell(x); }
 
+  /**
+   * FindCell() and IntersectWithLine() are thread safe when each thread
+   * passes its own vtkGenericCell, once the tree is built. With
+   * LazyEvaluation the tree is built on the first query, so the batched
+   * queries are only run in parallel once it exists.
+   */
+  bool SupportsConcurrentQueries() override
+  {
+    return !this->LazyEvaluation || (this->Tree && this->BuildTime > this->MTime);
+  }
+
   //@{
   /**
    * Satisfy vtkLocator abstract interface.
@@ -214,6 +225,13 @@ protected:
   // it can be overridden by subclasses to perform special treatment
   // (Example : Particles stored in tree, have no dimension, so we must
   // override the cell test to return a value based on some particle size
+  // The cell is used to evaluate the candidate, so that concurrent queries
+  // do not share it. When it is the locator's own cell, the test is forwarded
+  // to the signature without a cell, so that subclasses overriding it keep
+  // working for the queries that do not pass their own cell.
+  virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
+    const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+    vtkGenericCell* cell);
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
     const double tol, double& t, double ipt[3], double pcoords[3], int& subId);
 
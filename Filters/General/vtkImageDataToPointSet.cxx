@@ -26,19 +26,24 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStructuredGrid.h"
+#include "vtkStructuredPointArray.h"
 
 #include "vtkNew.h"
 
 vtkStandardNewMacro(vtkImageDataToPointSet);
 
 //------------------------------------------------------------------------------
-vtkImageDataToPointSet::vtkImageDataToPointSet() = default;
+vtkImageDataToPointSet::vtkImageDataToPointSet()
+  : ImplicitPoints(false)
+{
+}
 
 vtkImageDataToPointSet::~vtkImageDataToPointSet() = default;
 
 void vtkImageDataToPointSet::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ImplicitPoints: " << (this->ImplicitPoints ? "On" : "Off") << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -75,23 +80,29 @@ int vtkImageDataToPointSet::RequestData(vtkInformation* vtkNotUsed(request),
   outData->GetPointData()->PassData(inData->GetPointData());
   outData->GetCellData()->PassData(inData->GetCellData());
 
-  // Extract points coordinates from the image
-  vtkIdType nbPoints = inData->GetNumberOfPoints();
-  vtkNew<vtkPoints> points;
-  points->SetDataTypeToDouble();
-  points->SetNumberOfPoints(nbPoints);
-  for (vtkIdType i = 0; i < nbPoints; i++)
-  {
-    double p[3];
-    inData->GetPoint(i, p);
-    points->SetPoint(i, p);
-  }
-  outData->SetPoints(points);
-
   // Copy Extent
   int extent[6];
   inData->GetExtent(extent);
   outData->SetExtent(extent);
 
+  // The points coordinates are computed from the image, on demand if the
+  // points are implicit
+  vtkNew<vtkStructuredPointArray<double>> coordinates;
+  coordinates->ConstructBackend(extent, inData->GetIndexToPhysicalMatrix()->GetData());
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(inData->GetNumberOfPoints());
+  vtkNew<vtkPoints> points;
+  if (this->ImplicitPoints)
+  {
+    points->SetData(coordinates);
+  }
+  else
+  {
+    points->SetDataTypeToDouble();
+    points->SetNumberOfPoints(inData->GetNumberOfPoints());
+    coordinates->ExportToVoidPointer(points->GetVoidPointer(0));
+  }
+  outData->SetPoints(points);
+
   return 1;
 }
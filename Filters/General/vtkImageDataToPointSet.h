@@ -47,6 +47,20 @@ public:
 
   static vtkImageDataToPointSet* New();
 
+  //@{
+  /**
+   * When on, the output points are a vtkStructuredPointArray computing the
+   * coordinates from the input image instead of storing them. This saves the
+   * memory of the coordinates, but downstream filters that access the points
+   * through raw pointers then generate them into a temporary buffer, and
+   * vtkArrayDispatch only handles them when VTK_DISPATCH_STRUCTURED_POINT_ARRAYS
+   * is enabled. Off by default: the coordinates are stored in a vtkDoubleArray.
+   */
+  vtkSetMacro(ImplicitPoints, bool);
+  vtkGetMacro(ImplicitPoints, bool);
+  vtkBooleanMacro(ImplicitPoints, bool);
+  //@}
+
 protected:
   vtkImageDataToPointSet();
   ~vtkImageDataToPointSet() override;
@@ -56,6 +70,8 @@ protected:
 
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
+  bool ImplicitPoints;
+
 private:
   vtkImageDataToPointSet(const vtkImageDataToPointSet&) = delete;
   void operator=(const vtkImageDataToPointSet&) = delete;
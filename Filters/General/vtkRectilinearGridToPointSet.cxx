@@ -25,19 +25,24 @@
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkStructuredGrid.h"
+#include "vtkStructuredPointArray.h"
 
 #include "vtkNew.h"
 
 vtkStandardNewMacro(vtkRectilinearGridToPointSet);
 
 //------------------------------------------------------------------------------
-vtkRectilinearGridToPointSet::vtkRectilinearGridToPointSet() = default;
+vtkRectilinearGridToPointSet::vtkRectilinearGridToPointSet()
+  : ImplicitPoints(false)
+{
+}
 
 vtkRectilinearGridToPointSet::~vtkRectilinearGridToPointSet() = default;
 
 void vtkRectilinearGridToPointSet::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ImplicitPoints: " << (this->ImplicitPoints ? "On" : "Off") << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -64,33 +69,33 @@ int vtkRectilinearGridToPointSet::CopyStructure(
 
   outData->SetExtent(extent);
 
-  vtkNew<vtkPoints> points;
-  points->SetDataTypeToDouble();
-  points->SetNumberOfPoints(inData->GetNumberOfPoints());
-
-  vtkIdType pointId = 0;
-  int ijk[3];
-  for (ijk[2] = extent[4]; ijk[2] <= extent[5]; ijk[2]++)
+  // The points coordinates are computed from the axes coordinates, on demand
+  // if the points are implicit
+  vtkDataArray* axes[3] = { xcoord, ycoord, zcoord };
+  for (int axis = 0; axis < 3; ++axis)
   {
-    for (ijk[1] = extent[2]; ijk[1] <= extent[3]; ijk[1]++)
+    const vtkIdType size = extent[2 * axis + 1] - extent[2 * axis] + 1;
+    if (!axes[axis] || axes[axis]->GetNumberOfTuples() < size)
     {
-      for (ijk[0] = extent[0]; ijk[0] <= extent[1]; ijk[0]++)
-      {
-        double coord[3];
-        coord[0] = xcoord->GetComponent(ijk[0] - extent[0], 0);
-        coord[1] = ycoord->GetComponent(ijk[1] - extent[2], 0);
-        coord[2] = zcoord->GetComponent(ijk[2] - extent[4], 0);
-
-        points->SetPoint(pointId, coord);
-        pointId++;
-      }
+      vtkErrorMacro(<< "Not enough coordinates along axis " << axis);
+      return 0;
     }
   }
 
-  if (pointId != points->GetNumberOfPoints())
+  vtkNew<vtkStructuredPointArray<double>> coordinates;
+  coordinates->ConstructBackend(extent, xcoord, ycoord, zcoord);
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(inData->GetNumberOfPoints());
+  vtkNew<vtkPoints> points;
+  if (this->ImplicitPoints)
   {
-    vtkErrorMacro(<< "Somehow miscounted points");
-    return 0;
+    points->SetData(coordinates);
+  }
+  else
+  {
+    points->SetDataTypeToDouble();
+    points->SetNumberOfPoints(inData->GetNumberOfPoints());
+    coordinates->ExportToVoidPointer(points->GetVoidPointer(0));
   }
 
   outData->SetPoints(points);
@@ -48,6 +48,20 @@ public:
 
   static vtkRectilinearGridToPointSet* New();
 
+  //@{
+  /**
+   * When on, the output points are a vtkStructuredPointArray computing the
+   * coordinates from the input grid instead of storing them. This saves the
+   * memory of the coordinates, but downstream filters that access the points
+   * through raw pointers then generate them into a temporary buffer, and
+   * vtkArrayDispatch only handles them when VTK_DISPATCH_STRUCTURED_POINT_ARRAYS
+   * is enabled. Off by default: the coordinates are stored in a vtkDoubleArray.
+   */
+  vtkSetMacro(ImplicitPoints, bool);
+  vtkGetMacro(ImplicitPoints, bool);
+  vtkBooleanMacro(ImplicitPoints, bool);
+  //@}
+
 protected:
   vtkRectilinearGridToPointSet();
   ~vtkRectilinearGridToPointSet() override;
@@ -57,6 +71,8 @@ protected:
 
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
+  bool ImplicitPoints;
+
 private:
   vtkRectilinearGridToPointSet(const vtkRectilinearGridToPointSet&) = delete;
   void operator=(const vtkRectilinearGridToPointSet&) = delete;
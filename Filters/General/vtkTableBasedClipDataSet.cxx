@@ -49,3205 +49,1549 @@
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 #include "vtkTableBasedClipCases.cxx"
 
 vtkStandardNewMacro(vtkTableBasedClipDataSet);
 vtkCxxSetObjectMacro(vtkTableBasedClipDataSet, ClipFunction, vtkImplicitFunction);
 
 // ============================================================================
-// ============== vtkTableBasedClipperDataSetFromVolume (begin) ===============
+// ================= vtkTableBasedClipper cell clipping (begin) ===============
 // ============================================================================
 
-struct TableBasedClipperPointEntry
-{
-  vtkIdType ptIds[2];
-  double percent;
+namespace
+{
+// Cells are clipped by chunks of consecutive cells. The outputs of the chunks
+// are concatenated in cell order, so that the output does not depend on the
+// number of threads.
+constexpr vtkIdType TableBasedClipperChunkSize = 4096;
+
+// The kinds of output shapes, in the order their cells are output.
+enum TableBasedClipperShapeClass
+{
+  ClipperTets = 0,
+  ClipperPyramids,
+  ClipperWedges,
+  ClipperHexes,
+  ClipperQuads,
+  ClipperTris,
+  ClipperLines,
+  ClipperVertices,
+  ClipperNumberOfShapeClasses
 };
 
-// ---- vtkTableBasedClipperPointList (bein)
-class vtkTableBasedClipperPointList
+const int TableBasedClipperShapeSizes[ClipperNumberOfShapeClasses] = { 4, 5, 6, 8, 4, 3, 2, 1 };
+
+const unsigned char TableBasedClipperShapeTypes[ClipperNumberOfShapeClasses] = { VTK_TETRA,
+  VTK_PYRAMID, VTK_WEDGE, VTK_HEXAHEDRON, VTK_QUAD, VTK_TRIANGLE, VTK_LINE, VTK_VERTEX };
+
+// A point on the edge (V0, V1), V0 < V1, at V0 * Percent + V1 * (1 - Percent).
+struct TableBasedClipperEdgePoint
 {
-public:
-  vtkTableBasedClipperPointList();
-  virtual ~vtkTableBasedClipperPointList();
-
-  vtkIdType AddPoint(vtkIdType, vtkIdType, double);
-  vtkIdType GetTotalNumberOfPoints() const;
-  int GetNumberOfLists() const;
-  int GetList(vtkIdType, const TableBasedClipperPointEntry*&) const;
-
-protected:
-  vtkIdType currentList;
-  vtkIdType currentPoint;
-  int listSize;
-  int pointsPerList;
-  TableBasedClipperPointEntry** list;
+  vtkIdType V0;
+  vtkIdType V1;
+  double Percent;
 };
-// ---- vtkTableBasedClipperPointList (end)
 
-// ---- vtkTableBasedClipperEdgeHashEntry (begin)
-class vtkTableBasedClipperEdgeHashEntry
+// A point at the center of NumberOfPoints points.
+struct TableBasedClipperCentroidPoint
 {
-public:
-  vtkTableBasedClipperEdgeHashEntry();
-  virtual ~vtkTableBasedClipperEdgeHashEntry() = default;
-
-  int GetPointId() { return ptId; }
-  void SetInfo(int, int, int);
-  void SetNext(vtkTableBasedClipperEdgeHashEntry* n) { next = n; }
-  bool IsMatch(int i1, int i2) { return (i1 == id1 && i2 == id2 ? true : false); }
-
-  vtkTableBasedClipperEdgeHashEntry* GetNext() { return next; }
+  int NumberOfPoints;
+  vtkIdType PointIds[8];
+};
 
-protected:
-  int id1, id2;
-  int ptId;
-  vtkTableBasedClipperEdgeHashEntry* next;
+// What a chunk of cells outputs. The point ids of the shapes and of the
+// centroid points are either input point ids in [0, numInputPoints), or
+// numInputPoints + i for the i-th edge point of the chunk, or -1 - i for the
+// i-th centroid point of the chunk.
+struct TableBasedClipperChunk
+{
+  // The (cell id, point ids) of the shapes of each class.
+  std::vector<vtkIdType> Shapes[ClipperNumberOfShapeClasses];
+  std::vector<TableBasedClipperEdgePoint> EdgePoints;
+  std::vector<TableBasedClipperCentroidPoint> CentroidPoints;
+  // The cells the clip tables do not handle.
+  std::vector<vtkIdType> SpecialCells;
 };
-// ---- vtkTableBasedClipperEdgeHashEntry (end)
 
-// ---- vtkTableBasedClipperEdgeHashEntryMemoryManager (begin)
-#define FREE_ENTRY_LIST_SIZE 16384
-#define POOL_SIZE 256
-class vtkTableBasedClipperEdgeHashEntryMemoryManager
-{
-public:
-  vtkTableBasedClipperEdgeHashEntryMemoryManager();
-  virtual ~vtkTableBasedClipperEdgeHashEntryMemoryManager();
+typedef const int TableBasedClipperEdgeVertices[2];
 
-  inline vtkTableBasedClipperEdgeHashEntry* GetFreeEdgeHashEntry()
+bool IsTableBasedClipperCellType(int cellType)
+{
+  switch (cellType)
   {
-    if (freeEntryindex <= 0)
-    {
-      AllocateEdgeHashEntryPool();
-    }
-    freeEntryindex--;
-    return freeEntrylist[freeEntryindex];
+    case VTK_TETRA:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_LINE:
+    case VTK_VERTEX:
+      return true;
+    default:
+      return false;
   }
+}
 
-  inline void ReRegisterEdgeHashEntry(vtkTableBasedClipperEdgeHashEntry* q)
+// Start of the clip case, number of output shapes, and vertices from edges.
+void GetTableBasedClipperCase(int cellType, int caseIndx, const unsigned char*& thisCase,
+  int& nOutputs, TableBasedClipperEdgeVertices*& edgeVtxs)
+{
+  using namespace vtkTableBasedClipperClipTables;
+  using namespace vtkTableBasedClipperTriangulationTables;
+  switch (cellType)
   {
-    if (freeEntryindex >= FREE_ENTRY_LIST_SIZE - 1)
-    {
-      // We've got plenty, so ignore this one.
-      return;
-    }
-    freeEntrylist[freeEntryindex] = q;
-    freeEntryindex++;
-  }
+    case VTK_TETRA:
+      thisCase = &ClipShapesTet[StartClipShapesTet[caseIndx]];
+      nOutputs = NumClipShapesTet[caseIndx];
+      edgeVtxs = TetVerticesFromEdges;
+      break;
 
-protected:
-  int freeEntryindex;
-  vtkTableBasedClipperEdgeHashEntry* freeEntrylist[FREE_ENTRY_LIST_SIZE];
-  std::vector<vtkTableBasedClipperEdgeHashEntry*> edgeHashEntrypool;
+    case VTK_PYRAMID:
+      thisCase = &ClipShapesPyr[StartClipShapesPyr[caseIndx]];
+      nOutputs = NumClipShapesPyr[caseIndx];
+      edgeVtxs = PyramidVerticesFromEdges;
+      break;
 
-  void AllocateEdgeHashEntryPool();
-};
-// ---- vtkTableBasedClipperEdgeHashEntryMemoryManager (end)
+    case VTK_WEDGE:
+      thisCase = &ClipShapesWdg[StartClipShapesWdg[caseIndx]];
+      nOutputs = NumClipShapesWdg[caseIndx];
+      edgeVtxs = WedgeVerticesFromEdges;
+      break;
 
-// ---- vtkTableBasedClipperEdgeHashTable (begin)
-class vtkTableBasedClipperEdgeHashTable
-{
-public:
-  vtkTableBasedClipperEdgeHashTable(int, vtkTableBasedClipperPointList&);
-  virtual ~vtkTableBasedClipperEdgeHashTable();
+    case VTK_HEXAHEDRON:
+      thisCase = &ClipShapesHex[StartClipShapesHex[caseIndx]];
+      nOutputs = NumClipShapesHex[caseIndx];
+      edgeVtxs = HexVerticesFromEdges;
+      break;
 
-  vtkIdType AddPoint(vtkIdType, vtkIdType, double);
-  vtkTableBasedClipperPointList& GetPointList();
+    case VTK_VOXEL:
+      thisCase = &ClipShapesVox[StartClipShapesVox[caseIndx]];
+      nOutputs = NumClipShapesVox[caseIndx];
+      edgeVtxs = VoxVerticesFromEdges;
+      break;
 
-protected:
-  int nHashes;
-  vtkTableBasedClipperPointList& pointlist;
-  vtkTableBasedClipperEdgeHashEntry** hashes;
-  vtkTableBasedClipperEdgeHashEntryMemoryManager emm;
+    case VTK_TRIANGLE:
+      thisCase = &ClipShapesTri[StartClipShapesTri[caseIndx]];
+      nOutputs = NumClipShapesTri[caseIndx];
+      edgeVtxs = TriVerticesFromEdges;
+      break;
 
-  int GetKey(int, int);
+    case VTK_QUAD:
+      thisCase = &ClipShapesQua[StartClipShapesQua[caseIndx]];
+      nOutputs = NumClipShapesQua[caseIndx];
+      edgeVtxs = QuadVerticesFromEdges;
+      break;
 
-private:
-  vtkTableBasedClipperEdgeHashTable(const vtkTableBasedClipperEdgeHashTable&) = delete;
-  void operator=(const vtkTableBasedClipperEdgeHashTable&) = delete;
-};
-// ---- vtkTableBasedClipperEdgeHashTable (end)
+    case VTK_PIXEL:
+      thisCase = &ClipShapesPix[StartClipShapesPix[caseIndx]];
+      nOutputs = NumClipShapesPix[caseIndx];
+      edgeVtxs = PixelVerticesFromEdges;
+      break;
 
-class vtkTableBasedClipperDataSetFromVolume
-{
-public:
-  vtkTableBasedClipperDataSetFromVolume(vtkIdType ptSizeGuess);
-  vtkTableBasedClipperDataSetFromVolume(vtkIdType nPts, vtkIdType ptSizeGuess);
-  virtual ~vtkTableBasedClipperDataSetFromVolume() = default;
+    case VTK_LINE:
+      thisCase = &ClipShapesLin[StartClipShapesLin[caseIndx]];
+      nOutputs = NumClipShapesLin[caseIndx];
+      edgeVtxs = LineVerticesFromEdges;
+      break;
 
-  vtkIdType AddPoint(vtkIdType p1, vtkIdType p2, double percent)
-  {
-    return numPrevPts + edges.AddPoint(p1, p2, percent);
+    case VTK_VERTEX:
+      thisCase = &ClipShapesVtx[StartClipShapesVtx[caseIndx]];
+      nOutputs = NumClipShapesVtx[caseIndx];
+      edgeVtxs = nullptr;
+      break;
   }
+}
 
-protected:
-  int numPrevPts;
-  vtkTableBasedClipperPointList pt_list;
-  vtkTableBasedClipperEdgeHashTable edges;
+// Gives the cells of a vtkUnstructuredGrid or of a vtkPolyData whose cells
+// have been built.
+struct TableBasedClipperPointSetCells
+{
+  vtkDataSet* Input;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
 
-private:
-  vtkTableBasedClipperDataSetFromVolume(const vtkTableBasedClipperDataSetFromVolume&) = delete;
-  void operator=(const vtkTableBasedClipperDataSetFromVolume&) = delete;
-};
+  TableBasedClipperPointSetCells(vtkDataSet* input)
+    : Input(input)
+  {
+  }
 
-vtkTableBasedClipperPointList::vtkTableBasedClipperPointList()
-{
-  listSize = 4096;
-  pointsPerList = 1024;
+  int GetCellType(vtkIdType cellId) { return this->Input->GetCellType(cellId); }
 
-  list = new TableBasedClipperPointEntry*[listSize];
-  list[0] = new TableBasedClipperPointEntry[pointsPerList];
-  for (int i = 1; i < listSize; i++)
+  const vtkIdType* GetCellPoints(vtkIdType cellId, vtkIdType& npts, vtkIdType*)
   {
-    list[i] = nullptr;
+    vtkIdList* ptIds = this->CellPoints.Local();
+    this->Input->GetCellPoints(cellId, ptIds);
+    npts = ptIds->GetNumberOfIds();
+    return ptIds->GetPointer(0);
   }
+};
 
-  currentList = 0;
-  currentPoint = 0;
-}
+const int TableBasedClipperShiftLUTx[8] = { 0, 1, 1, 0, 0, 1, 1, 0 };
+const int TableBasedClipperShiftLUTy[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
+const int TableBasedClipperShiftLUTz[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
 
-vtkTableBasedClipperPointList::~vtkTableBasedClipperPointList()
+// Gives the cells of a vtkRectilinearGrid or of a vtkStructuredGrid: quads
+// for 2D grids, hexahedra otherwise.
+struct TableBasedClipperStructuredCells
 {
-  for (int i = 0; i < listSize; i++)
+  int CellType;
+  int CellDims[3];
+  vtkIdType CyStride;
+  vtkIdType CzStride;
+  vtkIdType PyStride;
+  vtkIdType PzStride;
+  const int* ShiftLUT[3];
+
+  TableBasedClipperStructuredCells(const int dims[3])
   {
-    if (list[i] != nullptr)
+    const bool isTwoDim = dims[0] <= 1 || dims[1] <= 1 || dims[2] <= 1;
+    this->CellType = isTwoDim ? VTK_QUAD : VTK_HEXAHEDRON;
+    if (isTwoDim && dims[0] > 1 && dims[1] <= 1)
+    {
+      // XZ plane
+      this->ShiftLUT[0] = TableBasedClipperShiftLUTx;
+      this->ShiftLUT[1] = TableBasedClipperShiftLUTz;
+      this->ShiftLUT[2] = TableBasedClipperShiftLUTy;
+    }
+    else if (isTwoDim && dims[0] <= 1)
     {
-      delete[] list[i];
+      // YZ plane
+      this->ShiftLUT[0] = TableBasedClipperShiftLUTy;
+      this->ShiftLUT[1] = TableBasedClipperShiftLUTz;
+      this->ShiftLUT[2] = TableBasedClipperShiftLUTx;
     }
     else
     {
-      break;
+      this->ShiftLUT[0] = TableBasedClipperShiftLUTx;
+      this->ShiftLUT[1] = TableBasedClipperShiftLUTy;
+      this->ShiftLUT[2] = TableBasedClipperShiftLUTz;
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+      this->CellDims[i] = dims[i] - 1;
     }
+    this->CyStride = (this->CellDims[0] ? this->CellDims[0] : 1);
+    this->CzStride =
+      (this->CellDims[0] ? this->CellDims[0] : 1) * (this->CellDims[1] ? this->CellDims[1] : 1);
+    this->PyStride = dims[0];
+    this->PzStride = static_cast<vtkIdType>(dims[0]) * dims[1];
   }
 
-  delete[] list;
-}
+  int GetCellType(vtkIdType) const { return this->CellType; }
 
-int vtkTableBasedClipperPointList::GetList(
-  vtkIdType listId, const TableBasedClipperPointEntry*& outlist) const
-{
-  if (listId < 0 || listId > currentList)
+  const vtkIdType* GetCellPoints(vtkIdType cellId, vtkIdType& npts, vtkIdType* pts) const
   {
-    outlist = nullptr;
-    return 0;
+    const vtkIdType theCellI = (this->CellDims[0] > 0 ? cellId % this->CellDims[0] : 0);
+    const vtkIdType theCellJ =
+      (this->CellDims[1] > 0 ? (cellId / this->CyStride) % this->CellDims[1] : 0);
+    const vtkIdType theCellK = (this->CellDims[2] > 0 ? (cellId / this->CzStride) : 0);
+
+    npts = (this->CellType == VTK_QUAD ? 4 : 8);
+    for (vtkIdType j = 0; j < npts; ++j)
+    {
+      pts[j] = (theCellI + this->ShiftLUT[0][j]) +
+        (theCellJ + this->ShiftLUT[1][j]) * this->PyStride +
+        (theCellK + this->ShiftLUT[2][j]) * this->PzStride;
+    }
+    return pts;
   }
+};
 
-  outlist = list[listId];
-  return (listId == currentList ? currentPoint : pointsPerList);
-}
+// Clips chunks of cells with the clip tables. Each chunk records its output
+// shapes, edge points and centroid points with chunk-local point ids that
+// are made global once all the chunks are clipped.
+template <typename TCells>
+struct TableBasedClipperCellsWorker
+{
+  TCells& Cells;
+  vtkDataArray* ClipArray;
+  double IsoValue;
+  bool InsideOut;
+  vtkIdType NumberOfInputPoints;
+  vtkIdType NumberOfCells;
+  std::vector<TableBasedClipperChunk>& Chunks;
+  std::atomic<bool> InvalidCase;
+
+  TableBasedClipperCellsWorker(TCells& cells, vtkDataArray* clipArray, double isoValue,
+    bool insideOut, vtkIdType numInputPoints, vtkIdType numCells,
+    std::vector<TableBasedClipperChunk>& chunks)
+    : Cells(cells)
+    , ClipArray(clipArray)
+    , IsoValue(isoValue)
+    , InsideOut(insideOut)
+    , NumberOfInputPoints(numInputPoints)
+    , NumberOfCells(numCells)
+    , Chunks(chunks)
+    , InvalidCase(false)
+  {
+  }
+
+  void operator()(vtkIdType beginChunk, vtkIdType endChunk)
+  {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      TableBasedClipperChunk& chunk = this->Chunks[chunkId];
+      const vtkIdType endCellId =
+        std::min((chunkId + 1) * TableBasedClipperChunkSize, this->NumberOfCells);
+      for (vtkIdType cellId = chunkId * TableBasedClipperChunkSize; cellId < endCellId; ++cellId)
+      {
+        this->ClipCell(chunk, cellId);
+      }
+    }
+  }
 
-int vtkTableBasedClipperPointList::GetNumberOfLists() const
-{
-  return currentList + 1;
-}
+  void ClipCell(TableBasedClipperChunk& chunk, vtkIdType cellId)
+  {
+    const int cellType = this->Cells.GetCellType(cellId);
+    if (!IsTableBasedClipperCellType(cellType))
+    {
+      chunk.SpecialCells.push_back(cellId);
+      return;
+    }
 
-vtkIdType vtkTableBasedClipperPointList::GetTotalNumberOfPoints() const
-{
-  vtkIdType numFullLists = currentList; // actually currentList-1+1
-  vtkIdType numExtra = currentPoint;    // again, currentPoint-1+1
+    vtkIdType numbPnts;
+    vtkIdType pntBuffer[8];
+    const vtkIdType* pntIndxs = this->Cells.GetCellPoints(cellId, numbPnts, pntBuffer);
 
-  return numFullLists * pointsPerList + numExtra;
-}
+    int caseIndx = 0;
+    double grdDiffs[8];
+    for (vtkIdType j = numbPnts - 1; j >= 0; j--)
+    {
+      grdDiffs[j] = this->ClipArray->GetComponent(pntIndxs[j], 0) - this->IsoValue;
+      caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
+      caseIndx <<= (1 - (!j));
+    }
 
-vtkIdType vtkTableBasedClipperPointList::AddPoint(vtkIdType pt0, vtkIdType pt1, double percent)
-{
-  if (currentPoint >= pointsPerList)
-  {
-    if ((currentList + 1) >= listSize)
+    const unsigned char* thisCase = nullptr;
+    int nOutputs = 0;
+    TableBasedClipperEdgeVertices* edgeVtxs = nullptr;
+    GetTableBasedClipperCase(cellType, caseIndx, thisCase, nOutputs, edgeVtxs);
+
+    vtkIdType intrpIds[4];
+    for (int j = 0; j < nOutputs; j++)
     {
-      TableBasedClipperPointEntry** tmpList = new TableBasedClipperPointEntry*[2 * listSize];
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
+      int nCellPts = 0;
+      int theColor = -1;
+      int intrpIdx = -1;
+      int shapeClass = -1;
+      unsigned char theShape = *thisCase++;
 
-      for (int i = listSize; i < listSize * 2; i++)
+      // number of points and color
+      switch (theShape)
       {
-        tmpList[i] = nullptr;
-      }
+        case ST_HEX:
+          nCellPts = 8;
+          theColor = *thisCase++;
+          shapeClass = ClipperHexes;
+          break;
 
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
+        case ST_WDG:
+          nCellPts = 6;
+          theColor = *thisCase++;
+          shapeClass = ClipperWedges;
+          break;
 
-    currentList++;
-    list[currentList] = new TableBasedClipperPointEntry[pointsPerList];
-    currentPoint = 0;
-  }
+        case ST_PYR:
+          nCellPts = 5;
+          theColor = *thisCase++;
+          shapeClass = ClipperPyramids;
+          break;
 
-  list[currentList][currentPoint].ptIds[0] = pt0;
-  list[currentList][currentPoint].ptIds[1] = pt1;
-  list[currentList][currentPoint].percent = percent;
-  currentPoint++;
+        case ST_TET:
+          nCellPts = 4;
+          theColor = *thisCase++;
+          shapeClass = ClipperTets;
+          break;
 
-  return (GetTotalNumberOfPoints() - 1);
-}
+        case ST_QUA:
+          nCellPts = 4;
+          theColor = *thisCase++;
+          shapeClass = ClipperQuads;
+          break;
 
-vtkTableBasedClipperEdgeHashEntry::vtkTableBasedClipperEdgeHashEntry()
-{
-  id1 = -1;
-  id2 = -1;
-  ptId = -1;
-  next = nullptr;
-}
+        case ST_TRI:
+          nCellPts = 3;
+          theColor = *thisCase++;
+          shapeClass = ClipperTris;
+          break;
 
-void vtkTableBasedClipperEdgeHashEntry::SetInfo(int i1, int i2, int pId)
-{
-  id1 = i1;
-  id2 = i2;
-  ptId = pId;
-  next = nullptr;
-}
+        case ST_LIN:
+          nCellPts = 2;
+          theColor = *thisCase++;
+          shapeClass = ClipperLines;
+          break;
 
-vtkTableBasedClipperEdgeHashEntryMemoryManager::vtkTableBasedClipperEdgeHashEntryMemoryManager()
-{
-  freeEntryindex = 0;
-}
+        case ST_VTX:
+          nCellPts = 1;
+          theColor = *thisCase++;
+          shapeClass = ClipperVertices;
+          break;
 
-vtkTableBasedClipperEdgeHashEntryMemoryManager::~vtkTableBasedClipperEdgeHashEntryMemoryManager()
-{
-  int npools = static_cast<int>(edgeHashEntrypool.size());
-  for (int i = 0; i < npools; i++)
-  {
-    vtkTableBasedClipperEdgeHashEntry* pool = edgeHashEntrypool[i];
-    delete[] pool;
+        case ST_PNT:
+          intrpIdx = *thisCase++;
+          theColor = *thisCase++;
+          nCellPts = *thisCase++;
+          break;
+
+        default:
+          this->InvalidCase = true;
+          return;
+      }
+
+      if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
+      {
+        // We don't want this one; it's the wrong side.
+        thisCase += nCellPts;
+        continue;
+      }
+
+      vtkIdType shapeIds[8];
+      for (int p = 0; p < nCellPts; p++)
+      {
+        unsigned char pntIndex = *thisCase++;
+
+        if (pntIndex <= P7)
+        {
+          // We know pt P0 must be >P0 since we already
+          // assume P0 == 0.  This is why we do not
+          // bother subtracting P0 from pt here.
+          shapeIds[p] = pntIndxs[pntIndex];
+        }
+        else if (pntIndex >= EA && pntIndex <= EL)
+        {
+          int pt1Index = edgeVtxs[pntIndex - EA][0];
+          int pt2Index = edgeVtxs[pntIndex - EA][1];
+          if (pt2Index < pt1Index)
+          {
+            std::swap(pt1Index, pt2Index);
+          }
+          double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
+          double pt1ToIso = 0.0 - grdDiffs[pt1Index];
+          double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
+
+          shapeIds[p] = this->AddEdgePoint(chunk, pntIndxs[pt1Index], pntIndxs[pt2Index], p1Weight);
+        }
+        else if (pntIndex >= N0 && pntIndex <= N3)
+        {
+          shapeIds[p] = intrpIds[pntIndex - N0];
+        }
+        else
+        {
+          this->InvalidCase = true;
+          return;
+        }
+      }
+
+      if (theShape == ST_PNT)
+      {
+        TableBasedClipperCentroidPoint centroid;
+        centroid.NumberOfPoints = nCellPts;
+        std::copy(shapeIds, shapeIds + nCellPts, centroid.PointIds);
+        chunk.CentroidPoints.push_back(centroid);
+        intrpIds[intrpIdx] = -static_cast<vtkIdType>(chunk.CentroidPoints.size());
+      }
+      else
+      {
+        std::vector<vtkIdType>& shapes = chunk.Shapes[shapeClass];
+        shapes.push_back(cellId);
+        shapes.insert(shapes.end(), shapeIds, shapeIds + nCellPts);
+      }
+    }
   }
-}
 
-void vtkTableBasedClipperEdgeHashEntryMemoryManager::AllocateEdgeHashEntryPool()
-{
-  if (freeEntryindex == 0)
+  vtkIdType AddEdgePoint(TableBasedClipperChunk& chunk, vtkIdType p1, vtkIdType p2, double percent)
   {
-    vtkTableBasedClipperEdgeHashEntry* newlist = new vtkTableBasedClipperEdgeHashEntry[POOL_SIZE];
-    edgeHashEntrypool.push_back(newlist);
-
-    for (int i = 0; i < POOL_SIZE; i++)
+    if (p2 < p1)
     {
-      freeEntrylist[i] = &(newlist[i]);
+      std::swap(p1, p2);
+      percent = 1.0 - percent;
     }
-
-    freeEntryindex = POOL_SIZE;
+    chunk.EdgePoints.push_back(TableBasedClipperEdgePoint{ p1, p2, percent });
+    return this->NumberOfInputPoints + static_cast<vtkIdType>(chunk.EdgePoints.size()) - 1;
   }
-}
+};
 
-vtkTableBasedClipperEdgeHashTable::vtkTableBasedClipperEdgeHashTable(
-  int nh, vtkTableBasedClipperPointList& p)
-  : pointlist(p)
+// Clips the cells by chunks, in parallel unless threaded is false. Returns
+// false if an invalid clip case was found.
+template <typename TCells>
+bool ClipTableBasedCells(TCells& cells, vtkIdType numCells, vtkIdType numInputPoints,
+  vtkDataArray* clipArray, double isoValue, bool insideOut, bool threaded,
+  std::vector<TableBasedClipperChunk>& chunks)
 {
-  nHashes = nh;
-  hashes = new vtkTableBasedClipperEdgeHashEntry*[nHashes];
-  for (int i = 0; i < nHashes; i++)
+  const vtkIdType numChunks =
+    (numCells + TableBasedClipperChunkSize - 1) / TableBasedClipperChunkSize;
+  chunks.resize(numChunks);
+  TableBasedClipperCellsWorker<TCells> worker(
+    cells, clipArray, isoValue, insideOut, numInputPoints, numCells, chunks);
+  if (threaded)
   {
-    hashes[i] = nullptr;
+    vtkSMPTools::For(0, numChunks, 1, worker);
   }
+  else
+  {
+    worker(0, numChunks);
+  }
+  return !worker.InvalidCase;
 }
 
-vtkTableBasedClipperEdgeHashTable::~vtkTableBasedClipperEdgeHashTable()
-{
-  delete[] hashes;
-}
-
-int vtkTableBasedClipperEdgeHashTable::GetKey(int p1, int p2)
+// Returns the ids of the cells the clip tables do not handle, in cell order.
+vtkIdType GetTableBasedClipperSpecialCells(
+  const std::vector<TableBasedClipperChunk>& chunks, vtkIdList* cellIds)
 {
-  int rv = (int)((unsigned int)p1 * 18457U + (unsigned int)p2 * 234749U) % nHashes;
-
-  // In case of overflows and modulo with negative numbers.
-  if (rv < 0)
+  cellIds->Reset();
+  for (const TableBasedClipperChunk& chunk : chunks)
   {
-    rv += nHashes;
+    for (vtkIdType cellId : chunk.SpecialCells)
+    {
+      cellIds->InsertNextId(cellId);
+    }
   }
-
-  return rv;
+  return cellIds->GetNumberOfIds();
 }
 
-vtkIdType vtkTableBasedClipperEdgeHashTable::AddPoint(vtkIdType ap1, vtkIdType ap2, double apercent)
+// The input points: either explicit coordinates, or the coordinates of a
+// rectilinear grid.
+struct TableBasedClipperInputPoints
 {
-  vtkIdType p1, p2;
-  double percent;
+  const double* Points = nullptr;
+  const int* Dims = nullptr;
+  const double* X = nullptr;
+  const double* Y = nullptr;
+  const double* Z = nullptr;
 
-  if (ap2 < ap1)
+  void GetPoint(vtkIdType ptId, double pt[3]) const
   {
-    p1 = ap2;
-    p2 = ap1;
-    percent = 1.0 - apercent;
+    if (this->Points)
+    {
+      const double* x = this->Points + 3 * ptId;
+      pt[0] = x[0];
+      pt[1] = x[1];
+      pt[2] = x[2];
+    }
+    else
+    {
+      const vtkIdType I = ptId % this->Dims[0];
+      const vtkIdType J = (ptId / this->Dims[0]) % this->Dims[1];
+      const vtkIdType K = ptId / (static_cast<vtkIdType>(this->Dims[0]) * this->Dims[1]);
+      pt[0] = this->X[I];
+      pt[1] = this->Y[J];
+      pt[2] = this->Z[K];
+    }
   }
-  else
+};
+
+// Returns the input points as doubles, converting them in buffer if needed.
+const double* GetTableBasedClipperPoints(vtkPoints* points, std::vector<double>& buffer)
+{
+  if (points->GetDataType() == VTK_DOUBLE)
   {
-    p1 = ap1;
-    p2 = ap2;
-    percent = apercent;
+    return static_cast<double*>(points->GetVoidPointer(0));
   }
 
-  int key = GetKey(p1, p2);
-
-  //
-  // See if we have any matches in the current hashes.
-  //
-  vtkTableBasedClipperEdgeHashEntry* cur = hashes[key];
-  while (cur != nullptr)
-  {
-    if (cur->IsMatch(p1, p2))
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  buffer.resize(3 * numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
     {
-      //
-      // We found a match.
-      //
-      return cur->GetPointId();
+      points->GetPoint(i, buffer.data() + 3 * i);
     }
-
-    cur = cur->GetNext();
-  }
-
-  //
-  // There was no match.  We will have to add a new entry.
-  //
-  vtkTableBasedClipperEdgeHashEntry* new_one = emm.GetFreeEdgeHashEntry();
-
-  vtkIdType newPt = pointlist.AddPoint(p1, p2, percent);
-  new_one->SetInfo(p1, p2, newPt);
-  new_one->SetNext(hashes[key]);
-  hashes[key] = new_one;
-
-  return newPt;
-}
-
-vtkTableBasedClipperDataSetFromVolume::vtkTableBasedClipperDataSetFromVolume(vtkIdType ptSizeGuess)
-  : numPrevPts(0)
-  , pt_list()
-  , edges(ptSizeGuess, pt_list)
-{
+  });
+  return buffer.data();
 }
 
-vtkTableBasedClipperDataSetFromVolume::vtkTableBasedClipperDataSetFromVolume(
-  vtkIdType nPts, vtkIdType ptSizeGuess)
-  : numPrevPts(nPts)
-  , pt_list()
-  , edges(ptSizeGuess, pt_list)
+// Output points are numbered in the order of their first use.
+void RecordTableBasedClipperFirstUse(std::atomic<vtkIdType>& firstUse, vtkIdType position)
 {
+  vtkIdType current = firstUse.load(std::memory_order_relaxed);
+  while (position < current &&
+    !firstUse.compare_exchange_weak(current, position, std::memory_order_relaxed))
+  {
+  }
 }
-// ============================================================================
-// ============== vtkTableBasedClipperDataSetFromVolume ( end ) ===============
-// ============================================================================
 
-// ============================================================================
-// =============== vtkTableBasedClipperVolumeFromVolume (begin) ===============
-// ============================================================================
-
-class vtkTableBasedClipperShapeList
+// Builds the output from the clipped chunks. The output is the one the
+// serial VisIt clipper builds: the input points used by the shapes come
+// first, in the order of their first use, then the edge points, in the order
+// they were first met, then the centroid points. The cells are grouped by
+// shape type, in cell order.
+void ConstructTableBasedClipOutput(vtkDataSet* input, std::vector<TableBasedClipperChunk>& chunks,
+  const TableBasedClipperInputPoints& inputPoints, int precision, vtkUnstructuredGrid* output)
 {
-public:
-  vtkTableBasedClipperShapeList(int size);
-  virtual ~vtkTableBasedClipperShapeList();
-  virtual int GetVTKType() const = 0;
-  int GetShapeSize() const { return shapeSize; }
-  int GetTotalNumberOfShapes() const;
-  int GetNumberOfLists() const;
-  int GetList(vtkIdType, const vtkIdType*&) const;
-
-protected:
-  vtkIdType** list;
-  int currentList;
-  int currentShape;
-  int listSize;
-  int shapesPerList;
-  int shapeSize;
-};
+  vtkPointData* inPD = input->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
 
-class vtkTableBasedClipperHexList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperHexList();
-  ~vtkTableBasedClipperHexList() override;
-  int GetVTKType() const override { return VTK_HEXAHEDRON; }
-  void AddHex(vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType,
-    vtkIdType, vtkIdType);
-};
+  const vtkIdType numPrevPts = input->GetNumberOfPoints();
+  const vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  const vtkIdType numSegments = ClipperNumberOfShapeClasses * numChunks;
+
+  // Lay the chunks out. A segment holds the shapes of a class output by a
+  // chunk; the segments of a class are consecutive.
+  std::vector<vtkIdType> edgeOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> centroidOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numSegments + 1, 0);
+  std::vector<vtkIdType> connOffsets(numSegments + 1, 0);
+  for (vtkIdType chunkId = 0; chunkId < numChunks; ++chunkId)
+  {
+    edgeOffsets[chunkId + 1] =
+      edgeOffsets[chunkId] + static_cast<vtkIdType>(chunks[chunkId].EdgePoints.size());
+    centroidOffsets[chunkId + 1] =
+      centroidOffsets[chunkId] + static_cast<vtkIdType>(chunks[chunkId].CentroidPoints.size());
+  }
+  for (vtkIdType segment = 0; segment < numSegments; ++segment)
+  {
+    const int shapeClass = static_cast<int>(segment / numChunks);
+    const vtkIdType shapeSize = TableBasedClipperShapeSizes[shapeClass];
+    const vtkIdType numShapes =
+      static_cast<vtkIdType>(chunks[segment % numChunks].Shapes[shapeClass].size()) /
+      (shapeSize + 1);
+    cellOffsets[segment + 1] = cellOffsets[segment] + numShapes;
+    connOffsets[segment + 1] = connOffsets[segment] + numShapes * shapeSize;
+  }
+  const vtkIdType ncells = cellOffsets[numSegments];
+  const vtkIdType connSize = connOffsets[numSegments];
+
+  // Merge the edge points met by several cells with an edge locator. Each
+  // edge point is numbered after its first occurrence in cell order.
+  const vtkIdType numEdgeRefs = edgeOffsets[numChunks];
+  std::vector<vtkIdType> edgeIds(numEdgeRefs, 0);
+  std::vector<TableBasedClipperEdgePoint> edgePoints;
+  if (numEdgeRefs > 0)
+  {
+    typedef vtkStaticEdgeLocatorTemplate<vtkIdType, double> EdgeLocatorType;
+    typedef EdgeLocatorType::MergeTupleType MergeTupleType;
+    std::vector<MergeTupleType> edges(numEdgeRefs);
+    vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+      for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+      {
+        vtkIdType edgeRef = edgeOffsets[chunkId];
+        for (const TableBasedClipperEdgePoint& pe : chunks[chunkId].EdgePoints)
+        {
+          edges[edgeRef] = MergeTupleType(pe.V0, pe.V1, edgeRef, pe.Percent);
+          ++edgeRef;
+        }
+        chunks[chunkId].EdgePoints = std::vector<TableBasedClipperEdgePoint>();
+      }
+    });
 
-class vtkTableBasedClipperWedgeList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperWedgeList();
-  ~vtkTableBasedClipperWedgeList() override;
-  int GetVTKType() const override { return VTK_WEDGE; }
-  void AddWedge(vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType);
-};
+    EdgeLocatorType locator;
+    vtkIdType numUniqueEdges;
+    const vtkIdType* groups = locator.MergeEdges(numEdgeRefs, edges.data(), numUniqueEdges);
 
-class vtkTableBasedClipperPyramidList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperPyramidList();
-  ~vtkTableBasedClipperPyramidList() override;
-  int GetVTKType() const override { return VTK_PYRAMID; }
-  void AddPyramid(vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType);
-};
+    std::vector<vtkIdType> firstRefs(numUniqueEdges);
+    vtkSMPTools::For(0, numUniqueEdges, [&](vtkIdType beginGroup, vtkIdType endGroup) {
+      for (vtkIdType group = beginGroup; group < endGroup; ++group)
+      {
+        vtkIdType first = groups[group];
+        for (vtkIdType i = groups[group] + 1; i < groups[group + 1]; ++i)
+        {
+          if (edges[i].EId < edges[first].EId)
+          {
+            first = i;
+          }
+        }
+        firstRefs[group] = first;
+        edgeIds[edges[first].EId] = 1;
+      }
+    });
+    vtkSMPTools::ExclusiveScan(edgeIds.begin(), edgeIds.end(), edgeIds.begin(), vtkIdType(0));
 
-class vtkTableBasedClipperTetList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperTetList();
-  ~vtkTableBasedClipperTetList() override;
-  int GetVTKType() const override { return VTK_TETRA; }
-  void AddTet(vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType);
-};
+    edgePoints.resize(numUniqueEdges);
+    vtkSMPTools::For(0, numUniqueEdges, [&](vtkIdType beginGroup, vtkIdType endGroup) {
+      for (vtkIdType group = beginGroup; group < endGroup; ++group)
+      {
+        const MergeTupleType& first = edges[firstRefs[group]];
+        const vtkIdType edgeId = edgeIds[first.EId];
+        edgePoints[edgeId] = TableBasedClipperEdgePoint{ first.V0, first.V1, first.T };
+        for (vtkIdType i = groups[group]; i < groups[group + 1]; ++i)
+        {
+          edgeIds[edges[i].EId] = edgeId;
+        }
+      }
+    });
+  }
 
-class vtkTableBasedClipperQuadList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperQuadList();
-  ~vtkTableBasedClipperQuadList() override;
-  int GetVTKType() const override { return VTK_QUAD; }
-  void AddQuad(vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType);
-};
-
-class vtkTableBasedClipperTriList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperTriList();
-  ~vtkTableBasedClipperTriList() override;
-  int GetVTKType() const override { return VTK_TRIANGLE; }
-  void AddTri(vtkIdType, vtkIdType, vtkIdType, vtkIdType);
-};
-
-class vtkTableBasedClipperLineList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperLineList();
-  ~vtkTableBasedClipperLineList() override;
-  int GetVTKType() const override { return VTK_LINE; }
-  void AddLine(vtkIdType, vtkIdType, vtkIdType);
-};
-
-class vtkTableBasedClipperVertexList : public vtkTableBasedClipperShapeList
-{
-public:
-  vtkTableBasedClipperVertexList();
-  ~vtkTableBasedClipperVertexList() override;
-  int GetVTKType() const override { return VTK_VERTEX; }
-  void AddVertex(vtkIdType, vtkIdType);
-};
-
-struct TableBasedClipperCentroidPointEntry
-{
-  vtkIdType nPts;
-  int ptIds[8];
-};
-
-class vtkTableBasedClipperCentroidPointList
-{
-public:
-  vtkTableBasedClipperCentroidPointList();
-  virtual ~vtkTableBasedClipperCentroidPointList();
-
-  vtkIdType AddPoint(vtkIdType, vtkIdType*);
-
-  vtkIdType GetTotalNumberOfPoints() const;
-  int GetNumberOfLists() const;
-  int GetList(vtkIdType, const TableBasedClipperCentroidPointEntry*&) const;
-
-protected:
-  TableBasedClipperCentroidPointEntry** list;
-  int currentList;
-  int currentPoint;
-  int listSize;
-  int pointsPerList;
-};
-
-struct TableBasedClipperCommonPointsStructure
-{
-  bool hasPtsList;
-  double* pts_ptr;
-  int* dims;
-  double* X;
-  double* Y;
-  double* Z;
-};
+  // If the clip only affects a small part of the dataset, we can save on
+  // memory by only bringing over the input points used by the output.
+  // Number them in the order of their first use in the output connectivity.
+  std::vector<std::atomic<vtkIdType> > firstUse(numPrevPts);
+  vtkSMPTools::For(0, numPrevPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstUse[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  auto visitInputPoints = [&](vtkIdType segment, bool record, vtkIdType* usedIds) {
+    const int shapeClass = static_cast<int>(segment / numChunks);
+    const int shapeSize = TableBasedClipperShapeSizes[shapeClass];
+    const std::vector<vtkIdType>& shapes = chunks[segment % numChunks].Shapes[shapeClass];
+    vtkIdType position = connOffsets[segment];
+    for (size_t i = 0; i < shapes.size(); i += shapeSize + 1)
+    {
+      for (int l = 1; l <= shapeSize; ++l, ++position)
+      {
+        const vtkIdType ptId = shapes[i + l];
+        if (ptId < 0 || ptId >= numPrevPts)
+        {
+          continue;
+        }
+        if (record)
+        {
+          RecordTableBasedClipperFirstUse(firstUse[ptId], position);
+        }
+        else if (firstUse[ptId].load(std::memory_order_relaxed) == position)
+        {
+          usedIds[position] = 1;
+        }
+      }
+    }
+  };
+  vtkSMPTools::For(0, numSegments, 1, [&](vtkIdType beginSegment, vtkIdType endSegment) {
+    for (vtkIdType segment = beginSegment; segment < endSegment; ++segment)
+    {
+      visitInputPoints(segment, true, nullptr);
+    }
+  });
+  // usedIds[position] is the output id of the input point first used at position.
+  std::vector<vtkIdType> usedIds(connSize + 1, 0);
+  vtkSMPTools::For(0, numSegments, 1, [&](vtkIdType beginSegment, vtkIdType endSegment) {
+    for (vtkIdType segment = beginSegment; segment < endSegment; ++segment)
+    {
+      visitInputPoints(segment, false, usedIds.data());
+    }
+  });
+  vtkSMPTools::ExclusiveScan(usedIds.begin(), usedIds.end(), usedIds.begin(), vtkIdType(0));
+  const vtkIdType numUsed = usedIds[connSize];
 
-class vtkTableBasedClipperVolumeFromVolume : public vtkTableBasedClipperDataSetFromVolume
-{
-public:
-  vtkTableBasedClipperVolumeFromVolume(int precision, vtkIdType nPts, vtkIdType ptSizeGuess);
-  ~vtkTableBasedClipperVolumeFromVolume() override = default;
+  const vtkIdType numEdgePts = static_cast<vtkIdType>(edgePoints.size());
+  const vtkIdType centroidStart = numUsed + numEdgePts;
+  const vtkIdType nOutPts = centroidStart + centroidOffsets[numChunks];
 
-  void ConstructDataSet(vtkDataSet*, vtkUnstructuredGrid*, double*);
-  void ConstructDataSet(vtkDataSet*, vtkUnstructuredGrid*, int*, double*, double*, double*);
+  // Output point id of a chunk-local point id.
+  auto getOutputId = [&](vtkIdType chunkId, vtkIdType ptId) -> vtkIdType {
+    if (ptId < 0)
+    {
+      return centroidStart + centroidOffsets[chunkId] - 1 - ptId;
+    }
+    else if (ptId >= numPrevPts)
+    {
+      return numUsed + edgeIds[edgeOffsets[chunkId] + ptId - numPrevPts];
+    }
+    return usedIds[firstUse[ptId].load(std::memory_order_relaxed)];
+  };
 
-  vtkIdType AddCentroidPoint(int n, vtkIdType* p)
-  {
-    return -1 - centroid_list.AddPoint(static_cast<vtkIdType>(n), p);
-  }
+  //
+  // Set up the output points and its point data.
+  //
+  vtkPoints* outPts = vtkPoints::New();
 
-  void AddHex(vtkIdType z, vtkIdType v0, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4,
-    vtkIdType v5, vtkIdType v6, vtkIdType v7)
+  // set precision for the points in the output
+  if (precision == vtkAlgorithm::DEFAULT_PRECISION)
   {
-    this->hexes.AddHex(z, v0, v1, v2, v3, v4, v5, v6, v7);
+    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+    if (inputPointSet)
+    {
+      outPts->SetDataType(inputPointSet->GetPoints()->GetDataType());
+    }
+    else
+    {
+      outPts->SetDataType(VTK_FLOAT);
+    }
   }
-
-  void AddWedge(
-    vtkIdType z, vtkIdType v0, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4, vtkIdType v5)
+  else if (precision == vtkAlgorithm::SINGLE_PRECISION)
   {
-    this->wedges.AddWedge(z, v0, v1, v2, v3, v4, v5);
+    outPts->SetDataType(VTK_FLOAT);
   }
-  void AddPyramid(vtkIdType z, vtkIdType v0, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4)
+  else if (precision == vtkAlgorithm::DOUBLE_PRECISION)
   {
-    this->pyramids.AddPyramid(z, v0, v1, v2, v3, v4);
+    outPts->SetDataType(VTK_DOUBLE);
   }
-  void AddTet(vtkIdType z, vtkIdType v0, vtkIdType v1, vtkIdType v2, vtkIdType v3)
+  outPts->SetNumberOfPoints(nOutPts);
+
+  // Copy over the points from the input that are actually used in the output.
+  vtkNew<vtkIdList> usedPtIds;
+  usedPtIds->SetNumberOfIds(numUsed);
+  vtkIdType* usedPtIdsPtr = usedPtIds->GetPointer(0);
+  vtkSMPTools::For(0, numPrevPts, [&](vtkIdType begin, vtkIdType end) {
+    double pt[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType position = firstUse[ptId].load(std::memory_order_relaxed);
+      if (position != VTK_ID_MAX)
+      {
+        const vtkIdType outId = usedIds[position];
+        inputPoints.GetPoint(ptId, pt);
+        outPts->SetPoint(outId, pt);
+        usedPtIdsPtr[outId] = ptId;
+      }
+    }
+  });
+
+  // Now construct all the points that are along edges.
+  vtkSMPTools::For(0, numEdgePts, [&](vtkIdType begin, vtkIdType end) {
+    double pt[3], pt1[3], pt2[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const TableBasedClipperEdgePoint& pe = edgePoints[i];
+      inputPoints.GetPoint(pe.V0, pt1);
+      inputPoints.GetPoint(pe.V1, pt2);
+      double p = pe.Percent;
+      double bp = 1.0 - p;
+      pt[0] = pt1[0] * p + pt2[0] * bp;
+      pt[1] = pt1[1] * p + pt2[1] * bp;
+      pt[2] = pt1[2] * p + pt2[2] * bp;
+      outPts->SetPoint(numUsed + i, pt);
+    }
+  });
+
+  // Now construct the new "centroid" points. They only depend on points of
+  // their cell, so the centroids of a chunk are computed in order.
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      vtkIdType ptIdx = centroidStart + centroidOffsets[chunkId];
+      for (TableBasedClipperCentroidPoint& ce : chunks[chunkId].CentroidPoints)
+      {
+        double pts[8][3];
+        double pt[3] = { 0.0, 0.0, 0.0 };
+        double weight_factor = 1.0 / ce.NumberOfPoints;
+        for (int k = 0; k < ce.NumberOfPoints; k++)
+        {
+          ce.PointIds[k] = getOutputId(chunkId, ce.PointIds[k]);
+          outPts->GetPoint(ce.PointIds[k], pts[k]);
+          pt[0] += pts[k][0];
+          pt[1] += pts[k][1];
+          pt[2] += pts[k][2];
+        }
+        pt[0] *= weight_factor;
+        pt[1] *= weight_factor;
+        pt[2] *= weight_factor;
+        outPts->SetPoint(ptIdx++, pt);
+      }
+    }
+  });
+
+  // The point data.
+  outPD->CopyAllocate(inPD, nOutPts);
+  vtkNew<vtkIdList> outPtIds;
+  outPtIds->SetNumberOfIds(numUsed);
+  std::iota(outPtIds->GetPointer(0), outPtIds->GetPointer(0) + numUsed, 0);
+  outPD->CopyData(inPD, usedPtIds, outPtIds);
+  for (vtkIdType i = 0; i < numEdgePts; ++i)
   {
-    this->tets.AddTet(z, v0, v1, v2, v3);
+    const TableBasedClipperEdgePoint& pe = edgePoints[i];
+    outPD->InterpolateEdge(inPD, numUsed + i, pe.V0, pe.V1, 1.0 - pe.Percent);
   }
-  void AddQuad(vtkIdType z, vtkIdType v0, vtkIdType v1, vtkIdType v2, vtkIdType v3)
+  vtkNew<vtkIdList> idList;
+  vtkIdType ptIdx = centroidStart;
+  for (const TableBasedClipperChunk& chunk : chunks)
   {
-    this->quads.AddQuad(z, v0, v1, v2, v3);
+    for (const TableBasedClipperCentroidPoint& ce : chunk.CentroidPoints)
+    {
+      double weights[8];
+      idList->SetNumberOfIds(ce.NumberOfPoints);
+      for (int k = 0; k < ce.NumberOfPoints; k++)
+      {
+        weights[k] = 1.0 / ce.NumberOfPoints;
+        idList->SetId(k, ce.PointIds[k]);
+      }
+      outPD->InterpolatePoint(outPD, ptIdx++, idList, weights);
+    }
   }
-  void AddTri(vtkIdType z, vtkIdType v0, vtkIdType v1, vtkIdType v2)
+
+  vtkIntArray* origNodes = vtkArrayDownCast<vtkIntArray>(inPD->GetArray("avtOriginalNodeNumbers"));
+  if (origNodes != nullptr)
   {
-    this->tris.AddTri(z, v0, v1, v2);
+    vtkIntArray* newOrigNodes = vtkIntArray::New();
+    newOrigNodes->SetNumberOfComponents(origNodes->GetNumberOfComponents());
+    newOrigNodes->SetNumberOfTuples(nOutPts);
+    newOrigNodes->SetName(origNodes->GetName());
+    for (vtkIdType i = 0; i < numUsed; ++i)
+    {
+      newOrigNodes->SetTuple(i, usedPtIdsPtr[i], origNodes);
+    }
+    for (vtkIdType i = 0; i < numEdgePts; ++i)
+    {
+      const TableBasedClipperEdgePoint& pe = edgePoints[i];
+      double bp = 1.0 - pe.Percent;
+      newOrigNodes->SetTuple(numUsed + i, (bp <= 0.5 ? pe.V0 : pe.V1), origNodes);
+    }
+    // these 'created' nodes have no original designation
+    for (vtkIdType i = centroidStart; i < nOutPts; ++i)
+    {
+      for (int z = 0; z < newOrigNodes->GetNumberOfComponents(); z++)
+      {
+        newOrigNodes->SetComponent(i, z, -1);
+      }
+    }
+    // AddArray will overwrite an already existing array with
+    // the same name, exactly what we want here.
+    outPD->AddArray(newOrigNodes);
+    newOrigNodes->Delete();
   }
-  void AddLine(vtkIdType z, vtkIdType v0, vtkIdType v1) { this->lines.AddLine(z, v0, v1); }
-  void AddVertex(vtkIdType z, vtkIdType v0) { this->vertices.AddVertex(z, v0); }
-
-protected:
-  vtkTableBasedClipperCentroidPointList centroid_list;
-  vtkTableBasedClipperHexList hexes;
-  vtkTableBasedClipperWedgeList wedges;
-  vtkTableBasedClipperPyramidList pyramids;
-  vtkTableBasedClipperTetList tets;
-  vtkTableBasedClipperQuadList quads;
-  vtkTableBasedClipperTriList tris;
-  vtkTableBasedClipperLineList lines;
-  vtkTableBasedClipperVertexList vertices;
-
-  vtkTableBasedClipperShapeList* shapes[8];
-  const int nshapes;
-  int OutputPointsPrecision;
-
-  void ConstructDataSet(vtkDataSet*, vtkUnstructuredGrid*, TableBasedClipperCommonPointsStructure&);
-};
 
-vtkTableBasedClipperVolumeFromVolume::vtkTableBasedClipperVolumeFromVolume(
-  int precision, vtkIdType nPts, vtkIdType ptSizeGuess)
-  : vtkTableBasedClipperDataSetFromVolume(nPts, ptSizeGuess)
-  , nshapes(8)
-  , OutputPointsPrecision(precision)
-{
-  shapes[0] = &tets;
-  shapes[1] = &pyramids;
-  shapes[2] = &wedges;
-  shapes[3] = &hexes;
-  shapes[4] = &quads;
-  shapes[5] = &tris;
-  shapes[6] = &lines;
-  shapes[7] = &vertices;
-}
+  output->SetPoints(outPts);
+  outPts->Delete();
 
-vtkTableBasedClipperCentroidPointList::vtkTableBasedClipperCentroidPointList()
-{
-  listSize = 4096;
-  pointsPerList = 1024;
+  //
+  // Now set up the shapes and the cell data.
+  //
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(ncells + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[ncells] = connSize;
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  vtkIdType* connPtr = conn->GetPointer(0);
+  vtkNew<vtkUnsignedCharArray> cellTypes;
+  cellTypes->SetNumberOfValues(ncells);
+  unsigned char* ct = cellTypes->GetPointer(0);
+  vtkNew<vtkIdList> inCellIds;
+  inCellIds->SetNumberOfIds(ncells);
+  vtkIdType* inCellIdsPtr = inCellIds->GetPointer(0);
 
-  list = new TableBasedClipperCentroidPointEntry*[listSize];
-  list[0] = new TableBasedClipperCentroidPointEntry[pointsPerList];
-  for (int i = 1; i < listSize; i++)
-  {
-    list[i] = nullptr;
-  }
+  vtkSMPTools::For(0, numSegments, 1, [&](vtkIdType beginSegment, vtkIdType endSegment) {
+    for (vtkIdType segment = beginSegment; segment < endSegment; ++segment)
+    {
+      const int shapeClass = static_cast<int>(segment / numChunks);
+      const vtkIdType chunkId = segment % numChunks;
+      const int shapeSize = TableBasedClipperShapeSizes[shapeClass];
+      const std::vector<vtkIdType>& shapes = chunks[chunkId].Shapes[shapeClass];
+      vtkIdType cellId = cellOffsets[segment];
+      vtkIdType position = connOffsets[segment];
+      for (size_t i = 0; i < shapes.size(); i += shapeSize + 1, ++cellId)
+      {
+        inCellIdsPtr[cellId] = shapes[i];
+        ct[cellId] = TableBasedClipperShapeTypes[shapeClass];
+        offsetsPtr[cellId] = position;
+        for (int l = 1; l <= shapeSize; ++l)
+        {
+          connPtr[position++] = getOutputId(chunkId, shapes[i + l]);
+        }
+      }
+    }
+  });
+
+  outCD->CopyAllocate(inCD, ncells);
+  vtkNew<vtkIdList> outCellIds;
+  outCellIds->SetNumberOfIds(ncells);
+  std::iota(outCellIds->GetPointer(0), outCellIds->GetPointer(0) + ncells, 0);
+  outCD->CopyData(inCD, inCellIds, outCellIds);
 
-  currentList = 0;
-  currentPoint = 0;
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, conn);
+  output->SetCells(cellTypes, cells);
+}
 }
 
-vtkTableBasedClipperCentroidPointList::~vtkTableBasedClipperCentroidPointList()
+// ============================================================================
+// ================= vtkTableBasedClipper cell clipping ( end ) ===============
+// ============================================================================
+
+//------------------------------------------------------------------------------
+// Construct with user-specified implicit function; InsideOut turned off; value
+// set to 0.0; and generate clip scalars turned off.
+vtkTableBasedClipDataSet::vtkTableBasedClipDataSet(vtkImplicitFunction* cf)
 {
-  for (int i = 0; i < listSize; i++)
-  {
-    if (list[i] != nullptr)
-    {
-      delete[] list[i];
-    }
-    else
-    {
-      break;
-    }
-  }
+  this->Locator = nullptr;
+  this->ClipFunction = cf;
+
+  // setup a callback to report progress
+  this->InternalProgressObserver = vtkCallbackCommand::New();
+  this->InternalProgressObserver->SetCallback(
+    &vtkTableBasedClipDataSet::InternalProgressCallbackFunction);
+  this->InternalProgressObserver->SetClientData(this);
+
+  this->Value = 0.0;
+  this->InsideOut = 0;
+  this->MergeTolerance = 0.01;
+  this->UseValueAsOffset = true;
+  this->GenerateClipScalars = 0;
+  this->GenerateClippedOutput = 0;
 
-  delete[] list;
+  this->OutputPointsPrecision = DEFAULT_PRECISION;
+
+  this->SetNumberOfOutputPorts(2);
+  vtkUnstructuredGrid* output2 = vtkUnstructuredGrid::New();
+  this->GetExecutive()->SetOutputData(1, output2);
+  output2->Delete();
+  output2 = nullptr;
+
+  // process active point scalars by default
+  this->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
 }
 
-int vtkTableBasedClipperCentroidPointList::GetList(
-  vtkIdType listId, const TableBasedClipperCentroidPointEntry*& outlist) const
+//------------------------------------------------------------------------------
+vtkTableBasedClipDataSet::~vtkTableBasedClipDataSet()
 {
-  if (listId < 0 || listId > currentList)
+  if (this->Locator)
   {
-    outlist = nullptr;
-    return 0;
+    this->Locator->UnRegister(this);
+    this->Locator = nullptr;
   }
-
-  outlist = list[listId];
-  return (listId == currentList ? currentPoint : pointsPerList);
+  this->SetClipFunction(nullptr);
+  this->InternalProgressObserver->Delete();
+  this->InternalProgressObserver = nullptr;
 }
 
-int vtkTableBasedClipperCentroidPointList::GetNumberOfLists() const
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::InternalProgressCallbackFunction(
+  vtkObject* arg, unsigned long, void* clientdata, void*)
 {
-  return currentList + 1;
+  reinterpret_cast<vtkTableBasedClipDataSet*>(clientdata)
+    ->InternalProgressCallback(static_cast<vtkAlgorithm*>(arg));
 }
 
-vtkIdType vtkTableBasedClipperCentroidPointList::GetTotalNumberOfPoints() const
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::InternalProgressCallback(vtkAlgorithm* algorithm)
 {
-  vtkIdType numFullLists = static_cast<vtkIdType>(currentList); // actually currentList-1+1
-  vtkIdType numExtra = static_cast<vtkIdType>(currentPoint);    // again, currentPoint-1+1
+  double progress = algorithm->GetProgress();
+  this->UpdateProgress(progress);
 
-  return numFullLists * pointsPerList + numExtra;
+  if (this->AbortExecute)
+  {
+    algorithm->SetAbortExecute(1);
+  }
 }
 
-vtkIdType vtkTableBasedClipperCentroidPointList::AddPoint(vtkIdType npts, vtkIdType* pts)
+//------------------------------------------------------------------------------
+vtkMTimeType vtkTableBasedClipDataSet::GetMTime()
 {
-  if (currentPoint >= pointsPerList)
-  {
-    if ((currentList + 1) >= listSize)
-    {
-      TableBasedClipperCentroidPointEntry** tmpList =
-        new TableBasedClipperCentroidPointEntry*[2 * listSize];
-
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
+  vtkMTimeType time;
+  vtkMTimeType mTime = this->Superclass::GetMTime();
 
-    currentList++;
-    list[currentList] = new TableBasedClipperCentroidPointEntry[pointsPerList];
-    currentPoint = 0;
+  if (this->ClipFunction != nullptr)
+  {
+    time = this->ClipFunction->GetMTime();
+    mTime = (time > mTime ? time : mTime);
   }
 
-  list[currentList][currentPoint].nPts = npts;
-  for (int i = 0; i < npts; i++)
+  if (this->Locator != nullptr)
   {
-    list[currentList][currentPoint].ptIds[i] = pts[i];
+    time = this->Locator->GetMTime();
+    mTime = (time > mTime ? time : mTime);
   }
-  currentPoint++;
 
-  return (GetTotalNumberOfPoints() - 1);
+  return mTime;
 }
 
-vtkTableBasedClipperShapeList::vtkTableBasedClipperShapeList(int size)
+vtkUnstructuredGrid* vtkTableBasedClipDataSet::GetClippedOutput()
 {
-  shapeSize = size;
-  listSize = 4096;
-  shapesPerList = 1024;
-
-  list = new vtkIdType*[listSize];
-  list[0] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-
-  for (int i = 1; i < listSize; i++)
+  if (!this->GenerateClippedOutput)
   {
-    list[i] = nullptr;
+    return nullptr;
   }
 
-  currentList = 0;
-  currentShape = 0;
+  return vtkUnstructuredGrid::SafeDownCast(this->GetExecutive()->GetOutputData(1));
 }
 
-vtkTableBasedClipperShapeList::~vtkTableBasedClipperShapeList()
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::SetLocator(vtkIncrementalPointLocator* locator)
 {
-  for (int i = 0; i < listSize; i++)
+  if (this->Locator == locator)
   {
-    if (list[i] != nullptr)
-    {
-      delete[] list[i];
-    }
-    else
-    {
-      break;
-    }
+    return;
   }
 
-  delete[] list;
-}
+  if (this->Locator)
+  {
+    this->Locator->UnRegister(this);
+    this->Locator = nullptr;
+  }
 
-int vtkTableBasedClipperShapeList::GetList(vtkIdType listId, const vtkIdType*& outlist) const
-{
-  if (listId < 0 || listId > currentList)
+  if (locator)
   {
-    outlist = nullptr;
-    return 0;
+    locator->Register(this);
   }
 
-  outlist = list[listId];
-  return (listId == currentList ? currentShape : shapesPerList);
+  this->Locator = locator;
+  this->Modified();
 }
 
-int vtkTableBasedClipperShapeList::GetNumberOfLists() const
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::CreateDefaultLocator()
 {
-  return currentList + 1;
+  if (this->Locator == nullptr)
+  {
+    this->Locator = vtkMergePoints::New();
+    this->Locator->Register(this);
+    this->Locator->Delete();
+  }
 }
 
-int vtkTableBasedClipperShapeList::GetTotalNumberOfShapes() const
+//------------------------------------------------------------------------------
+int vtkTableBasedClipDataSet::FillInputPortInformation(int, vtkInformation* info)
 {
-  int numFullLists = currentList; // actually currentList-1+1
-  int numExtra = currentShape;    // again, currentShape-1+1
-
-  return numFullLists * shapesPerList + numExtra;
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  return 1;
 }
 
-vtkTableBasedClipperHexList::vtkTableBasedClipperHexList()
-  : vtkTableBasedClipperShapeList(8)
-{
-}
-
-vtkTableBasedClipperHexList::~vtkTableBasedClipperHexList() = default;
-
-void vtkTableBasedClipperHexList::AddHex(vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3,
-  vtkIdType v4, vtkIdType v5, vtkIdType v6, vtkIdType v7, vtkIdType v8)
-{
-  if (currentShape >= shapesPerList)
-  {
-    if ((currentList + 1) >= listSize)
-    {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
-
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
-  }
-
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  list[currentList][idx + 2] = v2;
-  list[currentList][idx + 3] = v3;
-  list[currentList][idx + 4] = v4;
-  list[currentList][idx + 5] = v5;
-  list[currentList][idx + 6] = v6;
-  list[currentList][idx + 7] = v7;
-  list[currentList][idx + 8] = v8;
-  currentShape++;
-}
-
-vtkTableBasedClipperWedgeList::vtkTableBasedClipperWedgeList()
-  : vtkTableBasedClipperShapeList(6)
-{
-}
-
-vtkTableBasedClipperWedgeList::~vtkTableBasedClipperWedgeList() = default;
-
-void vtkTableBasedClipperWedgeList::AddWedge(vtkIdType cellId, vtkIdType v1, vtkIdType v2,
-  vtkIdType v3, vtkIdType v4, vtkIdType v5, vtkIdType v6)
-{
-  if (currentShape >= shapesPerList)
-  {
-    if ((currentList + 1) >= listSize)
-    {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
-
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
-  }
-
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  list[currentList][idx + 2] = v2;
-  list[currentList][idx + 3] = v3;
-  list[currentList][idx + 4] = v4;
-  list[currentList][idx + 5] = v5;
-  list[currentList][idx + 6] = v6;
-  currentShape++;
-}
-
-vtkTableBasedClipperPyramidList::vtkTableBasedClipperPyramidList()
-  : vtkTableBasedClipperShapeList(5)
-{
-}
-
-vtkTableBasedClipperPyramidList::~vtkTableBasedClipperPyramidList() = default;
-
-void vtkTableBasedClipperPyramidList::AddPyramid(
-  vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4, vtkIdType v5)
+//------------------------------------------------------------------------------
+int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  if (currentShape >= shapesPerList)
-  {
-    if ((currentList + 1) >= listSize)
-    {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
+  // input and output information objects
+  vtkInformation* inputInf = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfor = outputVector->GetInformationObject(0);
 
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
-  }
+  // Get the input of which we have to create a copy since the clipper requires
+  // that InterpolateAllocate() be invoked for the output based on its input in
+  // terms of the point data. If the input and output arrays are different,
+  // vtkCell3D's Clip will fail. The last argument of InterpolateAllocate makes
+  // sure that arrays are shallow-copied from theInput to cpyInput.
+  vtkDataSet* theInput = vtkDataSet::SafeDownCast(inputInf->Get(vtkDataObject::DATA_OBJECT()));
+  vtkSmartPointer<vtkDataSet> cpyInput;
+  cpyInput.TakeReference(theInput->NewInstance());
+  cpyInput->CopyStructure(theInput);
+  cpyInput->GetCellData()->PassData(theInput->GetCellData());
+  cpyInput->GetFieldData()->PassData(theInput->GetFieldData());
+  cpyInput->GetPointData()->InterpolateAllocate(theInput->GetPointData(), 0, 0, 1);
 
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  list[currentList][idx + 2] = v2;
-  list[currentList][idx + 3] = v3;
-  list[currentList][idx + 4] = v4;
-  list[currentList][idx + 5] = v5;
-  currentShape++;
-}
+  // get the output (the remaining and the clipped parts)
+  vtkUnstructuredGrid* outputUG =
+    vtkUnstructuredGrid::SafeDownCast(outInfor->Get(vtkDataObject::DATA_OBJECT()));
+  vtkUnstructuredGrid* clippedOutputUG = this->GetClippedOutput();
 
-vtkTableBasedClipperTetList::vtkTableBasedClipperTetList()
-  : vtkTableBasedClipperShapeList(4)
-{
-}
+  inputInf = nullptr;
+  outInfor = nullptr;
+  theInput = nullptr;
+  vtkDebugMacro(<< "Clipping dataset" << endl);
 
-vtkTableBasedClipperTetList::~vtkTableBasedClipperTetList() = default;
+  int i;
+  vtkIdType numbPnts = cpyInput->GetNumberOfPoints();
 
-void vtkTableBasedClipperTetList::AddTet(
-  vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4)
-{
-  if (currentShape >= shapesPerList)
+  // handling exceptions
+  if (numbPnts < 1)
   {
-    if ((currentList + 1) >= listSize)
-    {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
-
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
+    vtkDebugMacro(<< "No data to clip" << endl);
+    outputUG = nullptr;
+    return 1;
   }
 
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  list[currentList][idx + 2] = v2;
-  list[currentList][idx + 3] = v3;
-  list[currentList][idx + 4] = v4;
-  currentShape++;
-}
-
-vtkTableBasedClipperQuadList::vtkTableBasedClipperQuadList()
-  : vtkTableBasedClipperShapeList(4)
-{
-}
-
-vtkTableBasedClipperQuadList::~vtkTableBasedClipperQuadList() = default;
-
-void vtkTableBasedClipperQuadList::AddQuad(
-  vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4)
-{
-  if (currentShape >= shapesPerList)
+  if (!this->ClipFunction && this->GenerateClipScalars)
   {
-    if ((currentList + 1) >= listSize)
-    {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
-
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
+    vtkErrorMacro(<< "Cannot generate clip scalars "
+                  << "if no clip function defined" << endl);
+    outputUG = nullptr;
+    return 1;
   }
 
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  list[currentList][idx + 2] = v2;
-  list[currentList][idx + 3] = v3;
-  list[currentList][idx + 4] = v4;
-  currentShape++;
-}
-
-vtkTableBasedClipperTriList::vtkTableBasedClipperTriList()
-  : vtkTableBasedClipperShapeList(3)
-{
-}
-
-vtkTableBasedClipperTriList::~vtkTableBasedClipperTriList() = default;
+  vtkDataArray* clipAray = nullptr;
+  vtkDoubleArray* pScalars = nullptr;
 
-void vtkTableBasedClipperTriList::AddTri(vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3)
-{
-  if (currentShape >= shapesPerList)
+  // check whether the cells are clipped with input scalars or a clip function
+  if (this->ClipFunction)
   {
-    if ((currentList + 1) >= listSize)
-    {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
-    }
-
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
-  }
-
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  list[currentList][idx + 2] = v2;
-  list[currentList][idx + 3] = v3;
-  currentShape++;
-}
-
-vtkTableBasedClipperLineList::vtkTableBasedClipperLineList()
-  : vtkTableBasedClipperShapeList(2)
-{
-}
-
-vtkTableBasedClipperLineList::~vtkTableBasedClipperLineList() = default;
+    pScalars = vtkDoubleArray::New();
+    pScalars->SetNumberOfTuples(numbPnts);
+    pScalars->SetName("ClipDataSetScalars");
 
-void vtkTableBasedClipperLineList::AddLine(vtkIdType cellId, vtkIdType v1, vtkIdType v2)
-{
-  if (currentShape >= shapesPerList)
-  {
-    if ((currentList + 1) >= listSize)
+    // enable clipDataSetScalars to be passed to the output
+    if (this->GenerateClipScalars)
     {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
+      cpyInput->GetPointData()->SetScalars(pScalars);
     }
 
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
-  }
-
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  list[currentList][idx + 2] = v2;
-  currentShape++;
-}
-
-vtkTableBasedClipperVertexList::vtkTableBasedClipperVertexList()
-  : vtkTableBasedClipperShapeList(1)
-{
-}
-
-vtkTableBasedClipperVertexList::~vtkTableBasedClipperVertexList() = default;
-
-void vtkTableBasedClipperVertexList::AddVertex(vtkIdType cellId, vtkIdType v1)
-{
-  if (currentShape >= shapesPerList)
-  {
-    if ((currentList + 1) >= listSize)
+    for (i = 0; i < numbPnts; i++)
     {
-      vtkIdType** tmpList = new vtkIdType*[2 * listSize];
-      for (int i = 0; i < listSize; i++)
-      {
-        tmpList[i] = list[i];
-      }
-
-      for (int i = listSize; i < listSize * 2; i++)
-      {
-        tmpList[i] = nullptr;
-      }
-
-      listSize *= 2;
-      delete[] list;
-      list = tmpList;
+      double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
+      pScalars->SetTuple1(i, s);
     }
 
-    currentList++;
-    list[currentList] = new vtkIdType[(shapeSize + 1) * shapesPerList];
-    currentShape = 0;
-  }
-
-  int idx = (shapeSize + 1) * currentShape;
-  list[currentList][idx + 0] = cellId;
-  list[currentList][idx + 1] = v1;
-  currentShape++;
-}
-
-void vtkTableBasedClipperVolumeFromVolume::ConstructDataSet(
-  vtkDataSet* input, vtkUnstructuredGrid* output, double* pts_ptr)
-{
-  TableBasedClipperCommonPointsStructure cps;
-  cps.hasPtsList = true;
-  cps.pts_ptr = pts_ptr;
-  ConstructDataSet(input, output, cps);
-}
-
-void vtkTableBasedClipperVolumeFromVolume::ConstructDataSet(
-  vtkDataSet* input, vtkUnstructuredGrid* output, int* dims, double* X, double* Y, double* Z)
-{
-  TableBasedClipperCommonPointsStructure cps;
-  cps.hasPtsList = false;
-  cps.dims = dims;
-  cps.X = X;
-  cps.Y = Y;
-  cps.Z = Z;
-  ConstructDataSet(input, output, cps);
-}
-
-void vtkTableBasedClipperVolumeFromVolume::ConstructDataSet(
-  vtkDataSet* input, vtkUnstructuredGrid* output, TableBasedClipperCommonPointsStructure& cps)
-{
-  int i, j, k, l;
-
-  vtkPointData* inPD = input->GetPointData();
-  vtkCellData* inCD = input->GetCellData();
-
-  vtkPointData* outPD = output->GetPointData();
-  vtkCellData* outCD = output->GetCellData();
-
-  vtkIntArray* newOrigNodes = nullptr;
-  vtkIntArray* origNodes = vtkArrayDownCast<vtkIntArray>(inPD->GetArray("avtOriginalNodeNumbers"));
-  //
-  // If the isovolume only affects a small part of the dataset, we can save
-  // on memory by only bringing over the points from the original dataset
-  // that are used with the output.  Determine which points those are here.
-  //
-  int* ptLookup = new int[numPrevPts];
-  for (i = 0; i < numPrevPts; i++)
-  {
-    ptLookup[i] = -1;
+    clipAray = pScalars;
   }
-
-  int numUsed = 0;
-  for (i = 0; i < nshapes; i++)
+  else // using input scalars
   {
-    int nlists = shapes[i]->GetNumberOfLists();
-    int npts_per_shape = shapes[i]->GetShapeSize();
-
-    for (j = 0; j < nlists; j++)
+    clipAray = this->GetInputArrayToProcess(0, inputVector);
+    if (!clipAray)
     {
-      const vtkIdType* list;
-      int listSize = shapes[i]->GetList(j, list);
-
-      for (k = 0; k < listSize; k++)
-      {
-        list++; // skip the cell id entry
-
-        for (l = 0; l < npts_per_shape; l++)
-        {
-          int pt = *list;
-          list++;
-
-          if (pt >= 0 && pt < numPrevPts)
-          {
-            if (ptLookup[pt] == -1)
-            {
-              ptLookup[pt] = numUsed++;
-            }
-          }
-        }
-      }
+      vtkErrorMacro(<< "no input scalars." << endl);
+      return 1;
     }
   }
 
-  //
-  // Set up the output points and its point data.
-  //
-  vtkPoints* outPts = vtkPoints::New();
-
-  // set precision for the points in the output
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  int gridType = cpyInput->GetDataObjectType();
+  double isoValue = (!this->ClipFunction || this->UseValueAsOffset) ? this->Value : 0.0;
+  if (gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS)
   {
-    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
-    if (inputPointSet)
-    {
-      outPts->SetDataType(inputPointSet->GetPoints()->GetDataType());
-    }
-    else
+    this->ClipImageData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
     {
-      outPts->SetDataType(VTK_FLOAT);
-    }
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    outPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    outPts->SetDataType(VTK_DOUBLE);
-  }
-
-  vtkIdType centroidStart = numUsed + pt_list.GetTotalNumberOfPoints();
-  vtkIdType nOutPts = centroidStart + centroid_list.GetTotalNumberOfPoints();
-  outPts->SetNumberOfPoints(nOutPts);
-  outPD->CopyAllocate(inPD, nOutPts);
-
-  if (origNodes != nullptr)
-  {
-    newOrigNodes = vtkIntArray::New();
-    newOrigNodes->SetNumberOfComponents(origNodes->GetNumberOfComponents());
-    newOrigNodes->SetNumberOfTuples(nOutPts);
-    newOrigNodes->SetName(origNodes->GetName());
-  }
-
-  //
-  // Copy over all the points from the input that are actually used in the
-  // output.
-  //
-  for (i = 0; i < numPrevPts; i++)
-  {
-    if (ptLookup[i] == -1)
-    {
-      continue;
-    }
-
-    if (cps.hasPtsList)
-    {
-      outPts->SetPoint(ptLookup[i], cps.pts_ptr + 3 * i);
-    }
-    else
-    {
-      int I = i % cps.dims[0];
-      int J = (i / cps.dims[0]) % cps.dims[1];
-      int K = i / (cps.dims[0] * cps.dims[1]);
-      outPts->SetPoint(ptLookup[i], cps.X[I], cps.Y[J], cps.Z[K]);
-    }
-
-    outPD->CopyData(inPD, i, ptLookup[i]);
-    if (newOrigNodes)
-    {
-      newOrigNodes->SetTuple(ptLookup[i], origNodes->GetTuple(i));
-    }
-  }
-
-  int ptIdx = numUsed;
-
-  //
-  // Now construct all the points that are along edges and new and add
-  // them to the points list.
-  //
-  int nLists = pt_list.GetNumberOfLists();
-  for (i = 0; i < nLists; i++)
-  {
-    const TableBasedClipperPointEntry* pe_list = nullptr;
-    int nPts = pt_list.GetList(i, pe_list);
-    for (j = 0; j < nPts; j++)
-    {
-      const TableBasedClipperPointEntry& pe = pe_list[j];
-      double pt[3];
-      int idx1 = pe.ptIds[0];
-      int idx2 = pe.ptIds[1];
-
-      // Construct the original points -- this will depend on whether
-      // or not we started with a rectilinear grid or a point set.
-      double* pt1 = nullptr;
-      double* pt2 = nullptr;
-      double pt1_storage[3];
-      double pt2_storage[3];
-      if (cps.hasPtsList)
-      {
-        pt1 = cps.pts_ptr + 3 * idx1;
-        pt2 = cps.pts_ptr + 3 * idx2;
-      }
-      else
-      {
-        pt1 = pt1_storage;
-        pt2 = pt2_storage;
-        int I = idx1 % cps.dims[0];
-        int J = (idx1 / cps.dims[0]) % cps.dims[1];
-        int K = idx1 / (cps.dims[0] * cps.dims[1]);
-        pt1[0] = cps.X[I];
-        pt1[1] = cps.Y[J];
-        pt1[2] = cps.Z[K];
-        I = idx2 % cps.dims[0];
-        J = (idx2 / cps.dims[0]) % cps.dims[1];
-        K = idx2 / (cps.dims[0] * cps.dims[1]);
-        pt2[0] = cps.X[I];
-        pt2[1] = cps.Y[J];
-        pt2[2] = cps.Z[K];
-      }
-
-      // Now that we have the original points, calculate the new one.
-      double p = pe.percent;
-      double bp = 1.0 - p;
-      pt[0] = pt1[0] * p + pt2[0] * bp;
-      pt[1] = pt1[1] * p + pt2[1] * bp;
-      pt[2] = pt1[2] * p + pt2[2] * bp;
-      outPts->SetPoint(ptIdx, pt);
-      outPD->InterpolateEdge(inPD, ptIdx, pe.ptIds[0], pe.ptIds[1], bp);
-
-      if (newOrigNodes)
-      {
-        int id = (bp <= 0.5 ? pe.ptIds[0] : pe.ptIds[1]);
-        newOrigNodes->SetTuple(ptIdx, origNodes->GetTuple(id));
-      }
-      ptIdx++;
-    }
-  }
-
-  //
-  // Now construct the new "centroid" points and add them to the points list.
-  //
-  nLists = centroid_list.GetNumberOfLists();
-  vtkIdList* idList = vtkIdList::New();
-  for (i = 0; i < nLists; i++)
-  {
-    const TableBasedClipperCentroidPointEntry* ce_list = nullptr;
-    int nPts = centroid_list.GetList(i, ce_list);
-    for (j = 0; j < nPts; j++)
-    {
-      const TableBasedClipperCentroidPointEntry& ce = ce_list[j];
-      idList->SetNumberOfIds(ce.nPts);
-      double pts[8][3];
-      double weights[8];
-      double pt[3] = { 0.0, 0.0, 0.0 };
-      double weight_factor = 1.0 / ce.nPts;
-      for (k = 0; k < ce.nPts; k++)
-      {
-        weights[k] = 1.0 * weight_factor;
-        vtkIdType id = 0;
-
-        if (ce.ptIds[k] < 0)
-        {
-          id = centroidStart - 1 - ce.ptIds[k];
-        }
-        else if (ce.ptIds[k] >= numPrevPts)
-        {
-          id = numUsed + (ce.ptIds[k] - numPrevPts);
-        }
-        else
-        {
-          id = ptLookup[ce.ptIds[k]];
-        }
-
-        idList->SetId(k, id);
-        outPts->GetPoint(id, pts[k]);
-        pt[0] += pts[k][0];
-        pt[1] += pts[k][1];
-        pt[2] += pts[k][2];
-      }
-      pt[0] *= weight_factor;
-      pt[1] *= weight_factor;
-      pt[2] *= weight_factor;
-
-      outPts->SetPoint(ptIdx, pt);
-      outPD->InterpolatePoint(outPD, ptIdx, idList, weights);
-      if (newOrigNodes)
-      {
-        // these 'created' nodes have no original designation
-        for (int z = 0; z < newOrigNodes->GetNumberOfComponents(); z++)
-        {
-          newOrigNodes->SetComponent(ptIdx, z, -1);
-        }
-      }
-      ptIdx++;
-    }
-  }
-  idList->Delete();
-
-  //
-  // We are finally done constructing the points list.  Set it with our
-  // output and clean up memory.
-  //
-  output->SetPoints(outPts);
-  outPts->Delete();
-
-  if (newOrigNodes)
-  {
-    // AddArray will overwrite an already existing array with
-    // the same name, exactly what we want here.
-    outPD->AddArray(newOrigNodes);
-    newOrigNodes->Delete();
-  }
-
-  //
-  // Now set up the shapes and the cell data.
-  //
-  int cellId = 0;
-  int nlists;
-
-  vtkIdType ncells = 0;
-  vtkIdType conn_size = 0;
-  for (i = 0; i < nshapes; i++)
-  {
-    vtkIdType ns = shapes[i]->GetTotalNumberOfShapes();
-    ncells += ns;
-    conn_size += static_cast<vtkIdType>(shapes[i]->GetShapeSize() + 1) * ns;
-  }
-
-  outCD->CopyAllocate(inCD, ncells);
-
-  vtkIdTypeArray* nlist = vtkIdTypeArray::New();
-  nlist->SetNumberOfValues(conn_size);
-  vtkIdType* nl = nlist->GetPointer(0);
-
-  vtkUnsignedCharArray* cellTypes = vtkUnsignedCharArray::New();
-  cellTypes->SetNumberOfValues(ncells);
-  unsigned char* ct = cellTypes->GetPointer(0);
-
-  vtkIdType ids[1024]; // 8 (for hex) should be max, but...
-  for (i = 0; i < nshapes; i++)
-  {
-    const vtkIdType* list;
-    nlists = shapes[i]->GetNumberOfLists();
-    int shapesize = shapes[i]->GetShapeSize();
-    int vtk_type = shapes[i]->GetVTKType();
-
-    for (j = 0; j < nlists; j++)
-    {
-      int listSize = shapes[i]->GetList(j, list);
-
-      for (k = 0; k < listSize; k++)
-      {
-        outCD->CopyData(inCD, list[0], cellId);
-
-        for (l = 0; l < shapesize; l++)
-        {
-          if (list[l + 1] < 0)
-          {
-            ids[l] = centroidStart - 1 - list[l + 1];
-          }
-          else if (list[l + 1] >= numPrevPts)
-          {
-            ids[l] = numUsed + (list[l + 1] - numPrevPts);
-          }
-          else
-          {
-            ids[l] = ptLookup[list[l + 1]];
-          }
-        }
-        list += shapesize + 1;
-        *nl++ = shapesize;
-        *ct++ = static_cast<unsigned char>(vtk_type);
-        for (l = 0; l < shapesize; l++)
-        {
-          *nl++ = ids[l];
-        }
-
-        cellId++;
-      }
-    }
-  }
-
-  vtkCellArray* cells = vtkCellArray::New();
-  cells->AllocateExact(ncells, nlist->GetNumberOfValues() - ncells);
-  cells->ImportLegacyFormat(nlist);
-  nlist->Delete();
-
-  output->SetCells(cellTypes, cells);
-  cellTypes->Delete();
-  cells->Delete();
-
-  delete[] ptLookup;
-}
-
-inline void GetPoint(
-  double* pt, const double* X, const double* Y, const double* Z, const int* dims, const int& index)
-{
-  int cellI = index % dims[0];
-  int cellJ = (index / dims[0]) % dims[1];
-  int cellK = index / (dims[0] * dims[1]);
-  pt[0] = X[cellI];
-  pt[1] = Y[cellJ];
-  pt[2] = Z[cellK];
-}
-// ============================================================================
-// =============== vtkTableBasedClipperVolumeFromVolume ( end ) ===============
-// ============================================================================
-
-//------------------------------------------------------------------------------
-// Construct with user-specified implicit function; InsideOut turned off; value
-// set to 0.0; and generate clip scalars turned off.
-vtkTableBasedClipDataSet::vtkTableBasedClipDataSet(vtkImplicitFunction* cf)
-{
-  this->Locator = nullptr;
-  this->ClipFunction = cf;
-
-  // setup a callback to report progress
-  this->InternalProgressObserver = vtkCallbackCommand::New();
-  this->InternalProgressObserver->SetCallback(
-    &vtkTableBasedClipDataSet::InternalProgressCallbackFunction);
-  this->InternalProgressObserver->SetClientData(this);
-
-  this->Value = 0.0;
-  this->InsideOut = 0;
-  this->MergeTolerance = 0.01;
-  this->UseValueAsOffset = true;
-  this->GenerateClipScalars = 0;
-  this->GenerateClippedOutput = 0;
-
-  this->OutputPointsPrecision = DEFAULT_PRECISION;
-
-  this->SetNumberOfOutputPorts(2);
-  vtkUnstructuredGrid* output2 = vtkUnstructuredGrid::New();
-  this->GetExecutive()->SetOutputData(1, output2);
-  output2->Delete();
-  output2 = nullptr;
-
-  // process active point scalars by default
-  this->SetInputArrayToProcess(
-    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
-}
-
-//------------------------------------------------------------------------------
-vtkTableBasedClipDataSet::~vtkTableBasedClipDataSet()
-{
-  if (this->Locator)
-  {
-    this->Locator->UnRegister(this);
-    this->Locator = nullptr;
-  }
-  this->SetClipFunction(nullptr);
-  this->InternalProgressObserver->Delete();
-  this->InternalProgressObserver = nullptr;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::InternalProgressCallbackFunction(
-  vtkObject* arg, unsigned long, void* clientdata, void*)
-{
-  reinterpret_cast<vtkTableBasedClipDataSet*>(clientdata)
-    ->InternalProgressCallback(static_cast<vtkAlgorithm*>(arg));
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::InternalProgressCallback(vtkAlgorithm* algorithm)
-{
-  double progress = algorithm->GetProgress();
-  this->UpdateProgress(progress);
-
-  if (this->AbortExecute)
-  {
-    algorithm->SetAbortExecute(1);
-  }
-}
-
-//------------------------------------------------------------------------------
-vtkMTimeType vtkTableBasedClipDataSet::GetMTime()
-{
-  vtkMTimeType time;
-  vtkMTimeType mTime = this->Superclass::GetMTime();
-
-  if (this->ClipFunction != nullptr)
-  {
-    time = this->ClipFunction->GetMTime();
-    mTime = (time > mTime ? time : mTime);
-  }
-
-  if (this->Locator != nullptr)
-  {
-    time = this->Locator->GetMTime();
-    mTime = (time > mTime ? time : mTime);
-  }
-
-  return mTime;
-}
-
-vtkUnstructuredGrid* vtkTableBasedClipDataSet::GetClippedOutput()
-{
-  if (!this->GenerateClippedOutput)
-  {
-    return nullptr;
-  }
-
-  return vtkUnstructuredGrid::SafeDownCast(this->GetExecutive()->GetOutputData(1));
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::SetLocator(vtkIncrementalPointLocator* locator)
-{
-  if (this->Locator == locator)
-  {
-    return;
-  }
-
-  if (this->Locator)
-  {
-    this->Locator->UnRegister(this);
-    this->Locator = nullptr;
-  }
-
-  if (locator)
-  {
-    locator->Register(this);
-  }
-
-  this->Locator = locator;
-  this->Modified();
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::CreateDefaultLocator()
-{
-  if (this->Locator == nullptr)
-  {
-    this->Locator = vtkMergePoints::New();
-    this->Locator->Register(this);
-    this->Locator->Delete();
-  }
-}
-
-//------------------------------------------------------------------------------
-int vtkTableBasedClipDataSet::FillInputPortInformation(int, vtkInformation* info)
-{
-  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
-  return 1;
-}
-
-//------------------------------------------------------------------------------
-int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
-{
-  // input and output information objects
-  vtkInformation* inputInf = inputVector[0]->GetInformationObject(0);
-  vtkInformation* outInfor = outputVector->GetInformationObject(0);
-
-  // Get the input of which we have to create a copy since the clipper requires
-  // that InterpolateAllocate() be invoked for the output based on its input in
-  // terms of the point data. If the input and output arrays are different,
-  // vtkCell3D's Clip will fail. The last argument of InterpolateAllocate makes
-  // sure that arrays are shallow-copied from theInput to cpyInput.
-  vtkDataSet* theInput = vtkDataSet::SafeDownCast(inputInf->Get(vtkDataObject::DATA_OBJECT()));
-  vtkSmartPointer<vtkDataSet> cpyInput;
-  cpyInput.TakeReference(theInput->NewInstance());
-  cpyInput->CopyStructure(theInput);
-  cpyInput->GetCellData()->PassData(theInput->GetCellData());
-  cpyInput->GetFieldData()->PassData(theInput->GetFieldData());
-  cpyInput->GetPointData()->InterpolateAllocate(theInput->GetPointData(), 0, 0, 1);
-
-  // get the output (the remaining and the clipped parts)
-  vtkUnstructuredGrid* outputUG =
-    vtkUnstructuredGrid::SafeDownCast(outInfor->Get(vtkDataObject::DATA_OBJECT()));
-  vtkUnstructuredGrid* clippedOutputUG = this->GetClippedOutput();
-
-  inputInf = nullptr;
-  outInfor = nullptr;
-  theInput = nullptr;
-  vtkDebugMacro(<< "Clipping dataset" << endl);
-
-  int i;
-  vtkIdType numbPnts = cpyInput->GetNumberOfPoints();
-
-  // handling exceptions
-  if (numbPnts < 1)
-  {
-    vtkDebugMacro(<< "No data to clip" << endl);
-    outputUG = nullptr;
-    return 1;
-  }
-
-  if (!this->ClipFunction && this->GenerateClipScalars)
-  {
-    vtkErrorMacro(<< "Cannot generate clip scalars "
-                  << "if no clip function defined" << endl);
-    outputUG = nullptr;
-    return 1;
-  }
-
-  vtkDataArray* clipAray = nullptr;
-  vtkDoubleArray* pScalars = nullptr;
-
-  // check whether the cells are clipped with input scalars or a clip function
-  if (this->ClipFunction)
-  {
-    pScalars = vtkDoubleArray::New();
-    pScalars->SetNumberOfTuples(numbPnts);
-    pScalars->SetName("ClipDataSetScalars");
-
-    // enable clipDataSetScalars to be passed to the output
-    if (this->GenerateClipScalars)
-    {
-      cpyInput->GetPointData()->SetScalars(pScalars);
-    }
-
-    for (i = 0; i < numbPnts; i++)
-    {
-      double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
-      pScalars->SetTuple1(i, s);
-    }
-
-    clipAray = pScalars;
-  }
-  else // using input scalars
-  {
-    clipAray = this->GetInputArrayToProcess(0, inputVector);
-    if (!clipAray)
-    {
-      vtkErrorMacro(<< "no input scalars." << endl);
-      return 1;
-    }
-  }
-
-  int gridType = cpyInput->GetDataObjectType();
-  double isoValue = (!this->ClipFunction || this->UseValueAsOffset) ? this->Value : 0.0;
-  if (gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS)
-  {
-    this->ClipImageData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipImageData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else if (gridType == VTK_POLY_DATA)
-  {
-    this->ClipPolyData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipPolyData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else if (gridType == VTK_RECTILINEAR_GRID)
-  {
-    this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else if (gridType == VTK_STRUCTURED_GRID)
-  {
-    this->ClipStructuredGridData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipStructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else if (gridType == VTK_UNSTRUCTURED_GRID)
-  {
-    this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else
-  {
-    this->ClipDataSet(cpyInput, clipAray, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipDataSet(cpyInput, clipAray, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-
-  outputUG->Squeeze();
-  outputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
-
-  if (clippedOutputUG)
-  {
-    clippedOutputUG->Squeeze();
-    clippedOutputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
-  }
-
-  if (pScalars)
-  {
-    pScalars->Delete();
-  }
-  pScalars = nullptr;
-  outputUG = nullptr;
-  clippedOutputUG = nullptr;
-  clipAray = nullptr;
-
-  return 1;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipDataSet(
-  vtkDataSet* pDataSet, vtkDataArray* clipAray, vtkUnstructuredGrid* unstruct)
-{
-  vtkClipDataSet* clipData = vtkClipDataSet::New();
-  clipData->SetInputData(pDataSet);
-  clipData->SetValue(this->Value);
-  clipData->SetInsideOut(this->InsideOut);
-  clipData->SetClipFunction(this->ClipFunction);
-  clipData->SetUseValueAsOffset(this->UseValueAsOffset);
-  clipData->SetGenerateClipScalars(this->GenerateClipScalars);
-
-  if (!this->ClipFunction)
-  {
-    pDataSet->GetPointData()->SetScalars(clipAray);
-  }
-
-  clipData->Update();
-  unstruct->ShallowCopy(clipData->GetOutput());
-
-  clipData->Delete();
-  clipData = nullptr;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipImageData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
-{
-  int i, j;
-  int dataDims[3];
-  double spacings[3];
-  double tmpValue = 0.0;
-  vtkRectilinearGrid* rectGrid = nullptr;
-  vtkImageData* volImage = vtkImageData::SafeDownCast(inputGrd);
-  volImage->GetDimensions(dataDims);
-  volImage->GetSpacing(spacings);
-  const double* dataBBox = volImage->GetBounds();
-
-  vtkDoubleArray* pxCoords = vtkDoubleArray::New();
-  vtkDoubleArray* pyCoords = vtkDoubleArray::New();
-  vtkDoubleArray* pzCoords = vtkDoubleArray::New();
-  vtkDoubleArray* tmpArays[3] = { pxCoords, pyCoords, pzCoords };
-  for (j = 0; j < 3; j++)
-  {
-    tmpArays[j]->SetNumberOfComponents(1);
-    tmpArays[j]->SetNumberOfTuples(dataDims[j]);
-    for (tmpValue = dataBBox[j << 1], i = 0; i < dataDims[j]; i++, tmpValue += spacings[j])
-    {
-      tmpArays[j]->SetComponent(i, 0, tmpValue);
-    }
-    tmpArays[j] = nullptr;
-  }
-
-  rectGrid = vtkRectilinearGrid::New();
-  rectGrid->SetDimensions(dataDims);
-  rectGrid->SetXCoordinates(pxCoords);
-  rectGrid->SetYCoordinates(pyCoords);
-  rectGrid->SetZCoordinates(pzCoords);
-  rectGrid->GetPointData()->ShallowCopy(volImage->GetPointData());
-  rectGrid->GetCellData()->ShallowCopy(volImage->GetCellData());
-
-  this->ClipRectilinearGridData(rectGrid, clipAray, isoValue, outputUG);
-
-  pxCoords->Delete();
-  pyCoords->Delete();
-  pzCoords->Delete();
-  rectGrid->Delete();
-  pxCoords = nullptr;
-  pyCoords = nullptr;
-  pzCoords = nullptr;
-  rectGrid = nullptr;
-  volImage = nullptr;
-  dataBBox = nullptr;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipPolyData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
-{
-  vtkPolyData* polyData = vtkPolyData::SafeDownCast(inputGrd);
-  vtkIdType numCells = polyData->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume* visItVFV =
-    new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
-      polyData->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
-
-  vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
-  specials->SetPoints(polyData->GetPoints());
-  specials->GetPointData()->ShallowCopy(polyData->GetPointData());
-  specials->Allocate(numCells);
-
-  vtkIdType i, j;
-  vtkIdType numbPnts = 0;
-  int numCants = 0; // number of cells not clipped by this filter
-
-  for (i = 0; i < numCells; i++)
-  {
-    int cellType = polyData->GetCellType(i);
-    bool bCanClip = false;
-    const vtkIdType* pntIndxs = nullptr;
-    polyData->GetCellPoints(i, numbPnts, pntIndxs);
-
-    switch (cellType)
-    {
-      case VTK_TETRA:
-      case VTK_PYRAMID:
-      case VTK_WEDGE:
-      case VTK_HEXAHEDRON:
-      case VTK_TRIANGLE:
-      case VTK_QUAD:
-      case VTK_LINE:
-      case VTK_VERTEX:
-        bCanClip = true;
-        break;
-
-      default:
-        bCanClip = false;
-        break;
-    }
-
-    if (bCanClip)
-    {
-      double grdDiffs[8];
-      int caseIndx = 0;
-
-      for (j = numbPnts - 1; j >= 0; j--)
-      {
-        grdDiffs[j] = clipAray->GetComponent(pntIndxs[j], 0) - isoValue;
-        caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-        caseIndx <<= (1 - (!j));
-      }
-
-      int startIdx = 0;
-      int nOutputs = 0;
-      typedef int EDGEIDXS[2];
-      const EDGEIDXS* edgeVtxs = nullptr;
-      unsigned char* thisCase = nullptr;
-
-      switch (cellType)
-      {
-        case VTK_TETRA:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
-          break;
-
-        case VTK_PYRAMID:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
-          break;
-
-        case VTK_WEDGE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
-          break;
-
-        case VTK_HEXAHEDRON:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
-          break;
-
-        case VTK_TRIANGLE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
-          break;
-
-        case VTK_QUAD:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
-          break;
-
-        case VTK_LINE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
-          break;
-
-        case VTK_VERTEX:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
-          edgeVtxs = nullptr;
-          break;
-      }
-
-      vtkIdType intrpIds[4];
-      for (j = 0; j < nOutputs; j++)
-      {
-        int nCellPts = 0;
-        int intrpIdx = -1;
-        int theColor = -1;
-        unsigned char theShape = *thisCase++;
-
-        switch (theShape)
-        {
-          case ST_HEX:
-            nCellPts = 8;
-            theColor = *thisCase++;
-            break;
-
-          case ST_WDG:
-            nCellPts = 6;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PYR:
-            nCellPts = 5;
-            theColor = *thisCase++;
-            break;
-          case ST_TET:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_QUA:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TRI:
-            nCellPts = 3;
-            theColor = *thisCase++;
-            break;
-
-          case ST_LIN:
-            nCellPts = 2;
-            theColor = *thisCase++;
-            break;
-
-          case ST_VTX:
-            nCellPts = 1;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PNT:
-            intrpIdx = *thisCase++;
-            theColor = *thisCase++;
-            nCellPts = *thisCase++;
-            break;
-
-          default:
-            vtkErrorMacro(<< "An invalid output shape was found in "
-                          << "the ClipCases." << endl);
-        }
-
-        if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
-        {
-          // We don't want this one; it's the wrong side.
-          thisCase += nCellPts;
-          continue;
-        }
-
-        vtkIdType shapeIds[8];
-        for (int p = 0; p < nCellPts; p++)
-        {
-          unsigned char pntIndex = *thisCase++;
-
-          if (pntIndex <= P7)
-          {
-            shapeIds[p] = pntIndxs[pntIndex];
-          }
-          else if (pntIndex >= EA && pntIndex <= EL)
-          {
-            int pt1Index = edgeVtxs[pntIndex - EA][0];
-            int pt2Index = edgeVtxs[pntIndex - EA][1];
-            if (pt2Index < pt1Index)
-            {
-              int temp = pt2Index;
-              pt2Index = pt1Index;
-              pt1Index = temp;
-            }
-            double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-            double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-            double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-            vtkIdType pntIndx1 = pntIndxs[pt1Index];
-            vtkIdType pntIndx2 = pntIndxs[pt2Index];
-
-            shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-          }
-          else if (pntIndex >= N0 && pntIndex <= N3)
-          {
-            shapeIds[p] = static_cast<int>(intrpIds[pntIndex - N0]);
-          }
-          else
-          {
-            vtkErrorMacro(<< "An invalid output point value "
-                          << "was found in the ClipCases." << endl);
-          }
-        }
-
-        switch (theShape)
-        {
-          case ST_HEX:
-            visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-              shapeIds[5], shapeIds[6], shapeIds[7]);
-            break;
-
-          case ST_WDG:
-            visItVFV->AddWedge(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-            break;
-
-          case ST_PYR:
-            visItVFV->AddPyramid(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-            break;
-
-          case ST_TET:
-            visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_QUA:
-            visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_TRI:
-            visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-            break;
-
-          case ST_LIN:
-            visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-            break;
-
-          case ST_VTX:
-            visItVFV->AddVertex(i, shapeIds[0]);
-            break;
-
-          case ST_PNT:
-            intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-            break;
-        }
-      }
-
-      edgeVtxs = nullptr;
-      thisCase = nullptr;
-    }
-    else
-    {
-      if (numCants == 0)
-      {
-        specials->GetCellData()->CopyAllocate(polyData->GetCellData(), numCells);
-      }
-
-      specials->InsertNextCell(cellType, numbPnts, pntIndxs);
-      specials->GetCellData()->CopyData(polyData->GetCellData(), i, numCants);
-      numCants++;
-    }
-
-    pntIndxs = nullptr;
-  }
-
-  int toDelete = 0;
-  double* theCords = nullptr;
-  vtkPoints* inputPts = polyData->GetPoints();
-  if (inputPts->GetDataType() == VTK_DOUBLE)
-  {
-    theCords = static_cast<double*>(inputPts->GetVoidPointer(0));
-  }
-  else
-  {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double[numbPnts * 3];
-    for (i = 0; i < numbPnts; i++)
-    {
-      inputPts->GetPoint(i, theCords + (i << 1) + i);
-    }
-  }
-  inputPts = nullptr;
-
-  if (numCants > 0)
-  {
-    vtkUnstructuredGrid* vtkUGrid = vtkUnstructuredGrid::New();
-    this->ClipDataSet(specials, clipAray, vtkUGrid);
-
-    vtkUnstructuredGrid* visItGrd = vtkUnstructuredGrid::New();
-    visItVFV->ConstructDataSet(polyData, visItGrd, theCords);
-
-    vtkAppendFilter* appender = vtkAppendFilter::New();
-    appender->AddInputData(vtkUGrid);
-    appender->AddInputData(visItGrd);
-    appender->Update();
-
-    outputUG->ShallowCopy(appender->GetOutput());
-
-    appender->Delete();
-    vtkUGrid->Delete();
-    visItGrd->Delete();
-    appender = nullptr;
-    vtkUGrid = nullptr;
-    visItGrd = nullptr;
-  }
-  else
-  {
-    visItVFV->ConstructDataSet(polyData, outputUG, theCords);
-  }
-
-  specials->Delete();
-  delete visItVFV;
-  if (toDelete)
-  {
-    delete[] theCords;
-  }
-  specials = nullptr;
-  visItVFV = nullptr;
-  theCords = nullptr;
-  polyData = nullptr;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipRectilinearGridData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
-{
-  vtkRectilinearGrid* rectGrid = vtkRectilinearGrid::SafeDownCast(inputGrd);
-
-  vtkIdType i, j;
-  vtkIdType numCells = 0;
-  int isTwoDim = 0;
-  enum TwoDimType
-  {
-    XY,
-    YZ,
-    XZ
-  };
-  TwoDimType twoDimType;
-  int rectDims[3];
-  rectGrid->GetDimensions(rectDims);
-  isTwoDim = int(rectDims[0] <= 1 || rectDims[1] <= 1 || rectDims[2] <= 1);
-  if (rectDims[0] <= 1)
-    twoDimType = YZ;
-  else if (rectDims[1] <= 1)
-    twoDimType = XZ;
-  else
-    twoDimType = XY;
-  numCells = rectGrid->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume* visItVFV = new vtkTableBasedClipperVolumeFromVolume(
-    this->OutputPointsPrecision, rectGrid->GetNumberOfPoints(),
-    static_cast<vtkIdType>(pow(double(numCells), double(0.6667f)) * 5 + 100));
-
-  int shiftLUTx[8] = { 0, 1, 1, 0, 0, 1, 1, 0 };
-  int shiftLUTy[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
-  int shiftLUTz[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
-
-  int* shiftLUT[3];
-  if (isTwoDim && twoDimType == XZ)
-  {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTy;
-  }
-  else if (isTwoDim && twoDimType == YZ)
-  {
-    shiftLUT[0] = shiftLUTy;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTx;
-  }
-  else
-  {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTy;
-    shiftLUT[2] = shiftLUTz;
-  }
-
-  int cellDims[3] = { rectDims[0] - 1, rectDims[1] - 1, rectDims[2] - 1 };
-  int cyStride = (cellDims[0] ? cellDims[0] : 1);
-  int czStride = (cellDims[0] ? cellDims[0] : 1) * (cellDims[1] ? cellDims[1] : 1);
-  int pyStride = rectDims[0];
-  int pzStride = rectDims[0] * rectDims[1];
-
-  for (i = 0; i < numCells; i++)
-  {
-    int caseIndx = 0;
-    int nCellPts = isTwoDim ? 4 : 8;
-    vtkIdType theCellI = (cellDims[0] > 0 ? i % cellDims[0] : 0);
-    vtkIdType theCellJ = (cellDims[1] > 0 ? (i / cyStride) % cellDims[1] : 0);
-    vtkIdType theCellK = (cellDims[2] > 0 ? (i / czStride) : 0);
-    double grdDiffs[8];
-
-    for (j = static_cast<vtkIdType>(nCellPts) - 1; j >= 0; j--)
-    {
-      grdDiffs[j] = clipAray->GetComponent((theCellK + shiftLUT[2][j]) * pzStride +
-                        (theCellJ + shiftLUT[1][j]) * pyStride + (theCellI + shiftLUT[0][j]),
-                      0) -
-        isoValue;
-      caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-      caseIndx <<= (1 - (!j));
-    }
-
-    int nOutputs;
-    int intrpIds[4];
-    unsigned char* thisCase = nullptr;
-
-    if (isTwoDim)
-    {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua
-                   [vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-    }
-    else
-    {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex
-                   [vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-    }
-
-    for (j = 0; j < nOutputs; j++)
-    {
-      int intrpIdx = -1;
-      int theColor = -1;
-      unsigned char theShape = *thisCase++;
-
-      nCellPts = 0;
-      switch (theShape)
-      {
-        case ST_HEX:
-          nCellPts = 8;
-          theColor = *thisCase++;
-          break;
-
-        case ST_WDG:
-          nCellPts = 6;
-          theColor = *thisCase++;
-          break;
-
-        case ST_PYR:
-          nCellPts = 5;
-          theColor = *thisCase++;
-          break;
-
-        case ST_TET:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
-
-        case ST_QUA:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
-
-        case ST_TRI:
-          nCellPts = 3;
-          theColor = *thisCase++;
-          break;
-
-        case ST_LIN:
-          nCellPts = 2;
-          theColor = *thisCase++;
-          break;
-
-        case ST_VTX:
-          nCellPts = 1;
-          theColor = *thisCase++;
-          break;
-
-        case ST_PNT:
-          intrpIdx = *thisCase++;
-          theColor = *thisCase++;
-          nCellPts = *thisCase++;
-          break;
-
-        default:
-          vtkErrorMacro(<< "An invalid output shape was found in "
-                        << "the ClipCases." << endl);
-      }
-
-      if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
-      {
-        // We don't want this one; it's the wrong side.
-        thisCase += nCellPts;
-        continue;
-      }
-
-      vtkIdType shapeIds[8];
-      for (int p = 0; p < nCellPts; p++)
-      {
-        unsigned char pntIndex = *thisCase++;
-
-        if (pntIndex <= P7)
-        {
-          // We know pt P0 must be >P0 since we already
-          // assume P0 == 0.  This is why we do not
-          // bother subtracting P0 from pt here.
-          shapeIds[p] =
-            ((theCellI + shiftLUT[0][pntIndex]) + (theCellJ + shiftLUT[1][pntIndex]) * pyStride +
-              (theCellK + shiftLUT[2][pntIndex]) * pzStride);
-        }
-        else if (pntIndex >= EA && pntIndex <= EL)
-        {
-          int pt1Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][0];
-          int pt2Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][1];
-
-          if (pt2Index < pt1Index)
-          {
-            int temp = pt2Index;
-            pt2Index = pt1Index;
-            pt1Index = temp;
-          }
-
-          double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-          double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-          double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-          int pntIndx1 =
-            ((theCellI + shiftLUT[0][pt1Index]) + (theCellJ + shiftLUT[1][pt1Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt1Index]) * pzStride);
-          int pntIndx2 =
-            ((theCellI + shiftLUT[0][pt2Index]) + (theCellJ + shiftLUT[1][pt2Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt2Index]) * pzStride);
-
-          /* We may have physically (though not logically) degenerate cells
-          // if p1Weight == 0 or p1Weight == 1. We could pretty easily and
-          // mostly safely clamp percent to the range [1e-4, 1 - 1e-4].
-          if( p1Weight == 1.0)
-            {
-            shapeIds[p] = pntIndx1;
-            }
-          else
-          if( p1Weight == 0.0 )
-            {
-            shapeIds[p] = pntIndx2;
-            }
-          else
-
-            {
-            shapeIds[p] = visItVFV->AddPoint( pntIndx1, pntIndx2, p1Weight );
-            }
-          */
-
-          // Turning on the above code segment, the alternative, would cause
-          // a bug with a synthetic Wavelet dataset (vtkImageData) when the
-          // the clipping plane (x/y/z axis) is positioned exactly at (0,0,0).
-          // The problem occurs in the form of an open 'box', as opposed to an
-          // expected closed one. This is due to the use of hash instead of a
-          // point-locator based detection of duplicate points.
-          shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-        }
-        else if (pntIndex >= N0 && pntIndex <= N3)
-        {
-          shapeIds[p] = intrpIds[pntIndex - N0];
-        }
-        else
-        {
-          vtkErrorMacro(<< "An invalid output point value "
-                        << "was found in the ClipCases." << endl);
-        }
-      }
-
-      switch (theShape)
-      {
-        case ST_HEX:
-          visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-            shapeIds[5], shapeIds[6], shapeIds[7]);
-          break;
-
-        case ST_WDG:
-          visItVFV->AddWedge(
-            i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-          break;
-
-        case ST_PYR:
-          visItVFV->AddPyramid(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-          break;
-
-        case ST_TET:
-          visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
-
-        case ST_QUA:
-          visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
-
-        case ST_TRI:
-          visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-          break;
-
-        case ST_LIN:
-          visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-          break;
-
-        case ST_VTX:
-          visItVFV->AddVertex(i, shapeIds[0]);
-          break;
-
-        case ST_PNT:
-          intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-          break;
-      }
-    }
-
-    thisCase = nullptr;
-  }
-
-  int toDelete = 0;
-  double* theCords[3] = { nullptr, nullptr, nullptr };
-  vtkDataArray* theArays[3] = { nullptr, nullptr, nullptr };
-
-  if (rectGrid->GetXCoordinates()->GetDataType() == VTK_DOUBLE &&
-    rectGrid->GetYCoordinates()->GetDataType() == VTK_DOUBLE &&
-    rectGrid->GetZCoordinates()->GetDataType() == VTK_DOUBLE)
-  {
-    theCords[0] = static_cast<double*>(rectGrid->GetXCoordinates()->GetVoidPointer(0));
-    theCords[1] = static_cast<double*>(rectGrid->GetYCoordinates()->GetVoidPointer(0));
-    theCords[2] = static_cast<double*>(rectGrid->GetZCoordinates()->GetVoidPointer(0));
-  }
-  else
-  {
-    toDelete = 1;
-    theArays[0] = rectGrid->GetXCoordinates();
-    theArays[1] = rectGrid->GetYCoordinates();
-    theArays[2] = rectGrid->GetZCoordinates();
-    for (j = 0; j < 3; j++)
-    {
-      theCords[j] = new double[rectDims[j]];
-      for (i = 0; i < rectDims[j]; i++)
-      {
-        theCords[j][i] = theArays[j]->GetComponent(i, 0);
-      }
-      theArays[j] = nullptr;
-    }
-  }
-
-  visItVFV->ConstructDataSet(rectGrid, outputUG, rectDims, theCords[0], theCords[1], theCords[2]);
-
-  delete visItVFV;
-  visItVFV = nullptr;
-  rectGrid = nullptr;
-
-  for (i = 0; i < 3; i++)
-  {
-    if (toDelete)
-    {
-      delete[] theCords[i];
-    }
-    theCords[i] = nullptr;
-  }
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipStructuredGridData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
-{
-  vtkStructuredGrid* strcGrid = vtkStructuredGrid::SafeDownCast(inputGrd);
-
-  vtkIdType i, j;
-  int isTwoDim = 0;
-  enum TwoDimType
-  {
-    XY,
-    YZ,
-    XZ
-  };
-  TwoDimType twoDimType;
-  vtkIdType numCells = 0;
-  int gridDims[3] = { 0, 0, 0 };
-  strcGrid->GetDimensions(gridDims);
-  isTwoDim = int(gridDims[0] <= 1 || gridDims[1] <= 1 || gridDims[2] <= 1);
-  if (gridDims[0] <= 1)
-    twoDimType = YZ;
-  else if (gridDims[1] <= 1)
-    twoDimType = XZ;
-  else
-    twoDimType = XY;
-  numCells = strcGrid->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume* visItVFV =
-    new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
-      strcGrid->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
-
-  int shiftLUTx[8] = { 0, 1, 1, 0, 0, 1, 1, 0 };
-  int shiftLUTy[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
-  int shiftLUTz[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
-
-  int* shiftLUT[3];
-  if (isTwoDim && twoDimType == XZ)
-  {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTy;
-  }
-  else if (isTwoDim && twoDimType == YZ)
-  {
-    shiftLUT[0] = shiftLUTy;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTx;
-  }
-  else
-  {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTy;
-    shiftLUT[2] = shiftLUTz;
-  }
-
-  vtkIdType numbPnts = 0;
-  int cellDims[3] = { gridDims[0] - 1, gridDims[1] - 1, gridDims[2] - 1 };
-  int cyStride = (cellDims[0] ? cellDims[0] : 1);
-  int czStride = (cellDims[0] ? cellDims[0] : 1) * (cellDims[1] ? cellDims[1] : 1);
-  int pyStride = gridDims[0];
-  int pzStride = gridDims[0] * gridDims[1];
-
-  for (i = 0; i < numCells; i++)
-  {
-    int caseIndx = 0;
-    int theCellI = (cellDims[0] > 0 ? i % cellDims[0] : 0);
-    int theCellJ = (cellDims[1] > 0 ? (i / cyStride) % cellDims[1] : 0);
-    int theCellK = (cellDims[2] > 0 ? (i / czStride) : 0);
-    double grdDiffs[8];
-
-    numbPnts = isTwoDim ? 4 : 8;
-
-    for (j = numbPnts - 1; j >= 0; j--)
-    {
-      int pntIndex = (theCellI + shiftLUT[0][j]) + (theCellJ + shiftLUT[1][j]) * pyStride +
-        (theCellK + shiftLUT[2][j]) * pzStride;
-
-      grdDiffs[j] = clipAray->GetComponent(pntIndex, 0) - isoValue;
-      caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-      caseIndx <<= (1 - (!j));
-    }
-
-    int nOutputs;
-    vtkIdType intrpIds[4];
-    unsigned char* thisCase = nullptr;
-
-    if (isTwoDim)
-    {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua
-                   [vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-    }
-    else
-    {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex
-                   [vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-    }
-
-    for (j = 0; j < nOutputs; j++)
-    {
-      int nCellPts = 0;
-      int intrpIdx = -1;
-      int theColor = -1;
-      unsigned char theShape = *thisCase++;
-
-      switch (theShape)
-      {
-        case ST_HEX:
-          nCellPts = 8;
-          theColor = *thisCase++;
-          break;
-
-        case ST_WDG:
-          nCellPts = 6;
-          theColor = *thisCase++;
-          break;
-
-        case ST_PYR:
-          nCellPts = 5;
-          theColor = *thisCase++;
-          break;
-
-        case ST_TET:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
-
-        case ST_QUA:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
-
-        case ST_TRI:
-          nCellPts = 3;
-          theColor = *thisCase++;
-          break;
-
-        case ST_LIN:
-          nCellPts = 2;
-          theColor = *thisCase++;
-          break;
-
-        case ST_VTX:
-          nCellPts = 1;
-          theColor = *thisCase++;
-          break;
-
-        case ST_PNT:
-          intrpIdx = *thisCase++;
-          theColor = *thisCase++;
-          nCellPts = *thisCase++;
-          break;
-
-        default:
-          vtkErrorMacro(<< "An invalid output shape was found in "
-                        << "the ClipCases." << endl);
-      }
-
-      if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
-      {
-        // We don't want this one; it's the wrong side.
-        thisCase += nCellPts;
-        continue;
-      }
-
-      vtkIdType shapeIds[8];
-      for (int p = 0; p < nCellPts; p++)
-      {
-        unsigned char pntIndex = *thisCase++;
-
-        if (pntIndex <= P7)
-        {
-          // We know pt P0 must be >P0 since we already
-          // assume P0 == 0.  This is why we do not
-          // bother subtracting P0 from pt here.
-          shapeIds[p] =
-            ((theCellI + shiftLUT[0][pntIndex]) + (theCellJ + shiftLUT[1][pntIndex]) * pyStride +
-              (theCellK + shiftLUT[2][pntIndex]) * pzStride);
-        }
-        else if (pntIndex >= EA && pntIndex <= EL)
-        {
-          int pt1Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][0];
-          int pt2Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][1];
-
-          if (pt2Index < pt1Index)
-          {
-            int temp = pt2Index;
-            pt2Index = pt1Index;
-            pt1Index = temp;
-          }
-
-          double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-          double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-          double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-          int pntIndx1 =
-            ((theCellI + shiftLUT[0][pt1Index]) + (theCellJ + shiftLUT[1][pt1Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt1Index]) * pzStride);
-          int pntIndx2 =
-            ((theCellI + shiftLUT[0][pt2Index]) + (theCellJ + shiftLUT[1][pt2Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt2Index]) * pzStride);
-
-          shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-        }
-        else if (pntIndex >= N0 && pntIndex <= N3)
-        {
-          shapeIds[p] = intrpIds[pntIndex - N0];
-        }
-        else
-        {
-          vtkErrorMacro(<< "An invalid output point value "
-                        << "was found in the ClipCases." << endl);
-        }
-      }
-
-      switch (theShape)
-      {
-        case ST_HEX:
-          visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-            shapeIds[5], shapeIds[6], shapeIds[7]);
-          break;
-
-        case ST_WDG:
-          visItVFV->AddWedge(
-            i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-          break;
-
-        case ST_PYR:
-          visItVFV->AddPyramid(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-          break;
-
-        case ST_TET:
-          visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
-
-        case ST_QUA:
-          visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
-
-        case ST_TRI:
-          visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-          break;
-
-        case ST_LIN:
-          visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-          break;
-
-        case ST_VTX:
-          visItVFV->AddVertex(i, shapeIds[0]);
-          break;
-
-        case ST_PNT:
-          intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-          break;
-      }
+      this->InsideOut = !(this->InsideOut);
+      this->ClipImageData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
     }
-
-    thisCase = nullptr;
   }
-
-  int toDelete = 0;
-  double* theCords = nullptr;
-  vtkPoints* inputPts = strcGrid->GetPoints();
-  if (inputPts->GetDataType() == VTK_DOUBLE)
+  else if (gridType == VTK_POLY_DATA)
+  {
+    this->ClipPolyData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipPolyData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else if (gridType == VTK_RECTILINEAR_GRID)
+  {
+    this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else if (gridType == VTK_STRUCTURED_GRID)
+  {
+    this->ClipStructuredGridData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipStructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else if (gridType == VTK_UNSTRUCTURED_GRID)
   {
-    theCords = static_cast<double*>(inputPts->GetVoidPointer(0));
+    this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
   }
   else
   {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double[numbPnts * 3];
-    for (i = 0; i < numbPnts; i++)
+    this->ClipDataSet(cpyInput, clipAray, outputUG);
+    if (clippedOutputUG)
     {
-      inputPts->GetPoint(i, theCords + (i << 1) + i);
+      this->InsideOut = !(this->InsideOut);
+      this->ClipDataSet(cpyInput, clipAray, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
     }
   }
-  inputPts = nullptr;
 
-  visItVFV->ConstructDataSet(strcGrid, outputUG, theCords);
+  outputUG->Squeeze();
+  outputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
+
+  if (clippedOutputUG)
+  {
+    clippedOutputUG->Squeeze();
+    clippedOutputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
+  }
 
-  delete visItVFV;
-  if (toDelete)
+  if (pScalars)
   {
-    delete[] theCords;
+    pScalars->Delete();
   }
-  visItVFV = nullptr;
-  theCords = nullptr;
-  strcGrid = nullptr;
+  pScalars = nullptr;
+  outputUG = nullptr;
+  clippedOutputUG = nullptr;
+  clipAray = nullptr;
+
+  return 1;
 }
 
 //------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+void vtkTableBasedClipDataSet::ClipDataSet(
+  vtkDataSet* pDataSet, vtkDataArray* clipAray, vtkUnstructuredGrid* unstruct)
 {
-  vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
+  vtkClipDataSet* clipData = vtkClipDataSet::New();
+  clipData->SetInputData(pDataSet);
+  clipData->SetValue(this->Value);
+  clipData->SetInsideOut(this->InsideOut);
+  clipData->SetClipFunction(this->ClipFunction);
+  clipData->SetUseValueAsOffset(this->UseValueAsOffset);
+  clipData->SetGenerateClipScalars(this->GenerateClipScalars);
 
-  vtkIdType i, j;
-  vtkIdType numbPnts = 0;
-  int numCants = 0; // number of cells not clipped by this filter
-  vtkIdType numCells = unstruct->GetNumberOfCells();
+  if (!this->ClipFunction)
+  {
+    pDataSet->GetPointData()->SetScalars(clipAray);
+  }
 
-  // volume from volume
-  vtkTableBasedClipperVolumeFromVolume* visItVFV =
-    new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
-      unstruct->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
+  clipData->Update();
+  unstruct->ShallowCopy(clipData->GetOutput());
 
-  // the stuffs that can not be clipped by this filter
-  vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
-  specials->SetPoints(unstruct->GetPoints());
-  specials->GetPointData()->ShallowCopy(unstruct->GetPointData());
-  specials->Allocate(numCells);
+  clipData->Delete();
+  clipData = nullptr;
+}
 
-  for (i = 0; i < numCells; i++)
-  {
-    int cellType = unstruct->GetCellType(i);
-    const vtkIdType* pntIndxs = nullptr;
-    unstruct->GetCellPoints(i, numbPnts, pntIndxs);
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipImageData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  int i, j;
+  int dataDims[3];
+  double spacings[3];
+  double tmpValue = 0.0;
+  vtkRectilinearGrid* rectGrid = nullptr;
+  vtkImageData* volImage = vtkImageData::SafeDownCast(inputGrd);
+  volImage->GetDimensions(dataDims);
+  volImage->GetSpacing(spacings);
+  const double* dataBBox = volImage->GetBounds();
 
-    bool bCanClip = false;
-    switch (cellType)
+  vtkDoubleArray* pxCoords = vtkDoubleArray::New();
+  vtkDoubleArray* pyCoords = vtkDoubleArray::New();
+  vtkDoubleArray* pzCoords = vtkDoubleArray::New();
+  vtkDoubleArray* tmpArays[3] = { pxCoords, pyCoords, pzCoords };
+  for (j = 0; j < 3; j++)
+  {
+    tmpArays[j]->SetNumberOfComponents(1);
+    tmpArays[j]->SetNumberOfTuples(dataDims[j]);
+    for (tmpValue = dataBBox[j << 1], i = 0; i < dataDims[j]; i++, tmpValue += spacings[j])
     {
-      case VTK_TETRA:
-      case VTK_PYRAMID:
-      case VTK_WEDGE:
-      case VTK_HEXAHEDRON:
-      case VTK_VOXEL:
-      case VTK_TRIANGLE:
-      case VTK_QUAD:
-      case VTK_PIXEL:
-      case VTK_LINE:
-      case VTK_VERTEX:
-        bCanClip = true;
-        break;
-
-      default:
-        bCanClip = false;
-        break;
+      tmpArays[j]->SetComponent(i, 0, tmpValue);
     }
+    tmpArays[j] = nullptr;
+  }
 
-    if (bCanClip)
-    {
-      int caseIndx = 0;
-      double grdDiffs[8];
-
-      for (j = numbPnts - 1; j >= 0; j--)
-      {
-        grdDiffs[j] = clipAray->GetComponent(pntIndxs[j], 0) - isoValue;
-        caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-        caseIndx <<= (1 - (!j));
-      }
-
-      int startIdx = 0;
-      int nOutputs = 0;
-      typedef const int EDGEIDXS[2];
-      EDGEIDXS* edgeVtxs = nullptr;
-      unsigned char* thisCase = nullptr;
-
-      // start index, split case, number of output, and vertices from edges
-      switch (cellType)
-      {
-        case VTK_TETRA:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
-          break;
+  rectGrid = vtkRectilinearGrid::New();
+  rectGrid->SetDimensions(dataDims);
+  rectGrid->SetXCoordinates(pxCoords);
+  rectGrid->SetYCoordinates(pyCoords);
+  rectGrid->SetZCoordinates(pzCoords);
+  rectGrid->GetPointData()->ShallowCopy(volImage->GetPointData());
+  rectGrid->GetCellData()->ShallowCopy(volImage->GetCellData());
 
-        case VTK_PYRAMID:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
-          break;
+  this->ClipRectilinearGridData(rectGrid, clipAray, isoValue, outputUG);
 
-        case VTK_WEDGE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
-          break;
+  pxCoords->Delete();
+  pyCoords->Delete();
+  pzCoords->Delete();
+  rectGrid->Delete();
+  pxCoords = nullptr;
+  pyCoords = nullptr;
+  pzCoords = nullptr;
+  rectGrid = nullptr;
+  volImage = nullptr;
+  dataBBox = nullptr;
+}
 
-        case VTK_HEXAHEDRON:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
-          break;
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipPolyData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(inputGrd);
+  vtkIdType numCells = polyData->GetNumberOfCells();
 
-        case VTK_VOXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
-          break;
+  // The cells are only accessed concurrently if no temporary cell is needed.
+  if (polyData->NeedToBuildCells())
+  {
+    polyData->BuildCells();
+  }
+  bool threaded = polyData->GetVerts()->IsStorageShareable() &&
+    polyData->GetLines()->IsStorageShareable() && polyData->GetPolys()->IsStorageShareable() &&
+    polyData->GetStrips()->IsStorageShareable();
 
-        case VTK_TRIANGLE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
-          break;
+  TableBasedClipperPointSetCells cells(polyData);
+  std::vector<TableBasedClipperChunk> chunks;
+  if (!ClipTableBasedCells(cells, numCells, polyData->GetNumberOfPoints(), clipAray, isoValue,
+        this->InsideOut != 0, threaded, chunks))
+  {
+    vtkErrorMacro(<< "An invalid output shape was found in the ClipCases." << endl);
+  }
 
-        case VTK_QUAD:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
-          break;
+  std::vector<double> pointsBuffer;
+  TableBasedClipperInputPoints inputPoints;
+  inputPoints.Points = GetTableBasedClipperPoints(polyData->GetPoints(), pointsBuffer);
 
-        case VTK_PIXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
-          break;
+  // the stuffs that can not be clipped by this filter
+  vtkNew<vtkIdList> specialIds;
+  vtkIdType numCants = GetTableBasedClipperSpecialCells(chunks, specialIds);
+  if (numCants > 0)
+  {
+    vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
+    specials->SetPoints(polyData->GetPoints());
+    specials->GetPointData()->ShallowCopy(polyData->GetPointData());
+    specials->Allocate(numCants);
+    specials->GetCellData()->CopyAllocate(polyData->GetCellData(), numCants);
+    vtkIdType numbPnts;
+    const vtkIdType* pntIndxs;
+    for (vtkIdType i = 0; i < numCants; i++)
+    {
+      vtkIdType cellId = specialIds->GetId(i);
+      polyData->GetCellPoints(cellId, numbPnts, pntIndxs);
+      specials->InsertNextCell(polyData->GetCellType(cellId), numbPnts, pntIndxs);
+      specials->GetCellData()->CopyData(polyData->GetCellData(), cellId, i);
+    }
 
-        case VTK_LINE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
-          break;
+    vtkUnstructuredGrid* vtkUGrid = vtkUnstructuredGrid::New();
+    this->ClipDataSet(specials, clipAray, vtkUGrid);
 
-        case VTK_VERTEX:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
-          edgeVtxs = nullptr;
-          break;
-      }
+    vtkUnstructuredGrid* visItGrd = vtkUnstructuredGrid::New();
+    ConstructTableBasedClipOutput(
+      polyData, chunks, inputPoints, this->OutputPointsPrecision, visItGrd);
 
-      int intrpIds[4];
-      for (j = 0; j < nOutputs; j++)
-      {
-        int nCellPts = 0;
-        int theColor = -1;
-        int intrpIdx = -1;
-        unsigned char theShape = *thisCase++;
+    vtkAppendFilter* appender = vtkAppendFilter::New();
+    appender->AddInputData(vtkUGrid);
+    appender->AddInputData(visItGrd);
+    appender->Update();
 
-        // number of points and color
-        switch (theShape)
-        {
-          case ST_HEX:
-            nCellPts = 8;
-            theColor = *thisCase++;
-            break;
-
-          case ST_WDG:
-            nCellPts = 6;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PYR:
-            nCellPts = 5;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TET:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_QUA:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TRI:
-            nCellPts = 3;
-            theColor = *thisCase++;
-            break;
-
-          case ST_LIN:
-            nCellPts = 2;
-            theColor = *thisCase++;
-            break;
-
-          case ST_VTX:
-            nCellPts = 1;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PNT:
-            intrpIdx = *thisCase++;
-            theColor = *thisCase++;
-            nCellPts = *thisCase++;
-            break;
-
-          default:
-            vtkErrorMacro(<< "An invalid output shape was found "
-                          << "in the ClipCases." << endl);
-        }
+    outputUG->ShallowCopy(appender->GetOutput());
 
-        if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
-        {
-          // We don't want this one; it's the wrong side.
-          thisCase += nCellPts;
-          continue;
-        }
+    appender->Delete();
+    vtkUGrid->Delete();
+    visItGrd->Delete();
+    specials->Delete();
+  }
+  else
+  {
+    ConstructTableBasedClipOutput(
+      polyData, chunks, inputPoints, this->OutputPointsPrecision, outputUG);
+  }
+}
 
-        vtkIdType shapeIds[8];
-        for (int p = 0; p < nCellPts; p++)
-        {
-          unsigned char pntIndex = *thisCase++;
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipRectilinearGridData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkRectilinearGrid* rectGrid = vtkRectilinearGrid::SafeDownCast(inputGrd);
 
-          if (pntIndex <= P7)
-          {
-            // We know pt P0 must be >P0 since we already
-            // assume P0 == 0.  This is why we do not
-            // bother subtracting P0 from pt here.
-            shapeIds[p] = pntIndxs[pntIndex];
-          }
-          else if (pntIndex >= EA && pntIndex <= EL)
-          {
-            int pt1Index = edgeVtxs[pntIndex - EA][0];
-            int pt2Index = edgeVtxs[pntIndex - EA][1];
-            if (pt2Index < pt1Index)
-            {
-              int temp = pt2Index;
-              pt2Index = pt1Index;
-              pt1Index = temp;
-            }
-            double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-            double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-            double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-            vtkIdType pntIndx1 = pntIndxs[pt1Index];
-            vtkIdType pntIndx2 = pntIndxs[pt2Index];
-
-            shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-          }
-          else if (pntIndex >= N0 && pntIndex <= N3)
-          {
-            shapeIds[p] = intrpIds[pntIndex - N0];
-          }
-          else
-          {
-            vtkErrorMacro(<< "An invalid output point value was found "
-                          << "in the ClipCases." << endl);
-          }
-        }
+  int rectDims[3];
+  rectGrid->GetDimensions(rectDims);
 
-        switch (theShape)
-        {
-          case ST_HEX:
-            visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-              shapeIds[5], shapeIds[6], shapeIds[7]);
-            break;
-
-          case ST_WDG:
-            visItVFV->AddWedge(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-            break;
-
-          case ST_PYR:
-            visItVFV->AddPyramid(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-            break;
-
-          case ST_TET:
-            visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_QUA:
-            visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_TRI:
-            visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-            break;
-
-          case ST_LIN:
-            visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-            break;
-
-          case ST_VTX:
-            visItVFV->AddVertex(i, shapeIds[0]);
-            break;
-
-          case ST_PNT:
-            intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-            break;
-        }
-      }
+  TableBasedClipperStructuredCells cells(rectDims);
+  std::vector<TableBasedClipperChunk> chunks;
+  if (!ClipTableBasedCells(cells, rectGrid->GetNumberOfCells(), rectGrid->GetNumberOfPoints(),
+        clipAray, isoValue, this->InsideOut != 0, true, chunks))
+  {
+    vtkErrorMacro(<< "An invalid output shape was found in the ClipCases." << endl);
+  }
 
-      edgeVtxs = nullptr;
-      thisCase = nullptr;
-    }
-    else if (cellType == VTK_POLYHEDRON)
+  std::vector<double> coordsBuffers[3];
+  vtkDataArray* theArays[3] = { rectGrid->GetXCoordinates(), rectGrid->GetYCoordinates(),
+    rectGrid->GetZCoordinates() };
+  const double* theCords[3];
+  for (int j = 0; j < 3; j++)
+  {
+    if (theArays[j]->GetDataType() == VTK_DOUBLE)
     {
-      if (numCants == 0)
-      {
-        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
-      }
-      vtkIdType nfaces;
-      const vtkIdType* facePtIds;
-      unstruct->GetFaceStream(i, nfaces, facePtIds);
-      specials->InsertNextCell(cellType, nfaces, facePtIds);
-      specials->GetCellData()->CopyData(unstruct->GetCellData(), i, numCants);
-      numCants++;
+      theCords[j] = static_cast<double*>(theArays[j]->GetVoidPointer(0));
     }
     else
     {
-      if (numCants == 0)
+      coordsBuffers[j].resize(rectDims[j]);
+      for (int i = 0; i < rectDims[j]; i++)
       {
-        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
+        coordsBuffers[j][i] = theArays[j]->GetComponent(i, 0);
       }
-      specials->InsertNextCell(cellType, numbPnts, pntIndxs);
-      specials->GetCellData()->CopyData(unstruct->GetCellData(), i, numCants);
-      numCants++;
+      theCords[j] = coordsBuffers[j].data();
     }
-
-    pntIndxs = nullptr;
   }
 
-  int toDelete = 0;
-  double* theCords = nullptr;
-  vtkPoints* inputPts = unstruct->GetPoints();
-  if (inputPts->GetDataType() == VTK_DOUBLE)
+  TableBasedClipperInputPoints inputPoints;
+  inputPoints.Dims = rectDims;
+  inputPoints.X = theCords[0];
+  inputPoints.Y = theCords[1];
+  inputPoints.Z = theCords[2];
+  ConstructTableBasedClipOutput(
+    rectGrid, chunks, inputPoints, this->OutputPointsPrecision, outputUG);
+}
+
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipStructuredGridData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkStructuredGrid* strcGrid = vtkStructuredGrid::SafeDownCast(inputGrd);
+
+  int gridDims[3] = { 0, 0, 0 };
+  strcGrid->GetDimensions(gridDims);
+
+  TableBasedClipperStructuredCells cells(gridDims);
+  std::vector<TableBasedClipperChunk> chunks;
+  if (!ClipTableBasedCells(cells, strcGrid->GetNumberOfCells(), strcGrid->GetNumberOfPoints(),
+        clipAray, isoValue, this->InsideOut != 0, true, chunks))
   {
-    theCords = static_cast<double*>(inputPts->GetVoidPointer(0));
+    vtkErrorMacro(<< "An invalid output shape was found in the ClipCases." << endl);
   }
-  else
+
+  std::vector<double> pointsBuffer;
+  TableBasedClipperInputPoints inputPoints;
+  inputPoints.Points = GetTableBasedClipperPoints(strcGrid->GetPoints(), pointsBuffer);
+  ConstructTableBasedClipOutput(
+    strcGrid, chunks, inputPoints, this->OutputPointsPrecision, outputUG);
+}
+
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
+  vtkIdType numCells = unstruct->GetNumberOfCells();
+
+  TableBasedClipperPointSetCells cells(unstruct);
+  std::vector<TableBasedClipperChunk> chunks;
+  if (!ClipTableBasedCells(cells, numCells, unstruct->GetNumberOfPoints(), clipAray, isoValue,
+        this->InsideOut != 0, true, chunks))
   {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double[numbPnts * 3];
-    for (i = 0; i < numbPnts; i++)
-    {
-      inputPts->GetPoint(i, theCords + (i << 1) + i);
-    }
+    vtkErrorMacro(<< "An invalid output shape was found in the ClipCases." << endl);
   }
-  inputPts = nullptr;
 
-  // the stuff that can not be clipped
+  std::vector<double> pointsBuffer;
+  TableBasedClipperInputPoints inputPoints;
+  inputPoints.Points = GetTableBasedClipperPoints(unstruct->GetPoints(), pointsBuffer);
+
+  // the stuffs that can not be clipped by this filter
+  vtkNew<vtkIdList> specialIds;
+  vtkIdType numCants = GetTableBasedClipperSpecialCells(chunks, specialIds);
   if (numCants > 0)
   {
+    vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
+    specials->SetPoints(unstruct->GetPoints());
+    specials->GetPointData()->ShallowCopy(unstruct->GetPointData());
+    specials->Allocate(numCants);
+    specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCants);
+    vtkIdType numbPnts;
+    const vtkIdType* pntIndxs;
+    for (vtkIdType i = 0; i < numCants; i++)
+    {
+      vtkIdType cellId = specialIds->GetId(i);
+      int cellType = unstruct->GetCellType(cellId);
+      if (cellType == VTK_POLYHEDRON)
+      {
+        unstruct->GetFaceStream(cellId, numbPnts, pntIndxs);
+      }
+      else
+      {
+        unstruct->GetCellPoints(cellId, numbPnts, pntIndxs);
+      }
+      specials->InsertNextCell(cellType, numbPnts, pntIndxs);
+      specials->GetCellData()->CopyData(unstruct->GetCellData(), cellId, i);
+    }
+
     vtkUnstructuredGrid* vtkUGrid = vtkUnstructuredGrid::New();
     this->ClipDataSet(specials, clipAray, vtkUGrid);
 
     vtkUnstructuredGrid* visItGrd = vtkUnstructuredGrid::New();
-    visItVFV->ConstructDataSet(unstruct, visItGrd, theCords);
+    ConstructTableBasedClipOutput(
+      unstruct, chunks, inputPoints, this->OutputPointsPrecision, visItGrd);
 
     vtkAppendFilter* appender = vtkAppendFilter::New();
     appender->AddInputData(vtkUGrid);
@@ -3259,25 +1603,13 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
     appender->Delete();
     visItGrd->Delete();
     vtkUGrid->Delete();
-    appender = nullptr;
-    vtkUGrid = nullptr;
-    visItGrd = nullptr;
+    specials->Delete();
   }
   else
   {
-    visItVFV->ConstructDataSet(unstruct, outputUG, theCords);
-  }
-
-  specials->Delete();
-  delete visItVFV;
-  if (toDelete)
-  {
-    delete[] theCords;
+    ConstructTableBasedClipOutput(
+      unstruct, chunks, inputPoints, this->OutputPointsPrecision, outputUG);
   }
-  specials = nullptr;
-  visItVFV = nullptr;
-  theCords = nullptr;
-  unstruct = nullptr;
 }
 
 //------------------------------------------------------------------------------
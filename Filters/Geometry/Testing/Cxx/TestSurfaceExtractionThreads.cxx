@@ -0,0 +1,298 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSurfaceExtractionThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the threaded extraction of the surface of unstructured grids by
+// vtkDataSetSurfaceFilter and vtkGeometryFilter gives the same output as
+// their serial code, whatever the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkGeometryFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+// Hexahedra, wedges, pyramids and tetrahedra filling a block, with some
+// quads, strips, lines and vertices in between, and a few hidden points.
+// With addPolyhedron, a polyhedron is added at the end, away from the other
+// cells and with its own points, which makes vtkDataSetSurfaceFilter use its
+// serial code.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int n, bool addPolyhedron)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        points->InsertNextPoint(0.3 * i, 0.3 * j + 0.01 * i, 0.3 * k);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  auto id = [n](int i, int j, int k) { return static_cast<vtkIdType>((k * n + j) * n + i); };
+  for (int k = 0; k + 1 < n; ++k)
+  {
+    for (int j = 0; j + 1 < n; ++j)
+    {
+      for (int i = 0; i + 1 < n; ++i)
+      {
+        const vtkIdType p[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        switch ((i + j + k) % 4)
+        {
+          case 0:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+            break;
+          case 1:
+          {
+            const vtkIdType wedges[2][6] = { { p[0], p[1], p[3], p[4], p[5], p[7] },
+              { p[1], p[2], p[3], p[5], p[6], p[7] } };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedges[0]);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedges[1]);
+            break;
+          }
+          case 2:
+          {
+            // Leave a hole in the block sometimes.
+            if ((i * j + k) % 13 != 0)
+            {
+              const vtkIdType pyramid[5] = { p[0], p[1], p[2], p[3], p[4] };
+              grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+            }
+            break;
+          }
+          default:
+          {
+            const vtkIdType tets[5][4] = { { p[0], p[1], p[3], p[4] }, { p[1], p[2], p[3], p[6] },
+              { p[1], p[4], p[5], p[6] }, { p[3], p[4], p[6], p[7] }, { p[1], p[3], p[4], p[6] } };
+            for (const vtkIdType* tet : tets)
+            {
+              grid->InsertNextCell(VTK_TETRA, 4, tet);
+            }
+          }
+        }
+        if ((i + 2 * j) % 7 == 0)
+        {
+          grid->InsertNextCell(VTK_QUAD, 4, p);
+        }
+        if ((2 * i + j + k) % 9 == 0)
+        {
+          const vtkIdType strip[5] = { p[0], p[4], p[1], p[5], p[2] };
+          grid->InsertNextCell(VTK_TRIANGLE_STRIP, 5, strip);
+        }
+        if ((i + j + 2 * k) % 11 == 0)
+        {
+          grid->InsertNextCell(VTK_LINE, 2, p + 5);
+          grid->InsertNextCell(VTK_VERTEX, 1, p + 2);
+        }
+      }
+    }
+  }
+
+  if (addPolyhedron)
+  {
+    const vtkIdType p = points->InsertNextPoint(100.0, 0.0, 0.0);
+    points->InsertNextPoint(101.0, 0.0, 0.0);
+    points->InsertNextPoint(100.0, 1.0, 0.0);
+    points->InsertNextPoint(100.0, 0.0, 1.0);
+    const vtkIdType pts[4] = { p, p + 1, p + 2, p + 3 };
+    const vtkIdType faces[16] = { 3, p, p + 2, p + 1, 3, p, p + 1, p + 3, 3, p, p + 3, p + 2, 3,
+      p + 1, p + 2, p + 3 };
+    grid->InsertNextCell(VTK_POLYHEDRON, 4, pts, 4, faces);
+  }
+  grid->SetPoints(points);
+
+  vtkNew<vtkDoubleArray> height;
+  height->SetName("Height");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    height->InsertNextValue(points->GetPoint(i)[2]);
+    ghosts->InsertNextValue(i % 97 == 5 ? vtkDataSetAttributes::HIDDENPOINT : 0);
+  }
+  grid->GetPointData()->AddArray(height);
+  grid->GetPointData()->AddArray(ghosts);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+bool SameCells(vtkCellArray* cells, vtkCellArray* expected, bool prefix, const char* name)
+{
+  vtkNew<vtkIdTypeArray> connectivity, expectedConnectivity;
+  cells->ExportLegacyFormat(connectivity);
+  expected->ExportLegacyFormat(expectedConnectivity);
+  const vtkIdType size = connectivity->GetNumberOfValues();
+  const vtkIdType expectedSize = expectedConnectivity->GetNumberOfValues();
+  if (prefix ? size > expectedSize : size != expectedSize)
+  {
+    std::cerr << "Wrong number of " << name << ": " << cells->GetNumberOfCells() << " instead of "
+              << expected->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (connectivity->GetValue(i) != expectedConnectivity->GetValue(i))
+    {
+      std::cerr << "The " << name << " differ" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameArrays(vtkFieldData* data, vtkFieldData* expected, bool prefix, const char* name)
+{
+  if (data->GetNumberOfArrays() != expected->GetNumberOfArrays())
+  {
+    std::cerr << "Wrong number of " << name << " arrays" << std::endl;
+    return false;
+  }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* array = data->GetArray(a);
+    vtkDataArray* expectedArray = expected->GetArray(expected->GetArrayName(a));
+    const vtkIdType size = array->GetNumberOfTuples();
+    const vtkIdType expectedSize = expectedArray ? expectedArray->GetNumberOfTuples() : -1;
+    if (!expectedArray || array->GetDataType() != expectedArray->GetDataType() ||
+      (prefix ? size > expectedSize : size != expectedSize))
+    {
+      std::cerr << "Wrong " << name << " array " << array->GetName() << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < size; ++i)
+    {
+      if (array->GetTuple1(i) != expectedArray->GetTuple1(i))
+      {
+        std::cerr << "The " << name << " array " << array->GetName() << " differs at " << i
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Compare the outputs. With prefix, expected may have more points and
+// polygons after the ones of output.
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected, bool prefix)
+{
+  const vtkIdType numPts = output->GetNumberOfPoints();
+  const vtkIdType expectedNumPts = expected->GetNumberOfPoints();
+  if (numPts == 0 || (prefix ? numPts > expectedNumPts : numPts != expectedNumPts))
+  {
+    std::cerr << "Wrong number of points: " << numPts << " instead of " << expectedNumPts
+              << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    const double* x = output->GetPoint(i);
+    const double* y = expected->GetPoint(i);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  return SameCells(output->GetVerts(), expected->GetVerts(), false, "verts") &&
+    SameCells(output->GetLines(), expected->GetLines(), false, "lines") &&
+    SameCells(output->GetPolys(), expected->GetPolys(), prefix, "polys") &&
+    SameCells(output->GetStrips(), expected->GetStrips(), false, "strips") &&
+    SameArrays(output->GetPointData(), expected->GetPointData(), prefix, "point data") &&
+    SameArrays(output->GetCellData(), expected->GetCellData(), prefix, "cell data");
+}
+
+vtkSmartPointer<vtkPolyData> ExtractSurface(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(grid);
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  surface->Update();
+  return surface->GetOutput();
+}
+
+vtkSmartPointer<vtkPolyData> ExtractGeometry(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkGeometryFilter> geometry;
+  geometry->SetInputData(grid);
+  geometry->MergingOff();
+  geometry->Update();
+  return geometry->GetOutput();
+}
+}
+
+int TestSurfaceExtractionThreads(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(18, false);
+
+  // The polyhedron is the last cell and uses the last points, so its faces
+  // and points are output after all the others.
+  vtkSmartPointer<vtkUnstructuredGrid> serialSurfaceGrid = MakeGrid(18, true);
+  vtkSmartPointer<vtkPolyData> expectedSurface = ExtractSurface(serialSurfaceGrid);
+
+  // Connectivity that cannot be shared between threads makes
+  // vtkGeometryFilter use its serial code.
+  vtkSmartPointer<vtkUnstructuredGrid> serialGeometryGrid = MakeGrid(18, false);
+  if (!serialGeometryGrid->GetCells()->ConvertTo32BitStorage() ||
+    serialGeometryGrid->GetCells()->IsStorageShareable())
+  {
+    std::cerr << "Failed to convert the connectivity to 32 bit storage" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkPolyData> expectedGeometry = ExtractGeometry(serialGeometryGrid);
+
+  const int numThreads[3] = { 1, 2, 4 };
+  for (int n : numThreads)
+  {
+    vtkSMPTools::Initialize(n);
+    if (!SameOutput(ExtractSurface(grid), expectedSurface, true))
+    {
+      std::cerr << "vtkDataSetSurfaceFilter differs from its serial output with " << n
+                << " threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!SameOutput(ExtractGeometry(grid), expectedGeometry, false))
+    {
+      std::cerr << "vtkGeometryFilter differs from its serial output with " << n << " threads"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
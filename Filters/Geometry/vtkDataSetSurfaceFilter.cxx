@@ -22,6 +22,7 @@
 #include "vtkBezierTriangle.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
 #include "vtkCellTypes.h"
@@ -41,6 +42,8 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -57,8 +60,12 @@
 #include "vtkVoxel.h"
 #include "vtkWedge.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <numeric>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 static inline int sizeofFastQuad(int numPts)
 {
@@ -937,6 +944,40 @@ void vtkDataSetSurfaceFilter::ExecuteFaceQuads(vtkDataSet* input, vtkPolyData* o
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Fills the offsets and connectivity of the quads of a structured face.
+struct GenerateFaceQuadsImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType outStartCellId, vtkIdType outStartConnId,
+    vtkIdType outStartPtId, vtkIdType numQuadsB, vtkIdType numQuadsC, vtkIdType cOutInc)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    ValueType* offsets = state.GetOffsets()->GetPointer(outStartCellId);
+    ValueType* conn = state.GetConnectivity()->GetPointer(outStartConnId);
+
+    vtkSMPTools::For(0, numQuadsC, [&](vtkIdType beginC, vtkIdType endC) {
+      for (vtkIdType c = beginC; c < endC; ++c)
+      {
+        for (vtkIdType b = 0; b < numQuadsB; ++b)
+        {
+          const vtkIdType idx = c * numQuadsB + b;
+          const vtkIdType outPtId = outStartPtId + b + c * cOutInc;
+          ValueType* quad = conn + 4 * idx;
+          quad[0] = static_cast<ValueType>(outPtId);
+          quad[1] = static_cast<ValueType>(outPtId + cOutInc);
+          quad[2] = static_cast<ValueType>(outPtId + cOutInc + 1);
+          quad[3] = static_cast<ValueType>(outPtId + 1);
+          offsets[idx + 1] = static_cast<ValueType>(outStartConnId + 4 * (idx + 1));
+        }
+      }
+    });
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::ExecuteFaceQuads(vtkDataSet* input, vtkPolyData* output, int maxFlag,
   vtkIdType* ext, int aAxis, int bAxis, int cAxis, vtkIdType* wholeExt)
@@ -948,13 +989,9 @@ void vtkDataSetSurfaceFilter::ExecuteFaceQuads(vtkDataSet* input, vtkPolyData* o
   vtkIdType pInc[3];
   vtkIdType qInc[3];
   vtkIdType cOutInc;
-  double pt[3];
   vtkIdType inStartPtId;
   vtkIdType inStartCellId;
   vtkIdType outStartPtId;
-  vtkIdType outPtId;
-  vtkIdType inId, outId;
-  vtkIdType ib, ic;
   int aA2, bA2, cA2;
 
   outPts = output->GetPoints();
@@ -1018,43 +1055,73 @@ void vtkDataSetSurfaceFilter::ExecuteFaceQuads(vtkDataSet* input, vtkPolyData* o
     inStartCellId = qInc[aAxis] * (ext[aA2 + 1] - ext[aA2] - 1);
   }
 
-  outStartPtId = outPts->GetNumberOfPoints();
   // Make the points for this face.
-  for (ic = ext[cA2]; ic <= ext[cA2 + 1]; ++ic)
-  {
-    for (ib = ext[bA2]; ib <= ext[bA2 + 1]; ++ib)
+  const vtkIdType numB = ext[bA2 + 1] - ext[bA2] + 1;
+  const vtkIdType numC = ext[cA2 + 1] - ext[cA2] + 1;
+  const vtkIdType numFacePts = numB * numC;
+  outStartPtId = outPts->GetNumberOfPoints();
+  outPts->SetNumberOfPoints(outStartPtId + numFacePts);
+  vtkNew<vtkIdList> inIds;
+  inIds->SetNumberOfIds(numFacePts);
+  vtkNew<vtkIdList> outIds;
+  outIds->SetNumberOfIds(numFacePts);
+  vtkSMPTools::For(0, numC, [&](vtkIdType beginC, vtkIdType endC) {
+    double pt[3];
+    for (vtkIdType c = beginC; c < endC; ++c)
     {
-      inId = inStartPtId + (ib - ext[bA2]) * pInc[bAxis] + (ic - ext[cA2]) * pInc[cAxis];
-      input->GetPoint(inId, pt);
-      outId = outPts->InsertNextPoint(pt);
-      // Copy point data.
-      outPD->CopyData(inPD, inId, outId);
-      this->RecordOrigPointId(outId, inId);
+      for (vtkIdType b = 0; b < numB; ++b)
+      {
+        const vtkIdType idx = c * numB + b;
+        const vtkIdType inId = inStartPtId + b * pInc[bAxis] + c * pInc[cAxis];
+        input->GetPoint(inId, pt);
+        outPts->SetPoint(outStartPtId + idx, pt);
+        inIds->SetId(idx, inId);
+        outIds->SetId(idx, outStartPtId + idx);
+      }
     }
+  });
+  // Copy point data.
+  outPD->CopyData(inPD, inIds, outIds);
+  if (this->OriginalPointIds != nullptr)
+  {
+    this->OriginalPointIds->SetNumberOfValues(outStartPtId + numFacePts);
+    std::copy(inIds->GetPointer(0), inIds->GetPointer(0) + numFacePts,
+      this->OriginalPointIds->GetPointer(outStartPtId));
   }
 
   // Do the cells.
-  cOutInc = ext[bA2 + 1] - ext[bA2] + 1;
+  cOutInc = numB;
+  const vtkIdType numQuadsB = numB - 1;
+  const vtkIdType numQuadsC = numC - 1;
+  const vtkIdType numQuads = numQuadsB * numQuadsC;
 
   outPolys = output->GetPolys();
-
-  // Old method for creating quads (needed for cell data.).
-  for (ic = ext[cA2]; ic < ext[cA2 + 1]; ++ic)
-  {
-    for (ib = ext[bA2]; ib < ext[bA2 + 1]; ++ib)
+  const vtkIdType outStartCellId = outPolys->GetNumberOfCells();
+  const vtkIdType outStartConnId = outPolys->GetNumberOfConnectivityIds();
+  outPolys->ResizeExact(outStartCellId + numQuads, outStartConnId + 4 * numQuads);
+  outPolys->Visit(GenerateFaceQuadsImpl{}, outStartCellId, outStartConnId, outStartPtId,
+    numQuadsB, numQuadsC, cOutInc);
+
+  inIds->SetNumberOfIds(numQuads);
+  outIds->SetNumberOfIds(numQuads);
+  vtkSMPTools::For(0, numQuadsC, [&](vtkIdType beginC, vtkIdType endC) {
+    for (vtkIdType c = beginC; c < endC; ++c)
     {
-      outPtId = outStartPtId + (ib - ext[bA2]) + (ic - ext[cA2]) * cOutInc;
-      inId = inStartCellId + (ib - ext[bA2]) * qInc[bAxis] + (ic - ext[cA2]) * qInc[cAxis];
-
-      outId = outPolys->InsertNextCell(4);
-      outPolys->InsertCellPoint(outPtId);
-      outPolys->InsertCellPoint(outPtId + cOutInc);
-      outPolys->InsertCellPoint(outPtId + cOutInc + 1);
-      outPolys->InsertCellPoint(outPtId + 1);
-      // Copy cell data.
-      outCD->CopyData(inCD, inId, outId);
-      this->RecordOrigCellId(outId, inId);
+      for (vtkIdType b = 0; b < numQuadsB; ++b)
+      {
+        const vtkIdType idx = c * numQuadsB + b;
+        inIds->SetId(idx, inStartCellId + b * qInc[bAxis] + c * qInc[cAxis]);
+        outIds->SetId(idx, outStartCellId + idx);
+      }
     }
+  });
+  // Copy cell data.
+  outCD->CopyData(inCD, inIds, outIds);
+  if (this->OriginalCellIds != nullptr)
+  {
+    this->OriginalCellIds->SetNumberOfValues(outStartCellId + numQuads);
+    std::copy(inIds->GetPointer(0), inIds->GetPointer(0) + numQuads,
+      this->OriginalCellIds->GetPointer(outStartCellId));
   }
 }
 
@@ -1459,11 +1526,813 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 // Tris are now degenerate quads so we only need one hash table.
 // We might want to change the method names from QuadHash to just Hash.
 
+namespace
+{
+// Cells, faces and points are processed by chunks of consecutive items so
+// that the output can be laid out in the serial order with a prefix sum over
+// the chunk counts.
+constexpr vtkIdType SurfaceChunkSize = 4096;
+
+// The three kinds of output cells, in the order they are output.
+enum SurfaceCellClass
+{
+  SurfaceVerts = 0,
+  SurfaceLines = 1,
+  SurfacePolys = 2
+};
+
+// Faces of the linear 3D cells, listed in the order and orientation used by
+// UnstructuredGridExecute() to insert them in the quad hash.
+struct SurfaceCellFaces
+{
+  int NumberOfFaces;
+  int FaceSizes[8];
+  int Faces[8][6];
+};
+
+const SurfaceCellFaces* GetSurfaceCellFaces(int cellType)
+{
+  static const SurfaceCellFaces tetraFaces = { 4, { 3, 3, 3, 3 },
+    { { 0, 1, 3 }, { 0, 2, 1 }, { 0, 3, 2 }, { 1, 2, 3 } } };
+  static const SurfaceCellFaces voxelFaces = { 6, { 4, 4, 4, 4, 4, 4 },
+    { { 0, 1, 5, 4 }, { 0, 2, 3, 1 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 2, 6, 7, 3 },
+      { 4, 5, 7, 6 } } };
+  static const SurfaceCellFaces hexahedronFaces = { 6, { 4, 4, 4, 4, 4, 4 },
+    { { 0, 1, 5, 4 }, { 0, 3, 2, 1 }, { 0, 4, 7, 3 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 },
+      { 4, 5, 6, 7 } } };
+  static const SurfaceCellFaces wedgeFaces = { 5, { 4, 4, 4, 3, 3 },
+    { { 0, 2, 5, 3 }, { 1, 0, 3, 4 }, { 2, 1, 4, 5 }, { 0, 1, 2 }, { 3, 5, 4 } } };
+  static const SurfaceCellFaces pyramidFaces = { 5, { 4, 3, 3, 3, 3 },
+    { { 3, 2, 1, 0 }, { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 }, { 3, 0, 4 } } };
+  static const SurfaceCellFaces pentagonalPrismFaces = { 7, { 4, 4, 4, 4, 4, 5, 5 },
+    { { 0, 1, 6, 5 }, { 1, 2, 7, 6 }, { 2, 3, 8, 7 }, { 3, 4, 9, 8 }, { 4, 0, 5, 9 },
+      { 0, 1, 2, 3, 4 }, { 5, 6, 7, 8, 9 } } };
+  static const SurfaceCellFaces hexagonalPrismFaces = { 8, { 4, 4, 4, 4, 4, 4, 6, 6 },
+    { { 0, 1, 7, 6 }, { 1, 2, 8, 7 }, { 2, 3, 9, 8 }, { 3, 4, 10, 9 }, { 4, 5, 11, 10 },
+      { 5, 0, 6, 11 }, { 0, 1, 2, 3, 4, 5 }, { 6, 7, 8, 9, 10, 11 } } };
+
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      return &tetraFaces;
+    case VTK_VOXEL:
+      return &voxelFaces;
+    case VTK_HEXAHEDRON:
+      return &hexahedronFaces;
+    case VTK_WEDGE:
+      return &wedgeFaces;
+    case VTK_PYRAMID:
+      return &pyramidFaces;
+    case VTK_PENTAGONAL_PRISM:
+      return &pentagonalPrismFaces;
+    case VTK_HEXAGONAL_PRISM:
+      return &hexagonalPrismFaces;
+    default:
+      return nullptr;
+  }
+}
+
+// Returns the class of the output cells generated by a cell that is not a 3D
+// cell, -1 for the cell types ThreadedUnstructuredGridExecute() does not
+// handle.
+int GetSurfaceCellClass(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+      return SurfaceVerts;
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+      return SurfaceLines;
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_POLYGON:
+    case VTK_PIXEL:
+    case VTK_TRIANGLE_STRIP:
+      return SurfacePolys;
+    default:
+      return -1;
+  }
+}
+
+bool IsThreadedSurfaceCellType(int cellType)
+{
+  return cellType == VTK_EMPTY_CELL || GetSurfaceCellClass(cellType) >= 0 ||
+    GetSurfaceCellFaces(cellType) != nullptr;
+}
+
+// Copies the points of a face rotated the way the quad hash stores them:
+// triangles and quads start at their smallest id when it is unique, larger
+// polygons at the first occurrence of their smallest id.
+int GetHashedFacePoints(const vtkIdType* cellPts, const SurfaceCellFaces* faces, int faceId,
+  vtkIdType facePts[6])
+{
+  const int numFacePts = faces->FaceSizes[faceId];
+  const int* face = faces->Faces[faceId];
+  int start = 0;
+  if (numFacePts == 4)
+  {
+    const vtkIdType a = cellPts[face[0]], b = cellPts[face[1]];
+    const vtkIdType c = cellPts[face[2]], d = cellPts[face[3]];
+    if (b < a && b < c && b < d)
+    {
+      start = 1;
+    }
+    else if (c < a && c < b && c < d)
+    {
+      start = 2;
+    }
+    else if (d < a && d < b && d < c)
+    {
+      start = 3;
+    }
+  }
+  else if (numFacePts == 3)
+  {
+    const vtkIdType a = cellPts[face[0]], b = cellPts[face[1]], c = cellPts[face[2]];
+    if (b < a && b < c)
+    {
+      start = 1;
+    }
+    else if (c < a && c < b)
+    {
+      start = 2;
+    }
+  }
+  else
+  {
+    for (int i = 1; i < numFacePts; ++i)
+    {
+      if (cellPts[face[i]] < cellPts[face[start]])
+      {
+        start = i;
+      }
+    }
+  }
+  for (int i = 0; i < numFacePts; ++i)
+  {
+    facePts[i] = cellPts[face[(start + i) % numFacePts]];
+  }
+  return numFacePts;
+}
+
+// Tells whether a face matches a face stored before it in the same bin of the
+// quad hash, with the same tests as InsertQuadInHash(), InsertTriInHash() and
+// InsertPolygonInHash().
+bool IsSameHashedFace(const vtkIdType* pts, int numPts, const vtkIdType* stored, int numStored)
+{
+  if (numPts == 4)
+  {
+    return numStored == 4 && pts[2] == stored[2] &&
+      ((pts[1] == stored[1] && pts[3] == stored[3]) ||
+        (pts[1] == stored[3] && pts[3] == stored[1]));
+  }
+  if (numPts == 3)
+  {
+    return numStored == 3 &&
+      ((pts[1] == stored[1] && pts[2] == stored[2]) ||
+        (pts[1] == stored[2] && pts[2] == stored[1]));
+  }
+  if (numPts != numStored || pts[0] != stored[0])
+  {
+    return false;
+  }
+  if (numPts > 1 && pts[1] == stored[1])
+  {
+    return std::equal(pts + 2, pts + numPts, stored + 2);
+  }
+  for (int i = 1; i < numPts; ++i)
+  {
+    if (pts[numPts - i] != stored[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A face inserted in the hash. Sorting the faces gathers those of a bin in
+// the order the serial path inserts them.
+struct SurfaceHashedFace
+{
+  vtkIdType Bin;
+  vtkIdType CellId;
+  int FaceId;
+
+  bool operator<(const SurfaceHashedFace& other) const
+  {
+    if (this->Bin != other.Bin)
+    {
+      return this->Bin < other.Bin;
+    }
+    if (this->CellId != other.CellId)
+    {
+      return this->CellId < other.CellId;
+    }
+    return this->FaceId < other.FaceId;
+  }
+};
+
+// Visibility of the hashed faces.
+enum SurfaceFaceVisibility : unsigned char
+{
+  SurfaceFaceHidden = 0,
+  SurfaceFaceVisible = 1,
+  // The face is on the surface but uses a hidden point: its points are output
+  // but not the face itself, like in the serial path.
+  SurfaceFaceHiddenPoint = 2
+};
+
+// What a chunk of cells or faces outputs. The stream counts the input point
+// ids in the order the serial path maps them to output points.
+struct SurfaceChunk
+{
+  vtkIdType NumberOfCells[3] = { 0, 0, 0 };
+  vtkIdType ConnectivitySize[3] = { 0, 0, 0 };
+  vtkIdType StreamSize[3] = { 0, 0, 0 };
+  vtkIdType NumberOfFaces = 0;
+
+  // Where the chunk starts in the output, set by PrefixSum().
+  vtkIdType CellOffset[3] = { 0, 0, 0 };
+  vtkIdType ConnectivityOffset[3] = { 0, 0, 0 };
+  vtkIdType StreamOffset[3] = { 0, 0, 0 };
+  vtkIdType FaceOffset = 0;
+};
+
+// Turns the chunk counts into offsets and returns the totals.
+SurfaceChunk PrefixSum(std::vector<SurfaceChunk>& chunks)
+{
+  SurfaceChunk totals;
+  for (auto& chunk : chunks)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      chunk.CellOffset[i] = totals.NumberOfCells[i];
+      chunk.ConnectivityOffset[i] = totals.ConnectivitySize[i];
+      chunk.StreamOffset[i] = totals.StreamSize[i];
+      totals.NumberOfCells[i] += chunk.NumberOfCells[i];
+      totals.ConnectivitySize[i] += chunk.ConnectivitySize[i];
+      totals.StreamSize[i] += chunk.StreamSize[i];
+    }
+    chunk.FaceOffset = totals.NumberOfFaces;
+    totals.NumberOfFaces += chunk.NumberOfFaces;
+  }
+  return totals;
+}
+
+// Gives each thread its own iterator, the only thread-safe way to access the
+// cells whatever the storage of the connectivity.
+class SurfaceCellPoints
+{
+public:
+  explicit SurfaceCellPoints(vtkCellArray* cells)
+    : Cells(cells)
+  {
+  }
+
+  vtkCellArrayIterator* Local()
+  {
+    vtkSmartPointer<vtkCellArrayIterator>& iter = this->Iterators.Local();
+    if (!iter)
+    {
+      iter.TakeReference(this->Cells->NewIterator());
+    }
+    return iter;
+  }
+
+private:
+  vtkCellArray* Cells;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterators;
+};
+
+// Output points are numbered in the order of their first use in the stream.
+void RecordFirstUse(std::atomic<vtkIdType>& firstUse, vtkIdType position)
+{
+  vtkIdType current = firstUse.load(std::memory_order_relaxed);
+  while (position < current &&
+    !firstUse.compare_exchange_weak(current, position, std::memory_order_relaxed))
+  {
+  }
+}
+
+// Writes the output cells in the input point ids, and the input cell they
+// come from.
+struct SurfaceCellWriter
+{
+  vtkIdType* Offsets;
+  vtkIdType* Connectivity;
+  vtkIdType* CellIds;
+
+  void Write(vtkIdType cellId, vtkIdType connId, vtkIdType npts, const vtkIdType* pts,
+    vtkIdType sourceId) const
+  {
+    std::copy(pts, pts + npts, this->Connectivity + connId);
+    this->Offsets[cellId + 1] = connId + npts;
+    this->CellIds[cellId] = sourceId;
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::ThreadedUnstructuredGridExecute(
+  vtkUnstructuredGrid* input, vtkPolyData* output)
+{
+  vtkCellArray* cells = input->GetCells();
+  vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numChunks = (numCells + SurfaceChunkSize - 1) / SurfaceChunkSize;
+  SurfaceCellPoints cellPoints(cells);
+
+  // Shallow copy field data not associated with points or cells
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  // Count what each chunk of cells outputs as verts, lines and 2D polys, and
+  // the faces of its 3D cells.
+  std::vector<SurfaceChunk> chunks(numChunks);
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      SurfaceChunk& chunk = chunks[chunkId];
+      const vtkIdType endCellId = std::min((chunkId + 1) * SurfaceChunkSize, numCells);
+      for (vtkIdType cellId = chunkId * SurfaceChunkSize; cellId < endCellId; ++cellId)
+      {
+        const int cellType = input->GetCellType(cellId);
+        if (const SurfaceCellFaces* faces = GetSurfaceCellFaces(cellType))
+        {
+          chunk.NumberOfFaces += faces->NumberOfFaces;
+          continue;
+        }
+        const int cellClass = GetSurfaceCellClass(cellType);
+        if (cellClass < 0)
+        {
+          continue;
+        }
+        const vtkIdType npts = cells->GetCellSize(cellId);
+        if (cellType == VTK_TRIANGLE_STRIP)
+        {
+          // Strips are output as triangles.
+          if (npts > 1)
+          {
+            chunk.StreamSize[cellClass] += npts;
+            chunk.NumberOfCells[cellClass] += npts - 2;
+            chunk.ConnectivitySize[cellClass] += 3 * (npts - 2);
+          }
+        }
+        else
+        {
+          chunk.StreamSize[cellClass] += npts;
+          chunk.NumberOfCells[cellClass]++;
+          chunk.ConnectivitySize[cellClass] += npts;
+        }
+      }
+    }
+  });
+  const SurfaceChunk cellTotals = PrefixSum(chunks);
+  const vtkIdType numFaces = cellTotals.NumberOfFaces;
+
+  // Gather the faces and sort them by bin of the quad hash.
+  std::vector<SurfaceHashedFace> faces(numFaces);
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    vtkCellArrayIterator* iter = cellPoints.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType facePts[6];
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      vtkIdType faceIdx = chunks[chunkId].FaceOffset;
+      const vtkIdType endCellId = std::min((chunkId + 1) * SurfaceChunkSize, numCells);
+      for (vtkIdType cellId = chunkId * SurfaceChunkSize; cellId < endCellId; ++cellId)
+      {
+        const SurfaceCellFaces* cellFaces = GetSurfaceCellFaces(input->GetCellType(cellId));
+        if (!cellFaces)
+        {
+          continue;
+        }
+        iter->GetCellAtId(cellId, npts, pts);
+        for (int faceId = 0; faceId < cellFaces->NumberOfFaces; ++faceId)
+        {
+          GetHashedFacePoints(pts, cellFaces, faceId, facePts);
+          faces[faceIdx++] = SurfaceHashedFace{ facePts[0], cellId, faceId };
+        }
+      }
+    }
+  });
+  vtkSMPTools::Sort(faces.begin(), faces.end());
+  this->UpdateProgress(0.25);
+
+  // Resolve each bin like the quad hash does: a face matching a face stored
+  // before it hides that face and is not stored. A bin crossing the end of a
+  // range is resolved by the range it starts in.
+  std::vector<unsigned char> visibility(numFaces, SurfaceFaceHidden);
+  vtkSMPTools::For(0, numFaces, SurfaceChunkSize, [&](vtkIdType begin, vtkIdType end) {
+    struct StoredFace
+    {
+      vtkIdType Index;
+      int NumberOfPoints;
+      bool Hidden;
+      vtkIdType Points[6];
+    };
+    std::vector<StoredFace> stored;
+    vtkCellArrayIterator* iter = cellPoints.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    vtkIdType faceIdx = begin;
+    while (faceIdx > 0 && faceIdx < end && faces[faceIdx].Bin == faces[begin - 1].Bin)
+    {
+      ++faceIdx;
+    }
+    while (faceIdx < end)
+    {
+      const vtkIdType bin = faces[faceIdx].Bin;
+      stored.clear();
+      for (; faceIdx < numFaces && faces[faceIdx].Bin == bin; ++faceIdx)
+      {
+        const SurfaceHashedFace& face = faces[faceIdx];
+        StoredFace candidate;
+        candidate.Index = faceIdx;
+        candidate.Hidden = false;
+        iter->GetCellAtId(face.CellId, npts, pts);
+        candidate.NumberOfPoints = GetHashedFacePoints(
+          pts, GetSurfaceCellFaces(input->GetCellType(face.CellId)), face.FaceId,
+          candidate.Points);
+        bool matched = false;
+        for (auto& storedFace : stored)
+        {
+          if (IsSameHashedFace(candidate.Points, candidate.NumberOfPoints, storedFace.Points,
+                storedFace.NumberOfPoints))
+          {
+            storedFace.Hidden = true;
+            matched = true;
+            break;
+          }
+        }
+        if (!matched)
+        {
+          stored.push_back(candidate);
+        }
+      }
+      for (const auto& storedFace : stored)
+      {
+        if (storedFace.Hidden)
+        {
+          continue;
+        }
+        bool oneHidden = false;
+        for (int i = 0; ghosts && i < storedFace.NumberOfPoints; ++i)
+        {
+          if (ghosts->GetValue(storedFace.Points[i]) & vtkDataSetAttributes::HIDDENPOINT)
+          {
+            oneHidden = true;
+            break;
+          }
+        }
+        visibility[storedFace.Index] = oneHidden ? SurfaceFaceHiddenPoint : SurfaceFaceVisible;
+      }
+    }
+  });
+
+  // Count what each chunk of faces outputs. Faces are output as polys.
+  const vtkIdType numFaceChunks = (numFaces + SurfaceChunkSize - 1) / SurfaceChunkSize;
+  std::vector<SurfaceChunk> faceChunks(numFaceChunks);
+  vtkSMPTools::For(0, numFaceChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      SurfaceChunk& chunk = faceChunks[chunkId];
+      const vtkIdType endFaceIdx = std::min((chunkId + 1) * SurfaceChunkSize, numFaces);
+      for (vtkIdType faceIdx = chunkId * SurfaceChunkSize; faceIdx < endFaceIdx; ++faceIdx)
+      {
+        if (visibility[faceIdx] == SurfaceFaceHidden)
+        {
+          continue;
+        }
+        const SurfaceHashedFace& face = faces[faceIdx];
+        const int numFacePts =
+          GetSurfaceCellFaces(input->GetCellType(face.CellId))->FaceSizes[face.FaceId];
+        chunk.StreamSize[SurfacePolys] += numFacePts;
+        if (visibility[faceIdx] == SurfaceFaceVisible)
+        {
+          chunk.NumberOfCells[SurfacePolys]++;
+          chunk.ConnectivitySize[SurfacePolys] += numFacePts;
+        }
+      }
+    }
+  });
+  const SurfaceChunk faceTotals = PrefixSum(faceChunks);
+
+  // Allocate the output cells. Faces come after the 2D cells in the polys.
+  vtkIdType numOutCells[3], connSize[3], streamStart[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    numOutCells[i] = cellTotals.NumberOfCells[i];
+    connSize[i] = cellTotals.ConnectivitySize[i];
+  }
+  numOutCells[SurfacePolys] += faceTotals.NumberOfCells[SurfacePolys];
+  connSize[SurfacePolys] += faceTotals.ConnectivitySize[SurfacePolys];
+  streamStart[SurfaceVerts] = 0;
+  streamStart[SurfaceLines] = cellTotals.StreamSize[SurfaceVerts];
+  streamStart[SurfacePolys] = streamStart[SurfaceLines] + cellTotals.StreamSize[SurfaceLines];
+  const vtkIdType faceStreamStart = streamStart[SurfacePolys] + cellTotals.StreamSize[SurfacePolys];
+  const vtkIdType numNewCells =
+    numOutCells[SurfaceVerts] + numOutCells[SurfaceLines] + numOutCells[SurfacePolys];
+
+  vtkNew<vtkIdList> cellIds;
+  cellIds->SetNumberOfIds(numNewCells);
+  vtkSmartPointer<vtkIdTypeArray> offsets[3];
+  vtkSmartPointer<vtkIdTypeArray> connectivity[3];
+  SurfaceCellWriter writers[3];
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  for (int i = 0; i < 3; ++i)
+  {
+    offsets[i] = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets[i]->SetNumberOfValues(numOutCells[i] + 1);
+    offsets[i]->SetValue(0, 0);
+    connectivity[i] = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity[i]->SetNumberOfValues(connSize[i]);
+    writers[i] = SurfaceCellWriter{ offsets[i]->GetPointer(0), connectivity[i]->GetPointer(0),
+      cellIdsPtr };
+    cellIdsPtr += numOutCells[i];
+  }
+
+  std::vector<std::atomic<vtkIdType>> firstUse(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstUse[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+
+  // Output the verts, lines and 2D cells in cell order.
+  static const int pixelOrder[4] = { 0, 1, 3, 2 };
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    vtkCellArrayIterator* iter = cellPoints.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      const SurfaceChunk& chunk = chunks[chunkId];
+      vtkIdType cellIdx[3], connIdx[3], streamIdx[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        cellIdx[i] = chunk.CellOffset[i];
+        connIdx[i] = chunk.ConnectivityOffset[i];
+        streamIdx[i] = streamStart[i] + chunk.StreamOffset[i];
+      }
+      const vtkIdType endCellId = std::min((chunkId + 1) * SurfaceChunkSize, numCells);
+      for (vtkIdType cellId = chunkId * SurfaceChunkSize; cellId < endCellId; ++cellId)
+      {
+        const int cellType = input->GetCellType(cellId);
+        const int cellClass = GetSurfaceCellClass(cellType);
+        if (cellClass < 0)
+        {
+          continue;
+        }
+        iter->GetCellAtId(cellId, npts, pts);
+        if (cellType == VTK_TRIANGLE_STRIP && npts < 2)
+        {
+          continue;
+        }
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const vtkIdType ptId = cellType == VTK_PIXEL ? pts[pixelOrder[i]] : pts[i];
+          RecordFirstUse(firstUse[ptId], streamIdx[cellClass]++);
+        }
+
+        const SurfaceCellWriter& writer = writers[cellClass];
+        if (cellType == VTK_PIXEL)
+        {
+          const vtkIdType quad[4] = { pts[pixelOrder[0]], pts[pixelOrder[1]], pts[pixelOrder[2]],
+            pts[pixelOrder[3]] };
+          writer.Write(cellIdx[cellClass]++, connIdx[cellClass], 4, quad, cellId);
+          connIdx[cellClass] += 4;
+        }
+        else if (cellType == VTK_TRIANGLE_STRIP)
+        {
+          // Change strips to triangles so we do not have to worry about order.
+          int toggle = 0;
+          vtkIdType triangle[3] = { pts[0], pts[1], 0 };
+          for (vtkIdType i = 2; i < npts; ++i)
+          {
+            triangle[2] = pts[i];
+            writer.Write(cellIdx[cellClass]++, connIdx[cellClass], 3, triangle, cellId);
+            connIdx[cellClass] += 3;
+            triangle[toggle] = triangle[2];
+            toggle = !toggle;
+          }
+        }
+        else
+        {
+          writer.Write(cellIdx[cellClass]++, connIdx[cellClass], npts, pts, cellId);
+          connIdx[cellClass] += npts;
+        }
+      }
+    }
+  });
+
+  // Output the visible faces in hash order, after the 2D cells.
+  const vtkIdType faceCellStart = cellTotals.NumberOfCells[SurfacePolys];
+  const vtkIdType faceConnStart = cellTotals.ConnectivitySize[SurfacePolys];
+  vtkSMPTools::For(0, numFaceChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    vtkCellArrayIterator* iter = cellPoints.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType facePts[6];
+    const SurfaceCellWriter& writer = writers[SurfacePolys];
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      const SurfaceChunk& chunk = faceChunks[chunkId];
+      vtkIdType cellIdx = faceCellStart + chunk.CellOffset[SurfacePolys];
+      vtkIdType connIdx = faceConnStart + chunk.ConnectivityOffset[SurfacePolys];
+      vtkIdType streamIdx = faceStreamStart + chunk.StreamOffset[SurfacePolys];
+      const vtkIdType endFaceIdx = std::min((chunkId + 1) * SurfaceChunkSize, numFaces);
+      for (vtkIdType faceIdx = chunkId * SurfaceChunkSize; faceIdx < endFaceIdx; ++faceIdx)
+      {
+        if (visibility[faceIdx] == SurfaceFaceHidden)
+        {
+          continue;
+        }
+        const SurfaceHashedFace& face = faces[faceIdx];
+        iter->GetCellAtId(face.CellId, npts, pts);
+        const int numFacePts = GetHashedFacePoints(
+          pts, GetSurfaceCellFaces(input->GetCellType(face.CellId)), face.FaceId, facePts);
+        for (int i = 0; i < numFacePts; ++i)
+        {
+          RecordFirstUse(firstUse[facePts[i]], streamIdx++);
+        }
+        if (visibility[faceIdx] == SurfaceFaceVisible)
+        {
+          writer.Write(cellIdx++, connIdx, numFacePts, facePts, face.CellId);
+          connIdx += numFacePts;
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.5);
+
+  // Number the output points in the order of their first use.
+  const vtkIdType numPtChunks = (numPts + SurfaceChunkSize - 1) / SurfaceChunkSize;
+  std::vector<vtkIdType> usedOffsets(numPtChunks + 1, 0);
+  vtkSMPTools::For(0, numPtChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      const vtkIdType endPtId = std::min((chunkId + 1) * SurfaceChunkSize, numPts);
+      for (vtkIdType ptId = chunkId * SurfaceChunkSize; ptId < endPtId; ++ptId)
+      {
+        if (firstUse[ptId].load(std::memory_order_relaxed) != VTK_ID_MAX)
+        {
+          usedOffsets[chunkId + 1]++;
+        }
+      }
+    }
+  });
+  std::partial_sum(usedOffsets.begin(), usedOffsets.end(), usedOffsets.begin());
+  const vtkIdType numNewPts = usedOffsets[numPtChunks];
+
+  std::vector<std::pair<vtkIdType, vtkIdType>> usedPoints(numNewPts);
+  vtkSMPTools::For(0, numPtChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      vtkIdType usedIdx = usedOffsets[chunkId];
+      const vtkIdType endPtId = std::min((chunkId + 1) * SurfaceChunkSize, numPts);
+      for (vtkIdType ptId = chunkId * SurfaceChunkSize; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType position = firstUse[ptId].load(std::memory_order_relaxed);
+        if (position != VTK_ID_MAX)
+        {
+          usedPoints[usedIdx++] = std::make_pair(position, ptId);
+        }
+      }
+    }
+  });
+  vtkSMPTools::Sort(usedPoints.begin(), usedPoints.end());
+
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkNew<vtkIdList> origPtIds;
+  origPtIds->SetNumberOfIds(numNewPts);
+  vtkNew<vtkIdList> newIds;
+  newIds->SetNumberOfIds(std::max(numNewPts, numNewCells));
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(input->GetPoints()->GetData()->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType newPtId = begin; newPtId < end; ++newPtId)
+    {
+      const vtkIdType ptId = usedPoints[newPtId].second;
+      pointMap[ptId] = newPtId;
+      origPtIds->SetId(newPtId, ptId);
+      input->GetPoint(ptId, x);
+      newPts->SetPoint(newPtId, x);
+    }
+  });
+  vtkSMPTools::For(0, newIds->GetNumberOfIds(), [&](vtkIdType begin, vtkIdType end) {
+    std::iota(newIds->GetPointer(begin), newIds->GetPointer(end), begin);
+  });
+
+  for (int i = 0; i < 3; ++i)
+  {
+    vtkIdType* conn = connectivity[i]->GetPointer(0);
+    vtkSMPTools::For(0, connSize[i], [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType connIdx = begin; connIdx < end; ++connIdx)
+      {
+        conn[connIdx] = pointMap[conn[connIdx]];
+      }
+    });
+  }
+  this->UpdateProgress(0.75);
+
+  // Copy the attributes of the output points and cells.
+  if (this->NonlinearSubdivisionLevel < 2)
+  {
+    outputPD->CopyGlobalIdsOn();
+    outputPD->CopyAllocate(inputPD, numPts, numPts / 2);
+  }
+  else
+  {
+    outputPD->InterpolateAllocate(inputPD, numPts, numPts / 2);
+  }
+  newIds->SetNumberOfIds(numNewPts);
+  outputPD->CopyData(inputPD, origPtIds, newIds);
+
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(inputCD, numCells, numCells / 2);
+  newIds->SetNumberOfIds(numNewCells);
+  outputCD->CopyData(inputCD, cellIds, newIds);
+
+  if (this->PassThroughCellIds)
+  {
+    vtkNew<vtkIdTypeArray> originalCellIds;
+    originalCellIds->SetName(this->GetOriginalCellIdsName());
+    originalCellIds->SetNumberOfComponents(1);
+    originalCellIds->SetNumberOfValues(numNewCells);
+    std::copy(cellIds->GetPointer(0), cellIds->GetPointer(0) + numNewCells,
+      originalCellIds->GetPointer(0));
+    outputCD->AddArray(originalCellIds);
+  }
+  if (this->PassThroughPointIds)
+  {
+    vtkNew<vtkIdTypeArray> originalPointIds;
+    originalPointIds->SetName(this->GetOriginalPointIdsName());
+    originalPointIds->SetNumberOfComponents(1);
+    originalPointIds->SetNumberOfValues(numNewPts);
+    std::copy(origPtIds->GetPointer(0), origPtIds->GetPointer(0) + numNewPts,
+      originalPointIds->GetPointer(0));
+    outputPD->AddArray(originalPointIds);
+  }
+
+  output->SetPoints(newPts);
+  vtkNew<vtkCellArray> newCells[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    newCells[i]->SetData(offsets[i], connectivity[i]);
+  }
+  output->SetPolys(newCells[SurfacePolys]);
+  if (numOutCells[SurfaceVerts] > 0)
+  {
+    output->SetVerts(newCells[SurfaceVerts]);
+  }
+  if (numOutCells[SurfaceLines] > 0)
+  {
+    output->SetLines(newCells[SurfaceLines]);
+  }
+  output->Squeeze();
+  this->NumberOfNewCells = numNewCells;
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPolyData* output)
 {
   vtkUnstructuredGridBase* input = vtkUnstructuredGridBase::SafeDownCast(dataSetInput);
 
+  // Grids made only of cells with a fixed face layout are processed in
+  // parallel.
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid && grid->GetCells() && grid->GetPoints())
+  {
+    std::atomic<bool> supported(true);
+    vtkSMPTools::For(0, grid->GetNumberOfCells(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end && supported; ++cellId)
+      {
+        if (!IsThreadedSurfaceCellType(grid->GetCellType(cellId)))
+        {
+          supported = false;
+        }
+      }
+    });
+    if (supported)
+    {
+      return this->ThreadedUnstructuredGridExecute(grid, output);
+    }
+  }
+
   vtkSmartPointer<vtkCellIterator> cellIter =
     vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
 
@@ -21,6 +21,15 @@
  * vtkGeometryFilter.  It only has one option: whether to use triangle strips
  * when the input type is structured.
  *
+ * Unstructured grids made only of linear cells with a fixed face layout
+ * (vertices, lines, triangles, quads, polygons, pixels, strips, tetrahedra,
+ * voxels, hexahedra, wedges, pyramids and prisms) are processed in parallel
+ * with vtkSMPTools: the faces are sorted instead of being inserted in the
+ * quad hash one after the other, producing the same output as the serial
+ * path. Subclasses customizing the quad hash must also override
+ * UnstructuredGridExecute(). The quads of structured boundaries are also
+ * generated in parallel.
+ *
  * @sa
  * vtkGeometryFilter vtkStructuredGridGeometryFilter.
  */
@@ -35,6 +44,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 
 // Helper structure for hashing faces.
 struct vtkFastGeomQuadStruct
@@ -199,6 +209,13 @@ protected:
   void ExecuteFaceQuads(vtkDataSet* input, vtkPolyData* output, int maxFlag, vtkIdType* ext,
     int aAxis, int bAxis, int cAxis, vtkIdType* wholeExt);
 
+  /**
+   * Parallel version of UnstructuredGridExecute() for unstructured grids
+   * made only of the cell types it supports, see the class description.
+   * Called by UnstructuredGridExecute() when applicable.
+   */
+  int ThreadedUnstructuredGridExecute(vtkUnstructuredGrid* input, vtkPolyData* output);
+
   void InitializeQuadHash(vtkIdType numPoints);
   void DeleteQuadHash();
   virtual void InsertQuadInHash(
@@ -24,6 +24,7 @@
 #include "vtkGenericCell.h"
 #include "vtkHexagonalPrism.h"
 #include "vtkHexahedron.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -34,6 +35,9 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPyramid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTetra.h"
@@ -42,6 +46,11 @@
 #include "vtkVoxel.h"
 #include "vtkWedge.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkGeometryFilter);
 vtkCxxSetObjectMacro(vtkGeometryFilter, Locator, vtkIncrementalPointLocator);
 
@@ -584,6 +593,266 @@ void vtkGeometryFilter::PolyDataExecute(vtkDataSet* dataSetInput, vtkPolyData* o
                 << output->GetNumberOfCells() << " cells.");
 }
 
+namespace
+{
+// Cells are processed by chunks of consecutive cells whose outputs are then
+// concatenated in cell order.
+constexpr vtkIdType GeometryChunkSize = 4096;
+
+// The kinds of output cells, in the order their cell data is output.
+enum GeometryCellClass
+{
+  GeometryVerts = 0,
+  GeometryLines = 1,
+  GeometryPolys = 2,
+  GeometryStrips = 3
+};
+
+// Nonlinear cells are tessellated by the serial path only.
+bool IsNonlinearGeometryCell(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_QUADRATIC_EDGE:
+    case VTK_CUBIC_LINE:
+    case VTK_QUADRATIC_TRIANGLE:
+    case VTK_QUADRATIC_QUAD:
+    case VTK_QUADRATIC_POLYGON:
+    case VTK_QUADRATIC_TETRA:
+    case VTK_QUADRATIC_HEXAHEDRON:
+    case VTK_QUADRATIC_WEDGE:
+    case VTK_QUADRATIC_PYRAMID:
+    case VTK_QUADRATIC_LINEAR_QUAD:
+    case VTK_BIQUADRATIC_TRIANGLE:
+    case VTK_BIQUADRATIC_QUAD:
+    case VTK_TRIQUADRATIC_HEXAHEDRON:
+    case VTK_QUADRATIC_LINEAR_WEDGE:
+    case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+    case VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the faces of the linear 3D cells, nullptr for the other cells.
+using GeometryFaceArrayFunction = const vtkIdType* (*)(vtkIdType);
+GeometryFaceArrayFunction GetGeometryFaceArray(int cellType, int& numFaces)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      numFaces = 4;
+      return vtkTetra::GetFaceArray;
+    case VTK_VOXEL:
+      numFaces = 6;
+      return vtkVoxel::GetFaceArray;
+    case VTK_HEXAHEDRON:
+      numFaces = 6;
+      return vtkHexahedron::GetFaceArray;
+    case VTK_WEDGE:
+      numFaces = 5;
+      return vtkWedge::GetFaceArray;
+    case VTK_PYRAMID:
+      numFaces = 5;
+      return vtkPyramid::GetFaceArray;
+    case VTK_PENTAGONAL_PRISM:
+      numFaces = 7;
+      return vtkPentagonalPrism::GetFaceArray;
+    case VTK_HEXAGONAL_PRISM:
+      numFaces = 8;
+      return vtkHexagonalPrism::GetFaceArray;
+    default:
+      numFaces = 0;
+      return nullptr;
+  }
+}
+
+// The cells output by a chunk of input cells, per kind of output cell.
+struct GeometryChunk
+{
+  std::vector<vtkIdType> Connectivity[4];
+  std::vector<vtkIdType> CellSizes[4];
+  std::vector<vtkIdType> CellIds[4];
+
+  void AddCell(int cellClass, vtkIdType npts, const vtkIdType* pts, vtkIdType cellId)
+  {
+    this->Connectivity[cellClass].insert(this->Connectivity[cellClass].end(), pts, pts + npts);
+    this->CellSizes[cellClass].push_back(npts);
+    this->CellIds[cellClass].push_back(cellId);
+  }
+};
+
+// Extracts the geometry of the visible cells of a chunk, like the serial
+// loop of vtkGeometryFilter::UnstructuredGridExecute() does. The cell links
+// must be built and the connectivity shareable so that the neighbor queries
+// are thread safe.
+struct ExtractUnstructuredGeometry
+{
+  vtkUnstructuredGrid* Input;
+  const char* CellVis;
+  const unsigned char* CellGhosts;
+  std::vector<GeometryChunk>& Chunks;
+  vtkSMPThreadLocalObject<vtkIdList> FaceIds;
+  vtkSMPThreadLocalObject<vtkIdList> Neighbors;
+
+  ExtractUnstructuredGeometry(vtkUnstructuredGrid* input, const char* cellVis,
+    const unsigned char* cellGhosts, std::vector<GeometryChunk>& chunks)
+    : Input(input)
+    , CellVis(cellVis)
+    , CellGhosts(cellGhosts)
+    , Chunks(chunks)
+  {
+  }
+
+  void operator()(vtkIdType beginChunk, vtkIdType endChunk)
+  {
+    static const int pixelConvert[4] = { 0, 1, 3, 2 };
+    vtkIdList* faceIds = this->FaceIds.Local();
+    vtkIdList* neighbors = this->Neighbors.Local();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType facePts[6];
+
+    for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+    {
+      GeometryChunk& chunk = this->Chunks[chunkId];
+      const vtkIdType endCellId = std::min((chunkId + 1) * GeometryChunkSize, numCells);
+      for (vtkIdType cellId = chunkId * GeometryChunkSize; cellId < endCellId; ++cellId)
+      {
+        // Do not create surfaces in outer ghost cells.
+        if ((this->CellGhosts &&
+              this->CellGhosts[cellId] & vtkDataSetAttributes::DUPLICATECELL) ||
+          (this->CellVis && !this->CellVis[cellId]))
+        {
+          continue;
+        }
+
+        const int cellType = this->Input->GetCellType(cellId);
+        this->Input->GetCellPoints(cellId, npts, pts);
+        switch (cellType)
+        {
+          case VTK_VERTEX:
+          case VTK_POLY_VERTEX:
+            chunk.AddCell(GeometryVerts, npts, pts, cellId);
+            continue;
+          case VTK_LINE:
+          case VTK_POLY_LINE:
+            chunk.AddCell(GeometryLines, npts, pts, cellId);
+            continue;
+          case VTK_TRIANGLE:
+          case VTK_QUAD:
+          case VTK_POLYGON:
+            chunk.AddCell(GeometryPolys, npts, pts, cellId);
+            continue;
+          case VTK_TRIANGLE_STRIP:
+            chunk.AddCell(GeometryStrips, npts, pts, cellId);
+            continue;
+          case VTK_PIXEL:
+            npts = std::min<vtkIdType>(npts, 4);
+            for (vtkIdType i = 0; i < npts; i++)
+            {
+              facePts[i] = pts[pixelConvert[i]];
+            }
+            chunk.AddCell(GeometryPolys, npts, facePts, cellId);
+            continue;
+          default:
+            break;
+        }
+
+        int numFaces;
+        GeometryFaceArrayFunction getFaceArray = GetGeometryFaceArray(cellType, numFaces);
+        for (int faceId = 0; faceId < numFaces; faceId++)
+        {
+          const vtkIdType* faceVerts = getFaceArray(faceId);
+          faceIds->Reset();
+          for (int i = 0; i < 6 && faceVerts[i] >= 0; i++)
+          {
+            faceIds->InsertNextId(pts[faceVerts[i]]);
+          }
+          this->Input->GetCellNeighbors(cellId, faceIds, neighbors);
+          if (neighbors->GetNumberOfIds() <= 0 ||
+            (this->CellVis && !this->CellVis[neighbors->GetId(0)]))
+          {
+            const vtkIdType numFacePts = faceIds->GetNumberOfIds();
+            for (vtkIdType i = 0; i < numFacePts; i++)
+            {
+              facePts[i] =
+                cellType == VTK_VOXEL ? pts[faceVerts[pixelConvert[i]]] : pts[faceVerts[i]];
+            }
+            chunk.AddCell(GeometryPolys, numFacePts, facePts, cellId);
+          }
+        }
+      }
+    }
+  }
+};
+
+// Parallel version of the cell loop of UnstructuredGridExecute(): cells are
+// extracted by chunks whose outputs are concatenated in cell order, so the
+// output is the same as the one of the serial loop.
+void ThreadedUnstructuredGridExtract(vtkUnstructuredGrid* input, const char* cellVis,
+  const unsigned char* cellGhosts, vtkCellArray* outCells[4], vtkIdList* cellIds)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numChunks = (numCells + GeometryChunkSize - 1) / GeometryChunkSize;
+  std::vector<GeometryChunk> chunks(numChunks);
+  ExtractUnstructuredGeometry extractor(input, cellVis, cellGhosts, chunks);
+  vtkSMPTools::For(0, numChunks, 1, extractor);
+
+  // Lay the chunks out in cell order.
+  std::vector<vtkIdType> cellOffsets[4], connOffsets[4];
+  vtkIdType cellIdsOffsets[5] = { 0, 0, 0, 0, 0 };
+  for (int k = 0; k < 4; ++k)
+  {
+    cellOffsets[k].resize(numChunks + 1, 0);
+    connOffsets[k].resize(numChunks + 1, 0);
+    for (vtkIdType chunkId = 0; chunkId < numChunks; ++chunkId)
+    {
+      cellOffsets[k][chunkId + 1] =
+        cellOffsets[k][chunkId] + static_cast<vtkIdType>(chunks[chunkId].CellSizes[k].size());
+      connOffsets[k][chunkId + 1] =
+        connOffsets[k][chunkId] + static_cast<vtkIdType>(chunks[chunkId].Connectivity[k].size());
+    }
+    cellIdsOffsets[k + 1] = cellIdsOffsets[k] + cellOffsets[k][numChunks];
+  }
+  cellIds->SetNumberOfIds(cellIdsOffsets[4]);
+
+  for (int k = 0; k < 4; ++k)
+  {
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(cellOffsets[k][numChunks] + 1);
+    offsets->SetValue(0, 0);
+    vtkNew<vtkIdTypeArray> conn;
+    conn->SetNumberOfValues(connOffsets[k][numChunks]);
+    vtkIdType* offsetsPtr = offsets->GetPointer(0);
+    vtkIdType* connPtr = conn->GetPointer(0);
+    vtkIdType* cellIdsPtr = cellIds->GetPointer(cellIdsOffsets[k]);
+    vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+      for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+      {
+        GeometryChunk& chunk = chunks[chunkId];
+        vtkIdType cellIdx = cellOffsets[k][chunkId];
+        vtkIdType offset = connOffsets[k][chunkId];
+        std::copy(chunk.Connectivity[k].begin(), chunk.Connectivity[k].end(), connPtr + offset);
+        std::copy(chunk.CellIds[k].begin(), chunk.CellIds[k].end(), cellIdsPtr + cellIdx);
+        for (vtkIdType size : chunk.CellSizes[k])
+        {
+          offset += size;
+          offsetsPtr[++cellIdx] = offset;
+        }
+        // Release the chunk as soon as it has been copied.
+        chunk.Connectivity[k] = std::vector<vtkIdType>();
+        chunk.CellSizes[k] = std::vector<vtkIdType>();
+        chunk.CellIds[k] = std::vector<vtkIdType>();
+      }
+    });
+    outCells[k]->SetData(offsets, conn);
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPolyData* output)
 {
@@ -609,7 +878,6 @@ void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPol
   char* cellVis;
   int faceId, numFacePts;
   const vtkIdType* faceVerts;
-  double x[3];
   int pixelConvert[4];
   unsigned char* cellGhosts = nullptr;
 
@@ -662,6 +930,106 @@ void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPol
   outputCD->CopyGlobalIdsOn();
   outputCD->CopyAllocate(cd, numCells, numCells / 2);
 
+  // Loop over the cells determining what's visible
+  if (!allVisible)
+  {
+    vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> localIters;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+      vtkSmartPointer<vtkCellArrayIterator>& iter = localIters.Local();
+      if (!iter)
+      {
+        iter.TakeReference(connectivity->NewIterator());
+      }
+      vtkIdType numCellPts;
+      const vtkIdType* cellPts;
+      double pt[3];
+      for (vtkIdType visCellId = beginCellId; visCellId < endCellId; ++visCellId)
+      {
+        iter->GetCellAtId(visCellId, numCellPts, cellPts);
+        cellVis[visCellId] = 1;
+        if (this->CellClipping &&
+          (visCellId < this->CellMinimum || visCellId > this->CellMaximum))
+        {
+          cellVis[visCellId] = 0;
+        }
+        else
+        {
+          for (int i = 0; i < numCellPts; i++)
+          {
+            p->GetPoint(cellPts[i], pt);
+            if ((this->PointClipping &&
+                  (cellPts[i] < this->PointMinimum || cellPts[i] > this->PointMaximum)) ||
+              (this->ExtentClipping &&
+                (pt[0] < this->Extent[0] || pt[0] > this->Extent[1] || pt[1] < this->Extent[2] ||
+                  pt[1] > this->Extent[3] || pt[2] < this->Extent[4] || pt[2] > this->Extent[5])))
+            {
+              cellVis[visCellId] = 0;
+              break;
+            } // point/extent clipping
+          }   // for each point
+        }     // if point clipping needs checking
+      }       // for all cells
+    });
+  } // if not all visible
+
+  // Cells are extracted in parallel when the neighbor queries are thread
+  // safe, that is when the connectivity can be shared, and when there is no
+  // nonlinear cell to tessellate.
+  if (connectivity->IsStorageShareable())
+  {
+    std::atomic<bool> hasNonlinearCells(false);
+    std::atomic<bool> has3DCells(false);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+      int numFaces;
+      for (vtkIdType typeCellId = beginCellId; typeCellId < endCellId; ++typeCellId)
+      {
+        const int cellType = input->GetCellType(typeCellId);
+        if (IsNonlinearGeometryCell(cellType))
+        {
+          hasNonlinearCells = true;
+          break;
+        }
+        if (!has3DCells && GetGeometryFaceArray(cellType, numFaces))
+        {
+          has3DCells = true;
+        }
+      }
+    });
+
+    if (!hasNonlinearCells)
+    {
+      if (has3DCells && !input->GetCellLinks())
+      {
+        input->BuildLinks();
+      }
+
+      vtkNew<vtkCellArray> outCells[4];
+      vtkCellArray* outCellsPtr[4] = { outCells[0], outCells[1], outCells[2], outCells[3] };
+      vtkNew<vtkIdList> sourceIds;
+      ThreadedUnstructuredGridExtract(input, cellVis, cellGhosts, outCellsPtr, sourceIds);
+      output->SetVerts(outCells[GeometryVerts]);
+      output->SetLines(outCells[GeometryLines]);
+      output->SetPolys(outCells[GeometryPolys]);
+      output->SetStrips(outCells[GeometryStrips]);
+
+      // Copy the cell data in appropriate order : verts / lines / polys / strips
+      vtkNew<vtkIdList> destIds;
+      destIds->SetNumberOfIds(sourceIds->GetNumberOfIds());
+      std::iota(destIds->GetPointer(0), destIds->GetPointer(0) + destIds->GetNumberOfIds(), 0);
+      outputCD->CopyData(cd, sourceIds, destIds);
+
+      output->Squeeze();
+
+      vtkDebugMacro(<< "Extracted " << input->GetNumberOfPoints() << " points,"
+                    << output->GetNumberOfCells() << " cells.");
+
+      cellIds->Delete();
+      faceIds->Delete();
+      delete[] cellVis;
+      return;
+    }
+  }
+
   verts = vtkCellArray::New();
   verts->AllocateEstimate(numCells / 4, 1);
   lines = vtkCellArray::New();
@@ -671,36 +1039,6 @@ void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPol
   strips = vtkCellArray::New();
   strips->AllocateEstimate(numCells / 4, 1);
 
-  // Loop over the cells determining what's visible
-  if (!allVisible)
-  {
-    for (cellIter->GoToFirstCell(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
-    {
-      cellId = cellIter->GetCurrentCellId();
-      cellIter->GetCurrentCell(npts, pts);
-      cellVis[cellId] = 1;
-      if (this->CellClipping && (cellId < this->CellMinimum || cellId > this->CellMaximum))
-      {
-        cellVis[cellId] = 0;
-      }
-      else
-      {
-        for (int i = 0; i < npts; i++)
-        {
-          p->GetPoint(pts[i], x);
-          if ((this->PointClipping &&
-                (pts[i] < this->PointMinimum || pts[i] > this->PointMaximum)) ||
-            (this->ExtentClipping &&
-              (x[0] < this->Extent[0] || x[0] > this->Extent[1] || x[1] < this->Extent[2] ||
-                x[1] > this->Extent[3] || x[2] < this->Extent[4] || x[2] > this->Extent[5])))
-          {
-            cellVis[cellId] = 0;
-            break;
-          } // point/extent clipping
-        }   // for each point
-      }     // if point clipping needs checking
-    }       // for all cells
-  }         // if not all visible
 
   // Used for nonlinear cells only
   vtkNew<vtkGenericCell> cell;
@@ -31,6 +31,11 @@
  * vtkExtractUnstructuredGrid, vtkRectilinearGridGeometryFilter, or
  * vtkExtractVOI.)
  *
+ * The cells of unstructured grids are processed in parallel with
+ * vtkSMPTools, unless the grid has nonlinear cells or a connectivity storage
+ * that cannot be shared between threads (see
+ * vtkCellArray::IsStorageShareable()).
+ *
  * @warning
  * When vtkGeometryFilter extracts cells (or boundaries of cells) it
  * will (by default) merge duplicate vertices. This may cause problems
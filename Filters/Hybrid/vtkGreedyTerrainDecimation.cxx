@@ -866,6 +866,7 @@ int vtkGreedyTerrainDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   // call reallocates the links from the points to the using triangles.
   this->Mesh->SetPoints(newPts);
   this->Mesh->SetPolys(triangles);
+  this->Mesh->EditableOn();       // the links are modified by the insertions
   this->Mesh->BuildLinks(numPts); // build cell structure; give it initial size
 
   // Update all (two) triangles connected to this mesh point. The single point
@@ -923,6 +924,7 @@ int vtkGreedyTerrainDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->TerrainError->Delete();
   delete this->TerrainInfo;
   delete this->PointInfo;
+  this->Mesh->EditableOff();
 
   newPts->Delete();
   triangles->Delete();
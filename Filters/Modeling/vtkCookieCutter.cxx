@@ -970,6 +970,7 @@ void vtkCookieCutterHelper::CropPoly(vtkIdType cellId, vtkIdType cellOffset, vtk
       }
     }
   }
+  pData->EditableOn(); // ResolveTopology() removes cell references
   pData->BuildLinks();
 
   // Check the topology of the edges and ensure that it is valid.  If there
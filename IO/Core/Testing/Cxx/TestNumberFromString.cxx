@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNumberFromString.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkNumberFromString reads the same numbers as formatted stream
+// input, and print how long both take on a large array.
+
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkNumberFromString.h"
+#include "vtkNumberToString.h"
+#include "vtkTimerLog.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+int CheckParse()
+{
+  int status = EXIT_SUCCESS;
+  const std::string valid[] = { "0", "-12", "+34", "2147483647", "-2147483648" };
+  const int expected[] = { 0, -12, 34, 2147483647, -2147483647 - 1 };
+  for (int i = 0; i < 5; ++i)
+  {
+    int value;
+    if (!vtkNumberFromString::Parse(valid[i].data(), valid[i].data() + valid[i].size(), value) ||
+      value != expected[i])
+    {
+      std::cerr << "Failed to parse " << valid[i] << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  const std::string invalid[] = { "", "-", "2147483648", "-2147483649", "1.5", "12a", "0x10" };
+  for (const std::string& word : invalid)
+  {
+    int value;
+    if (vtkNumberFromString::Parse(word.data(), word.data() + word.size(), value))
+    {
+      std::cerr << "Parsed the invalid integer \"" << word << "\"" << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  unsigned char byte;
+  const std::string big = "300";
+  if (!vtkNumberFromString::Parse(big.data(), big.data() + big.size(), byte) ||
+    byte != static_cast<unsigned char>(300))
+  {
+    std::cerr << "Characters should be parsed as int" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  const std::string floats[] = { "1.5", "-2.25e-3", ".5", "5.", "1E10", "inf", "-Infinity" };
+  const double floatsExpected[] = { 1.5, -2.25e-3, 0.5, 5., 1e10,
+    std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+  for (int i = 0; i < 7; ++i)
+  {
+    double value;
+    if (!vtkNumberFromString::Parse(floats[i].data(), floats[i].data() + floats[i].size(), value) ||
+      value != floatsExpected[i])
+    {
+      std::cerr << "Failed to parse " << floats[i] << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  double nan;
+  const std::string nanWord = "NaN";
+  if (!vtkNumberFromString::Parse(nanWord.data(), nanWord.data() + nanWord.size(), nan) ||
+    !std::isnan(nan))
+  {
+    std::cerr << "Failed to parse NaN" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  return status;
+}
+
+// Read "1 2 3</DataArray>" as XML ASCII data is: the tag must stop reading
+// without being mistaken for a number.
+int CheckStop()
+{
+  std::istringstream is("1 2\n3</DataArray>");
+  int values[5];
+  if (vtkNumberFromString::Read(is, values, 5) != 3 || !is.fail() || values[2] != 3)
+  {
+    std::cerr << "Reading should stop at the closing tag" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::istringstream partial("4 5 6 7");
+  if (vtkNumberFromString::Read(partial, values, 2) != 2 || !partial.good())
+  {
+    std::cerr << "Failed to read the first numbers of a stream" << std::endl;
+    return EXIT_FAILURE;
+  }
+  int next;
+  partial >> next;
+  if (next != 6)
+  {
+    std::cerr << "The stream should be left after the last number read" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename T>
+int CompareWithStream(const std::string& text, vtkIdType numValues, const char* name)
+{
+  vtkNew<vtkTimerLog> timer;
+  std::vector<T> expected(numValues);
+  std::istringstream reference(text);
+  timer->StartTimer();
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    reference >> expected[i];
+  }
+  timer->StopTimer();
+  const double streamTime = timer->GetElapsedTime();
+
+  std::vector<T> values(numValues);
+  std::istringstream is(text);
+  timer->StartTimer();
+  const vtkIdType numRead = vtkNumberFromString::Read(is, values.data(), numValues);
+  timer->StopTimer();
+  std::cout << "Reading " << numValues << " " << name << ": operator>> " << streamTime
+            << " s, vtkNumberFromString " << timer->GetElapsedTime() << " s" << std::endl;
+
+  if (numRead != numValues || values != expected)
+  {
+    std::cerr << "Failed to read " << name << ": " << numRead << " values read" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestNumberFromString(int, char*[])
+{
+  int status = CheckParse();
+  if (CheckStop() != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // Enough numbers to read the text by chunks.
+  const vtkIdType numValues = 1000000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  std::ostringstream ints;
+  std::ostringstream doubles;
+  vtkNumberToString convert;
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    random->Next();
+    const double value = random->GetRangeValue(-1e6, 1e6);
+    ints << static_cast<int>(value) << ((i % 9 == 8) ? "\n" : " ");
+    doubles << convert(value * 1e-3) << ((i % 9 == 8) ? "\n" : " ");
+  }
+
+  if (CompareWithStream<int>(ints.str(), numValues, "ints") != EXIT_SUCCESS ||
+    CompareWithStream<double>(doubles.str(), numValues, "doubles") != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+  return status;
+}
@@ -0,0 +1,631 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkNumberFromString.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkNumberFromString.h"
+
+#include "vtkSMPTools.h"
+
+// clang-format off
+#include "vtk_doubleconversion.h"
+#include VTK_DOUBLECONVERSION_HEADER(double-conversion.h)
+// clang-format on
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+// Numbers are read by chunks of text from seekable streams when there are
+// at least this many of them.
+const vtkIdType ChunkedReadThreshold = 1 << 16;
+const size_t ChunkSize = 1 << 22;
+
+inline bool IsSpace(int c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Characters that may be part of a number. A word ends at any other
+// character, so that "3</DataArray>" is read as 3 followed by a word that
+// is not a number.
+inline bool IsNumberChar(int c)
+{
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '.' ||
+    c == '+' || c == '-';
+}
+
+// Infinity is written "inf" by the C library and "Infinity" by
+// vtkNumberToString: the second spelling is tried when the first fails.
+const double_conversion::StringToDoubleConverter& GetConverter(bool longInfinity)
+{
+  static const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::ALLOW_CASE_INSENSIBILITY, 0.0, 0.0, "inf", "nan");
+  static const double_conversion::StringToDoubleConverter longConverter(
+    double_conversion::StringToDoubleConverter::ALLOW_CASE_INSENSIBILITY, 0.0, 0.0, "infinity",
+    "nan");
+  return longInfinity ? longConverter : converter;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool ParseInteger(const char* first, const char* last, T& value)
+{
+  typedef typename std::make_unsigned<T>::type UnsignedT;
+  bool negative = false;
+  if (first != last && (*first == '-' || *first == '+'))
+  {
+    negative = *first == '-';
+    ++first;
+  }
+  if (first == last)
+  {
+    return false;
+  }
+
+  // The largest magnitude of a value of type T with this sign. Unsigned
+  // values written with a minus sign wrap around.
+  const UnsignedT limit = std::is_signed<T>::value
+    ? static_cast<UnsignedT>(static_cast<UnsignedT>(std::numeric_limits<T>::max()) + negative)
+    : std::numeric_limits<UnsignedT>::max();
+  UnsignedT magnitude = 0;
+
+  // The first digits10 digits cannot overflow: only the following ones are
+  // checked against the limit.
+  const char* unchecked = first + std::min<std::ptrdiff_t>(last - first,
+                                    std::numeric_limits<T>::digits10);
+  for (; first != unchecked; ++first)
+  {
+    const unsigned int digit = static_cast<unsigned int>(*first) - '0';
+    if (digit > 9)
+    {
+      return false;
+    }
+    magnitude = static_cast<UnsignedT>(magnitude * 10 + digit);
+  }
+  for (; first != last; ++first)
+  {
+    const unsigned int digit = static_cast<unsigned int>(*first) - '0';
+    if (digit > 9 || magnitude > (limit - digit) / 10)
+    {
+      return false;
+    }
+    magnitude = static_cast<UnsignedT>(magnitude * 10 + digit);
+  }
+  value = static_cast<T>(negative ? static_cast<UnsignedT>(0 - magnitude) : magnitude);
+  return true;
+}
+
+// Characters are parsed as int, as VTK readers always did.
+template <typename T>
+bool ParseCharacter(const char* first, const char* last, T& value)
+{
+  int intValue;
+  if (!ParseInteger(first, last, intValue))
+  {
+    return false;
+  }
+  value = static_cast<T>(intValue);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool ParseFloatingPoint(const char* first, const char* last, T& value)
+{
+  const int length = static_cast<int>(last - first);
+  if (length <= 0)
+  {
+    return false;
+  }
+  for (bool longInfinity : { false, true })
+  {
+    int processed = 0;
+    const double_conversion::StringToDoubleConverter& converter = GetConverter(longInfinity);
+    value = std::is_same<T, float>::value
+      ? static_cast<T>(converter.StringToFloat(first, length, &processed))
+      : static_cast<T>(converter.StringToDouble(first, length, &processed));
+    if (processed == length)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Parse a word into a value of any of the types, inline.
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 1, bool>::type ParseValue(
+  const char* first, const char* last, T& value)
+{
+  return ParseCharacter(first, last, value);
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && (sizeof(T) > 1), bool>::type ParseValue(
+  const char* first, const char* last, T& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type ParseValue(
+  const char* first, const char* last, T& value)
+{
+  return ParseFloatingPoint(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+vtkIdType ReadWords(std::istream& is, T* values, vtkIdType numValues)
+{
+  typedef std::char_traits<char> Traits;
+  std::streambuf* sb = is.rdbuf();
+  std::string word;
+  vtkIdType count = 0;
+  for (; count < numValues; ++count)
+  {
+    Traits::int_type c = sb->sgetc();
+    while (!Traits::eq_int_type(c, Traits::eof()) && IsSpace(c))
+    {
+      c = sb->snextc();
+    }
+    if (Traits::eq_int_type(c, Traits::eof()))
+    {
+      is.setstate(std::ios::eofbit);
+      break;
+    }
+
+    // A character that cannot start a number is a word by itself.
+    word.clear();
+    do
+    {
+      word.push_back(Traits::to_char_type(c));
+      c = sb->snextc();
+    } while (IsNumberChar(word.back()) && !Traits::eq_int_type(c, Traits::eof()) &&
+      IsNumberChar(c));
+    if (Traits::eq_int_type(c, Traits::eof()))
+    {
+      is.setstate(std::ios::eofbit);
+    }
+
+    if (!ParseValue(word.data(), word.data() + word.size(), values[count]))
+    {
+      is.setstate(std::ios::failbit);
+      break;
+    }
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+// Parse up to maxValues words of [first, last) into values as they are
+// found, and return the number of values parsed. end is left after the last
+// word parsed, or after the first word that is not a number, in which case
+// failed is set.
+template <typename T>
+vtkIdType ParseWords(const char* first, const char* last, T* values, vtkIdType maxValues,
+  const char*& end, bool& failed)
+{
+  vtkIdType count = 0;
+  end = first;
+  while (count < maxValues)
+  {
+    while (first != last && IsSpace(*first))
+    {
+      ++first;
+    }
+    if (first == last)
+    {
+      break;
+    }
+    const char* wordEnd = first;
+    while (wordEnd != last && IsNumberChar(*wordEnd))
+    {
+      ++wordEnd;
+    }
+    if (wordEnd == first)
+    {
+      // A character that cannot start a number is a word by itself.
+      ++wordEnd;
+    }
+    end = wordEnd;
+    if (!ParseValue(first, wordEnd, values[count]))
+    {
+      failed = true;
+      break;
+    }
+    ++count;
+    first = wordEnd;
+  }
+  return count;
+}
+
+// Count the words of [first, last).
+vtkIdType CountWords(const char* first, const char* last)
+{
+  vtkIdType count = 0;
+  while (true)
+  {
+    while (first != last && IsSpace(*first))
+    {
+      ++first;
+    }
+    if (first == last)
+    {
+      return count;
+    }
+    const char* wordEnd = first;
+    while (wordEnd != last && IsNumberChar(*wordEnd))
+    {
+      ++wordEnd;
+    }
+    first = wordEnd == first ? wordEnd + 1 : wordEnd;
+    ++count;
+  }
+}
+
+// Parse the words of segments of a text concurrently. The segments start
+// and end at whitespace, so that no word is split. The words are counted
+// first to know where the values of each segment go.
+template <typename T>
+struct ParseSegmentsWorker
+{
+  const char* const* Bounds;
+  T* Values;
+  vtkIdType MaxValues;
+  std::vector<vtkIdType> Firsts;
+  std::vector<vtkIdType> Counts;
+  std::vector<const char*> Ends;
+  std::vector<char> Failed;
+  bool Counting;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (this->Counting)
+      {
+        this->Counts[i] = CountWords(this->Bounds[i], this->Bounds[i + 1]);
+        continue;
+      }
+      const vtkIdType maxValues = std::min(this->Counts[i], this->MaxValues - this->Firsts[i]);
+      if (maxValues > 0)
+      {
+        bool failed = false;
+        this->Counts[i] = ParseWords(this->Bounds[i], this->Bounds[i + 1],
+          this->Values + this->Firsts[i], maxValues, this->Ends[i], failed);
+        this->Failed[i] = failed;
+      }
+      else
+      {
+        this->Counts[i] = 0;
+      }
+    }
+  }
+};
+
+// Parse up to maxValues words of [first, last), concurrently when there
+// are several threads. Same result as ParseWords.
+template <typename T>
+vtkIdType ParseText(const char* first, const char* last, T* values, vtkIdType maxValues,
+  const char*& end, bool& failed)
+{
+  const vtkIdType numSegments =
+    std::min<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads(), (last - first) >> 16);
+  if (numSegments <= 1)
+  {
+    return ParseWords(first, last, values, maxValues, end, failed);
+  }
+
+  std::vector<const char*> bounds(numSegments + 1, last);
+  bounds[0] = first;
+  for (vtkIdType i = 1; i < numSegments; ++i)
+  {
+    const char* bound = std::max(bounds[i - 1], first + (last - first) * i / numSegments);
+    while (bound != last && !IsSpace(*bound))
+    {
+      ++bound;
+    }
+    bounds[i] = bound;
+  }
+
+  ParseSegmentsWorker<T> worker;
+  worker.Bounds = bounds.data();
+  worker.Values = values;
+  worker.MaxValues = maxValues;
+  worker.Firsts.resize(numSegments);
+  worker.Counts.resize(numSegments);
+  worker.Ends.assign(numSegments, first);
+  worker.Failed.assign(numSegments, 0);
+  worker.Counting = true;
+  vtkSMPTools::For(0, numSegments, 1, worker);
+  vtkIdType numWords = 0;
+  for (vtkIdType i = 0; i < numSegments; ++i)
+  {
+    worker.Firsts[i] = numWords;
+    numWords += worker.Counts[i];
+  }
+  worker.Counting = false;
+  vtkSMPTools::For(0, numSegments, 1, worker);
+
+  // Keep the values up to the first word that is not a number.
+  vtkIdType count = 0;
+  end = first;
+  for (vtkIdType i = 0; i < numSegments; ++i)
+  {
+    count += worker.Counts[i];
+    if (worker.Counts[i] > 0 || worker.Failed[i])
+    {
+      end = worker.Ends[i];
+    }
+    if (worker.Failed[i])
+    {
+      failed = true;
+      break;
+    }
+  }
+  return count;
+}
+
+// Read the text by large chunks, and parse the complete words of each one.
+// Only the word that a chunk may split is carried over to the next one. The
+// stream is then moved back to the end of the last word used.
+template <typename T>
+vtkIdType ReadChunks(std::istream& is, std::streampos start, T* values, vtkIdType numValues)
+{
+  std::streambuf* sb = is.rdbuf();
+  std::vector<char> text;
+
+  // The offset in the stream of the first character of the text, and the
+  // offset in the stream where reading stops.
+  std::streamoff textOffset = 0;
+  std::streamoff stop = 0;
+  size_t textSize = 0;
+  vtkIdType count = 0;
+  bool failed = false;
+  bool atEnd = false;
+  while (count < numValues && !failed && !atEnd)
+  {
+    // Append a chunk to the word left from the previous one.
+    text.resize(textSize + ChunkSize);
+    const std::streamsize numRead =
+      sb->sgetn(text.data() + textSize, static_cast<std::streamsize>(ChunkSize));
+    atEnd = numRead < static_cast<std::streamsize>(ChunkSize);
+    textSize += static_cast<size_t>(numRead);
+
+    // The last word may continue in the next chunk, unless the end of the
+    // stream is reached.
+    const char* first = text.data();
+    const char* last = first + textSize;
+    if (!atEnd)
+    {
+      while (last != first && !IsSpace(last[-1]))
+      {
+        --last;
+      }
+    }
+
+    const char* end;
+    count += ParseText(first, last, values + count, numValues - count, end, failed);
+    if (failed || count == numValues)
+    {
+      stop = textOffset + (end - first);
+    }
+    else if (atEnd)
+    {
+      stop = textOffset + static_cast<std::streamoff>(textSize);
+    }
+
+    // Keep the rest of the text for the next chunk.
+    const size_t used = static_cast<size_t>(last - first);
+    std::copy(text.begin() + used, text.begin() + textSize, text.begin());
+    textOffset += static_cast<std::streamoff>(used);
+    textSize -= used;
+  }
+
+  is.clear();
+  is.seekg(start + stop);
+  if (failed)
+  {
+    is.setstate(std::ios::failbit);
+  }
+  else if (atEnd && count < numValues)
+  {
+    is.setstate(std::ios::eofbit);
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+vtkIdType ReadValues(std::istream& is, T* values, vtkIdType numValues)
+{
+  if (!is.good() || numValues <= 0)
+  {
+    return 0;
+  }
+  if (numValues >= ChunkedReadThreshold)
+  {
+    const std::streampos start = is.tellg();
+    if (start != std::streampos(-1))
+    {
+      return ReadChunks(is, start, values, numValues);
+    }
+  }
+  return ReadWords(is, values, numValues);
+}
+
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, char& value)
+{
+  return ParseCharacter(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, signed char& value)
+{
+  return ParseCharacter(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, unsigned char& value)
+{
+  return ParseCharacter(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, short& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, unsigned short& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, int& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, unsigned int& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, long& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, unsigned long& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, long long& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, unsigned long long& value)
+{
+  return ParseInteger(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, float& value)
+{
+  return ParseFloatingPoint(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+bool vtkNumberFromString::Parse(const char* first, const char* last, double& value)
+{
+  return ParseFloatingPoint(first, last, value);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, char* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, signed char* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, unsigned char* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, short* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, unsigned short* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, int* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, unsigned int* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, long* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, unsigned long* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, long long* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(
+  std::istream& is, unsigned long long* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, float* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkNumberFromString::Read(std::istream& is, double* values, vtkIdType numValues)
+{
+  return ReadValues(is, values, numValues);
+}
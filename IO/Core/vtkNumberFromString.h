@@ -0,0 +1,103 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkNumberFromString.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkNumberFromString
+ * @brief Convert strings to floating and fixed point numbers
+ *
+ * This class parses decimal numbers independently of the locale and
+ * without the overhead of formatted stream input. Floating point numbers
+ * are converted with the double-conversion library, so that the numbers
+ * written by vtkNumberToString are read back exactly, and "inf", "infinity"
+ * and "nan" are recognized in any case. Characters are parsed as int then
+ * converted, and an unsigned integer written with a minus sign wraps around,
+ * as with formatted stream input.
+ *
+ * Read() parses whitespace separated numbers from a stream by reading its
+ * buffer directly. When many numbers are read from a seekable stream, the
+ * text is read by large chunks whose numbers are converted concurrently
+ * with vtkSMPTools.
+ *
+ * Typical use:
+ *
+ * @code{cpp}
+ *  #include "vtkNumberFromString.h"
+ *  std::vector<float> values(3 * numPoints);
+ *  if (vtkNumberFromString::Read(stream, values.data(), 3 * numPoints) != 3 * numPoints)
+ *  {
+ *    // Not enough numbers in the stream.
+ *  }
+ * @endcode
+ *
+ * @sa
+ * vtkNumberToString
+ */
+#ifndef vtkNumberFromString_h
+#define vtkNumberFromString_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkType.h"         // For vtkIdType
+
+#include <istream> // For istream
+
+class VTKIOCORE_EXPORT vtkNumberFromString
+{
+public:
+  //@{
+  /**
+   * Parse the number written in [first, last), which must not hold anything
+   * else. Returns false if it is not a valid number, or if it does not fit
+   * in the type of @a value.
+   */
+  static bool Parse(const char* first, const char* last, char& value);
+  static bool Parse(const char* first, const char* last, signed char& value);
+  static bool Parse(const char* first, const char* last, unsigned char& value);
+  static bool Parse(const char* first, const char* last, short& value);
+  static bool Parse(const char* first, const char* last, unsigned short& value);
+  static bool Parse(const char* first, const char* last, int& value);
+  static bool Parse(const char* first, const char* last, unsigned int& value);
+  static bool Parse(const char* first, const char* last, long& value);
+  static bool Parse(const char* first, const char* last, unsigned long& value);
+  static bool Parse(const char* first, const char* last, long long& value);
+  static bool Parse(const char* first, const char* last, unsigned long long& value);
+  static bool Parse(const char* first, const char* last, float& value);
+  static bool Parse(const char* first, const char* last, double& value);
+  //@}
+
+  //@{
+  /**
+   * Read up to @a numValues whitespace separated numbers from the stream
+   * into @a values, and return the number of values read. Reading stops at
+   * the end of the stream, or at the first word that is not a number, which
+   * is consumed and sets the failbit of the stream. Otherwise, the stream is
+   * left right after the last number read.
+   */
+  static vtkIdType Read(std::istream& is, char* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, signed char* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, unsigned char* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, short* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, unsigned short* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, int* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, unsigned int* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, long* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, unsigned long* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, long long* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, unsigned long long* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, float* values, vtkIdType numValues);
+  static vtkIdType Read(std::istream& is, double* values, vtkIdType numValues);
+  //@}
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkNumberFromString.h
@@ -0,0 +1,250 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMerging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that merging the points of STL files without a locator gives the
+// same points and triangles as merging them with vtkMergePoints.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkMergePoints.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Facets of a grid of triangles sharing their vertices, with signed zeros,
+// a NaN coordinate and a triangle degenerated by merging.
+std::vector<float> MakeFacets(int resolution)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  std::vector<float> heights((resolution + 1) * (resolution + 1));
+  for (float& height : heights)
+  {
+    random->Next();
+    height = static_cast<float>(random->GetRangeValue(-1.0, 1.0));
+  }
+  heights[0] = 0.0f;
+  heights[1] = -0.0f;
+
+  std::vector<float> facets;
+  auto addVertex = [&](int i, int j) {
+    facets.push_back(static_cast<float>(i));
+    facets.push_back(static_cast<float>(j));
+    facets.push_back(heights[j * (resolution + 1) + i]);
+  };
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      addVertex(i, j);
+      addVertex(i + 1, j);
+      addVertex(i + 1, j + 1);
+      addVertex(i, j);
+      addVertex(i + 1, j + 1);
+      addVertex(i, j + 1);
+    }
+  }
+  // Signed zeros are merged, NaN are never merged.
+  const float zeros[9] = { 0.0f, 0.0f, -0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float nans[9] = { nan, 0.0f, 0.0f, nan, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  const float degenerate[9] = { 1.0f, 0.0f, 7.0f, 1.0f, 0.0f, 7.0f, 2.0f, 0.0f, 7.0f };
+  facets.insert(facets.end(), zeros, zeros + 9);
+  facets.insert(facets.end(), nans, nans + 9);
+  facets.insert(facets.end(), degenerate, degenerate + 9);
+  return facets;
+}
+
+void WriteBinary(const std::string& fileName, const std::vector<float>& facets)
+{
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  char header[80] = "binary STL written by TestSTLReaderMerging";
+  file.write(header, 80);
+  const unsigned int numFacets = static_cast<unsigned int>(facets.size() / 9);
+  unsigned char count[4] = { static_cast<unsigned char>(numFacets),
+    static_cast<unsigned char>(numFacets >> 8), static_cast<unsigned char>(numFacets >> 16),
+    static_cast<unsigned char>(numFacets >> 24) };
+  file.write(reinterpret_cast<char*>(count), 4);
+  for (unsigned int i = 0; i < numFacets; ++i)
+  {
+    // Little endian floats, as on the machines this test runs on.
+    unsigned char facet[50] = { 0 };
+    std::memcpy(facet + 12, facets.data() + 9 * i, 9 * sizeof(float));
+    file.write(reinterpret_cast<char*>(facet), 50);
+  }
+}
+
+void WriteASCII(const std::string& fileName, const std::vector<float>& facets)
+{
+  std::ofstream file(fileName.c_str());
+  const size_t numFacets = facets.size() / 9;
+  for (size_t i = 0; i < numFacets; ++i)
+  {
+    // Two solids, to tag the triangles with scalars.
+    if (i == 0 || i == numFacets / 2)
+    {
+      file << "solid part" << (i == 0 ? 0 : 1) << "\n";
+    }
+    file << "facet normal 0 0 1\nouter loop\n";
+    for (int j = 0; j < 3; ++j)
+    {
+      const float* x = facets.data() + 9 * i + 3 * j;
+      file << "vertex " << x[0] << " " << x[1] << " " << x[2] << "\n";
+    }
+    file << "endloop\nendfacet\n";
+    if (i + 1 == numFacets / 2 || i + 1 == numFacets)
+    {
+      file << "endsolid\n";
+    }
+  }
+}
+
+bool SamePoint(const double* x, const double* y)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (x[i] != y[i] && !(std::isnan(x[i]) && std::isnan(y[i])))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfPolys() != expected->GetNumberOfPolys())
+  {
+    std::cerr << "Read " << output->GetNumberOfPoints() << " points and "
+              << output->GetNumberOfPolys() << " triangles instead of "
+              << expected->GetNumberOfPoints() << " and " << expected->GetNumberOfPolys()
+              << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    if (!SamePoint(output->GetPoint(i), expected->GetPoint(i)))
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdList> expectedIds;
+  for (vtkIdType i = 0; i < output->GetNumberOfPolys(); ++i)
+  {
+    output->GetPolys()->GetCellAtId(i, ids);
+    expected->GetPolys()->GetCellAtId(i, expectedIds);
+    for (vtkIdType j = 0; j < 3; ++j)
+    {
+      if (ids->GetNumberOfIds() != 3 || ids->GetId(j) != expectedIds->GetId(j))
+      {
+        std::cerr << "Triangle " << i << " differs" << std::endl;
+        return false;
+      }
+    }
+  }
+  vtkDataArray* scalars = output->GetCellData()->GetScalars();
+  vtkDataArray* expectedScalars = expected->GetCellData()->GetScalars();
+  if ((scalars == nullptr) != (expectedScalars == nullptr))
+  {
+    std::cerr << "Scalars differ" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; scalars && i < scalars->GetNumberOfTuples(); ++i)
+  {
+    if (scalars->GetTuple1(i) != expectedScalars->GetTuple1(i))
+    {
+      std::cerr << "Scalar " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareWithLocator(const std::string& fileName, bool scalarTags)
+{
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetScalarTags(scalarTags);
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  const double sortTime = timer->GetElapsedTime();
+
+  vtkNew<vtkSTLReader> locatorReader;
+  locatorReader->SetFileName(fileName.c_str());
+  locatorReader->SetScalarTags(scalarTags);
+  vtkNew<vtkMergePoints> locator;
+  locatorReader->SetLocator(locator);
+  timer->StartTimer();
+  locatorReader->Update();
+  timer->StopTimer();
+  std::cout << fileName << ": " << sortTime << " s merging by hashing, "
+            << timer->GetElapsedTime() << " s with vtkMergePoints" << std::endl;
+
+  return SameOutput(reader->GetOutput(), locatorReader->GetOutput());
+}
+}
+
+int TestSTLReaderMerging(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string binaryFileName = std::string(tempDir) + "/TestSTLReaderMergingBinary.stl";
+  const std::string asciiFileName = std::string(tempDir) + "/TestSTLReaderMergingASCII.stl";
+  delete[] tempDir;
+
+  const std::vector<float> facets = MakeFacets(300);
+  WriteBinary(binaryFileName, facets);
+  WriteASCII(asciiFileName, facets);
+
+  if (!CompareWithLocator(binaryFileName, false) || !CompareWithLocator(asciiFileName, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Without merging, each facet has its own points.
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(binaryFileName.c_str());
+  reader->MergingOff();
+  reader->Update();
+  const vtkIdType numFacets = static_cast<vtkIdType>(facets.size() / 9);
+  vtkPolyData* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != 3 * numFacets || output->GetNumberOfPolys() != numFacets ||
+    output->GetPoint(3 * numFacets - 1)[2] != 7.0)
+  {
+    std::cerr << "Wrong output without merging" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
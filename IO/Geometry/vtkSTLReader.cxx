@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,6 +27,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -33,7 +35,10 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -79,6 +84,417 @@ vtkMTimeType vtkSTLReader::GetMTime()
   return mTime1;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Copy the vertices of binary facets, skipping their normal and attribute,
+// and convert them from little endian.
+struct vtkSTLDecodeFacets
+{
+  const unsigned char* Facets;
+  float* Coords;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      memcpy(this->Coords + 9 * i, this->Facets + 50 * i + 12, 9 * sizeof(float));
+    }
+    vtkByteSwap::Swap4LERange(this->Coords + 9 * begin, 9 * static_cast<size_t>(end - begin));
+  }
+};
+
+// Fill an array with multiples of Step, to build the offsets and the
+// connectivity of triangles using consecutive points.
+struct vtkSTLSequence
+{
+  vtkIdType* Values;
+  vtkIdType Step;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Values[i] = this->Step * i;
+    }
+  }
+};
+
+// Points are merged when their float coordinates compare equal, as with
+// vtkMergePoints: -0 is 0, and points with a NaN coordinate are unique. Once
+// -0 is replaced by 0, equal points have the same coordinate bits.
+struct vtkSTLPointBits
+{
+  vtkTypeUInt32 X[3];
+
+  vtkSTLPointBits() = default;
+  explicit vtkSTLPointBits(const float* x)
+  {
+    memcpy(this->X, x, sizeof(this->X));
+    for (int j = 0; j < 3; ++j)
+    {
+      if (this->X[j] == 0x80000000)
+      {
+        this->X[j] = 0;
+      }
+    }
+  }
+
+  bool SamePoint(const vtkSTLPointBits& other) const
+  {
+    return this->X[0] == other.X[0] && this->X[1] == other.X[1] && this->X[2] == other.X[2] &&
+      (this->X[0] & 0x7fffffff) <= 0x7f800000 && (this->X[1] & 0x7fffffff) <= 0x7f800000 &&
+      (this->X[2] & 0x7fffffff) <= 0x7f800000;
+  }
+
+  vtkTypeUInt64 Hash() const
+  {
+    vtkTypeUInt64 hash = 0;
+    for (int j = 0; j < 3; ++j)
+    {
+      hash = (hash ^ this->X[j]) * 0x9e3779b97f4a7c15ULL;
+    }
+    // Mix the bits so that both the high bits, which select the partition,
+    // and the low bits, which select the slot in its hash table, depend on
+    // all the coordinates.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    return hash ^ (hash >> 33);
+  }
+};
+
+// A point to merge, with the hash of its coordinates. The hash is stored
+// as two halves and ids are 32-bit when possible, so that an entry takes
+// 12 bytes.
+template <typename IdType>
+struct vtkSTLPointEntry
+{
+  vtkTypeUInt32 HashLow;
+  vtkTypeUInt32 HashHigh;
+  IdType Id;
+
+  bool SameHash(const vtkSTLPointEntry& other) const
+  {
+    return this->HashLow == other.HashLow && this->HashHigh == other.HashHigh;
+  }
+};
+
+// The points are partitioned by the high bits of their hash. Each
+// partition is merged independently with a hash table of its own.
+const int vtkSTLPartitionBits = 8;
+const int vtkSTLPartitionShift = 64 - vtkSTLPartitionBits;
+const vtkIdType vtkSTLNumberOfPartitions = 1 << vtkSTLPartitionBits;
+
+// Hash the points of consecutive blocks of points, and count the points of
+// each block that fall in each partition. The hashes are stored in the
+// array that later maps the points.
+struct vtkSTLCountPartitions
+{
+  const float* Coords;
+  vtkIdType NumberOfPoints;
+  vtkIdType BlockSize;
+  vtkIdType* Hashes;
+  vtkIdType* Counts;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      vtkIdType* counts = this->Counts + block * vtkSTLNumberOfPartitions;
+      const vtkIdType last = std::min(this->NumberOfPoints, (block + 1) * this->BlockSize);
+      for (vtkIdType i = block * this->BlockSize; i < last; ++i)
+      {
+        const vtkTypeUInt64 hash = vtkSTLPointBits(this->Coords + 3 * i).Hash();
+        this->Hashes[i] = static_cast<vtkIdType>(hash);
+        ++counts[hash >> vtkSTLPartitionShift];
+      }
+    }
+  }
+};
+
+// Copy the points of each block to the positions reserved for the block in
+// each partition, so that the points of a partition keep their order.
+template <typename IdType>
+struct vtkSTLScatterPartitions
+{
+  vtkIdType NumberOfPoints;
+  vtkIdType BlockSize;
+  const vtkIdType* Hashes;
+  vtkIdType* Next;
+  vtkSTLPointEntry<IdType>* Entries;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      vtkIdType* next = this->Next + block * vtkSTLNumberOfPartitions;
+      const vtkIdType last = std::min(this->NumberOfPoints, (block + 1) * this->BlockSize);
+      for (vtkIdType i = block * this->BlockSize; i < last; ++i)
+      {
+        const vtkTypeUInt64 hash = static_cast<vtkTypeUInt64>(this->Hashes[i]);
+        vtkSTLPointEntry<IdType>& entry = this->Entries[next[hash >> vtkSTLPartitionShift]++];
+        entry.HashLow = static_cast<vtkTypeUInt32>(hash);
+        entry.HashHigh = static_cast<vtkTypeUInt32>(hash >> 32);
+        entry.Id = static_cast<IdType>(i);
+      }
+    }
+  }
+};
+
+// Map each point to the first point of its partition that it is equal to.
+// The points of each partition are sorted by increasing index. The map
+// overwrites the hashes of the points, which the entries hold.
+//
+// Points are first merged when their hashes are equal, without reading
+// their coordinates, which are far apart in a partition. The merged points
+// are then checked in order, and the partitions where hashes collide are
+// merged again, only those, comparing the coordinates.
+template <typename IdType>
+struct vtkSTLMergePartitions
+{
+  const float* Coords;
+  const vtkIdType* PartitionOffsets;
+  const vtkSTLPointEntry<IdType>* Entries;
+  vtkIdType* PointMap;
+  // The partitions to merge again comparing coordinates, or nullptr to
+  // merge all of them comparing hashes.
+  const unsigned char* Exact;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    // Open addressing table of the positions of the distinct points, in
+    // the partition.
+    const IdType empty = static_cast<IdType>(-1);
+    std::vector<IdType> table;
+    for (vtkIdType partition = begin; partition < end; ++partition)
+    {
+      if (this->Exact && !this->Exact[partition])
+      {
+        continue;
+      }
+      const vtkIdType first = this->PartitionOffsets[partition];
+      const vtkIdType last = this->PartitionOffsets[partition + 1];
+      vtkTypeUInt32 tableSize = 1;
+      while (tableSize < 2 * (last - first))
+      {
+        tableSize <<= 1;
+      }
+      table.assign(tableSize, empty);
+      const vtkTypeUInt32 mask = tableSize - 1;
+      const vtkSTLPointEntry<IdType>* entries = this->Entries + first;
+      for (vtkIdType k = 0; k < last - first; ++k)
+      {
+        const vtkSTLPointEntry<IdType>& entry = entries[k];
+        vtkTypeUInt32 slot = entry.HashLow & mask;
+        for (; table[slot] != empty; slot = (slot + 1) & mask)
+        {
+          const vtkSTLPointEntry<IdType>& other = entries[table[slot]];
+          if (other.SameHash(entry) &&
+            (!this->Exact ||
+              vtkSTLPointBits(this->Coords + 3 * static_cast<vtkIdType>(entry.Id))
+                .SamePoint(vtkSTLPointBits(this->Coords + 3 * static_cast<vtkIdType>(other.Id)))))
+          {
+            break;
+          }
+        }
+        if (table[slot] == empty)
+        {
+          table[slot] = static_cast<IdType>(k);
+        }
+        this->PointMap[entry.Id] = static_cast<vtkIdType>(entries[table[slot]].Id);
+      }
+    }
+  }
+};
+
+// Check that the points of consecutive blocks of points are equal to the
+// points they were merged with, and flag the partitions of those that are
+// not.
+struct vtkSTLCheckMergedPoints
+{
+  const float* Coords;
+  vtkIdType NumberOfPoints;
+  vtkIdType BlockSize;
+  const vtkIdType* PointMap;
+  unsigned char* Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      unsigned char* failed = this->Failed + block * vtkSTLNumberOfPartitions;
+      const vtkIdType last = std::min(this->NumberOfPoints, (block + 1) * this->BlockSize);
+      for (vtkIdType i = block * this->BlockSize; i < last; ++i)
+      {
+        const vtkIdType merged = this->PointMap[i];
+        const vtkSTLPointBits bits(this->Coords + 3 * i);
+        if (merged != i && !bits.SamePoint(vtkSTLPointBits(this->Coords + 3 * merged)))
+        {
+          failed[bits.Hash() >> vtkSTLPartitionShift] = 1;
+        }
+      }
+    }
+  }
+};
+
+struct vtkSTLCopyMergedPoints
+{
+  const float* Coords;
+  const vtkIdType* Firsts;
+  float* MergedCoords;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      memcpy(this->MergedCoords + 3 * i, this->Coords + 3 * this->Firsts[i], 3 * sizeof(float));
+    }
+  }
+};
+
+// Scatter the hashed points in their partitions, and merge them. The
+// hashes are replaced by the map of the points.
+template <typename IdType>
+void vtkSTLMapPoints(const float* coords, vtkIdType numPts, vtkIdType numBlocks,
+  vtkIdType blockSize, const vtkIdType* partitionOffsets, vtkIdType* next, vtkIdType* pointMap)
+{
+  std::unique_ptr<vtkSTLPointEntry<IdType>[]> entries(new vtkSTLPointEntry<IdType>[numPts]);
+  vtkSTLScatterPartitions<IdType> scatterPartitions{ numPts, blockSize, pointMap, next,
+    entries.get() };
+  vtkSMPTools::For(0, numBlocks, 1, scatterPartitions);
+  vtkSTLMergePartitions<IdType> mergePartitions{ coords, partitionOffsets, entries.get(),
+    pointMap, nullptr };
+  vtkSMPTools::For(0, vtkSTLNumberOfPartitions, 1, mergePartitions);
+
+  std::vector<unsigned char> failed(numBlocks * vtkSTLNumberOfPartitions, 0);
+  vtkSTLCheckMergedPoints checkPoints{ coords, numPts, blockSize, pointMap, failed.data() };
+  vtkSMPTools::For(0, numBlocks, 1, checkPoints);
+  std::vector<unsigned char> exact(vtkSTLNumberOfPartitions, 0);
+  bool collisions = false;
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    for (vtkIdType partition = 0; partition < vtkSTLNumberOfPartitions; ++partition)
+    {
+      if (failed[block * vtkSTLNumberOfPartitions + partition])
+      {
+        exact[partition] = 1;
+        collisions = true;
+      }
+    }
+  }
+  if (collisions)
+  {
+    mergePartitions.Exact = exact.data();
+    vtkSMPTools::For(0, vtkSTLNumberOfPartitions, 1, mergePartitions);
+  }
+}
+
+// Merge the coincident points of triangles whose points are consecutive,
+// as the ASCII and binary readers insert them, by hashing the points
+// concurrently instead of inserting them one by one in a locator. Points are numbered
+// in the order of their first use, and triangles that become degenerate are
+// removed, so that the output is the same as with vtkMergePoints.
+void vtkSTLMergePoints(vtkPoints* newPts, vtkFloatArray* newScalars, vtkPoints* mergedPts,
+  vtkCellArray* mergedPolys, vtkFloatArray* mergedScalars)
+{
+  const vtkIdType numPts = newPts->GetNumberOfPoints();
+  const float* coords = static_cast<const float*>(newPts->GetVoidPointer(0));
+
+  // Hash the points, and sort them by partition, keeping their order
+  // within each partition. Blocks of points are counted and copied
+  // concurrently.
+  const vtkIdType numBlocks = std::max<vtkIdType>(1, std::min<vtkIdType>(64, numPts / 4096));
+  const vtkIdType blockSize = (numPts + numBlocks - 1) / numBlocks;
+  std::vector<vtkIdType> pointMap(numPts);
+  std::vector<vtkIdType> counts(numBlocks * vtkSTLNumberOfPartitions, 0);
+  vtkSTLCountPartitions countPartitions{ coords, numPts, blockSize, pointMap.data(),
+    counts.data() };
+  vtkSMPTools::For(0, numBlocks, 1, countPartitions);
+
+  // Turn the counts into the position of the first point of each block in
+  // each partition.
+  std::vector<vtkIdType> partitionOffsets(vtkSTLNumberOfPartitions + 1);
+  vtkIdType position = 0;
+  for (vtkIdType partition = 0; partition < vtkSTLNumberOfPartitions; ++partition)
+  {
+    partitionOffsets[partition] = position;
+    for (vtkIdType block = 0; block < numBlocks; ++block)
+    {
+      vtkIdType& count = counts[block * vtkSTLNumberOfPartitions + partition];
+      const vtkIdType blockCount = count;
+      count = position;
+      position += blockCount;
+    }
+  }
+  partitionOffsets[vtkSTLNumberOfPartitions] = position;
+
+  // Map each point to the first point it is merged with, merging the
+  // partitions concurrently, then number the merged points in the order of
+  // their first use.
+  if (numPts <= static_cast<vtkIdType>(VTK_UNSIGNED_INT_MAX))
+  {
+    vtkSTLMapPoints<vtkTypeUInt32>(coords, numPts, numBlocks, blockSize, partitionOffsets.data(),
+      counts.data(), pointMap.data());
+  }
+  else
+  {
+    vtkSTLMapPoints<vtkIdType>(coords, numPts, numBlocks, blockSize, partitionOffsets.data(),
+      counts.data(), pointMap.data());
+  }
+
+  std::vector<vtkIdType> firsts;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (pointMap[i] == i)
+    {
+      pointMap[i] = static_cast<vtkIdType>(firsts.size());
+      firsts.push_back(i);
+    }
+    else
+    {
+      pointMap[i] = pointMap[pointMap[i]];
+    }
+  }
+
+  const vtkIdType numMergedPts = static_cast<vtkIdType>(firsts.size());
+  mergedPts->SetDataTypeToFloat();
+  mergedPts->SetNumberOfPoints(numMergedPts);
+  vtkSTLCopyMergedPoints copyPoints{ coords, firsts.data(),
+    static_cast<float*>(mergedPts->GetVoidPointer(0)) };
+  vtkSMPTools::For(0, numMergedPts, copyPoints);
+
+  // Keep the triangles whose three points are still distinct.
+  const vtkIdType numTris = numPts / 3;
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numPts);
+  vtkIdType* offset = offsets->GetPointer(0);
+  vtkIdType* nodes = connectivity->GetPointer(0);
+  vtkIdType numMergedTris = 0;
+  for (vtkIdType i = 0; i < numTris; ++i)
+  {
+    const vtkIdType* tri = pointMap.data() + 3 * i;
+    if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
+    {
+      offset[numMergedTris] = 3 * numMergedTris;
+      std::copy(tri, tri + 3, nodes + 3 * numMergedTris);
+      ++numMergedTris;
+      if (newScalars)
+      {
+        mergedScalars->InsertNextValue(newScalars->GetValue(i));
+      }
+    }
+  }
+  offset[numMergedTris] = 3 * numMergedTris;
+  offsets->SetNumberOfValues(numMergedTris + 1);
+  connectivity->SetNumberOfValues(3 * numMergedTris);
+  mergedPolys->SetData(offsets, connectivity);
+}
+}
+
 //------------------------------------------------------------------------------
 int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
@@ -159,44 +575,55 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   if (this->Merging)
   {
     mergedPts = vtkSmartPointer<vtkPoints>::New();
-    mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
     mergedPolys = vtkSmartPointer<vtkCellArray>::New();
-    mergedPolys->AllocateCopy(newPolys);
     if (newScalars)
     {
       mergedScalars = vtkSmartPointer<vtkFloatArray>::New();
       mergedScalars->Allocate(newPolys->GetNumberOfCells());
     }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
-    if (this->Locator == nullptr)
+    // Without a user locator, points are merged as vtkMergePoints would
+    // merge them, but by hashing them concurrently.
+    if (this->Locator == nullptr && newPts->GetDataType() == VTK_FLOAT &&
+      newPts->GetNumberOfPoints() == 3 * newPolys->GetNumberOfCells())
     {
-      locator.TakeReference(this->NewDefaultLocator());
+      vtkSTLMergePoints(newPts, newScalars, mergedPts, mergedPolys, mergedScalars);
     }
-    locator->InitPointInsertion(mergedPts, newPts->GetBounds());
-
-    int nextCell = 0;
-    const vtkIdType* pts = nullptr;
-    vtkIdType npts;
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
+    else
     {
-      vtkIdType nodes[3];
-      for (int i = 0; i < 3; i++)
+      mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
+      mergedPolys->AllocateCopy(newPolys);
+
+      vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
+      if (this->Locator == nullptr)
       {
-        double x[3];
-        newPts->GetPoint(pts[i], x);
-        locator->InsertUniquePoint(x, nodes[i]);
+        locator.TakeReference(this->NewDefaultLocator());
       }
+      locator->InitPointInsertion(mergedPts, newPts->GetBounds());
 
-      if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
+      int nextCell = 0;
+      const vtkIdType* pts = nullptr;
+      vtkIdType npts;
+      for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
       {
-        mergedPolys->InsertNextCell(3, nodes);
-        if (newScalars)
+        vtkIdType nodes[3];
+        for (int i = 0; i < 3; i++)
         {
-          mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          double x[3];
+          newPts->GetPoint(pts[i], x);
+          locator->InsertUniquePoint(x, nodes[i]);
         }
+
+        if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
+        {
+          mergedPolys->InsertNextCell(3, nodes);
+          if (newScalars)
+          {
+            mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          }
+        }
+        nextCell++;
       }
-      nextCell++;
     }
 
     vtkDebugMacro(<< "Merged to: " << mergedPts->GetNumberOfPoints() << " points, "
@@ -225,13 +652,6 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
 //------------------------------------------------------------------------------
 bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newPolys)
 {
-  struct facet_t_t
-  {
-    float n[3], v1[3], v2[3], v3[3];
-    unsigned short junk;
-  };
-  using facet_t = struct facet_t_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -272,54 +692,50 @@ bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newP
     vtkDebugMacro(<< "Bad binary count: attempting to correct(" << numTris << ")");
   }
 
-  // Verify the numTris with the length of the file
-  unsigned long ulFileLength = vtksys::SystemTools::FileLength(this->FileName);
-  ulFileLength -= (80 + 4); // 80 byte - header, 4 byte - tringle count
-  ulFileLength /=
-    50; // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
-
-  if (numTris < static_cast<int>(ulFileLength))
-  {
-    numTris = static_cast<int>(ulFileLength);
-  }
-
-  // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris * 3);
-  newPolys->AllocateEstimate(numTris, 3);
-
-  facet_t facet;
-  for (int i = 0; fread(&facet, 50, 1, fp) > 0; i++)
+  // The number of facets is given by the length of the file:
+  // 80 byte - header, 4 byte - triangle count, then 50 byte per facet -
+  // twelve 32-bit-floating point numbers + 2 byte for attribute byte count
+  const vtkIdType fileLength =
+    static_cast<vtkIdType>(vtksys::SystemTools::FileLength(this->FileName));
+  const vtkIdType numFacets = std::max<vtkIdType>(fileLength - (80 + 4), 0) / 50;
+
+  // Read the facets by large blocks, and decode the vertices of each block
+  // concurrently. Incomplete facets at the end of the file are ignored.
+  const vtkIdType blockSize = 1 << 16;
+  std::vector<unsigned char> block(50 * static_cast<size_t>(std::min(numFacets, blockSize)));
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(3 * numFacets);
+  float* coords = static_cast<float*>(newPts->GetVoidPointer(0));
+  vtkIdType numRead = 0;
+  while (numRead < numFacets)
   {
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n + 1);
-    vtkByteSwap::Swap4LE(facet.n + 2);
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1 + 1);
-    vtkByteSwap::Swap4LE(facet.v1 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2 + 1);
-    vtkByteSwap::Swap4LE(facet.v2 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3 + 1);
-    vtkByteSwap::Swap4LE(facet.v3 + 2);
-
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
-
-    if ((i % 100000) == 0 && i != 0)
+    const vtkIdType numBlockFacets = static_cast<vtkIdType>(
+      fread(block.data(), 50, static_cast<size_t>(std::min(numFacets - numRead, blockSize)), fp));
+    if (numBlockFacets == 0)
     {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTris);
+      break;
     }
+    vtkSTLDecodeFacets decode{ block.data(), coords + 9 * numRead };
+    vtkSMPTools::For(0, numBlockFacets, decode);
+    numRead += numBlockFacets;
+    this->UpdateProgress(static_cast<double>(numRead) / numFacets);
+  }
+  if (numRead < numFacets)
+  {
+    newPts->SetNumberOfPoints(3 * numRead);
   }
 
+  // Each facet uses its own three points.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numRead + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numRead);
+  vtkSTLSequence offsetSequence{ offsets->GetPointer(0), 3 };
+  vtkSMPTools::For(0, numRead + 1, offsetSequence);
+  vtkSTLSequence connectivitySequence{ connectivity->GetPointer(0), 1 };
+  vtkSMPTools::For(0, 3 * numRead, connectivitySequence);
+  newPolys->SetData(offsets, connectivity);
+
   return true;
 }
 
@@ -27,6 +27,11 @@
  * however, merging requires a large amount of temporary storage since a
  * 3D hash table must be constructed.
  *
+ * Binary files are read by large blocks whose facets are decoded
+ * concurrently. When no locator is set, coincident points are merged by
+ * hashing them concurrently with vtkSMPTools, which gives the same points
+ * and triangles as vtkMergePoints.
+ *
  * @warning
  * Binary files written on one system may not be readable on other systems.
  * vtkSTLWriter uses VAX or PC byte ordering and swaps bytes on other systems.
@@ -80,8 +85,9 @@ public:
 
   //@{
   /**
-   * Specify a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Specify a spatial locator for merging points. By default, points are
+   * merged exactly as with an instance of vtkMergePoints, but without
+   * inserting them one by one in a locator.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
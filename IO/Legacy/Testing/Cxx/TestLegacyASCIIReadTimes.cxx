@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIReadTimes.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Times vtkStructuredPointsReader on ASCII files of a million ints and a
+// million doubles, against operator>> on the values of the same files, and
+// checks the values read.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStructuredPoints.h"
+#include "vtkStructuredPointsReader.h"
+#include "vtkStructuredPointsWriter.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Read the values of the scalars of the file, after its header, with
+// operator>>, and return the time taken.
+template <typename T>
+double ReadWithStream(const std::string& fileName, vtkIdType numValues, std::vector<T>& values)
+{
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  std::ifstream is(fileName.c_str());
+  std::string line;
+  while (std::getline(is, line) && line.compare(0, 12, "LOOKUP_TABLE") != 0)
+  {
+  }
+  values.resize(numValues);
+  for (vtkIdType i = 0; i < numValues && is >> values[i]; ++i)
+  {
+  }
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+template <typename T>
+int TimeRead(vtkDataArray* array, const std::string& fileName, const char* name)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(100, 100, 100);
+  array->SetName("values");
+  image->GetPointData()->SetScalars(array);
+  vtkNew<vtkStructuredPointsWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  std::vector<T> expected;
+  const double streamTime = ReadWithStream(fileName, array->GetNumberOfValues(), expected);
+
+  vtkNew<vtkStructuredPointsReader> reader;
+  reader->SetFileName(fileName.c_str());
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  std::cout << "Reading " << array->GetNumberOfValues() << " " << name << ": operator>> "
+            << streamTime << " s, vtkStructuredPointsReader " << timer->GetElapsedTime() << " s"
+            << std::endl;
+
+  vtkDataArray* values = reader->GetOutput()->GetPointData()->GetScalars();
+  if (!values || values->GetNumberOfValues() != array->GetNumberOfValues())
+  {
+    std::cerr << "Failed to read the " << name << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < values->GetNumberOfValues(); ++i)
+  {
+    if (values->GetComponent(i, 0) != static_cast<double>(expected[i]))
+    {
+      std::cerr << "Wrong value " << values->GetComponent(i, 0) << " instead of " << expected[i]
+                << " for " << name << " " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestLegacyASCIIReadTimes(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestLegacyASCIIReadTimes";
+  delete[] tempDir;
+
+  // The times are only reported.
+  const vtkIdType numValues = 1000000;
+  vtkNew<vtkIntArray> ints;
+  vtkNew<vtkDoubleArray> doubles;
+  ints->SetNumberOfValues(numValues);
+  doubles->SetNumberOfValues(numValues);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    ints->SetValue(i, static_cast<int>((i * 7919) % 2000000 - 1000000));
+    doubles->SetValue(i, 1e3 * std::sin(0.001 * i));
+  }
+  if (TimeRead<int>(ints, prefix + "Ints.vtk", "ints") != EXIT_SUCCESS ||
+    TimeRead<double>(doubles, prefix + "Doubles.vtk", "doubles") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
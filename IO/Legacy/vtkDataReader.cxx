@@ -41,6 +41,7 @@
 #include "vtkLegacyReaderVersion.h"
 #include "vtkLongArray.h"
 #include "vtkLookupTable.h"
+#include "vtkNumberFromString.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
@@ -297,132 +298,66 @@ int vtkDataReader::ReadString(char result[256])
   return 1;
 }
 
-// Internal function to read in an integer value.
+// Internal function to read in a value.
 // Returns zero if there was an error.
 int vtkDataReader::Read(char* result)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-
-  *result = (char)intData;
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(unsigned char* result)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-
-  *result = (unsigned char)intData;
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(short* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(unsigned short* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(int* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(unsigned int* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(long* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(unsigned long* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(long long* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(unsigned long long* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(float* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 int vtkDataReader::Read(double* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return vtkNumberFromString::Read(*this->IS, result, 1) == 1;
 }
 
 size_t vtkDataReader::Peek(char* str, size_t n)
@@ -1494,19 +1429,12 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
-  vtkIdType i, j;
-
-  for (i = 0; i < numTuples; i++)
+  vtkIdType numValues = numTuples * numComp;
+  if (vtkNumberFromString::Read(*self->GetIStream(), data, numValues) != numValues)
   {
-    for (j = 0; j < numComp; j++)
-    {
-      if (!self->Read(data++))
-      {
-        vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
-                                  "datasize with declaration.");
-        return 0;
-      }
-    }
+    vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
+                              "datasize with declaration.");
+    return 0;
   }
   return 1;
 }
@@ -3205,7 +3133,6 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3223,15 +3150,12 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    if (vtkNumberFromString::Read(*this->IS, data, size) != size)
     {
-      if (!this->Read(data + i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<< "Error reading ascii cell data!"
-                      << " for file: " << (fname ? fname : "(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<< "Error reading ascii cell data!"
+                    << " for file: " << (fname ? fname : "(Null FileName)"));
+      return 0;
     }
   }
 
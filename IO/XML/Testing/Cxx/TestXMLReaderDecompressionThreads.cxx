@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReaderDecompressionThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that decompressing blocks concurrently reads the same arrays as
+// decompressing them one after another, for each compressor and data mode.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool SameArray(vtkDataArray* read, vtkDataArray* expected)
+{
+  if (!read || read->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    read->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    const int comps = expected->GetNumberOfComponents();
+    if (read->GetComponent(i / comps, i % comps) != expected->GetComponent(i / comps, i % comps))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLReaderDecompressionThreads(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  vtkNew<vtkDoubleArray> wave;
+  wave->SetName("wave");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    wave->InsertNextValue(std::sin(0.01 * i));
+    ids->InsertNextTuple2(i, i % 7);
+  }
+  image->GetPointData()->AddArray(wave);
+  image->GetPointData()->AddArray(ids);
+
+  const int compressors[3] = { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::LZMA };
+  const int dataModes[2] = { vtkXMLWriter::Binary, vtkXMLWriter::Appended };
+  for (int compressor : compressors)
+  {
+    for (int dataMode : dataModes)
+    {
+      vtkNew<vtkXMLImageDataWriter> writer;
+      writer->SetInputData(image);
+      writer->WriteToOutputStringOn();
+      writer->SetCompressorType(compressor);
+      writer->SetDataMode(dataMode);
+      writer->SetBlockSize(1000);
+      writer->Write();
+
+      for (int numThreads : { 1, 0, 2, 3, 8 })
+      {
+        vtkNew<vtkXMLImageDataReader> reader;
+        reader->ReadFromInputStringOn();
+        reader->SetInputString(writer->GetOutputString());
+        reader->SetNumberOfDecompressionThreads(numThreads);
+        reader->Update();
+        vtkPointData* pd = reader->GetOutput()->GetPointData();
+        if (!SameArray(pd->GetArray("wave"), wave) || !SameArray(pd->GetArray("ids"), ids))
+        {
+          std::cerr << "Compressor " << compressor << ", data mode " << dataMode << ": "
+                    << numThreads << " threads do not read the arrays written" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReaderMemoryMap.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the arrays of raw appended data are views of the memory mapping
+// of the file, that they hold the same values as arrays read from the file,
+// and that they outlive the reader.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+bool SameArray(vtkDataArray* read, vtkDataArray* expected)
+{
+  if (!read || read->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    read->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int comps = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (read->GetComponent(i / comps, i % comps) != expected->GetComponent(i / comps, i % comps))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameArrays(vtkImageData* read, vtkImageData* expected)
+{
+  vtkPointData* pd = read->GetPointData();
+  vtkPointData* expectedPD = expected->GetPointData();
+  for (int i = 0; i < expectedPD->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = expectedPD->GetArray(i);
+    if (!SameArray(pd->GetArray(array->GetName()), array))
+    {
+      std::cerr << "Wrong values for array " << array->GetName() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the values of the array are in a mapping of the file. Always true
+// where /proc/self/maps is not available.
+bool IsMapped(vtkDataArray* array, const std::string& fileName)
+{
+  std::ifstream maps("/proc/self/maps");
+  if (!maps)
+  {
+    return true;
+  }
+  const std::string baseName = fileName.substr(fileName.find_last_of('/') + 1);
+  const std::uintptr_t pointer = reinterpret_cast<std::uintptr_t>(array->GetVoidPointer(0));
+  std::string line;
+  while (std::getline(maps, line))
+  {
+    std::istringstream fields(line);
+    std::uintptr_t begin, end;
+    char dash;
+    std::string permissions, offset, device, inode, path;
+    fields >> std::hex >> begin >> dash >> end >> permissions >> offset >> device >> inode >> path;
+    if (pointer >= begin && pointer < end)
+    {
+      return path.size() > baseName.size() &&
+        path.compare(path.size() - baseName.size() - 1, std::string::npos, "/" + baseName) == 0;
+    }
+  }
+  return false;
+}
+
+vtkSmartPointer<vtkImageData> Read(const std::string& fileName, bool memoryMap)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapAppendedData(memoryMap);
+  reader->Update();
+  // Read the file again, replacing the views of the first update.
+  reader->Modified();
+  reader->Update();
+  return reader->GetOutput();
+}
+}
+
+int TestXMLReaderMemoryMap(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string rawFileName = std::string(tempDir) + "/TestXMLReaderMemoryMap.vti";
+  std::string compressedFileName = std::string(tempDir) + "/TestXMLReaderMemoryMapZLib.vti";
+  delete[] tempDir;
+
+  // An odd number of bytes of flags misaligns the array that follows it,
+  // unless the writer aligns it.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(41, 31, 21);
+  vtkNew<vtkUnsignedCharArray> flags;
+  flags->SetName("flags");
+  vtkNew<vtkDoubleArray> wave;
+  wave->SetName("wave");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    flags->InsertNextValue(static_cast<unsigned char>(i % 3));
+    wave->InsertNextValue(std::sin(0.01 * i));
+    ids->InsertNextTuple2(i, i % 7);
+  }
+  image->GetPointData()->AddArray(flags);
+  image->GetPointData()->AddArray(wave);
+  image->GetPointData()->AddArray(ids);
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+  writer->SetFileName(rawFileName.c_str());
+  writer->Write();
+  writer->SetCompressorTypeToZLib();
+  writer->SetFileName(compressedFileName.c_str());
+  writer->Write();
+
+  for (const std::string& fileName : { rawFileName, compressedFileName })
+  {
+    vtkSmartPointer<vtkImageData> copied = Read(fileName, false);
+    vtkSmartPointer<vtkImageData> mapped = Read(fileName, true);
+    if (!SameArrays(copied, image) || !SameArrays(mapped, image))
+    {
+      std::cerr << "Failed to read " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Only the arrays of the raw file are mapped.
+    const bool raw = fileName == rawFileName;
+    for (int i = 0; i < image->GetPointData()->GetNumberOfArrays(); ++i)
+    {
+      const char* name = image->GetPointData()->GetArray(i)->GetName();
+      if (IsMapped(copied->GetPointData()->GetArray(name), fileName) ||
+        IsMapped(mapped->GetPointData()->GetArray(name), fileName) != raw)
+      {
+        std::cerr << "Array " << name << " of " << fileName << " is "
+                  << (raw ? "not " : "") << "mapped" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Modifying the values does not modify the file.
+    vtkDataArray* mappedIds = mapped->GetPointData()->GetArray("ids");
+    vtkDataArray* mappedWave = mapped->GetPointData()->GetArray("wave");
+    mappedIds->SetComponent(10, 0, -1);
+    mappedWave->SetComponent(20, 0, 2.0);
+    if (!SameArrays(Read(fileName, true), image) || mappedIds->GetComponent(10, 0) != -1 ||
+      mappedWave->GetComponent(20, 0) != 2.0)
+    {
+      std::cerr << "Modifying the values of " << fileName << " modified the file" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLWriterCompressionThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that compressing blocks concurrently writes the same file as
+// compressing them one after another, for each compressor and data mode.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+std::string Write(vtkImageData* image, int compressor, int dataMode, int numThreads)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressor);
+  writer->SetDataMode(dataMode);
+  writer->SetBlockSize(1024);
+  writer->SetNumberOfCompressionThreads(numThreads);
+  writer->Write();
+  return writer->GetOutputString();
+}
+}
+
+int TestXMLWriterCompressionThreads(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  vtkNew<vtkDoubleArray> wave;
+  wave->SetName("wave");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    wave->InsertNextValue(std::sin(0.01 * i));
+    ids->InsertNextTuple2(i, i % 7);
+  }
+  image->GetPointData()->AddArray(wave);
+  image->GetPointData()->AddArray(ids);
+
+  const int compressors[3] = { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::LZMA };
+  const int dataModes[2] = { vtkXMLWriter::Binary, vtkXMLWriter::Appended };
+  for (int compressor : compressors)
+  {
+    for (int dataMode : dataModes)
+    {
+      const std::string reference = Write(image, compressor, dataMode, 1);
+      for (int numThreads : { 0, 2, 3, 8 })
+      {
+        if (Write(image, compressor, dataMode, numThreads) != reference)
+        {
+          std::cerr << "Compressor " << compressor << ", data mode " << dataMode << ": "
+                    << numThreads << " threads do not write the same file as one" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+      vtkNew<vtkXMLImageDataReader> reader;
+      reader->ReadFromInputStringOn();
+      reader->SetInputString(reference);
+      reader->Update();
+      vtkDataArray* read = reader->GetOutput()->GetPointData()->GetArray("wave");
+      if (!read || read->GetNumberOfTuples() != wave->GetNumberOfTuples() ||
+        read->GetComponent(12345, 0) != wave->GetValue(12345))
+      {
+        std::cerr << "Compressor " << compressor << ", data mode " << dataMode
+                  << ": wrong data read back" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
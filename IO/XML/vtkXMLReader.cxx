@@ -52,11 +52,23 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <functional>
 #include <locale> // C++ locale
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
+#ifdef _WIN32
+#include "vtkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
 
@@ -129,6 +141,102 @@ static void ReadStringVersion(const char* version, int& major, int& minor)
     }
   }
 }
+//------------------------------------------------------------------------------
+// A private, copy-on-write memory mapping of a whole file.
+class vtkXMLReaderMemoryMap
+{
+public:
+  vtkXMLReaderMemoryMap(const char* fileName)
+  {
+#ifdef _WIN32
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+      GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return;
+    }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+      // The view keeps the mapping alive once its handle is closed.
+      HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+      if (mapping)
+      {
+        this->Data = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+        this->Size = this->Data ? static_cast<vtkTypeUInt64>(size.QuadPart) : 0;
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+      return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      void* data = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED)
+      {
+        this->Data = static_cast<unsigned char*>(data);
+        this->Size = static_cast<vtkTypeUInt64>(st.st_size);
+      }
+    }
+    close(fd);
+#endif
+  }
+
+  ~vtkXMLReaderMemoryMap()
+  {
+    if (this->Data)
+    {
+#ifdef _WIN32
+      UnmapViewOfFile(this->Data);
+#else
+      munmap(this->Data, this->Size);
+#endif
+    }
+  }
+
+  unsigned char* Data = nullptr;
+  vtkTypeUInt64 Size = 0;
+
+private:
+  vtkXMLReaderMemoryMap(const vtkXMLReaderMemoryMap&) = delete;
+  void operator=(const vtkXMLReaderMemoryMap&) = delete;
+};
+
+namespace
+{
+// The memory mappings viewed by data arrays, by address of the view.  The
+// free function of the arrays releases their view.
+struct vtkXMLReaderMemoryMapViews
+{
+  std::mutex Mutex;
+  std::unordered_multimap<void*, std::shared_ptr<vtkXMLReaderMemoryMap>> Views;
+};
+
+vtkXMLReaderMemoryMapViews& GetMemoryMapViews()
+{
+  // Never destroyed, since arrays may be released during static destruction.
+  static vtkXMLReaderMemoryMapViews* views = new vtkXMLReaderMemoryMapViews;
+  return *views;
+}
+
+void ReleaseMemoryMapView(void* view)
+{
+  vtkXMLReaderMemoryMapViews& views = GetMemoryMapViews();
+  std::lock_guard<std::mutex> lock(views.Mutex);
+  auto it = views.Views.find(view);
+  if (it != views.Views.end())
+  {
+    views.Views.erase(it);
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 vtkXMLReader::vtkXMLReader()
 {
@@ -138,6 +246,8 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->NumberOfDecompressionThreads = 0;
+  this->MemoryMapAppendedData = 0;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -234,6 +344,8 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Stream: (none)\n";
   }
   os << indent << "TimeStep:" << this->TimeStep << "\n";
+  os << indent << "NumberOfDecompressionThreads: " << this->NumberOfDecompressionThreads << "\n";
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
@@ -364,6 +476,8 @@ int vtkXMLReader::OpenVTKString()
 //------------------------------------------------------------------------------
 void vtkXMLReader::CloseStream()
 {
+  // Arrays viewing the memory mapping keep it alive.
+  this->MemoryMap = nullptr;
   if (this->Stream)
   {
     if (this->ReadFromInputString)
@@ -690,6 +804,7 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
   {
     // We are just starting to execute.  No errors have yet occurred.
     this->XMLParser->SetAbort(0);
+    this->XMLParser->SetNumberOfDecompressionThreads(this->NumberOfDecompressionThreads);
     this->DataError = 0;
 
     // Let the subclasses read the data they want.
@@ -876,12 +991,21 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  if (this->MemoryMapAppendedData && arrayIndex == 0 && startIndex == 0 &&
+    numValues == array->GetNumberOfValues() && this->MapArrayValues(da, array))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    result = 1;
+  }
+  else
+  {
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da,
+                                      this->XMLParser, arrayIndex, static_cast<VTK_TT*>(iter),
+                                      startIndex, numValues));
+      default:
+        result = 0;
+    }
   }
   if (iter)
   {
@@ -901,6 +1025,48 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   return result;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array)
+{
+  // Only arrays with a contiguous buffer of values can view the appended
+  // data of a file opened by this reader.
+  if (!this->FileStream || !this->FileName || !da->GetAttribute("offset") ||
+    array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate ||
+    array->GetNumberOfValues() == 0)
+  {
+    return 0;
+  }
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkIdType numValues = array->GetNumberOfValues();
+  vtkTypeInt64 position =
+    this->XMLParser->GetRawAppendedDataPosition(offset, numValues, array->GetDataType());
+  if (position < 0)
+  {
+    return 0;
+  }
+
+  if (!this->MemoryMap)
+  {
+    this->MemoryMap = std::make_shared<vtkXMLReaderMemoryMap>(this->FileName);
+  }
+  vtkTypeUInt64 wordSize = static_cast<vtkTypeUInt64>(array->GetDataTypeSize());
+  vtkTypeUInt64 end = static_cast<vtkTypeUInt64>(position) + numValues * wordSize;
+  unsigned char* view = this->MemoryMap->Data + position;
+  if (!this->MemoryMap->Data || end > this->MemoryMap->Size ||
+    reinterpret_cast<std::uintptr_t>(view) % wordSize != 0)
+  {
+    return 0;
+  }
+
+  array->SetVoidArray(view, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(ReleaseMemoryMapView);
+  vtkXMLReaderMemoryMapViews& views = GetMemoryMapViews();
+  std::lock_guard<std::mutex> lock(views.Mutex);
+  views.Views.emplace(view, this->MemoryMap);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkXMLReader::ReadXMLData()
 {
@@ -27,6 +27,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkIOXMLModule.h" // For export macro
 
+#include <memory> // for std::shared_ptr
 #include <string> // for std::string
 #include <vector>
 
@@ -38,6 +39,7 @@ class vtkDataSet;
 class vtkDataSetAttributes;
 class vtkXMLDataElement;
 class vtkXMLDataParser;
+class vtkXMLReaderMemoryMap;
 class vtkInformationVector;
 class vtkInformation;
 class vtkStringArray;
@@ -73,6 +75,34 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   //@}
 
+  //@{
+  /**
+   * Get/Set the maximum number of compressed blocks decompressed
+   * concurrently while reading the data, see
+   * vtkXMLDataParser::SetNumberOfDecompressionThreads(). The default, 0, uses
+   * vtkSMPTools::GetEstimatedNumberOfThreads().
+   */
+  vtkSetClampMacro(NumberOfDecompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfDecompressionThreads, int);
+  //@}
+
+  //@{
+  /**
+   * When on, data arrays read whole from the raw, uncompressed appended data
+   * of a file, in the byte order of this machine, are views over a private
+   * memory mapping of the file instead of copies. The values are then read
+   * from the file when first accessed, and pages that are not modified are
+   * shared with the operating system's page cache. Modifying the values does
+   * not modify the file. The values must also be aligned in the file on the
+   * size of their type, as vtkXMLWriter writes them since it aligns raw
+   * appended data; arrays of files that older writers left misaligned are
+   * read as usual, as are other arrays. Off by default.
+   */
+  vtkSetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkGetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkBooleanMacro(MemoryMapAppendedData, vtkTypeBool);
+  //@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -297,6 +327,11 @@ protected:
   virtual int ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues, FieldType type = OTHER);
 
+  // Replace the values of a whole array by a view over the memory mapping
+  // of the file, see MemoryMapAppendedData. Returns 0 when the array must
+  // be read instead.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array);
+
   // Setup the data array selections for the input's set of arrays.
   void SetDataArraySelections(vtkXMLDataElement* eDSA, vtkDataArraySelection* sel);
 
@@ -331,6 +366,14 @@ protected:
   // Default is 0: read from file.
   vtkTypeBool ReadFromInputString;
 
+  // The maximum number of blocks decompressed concurrently.
+  int NumberOfDecompressionThreads;
+
+  // Whether arrays view the memory mapping of the file, which is kept
+  // while the file is open.
+  vtkTypeBool MemoryMapAppendedData;
+  std::shared_ptr<vtkXMLReaderMemoryMap> MemoryMap;
+
   // The input string.
   std::string InputString;
 
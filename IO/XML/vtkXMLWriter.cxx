@@ -45,6 +45,8 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -65,9 +67,11 @@
 #include "vtksys/FStream.hxx"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -78,6 +82,18 @@
 #include <cctype> // for isalnum
 #include <locale> // C++ locale
 
+//*****************************************************************************
+// Uncompressed blocks of an array waiting to be compressed together. The
+// buffers are kept from one batch to the next.
+class vtkXMLWriterCompressionBlocks
+{
+public:
+  std::vector<std::vector<unsigned char>> Blocks;
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> Compressed;
+  size_t NumberOfBlocks = 0;
+  int NumberOfThreads = 1;
+};
+
 //*****************************************************************************
 // Friend class to enable access for template functions to the protected
 // writer methods.
@@ -106,6 +122,24 @@ public:
 namespace
 {
 
+//------------------------------------------------------------------------------
+// Compress a range of pending blocks.
+struct CompressBlocksWorker
+{
+  vtkDataCompressor* Compressor;
+  vtkXMLWriterCompressionBlocks* Blocks;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      std::vector<unsigned char>& block = this->Blocks->Blocks[i];
+      this->Blocks->Compressed[i].TakeReference(
+        this->Compressor->Compress(block.data(), block.size()));
+    }
+  }
+};
+
 struct WriteBinaryDataBlockWorker
 {
   vtkXMLWriter* Writer;
@@ -473,6 +507,8 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; // 2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = nullptr;
+  this->NumberOfCompressionThreads = 0;
+  this->CompressionBlocks = new vtkXMLWriterCompressionBlocks;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
@@ -508,6 +544,7 @@ vtkXMLWriter::~vtkXMLWriter()
   delete this->OutStringStream;
   this->OutStringStream = nullptr;
   delete this->FieldDataOM;
+  delete this->CompressionBlocks;
   delete[] this->NumberOfTimeValues;
 }
 
@@ -620,6 +657,7 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "NumberOfCompressionThreads: " << this->NumberOfCompressionThreads << "\n";
   if (this->Stream)
   {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -1310,6 +1348,13 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks still pending.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+    this->CompressionBlocks->NumberOfBlocks = 0;
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1672,8 +1717,67 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  int numThreads = this->NumberOfCompressionThreads;
+  if (numThreads == 0)
+  {
+    numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  }
+  if (numThreads <= 1)
+  {
+    // Compress the data.
+    vtkSmartPointer<vtkUnsignedCharArray> outputArray =
+      vtkSmartPointer<vtkUnsignedCharArray>::Take(this->Compressor->Compress(data, size));
+    return this->WriteCompressedBlock(outputArray);
+  }
+
+  // Copy the block, as the caller reuses its buffer, and compress the blocks
+  // in batches of a few blocks per thread.
+  vtkXMLWriterCompressionBlocks* pending = this->CompressionBlocks;
+  const size_t batchSize = 4 * static_cast<size_t>(numThreads);
+  pending->NumberOfThreads = numThreads;
+  if (pending->Blocks.size() < batchSize)
+  {
+    pending->Blocks.resize(batchSize);
+    pending->Compressed.resize(batchSize);
+  }
+  pending->Blocks[pending->NumberOfBlocks++].assign(data, data + size);
+  return pending->NumberOfBlocks < batchSize ? 1 : this->FlushCompressionBlocks();
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  vtkXMLWriterCompressionBlocks* pending = this->CompressionBlocks;
+  const vtkIdType numBlocks = static_cast<vtkIdType>(pending->NumberOfBlocks);
+  pending->NumberOfBlocks = 0;
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
+
+  // Compress the blocks, with at most one range of blocks per thread.
+  const vtkIdType grain = (numBlocks + pending->NumberOfThreads - 1) / pending->NumberOfThreads;
+  CompressBlocksWorker worker{ this->Compressor, pending };
+  vtkSMPTools::For(0, numBlocks, grain, worker);
+
+  // Write the compressed blocks in order.
+  int result = 1;
+  for (vtkIdType i = 0; i < numBlocks; ++i)
+  {
+    result = result && this->WriteCompressedBlock(pending->Compressed[i]);
+    pending->Compressed[i] = nullptr;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLWriter::WriteCompressedBlock(vtkUnsignedCharArray* outputArray)
+{
+  if (!outputArray)
+  {
+    vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+    return 0;
+  }
 
   // Find the compressed size.
   size_t outputSize = outputArray->GetNumberOfTuples();
@@ -1690,8 +1794,6 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
   // Store the resulting compressed size in the compression header.
   this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
 
-  outputArray->Delete();
-
   return result;
 }
 
@@ -2332,6 +2434,23 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  // Align the values of raw data on the size of their type, with zeros
+  // before the header, so that readers can memory map them.
+  if (!this->EncodeAppendedData && !this->Compressor && a->GetDataType() != VTK_BIT &&
+    vtkArrayDownCast<vtkDataArray>(a))
+  {
+    ostream& os = *(this->Stream);
+    const vtkTypeInt64 wordSize =
+      static_cast<vtkTypeInt64>(this->GetOutputWordTypeSize(a->GetDataType()));
+    const vtkTypeInt64 headerSize = this->HeaderType == vtkXMLWriter::UInt64 ? 8 : 4;
+    const vtkTypeInt64 misalignment =
+      (static_cast<vtkTypeInt64>(os.tellp()) + headerSize) % wordSize;
+    if (misalignment != 0)
+    {
+      const char zeros[8] = { 0 };
+      os.write(zeros, wordSize - misalignment);
+    }
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
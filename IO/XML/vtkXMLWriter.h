@@ -57,6 +57,8 @@ class vtkStdString;
 class OffsetsManager;      // one per piece/per time
 class OffsetsManagerGroup; // array of OffsetsManager
 class OffsetsManagerArray; // array of OffsetsManagerGroup
+class vtkXMLWriterCompressionBlocks;
+class vtkUnsignedCharArray;
 
 class VTKIOXML_EXPORT vtkXMLWriter : public vtkAlgorithm
 {
@@ -201,6 +203,18 @@ public:
   vtkGetMacro(BlockSize, size_t);
   //@}
 
+  //@{
+  /**
+   * Get/Set the maximum number of blocks compressed concurrently with
+   * vtkSMPTools. The compressed blocks are written in order, so the file
+   * does not depend on this value. A value of 1 compresses each block on
+   * the calling thread as it is produced. The default, 0, uses
+   * vtkSMPTools::GetEstimatedNumberOfThreads().
+   */
+  vtkSetClampMacro(NumberOfCompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfCompressionThreads, int);
+  //@}
+
   //@{
   /**
    * Get/Set the data mode used for the file's data.  The options are
@@ -220,7 +234,9 @@ public:
    * encoded, reading and writing will be slower, but the file will be
    * fully valid XML and text-only.  If not encoded, the XML
    * specification will be violated, but reading and writing will be
-   * fast.  The default is to do the encoding.
+   * fast.  The default is to do the encoding.  Without encoding nor
+   * compression, the values of each data array are aligned in the file on
+   * the size of their type, so that readers can memory map them.
    */
   vtkSetMacro(EncodeAppendedData, vtkTypeBool);
   vtkGetMacro(EncodeAppendedData, vtkTypeBool);
@@ -342,6 +358,9 @@ protected:
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel = 5;
+  // Blocks waiting to be compressed concurrently.
+  int NumberOfCompressionThreads;
+  vtkXMLWriterCompressionBlocks* CompressionBlocks;
 
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
@@ -462,6 +481,8 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
+  int WriteCompressedBlock(vtkUnsignedCharArray* outputArray);
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
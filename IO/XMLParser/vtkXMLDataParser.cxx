@@ -20,7 +20,9 @@
 #include "vtkDataCompressor.h"
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
+#include "vtkNumberFromString.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -29,8 +31,11 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "vtkXMLUtilities.h"
@@ -38,6 +43,123 @@
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
 
+//------------------------------------------------------------------------------
+// Compressed blocks read from the data stream, the destination of their
+// uncompressed data, and the number of threads decompressing them.
+class vtkXMLDataParserBlockBatch
+{
+public:
+  int NumberOfThreads = 1;
+  std::vector<unsigned char> Compressed;
+  std::vector<size_t> Offsets;
+  std::vector<unsigned char*> Outputs;
+  std::vector<size_t> Sizes;
+  std::vector<char> Results;
+};
+
+namespace
+{
+struct DecompressBlocksWorker
+{
+  vtkDataCompressor* Compressor;
+  vtkXMLDataParserBlockBatch* Batch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkXMLDataParserBlockBatch* batch = this->Batch;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const size_t compressedSize = batch->Offsets[i + 1] - batch->Offsets[i];
+      batch->Results[i] = this->Compressor->Uncompress(batch->Compressed.data() + batch->Offsets[i],
+                            compressedSize, batch->Outputs[i], batch->Sizes[i]) > 0;
+    }
+  }
+};
+
+// Decompress the blocks of a batch with vtkSMPTools, and return whether they
+// all succeeded.  The blocks are split in at most NumberOfThreads tasks.
+bool DecompressBlocks(vtkDataCompressor* compressor, vtkXMLDataParserBlockBatch* batch)
+{
+  const vtkIdType numBlocks = static_cast<vtkIdType>(batch->Outputs.size());
+  const vtkIdType grain = (numBlocks + batch->NumberOfThreads - 1) / batch->NumberOfThreads;
+  DecompressBlocksWorker worker{ compressor, batch };
+  vtkSMPTools::For(0, numBlocks, grain, worker);
+  return std::find(batch->Results.begin(), batch->Results.end(), 0) == batch->Results.end();
+}
+}
+
+//------------------------------------------------------------------------------
+// Thread kept by the parser to decompress a batch of blocks while the next
+// batch is read on the calling thread. It is started by the first batch and
+// joined when the parser is destroyed.
+class vtkXMLDataParserWorker
+{
+public:
+  ~vtkXMLDataParserWorker()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stop = true;
+    }
+    this->Condition.notify_all();
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  // Start decompressing the batch.
+  void Start(vtkDataCompressor* compressor, vtkXMLDataParserBlockBatch* batch)
+  {
+    if (!this->Thread.joinable())
+    {
+      this->Thread = std::thread(&vtkXMLDataParserWorker::Run, this);
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Compressor = compressor;
+      this->Batch = batch;
+    }
+    this->Condition.notify_all();
+  }
+
+  // Wait for the batch, and return whether all its blocks were decompressed.
+  bool Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this] { return !this->Batch; });
+    return this->Result;
+  }
+
+private:
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this] { return this->Stop || this->Batch; });
+      if (this->Stop)
+      {
+        return;
+      }
+      lock.unlock();
+      const bool result = DecompressBlocks(this->Compressor, this->Batch);
+      lock.lock();
+      this->Result = result;
+      this->Batch = nullptr;
+      this->Condition.notify_all();
+    }
+  }
+
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  vtkDataCompressor* Compressor = nullptr;
+  vtkXMLDataParserBlockBatch* Batch = nullptr;
+  bool Result = false;
+  bool Stop = false;
+};
+
 //------------------------------------------------------------------------------
 vtkXMLDataParser::vtkXMLDataParser()
 {
@@ -54,6 +176,8 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = nullptr;
   this->BlockStartOffsets = nullptr;
   this->Compressor = nullptr;
+  this->NumberOfDecompressionThreads = 0;
+  this->DecompressionWorker = nullptr;
 
   this->AsciiDataBuffer = nullptr;
   this->AsciiDataBufferLength = 0;
@@ -87,6 +211,7 @@ vtkXMLDataParser::~vtkXMLDataParser()
   this->AppendedDataStream->Delete();
   delete[] this->BlockCompressedSizes;
   delete[] this->BlockStartOffsets;
+  delete this->DecompressionWorker;
   this->SetCompressor(nullptr);
   if (this->AsciiDataBuffer)
   {
@@ -113,6 +238,7 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
+  os << indent << "NumberOfDecompressionThreads: " << this->NumberOfDecompressionThreads << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
 }
 
@@ -639,6 +765,122 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 firstBlock, vtkTypeUInt64 lastBlock,
+  unsigned char* buffer, size_t wordSize, const unsigned char* data, size_t length)
+{
+  const int numThreads = this->NumberOfDecompressionThreads > 0
+    ? this->NumberOfDecompressionThreads
+    : vtkSMPTools::GetEstimatedNumberOfThreads();
+  unsigned char* outputPointer = buffer;
+  if (numThreads <= 1 || lastBlock - firstBlock < 2)
+  {
+    for (vtkTypeUInt64 block = firstBlock; block < lastBlock && !this->Abort; ++block)
+    {
+      // Read this block.
+      if (!this->ReadBlock(block, outputPointer))
+      {
+        return 0;
+      }
+
+      // Byte swap this block.  Note that the size of a complete block
+      // will always be an integer multiple of the word size.
+      size_t blockSize = this->FindBlockSize(block);
+      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+
+      // Advance the pointer to the beginning of the next block.
+      outputPointer += blockSize;
+
+      // Report progress.
+      this->UpdateProgress(float(outputPointer - data) / length);
+    }
+    return 1;
+  }
+
+  // Blocks are decompressed independently, directly into the output, by
+  // batches of a few blocks per thread.  The next batch is read from the
+  // stream on this thread while the worker of the parser decompresses the
+  // current one.
+  const vtkTypeUInt64 batchSize = 4 * static_cast<vtkTypeUInt64>(numThreads);
+  vtkXMLDataParserBlockBatch batches[2];
+  batches[0].NumberOfThreads = batches[1].NumberOfThreads = numThreads;
+  vtkXMLDataParserBlockBatch* current = &batches[0];
+  vtkXMLDataParserBlockBatch* next = &batches[1];
+  vtkTypeUInt64 block = firstBlock;
+  vtkTypeUInt64 batchEnd = std::min(lastBlock, block + batchSize);
+  if (!this->ReadBlockBatch(block, batchEnd, outputPointer, current))
+  {
+    return 0;
+  }
+  if (!this->DecompressionWorker)
+  {
+    this->DecompressionWorker = new vtkXMLDataParserWorker;
+  }
+  while (block < lastBlock && !this->Abort)
+  {
+    this->DecompressionWorker->Start(this->Compressor, current);
+
+    // Read the next batch meanwhile.
+    const vtkTypeUInt64 nextBlock = batchEnd;
+    const vtkTypeUInt64 nextBatchEnd = std::min(lastBlock, nextBlock + batchSize);
+    unsigned char* nextOutputPointer = outputPointer;
+    for (vtkTypeUInt64 i = block; i < nextBlock; ++i)
+    {
+      nextOutputPointer += this->FindBlockSize(i);
+    }
+    const bool readNext = nextBlock == lastBlock ||
+      this->ReadBlockBatch(nextBlock, nextBatchEnd, nextOutputPointer, next);
+    if (!this->DecompressionWorker->Wait() || !readNext)
+    {
+      return 0;
+    }
+
+    // Byte swap the decompressed blocks.
+    for (size_t i = 0; i < current->Outputs.size(); ++i)
+    {
+      this->PerformByteSwap(current->Outputs[i], current->Sizes[i] / wordSize, wordSize);
+    }
+
+    // Report progress.
+    outputPointer = nextOutputPointer;
+    this->UpdateProgress(float(outputPointer - data) / length);
+
+    std::swap(current, next);
+    block = nextBlock;
+    batchEnd = nextBatchEnd;
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlockBatch(vtkTypeUInt64 firstBlock, vtkTypeUInt64 lastBlock,
+  unsigned char* buffer, vtkXMLDataParserBlockBatch* batch)
+{
+  // The compressed blocks are stored one after another, so the whole
+  // batch is read at once.
+  const size_t numBlocks = static_cast<size_t>(lastBlock - firstBlock);
+  batch->Offsets.resize(numBlocks + 1);
+  batch->Outputs.resize(numBlocks);
+  batch->Sizes.resize(numBlocks);
+  batch->Results.assign(numBlocks, 0);
+  batch->Offsets[0] = 0;
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    batch->Offsets[i + 1] = batch->Offsets[i] + this->BlockCompressedSizes[firstBlock + i];
+    batch->Outputs[i] = buffer;
+    batch->Sizes[i] = this->FindBlockSize(firstBlock + i);
+    buffer += batch->Sizes[i];
+  }
+
+  const size_t compressedSize = batch->Offsets[numBlocks];
+  batch->Compressed.resize(compressedSize);
+  if (!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+  {
+    return 0;
+  }
+  return this->DataStream->Read(batch->Compressed.data(), compressedSize) == compressedSize;
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -811,24 +1053,14 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in between.
+    if (!this->ReadBlocks(firstBlock + 1, lastBlock, outputPointer, wordSize, data, length))
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
-      {
-        return 0;
-      }
-
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
-      // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
-
-      // Report progress.
-      this->UpdateProgress(float(outputPointer - data) / length);
+      return 0;
+    }
+    for (vtkTypeUInt64 block = firstBlock + 1; block < lastBlock; ++block)
+    {
+      outputPointer += this->FindBlockSize(block);
     }
 
     // Now read the final block, which is incomplete if it exists.
@@ -974,241 +1206,67 @@ size_t vtkXMLDataParser::ReadAppendedData(
 }
 
 //------------------------------------------------------------------------------
-//------------------------------------------------------------------------------
-// Define a parsing function template.  The extra "long" argument is used
-// to help broken compilers select the non-templates below for char and
-// unsigned char, and float/double by making them a better conversion than
-// the template.
-template <class T>
-T* vtkXMLParseAsciiData(istream& is, int* length, T*, long)
+vtkTypeInt64 vtkXMLDataParser::GetRawAppendedDataPosition(
+  vtkTypeInt64 offset, size_t numWords, int wordType)
 {
-  int dataLength = 0;
-  int dataBufferSize = 64;
-
-  T* dataBuffer = new T[dataBufferSize];
-  T element;
-
-  while (is >> element)
+#ifdef VTK_WORDS_BIGENDIAN
+  const int byteOrder = vtkXMLDataParser::BigEndian;
+#else
+  const int byteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if (this->Abort || this->Compressor || this->ByteOrder != byteOrder ||
+    vtkBase64InputStream::SafeDownCast(this->AppendedDataStream))
   {
-    if (dataLength == dataBufferSize)
-    {
-      int newSize = dataBufferSize * 2;
-      T* newBuffer = new T[newSize];
-      memcpy(newBuffer, dataBuffer, dataLength * sizeof(T));
-      delete[] dataBuffer;
-      dataBuffer = newBuffer;
-      dataBufferSize = newSize;
-    }
-    dataBuffer[dataLength++] = element;
+    return -1;
   }
 
-  if (length)
+  // Read the length of the data from its header.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  vtkTypeInt64 const position = this->AppendedDataPosition + offset;
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(position);
+  this->DataStream->SetStream(this->Stream);
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if (r < headerSize || uh->Get(0) < numWords * this->GetWordTypeSize(wordType))
   {
-    *length = dataLength;
+    return -1;
   }
-
-  return dataBuffer;
+  return position + static_cast<vtkTypeInt64>(headerSize);
 }
 
 //------------------------------------------------------------------------------
-static float* vtkXMLParseAsciiData(istream& is, int* length, float*, int)
-{
-  int dataLength = 0;
-  int dataBufferSize = 64;
-
-  float* dataBuffer = new float[dataBufferSize];
-  std::string stringBuffer;
-  float element;
-
-  while (true)
-  {
-    is >> element;
-    if (!is.good())
-    {
-      is.clear(is.rdstate() & ~ios::failbit);
-      is >> stringBuffer;
-      if (!is.good())
-      {
-        break;
-      }
-      else
-      {
-        std::for_each(
-          stringBuffer.begin(), stringBuffer.end(), [](char& c) { c = std::tolower(c); });
-        if (stringBuffer == "inf" || stringBuffer == "nan" || stringBuffer == "-inf")
-        {
-          element = strtof(stringBuffer.c_str(), nullptr);
-        }
-        else
-        {
-          break;
-        }
-      }
-    }
-    if (dataLength == dataBufferSize)
-    {
-      int newSize = dataBufferSize * 2;
-      float* newBuffer = new float[newSize];
-      memcpy(newBuffer, dataBuffer, dataLength * sizeof(float));
-      delete[] dataBuffer;
-      dataBuffer = newBuffer;
-      dataBufferSize = newSize;
-    }
-    dataBuffer[dataLength++] = element;
-  }
-
-  if (length)
-  {
-    *length = dataLength;
-  }
-
-  return dataBuffer;
-}
-
 //------------------------------------------------------------------------------
-static double* vtkXMLParseAsciiData(istream& is, int* length, double*, int)
+// Parse numbers until the first word that is not a number, by requests of
+// growing size so that large arrays are parsed by chunks.
+template <class T>
+T* vtkXMLParseAsciiData(istream& is, int* length, T*)
 {
   int dataLength = 0;
   int dataBufferSize = 64;
 
-  double* dataBuffer = new double[dataBufferSize];
-  std::string stringBuffer;
-  double element;
+  T* dataBuffer = new T[dataBufferSize];
 
   while (true)
   {
-    is >> element;
-    if (!is.good())
-    {
-      is.clear(is.rdstate() & ~ios::failbit);
-      is >> stringBuffer;
-      if (!is.good())
-      {
-        break;
-      }
-      else
-      {
-        std::for_each(
-          stringBuffer.begin(), stringBuffer.end(), [](char& c) { c = std::tolower(c); });
-        if (stringBuffer == "inf" || stringBuffer == "nan" || stringBuffer == "-inf")
-        {
-          element = strtod(stringBuffer.c_str(), nullptr);
-        }
-        else
-        {
-          break;
-        }
-      }
-    }
     if (dataLength == dataBufferSize)
     {
       int newSize = dataBufferSize * 2;
-      double* newBuffer = new double[newSize];
-      memcpy(newBuffer, dataBuffer, dataLength * sizeof(double));
-      delete[] dataBuffer;
-      dataBuffer = newBuffer;
-      dataBufferSize = newSize;
-    }
-    dataBuffer[dataLength++] = element;
-  }
-
-  if (length)
-  {
-    *length = dataLength;
-  }
-
-  return dataBuffer;
-}
-
-//------------------------------------------------------------------------------
-static char* vtkXMLParseAsciiData(istream& is, int* length, char*, int)
-{
-  int dataLength = 0;
-  int dataBufferSize = 64;
-
-  char* dataBuffer = new char[dataBufferSize];
-  char element;
-  short inElement;
-
-  while (is >> inElement)
-  {
-    element = inElement;
-    if (dataLength == dataBufferSize)
-    {
-      int newSize = dataBufferSize * 2;
-      char* newBuffer = new char[newSize];
-      memcpy(newBuffer, dataBuffer, dataLength * sizeof(char));
-      delete[] dataBuffer;
-      dataBuffer = newBuffer;
-      dataBufferSize = newSize;
-    }
-    dataBuffer[dataLength++] = element;
-  }
-
-  if (length)
-  {
-    *length = dataLength;
-  }
-
-  return dataBuffer;
-}
-
-//------------------------------------------------------------------------------
-static unsigned char* vtkXMLParseAsciiData(istream& is, int* length, unsigned char*, int)
-{
-  int dataLength = 0;
-  int dataBufferSize = 64;
-
-  unsigned char* dataBuffer = new unsigned char[dataBufferSize];
-  unsigned char element;
-  short inElement;
-
-  while (is >> inElement)
-  {
-    element = inElement;
-    if (dataLength == dataBufferSize)
-    {
-      int newSize = dataBufferSize * 2;
-      unsigned char* newBuffer = new unsigned char[newSize];
-      memcpy(newBuffer, dataBuffer, dataLength * sizeof(unsigned char));
+      T* newBuffer = new T[newSize];
+      memcpy(newBuffer, dataBuffer, dataLength * sizeof(T));
       delete[] dataBuffer;
       dataBuffer = newBuffer;
       dataBufferSize = newSize;
     }
-    dataBuffer[dataLength++] = element;
-  }
-
-  if (length)
-  {
-    *length = dataLength;
-  }
-
-  return dataBuffer;
-}
-
-//------------------------------------------------------------------------------
-static signed char* vtkXMLParseAsciiData(istream& is, int* length, signed char*, int)
-{
-  int dataLength = 0;
-  int dataBufferSize = 64;
-
-  signed char* dataBuffer = new signed char[dataBufferSize];
-  signed char element;
-  short inElement;
-
-  while (is >> inElement)
-  {
-    element = inElement;
-    if (dataLength == dataBufferSize)
+    vtkIdType requested = dataBufferSize - dataLength;
+    vtkIdType numRead = vtkNumberFromString::Read(is, dataBuffer + dataLength, requested);
+    dataLength += static_cast<int>(numRead);
+    if (numRead < requested)
     {
-      int newSize = dataBufferSize * 2;
-      signed char* newBuffer = new signed char[newSize];
-      memcpy(newBuffer, dataBuffer, dataLength * sizeof(signed char));
-      delete[] dataBuffer;
-      dataBuffer = newBuffer;
-      dataBufferSize = newSize;
+      break;
     }
-    dataBuffer[dataLength++] = element;
   }
 
   if (length)
@@ -1296,7 +1354,7 @@ int vtkXMLDataParser::ParseAsciiData(int wordType)
   void* buffer = nullptr;
   switch (wordType)
   {
-    vtkTemplateMacro(buffer = vtkXMLParseAsciiData(is, &length, static_cast<VTK_TT*>(nullptr), 1));
+    vtkTemplateMacro(buffer = vtkXMLParseAsciiData(is, &length, static_cast<VTK_TT*>(nullptr)));
 
     case VTK_BIT:
       buffer = vtkXMLParseAsciiBitData(is, &length);
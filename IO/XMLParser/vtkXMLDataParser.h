@@ -34,6 +34,8 @@
 #include "vtkXMLParser.h"
 
 class vtkInputStream;
+class vtkXMLDataParserBlockBatch;
+class vtkXMLDataParserWorker;
 class vtkDataCompressor;
 
 class VTKIOXMLPARSER_EXPORT vtkXMLDataParser : public vtkXMLParser
@@ -81,6 +83,15 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Get the position in the input stream of the values of the appended data
+   * starting at the given appended data offset, when they can be used in
+   * place: the appended data must be raw and uncompressed, in the byte order
+   * of this machine, and hold at least numWords words of the given type.
+   * Returns -1 otherwise.
+   */
+  vtkTypeInt64 GetRawAppendedDataPosition(vtkTypeInt64 offset, size_t numWords, int wordType);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -102,6 +113,19 @@ public:
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
   //@}
 
+  //@{
+  /**
+   * Get/Set the maximum number of compressed blocks decompressed
+   * concurrently with vtkSMPTools. The blocks are read in batches, and each
+   * batch is decompressed directly into the destination buffer while the
+   * next one is read. A value of 1 reads and decompresses each block in turn
+   * on the calling thread. The default, 0, uses
+   * vtkSMPTools::GetEstimatedNumberOfThreads().
+   */
+  vtkSetClampMacro(NumberOfDecompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfDecompressionThreads, int);
+  //@}
+
   /**
    * Get the size of a word of the given type.
    */
@@ -186,6 +210,10 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, vtkTypeUInt64 lastBlock, unsigned char* buffer,
+    size_t wordSize, const unsigned char* data, size_t length);
+  int ReadBlockBatch(vtkTypeUInt64 firstBlock, vtkTypeUInt64 lastBlock, unsigned char* buffer,
+    vtkXMLDataParserBlockBatch* batch);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -239,6 +267,8 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  int NumberOfDecompressionThreads;
+  vtkXMLDataParserWorker* DecompressionWorker;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;